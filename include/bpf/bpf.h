@@ -24,6 +24,26 @@
 int
 bpf_link_detach(int link_fd);
 
+/**
+ * @brief Atomically replace the program attached to a link. The link stays
+ * attached to its hook throughout, so the hook never runs without a program.
+ *
+ * @param[in] link_fd File descriptor of link to update.
+ * @param[in] new_prog_fd File descriptor of program to attach to the link.
+ * @param[in] opts Optional update options. If opts->flags contains
+ * BPF_F_REPLACE, the update only succeeds if opts->old_prog_fd refers to the
+ * program currently attached to the link.
+ *
+ * @retval 0 The operation was successful.
+ * @retval <0 An error occured, and errno was set.
+ *
+ * @exception EBADF A file descriptor was not found.
+ * @exception EINVAL The link is not attached, the attached program does not
+ * match old_prog_fd, or the program type does not match the link.
+ */
+int
+bpf_link_update(int link_fd, int new_prog_fd, const struct bpf_link_update_opts* opts);
+
 /**
  * @brief Get a file descriptor referring to a link
  * with a given ID.
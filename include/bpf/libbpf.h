@@ -864,7 +864,9 @@ libbpf_num_possible_cpus(void);
 /* Ring buffer APIs */
 
 /**
- * @brief Creates a new ring buffer manager.
+ * @brief Creates a new ring buffer manager. Records of its maps are only
+ * delivered by ring_buffer__poll and ring_buffer__consume, on the calling
+ * thread.
  *
  * @param[in] map_fd File descriptor to ring buffer map.
  * @param[in] sample_cb Pointer to ring buffer notification callback function.
@@ -876,6 +878,48 @@ libbpf_num_possible_cpus(void);
 struct ring_buffer*
 ring_buffer__new(int map_fd, ring_buffer_sample_fn sample_cb, void* ctx, const struct ring_buffer_opts* opts);
 
+/**
+ * @brief Adds a ring buffer map to a ring buffer manager, which polls it
+ * along with the map passed to ring_buffer__new.
+ *
+ * @param[in] rb Pointer to ring buffer manager.
+ * @param[in] map_fd File descriptor to ring buffer map.
+ * @param[in] sample_cb Pointer to ring buffer notification callback function.
+ * @param[in] ctx Pointer to sample_cb callback function.
+ *
+ * @retval 0 The operation was successful.
+ * @retval <0 An error occured, and errno was set.
+ */
+int
+ring_buffer__add(struct ring_buffer* rb, int map_fd, ring_buffer_sample_fn sample_cb, void* ctx);
+
+/**
+ * @brief Waits for records in the maps of a ring buffer manager and
+ * delivers them.
+ *
+ * @param[in] rb Pointer to ring buffer manager.
+ * @param[in] timeout_ms Maximum time to wait in milliseconds, or -1 to wait
+ * indefinitely.
+ *
+ * @returns Number of records consumed, the negative value returned by a
+ * callback, or a negative error code with errno set.
+ */
+int
+ring_buffer__poll(struct ring_buffer* rb, int timeout_ms);
+
+/**
+ * @brief Delivers the records available in the maps of a ring buffer
+ * manager without waiting. Maps without new records cost no system call, so
+ * this can be used to busy-poll.
+ *
+ * @param[in] rb Pointer to ring buffer manager.
+ *
+ * @returns Number of records consumed, the negative value returned by a
+ * callback, or a negative error code with errno set.
+ */
+int
+ring_buffer__consume(struct ring_buffer* rb);
+
 /**
  * @brief Frees a new ring buffer manager.
  *
@@ -31,10 +31,24 @@ extern "C"
 
 #define UBPF_STACK_SIZE 512
 
+// Maximum number of iterations of bpf_loop.
+#define BPF_MAX_LOOPS (8U * 1024 * 1024)
+
 #define IMMEDIATE(X) (int32_t) X
 #define OFFSET(X) (int16_t) X
 #define POINTER(X) (uint64_t)(X)
 
+#if defined(__clang__) || defined(__GNUC__)
+#define LIKELY(X) __builtin_expect(!!(X), 1)
+#define UNLIKELY(X) __builtin_expect(!!(X), 0)
+#elif defined(BPF2C_BRANCH_HINTS)
+// MSVC has no branch hints for C code, so it would silently drop the hints of a profile guided build.
+#error "Code generated with bpf2c --profile must be compiled with clang."
+#else
+#define LIKELY(X) (X)
+#define UNLIKELY(X) (X)
+#endif
+
 #if !defined(htobe16)
 #define htobe16(X) swap16(X)
 #define htobe32(X) swap32(X)
@@ -58,6 +72,12 @@ extern "C"
         void* address;
         ebpf_map_definition_in_file_t definition;
         const char* name;
+        // Values of a BPF_MAP_TYPE_ARRAY map, used by inlined lookups. Set when the map is resolved.
+        void* array_data;
+        // Initial value of a global data (.data or .rodata) map, NULL if the value starts zeroed.
+        const uint8_t* initial_value;
+        // True for a read-only global data (.rodata) map, which is frozen once its initial value is set.
+        bool read_only;
     } map_entry_t;
 
     typedef struct _program_entry
@@ -80,6 +100,9 @@ extern "C"
         ebpf_attach_type_t* expected_attach_type;
         const uint8_t* program_info_hash;
         size_t program_info_hash_length;
+        // Execution count of each basic block when generated with bpf2c --instrument, NULL otherwise.
+        uint64_t* block_counts;
+        size_t block_count;
     } program_entry_t;
 
     typedef struct _bpf2c_version
@@ -118,6 +141,40 @@ extern "C"
     void
     division_by_zero(uint32_t address);
 
+#if defined(_MSC_VER)
+    // Interlocked intrinsics used by atomic instructions.
+    long
+    _InterlockedExchangeAdd(long volatile* addend, long value);
+    int64_t
+    _InterlockedExchangeAdd64(int64_t volatile* addend, int64_t value);
+    long
+    _InterlockedOr(long volatile* destination, long value);
+    int64_t
+    _InterlockedOr64(int64_t volatile* destination, int64_t value);
+    long
+    _InterlockedAnd(long volatile* destination, long value);
+    int64_t
+    _InterlockedAnd64(int64_t volatile* destination, int64_t value);
+    long
+    _InterlockedXor(long volatile* destination, long value);
+    int64_t
+    _InterlockedXor64(int64_t volatile* destination, int64_t value);
+    long
+    _InterlockedExchange(long volatile* target, long value);
+    int64_t
+    _InterlockedExchange64(int64_t volatile* target, int64_t value);
+    long
+    _InterlockedCompareExchange(long volatile* destination, long exchange, long comparand);
+    int64_t
+    _InterlockedCompareExchange64(int64_t volatile* destination, int64_t exchange, int64_t comparand);
+#pragma intrinsic(_InterlockedExchangeAdd, _InterlockedExchangeAdd64)
+#pragma intrinsic(_InterlockedOr, _InterlockedOr64)
+#pragma intrinsic(_InterlockedAnd, _InterlockedAnd64)
+#pragma intrinsic(_InterlockedXor, _InterlockedXor64)
+#pragma intrinsic(_InterlockedExchange, _InterlockedExchange64)
+#pragma intrinsic(_InterlockedCompareExchange, _InterlockedCompareExchange64)
+#endif
+
 #ifdef __cplusplus
 }
 #endif
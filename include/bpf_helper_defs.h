@@ -137,7 +137,9 @@ EBPF_HELPER(int, bpf_csum_diff, (void* from, int from_size, void* to, int to_siz
  * @param[in, out] map Pointer to ring buffer map.
  * @param[in] data Data to copy into ring buffer map.
  * @param[in] size Length of data.
- * @param[in] flags Flags indicating if notification for new data availability should be sent.
+ * @param[in] flags Flags indicating if notification for new data availability should be sent:
+ *  BPF_RB_NO_WAKEUP to not notify the consumer, BPF_RB_FORCE_WAKEUP to notify it even if the
+ *  ring buffer's wakeup thresholds are not reached, or 0.
  * @returns 0 on success and a negative value on error.
  */
 EBPF_HELPER(int, bpf_ringbuf_output, (struct bpf_map * ring_buffer, void* data, uint64_t size, uint64_t flags));
@@ -309,3 +311,22 @@ EBPF_HELPER(uint64_t, bpf_get_current_pid_tgid, ());
 #ifndef __doxygen
 #define bpf_get_current_pid_tgid ((bpf_get_current_pid_tgid_t)BPF_FUNC_get_current_pid_tgid)
 #endif
+
+/**
+ * @brief Call a function a bounded number of times, without unrolling the loop.
+ * The loop ends early when the callback returns 1. The verifier can't check
+ * callbacks yet, so bpf2c only accepts this helper when verification is skipped.
+ *
+ * @param[in] nr_loops Number of times to call the callback, at most 8 * 1024 * 1024.
+ * @param[in] callback_fn Static function of the program, with the prototype
+ * long callback_fn(uint32_t index, void* callback_ctx).
+ * @param[in] callback_ctx Context to pass to the callback.
+ * @param[in] flags Must be 0.
+ * @returns The number of times the callback was called.
+ * @retval -EBPF_INVALID_ARGUMENT flags is not 0 or nr_loops is too large.
+ * @retval -EBPF_OPERATION_NOT_SUPPORTED The program isn't a native program. Callbacks require bpf2c.
+ */
+EBPF_HELPER(int64_t, bpf_loop, (uint32_t nr_loops, void* callback_fn, void* callback_ctx, uint64_t flags));
+#ifndef __doxygen
+#define bpf_loop ((bpf_loop_t)BPF_FUNC_loop)
+#endif
@@ -44,6 +44,26 @@ extern "C"
         _Outptr_result_z_ const char** file_name,
         _Outptr_result_z_ const char** section_name) EBPF_NO_EXCEPT;
 
+    /**
+     * @brief Get the execution count of each basic block of a native eBPF program generated with
+     * bpf2c --instrument. The counts can be passed back to bpf2c with --profile.
+     *
+     * @param[in] fd File descriptor of an eBPF program.
+     * @param[out] block_counts Array that receives the execution count of each basic block.
+     * @param[in, out] block_count On input, the number of entries in block_counts. On output, the number of
+     *  basic blocks in the program.
+     *
+     * @retval EBPF_SUCCESS The operation was successful.
+     * @retval EBPF_INVALID_FD The program fd is invalid.
+     * @retval EBPF_OPERATION_NOT_SUPPORTED The program isn't an instrumented native program.
+     * @retval EBPF_INSUFFICIENT_BUFFER block_counts is too small, *block_count contains the required count.
+     */
+    _Must_inspect_result_ ebpf_result_t
+    ebpf_program_get_block_counts(
+        fd_t fd,
+        _Out_writes_to_(*block_count, *block_count) uint64_t* block_counts,
+        _Inout_ uint32_t* block_count) EBPF_NO_EXCEPT;
+
     typedef struct _ebpf_stat
     {
         struct _ebpf_stat* next;
@@ -302,6 +322,36 @@ extern "C"
         size_t attach_parameters_size,
         _Outptr_ struct bpf_link** link) EBPF_NO_EXCEPT;
 
+    /**
+     * @brief Attach an eBPF program to a shared attach point that can have
+     *  more than one program attached. All programs attached this way with the
+     *  same attach type and attach parameters are invoked in ascending priority
+     *  order until one of them returns a value other than the continue verdict.
+     *  Programs with equal priority are invoked in the order they were attached.
+     *
+     * @param[in] program_fd An eBPF program file descriptor.
+     * @param[in] attach_type The attach type for attaching the program.
+     * @param[in] attach_parameters Optionally, attach parameters. This is an
+     *  opaque flat buffer containing the attach parameters which is interpreted
+     *  by the extension provider.
+     * @param[in] attach_parameters_size Size of the attach parameters.
+     * @param[in] options Priority and continue verdict for this program.
+     * @param[out] link Pointer to ebpf_link structure.
+     *
+     * @retval EBPF_SUCCESS The operation was successful.
+     * @retval EBPF_INVALID_FD The program file descriptor is not valid.
+     * @retval EBPF_INVALID_ARGUMENT The attach point already has programs
+     *  attached with a different continue verdict.
+     */
+    _Must_inspect_result_ ebpf_result_t
+    ebpf_program_attach_multi_by_fd(
+        fd_t program_fd,
+        _In_ const ebpf_attach_type_t* attach_type,
+        _In_reads_bytes_opt_(attach_parameters_size) void* attach_parameters,
+        size_t attach_parameters_size,
+        _In_ const ebpf_link_multi_attach_options_t* options,
+        _Outptr_ struct bpf_link** link) EBPF_NO_EXCEPT;
+
     /**
      * @brief Detach an eBPF program from an attach point represented by
      *  the bpf_link structure.
@@ -406,6 +456,356 @@ extern "C"
     ebpf_get_next_pinned_program_path(
         _In_z_ const char* start_path, _Out_writes_z_(EBPF_MAX_PIN_PATH_LENGTH) char* next_path) EBPF_NO_EXCEPT;
 
+    /**
+     * @brief Gets the pinned paths that start with a given prefix and follow a
+     * given path, in lexical order. The paths are returned as consecutive null
+     * terminated strings. To get the next page of paths, call this function
+     * again with the last path returned as start_path.
+     *
+     * @param[in] prefix Prefix of the paths to return, or "" for all paths.
+     *  To list a directory, the prefix must end with a separator.
+     * @param[in] start_path Path to look for entries greater than, or "" to
+     *  start from the first path.
+     * @param[out] paths Buffer that receives the paths.
+     * @param[in] paths_length Size in bytes of the buffer, which must be at
+     *  least EBPF_MAX_PIN_PATH_LENGTH to fit any path.
+     * @param[out] path_count Number of paths returned.
+     *
+     * @retval EBPF_SUCCESS The operation was successful.
+     * @retval EBPF_NO_MORE_KEYS No more entries found.
+     * @retval EBPF_INVALID_ARGUMENT The prefix or start path is too long.
+     * @retval EBPF_INSUFFICIENT_BUFFER The buffer is too small for the next
+     *  path.
+     */
+    _Must_inspect_result_ ebpf_result_t
+    ebpf_get_next_pinned_paths(
+        _In_z_ const char* prefix,
+        _In_z_ const char* start_path,
+        _Out_writes_bytes_(paths_length) char* paths,
+        size_t paths_length,
+        _Out_ uint32_t* path_count) EBPF_NO_EXCEPT;
+
+    /**
+     * @brief Unpin all objects pinned to a path that starts with a given
+     * prefix. To unpin a directory, the prefix must end with a separator.
+     *
+     * @param[in] prefix Prefix of the paths to unpin.
+     * @param[out] unpinned_count Optionally returns the number of paths
+     *  unpinned.
+     *
+     * @retval EBPF_SUCCESS The operation was successful.
+     * @retval EBPF_INVALID_ARGUMENT The prefix is empty or too long.
+     */
+    _Must_inspect_result_ ebpf_result_t
+    ebpf_object_unpin_prefix(_In_z_ const char* prefix, _Out_opt_ uint32_t* unpinned_count) EBPF_NO_EXCEPT;
+
+    /**
+     * @brief Get information about the links whose ID is greater than a given
+     * ID, in increasing order of ID. To get the next page of information, call
+     * this function again with the ID of the last link returned.
+     *
+     * @param[in] start_id ID to look for links after, or 0 to start from the
+     *  first link.
+     * @param[out] info Array that receives the information about the links.
+     * @param[in, out] info_count On input, the number of entries in info. On
+     *  output, the number of entries returned.
+     *
+     * @retval EBPF_SUCCESS The operation was successful.
+     * @retval EBPF_NO_MORE_KEYS No more links found.
+     * @retval EBPF_INVALID_ARGUMENT info_count is 0.
+     */
+    _Must_inspect_result_ ebpf_result_t
+    ebpf_get_next_link_info(
+        ebpf_id_t start_id,
+        _Out_writes_to_(*info_count, *info_count) struct bpf_link_info* info,
+        _Inout_ uint32_t* info_count) EBPF_NO_EXCEPT;
+
+    /**
+     * @brief Get information about the maps whose ID is greater than a given
+     * ID, in increasing order of ID. To get the next page of information, call
+     * this function again with the ID of the last map returned.
+     *
+     * @param[in] start_id ID to look for maps after, or 0 to start from the
+     *  first map.
+     * @param[out] info Array that receives the information about the maps.
+     * @param[in, out] info_count On input, the number of entries in info. On
+     *  output, the number of entries returned.
+     *
+     * @retval EBPF_SUCCESS The operation was successful.
+     * @retval EBPF_NO_MORE_KEYS No more maps found.
+     * @retval EBPF_INVALID_ARGUMENT info_count is 0.
+     */
+    _Must_inspect_result_ ebpf_result_t
+    ebpf_get_next_map_info(
+        ebpf_id_t start_id,
+        _Out_writes_to_(*info_count, *info_count) struct bpf_map_info* info,
+        _Inout_ uint32_t* info_count) EBPF_NO_EXCEPT;
+
+    /**
+     * @brief Get information about the programs whose ID is greater than a
+     * given ID, in increasing order of ID. To get the next page of information,
+     * call this function again with the ID of the last program returned. The
+     * map IDs of the programs aren't returned.
+     *
+     * @param[in] start_id ID to look for programs after, or 0 to start from
+     *  the first program.
+     * @param[out] info Array that receives the information about the programs.
+     * @param[in, out] info_count On input, the number of entries in info. On
+     *  output, the number of entries returned.
+     *
+     * @retval EBPF_SUCCESS The operation was successful.
+     * @retval EBPF_NO_MORE_KEYS No more programs found.
+     * @retval EBPF_INVALID_ARGUMENT info_count is 0.
+     */
+    _Must_inspect_result_ ebpf_result_t
+    ebpf_get_next_program_info(
+        ebpf_id_t start_id,
+        _Out_writes_to_(*info_count, *info_count) struct bpf_prog_info* info,
+        _Inout_ uint32_t* info_count) EBPF_NO_EXCEPT;
+
+    /**
+     * @brief Get the state of epoch based memory reclamation in the execution context.
+     *
+     * @param[out] statistics Global epoch statistics.
+     * @param[out] cpu_statistics Array that receives the statistics of each CPU.
+     * @param[in, out] cpu_count On input, the number of entries in cpu_statistics. On output, the number of CPUs.
+     *
+     * @retval EBPF_SUCCESS The operation was successful.
+     * @retval EBPF_INSUFFICIENT_BUFFER cpu_statistics is too small, *cpu_count contains the required count.
+     */
+    _Must_inspect_result_ ebpf_result_t
+    ebpf_get_epoch_statistics(
+        _Out_ ebpf_epoch_statistics_t* statistics,
+        _Out_writes_opt_(*cpu_count) ebpf_epoch_cpu_statistics_t* cpu_statistics,
+        _Inout_ uint32_t* cpu_count) EBPF_NO_EXCEPT;
+
+    /**
+     * @brief Set the number of bytes pending reclamation on a CPU above which
+     * the execution context flushes epochs more frequently.
+     *
+     * @param[in] threshold_in_bytes Backlog threshold in bytes, or 0 to disable.
+     *
+     * @retval EBPF_SUCCESS The operation was successful.
+     */
+    _Must_inspect_result_ ebpf_result_t
+    ebpf_set_epoch_backlog_threshold(uint64_t threshold_in_bytes) EBPF_NO_EXCEPT;
+
+    /**
+     * @brief Submission and completion queues, in memory shared with the
+     * execution context, through which map operations are executed in bulk
+     * without a system call per operation. A map queue must not be used by
+     * more than one thread at a time.
+     */
+    typedef struct _ebpf_map_queue ebpf_map_queue_t;
+
+    typedef struct _ebpf_map_queue_completion
+    {
+        uint64_t user_data;   ///< Value passed to ebpf_map_queue_post.
+        ebpf_result_t result; ///< Result of the operation.
+    } ebpf_map_queue_completion_t;
+
+    /**
+     * @brief Create a map queue.
+     *
+     * @param[in] entry_count Maximum number of operations in flight. Must be a
+     *  power of two.
+     * @param[in] slot_size Maximum size of the key and value of an operation.
+     * @param[out] queue Pointer to memory that will contain the map queue on
+     *  success.
+     *
+     * @retval EBPF_SUCCESS The operation was successful.
+     * @retval EBPF_INVALID_ARGUMENT One or more parameters are invalid.
+     * @retval EBPF_NO_MEMORY Unable to allocate resources for this map queue.
+     */
+    _Must_inspect_result_ ebpf_result_t
+    ebpf_map_queue_create(uint32_t entry_count, uint32_t slot_size, _Outptr_ ebpf_map_queue_t** queue) EBPF_NO_EXCEPT;
+
+    /**
+     * @brief Destroy a map queue. Completions that have not been reaped are
+     * discarded.
+     *
+     * @param[in] queue Map queue to destroy.
+     */
+    void
+    ebpf_map_queue_destroy(_In_opt_ _Post_invalid_ ebpf_map_queue_t* queue) EBPF_NO_EXCEPT;
+
+    /**
+     * @brief Post a map operation to a map queue. The operation is executed by
+     * the next call to ebpf_map_queue_submit.
+     *
+     * @param[in, out] queue Map queue to post the operation to.
+     * @param[in] operation Operation to execute.
+     * @param[in] map_fd File descriptor of the map.
+     * @param[in] key Key of the operation, copied before this function returns.
+     * @param[in, out] value For an update, the value to store, copied before
+     *  this function returns. For a find, the buffer that receives the value
+     *  when the completion is reaped. Ignored for a delete.
+     * @param[in] flags For an update, one of EBPF_ANY, EBPF_NOEXIST or
+     *  EBPF_EXIST. Ignored otherwise.
+     * @param[in] user_data Value returned in the completion of the operation.
+     *
+     * @retval EBPF_SUCCESS The operation was successful.
+     * @retval EBPF_INVALID_ARGUMENT One or more parameters are invalid, or the
+     *  key and value don't fit in a slot.
+     * @retval EBPF_INVALID_FD map_fd is not a valid file descriptor.
+     * @retval EBPF_OPERATION_NOT_SUPPORTED The map stores object handles.
+     * @retval EBPF_OUT_OF_SPACE The maximum number of operations are in
+     *  flight. Submit them and reap their completions first.
+     */
+    _Must_inspect_result_ ebpf_result_t
+    ebpf_map_queue_post(
+        _Inout_ ebpf_map_queue_t* queue,
+        ebpf_map_queue_operation_t operation,
+        fd_t map_fd,
+        _In_opt_ const void* key,
+        _Inout_opt_ void* value,
+        uint64_t flags,
+        uint64_t user_data) EBPF_NO_EXCEPT;
+
+    /**
+     * @brief Execute the operations posted to a map queue and post their
+     * completions. This is the only call that enters the execution context.
+     *
+     * @param[in, out] queue Map queue to submit.
+     * @param[out] completed_count Number of operations executed.
+     *
+     * @retval EBPF_SUCCESS The operation was successful.
+     * @retval EBPF_INVALID_ARGUMENT The map queue is corrupt.
+     */
+    _Must_inspect_result_ ebpf_result_t
+    ebpf_map_queue_submit(_Inout_ ebpf_map_queue_t* queue, _Out_opt_ uint32_t* completed_count) EBPF_NO_EXCEPT;
+
+    /**
+     * @brief Reap the completions of executed operations, in the order the
+     * operations were posted, and copy the values found by find operations to
+     * the buffers passed to ebpf_map_queue_post.
+     *
+     * @param[in, out] queue Map queue to reap completions from.
+     * @param[out] completions Array that receives the completions.
+     * @param[in] completion_count Number of entries in completions.
+     * @param[out] reaped_count Number of completions returned.
+     */
+    void
+    ebpf_map_queue_reap(
+        _Inout_ ebpf_map_queue_t* queue,
+        _Out_writes_to_(completion_count, *reaped_count) ebpf_map_queue_completion_t* completions,
+        uint32_t completion_count,
+        _Out_ uint32_t* reaped_count) EBPF_NO_EXCEPT;
+
+    /**
+     * @brief Callback invoked when an asynchronous map operation completes.
+     *
+     * @param[in, out] context Context passed to the function that started the
+     *  operation.
+     * @param[in] result Result of the operation.
+     */
+    typedef void (*ebpf_map_async_completion_t)(_Inout_opt_ void* context, ebpf_result_t result);
+
+    /**
+     * @brief Start looking up an element in an eBPF map. The completion
+     * callback is invoked on a thread pool thread once the operation
+     * completes, and is never invoked from within this function.
+     *
+     * @param[in] map_fd File descriptor for the eBPF map.
+     * @param[in] key Pointer to buffer containing key, or NULL for a map with
+     *  no keys. Must remain valid until the completion callback is invoked.
+     * @param[out] value Pointer to buffer that contains the value on
+     *  successful completion. Must remain valid until the completion callback
+     *  is invoked.
+     * @param[in] completion Callback to invoke when the operation completes.
+     * @param[in, out] completion_context Context to pass to the callback.
+     *
+     * @retval EBPF_SUCCESS The operation was started, and the completion
+     *  callback will be invoked exactly once.
+     * @retval EBPF_INVALID_ARGUMENT One or more parameters are invalid.
+     * @retval EBPF_INVALID_FD map_fd is not a valid file descriptor.
+     * @retval EBPF_NO_MEMORY Out of memory.
+     */
+    _Must_inspect_result_ ebpf_result_t
+    ebpf_map_lookup_element_async(
+        fd_t map_fd,
+        _In_opt_ const void* key,
+        _Out_ void* value,
+        ebpf_map_async_completion_t completion,
+        _Inout_opt_ void* completion_context) EBPF_NO_EXCEPT;
+
+    /**
+     * @brief Start updating an element in an eBPF map. The completion
+     * callback is invoked on a thread pool thread once the operation
+     * completes, and is never invoked from within this function.
+     *
+     * @param[in] map_fd File descriptor for the eBPF map.
+     * @param[in] key Pointer to buffer containing key, or NULL for a map with
+     *  no keys. Must remain valid until the completion callback is invoked.
+     * @param[in] value Pointer to buffer containing the value. Must remain
+     *  valid until the completion callback is invoked.
+     * @param[in] flags One of EBPF_ANY, EBPF_NOEXIST or EBPF_EXIST.
+     * @param[in] completion Callback to invoke when the operation completes.
+     * @param[in, out] completion_context Context to pass to the callback.
+     *
+     * @retval EBPF_SUCCESS The operation was started, and the completion
+     *  callback will be invoked exactly once.
+     * @retval EBPF_INVALID_ARGUMENT One or more parameters are invalid.
+     * @retval EBPF_INVALID_FD map_fd is not a valid file descriptor.
+     * @retval EBPF_NO_MEMORY Out of memory.
+     */
+    _Must_inspect_result_ ebpf_result_t
+    ebpf_map_update_element_async(
+        fd_t map_fd,
+        _In_opt_ const void* key,
+        _In_ const void* value,
+        uint64_t flags,
+        ebpf_map_async_completion_t completion,
+        _Inout_opt_ void* completion_context) EBPF_NO_EXCEPT;
+
+    /**
+     * @brief Start deleting an element from an eBPF map. The completion
+     * callback is invoked on a thread pool thread once the operation
+     * completes, and is never invoked from within this function.
+     *
+     * @param[in] map_fd File descriptor for the eBPF map.
+     * @param[in] key Pointer to buffer containing key. Must remain valid until
+     *  the completion callback is invoked.
+     * @param[in] completion Callback to invoke when the operation completes.
+     * @param[in, out] completion_context Context to pass to the callback.
+     *
+     * @retval EBPF_SUCCESS The operation was started, and the completion
+     *  callback will be invoked exactly once.
+     * @retval EBPF_INVALID_ARGUMENT One or more parameters are invalid.
+     * @retval EBPF_INVALID_FD map_fd is not a valid file descriptor.
+     * @retval EBPF_NO_MEMORY Out of memory.
+     */
+    _Must_inspect_result_ ebpf_result_t
+    ebpf_map_delete_element_async(
+        fd_t map_fd,
+        _In_ const void* key,
+        ebpf_map_async_completion_t completion,
+        _Inout_opt_ void* completion_context) EBPF_NO_EXCEPT;
+
+    /**
+     * @brief Batch ring buffer notifications: the consumer of a ring buffer
+     * map is only notified once a threshold is reached, or once the oldest
+     * unnotified data has waited for the maximum latency. Records written
+     * with BPF_RB_FORCE_WAKEUP notify the consumer immediately.
+     *
+     * @param[in] map_fd File descriptor for the ring buffer map.
+     * @param[in] wakeup_bytes Number of unconsumed bytes that notifies the
+     *  consumer, or 0 for no byte threshold.
+     * @param[in] wakeup_records Number of records written since the last
+     *  notification that notifies the consumer, or 0 for no record threshold.
+     * @param[in] max_wakeup_latency_us Maximum time in microseconds before
+     *  the consumer is notified of pending data, or 0 to wait for a threshold.
+     *  When both thresholds are 0, the consumer is notified of every record.
+     *
+     * @retval EBPF_SUCCESS The operation was successful.
+     * @retval EBPF_INVALID_ARGUMENT map_fd is not a ring buffer map.
+     * @retval EBPF_INVALID_FD map_fd is not a valid file descriptor.
+     * @retval EBPF_NO_MEMORY Out of memory.
+     */
+    _Must_inspect_result_ ebpf_result_t
+    ebpf_map_set_ring_buffer_wakeup_thresholds(
+        fd_t map_fd, uint32_t wakeup_bytes, uint32_t wakeup_records, uint32_t max_wakeup_latency_us) EBPF_NO_EXCEPT;
+
     typedef struct _ebpf_program_info ebpf_program_info_t;
 
     /**
@@ -420,6 +820,20 @@ extern "C"
     _Must_inspect_result_ ebpf_result_t
     ebpf_get_program_info_from_verifier(_Outptr_ const ebpf_program_info_t** program_info) EBPF_NO_EXCEPT;
 
+    /**
+     * @brief Get the program information that the verifier uses for a
+     * program type.
+     *
+     * @param[in] program_type Program type to get the information of.
+     * @param[out] program_info Pointer to the program information. The
+     * pointer is only valid on the calling thread.
+     * @retval EBPF_SUCCESS The operation was successful.
+     * @retval EBPF_OBJECT_NOT_FOUND No program information was found.
+     */
+    _Must_inspect_result_ ebpf_result_t
+    ebpf_get_program_info_by_type(
+        _In_ const ebpf_program_type_t* program_type, _Outptr_ const ebpf_program_info_t** program_info) EBPF_NO_EXCEPT;
+
     typedef struct _ebpf_test_run_options
     {
         _Readable_bytes_(data_size_in) const uint8_t* data_in; ///< Input data to the program.
@@ -29,3 +29,49 @@ typedef struct _ebpf_ring_buffer_map_async_query_result
     size_t producer;
     size_t consumer;
 } ebpf_ring_buffer_map_async_query_result_t;
+
+/**
+ * @brief Options for attaching a program to a shared attach point that can
+ * have more than one program attached.
+ */
+typedef struct _ebpf_link_multi_attach_options
+{
+    int32_t priority;          ///< Lower values are invoked first.
+    uint32_t continue_verdict; ///< Program return value that causes the next program to be invoked.
+} ebpf_link_multi_attach_options_t;
+
+/**
+ * @brief Epoch reclamation state of a single CPU.
+ */
+typedef struct _ebpf_epoch_cpu_statistics
+{
+    uint64_t pending_blocks;           ///< Memory blocks waiting in the free list for their epoch to be released.
+    uint64_t pending_bytes;            ///< Size in bytes of the pending memory blocks.
+    uint64_t pending_work_items;       ///< Work items waiting in the free list for their epoch to be released.
+    uint64_t oldest_pending_epoch_age; ///< Number of epochs since the oldest pending entry was freed, 0 if none.
+} ebpf_epoch_cpu_statistics_t;
+
+/**
+ * @brief Epoch reclamation state shared by all CPUs.
+ */
+typedef struct _ebpf_epoch_statistics
+{
+    uint64_t current_epoch;              ///< Newest active epoch.
+    uint64_t release_epoch;              ///< Newest epoch whose entries can be released.
+    uint64_t flush_timer_fires;          ///< Number of times the flush timer ran.
+    uint64_t stale_worker_runs;          ///< Number of times a per-CPU stale worker was queued.
+    uint64_t stale_thread_detections;    ///< Number of times a thread was found in an epoch for too long.
+    uint64_t accelerated_flushes;        ///< Number of times the flush timer was armed with the backlog delay.
+    uint64_t backlog_threshold_in_bytes; ///< Pending bytes on a CPU above which the flush delay is shortened.
+} ebpf_epoch_statistics_t;
+
+/**
+ * @brief Map operation posted to a map queue.
+ */
+typedef enum _ebpf_map_queue_operation
+{
+    EBPF_MAP_QUEUE_OPERATION_FIND,            ///< Copy the value of a key.
+    EBPF_MAP_QUEUE_OPERATION_FIND_AND_DELETE, ///< Copy the value of a key and delete the key.
+    EBPF_MAP_QUEUE_OPERATION_UPDATE,          ///< Insert or update the value of a key.
+    EBPF_MAP_QUEUE_OPERATION_DELETE,          ///< Delete a key.
+} ebpf_map_queue_operation_t;
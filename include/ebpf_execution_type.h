@@ -10,10 +10,11 @@ extern "C"
 
     typedef enum _ebpf_execution_type
     {
-        EBPF_EXECUTION_ANY,       ///< Execute in JIT-compiled or interpreted mode, per system policy.
-        EBPF_EXECUTION_JIT,       ///< Execute in JIT-compiled mode.
-        EBPF_EXECUTION_INTERPRET, ///< Execute in interpreted mode.
-        EBPF_EXECUTION_NATIVE     ///< Execute from native driver.
+        EBPF_EXECUTION_ANY,               ///< Execute in JIT-compiled or interpreted mode, per system policy.
+        EBPF_EXECUTION_JIT,               ///< Execute in JIT-compiled mode.
+        EBPF_EXECUTION_INTERPRET,         ///< Execute in interpreted mode.
+        EBPF_EXECUTION_NATIVE,            ///< Execute from native driver.
+        EBPF_EXECUTION_INTERPRET_THREADED ///< Execute in interpreted mode using pre-decoded threaded code.
     } ebpf_execution_type_t;
 
 #ifdef __cplusplus
@@ -154,6 +154,7 @@ typedef enum
     BPF_FUNC_map_pop_elem = 17,              ///< \ref bpf_map_pop_elem
     BPF_FUNC_map_peek_elem = 18,             ///< \ref bpf_map_peek_elem
     BPF_FUNC_get_current_pid_tgid = 19,      ///< \ref bpf_get_current_pid_tgid
+    BPF_FUNC_loop = 20,                      ///< \ref bpf_loop
 } ebpf_helper_id_t;
 
 // Cross-platform BPF program types.
@@ -360,6 +361,10 @@ struct bpf_map_info
 #define BPF_NOEXIST 0x1
 #define BPF_EXIST 0x2
 
+// Flags for bpf_ringbuf_output.
+#define BPF_RB_NO_WAKEUP 0x1    ///< Don't notify the consumer of this record.
+#define BPF_RB_FORCE_WAKEUP 0x2 ///< Notify the consumer regardless of the wakeup thresholds.
+
 /**
  * @brief eBPF program information.  This structure can be retrieved by calling
  * \ref bpf_obj_get_info_by_fd on a program fd.
@@ -69,8 +69,11 @@ enum bpf_cmd_id
     BPF_PROG_BIND_MAP,
     BPF_PROG_TEST_RUN,
     BPF_PROG_RUN = BPF_PROG_TEST_RUN,
+    BPF_LINK_UPDATE,
 };
 
+#define BPF_F_REPLACE 0x04 ///< Only update the link if old_prog_fd is the attached program.
+
 /// Attributes used by BPF_OBJ_GET_INFO_BY_FD.
 typedef struct
 {
@@ -90,6 +93,15 @@ typedef struct
     uint32_t link_fd; ///< File descriptor of link to detach.
 } bpf_link_detach_attr_t;
 
+/// Attributes used by BPF_LINK_UPDATE.
+typedef struct
+{
+    uint32_t link_fd;     ///< File descriptor of link to update.
+    uint32_t new_prog_fd; ///< File descriptor of program to attach to the link.
+    uint32_t flags;       ///< Flags affecting the update operation.
+    uint32_t old_prog_fd; ///< File descriptor of program expected to be attached, if BPF_F_REPLACE is set.
+} bpf_link_update_attr_t;
+
 /// Attributes used by BPF_PROG_BIND_MAP.
 typedef struct
 {
@@ -208,6 +220,9 @@ union bpf_attr
         uint32_t cpu;           ///< CPU to run the program on.
         uint32_t batch_size;    ///< Number of times to run the program in a batch.
     } test;                     ///< Attributes used by BPF_PROG_TEST_RUN.
+
+    // BPF_LINK_UPDATE
+    bpf_link_update_attr_t link_update; ///< Attributes used by BPF_LINK_UPDATE.
 };
 #ifdef _MSC_VER
 #pragma warning(pop)
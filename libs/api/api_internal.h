@@ -11,6 +11,7 @@
 struct bpf_object;
 
 typedef struct _ebpf_ring_buffer_subscription ring_buffer_subscription_t;
+typedef struct _ebpf_ring_buffer_poller ebpf_ring_buffer_poller_t;
 
 typedef struct bpf_program
 {
@@ -330,6 +331,22 @@ ebpf_map_get_next_key(fd_t map_fd, _In_opt_ const void* previous_key, _Out_ void
 _Must_inspect_result_ ebpf_result_t
 ebpf_detach_link_by_fd(fd_t fd) noexcept;
 
+/**
+ * @brief Atomically replace the program attached to a link.
+ *
+ * @param[in] link_fd File descriptor for the link.
+ * @param[in] program_fd File descriptor for the program to attach.
+ * @param[in] old_program_fd File descriptor for the program that must currently
+ *  be attached, or ebpf_fd_invalid to replace any program.
+ *
+ * @retval EBPF_SUCCESS The operation was successful.
+ * @retval EBPF_INVALID_FD A file descriptor was not valid.
+ * @retval EBPF_INVALID_ARGUMENT The link is not attached, old_program_fd is
+ *  not the attached program, or the program type does not match the link.
+ */
+_Must_inspect_result_ ebpf_result_t
+ebpf_update_link_by_fd(fd_t link_fd, fd_t program_fd, fd_t old_program_fd) noexcept;
+
 /**
  * @brief Open a file descriptor for the map with a given ID.
  *
@@ -524,6 +541,79 @@ ebpf_ring_buffer_map_subscribe(
 bool
 ebpf_ring_buffer_map_unsubscribe(_In_ _Post_invalid_ ring_buffer_subscription_t* subscription) noexcept;
 
+/**
+ * @brief Create a ring buffer poller. Unlike a subscription, a poller only invokes the sample callbacks of its ring
+ * buffer maps from ebpf_ring_buffer_poller_consume and ebpf_ring_buffer_poller_poll, on the calling thread.
+ *
+ * @param[out] poller Pointer to memory that will contain the poller on success.
+ *
+ * @retval EBPF_SUCCESS The operation was successful.
+ * @retval EBPF_NO_MEMORY Out of memory.
+ */
+_Must_inspect_result_ ebpf_result_t
+ebpf_ring_buffer_poller_create(_Outptr_ ebpf_ring_buffer_poller_t** poller) noexcept;
+
+/**
+ * @brief Add a ring buffer map to a poller.
+ *
+ * @param[in, out] poller Poller to add the map to.
+ * @param[in] ring_buffer_map_fd File descriptor to the ring buffer map.
+ * @param[in] sample_callback Function invoked for each record of the map.
+ * @param[in, out] sample_callback_context Context passed to sample_callback.
+ *
+ * @retval EBPF_SUCCESS The operation was successful.
+ * @retval EBPF_INVALID_FD The file descriptor is not valid.
+ * @retval EBPF_INVALID_ARGUMENT The map is not a ring buffer map, or is already being polled or subscribed to.
+ * @retval EBPF_NO_MEMORY Out of memory.
+ */
+_Must_inspect_result_ ebpf_result_t
+ebpf_ring_buffer_poller_add(
+    _Inout_ ebpf_ring_buffer_poller_t* poller,
+    fd_t ring_buffer_map_fd,
+    ring_buffer_sample_fn sample_callback,
+    _Inout_opt_ void* sample_callback_context) noexcept;
+
+/**
+ * @brief Invoke the sample callback for every record available in the maps of a poller, without waiting. Maps with
+ * no new records cost no system call, so this can be called in a loop to busy-poll.
+ *
+ * @param[in, out] poller Poller to consume records from.
+ * @param[out] record_count Number of records consumed.
+ * @param[out] callback_result Negative value returned by a sample callback, which stops consumption, or 0.
+ *
+ * @retval EBPF_SUCCESS The operation was successful.
+ * @retval EBPF_NO_MEMORY Out of memory.
+ */
+_Must_inspect_result_ ebpf_result_t
+ebpf_ring_buffer_poller_consume(
+    _Inout_ ebpf_ring_buffer_poller_t* poller, _Out_ uint32_t* record_count, _Out_ int* callback_result) noexcept;
+
+/**
+ * @brief Wait until records are available in any map of a poller or the timeout expires, then consume them.
+ *
+ * @param[in, out] poller Poller to consume records from.
+ * @param[in] timeout_ms Maximum time to wait in milliseconds, or INFINITE.
+ * @param[out] record_count Number of records consumed.
+ * @param[out] callback_result Negative value returned by a sample callback, which stops consumption, or 0.
+ *
+ * @retval EBPF_SUCCESS The operation was successful.
+ * @retval EBPF_NO_MEMORY Out of memory.
+ */
+_Must_inspect_result_ ebpf_result_t
+ebpf_ring_buffer_poller_poll(
+    _Inout_ ebpf_ring_buffer_poller_t* poller,
+    uint32_t timeout_ms,
+    _Out_ uint32_t* record_count,
+    _Out_ int* callback_result) noexcept;
+
+/**
+ * @brief Stop polling the maps of a poller and free it.
+ *
+ * @param[in] poller Poller to free.
+ */
+void
+ebpf_ring_buffer_poller_destroy(_In_opt_ _Post_invalid_ ebpf_ring_buffer_poller_t* poller) noexcept;
+
 /**
  * @brief Get list of programs and stats in an ELF eBPF file.
  * @param[in] file Name of ELF file containing eBPF program.
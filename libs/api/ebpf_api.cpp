@@ -4,6 +4,7 @@
 #define _SILENCE_CXX17_CODECVT_HEADER_DEPRECATION_WARNING
 #include "pch.h"
 
+#include <atomic>
 #include <codecvt>
 #include <fcntl.h>
 #include <io.h>
@@ -48,6 +49,34 @@ static std::map<ebpf_handle_t, ebpf_program_t*> _ebpf_programs;
 static std::map<ebpf_handle_t, ebpf_map_t*> _ebpf_maps;
 static std::vector<ebpf_object_t*> _ebpf_objects;
 
+// Largest file descriptor whose map properties are cached for map element operations.
+#define EBPF_MAP_ELEMENT_DESCRIPTOR_CACHE_MAX_FD 8192
+
+typedef struct _ebpf_map_element_descriptor
+{
+    ebpf_handle_t handle; // Handle the properties were read for, or ebpf_handle_invalid if the entry is unused.
+    uint64_t generation;  // File descriptor generation the properties were read at.
+    uint32_t type;
+    uint32_t key_size;
+    uint32_t value_size; // Size of a value as exchanged with the execution context.
+} ebpf_map_element_descriptor_t;
+
+// Per-thread state that lets steady-state map element operations run without heap allocations or map definition
+// queries. Descriptors are indexed by file descriptor, and the protocol buffers only ever grow.
+typedef struct _ebpf_map_element_thread_state
+{
+    std::vector<ebpf_map_element_descriptor_t> descriptors;
+    ebpf_protocol_buffer_t request_buffer;
+    ebpf_protocol_buffer_t reply_buffer;
+} ebpf_map_element_thread_state_t;
+
+thread_local static ebpf_map_element_thread_state_t _ebpf_map_element_thread_state;
+
+// Incremented each time this library creates a file descriptor. A closed file descriptor, and the handle value behind
+// it, can only come to refer to another map through a new file descriptor, so a cached descriptor read at an older
+// generation is never trusted, no matter how the original file descriptor was closed.
+static std::atomic<uint64_t> _ebpf_file_descriptor_generation;
+
 #define DEFAULT_PIN_ROOT_PATH "/ebpf/global"
 
 #define SERVICE_PATH_PREFIX L"\\Registry\\Machine\\System\\CurrentControlSet\\Services\\"
@@ -115,6 +144,7 @@ _ebpf_get_section_string(
 static fd_t
 _create_file_descriptor_for_handle(ebpf_handle_t handle) noexcept
 {
+    _ebpf_file_descriptor_generation++;
     return Platform::_open_osfhandle(handle, 0);
 }
 
@@ -344,10 +374,10 @@ _map_lookup_element(
     ebpf_result_t result = EBPF_SUCCESS;
     ebpf_assert(value);
     try {
-        ebpf_protocol_buffer_t request_buffer(
-            EBPF_OFFSET_OF(ebpf_operation_map_find_element_request_t, key) + key_size);
-        ebpf_protocol_buffer_t reply_buffer(
-            EBPF_OFFSET_OF(ebpf_operation_map_find_element_reply_t, value) + value_size);
+        ebpf_protocol_buffer_t& request_buffer = _ebpf_map_element_thread_state.request_buffer;
+        ebpf_protocol_buffer_t& reply_buffer = _ebpf_map_element_thread_state.reply_buffer;
+        request_buffer.resize(EBPF_OFFSET_OF(ebpf_operation_map_find_element_request_t, key) + key_size);
+        reply_buffer.resize(EBPF_OFFSET_OF(ebpf_operation_map_find_element_reply_t, value) + value_size);
         auto request = reinterpret_cast<ebpf_operation_map_find_element_request_t*>(request_buffer.data());
         auto reply = reinterpret_cast<ebpf_operation_map_find_element_reply_t*>(reply_buffer.data());
 
@@ -419,48 +449,153 @@ Exit:
     EBPF_RETURN_RESULT(result);
 }
 
+/**
+ * @brief Get the properties of a map as used by map element operations.
+ *
+ * @param[in] map_handle Handle to the map.
+ * @param[out] descriptor Receives the handle and properties of the map.
+ *
+ * @retval EBPF_SUCCESS The operation was successful.
+ * @retval EBPF_INVALID_ARGUMENT The handle does not refer to a map.
+ */
 static ebpf_result_t
-_ebpf_map_lookup_element_helper(fd_t map_fd, bool find_and_delete, _In_opt_ const void* key, _Out_ void* value) noexcept
+_query_map_element_descriptor(ebpf_handle_t map_handle, _Out_ ebpf_map_element_descriptor_t* descriptor) noexcept
 {
-    EBPF_LOG_ENTRY();
-    ebpf_result_t result = EBPF_SUCCESS;
-    ebpf_handle_t map_handle;
-    uint32_t key_size = 0;
-    uint32_t value_size = 0;
-    uint32_t max_entries = 0;
-    uint32_t type;
+    uint32_t max_entries;
 
-    ebpf_assert(value);
-    if (map_fd <= 0) {
-        result = EBPF_INVALID_ARGUMENT;
-        goto Exit;
+    descriptor->handle = map_handle;
+    descriptor->generation = _ebpf_file_descriptor_generation;
+    ebpf_result_t result = _get_map_descriptor_properties(
+        map_handle, &descriptor->type, &descriptor->key_size, &descriptor->value_size, &max_entries);
+    if (result != EBPF_SUCCESS) {
+        return result;
     }
-    *((uint8_t*)value) = 0;
+    if (BPF_MAP_TYPE_PER_CPU(descriptor->type)) {
+        descriptor->value_size = EBPF_PAD_8(descriptor->value_size) * libbpf_num_possible_cpus();
+    }
+    return EBPF_SUCCESS;
+}
+
+/**
+ * @brief Get the handle and properties of the map that a file descriptor refers to. The properties are cached per
+ * thread and per file descriptor, and a cache entry is used only while the file descriptor maps to the same handle and
+ * no file descriptor has been created since the entry was filled.
+ *
+ * @param[in] map_fd File descriptor of the map.
+ * @param[in] refresh If true, ignore the cache entry and query the properties again.
+ * @param[out] descriptor Receives the handle and properties of the map.
+ * @param[out] cached Set to true if the properties came from the cache.
+ *
+ * @retval EBPF_SUCCESS The operation was successful.
+ * @retval EBPF_INVALID_FD The file descriptor is not valid.
+ * @retval EBPF_INVALID_ARGUMENT The file descriptor does not refer to a map.
+ */
+static ebpf_result_t
+_get_map_element_descriptor(
+    fd_t map_fd, bool refresh, _Out_ ebpf_map_element_descriptor_t* descriptor, _Out_ bool* cached) noexcept
+{
+    std::vector<ebpf_map_element_descriptor_t>& descriptors = _ebpf_map_element_thread_state.descriptors;
+    size_t index = static_cast<size_t>(map_fd);
+    ebpf_handle_t map_handle;
+    ebpf_result_t result;
 
+    *cached = false;
     map_handle = _get_handle_from_file_descriptor(map_fd);
     if (map_handle == ebpf_handle_invalid) {
-        result = EBPF_INVALID_FD;
-        goto Exit;
+        descriptor->handle = ebpf_handle_invalid;
+        return EBPF_INVALID_FD;
+    }
+
+    if (!refresh && index < descriptors.size() && descriptors[index].handle == map_handle &&
+        descriptors[index].generation == _ebpf_file_descriptor_generation) {
+        *descriptor = descriptors[index];
+        *cached = true;
+        return EBPF_SUCCESS;
     }
 
-    // Get map properties, either from local cache or from EC.
-    result = _get_map_descriptor_properties(map_handle, &type, &key_size, &value_size, &max_entries);
+    result = _query_map_element_descriptor(map_handle, descriptor);
     if (result != EBPF_SUCCESS) {
-        goto Exit;
+        if (index < descriptors.size()) {
+            descriptors[index].handle = ebpf_handle_invalid;
+        }
+        return result;
+    }
+
+    if (index < EBPF_MAP_ELEMENT_DESCRIPTOR_CACHE_MAX_FD) {
+        try {
+            if (index >= descriptors.size()) {
+                descriptors.resize(index + 1, {ebpf_handle_invalid});
+            }
+            descriptors[index] = *descriptor;
+        } catch (const std::bad_alloc&) {
+            // Leave the file descriptor uncached; the next operation queries the properties again.
+        }
+    }
+    return EBPF_SUCCESS;
+}
+
+/**
+ * @brief Check whether a map element operation that failed could have failed because it used stale cached
+ * properties. The generation check catches file descriptors reused for another map before the operation is issued,
+ * but another thread can still close and reuse the file descriptor while the operation is in flight. If that surfaces
+ * as one of these errors, the operation is retried with refreshed properties.
+ */
+static inline bool
+_map_element_descriptor_may_be_stale(ebpf_result_t result, bool cached) noexcept
+{
+    return cached && (result == EBPF_INVALID_ARGUMENT || result == EBPF_INVALID_OBJECT ||
+                      result == EBPF_OPERATION_NOT_SUPPORTED);
+}
+
+static ebpf_result_t
+_map_lookup_element_with_descriptor(
+    _In_ const ebpf_map_element_descriptor_t* descriptor,
+    bool find_and_delete,
+    _In_opt_ const void* key,
+    _Out_ void* value) noexcept
+{
+    if ((key == nullptr) != (descriptor->key_size == 0)) {
+        return EBPF_INVALID_ARGUMENT;
     }
-    if ((key == nullptr) != (key_size == 0)) {
+    assert(descriptor->value_size != 0);
+
+    return _map_lookup_element(
+        descriptor->handle,
+        find_and_delete,
+        descriptor->key_size,
+        (uint8_t*)key,
+        descriptor->value_size,
+        (uint8_t*)value);
+}
+
+static ebpf_result_t
+_ebpf_map_lookup_element_helper(fd_t map_fd, bool find_and_delete, _In_opt_ const void* key, _Out_ void* value) noexcept
+{
+    EBPF_LOG_ENTRY();
+    ebpf_result_t result = EBPF_SUCCESS;
+    ebpf_map_element_descriptor_t descriptor;
+    bool cached;
+
+    ebpf_assert(value);
+    if (map_fd <= 0) {
         result = EBPF_INVALID_ARGUMENT;
         goto Exit;
     }
-    assert(value_size != 0);
-    if (BPF_MAP_TYPE_PER_CPU(type)) {
-        value_size = EBPF_PAD_8(value_size) * libbpf_num_possible_cpus();
-    }
+    *((uint8_t*)value) = 0;
 
-    result = _map_lookup_element(map_handle, find_and_delete, key_size, (uint8_t*)key, value_size, (uint8_t*)value);
+    // Get map properties, either from the per-thread cache, the local cache or from EC.
+    result = _get_map_element_descriptor(map_fd, false, &descriptor, &cached);
     if (result != EBPF_SUCCESS) {
         goto Exit;
     }
+    result = _map_lookup_element_with_descriptor(&descriptor, find_and_delete, key, value);
+    if (_map_element_descriptor_may_be_stale(result, cached)) {
+        result = _get_map_element_descriptor(map_fd, true, &descriptor, &cached);
+        if (result != EBPF_SUCCESS) {
+            goto Exit;
+        }
+        result = _map_lookup_element_with_descriptor(&descriptor, find_and_delete, key, value);
+    }
 
 Exit:
     EBPF_RETURN_RESULT(result);
@@ -494,7 +629,7 @@ _update_map_element(
 {
     EBPF_LOG_ENTRY();
     ebpf_result_t result;
-    ebpf_protocol_buffer_t request_buffer;
+    ebpf_protocol_buffer_t& request_buffer = _ebpf_map_element_thread_state.request_buffer;
     ebpf_operation_map_update_element_request_t* request;
     ebpf_assert(value);
     ebpf_assert(key || !key_size);
@@ -536,8 +671,12 @@ _update_map_element_with_handle(
 {
     EBPF_LOG_ENTRY();
     ebpf_assert(key);
-    ebpf_protocol_buffer_t request_buffer(
-        EBPF_OFFSET_OF(ebpf_operation_map_update_element_with_handle_request_t, key) + key_size);
+    ebpf_protocol_buffer_t& request_buffer = _ebpf_map_element_thread_state.request_buffer;
+    try {
+        request_buffer.resize(EBPF_OFFSET_OF(ebpf_operation_map_update_element_with_handle_request_t, key) + key_size);
+    } catch (const std::bad_alloc&) {
+        EBPF_RETURN_RESULT(EBPF_NO_MEMORY);
+    }
     auto request = reinterpret_cast<ebpf_operation_map_update_element_with_handle_request_t*>(request_buffer.data());
 
     request->header.length = static_cast<uint16_t>(request_buffer.size());
@@ -550,16 +689,47 @@ _update_map_element_with_handle(
     EBPF_RETURN_RESULT(win32_error_code_to_ebpf_result(invoke_ioctl(request_buffer)));
 }
 
+static ebpf_result_t
+_update_map_element_with_descriptor(
+    _In_ const ebpf_map_element_descriptor_t* descriptor,
+    _In_opt_ const void* key,
+    _In_ const void* value,
+    uint64_t flags) noexcept
+{
+    if ((key == nullptr) != (descriptor->key_size == 0)) {
+        return EBPF_INVALID_ARGUMENT;
+    }
+    assert(descriptor->value_size != 0);
+    assert(descriptor->type != 0);
+
+    if ((descriptor->type == BPF_MAP_TYPE_PROG_ARRAY) || (descriptor->type == BPF_MAP_TYPE_HASH_OF_MAPS) ||
+        (descriptor->type == BPF_MAP_TYPE_ARRAY_OF_MAPS)) {
+        fd_t fd = *(fd_t*)value;
+        ebpf_handle_t handle = ebpf_handle_invalid;
+        // If the fd is valid, resolve it to a handle, else pass ebpf_handle_invalid to the IOCTL.
+        if (fd != ebpf_fd_invalid) {
+            handle = _get_handle_from_file_descriptor(fd);
+            if (handle == ebpf_handle_invalid) {
+                return EBPF_INVALID_FD;
+            }
+        }
+
+        assert(descriptor->key_size != 0);
+        __analysis_assume(descriptor->key_size != 0);
+        return _update_map_element_with_handle(
+            descriptor->handle, descriptor->key_size, (const uint8_t*)key, handle, flags);
+    } else {
+        return _update_map_element(descriptor->handle, key, descriptor->key_size, value, descriptor->value_size, flags);
+    }
+}
+
 _Must_inspect_result_ ebpf_result_t
 ebpf_map_update_element(fd_t map_fd, _In_opt_ const void* key, _In_ const void* value, uint64_t flags) noexcept
 {
     EBPF_LOG_ENTRY();
     ebpf_result_t result = EBPF_SUCCESS;
-    ebpf_handle_t map_handle;
-    uint32_t key_size = 0;
-    uint32_t value_size = 0;
-    uint32_t max_entries = 0;
-    uint32_t type;
+    ebpf_map_element_descriptor_t descriptor;
+    bool cached;
 
     ebpf_assert(value);
     if (map_fd <= 0) {
@@ -575,145 +745,107 @@ ebpf_map_update_element(fd_t map_fd, _In_opt_ const void* key, _In_ const void*
         EBPF_RETURN_RESULT(EBPF_INVALID_ARGUMENT);
     }
 
-    map_handle = _get_handle_from_file_descriptor(map_fd);
-    if (map_handle == ebpf_handle_invalid) {
-        EBPF_RETURN_RESULT(EBPF_INVALID_FD);
-    }
-
-    // Get map properties, either from local cache or from EC.
-    result = _get_map_descriptor_properties(map_handle, &type, &key_size, &value_size, &max_entries);
+    // Get map properties, either from the per-thread cache, the local cache or from EC.
+    result = _get_map_element_descriptor(map_fd, false, &descriptor, &cached);
     if (result != EBPF_SUCCESS) {
         EBPF_RETURN_RESULT(result);
     }
-    if ((key == nullptr) != (key_size == 0)) {
-        EBPF_RETURN_RESULT(EBPF_INVALID_ARGUMENT);
-    }
-    assert(value_size != 0);
-    assert(type != 0);
-
-    if (BPF_MAP_TYPE_PER_CPU(type)) {
-        value_size = EBPF_PAD_8(value_size) * libbpf_num_possible_cpus();
-    }
-
-    if ((type == BPF_MAP_TYPE_PROG_ARRAY) || (type == BPF_MAP_TYPE_HASH_OF_MAPS) ||
-        (type == BPF_MAP_TYPE_ARRAY_OF_MAPS)) {
-        fd_t fd = *(fd_t*)value;
-        ebpf_handle_t handle = ebpf_handle_invalid;
-        // If the fd is valid, resolve it to a handle, else pass ebpf_handle_invalid to the IOCTL.
-        if (fd != ebpf_fd_invalid) {
-            handle = _get_handle_from_file_descriptor(fd);
-            if (handle == ebpf_handle_invalid) {
-                EBPF_RETURN_RESULT(EBPF_INVALID_FD);
-            }
+    result = _update_map_element_with_descriptor(&descriptor, key, value, flags);
+    if (_map_element_descriptor_may_be_stale(result, cached)) {
+        result = _get_map_element_descriptor(map_fd, true, &descriptor, &cached);
+        if (result != EBPF_SUCCESS) {
+            EBPF_RETURN_RESULT(result);
         }
-
-        assert(key_size != 0);
-        __analysis_assume(key_size != 0);
-        EBPF_RETURN_RESULT(_update_map_element_with_handle(map_handle, key_size, (const uint8_t*)key, handle, flags));
-    } else {
-        EBPF_RETURN_RESULT(_update_map_element(map_handle, key, key_size, value, value_size, flags));
+        result = _update_map_element_with_descriptor(&descriptor, key, value, flags);
     }
+    EBPF_RETURN_RESULT(result);
 }
 
-_Must_inspect_result_ ebpf_result_t
-ebpf_map_delete_element(fd_t map_fd, _In_ const void* key) noexcept
+static ebpf_result_t
+_delete_map_element_with_descriptor(_In_ const ebpf_map_element_descriptor_t* descriptor, _In_ const void* key) noexcept
 {
     EBPF_LOG_ENTRY();
-    ebpf_result_t result = EBPF_SUCCESS;
-    ebpf_handle_t map_handle;
-    uint32_t key_size = 0;
-    uint32_t value_size = 0;
-    uint32_t max_entries = 0;
-    uint32_t type;
-    ebpf_protocol_buffer_t request_buffer;
+    ebpf_result_t result;
+    ebpf_protocol_buffer_t& request_buffer = _ebpf_map_element_thread_state.request_buffer;
     ebpf_operation_map_delete_element_request_t* request;
 
-    ebpf_assert(key);
-    if (map_fd <= 0) {
-        result = EBPF_INVALID_ARGUMENT;
-        goto Exit;
-    }
-
-    map_handle = _get_handle_from_file_descriptor(map_fd);
-    if (map_handle == ebpf_handle_invalid) {
-        result = EBPF_INVALID_FD;
-        goto Exit;
-    }
-
-    // Get map properties, either from local cache or from EC.
-    result = _get_map_descriptor_properties(map_handle, &type, &key_size, &value_size, &max_entries);
-    if (result != EBPF_SUCCESS) {
-        goto Exit;
-    }
-    if (key_size == 0) {
-        result = EBPF_INVALID_ARGUMENT;
-        goto Exit;
+    if (descriptor->key_size == 0) {
+        EBPF_RETURN_RESULT(EBPF_INVALID_ARGUMENT);
     }
-    assert(value_size != 0);
+    assert(descriptor->value_size != 0);
 
     try {
-        request_buffer.resize(EBPF_OFFSET_OF(ebpf_operation_map_delete_element_request_t, key) + key_size);
+        request_buffer.resize(EBPF_OFFSET_OF(ebpf_operation_map_delete_element_request_t, key) + descriptor->key_size);
         request = reinterpret_cast<ebpf_operation_map_delete_element_request_t*>(request_buffer.data());
 
         request->header.length = static_cast<uint16_t>(request_buffer.size());
         request->header.id = ebpf_operation_id_t::EBPF_OPERATION_MAP_DELETE_ELEMENT;
-        request->handle = (uint64_t)map_handle;
-        std::copy((uint8_t*)key, (uint8_t*)key + key_size, request->key);
+        request->handle = (uint64_t)descriptor->handle;
+        std::copy((uint8_t*)key, (uint8_t*)key + descriptor->key_size, request->key);
 
         result = win32_error_code_to_ebpf_result(invoke_ioctl(request_buffer));
-        if (result == EBPF_INVALID_OBJECT) {
-            result = EBPF_INVALID_FD;
-        }
     } catch (const std::bad_alloc&) {
         result = EBPF_NO_MEMORY;
-        goto Exit;
     } catch (...) {
         result = EBPF_FAILED;
-        goto Exit;
     }
 
-Exit:
     EBPF_RETURN_RESULT(result);
 }
 
 _Must_inspect_result_ ebpf_result_t
-ebpf_map_get_next_key(fd_t map_fd, _In_opt_ const void* previous_key, _Out_ void* next_key) noexcept
+ebpf_map_delete_element(fd_t map_fd, _In_ const void* key) noexcept
 {
     EBPF_LOG_ENTRY();
     ebpf_result_t result = EBPF_SUCCESS;
-    ebpf_protocol_buffer_t request_buffer;
-    ebpf_protocol_buffer_t reply_buffer;
-    ebpf_operation_map_get_next_key_request_t* request;
-    ebpf_operation_map_get_next_key_reply_t* reply;
-    uint32_t key_size = 0;
-    uint32_t value_size = 0;
-    uint32_t max_entries = 0;
-    uint32_t type;
-    ebpf_handle_t map_handle = ebpf_handle_invalid;
-
-    ebpf_assert(next_key);
+    ebpf_map_element_descriptor_t descriptor;
+    bool cached;
 
+    ebpf_assert(key);
     if (map_fd <= 0) {
         result = EBPF_INVALID_ARGUMENT;
         goto Exit;
     }
 
-    map_handle = _get_handle_from_file_descriptor(map_fd);
-    if (map_handle == ebpf_handle_invalid) {
-        result = EBPF_INVALID_FD;
-        goto Exit;
-    }
-
-    // Get map properties, either from local cache or from EC.
-    result = _get_map_descriptor_properties(map_handle, &type, &key_size, &value_size, &max_entries);
+    // Get map properties, either from the per-thread cache, the local cache or from EC.
+    result = _get_map_element_descriptor(map_fd, false, &descriptor, &cached);
     if (result != EBPF_SUCCESS) {
         goto Exit;
     }
+    result = _delete_map_element_with_descriptor(&descriptor, key);
+    if (_map_element_descriptor_may_be_stale(result, cached)) {
+        result = _get_map_element_descriptor(map_fd, true, &descriptor, &cached);
+        if (result != EBPF_SUCCESS) {
+            goto Exit;
+        }
+        result = _delete_map_element_with_descriptor(&descriptor, key);
+    }
+    if (result == EBPF_INVALID_OBJECT) {
+        result = EBPF_INVALID_FD;
+    }
+
+Exit:
+    EBPF_RETURN_RESULT(result);
+}
+
+static ebpf_result_t
+_get_next_map_key_with_descriptor(
+    _In_ const ebpf_map_element_descriptor_t* descriptor,
+    _In_opt_ const void* previous_key,
+    _Out_ void* next_key) noexcept
+{
+    EBPF_LOG_ENTRY();
+    ebpf_result_t result;
+    ebpf_protocol_buffer_t& request_buffer = _ebpf_map_element_thread_state.request_buffer;
+    ebpf_protocol_buffer_t& reply_buffer = _ebpf_map_element_thread_state.reply_buffer;
+    ebpf_operation_map_get_next_key_request_t* request;
+    ebpf_operation_map_get_next_key_reply_t* reply;
+    uint32_t key_size = descriptor->key_size;
+
     if (key_size == 0) {
-        result = EBPF_OPERATION_NOT_SUPPORTED;
-        goto Exit;
+        EBPF_RETURN_RESULT(EBPF_OPERATION_NOT_SUPPORTED);
     }
-    assert(value_size != 0);
+    assert(descriptor->value_size != 0);
 
     try {
         request_buffer.resize((offsetof(ebpf_operation_map_get_next_key_request_t, previous_key) + key_size));
@@ -723,7 +855,7 @@ ebpf_map_get_next_key(fd_t map_fd, _In_opt_ const void* previous_key, _Out_ void
 
         request->header.length = static_cast<uint16_t>(request_buffer.size());
         request->header.id = ebpf_operation_id_t::EBPF_OPERATION_MAP_GET_NEXT_KEY;
-        request->handle = map_handle;
+        request->handle = descriptor->handle;
         if (previous_key) {
             uint8_t* end = (uint8_t*)previous_key + key_size;
             std::copy((uint8_t*)previous_key, end, request->previous_key);
@@ -739,59 +871,652 @@ ebpf_map_get_next_key(fd_t map_fd, _In_opt_ const void* previous_key, _Out_ void
         }
     } catch (const std::bad_alloc&) {
         result = EBPF_NO_MEMORY;
-        goto Exit;
     } catch (...) {
         result = EBPF_FAILED;
-        goto Exit;
     }
 
-Exit:
     EBPF_RETURN_RESULT(result);
 }
 
-static ebpf_result_t
-_create_program(
-    ebpf_program_type_t program_type,
-    _In_ const std::string& file_name,
-    _In_ const std::string& section_name,
-    _In_ const std::string& program_name,
-    _Out_ ebpf_handle_t* program_handle) noexcept(false)
+_Must_inspect_result_ ebpf_result_t
+ebpf_map_get_next_key(fd_t map_fd, _In_opt_ const void* previous_key, _Out_ void* next_key) noexcept
 {
     EBPF_LOG_ENTRY();
-    ebpf_protocol_buffer_t request_buffer;
-    ebpf_operation_create_program_request_t* request;
-    ebpf_operation_create_program_reply_t reply;
-    ebpf_assert(program_handle);
-    *program_handle = ebpf_handle_invalid;
-
-    request_buffer.resize(
-        offsetof(ebpf_operation_create_program_request_t, data) + file_name.size() + section_name.size() +
-        program_name.size());
+    ebpf_result_t result = EBPF_SUCCESS;
+    ebpf_map_element_descriptor_t descriptor;
+    bool cached;
 
-    request = reinterpret_cast<ebpf_operation_create_program_request_t*>(request_buffer.data());
-    request->header.id = ebpf_operation_id_t::EBPF_OPERATION_CREATE_PROGRAM;
-    request->header.length = static_cast<uint16_t>(request_buffer.size());
-    request->program_type = program_type;
-    request->section_name_offset =
-        static_cast<uint16_t>(offsetof(ebpf_operation_create_program_request_t, data) + file_name.size());
-    request->program_name_offset = static_cast<uint16_t>(request->section_name_offset + section_name.size());
-    std::copy(
-        file_name.begin(),
-        file_name.end(),
-        request_buffer.begin() + offsetof(ebpf_operation_create_program_request_t, data));
+    ebpf_assert(next_key);
 
-    std::copy(section_name.begin(), section_name.end(), request_buffer.begin() + request->section_name_offset);
-    std::copy(program_name.begin(), program_name.end(), request_buffer.begin() + request->program_name_offset);
+    if (map_fd <= 0) {
+        result = EBPF_INVALID_ARGUMENT;
+        goto Exit;
+    }
 
-    uint32_t error = invoke_ioctl(request_buffer, reply);
-    if (error != ERROR_SUCCESS) {
+    // Get map properties, either from the per-thread cache, the local cache or from EC.
+    result = _get_map_element_descriptor(map_fd, false, &descriptor, &cached);
+    if (result != EBPF_SUCCESS) {
         goto Exit;
     }
-    ebpf_assert(reply.header.id == ebpf_operation_id_t::EBPF_OPERATION_CREATE_PROGRAM);
-    *program_handle = reply.program_handle;
+    result = _get_next_map_key_with_descriptor(&descriptor, previous_key, next_key);
+    if (_map_element_descriptor_may_be_stale(result, cached)) {
+        result = _get_map_element_descriptor(map_fd, true, &descriptor, &cached);
+        if (result != EBPF_SUCCESS) {
+            goto Exit;
+        }
+        result = _get_next_map_key_with_descriptor(&descriptor, previous_key, next_key);
+    }
 
 Exit:
-    EBPF_RETURN_RESULT(win32_error_code_to_ebpf_result(error));
+    EBPF_RETURN_RESULT(result);
+}
+
+typedef struct _ebpf_map_async_operation
+{
+    _ebpf_map_async_operation()
+        : operation_id(EBPF_OPERATION_MAP_FIND_ELEMENT), descriptor({ebpf_handle_invalid}), cached(false),
+          key(nullptr), input_value(nullptr), output_value(nullptr), flags(0), completion(nullptr),
+          completion_context(nullptr), immediate_result(EBPF_PENDING), async_ioctl_completion(nullptr)
+    {}
+    ~_ebpf_map_async_operation()
+    {
+        if (async_ioctl_completion != nullptr) {
+            clean_up_async_ioctl_completion(async_ioctl_completion);
+        }
+    }
+    ebpf_operation_id_t operation_id;
+    ebpf_map_element_descriptor_t descriptor;
+    bool cached; // True if the descriptor came from the per-thread cache.
+    const void* key;
+    const void* input_value;
+    void* output_value;
+    uint64_t flags;
+    ebpf_map_async_completion_t completion;
+    void* completion_context;
+    ebpf_result_t immediate_result; // Result of an IOCTL that failed synchronously, else EBPF_PENDING.
+    ebpf_protocol_buffer_t request_buffer;
+    ebpf_protocol_buffer_t reply_buffer;
+    async_ioctl_completion_t* async_ioctl_completion;
+} ebpf_map_async_operation_t;
+
+typedef std::unique_ptr<ebpf_map_async_operation_t> ebpf_map_async_operation_ptr;
+
+static ebpf_result_t
+_ebpf_map_async_operation_completion(_Inout_ void* completion_context) noexcept
+{
+    EBPF_LOG_ENTRY();
+    ebpf_map_async_operation_ptr operation(reinterpret_cast<ebpf_map_async_operation_t*>(completion_context));
+    ebpf_result_t result = operation->immediate_result;
+    if (result == EBPF_PENDING) {
+        result = get_async_ioctl_result(operation->async_ioctl_completion);
+    }
+
+    if (_map_element_descriptor_may_be_stale(result, operation->cached)) {
+        // The properties came from the cache of the thread that started the operation and may belong to a map that
+        // the file descriptor referred to earlier. Refresh them and execute the operation synchronously on this thread.
+        result = _query_map_element_descriptor(operation->descriptor.handle, &operation->descriptor);
+        if (result == EBPF_SUCCESS) {
+            switch (operation->operation_id) {
+            case EBPF_OPERATION_MAP_FIND_ELEMENT:
+                result = _map_lookup_element_with_descriptor(
+                    &operation->descriptor, false, operation->key, operation->output_value);
+                break;
+            case EBPF_OPERATION_MAP_DELETE_ELEMENT:
+                result = _delete_map_element_with_descriptor(&operation->descriptor, operation->key);
+                break;
+            default:
+                result = _update_map_element_with_descriptor(
+                    &operation->descriptor, operation->key, operation->input_value, operation->flags);
+                break;
+            }
+        }
+    } else if (result == EBPF_SUCCESS && operation->operation_id == EBPF_OPERATION_MAP_FIND_ELEMENT) {
+        auto reply = reinterpret_cast<ebpf_operation_map_find_element_reply_t*>(operation->reply_buffer.data());
+        std::copy(reply->value, reply->value + operation->descriptor.value_size, (uint8_t*)operation->output_value);
+    }
+    if (operation->operation_id == EBPF_OPERATION_MAP_DELETE_ELEMENT && result == EBPF_INVALID_OBJECT) {
+        result = EBPF_INVALID_FD;
+    }
+
+    operation->completion(operation->completion_context, result);
+    EBPF_RETURN_RESULT(EBPF_SUCCESS);
+}
+
+/**
+ * @brief Build the request for an asynchronous map operation and issue it.
+ *
+ * @param[in, out] operation Operation to start. On success, ownership passes to the completion callback, which runs
+ *  on a thread pool thread even if the execution context completes the IOCTL before this function returns.
+ *
+ * @retval EBPF_SUCCESS The operation was started.
+ * @retval EBPF_NO_MEMORY Unable to allocate resources for this operation.
+ */
+static ebpf_result_t
+_ebpf_map_async_operation_start(_Inout_ ebpf_map_async_operation_ptr& operation) noexcept
+{
+    EBPF_LOG_ENTRY();
+    ebpf_result_t result;
+    const ebpf_map_element_descriptor_t* descriptor = &operation->descriptor;
+    OVERLAPPED* overlapped;
+
+    result = initialize_async_ioctl_operation(
+        operation.get(), _ebpf_map_async_operation_completion, &operation->async_ioctl_completion);
+    if (result != EBPF_SUCCESS) {
+        EBPF_RETURN_RESULT(result);
+    }
+    overlapped = get_async_ioctl_operation_overlapped(operation->async_ioctl_completion);
+
+    try {
+        ebpf_protocol_buffer_t& request_buffer = operation->request_buffer;
+        ebpf_protocol_buffer_t& reply_buffer = operation->reply_buffer;
+        switch (operation->operation_id) {
+        case EBPF_OPERATION_MAP_FIND_ELEMENT: {
+            request_buffer.resize(
+                EBPF_OFFSET_OF(ebpf_operation_map_find_element_request_t, key) + descriptor->key_size);
+            reply_buffer.resize(
+                EBPF_OFFSET_OF(ebpf_operation_map_find_element_reply_t, value) + descriptor->value_size);
+            auto request = reinterpret_cast<ebpf_operation_map_find_element_request_t*>(request_buffer.data());
+            request->header.length = static_cast<uint16_t>(request_buffer.size());
+            request->header.id = ebpf_operation_id_t::EBPF_OPERATION_MAP_FIND_ELEMENT;
+            request->find_and_delete = false;
+            request->handle = descriptor->handle;
+            if (descriptor->key_size > 0) {
+                std::copy((uint8_t*)operation->key, (uint8_t*)operation->key + descriptor->key_size, request->key);
+            }
+            result = win32_error_code_to_ebpf_result(invoke_ioctl(request_buffer, reply_buffer, overlapped));
+            break;
+        }
+        case EBPF_OPERATION_MAP_UPDATE_ELEMENT: {
+            request_buffer.resize(
+                EBPF_OFFSET_OF(ebpf_operation_map_update_element_request_t, data) + descriptor->key_size +
+                descriptor->value_size);
+            auto request = reinterpret_cast<ebpf_operation_map_update_element_request_t*>(request_buffer.data());
+            request->header.length = static_cast<uint16_t>(request_buffer.size());
+            request->header.id = ebpf_operation_id_t::EBPF_OPERATION_MAP_UPDATE_ELEMENT;
+            request->handle = (uint64_t)descriptor->handle;
+            request->option = static_cast<ebpf_map_option_t>(operation->flags);
+            if (descriptor->key_size > 0) {
+                std::copy((uint8_t*)operation->key, (uint8_t*)operation->key + descriptor->key_size, request->data);
+            }
+            std::copy(
+                (uint8_t*)operation->input_value,
+                (uint8_t*)operation->input_value + descriptor->value_size,
+                request->data + descriptor->key_size);
+            result = win32_error_code_to_ebpf_result(invoke_ioctl(request_buffer, _empty_reply, overlapped));
+            break;
+        }
+        case EBPF_OPERATION_MAP_UPDATE_ELEMENT_WITH_HANDLE: {
+            fd_t value_fd = *(fd_t*)operation->input_value;
+            ebpf_handle_t value_handle = ebpf_handle_invalid;
+            // If the fd is valid, resolve it to a handle, else pass ebpf_handle_invalid to the IOCTL.
+            if (value_fd != ebpf_fd_invalid) {
+                value_handle = _get_handle_from_file_descriptor(value_fd);
+                if (value_handle == ebpf_handle_invalid) {
+                    EBPF_RETURN_RESULT(EBPF_INVALID_FD);
+                }
+            }
+            request_buffer.resize(
+                EBPF_OFFSET_OF(ebpf_operation_map_update_element_with_handle_request_t, key) + descriptor->key_size);
+            auto request =
+                reinterpret_cast<ebpf_operation_map_update_element_with_handle_request_t*>(request_buffer.data());
+            request->header.length = static_cast<uint16_t>(request_buffer.size());
+            request->header.id = ebpf_operation_id_t::EBPF_OPERATION_MAP_UPDATE_ELEMENT_WITH_HANDLE;
+            request->map_handle = (uintptr_t)descriptor->handle;
+            request->value_handle = (uintptr_t)value_handle;
+            request->option = static_cast<ebpf_map_option_t>(operation->flags);
+            std::copy((uint8_t*)operation->key, (uint8_t*)operation->key + descriptor->key_size, request->key);
+            result = win32_error_code_to_ebpf_result(invoke_ioctl(request_buffer, _empty_reply, overlapped));
+            break;
+        }
+        default: {
+            ebpf_assert(operation->operation_id == EBPF_OPERATION_MAP_DELETE_ELEMENT);
+            request_buffer.resize(
+                EBPF_OFFSET_OF(ebpf_operation_map_delete_element_request_t, key) + descriptor->key_size);
+            auto request = reinterpret_cast<ebpf_operation_map_delete_element_request_t*>(request_buffer.data());
+            request->header.length = static_cast<uint16_t>(request_buffer.size());
+            request->header.id = ebpf_operation_id_t::EBPF_OPERATION_MAP_DELETE_ELEMENT;
+            request->handle = (uint64_t)descriptor->handle;
+            std::copy((uint8_t*)operation->key, (uint8_t*)operation->key + descriptor->key_size, request->key);
+            result = win32_error_code_to_ebpf_result(invoke_ioctl(request_buffer, _empty_reply, overlapped));
+            break;
+        }
+        }
+    } catch (const std::bad_alloc&) {
+        EBPF_RETURN_RESULT(EBPF_NO_MEMORY);
+    }
+
+    // The device is opened for overlapped I/O, so an IOCTL that completed, even before DeviceIoControl returned, has
+    // signaled the event and the completion callback may already have freed the operation. Only an IOCTL that failed
+    // synchronously leaves the event unsignaled. Signal it so that the failure is also delivered by the thread pool.
+    if (result != EBPF_SUCCESS && result != EBPF_PENDING) {
+        operation->immediate_result = result;
+        SetEvent(overlapped->hEvent);
+    }
+    operation.release();
+    EBPF_RETURN_RESULT(EBPF_SUCCESS);
+}
+
+/**
+ * @brief Validate the arguments of an asynchronous map operation and fill in the map properties.
+ */
+static ebpf_result_t
+_ebpf_map_async_operation_initialize(
+    fd_t map_fd,
+    ebpf_operation_id_t operation_id,
+    _In_opt_ const void* key,
+    ebpf_map_async_completion_t completion,
+    _Inout_opt_ void* completion_context,
+    _Inout_ ebpf_map_async_operation_ptr& operation) noexcept
+{
+    ebpf_result_t result;
+
+    if (map_fd <= 0 || completion == nullptr) {
+        return EBPF_INVALID_ARGUMENT;
+    }
+
+    operation.reset(new (std::nothrow) ebpf_map_async_operation_t());
+    if (operation == nullptr) {
+        return EBPF_NO_MEMORY;
+    }
+    operation->operation_id = operation_id;
+    operation->key = key;
+    operation->completion = completion;
+    operation->completion_context = completion_context;
+
+    // Get map properties, either from the per-thread cache, the local cache or from EC.
+    result = _get_map_element_descriptor(map_fd, false, &operation->descriptor, &operation->cached);
+    if (result != EBPF_SUCCESS) {
+        return result;
+    }
+    if ((key == nullptr) != (operation->descriptor.key_size == 0)) {
+        return EBPF_INVALID_ARGUMENT;
+    }
+    return EBPF_SUCCESS;
+}
+
+_Must_inspect_result_ ebpf_result_t
+ebpf_map_lookup_element_async(
+    fd_t map_fd,
+    _In_opt_ const void* key,
+    _Out_ void* value,
+    ebpf_map_async_completion_t completion,
+    _Inout_opt_ void* completion_context) EBPF_NO_EXCEPT
+{
+    EBPF_LOG_ENTRY();
+    ebpf_map_async_operation_ptr operation;
+
+    if (value == nullptr) {
+        EBPF_RETURN_RESULT(EBPF_INVALID_ARGUMENT);
+    }
+    ebpf_result_t result = _ebpf_map_async_operation_initialize(
+        map_fd, EBPF_OPERATION_MAP_FIND_ELEMENT, key, completion, completion_context, operation);
+    if (result != EBPF_SUCCESS) {
+        EBPF_RETURN_RESULT(result);
+    }
+    operation->output_value = value;
+
+    EBPF_RETURN_RESULT(_ebpf_map_async_operation_start(operation));
+}
+
+_Must_inspect_result_ ebpf_result_t
+ebpf_map_update_element_async(
+    fd_t map_fd,
+    _In_opt_ const void* key,
+    _In_ const void* value,
+    uint64_t flags,
+    ebpf_map_async_completion_t completion,
+    _Inout_opt_ void* completion_context) EBPF_NO_EXCEPT
+{
+    EBPF_LOG_ENTRY();
+    ebpf_map_async_operation_ptr operation;
+
+    if (value == nullptr) {
+        EBPF_RETURN_RESULT(EBPF_INVALID_ARGUMENT);
+    }
+    switch (flags) {
+    case EBPF_ANY:
+    case EBPF_NOEXIST:
+    case EBPF_EXIST:
+        break;
+    default:
+        EBPF_RETURN_RESULT(EBPF_INVALID_ARGUMENT);
+    }
+
+    ebpf_result_t result = _ebpf_map_async_operation_initialize(
+        map_fd, EBPF_OPERATION_MAP_UPDATE_ELEMENT, key, completion, completion_context, operation);
+    if (result != EBPF_SUCCESS) {
+        EBPF_RETURN_RESULT(result);
+    }
+    uint32_t type = operation->descriptor.type;
+    if ((type == BPF_MAP_TYPE_PROG_ARRAY) || (type == BPF_MAP_TYPE_HASH_OF_MAPS) ||
+        (type == BPF_MAP_TYPE_ARRAY_OF_MAPS)) {
+        operation->operation_id = EBPF_OPERATION_MAP_UPDATE_ELEMENT_WITH_HANDLE;
+    }
+    operation->input_value = value;
+    operation->flags = flags;
+
+    EBPF_RETURN_RESULT(_ebpf_map_async_operation_start(operation));
+}
+
+_Must_inspect_result_ ebpf_result_t
+ebpf_map_delete_element_async(
+    fd_t map_fd,
+    _In_ const void* key,
+    ebpf_map_async_completion_t completion,
+    _Inout_opt_ void* completion_context) EBPF_NO_EXCEPT
+{
+    EBPF_LOG_ENTRY();
+    ebpf_map_async_operation_ptr operation;
+
+    if (key == nullptr) {
+        EBPF_RETURN_RESULT(EBPF_INVALID_ARGUMENT);
+    }
+    ebpf_result_t result = _ebpf_map_async_operation_initialize(
+        map_fd, EBPF_OPERATION_MAP_DELETE_ELEMENT, key, completion, completion_context, operation);
+    if (result != EBPF_SUCCESS) {
+        EBPF_RETURN_RESULT(result);
+    }
+
+    EBPF_RETURN_RESULT(_ebpf_map_async_operation_start(operation));
+}
+
+_Must_inspect_result_ ebpf_result_t
+ebpf_map_set_ring_buffer_wakeup_thresholds(
+    fd_t map_fd, uint32_t wakeup_bytes, uint32_t wakeup_records, uint32_t max_wakeup_latency_us) EBPF_NO_EXCEPT
+{
+    EBPF_LOG_ENTRY();
+    ebpf_handle_t map_handle = _get_handle_from_file_descriptor(map_fd);
+    if (map_handle == ebpf_handle_invalid) {
+        EBPF_RETURN_RESULT(EBPF_INVALID_FD);
+    }
+
+    ebpf_operation_ring_buffer_map_set_wakeup_thresholds_request_t request;
+    request.header.id = ebpf_operation_id_t::EBPF_OPERATION_RING_BUFFER_MAP_SET_WAKEUP_THRESHOLDS;
+    request.header.length = sizeof(request);
+    request.map_handle = map_handle;
+    request.wakeup_bytes = wakeup_bytes;
+    request.wakeup_records = wakeup_records;
+    request.max_wakeup_latency_us = max_wakeup_latency_us;
+
+    EBPF_RETURN_RESULT(win32_error_code_to_ebpf_result(invoke_ioctl(request)));
+}
+
+typedef struct _ebpf_map_queue_find_value
+{
+    void* value; // Buffer that receives the value, or nullptr if the operation is not a find.
+    uint32_t key_size;
+    uint32_t value_size;
+} ebpf_map_queue_find_value_t;
+
+typedef struct _ebpf_map_queue
+{
+    _ebpf_map_queue()
+        : handle(ebpf_handle_invalid), buffer(nullptr), header(nullptr), submissions(nullptr), completions(nullptr),
+          slots(nullptr), entry_count(0), slot_size(0), submission_tail(0), completion_head(0),
+          map_fd(ebpf_fd_invalid), map_handle(ebpf_handle_invalid), map_type(0), key_size(0), value_size(0)
+    {}
+    ~_ebpf_map_queue()
+    {
+        // The shared memory belongs to the execution context and is released with the handle.
+        if (handle != ebpf_handle_invalid)
+            Platform::CloseHandle(handle);
+    }
+    ebpf_handle_t handle;
+    uint8_t* buffer;
+    ebpf_map_queue_header_t* header;
+    ebpf_map_queue_submission_t* submissions;
+    ebpf_map_queue_completion_entry_t* completions;
+    uint8_t* slots;
+    uint32_t entry_count;
+    uint32_t slot_size;
+    uint32_t submission_tail;
+    uint32_t completion_head;
+    std::vector<ebpf_map_queue_find_value_t> find_values; // Indexed by slot.
+    // Properties of the map of the last operation posted.
+    fd_t map_fd;
+    ebpf_handle_t map_handle;
+    uint32_t map_type;
+    uint32_t key_size;
+    uint32_t value_size;
+} ebpf_map_queue_t;
+
+_Must_inspect_result_ ebpf_result_t
+ebpf_map_queue_create(uint32_t entry_count, uint32_t slot_size, _Outptr_ ebpf_map_queue_t** queue) noexcept
+{
+    EBPF_LOG_ENTRY();
+    ebpf_assert(queue);
+    if (entry_count == 0 || entry_count > EBPF_MAP_QUEUE_MAX_ENTRY_COUNT || (entry_count & (entry_count - 1)) != 0 ||
+        slot_size == 0 || slot_size > EBPF_MAP_QUEUE_MAX_SLOT_SIZE) {
+        EBPF_RETURN_RESULT(EBPF_INVALID_ARGUMENT);
+    }
+
+    try {
+        std::unique_ptr<ebpf_map_queue_t> local_queue = std::make_unique<ebpf_map_queue_t>();
+        local_queue->find_values.resize(entry_count);
+
+        ebpf_operation_create_map_queue_request_t request{
+            sizeof(request), ebpf_operation_id_t::EBPF_OPERATION_CREATE_MAP_QUEUE, entry_count, slot_size};
+        ebpf_operation_create_map_queue_reply_t reply;
+        ebpf_result_t result = win32_error_code_to_ebpf_result(invoke_ioctl(request, reply));
+        if (result != EBPF_SUCCESS) {
+            EBPF_RETURN_RESULT(result);
+        }
+        ebpf_assert(reply.header.id == ebpf_operation_id_t::EBPF_OPERATION_CREATE_MAP_QUEUE);
+        local_queue->handle = reply.queue_handle;
+
+        // The execution context maps zeroed memory into this process, so both queues start empty.
+        local_queue->buffer = reinterpret_cast<uint8_t*>(reply.buffer_address);
+        local_queue->header = reinterpret_cast<ebpf_map_queue_header_t*>(local_queue->buffer);
+        local_queue->submissions = reinterpret_cast<ebpf_map_queue_submission_t*>(local_queue->header + 1);
+        local_queue->completions =
+            reinterpret_cast<ebpf_map_queue_completion_entry_t*>(local_queue->submissions + entry_count);
+        local_queue->slots = reinterpret_cast<uint8_t*>(local_queue->completions + entry_count);
+        local_queue->entry_count = entry_count;
+        local_queue->slot_size = slot_size;
+
+        *queue = local_queue.release();
+        EBPF_RETURN_RESULT(EBPF_SUCCESS);
+    } catch (const std::bad_alloc&) {
+        EBPF_RETURN_RESULT(EBPF_NO_MEMORY);
+    }
+}
+
+void
+ebpf_map_queue_destroy(_In_opt_ _Post_invalid_ ebpf_map_queue_t* queue) noexcept
+{
+    EBPF_LOG_ENTRY();
+    delete queue;
+    EBPF_RETURN_VOID();
+}
+
+_Must_inspect_result_ ebpf_result_t
+ebpf_map_queue_post(
+    _Inout_ ebpf_map_queue_t* queue,
+    ebpf_map_queue_operation_t operation,
+    fd_t map_fd,
+    _In_opt_ const void* key,
+    _Inout_opt_ void* value,
+    uint64_t flags,
+    uint64_t user_data) noexcept
+{
+    // High volume call - Skip entry/exit logging.
+    ebpf_assert(queue);
+
+    // A slot can only be reused once the completion of its previous operation has been reaped.
+    if (queue->submission_tail - queue->completion_head >= queue->entry_count) {
+        return EBPF_OUT_OF_SPACE;
+    }
+
+    if (map_fd != queue->map_fd) {
+        ebpf_handle_t map_handle = _get_handle_from_file_descriptor(map_fd);
+        if (map_handle == ebpf_handle_invalid) {
+            return EBPF_INVALID_FD;
+        }
+
+        uint32_t type;
+        uint32_t key_size;
+        uint32_t value_size;
+        uint32_t max_entries;
+        ebpf_result_t result = _get_map_descriptor_properties(map_handle, &type, &key_size, &value_size, &max_entries);
+        if (result != EBPF_SUCCESS) {
+            return result;
+        }
+        if (BPF_MAP_TYPE_PER_CPU(type)) {
+            value_size = EBPF_PAD_8(value_size) * libbpf_num_possible_cpus();
+        }
+
+        queue->map_fd = map_fd;
+        queue->map_handle = map_handle;
+        queue->map_type = type;
+        queue->key_size = key_size;
+        queue->value_size = value_size;
+    }
+
+    if ((key == nullptr) != (queue->key_size == 0) || (size_t)queue->key_size + queue->value_size > queue->slot_size) {
+        return EBPF_INVALID_ARGUMENT;
+    }
+
+    switch (operation) {
+    case EBPF_MAP_QUEUE_OPERATION_FIND:
+    case EBPF_MAP_QUEUE_OPERATION_FIND_AND_DELETE:
+        if (value == nullptr) {
+            return EBPF_INVALID_ARGUMENT;
+        }
+        break;
+    case EBPF_MAP_QUEUE_OPERATION_UPDATE:
+        if (value == nullptr || (flags != EBPF_ANY && flags != EBPF_NOEXIST && flags != EBPF_EXIST)) {
+            return EBPF_INVALID_ARGUMENT;
+        }
+        // Values of these maps are object handles, which need ebpf_map_update_element.
+        if ((queue->map_type == BPF_MAP_TYPE_PROG_ARRAY) || (queue->map_type == BPF_MAP_TYPE_HASH_OF_MAPS) ||
+            (queue->map_type == BPF_MAP_TYPE_ARRAY_OF_MAPS)) {
+            return EBPF_OPERATION_NOT_SUPPORTED;
+        }
+        break;
+    case EBPF_MAP_QUEUE_OPERATION_DELETE:
+        break;
+    default:
+        return EBPF_INVALID_ARGUMENT;
+    }
+
+    uint32_t index = queue->submission_tail & (queue->entry_count - 1);
+    uint8_t* slot = queue->slots + (size_t)index * queue->slot_size;
+    if (queue->key_size > 0) {
+        memcpy(slot, key, queue->key_size);
+    }
+    if (operation == EBPF_MAP_QUEUE_OPERATION_UPDATE) {
+        memcpy(slot + queue->key_size, value, queue->value_size);
+    }
+    bool find =
+        (operation == EBPF_MAP_QUEUE_OPERATION_FIND) || (operation == EBPF_MAP_QUEUE_OPERATION_FIND_AND_DELETE);
+    queue->find_values[index] = {find ? value : nullptr, queue->key_size, queue->value_size};
+
+    ebpf_map_queue_submission_t* submission = &queue->submissions[index];
+    submission->user_data = user_data;
+    submission->map_handle = queue->map_handle;
+    submission->operation = operation;
+    submission->option = static_cast<uint32_t>(flags);
+    queue->submission_tail++;
+    return EBPF_SUCCESS;
+}
+
+_Must_inspect_result_ ebpf_result_t
+ebpf_map_queue_submit(_Inout_ ebpf_map_queue_t* queue, _Out_opt_ uint32_t* completed_count) noexcept
+{
+    // High volume call - Skip entry/exit logging.
+    ebpf_assert(queue);
+
+    // The release makes the submissions and their slots visible before the new tail.
+    WriteRelease((volatile LONG*)&queue->header->submission_tail, (LONG)queue->submission_tail);
+
+    ebpf_operation_submit_map_queue_request_t request{
+        sizeof(request), ebpf_operation_id_t::EBPF_OPERATION_SUBMIT_MAP_QUEUE, queue->handle};
+    ebpf_operation_submit_map_queue_reply_t reply;
+    ebpf_result_t result = win32_error_code_to_ebpf_result(invoke_ioctl(request, reply));
+    if (completed_count) {
+        *completed_count = (result == EBPF_SUCCESS) ? reply.completed_count : 0;
+    }
+    return result;
+}
+
+void
+ebpf_map_queue_reap(
+    _Inout_ ebpf_map_queue_t* queue,
+    _Out_writes_to_(completion_count, *reaped_count) ebpf_map_queue_completion_t* completions,
+    uint32_t completion_count,
+    _Out_ uint32_t* reaped_count) noexcept
+{
+    // High volume call - Skip entry/exit logging.
+    ebpf_assert(queue);
+    ebpf_assert(reaped_count);
+    uint32_t mask = queue->entry_count - 1;
+    uint32_t count = 0;
+
+    // The acquire pairs with the release of the tail by the execution context.
+    uint32_t completion_tail = (uint32_t)ReadAcquire((volatile LONG*)&queue->header->completion_tail);
+    while (queue->completion_head != completion_tail && count < completion_count) {
+        const ebpf_map_queue_completion_entry_t* entry = &queue->completions[queue->completion_head & mask];
+        uint32_t slot = entry->slot & mask;
+        const ebpf_map_queue_find_value_t* find_value = &queue->find_values[slot];
+        if (find_value->value != nullptr && entry->result == EBPF_SUCCESS) {
+            memcpy(
+                find_value->value,
+                queue->slots + (size_t)slot * queue->slot_size + find_value->key_size,
+                find_value->value_size);
+        }
+        completions[count].user_data = entry->user_data;
+        completions[count].result = static_cast<ebpf_result_t>(entry->result);
+        queue->completion_head++;
+        count++;
+    }
+
+    WriteRelease((volatile LONG*)&queue->header->completion_head, (LONG)queue->completion_head);
+    *reaped_count = count;
+}
+
+static ebpf_result_t
+_create_program(
+    ebpf_program_type_t program_type,
+    _In_ const std::string& file_name,
+    _In_ const std::string& section_name,
+    _In_ const std::string& program_name,
+    _Out_ ebpf_handle_t* program_handle) noexcept(false)
+{
+    EBPF_LOG_ENTRY();
+    ebpf_protocol_buffer_t request_buffer;
+    ebpf_operation_create_program_request_t* request;
+    ebpf_operation_create_program_reply_t reply;
+    ebpf_assert(program_handle);
+    *program_handle = ebpf_handle_invalid;
+
+    request_buffer.resize(
+        offsetof(ebpf_operation_create_program_request_t, data) + file_name.size() + section_name.size() +
+        program_name.size());
+
+    request = reinterpret_cast<ebpf_operation_create_program_request_t*>(request_buffer.data());
+    request->header.id = ebpf_operation_id_t::EBPF_OPERATION_CREATE_PROGRAM;
+    request->header.length = static_cast<uint16_t>(request_buffer.size());
+    request->program_type = program_type;
+    request->section_name_offset =
+        static_cast<uint16_t>(offsetof(ebpf_operation_create_program_request_t, data) + file_name.size());
+    request->program_name_offset = static_cast<uint16_t>(request->section_name_offset + section_name.size());
+    std::copy(
+        file_name.begin(),
+        file_name.end(),
+        request_buffer.begin() + offsetof(ebpf_operation_create_program_request_t, data));
+
+    std::copy(section_name.begin(), section_name.end(), request_buffer.begin() + request->section_name_offset);
+    std::copy(program_name.begin(), program_name.end(), request_buffer.begin() + request->program_name_offset);
+
+    uint32_t error = invoke_ioctl(request_buffer, reply);
+    if (error != ERROR_SUCCESS) {
+        goto Exit;
+    }
+    ebpf_assert(reply.header.id == ebpf_operation_id_t::EBPF_OPERATION_CREATE_PROGRAM);
+    *program_handle = reply.program_handle;
+
+Exit:
+    EBPF_RETURN_RESULT(win32_error_code_to_ebpf_result(error));
 }
 
 void
@@ -1018,7 +1743,8 @@ _link_ebpf_program(
     _In_ const ebpf_attach_type_t* attach_type,
     _Outptr_ ebpf_link_t** link,
     _In_reads_bytes_opt_(attach_parameter_size) uint8_t* attach_parameter,
-    size_t attach_parameter_size) noexcept
+    size_t attach_parameter_size,
+    _In_opt_ const ebpf_link_multi_attach_options_t* multi_attach_options) noexcept
 {
     EBPF_LOG_ENTRY();
     ebpf_protocol_buffer_t request_buffer;
@@ -1046,6 +1772,10 @@ _link_ebpf_program(
         request->header.length = static_cast<uint16_t>(request_buffer.size());
         request->program_handle = program_handle;
         request->attach_type = *attach_type;
+        request->multi_attach = (multi_attach_options != nullptr);
+        if (multi_attach_options != nullptr) {
+            request->multi_attach_options = *multi_attach_options;
+        }
 
         if (attach_parameter_size > 0) {
             memcpy_s(request->data, attach_parameter_size, attach_parameter, attach_parameter_size);
@@ -1129,6 +1859,38 @@ ebpf_detach_link_by_fd(fd_t fd) noexcept
     EBPF_RETURN_RESULT(_detach_link_by_handle(link_handle));
 }
 
+_Must_inspect_result_ ebpf_result_t
+ebpf_update_link_by_fd(fd_t link_fd, fd_t program_fd, fd_t old_program_fd) noexcept
+{
+    EBPF_LOG_ENTRY();
+    ebpf_handle_t link_handle = _get_handle_from_file_descriptor(link_fd);
+    if (link_handle == ebpf_handle_invalid) {
+        EBPF_RETURN_RESULT(EBPF_INVALID_FD);
+    }
+
+    ebpf_handle_t program_handle = _get_handle_from_file_descriptor(program_fd);
+    if (program_handle == ebpf_handle_invalid) {
+        EBPF_RETURN_RESULT(EBPF_INVALID_FD);
+    }
+
+    ebpf_handle_t old_program_handle = ebpf_handle_invalid;
+    if (old_program_fd != ebpf_fd_invalid) {
+        old_program_handle = _get_handle_from_file_descriptor(old_program_fd);
+        if (old_program_handle == ebpf_handle_invalid) {
+            EBPF_RETURN_RESULT(EBPF_INVALID_FD);
+        }
+    }
+
+    ebpf_operation_update_link_request_t request;
+    request.header.id = ebpf_operation_id_t::EBPF_OPERATION_UPDATE_LINK;
+    request.header.length = sizeof(request);
+    request.link_handle = link_handle;
+    request.program_handle = program_handle;
+    request.old_program_handle = old_program_handle;
+
+    EBPF_RETURN_RESULT(win32_error_code_to_ebpf_result(invoke_ioctl(request)));
+}
+
 _Must_inspect_result_ ebpf_result_t
 ebpf_program_attach(
     _In_ const struct bpf_program* program,
@@ -1159,8 +1921,8 @@ ebpf_program_attach(
         goto Exit;
     }
 
-    result =
-        _link_ebpf_program(program->handle, program_attach_type, link, (uint8_t*)attach_parameters, attach_params_size);
+    result = _link_ebpf_program(
+        program->handle, program_attach_type, link, (uint8_t*)attach_parameters, attach_params_size, nullptr);
 
 Exit:
     EBPF_RETURN_RESULT(result);
@@ -1194,8 +1956,33 @@ ebpf_program_attach_by_fd(
         EBPF_RETURN_RESULT(ebpf_program_attach(program, attach_type, attach_parameters, attach_parameters_size, link));
     }
 
-    EBPF_RETURN_RESULT(
-        _link_ebpf_program(program_handle, attach_type, link, (uint8_t*)attach_parameters, attach_parameters_size));
+    EBPF_RETURN_RESULT(_link_ebpf_program(
+        program_handle, attach_type, link, (uint8_t*)attach_parameters, attach_parameters_size, nullptr));
+}
+
+_Must_inspect_result_ ebpf_result_t
+ebpf_program_attach_multi_by_fd(
+    fd_t program_fd,
+    _In_ const ebpf_attach_type_t* attach_type,
+    _In_reads_bytes_opt_(attach_parameters_size) void* attach_parameters,
+    size_t attach_parameters_size,
+    _In_ const ebpf_link_multi_attach_options_t* options,
+    _Outptr_ struct bpf_link** link) EBPF_NO_EXCEPT
+{
+    EBPF_LOG_ENTRY();
+    ebpf_assert(attach_type);
+    ebpf_assert(attach_parameters || !attach_parameters_size);
+    ebpf_assert(options);
+    ebpf_assert(link);
+    *link = nullptr;
+
+    ebpf_handle_t program_handle = _get_handle_from_file_descriptor(program_fd);
+    if (program_handle == ebpf_handle_invalid) {
+        EBPF_RETURN_RESULT(EBPF_INVALID_FD);
+    }
+
+    EBPF_RETURN_RESULT(_link_ebpf_program(
+        program_handle, attach_type, link, (uint8_t*)attach_parameters, attach_parameters_size, options));
 }
 
 _Must_inspect_result_ ebpf_result_t
@@ -2316,7 +3103,8 @@ _Must_inspect_result_ ebpf_result_t
 ebpf_object_set_execution_type(_Inout_ struct bpf_object* object, ebpf_execution_type_t execution_type) EBPF_NO_EXCEPT
 {
     if (Platform::_is_native_program(object->file_name)) {
-        if (execution_type == EBPF_EXECUTION_INTERPRET || execution_type == EBPF_EXECUTION_JIT) {
+        if (execution_type == EBPF_EXECUTION_INTERPRET || execution_type == EBPF_EXECUTION_JIT ||
+            execution_type == EBPF_EXECUTION_INTERPRET_THREADED) {
             return EBPF_INVALID_ARGUMENT;
         }
 
@@ -3319,51 +4107,256 @@ ebpf_get_program_fd_by_id(ebpf_id_t id, _Out_ int* fd) noexcept
 }
 
 _Must_inspect_result_ ebpf_result_t
-ebpf_get_link_fd_by_id(ebpf_id_t id, _Out_ int* fd) noexcept
+ebpf_get_link_fd_by_id(ebpf_id_t id, _Out_ int* fd) noexcept
+{
+    EBPF_LOG_ENTRY();
+    ebpf_assert(fd);
+    EBPF_RETURN_RESULT(_get_fd_by_id(ebpf_operation_id_t::EBPF_OPERATION_GET_LINK_HANDLE_BY_ID, id, fd));
+}
+
+_Must_inspect_result_ ebpf_result_t
+ebpf_get_next_pinned_program_path(
+    _In_z_ const char* start_path, _Out_writes_z_(EBPF_MAX_PIN_PATH_LENGTH) char* next_path) EBPF_NO_EXCEPT
+{
+    EBPF_LOG_ENTRY();
+    ebpf_assert(start_path);
+    ebpf_assert(next_path);
+
+    size_t start_path_length = strlen(start_path);
+
+    ebpf_protocol_buffer_t request_buffer(
+        EBPF_OFFSET_OF(ebpf_operation_get_next_pinned_program_path_request_t, start_path) + start_path_length);
+    ebpf_protocol_buffer_t reply_buffer(
+        EBPF_OFFSET_OF(ebpf_operation_get_next_pinned_program_path_reply_t, next_path) + EBPF_MAX_PIN_PATH_LENGTH - 1);
+    ebpf_operation_get_next_pinned_program_path_request_t* request =
+        reinterpret_cast<ebpf_operation_get_next_pinned_program_path_request_t*>(request_buffer.data());
+    ebpf_operation_get_next_pinned_program_path_reply_t* reply =
+        reinterpret_cast<ebpf_operation_get_next_pinned_program_path_reply_t*>(reply_buffer.data());
+
+    request->header.id = ebpf_operation_id_t::EBPF_OPERATION_GET_NEXT_PINNED_PROGRAM_PATH;
+    request->header.length = static_cast<uint16_t>(request_buffer.size());
+    reply->header.length = static_cast<uint16_t>(reply_buffer.size());
+
+    memcpy(request->start_path, start_path, start_path_length);
+
+    uint32_t error = invoke_ioctl(request_buffer, reply_buffer);
+    ebpf_result_t result = win32_error_code_to_ebpf_result(error);
+    if (result != EBPF_SUCCESS) {
+        EBPF_RETURN_RESULT(result);
+    }
+    ebpf_assert(reply->header.id == ebpf_operation_id_t::EBPF_OPERATION_GET_NEXT_PINNED_PROGRAM_PATH);
+    size_t next_path_length =
+        reply->header.length - EBPF_OFFSET_OF(ebpf_operation_get_next_pinned_program_path_reply_t, next_path);
+    memcpy(next_path, reply->next_path, next_path_length);
+
+    next_path[next_path_length] = '\0';
+
+    EBPF_RETURN_RESULT(EBPF_SUCCESS);
+}
+
+_Must_inspect_result_ ebpf_result_t
+ebpf_get_next_pinned_paths(
+    _In_z_ const char* prefix,
+    _In_z_ const char* start_path,
+    _Out_writes_bytes_(paths_length) char* paths,
+    size_t paths_length,
+    _Out_ uint32_t* path_count) EBPF_NO_EXCEPT
+{
+    EBPF_LOG_ENTRY();
+    ebpf_assert(prefix);
+    ebpf_assert(start_path);
+    ebpf_assert(paths);
+    ebpf_assert(path_count);
+
+    *path_count = 0;
+    size_t prefix_length = strlen(prefix);
+    size_t start_path_length = strlen(start_path);
+    if (prefix_length >= EBPF_MAX_PIN_PATH_LENGTH || start_path_length >= EBPF_MAX_PIN_PATH_LENGTH) {
+        EBPF_RETURN_RESULT(EBPF_INVALID_ARGUMENT);
+    }
+
+    // Each path in the reply takes at most one more byte than in the output buffer, so twice the size of the output
+    // buffer is enough to fill it.
+    size_t reply_data_length = std::max(paths_length, (size_t)EBPF_MAX_PIN_PATH_LENGTH) * 2;
+    size_t reply_length = std::min(
+        EBPF_OFFSET_OF(ebpf_operation_get_next_pinned_paths_reply_t, data) + reply_data_length, (size_t)UINT16_MAX);
+
+    try {
+        ebpf_protocol_buffer_t request_buffer(
+            EBPF_OFFSET_OF(ebpf_operation_get_next_pinned_paths_request_t, data) + prefix_length + start_path_length);
+        ebpf_protocol_buffer_t reply_buffer(reply_length);
+        auto request = reinterpret_cast<ebpf_operation_get_next_pinned_paths_request_t*>(request_buffer.data());
+        auto reply = reinterpret_cast<ebpf_operation_get_next_pinned_paths_reply_t*>(reply_buffer.data());
+
+        request->header.id = ebpf_operation_id_t::EBPF_OPERATION_GET_NEXT_PINNED_PATHS;
+        request->header.length = static_cast<uint16_t>(request_buffer.size());
+        request->prefix_length = static_cast<uint16_t>(prefix_length);
+        memcpy(request->data, prefix, prefix_length);
+        memcpy(request->data + prefix_length, start_path, start_path_length);
+        reply->header.length = static_cast<uint16_t>(reply_buffer.size());
+
+        ebpf_result_t result = win32_error_code_to_ebpf_result(invoke_ioctl(request_buffer, reply_buffer));
+        if (result != EBPF_SUCCESS) {
+            EBPF_RETURN_RESULT(result);
+        }
+        ebpf_assert(reply->header.id == ebpf_operation_id_t::EBPF_OPERATION_GET_NEXT_PINNED_PATHS);
+
+        // Copy as many paths as fit, the next call resumes after the last one copied.
+        size_t reply_offset = 0;
+        size_t paths_offset = 0;
+        uint32_t count = 0;
+        for (uint16_t index = 0; index < reply->path_count; index++) {
+            uint16_t path_length;
+            memcpy(&path_length, reply->data + reply_offset, sizeof(path_length));
+            reply_offset += sizeof(path_length);
+            if (paths_length - paths_offset < (size_t)path_length + 1) {
+                break;
+            }
+            memcpy(paths + paths_offset, reply->data + reply_offset, path_length);
+            paths[paths_offset + path_length] = '\0';
+            reply_offset += path_length;
+            paths_offset += (size_t)path_length + 1;
+            count++;
+        }
+
+        if (count == 0) {
+            EBPF_RETURN_RESULT(EBPF_INSUFFICIENT_BUFFER);
+        }
+        *path_count = count;
+        EBPF_RETURN_RESULT(EBPF_SUCCESS);
+    } catch (const std::bad_alloc&) {
+        EBPF_RETURN_RESULT(EBPF_NO_MEMORY);
+    }
+}
+
+_Must_inspect_result_ ebpf_result_t
+ebpf_object_unpin_prefix(_In_z_ const char* prefix, _Out_opt_ uint32_t* unpinned_count) EBPF_NO_EXCEPT
+{
+    EBPF_LOG_ENTRY();
+    ebpf_assert(prefix);
+    auto prefix_length = strlen(prefix);
+    if (prefix_length == 0 || prefix_length >= EBPF_MAX_PIN_PATH_LENGTH) {
+        EBPF_RETURN_RESULT(EBPF_INVALID_ARGUMENT);
+    }
+
+    try {
+        ebpf_protocol_buffer_t request_buffer(
+            EBPF_OFFSET_OF(ebpf_operation_unpin_path_prefix_request_t, prefix) + prefix_length);
+        auto request = reinterpret_cast<ebpf_operation_unpin_path_prefix_request_t*>(request_buffer.data());
+        ebpf_operation_unpin_path_prefix_reply_t reply;
+
+        request->header.id = ebpf_operation_id_t::EBPF_OPERATION_UNPIN_PATH_PREFIX;
+        request->header.length = static_cast<uint16_t>(request_buffer.size());
+        std::copy(prefix, prefix + prefix_length, request->prefix);
+
+        ebpf_result_t result = win32_error_code_to_ebpf_result(invoke_ioctl(request_buffer, reply));
+        if (result == EBPF_SUCCESS && unpinned_count != nullptr) {
+            ebpf_assert(reply.header.id == ebpf_operation_id_t::EBPF_OPERATION_UNPIN_PATH_PREFIX);
+            *unpinned_count = reply.unpinned_count;
+        }
+        EBPF_RETURN_RESULT(result);
+    } catch (const std::bad_alloc&) {
+        EBPF_RETURN_RESULT(EBPF_NO_MEMORY);
+    }
+}
+
+_Must_inspect_result_ ebpf_result_t
+ebpf_get_epoch_statistics(
+    _Out_ ebpf_epoch_statistics_t* statistics,
+    _Out_writes_opt_(*cpu_count) ebpf_epoch_cpu_statistics_t* cpu_statistics,
+    _Inout_ uint32_t* cpu_count) EBPF_NO_EXCEPT
 {
     EBPF_LOG_ENTRY();
-    ebpf_assert(fd);
-    EBPF_RETURN_RESULT(_get_fd_by_id(ebpf_operation_id_t::EBPF_OPERATION_GET_LINK_HANDLE_BY_ID, id, fd));
+    ebpf_assert(statistics);
+    ebpf_assert(cpu_count);
+
+    ebpf_operation_get_epoch_statistics_request_t request{
+        sizeof(request), ebpf_operation_id_t::EBPF_OPERATION_GET_EPOCH_STATISTICS};
+    size_t cpu_statistics_count = cpu_statistics ? *cpu_count : 0;
+    size_t reply_length = EBPF_OFFSET_OF(ebpf_operation_get_epoch_statistics_reply_t, cpu_statistics) +
+                          cpu_statistics_count * sizeof(ebpf_epoch_cpu_statistics_t);
+    if (reply_length > UINT16_MAX) {
+        EBPF_RETURN_RESULT(EBPF_INVALID_ARGUMENT);
+    }
+
+    ebpf_protocol_buffer_t reply_buffer;
+    try {
+        reply_buffer.resize(reply_length);
+    } catch (const std::bad_alloc&) {
+        EBPF_RETURN_RESULT(EBPF_NO_MEMORY);
+    }
+    auto reply = reinterpret_cast<ebpf_operation_get_epoch_statistics_reply_t*>(reply_buffer.data());
+
+    ebpf_result_t result = win32_error_code_to_ebpf_result(invoke_ioctl(request, reply_buffer));
+    if (result != EBPF_SUCCESS && result != EBPF_INSUFFICIENT_BUFFER) {
+        EBPF_RETURN_RESULT(result);
+    }
+    ebpf_assert(reply->header.id == ebpf_operation_id_t::EBPF_OPERATION_GET_EPOCH_STATISTICS);
+
+    *statistics = reply->statistics;
+    *cpu_count = reply->cpu_count;
+    if (result == EBPF_SUCCESS && reply->cpu_count > 0) {
+        memcpy(cpu_statistics, reply->cpu_statistics, reply->cpu_count * sizeof(ebpf_epoch_cpu_statistics_t));
+    }
+
+    EBPF_RETURN_RESULT(result);
 }
 
 _Must_inspect_result_ ebpf_result_t
-ebpf_get_next_pinned_program_path(
-    _In_z_ const char* start_path, _Out_writes_z_(EBPF_MAX_PIN_PATH_LENGTH) char* next_path) EBPF_NO_EXCEPT
+ebpf_program_get_block_counts(
+    fd_t fd,
+    _Out_writes_to_(*block_count, *block_count) uint64_t* block_counts,
+    _Inout_ uint32_t* block_count) EBPF_NO_EXCEPT
 {
     EBPF_LOG_ENTRY();
-    ebpf_assert(start_path);
-    ebpf_assert(next_path);
+    ebpf_assert(block_counts);
+    ebpf_assert(block_count);
 
-    size_t start_path_length = strlen(start_path);
-
-    ebpf_protocol_buffer_t request_buffer(
-        EBPF_OFFSET_OF(ebpf_operation_get_next_pinned_program_path_request_t, start_path) + start_path_length);
-    ebpf_protocol_buffer_t reply_buffer(
-        EBPF_OFFSET_OF(ebpf_operation_get_next_pinned_program_path_reply_t, next_path) + EBPF_MAX_PIN_PATH_LENGTH - 1);
-    ebpf_operation_get_next_pinned_program_path_request_t* request =
-        reinterpret_cast<ebpf_operation_get_next_pinned_program_path_request_t*>(request_buffer.data());
-    ebpf_operation_get_next_pinned_program_path_reply_t* reply =
-        reinterpret_cast<ebpf_operation_get_next_pinned_program_path_reply_t*>(reply_buffer.data());
+    ebpf_handle_t handle = _get_handle_from_file_descriptor(fd);
+    if (handle == ebpf_handle_invalid) {
+        EBPF_RETURN_RESULT(EBPF_INVALID_FD);
+    }
 
-    request->header.id = ebpf_operation_id_t::EBPF_OPERATION_GET_NEXT_PINNED_PROGRAM_PATH;
-    request->header.length = static_cast<uint16_t>(request_buffer.size());
-    reply->header.length = static_cast<uint16_t>(reply_buffer.size());
+    ebpf_operation_get_program_block_counts_request_t request{
+        sizeof(request), ebpf_operation_id_t::EBPF_OPERATION_GET_PROGRAM_BLOCK_COUNTS, handle};
+    size_t reply_length = EBPF_OFFSET_OF(ebpf_operation_get_program_block_counts_reply_t, block_counts) +
+                          (size_t)*block_count * sizeof(uint64_t);
+    if (reply_length > UINT16_MAX) {
+        EBPF_RETURN_RESULT(EBPF_INVALID_ARGUMENT);
+    }
 
-    memcpy(request->start_path, start_path, start_path_length);
+    ebpf_protocol_buffer_t reply_buffer;
+    try {
+        reply_buffer.resize(reply_length);
+    } catch (const std::bad_alloc&) {
+        EBPF_RETURN_RESULT(EBPF_NO_MEMORY);
+    }
+    auto reply = reinterpret_cast<ebpf_operation_get_program_block_counts_reply_t*>(reply_buffer.data());
 
-    uint32_t error = invoke_ioctl(request_buffer, reply_buffer);
-    ebpf_result_t result = win32_error_code_to_ebpf_result(error);
-    if (result != EBPF_SUCCESS) {
+    ebpf_result_t result = win32_error_code_to_ebpf_result(invoke_ioctl(request, reply_buffer));
+    if (result != EBPF_SUCCESS && result != EBPF_INSUFFICIENT_BUFFER) {
         EBPF_RETURN_RESULT(result);
     }
-    ebpf_assert(reply->header.id == ebpf_operation_id_t::EBPF_OPERATION_GET_NEXT_PINNED_PROGRAM_PATH);
-    size_t next_path_length =
-        reply->header.length - EBPF_OFFSET_OF(ebpf_operation_get_next_pinned_program_path_reply_t, next_path);
-    memcpy(next_path, reply->next_path, next_path_length);
+    ebpf_assert(reply->header.id == ebpf_operation_id_t::EBPF_OPERATION_GET_PROGRAM_BLOCK_COUNTS);
 
-    next_path[next_path_length] = '\0';
+    *block_count = reply->block_count;
+    if (result == EBPF_SUCCESS && reply->block_count > 0) {
+        memcpy(block_counts, reply->block_counts, reply->block_count * sizeof(uint64_t));
+    }
 
-    EBPF_RETURN_RESULT(EBPF_SUCCESS);
+    EBPF_RETURN_RESULT(result);
+}
+
+_Must_inspect_result_ ebpf_result_t
+ebpf_set_epoch_backlog_threshold(uint64_t threshold_in_bytes) EBPF_NO_EXCEPT
+{
+    EBPF_LOG_ENTRY();
+    ebpf_operation_set_epoch_backlog_threshold_request_t request;
+    request.header.id = ebpf_operation_id_t::EBPF_OPERATION_SET_EPOCH_BACKLOG_THRESHOLD;
+    request.header.length = sizeof(request);
+    request.threshold_in_bytes = threshold_in_bytes;
+
+    EBPF_RETURN_RESULT(win32_error_code_to_ebpf_result(invoke_ioctl(request)));
 }
 
 static ebpf_result_t
@@ -3409,6 +4402,81 @@ ebpf_get_next_program_id(ebpf_id_t start_id, _Out_ ebpf_id_t* next_id) noexcept
     EBPF_RETURN_RESULT(_get_next_id(ebpf_operation_id_t::EBPF_OPERATION_GET_NEXT_PROGRAM_ID, start_id, next_id));
 }
 
+static ebpf_result_t
+_get_next_object_info(
+    ebpf_operation_id_t operation,
+    ebpf_id_t start_id,
+    _Out_writes_bytes_(*info_count * info_size) void* info,
+    size_t info_size,
+    _Inout_ uint32_t* info_count) noexcept
+{
+    EBPF_LOG_ENTRY();
+    ebpf_assert(info);
+    ebpf_assert(info_count);
+    if (*info_count == 0) {
+        EBPF_RETURN_RESULT(EBPF_INVALID_ARGUMENT);
+    }
+
+    // Request as many records as fit in a reply.
+    size_t reply_length = std::min(
+        EBPF_OFFSET_OF(ebpf_operation_get_next_object_info_reply_t, data) + (size_t)*info_count * info_size,
+        (size_t)UINT16_MAX);
+
+    try {
+        ebpf_operation_get_next_object_info_request_t request{sizeof(request), operation, start_id};
+        ebpf_protocol_buffer_t reply_buffer(reply_length);
+        auto reply = reinterpret_cast<ebpf_operation_get_next_object_info_reply_t*>(reply_buffer.data());
+        reply->header.length = static_cast<uint16_t>(reply_buffer.size());
+
+        ebpf_result_t result = win32_error_code_to_ebpf_result(invoke_ioctl(request, reply_buffer));
+        if (result != EBPF_SUCCESS) {
+            EBPF_RETURN_RESULT(result);
+        }
+        ebpf_assert(reply->header.id == operation);
+        ebpf_assert(reply->info_size == info_size);
+        ebpf_assert(reply->info_count <= *info_count);
+
+        memcpy(info, reply->data, (size_t)reply->info_count * info_size);
+        *info_count = reply->info_count;
+        EBPF_RETURN_RESULT(EBPF_SUCCESS);
+    } catch (const std::bad_alloc&) {
+        EBPF_RETURN_RESULT(EBPF_NO_MEMORY);
+    }
+}
+
+_Must_inspect_result_ ebpf_result_t
+ebpf_get_next_link_info(
+    ebpf_id_t start_id,
+    _Out_writes_to_(*info_count, *info_count) struct bpf_link_info* info,
+    _Inout_ uint32_t* info_count) EBPF_NO_EXCEPT
+{
+    EBPF_LOG_ENTRY();
+    EBPF_RETURN_RESULT(_get_next_object_info(
+        ebpf_operation_id_t::EBPF_OPERATION_GET_NEXT_LINK_INFO, start_id, info, sizeof(*info), info_count));
+}
+
+_Must_inspect_result_ ebpf_result_t
+ebpf_get_next_map_info(
+    ebpf_id_t start_id,
+    _Out_writes_to_(*info_count, *info_count) struct bpf_map_info* info,
+    _Inout_ uint32_t* info_count) EBPF_NO_EXCEPT
+{
+    EBPF_LOG_ENTRY();
+    EBPF_RETURN_RESULT(_get_next_object_info(
+        ebpf_operation_id_t::EBPF_OPERATION_GET_NEXT_MAP_INFO, start_id, info, sizeof(*info), info_count));
+}
+
+_Must_inspect_result_ ebpf_result_t
+ebpf_get_next_program_info(
+    ebpf_id_t start_id,
+    _Out_writes_to_(*info_count, *info_count) struct bpf_prog_info* info,
+    _Inout_ uint32_t* info_count) EBPF_NO_EXCEPT
+{
+    EBPF_LOG_ENTRY();
+    EBPF_RETURN_RESULT(_get_next_object_info(
+        ebpf_operation_id_t::EBPF_OPERATION_GET_NEXT_PROGRAM_INFO, start_id, info, sizeof(*info), info_count));
+}
+
 _Must_inspect_result_ ebpf_result_t
 ebpf_object_get_info_by_fd(
     fd_t bpf_fd, _Inout_updates_bytes_to_(*info_size, *info_size) void* info, _Inout_ uint32_t* info_size) noexcept
@@ -3453,6 +4521,20 @@ ebpf_get_program_info_from_verifier(_Outptr_ const ebpf_program_info_t** program
     EBPF_RETURN_RESULT(result);
 }
 
+_Must_inspect_result_ ebpf_result_t
+ebpf_get_program_info_by_type(
+    _In_ const ebpf_program_type_t* program_type, _Outptr_ const ebpf_program_info_t** program_info) EBPF_NO_EXCEPT
+{
+    ebpf_result_t result = EBPF_SUCCESS;
+    EBPF_LOG_ENTRY();
+    ebpf_assert(program_type);
+    ebpf_assert(program_info);
+
+    result = get_program_type_info_by_type(program_type, program_info);
+
+    EBPF_RETURN_RESULT(result);
+}
+
 _Ret_maybenull_ const ebpf_program_type_t*
 ebpf_get_ebpf_program_type(bpf_prog_type_t bpf_program_type) noexcept
 {
@@ -3770,6 +4852,285 @@ ebpf_ring_buffer_map_unsubscribe(_In_ _Post_invalid_ ring_buffer_subscription_t*
     EBPF_RETURN_BOOL(cancel_result);
 }
 
+typedef struct _ebpf_ring_buffer_poller_ring
+{
+    _ebpf_ring_buffer_poller_ring()
+        : ring_buffer_map_handle(ebpf_handle_invalid), buffer(nullptr), length(0), consumer(0),
+          sample_callback(nullptr), sample_callback_context(nullptr), overlapped({}), reply({}), query_issued(false)
+    {}
+    ~_ebpf_ring_buffer_poller_ring()
+    {
+        if (ring_buffer_map_handle != ebpf_handle_invalid)
+            Platform::CloseHandle(ring_buffer_map_handle);
+    }
+    ebpf_handle_t ring_buffer_map_handle;
+    const uint8_t* buffer;
+    size_t length;
+    size_t consumer; // Offset up to which records have been consumed.
+    ring_buffer_sample_fn sample_callback;
+    void* sample_callback_context;
+    OVERLAPPED overlapped;
+    ebpf_operation_ring_buffer_map_async_query_reply_t reply;
+    bool query_issued; // True if an async query was issued and its completion has not been processed.
+} ebpf_ring_buffer_poller_ring_t;
+
+typedef struct _ebpf_ring_buffer_poller
+{
+    // All the async queries signal the same event, so that a single wait covers any number of maps.
+    ebpf_signal_t signal;
+    std::vector<std::unique_ptr<ebpf_ring_buffer_poller_ring_t>> rings;
+} ebpf_ring_buffer_poller_t;
+
+static ebpf_result_t
+_ebpf_ring_buffer_poller_issue_query(
+    _Inout_ ebpf_ring_buffer_poller_t* poller, _Inout_ ebpf_ring_buffer_poller_ring_t* ring) noexcept
+{
+    // The async query returns the space consumed so far and completes as soon as the map has unconsumed records,
+    // which may be before the IOCTL returns.
+    ebpf_operation_ring_buffer_map_async_query_request_t async_query_request{
+        sizeof(async_query_request),
+        ebpf_operation_id_t::EBPF_OPERATION_RING_BUFFER_MAP_ASYNC_QUERY,
+        ring->ring_buffer_map_handle,
+        ring->consumer};
+    memset(&ring->overlapped, 0, sizeof(ring->overlapped));
+    memset(&ring->reply, 0, sizeof(ring->reply));
+    ring->overlapped.hEvent = poller->signal.get();
+    ring->overlapped.Internal = STATUS_PENDING;
+
+    ebpf_result_t result =
+        win32_error_code_to_ebpf_result(invoke_ioctl(async_query_request, ring->reply, &ring->overlapped));
+    if (result == EBPF_PENDING || result == EBPF_SUCCESS) {
+        ring->query_issued = true;
+        result = EBPF_SUCCESS;
+    }
+    return result;
+}
+
+/**
+ * @brief Consume the records reported by a completed async query and issue the next query.
+ */
+static ebpf_result_t
+_ebpf_ring_buffer_poller_consume_ring(
+    _Inout_ ebpf_ring_buffer_poller_t* poller,
+    _Inout_ ebpf_ring_buffer_poller_ring_t* ring,
+    _Inout_ uint32_t* record_count,
+    _Inout_ int* callback_result) noexcept
+{
+    unsigned long bytes_returned;
+
+    ring->query_issued = false;
+    if (!GetOverlappedResult(
+            reinterpret_cast<HANDLE>(get_device_handle()), &ring->overlapped, &bytes_returned, FALSE)) {
+        return win32_error_code_to_ebpf_result(GetLastError());
+    }
+
+    size_t producer = ring->reply.async_query_result.producer;
+    while (*callback_result == 0) {
+        auto record = ebpf_ring_buffer_next_record(ring->buffer, ring->length, ring->consumer, producer);
+        if (record == nullptr) {
+            break;
+        }
+        const volatile ebpf_ring_buffer_record_t* volatile_record = record;
+        if (volatile_record->header.locked) {
+            // The record is reserved but not yet submitted.
+            break;
+        }
+        // Order the read of the locked bit before the reads of the record.
+        MemoryBarrier();
+        ring->consumer += record->header.length;
+        if (!record->header.discarded) {
+            (*record_count)++;
+            int sample_result = ring->sample_callback(
+                ring->sample_callback_context,
+                const_cast<void*>(reinterpret_cast<const void*>(record->data)),
+                record->header.length - EBPF_OFFSET_OF(ebpf_ring_buffer_record_t, data));
+            if (sample_result < 0) {
+                *callback_result = sample_result;
+            }
+        }
+    }
+
+    return _ebpf_ring_buffer_poller_issue_query(poller, ring);
+}
+
+_Must_inspect_result_ ebpf_result_t
+ebpf_ring_buffer_poller_create(_Outptr_ ebpf_ring_buffer_poller_t** poller) noexcept
+{
+    EBPF_LOG_ENTRY();
+    *poller = nullptr;
+    try {
+        *poller = new ebpf_ring_buffer_poller_t();
+    } catch (const std::bad_alloc&) {
+        EBPF_RETURN_RESULT(EBPF_NO_MEMORY);
+    }
+    EBPF_RETURN_RESULT(EBPF_SUCCESS);
+}
+
+_Must_inspect_result_ ebpf_result_t
+ebpf_ring_buffer_poller_add(
+    _Inout_ ebpf_ring_buffer_poller_t* poller,
+    fd_t ring_buffer_map_fd,
+    ring_buffer_sample_fn sample_callback,
+    _Inout_opt_ void* sample_callback_context) noexcept
+{
+    EBPF_LOG_ENTRY();
+    ebpf_result_t result;
+    uint32_t type;
+    uint32_t key_size;
+    uint32_t value_size;
+    uint32_t max_entries;
+
+    ebpf_assert(sample_callback);
+    try {
+        std::unique_ptr<ebpf_ring_buffer_poller_ring_t> ring = std::make_unique<ebpf_ring_buffer_poller_ring_t>();
+
+        ebpf_handle_t ring_buffer_map_handle = _get_handle_from_file_descriptor(ring_buffer_map_fd);
+        if (ring_buffer_map_handle == ebpf_handle_invalid) {
+            EBPF_RETURN_RESULT(EBPF_INVALID_FD);
+        }
+
+        // Keep the map alive for as long as it is polled, even if the caller closes the file descriptor.
+        if (!Platform::DuplicateHandle(
+                reinterpret_cast<ebpf_handle_t>(GetCurrentProcess()),
+                ring_buffer_map_handle,
+                reinterpret_cast<ebpf_handle_t>(GetCurrentProcess()),
+                &ring->ring_buffer_map_handle,
+                0,
+                FALSE,
+                DUPLICATE_SAME_ACCESS)) {
+            result = win32_error_code_to_ebpf_result(GetLastError());
+            _Analysis_assume_(result != EBPF_SUCCESS);
+            EBPF_LOG_WIN32_API_FAILURE(EBPF_TRACELOG_KEYWORD_API, DuplicateHandle);
+            EBPF_RETURN_RESULT(result);
+        }
+
+        result = _get_map_descriptor_properties(
+            ring->ring_buffer_map_handle, &type, &key_size, &value_size, &max_entries);
+        if (result != EBPF_SUCCESS) {
+            EBPF_RETURN_RESULT(result);
+        }
+        if (type != BPF_MAP_TYPE_RINGBUF) {
+            EBPF_RETURN_RESULT(EBPF_INVALID_ARGUMENT);
+        }
+        ring->length = max_entries;
+
+        // Get user-mode address to ring buffer shared data.
+        ebpf_operation_ring_buffer_map_query_buffer_request_t query_buffer_request{
+            sizeof(query_buffer_request),
+            ebpf_operation_id_t::EBPF_OPERATION_RING_BUFFER_MAP_QUERY_BUFFER,
+            ring->ring_buffer_map_handle};
+        ebpf_operation_ring_buffer_map_query_buffer_reply_t query_buffer_reply{};
+        result = win32_error_code_to_ebpf_result(invoke_ioctl(query_buffer_request, query_buffer_reply));
+        if (result != EBPF_SUCCESS) {
+            EBPF_RETURN_RESULT(result);
+        }
+        ring->buffer = reinterpret_cast<const uint8_t*>(static_cast<uintptr_t>(query_buffer_reply.buffer_address));
+        ring->sample_callback = sample_callback;
+        ring->sample_callback_context = sample_callback_context;
+
+        // Reserve the slot first, so that an issued query is always owned by the poller.
+        poller->rings.emplace_back(nullptr);
+        result = _ebpf_ring_buffer_poller_issue_query(poller, ring.get());
+        if (result != EBPF_SUCCESS) {
+            poller->rings.pop_back();
+            EBPF_RETURN_RESULT(result);
+        }
+        poller->rings.back() = std::move(ring);
+    } catch (const std::bad_alloc&) {
+        EBPF_RETURN_RESULT(EBPF_NO_MEMORY);
+    }
+    EBPF_RETURN_RESULT(EBPF_SUCCESS);
+}
+
+_Must_inspect_result_ ebpf_result_t
+ebpf_ring_buffer_poller_consume(
+    _Inout_ ebpf_ring_buffer_poller_t* poller, _Out_ uint32_t* record_count, _Out_ int* callback_result) noexcept
+{
+    EBPF_LOG_ENTRY();
+    ebpf_result_t result = EBPF_SUCCESS;
+
+    *record_count = 0;
+    *callback_result = 0;
+    for (auto& ring : poller->rings) {
+        // Checking for a completed query only reads the OVERLAPPED, so idle maps cost no system call.
+        if (!ring->query_issued || !HasOverlappedIoCompleted(&ring->overlapped)) {
+            continue;
+        }
+        MemoryBarrier();
+        result = _ebpf_ring_buffer_poller_consume_ring(poller, ring.get(), record_count, callback_result);
+        if (result != EBPF_SUCCESS || *callback_result != 0) {
+            break;
+        }
+    }
+    EBPF_RETURN_RESULT(result);
+}
+
+_Must_inspect_result_ ebpf_result_t
+ebpf_ring_buffer_poller_poll(
+    _Inout_ ebpf_ring_buffer_poller_t* poller,
+    uint32_t timeout_ms,
+    _Out_ uint32_t* record_count,
+    _Out_ int* callback_result) noexcept
+{
+    EBPF_LOG_ENTRY();
+    ebpf_result_t result;
+    ULONGLONG start = GetTickCount64();
+
+    for (;;) {
+        result = ebpf_ring_buffer_poller_consume(poller, record_count, callback_result);
+        if (result != EBPF_SUCCESS || *record_count != 0 || *callback_result != 0) {
+            break;
+        }
+
+        // Reset the event before checking the queries again, so that a completion that races with the reset is
+        // either seen by the check or signals the event afterwards.
+        poller->signal.reset();
+        bool completed = false;
+        for (auto& ring : poller->rings) {
+            if (ring->query_issued && HasOverlappedIoCompleted(&ring->overlapped)) {
+                completed = true;
+                break;
+            }
+        }
+        if (completed) {
+            continue;
+        }
+
+        ULONGLONG elapsed = GetTickCount64() - start;
+        if (timeout_ms != INFINITE && elapsed >= timeout_ms) {
+            break;
+        }
+        DWORD wait_time = (timeout_ms == INFINITE) ? INFINITE : static_cast<DWORD>(timeout_ms - elapsed);
+        if (WaitForSingleObject(poller->signal.get(), wait_time) == WAIT_TIMEOUT) {
+            break;
+        }
+    }
+    EBPF_RETURN_RESULT(result);
+}
+
+void
+ebpf_ring_buffer_poller_destroy(_In_opt_ _Post_invalid_ ebpf_ring_buffer_poller_t* poller) noexcept
+{
+    EBPF_LOG_ENTRY();
+    if (poller == nullptr) {
+        EBPF_RETURN_VOID();
+    }
+
+    for (auto& ring : poller->rings) {
+        if (ring->query_issued) {
+            (void)cancel_async_ioctl(&ring->overlapped);
+        }
+    }
+    // The OVERLAPPED and reply of each query must remain valid until the query completes.
+    for (auto& ring : poller->rings) {
+        while (ring->query_issued && !HasOverlappedIoCompleted(&ring->overlapped)) {
+            SwitchToThread();
+        }
+    }
+    delete poller;
+    EBPF_RETURN_VOID();
+}
+
 _Must_inspect_result_ ebpf_result_t
 ebpf_program_test_run(fd_t program_fd, _Inout_ ebpf_test_run_options_t* options) EBPF_NO_EXCEPT
 {
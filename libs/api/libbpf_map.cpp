@@ -298,7 +298,8 @@ bpf_map_get_next_id(uint32_t start_id, uint32_t* next_id)
 
 typedef struct ring_buffer
 {
-    std::vector<ring_buffer_subscription_t*> subscriptions;
+    // Records of every map are delivered by ring_buffer__poll and ring_buffer__consume, on the calling thread.
+    ebpf_ring_buffer_poller_t* poller = nullptr;
 } ring_buffer_t;
 
 struct ring_buffer*
@@ -309,11 +310,14 @@ ring_buffer__new(int map_fd, ring_buffer_sample_fn sample_cb, void* ctx, const s
 
     try {
         std::unique_ptr<ring_buffer_t> ring_buffer = std::make_unique<ring_buffer_t>();
-        ring_buffer_subscription_t* subscription = nullptr;
-        result = ebpf_ring_buffer_map_subscribe(map_fd, ctx, sample_cb, &subscription);
+        result = ebpf_ring_buffer_poller_create(&ring_buffer->poller);
         if (result != EBPF_SUCCESS)
             goto Exit;
-        ring_buffer->subscriptions.push_back(subscription);
+        result = ebpf_ring_buffer_poller_add(ring_buffer->poller, map_fd, sample_cb, ctx);
+        if (result != EBPF_SUCCESS) {
+            ebpf_ring_buffer_poller_destroy(ring_buffer->poller);
+            goto Exit;
+        }
         local_ring_buffer = ring_buffer.release();
     } catch (const std::bad_alloc&) {
         result = EBPF_NO_MEMORY;
@@ -325,12 +329,46 @@ Exit:
     EBPF_RETURN_POINTER(ring_buffer_t*, local_ring_buffer);
 }
 
+int
+ring_buffer__add(struct ring_buffer* ring_buffer, int map_fd, ring_buffer_sample_fn sample_cb, void* ctx)
+{
+    return libbpf_result_err(ebpf_ring_buffer_poller_add(ring_buffer->poller, map_fd, sample_cb, ctx));
+}
+
+int
+ring_buffer__poll(struct ring_buffer* ring_buffer, int timeout_ms)
+{
+    uint32_t record_count = 0;
+    int callback_result = 0;
+
+    ebpf_result_t result = ebpf_ring_buffer_poller_poll(
+        ring_buffer->poller,
+        (timeout_ms < 0) ? INFINITE : static_cast<uint32_t>(timeout_ms),
+        &record_count,
+        &callback_result);
+    if (result != EBPF_SUCCESS) {
+        return libbpf_result_err(result);
+    }
+    return (callback_result < 0) ? callback_result : static_cast<int>(record_count);
+}
+
+int
+ring_buffer__consume(struct ring_buffer* ring_buffer)
+{
+    uint32_t record_count = 0;
+    int callback_result = 0;
+
+    ebpf_result_t result = ebpf_ring_buffer_poller_consume(ring_buffer->poller, &record_count, &callback_result);
+    if (result != EBPF_SUCCESS) {
+        return libbpf_result_err(result);
+    }
+    return (callback_result < 0) ? callback_result : static_cast<int>(record_count);
+}
+
 void
 ring_buffer__free(struct ring_buffer* ring_buffer)
 {
-    for (auto it = ring_buffer->subscriptions.begin(); it != ring_buffer->subscriptions.end(); it++)
-        (void)ebpf_ring_buffer_map_unsubscribe(*it);
-    ring_buffer->subscriptions.clear();
+    ebpf_ring_buffer_poller_destroy(ring_buffer->poller);
     delete ring_buffer;
 }
 
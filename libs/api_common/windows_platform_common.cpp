@@ -726,9 +726,9 @@ _get_static_program_info(_In_ const ebpf_program_type_t* program_type)
     return nullptr;
 }
 
-_Success_(return == EBPF_SUCCESS) ebpf_result_t get_program_type_info(_Outptr_ const ebpf_program_info_t** info)
+_Success_(return == EBPF_SUCCESS) ebpf_result_t get_program_type_info_by_type(
+    _In_ const ebpf_program_type_t* program_type, _Outptr_ const ebpf_program_info_t** info)
 {
-    const GUID* program_type = reinterpret_cast<const GUID*>(global_program_info.type.platform_specific_data);
     ebpf_result_t result = EBPF_SUCCESS;
     ebpf_program_info_t* program_info;
     bool fall_back = false;
@@ -761,6 +761,12 @@ _Success_(return == EBPF_SUCCESS) ebpf_result_t get_program_type_info(_Outptr_ c
     return result;
 }
 
+_Success_(return == EBPF_SUCCESS) ebpf_result_t get_program_type_info(_Outptr_ const ebpf_program_info_t** info)
+{
+    const GUID* program_type = reinterpret_cast<const GUID*>(global_program_info.type.platform_specific_data);
+    return get_program_type_info_by_type(program_type, info);
+}
+
 void
 clear_program_info_cache()
 {
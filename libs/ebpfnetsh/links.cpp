@@ -16,6 +16,7 @@
 #include "platform.h"
 #include "links.h"
 #include "tokens.h"
+#include "utilities.h"
 
 DWORD
 handle_ebpf_show_links(
@@ -34,26 +35,22 @@ handle_ebpf_show_links(
     std::cout << "     ID       ID  Type\n";
     std::cout << "=======  =======  =============\n";
 
+    // Fetch the information about many links per call instead of opening each link.
+    std::vector<struct bpf_link_info> infos(EBPF_NETSH_INFO_PAGE_SIZE);
     uint32_t link_id = 0;
     for (;;) {
-        if (bpf_link_get_next_id(link_id, &link_id) < 0) {
+        uint32_t info_count = (uint32_t)infos.size();
+        if (ebpf_get_next_link_info(link_id, infos.data(), &info_count) != EBPF_SUCCESS) {
             break;
         }
 
-        fd_t link_fd = bpf_link_get_fd_by_id(link_id);
-        if (link_fd < 0) {
-            break;
-        }
-
-        struct bpf_link_info info;
-        uint32_t info_size = (uint32_t)sizeof(info);
-        if (bpf_obj_get_info_by_fd(link_fd, &info, &info_size) == 0) {
+        for (uint32_t index = 0; index < info_count; index++) {
+            const struct bpf_link_info& info = infos[index];
             const char* attach_type_name = ebpf_get_attach_type_name(&info.attach_type_uuid);
 
             printf("%7u%9u  %s\n", info.id, info.prog_id, attach_type_name);
         }
-
-        Platform::_close(link_fd);
+        link_id = infos[info_count - 1].id;
     }
     return EBPF_SUCCESS;
 }
@@ -16,6 +16,7 @@
 #include "platform.h"
 #include "maps.h"
 #include "tokens.h"
+#include "utilities.h"
 
 DWORD
 handle_ebpf_show_maps(
@@ -34,20 +35,17 @@ handle_ebpf_show_maps(
     std::cout << "    ID            Map Type  Size   Size  Entries     ID  Pins  Name\n";
     std::cout << "======  ==================  ====  =====  =======  =====  ====  ========\n";
 
+    // Fetch the information about many maps per call instead of opening each map.
+    std::vector<struct bpf_map_info> infos(EBPF_NETSH_INFO_PAGE_SIZE);
     uint32_t map_id = 0;
     for (;;) {
-        if (bpf_map_get_next_id(map_id, &map_id) < 0) {
+        uint32_t info_count = (uint32_t)infos.size();
+        if (ebpf_get_next_map_info(map_id, infos.data(), &info_count) != EBPF_SUCCESS) {
             break;
         }
 
-        fd_t map_fd = bpf_map_get_fd_by_id(map_id);
-        if (map_fd < 0) {
-            break;
-        }
-
-        struct bpf_map_info info;
-        uint32_t info_size = (uint32_t)sizeof(info);
-        if (bpf_obj_get_info_by_fd(map_fd, &info, &info_size) == 0) {
+        for (uint32_t index = 0; index < info_count; index++) {
+            const struct bpf_map_info& info = infos[index];
             printf(
                 "%6u  %18s%6u%7u%9u%7d%6u  %s\n",
                 info.id,
@@ -59,8 +57,7 @@ handle_ebpf_show_maps(
                 info.pinned_path_count,
                 info.name);
         }
-
-        Platform::_close(map_fd);
+        map_id = infos[info_count - 1].id;
     }
     return NO_ERROR;
 }
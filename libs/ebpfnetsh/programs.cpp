@@ -32,6 +32,7 @@ static TOKEN_VALUE _boolean_constraint_enum[] = {
 static TOKEN_VALUE _ebpf_execution_type_enum[] = {
     {L"jit", EBPF_EXECUTION_JIT},
     {L"interpret", EBPF_EXECUTION_INTERPRET},
+    {L"interpret_threaded", EBPF_EXECUTION_INTERPRET_THREADED},
 };
 
 typedef enum
@@ -654,115 +655,130 @@ handle_ebpf_show_programs(
         std::cout << "======  ====  =====  =========  =============  ====================\n";
     }
 
+    // Fetch the information about many programs per call, and only open the programs that pass the filters.
+    std::vector<struct bpf_prog_info> infos(EBPF_NETSH_INFO_PAGE_SIZE);
     uint32_t program_id = 0;
     fd_t program_fd = ebpf_fd_invalid;
-    for (;;) {
-        const char* program_file_name;
-        const char* program_section_name;
-        const char* execution_type_name;
-        ebpf_execution_type_t program_execution_type;
-        uint32_t next_program_id;
-        if (bpf_prog_get_next_id(program_id, &next_program_id) < 0) {
+    bool more_programs = true;
+    while (more_programs) {
+        uint32_t info_count = (uint32_t)infos.size();
+        if (ebpf_get_next_program_info(program_id, infos.data(), &info_count) != EBPF_SUCCESS) {
             break;
         }
-        program_id = next_program_id;
+        program_id = infos[info_count - 1].id;
 
-        if (program_fd != ebpf_fd_invalid) {
-            Platform::_close(program_fd);
-        }
-        program_fd = bpf_prog_get_fd_by_id(program_id);
+        for (uint32_t index = 0; index < info_count; index++) {
+            struct bpf_prog_info& info = infos[index];
+            const char* program_file_name;
+            const char* program_section_name;
+            const char* execution_type_name;
+            ebpf_execution_type_t program_execution_type;
 
-        struct bpf_prog_info info = {};
-        uint32_t info_size = (uint32_t)sizeof(info);
-        int error = bpf_obj_get_info_by_fd(program_fd, &info, &info_size);
-        if (error < 0) {
-            break;
-        }
+            if ((id != 0) && (info.id != id)) {
+                continue;
+            }
+            if (tags[0].bPresent && (memcmp(&info.type_uuid, &program_type, sizeof(program_type)) != 0)) {
+                continue;
+            }
 
-        if ((id != 0) && (info.id != id)) {
-            continue;
-        }
-        if (tags[0].bPresent && (memcmp(&info.type_uuid, &program_type, sizeof(program_type)) != 0)) {
-            continue;
-        }
+            // Filter by attached if desired.
+            if (attached == BC_NO && info.link_count > 0) {
+                continue;
+            }
+            if (attached == BC_YES && info.link_count == 0) {
+                continue;
+            }
 
-        // Filter by attached if desired.
-        if (attached == BC_NO && info.link_count > 0) {
-            continue;
-        }
-        if (attached == BC_YES && info.link_count == 0) {
-            continue;
-        }
+            // Filter by pinpath if desired.
+            if (pinned == BC_NO && info.pinned_path_count > 0) {
+                continue;
+            }
+            if (pinned == BC_YES && info.pinned_path_count == 0) {
+                continue;
+            }
 
-        // Filter by pinpath if desired.
-        if (pinned == BC_NO && info.pinned_path_count > 0) {
-            continue;
-        }
-        if (pinned == BC_YES && info.pinned_path_count == 0) {
-            continue;
-        }
+            if (program_fd != ebpf_fd_invalid) {
+                Platform::_close(program_fd);
+            }
+            program_fd = bpf_prog_get_fd_by_id(info.id);
+            if (program_fd < 0) {
+                // The program was unloaded after its information was fetched.
+                program_fd = ebpf_fd_invalid;
+                continue;
+            }
 
-        status =
-            ebpf_program_query_info(program_fd, &program_execution_type, &program_file_name, &program_section_name);
-        if (status != ERROR_SUCCESS) {
-            break;
-        }
+            status = ebpf_program_query_info(
+                program_fd, &program_execution_type, &program_file_name, &program_section_name);
+            if (status != ERROR_SUCCESS) {
+                more_programs = false;
+                break;
+            }
 
-        if (filename.empty() || strcmp(program_file_name, filename.c_str()) == 0) {
-            if (section.empty() || strcmp(program_section_name, section.c_str()) == 0) {
-                switch (program_execution_type) {
-                case EBPF_EXECUTION_JIT:
-                    execution_type_name = "JIT";
-                    break;
-                case EBPF_EXECUTION_INTERPRET:
-                    execution_type_name = "INTERPRET";
-                    break;
-                default:
-                    execution_type_name = "NATIVE";
-                    break;
-                }
-                const char* program_type_name = ebpf_get_program_type_name(&info.type_uuid);
-
-                if (level == VL_NORMAL) {
-                    printf(
-                        "%6u  %4u  %5u  %-9s  %-13s  %s\n",
-                        info.id,
-                        info.pinned_path_count,
-                        info.link_count,
-                        execution_type_name,
-                        program_type_name,
-                        info.name);
-                } else {
-                    std::cout << "\n";
-                    std::cout << "ID             : " << info.id << "\n";
-                    std::cout << "File name      : " << program_file_name << "\n";
-                    std::cout << "Section        : " << program_section_name << "\n";
-                    std::cout << "Name           : " << info.name << "\n";
-                    std::cout << "Program type   : " << program_type_name << "\n";
-                    std::cout << "Mode           : " << execution_type_name << "\n";
-                    std::cout << "# map IDs      : " << info.nr_map_ids << "\n";
-
-                    if (info.nr_map_ids > 0) {
-                        std::vector<ebpf_id_t> map_ids(info.nr_map_ids);
-                        info.map_ids = (uintptr_t)map_ids.data();
-                        error = bpf_obj_get_info_by_fd(program_fd, &info, &info_size);
-                        if (error < 0) {
-                            break;
+            if (filename.empty() || strcmp(program_file_name, filename.c_str()) == 0) {
+                if (section.empty() || strcmp(program_section_name, section.c_str()) == 0) {
+                    switch (program_execution_type) {
+                    case EBPF_EXECUTION_JIT:
+                        execution_type_name = "JIT";
+                        break;
+                    case EBPF_EXECUTION_INTERPRET:
+                        execution_type_name = "INTERPRET";
+                        break;
+                    case EBPF_EXECUTION_INTERPRET_THREADED:
+                        execution_type_name = "INTERPRET_THREADED";
+                        break;
+                    default:
+                        execution_type_name = "NATIVE";
+                        break;
+                    }
+                    const char* program_type_name = ebpf_get_program_type_name(&info.type_uuid);
+
+                    if (level == VL_NORMAL) {
+                        printf(
+                            "%6u  %4u  %5u  %-9s  %-13s  %s\n",
+                            info.id,
+                            info.pinned_path_count,
+                            info.link_count,
+                            execution_type_name,
+                            program_type_name,
+                            info.name);
+                    } else {
+                        std::cout << "\n";
+                        std::cout << "ID             : " << info.id << "\n";
+                        std::cout << "File name      : " << program_file_name << "\n";
+                        std::cout << "Section        : " << program_section_name << "\n";
+                        std::cout << "Name           : " << info.name << "\n";
+                        std::cout << "Program type   : " << program_type_name << "\n";
+                        std::cout << "Mode           : " << execution_type_name << "\n";
+                        std::cout << "# map IDs      : " << info.nr_map_ids << "\n";
+
+                        if (info.nr_map_ids > 0) {
+                            std::vector<ebpf_id_t> map_ids(info.nr_map_ids);
+                            uint32_t info_size = (uint32_t)sizeof(info);
+                            info.map_ids = (uintptr_t)map_ids.data();
+                            if (bpf_obj_get_info_by_fd(program_fd, &info, &info_size) < 0) {
+                                more_programs = false;
+                            } else {
+                                std::cout << "map IDs        : " << map_ids[0] << "\n";
+                                for (uint32_t i = 1; i < info.nr_map_ids; i++) {
+                                    std::cout << "                 " << map_ids[i] << "\n";
+                                }
+                            }
                         }
-                        std::cout << "map IDs        : " << map_ids[0] << "\n";
-                        for (uint32_t i = 1; i < info.nr_map_ids; i++) {
-                            std::cout << "                 " << map_ids[i] << "\n";
+
+                        if (more_programs) {
+                            std::cout << "# pinned paths : " << info.pinned_path_count << "\n";
+                            std::cout << "# links        : " << info.link_count << "\n";
                         }
                     }
-
-                    std::cout << "# pinned paths : " << info.pinned_path_count << "\n";
-                    std::cout << "# links        : " << info.link_count << "\n";
                 }
             }
-        }
 
-        ebpf_free_string(program_file_name);
-        ebpf_free_string(program_section_name);
+            ebpf_free_string(program_file_name);
+            ebpf_free_string(program_section_name);
+            if (!more_programs) {
+                break;
+            }
+        }
     }
     if (program_fd != ebpf_fd_invalid) {
         Platform::_close(program_fd);
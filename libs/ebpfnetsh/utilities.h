@@ -6,6 +6,9 @@
 #include <iostream>
 #include "ebpf_api.h"
 
+// Number of objects whose information is fetched per call when listing objects.
+#define EBPF_NETSH_INFO_PAGE_SIZE 256
+
 std::string
 down_cast_from_wstring(const std::wstring& wide_string);
 
@@ -8,6 +8,7 @@
 #include "ebpf_extension_uuids.h"
 #include "ebpf_handle.h"
 #include "ebpf_link.h"
+#include "ebpf_core_map_queue.h"
 #include "ebpf_maps.h"
 #include "ebpf_native.h"
 #include "ebpf_pinning_table.h"
@@ -84,7 +85,7 @@ static const void* _ebpf_general_helpers[] = {
     (void*)&_ebpf_core_get_time_ns,
     (void*)&ebpf_core_csum_diff,
     // Ring buffer output.
-    (void*)&ebpf_ring_buffer_map_output,
+    (void*)&_ebpf_core_ring_buffer_output,
     (void*)&_ebpf_core_trace_printk2,
     (void*)&_ebpf_core_trace_printk3,
     (void*)&_ebpf_core_trace_printk4,
@@ -167,6 +168,8 @@ ebpf_core_initiate()
 
     ebpf_object_tracking_initiate();
 
+    ebpf_link_initiate();
+
     return_value = ebpf_pinning_table_allocate(&_ebpf_core_map_pinning_table);
     if (return_value != EBPF_SUCCESS)
         goto Done;
@@ -246,6 +249,8 @@ ebpf_core_terminate()
     // Verify that all ebpf_core_object_t objects have been freed.
     ebpf_object_tracking_terminate();
 
+    ebpf_link_terminate();
+
     ebpf_trace_terminate();
 
     ebpf_platform_terminate();
@@ -1124,7 +1129,17 @@ _ebpf_core_protocol_link_program(
         request->header.length, FIELD_OFFSET(ebpf_operation_link_program_request_t, data), &data_length);
     if (retval != EBPF_SUCCESS)
         goto Done;
-    retval = ebpf_link_initialize(link, request->attach_type, request->data, data_length);
+    if (request->multi_attach) {
+        retval = ebpf_link_initialize_shared(
+            link,
+            request->attach_type,
+            request->data,
+            data_length,
+            request->multi_attach_options.priority,
+            request->multi_attach_options.continue_verdict);
+    } else {
+        retval = ebpf_link_initialize(link, request->attach_type, request->data, data_length);
+    }
     if (retval != EBPF_SUCCESS)
         goto Done;
 
@@ -1577,6 +1592,98 @@ _ebpf_core_protocol_get_next_pinned_program_path(
     EBPF_RETURN_RESULT(result);
 }
 
+static ebpf_result_t
+_ebpf_core_protocol_get_next_pinned_paths(
+    _In_ const ebpf_operation_get_next_pinned_paths_request_t* request,
+    _Inout_ ebpf_operation_get_next_pinned_paths_reply_t* reply,
+    uint16_t reply_length)
+{
+    EBPF_LOG_ENTRY();
+    uint16_t entry_count = 0;
+    ebpf_pinning_entry_t* pinning_entries = NULL;
+    uint16_t path_count = 0;
+    size_t offset = 0;
+
+    size_t data_length;
+    ebpf_result_t result = ebpf_safe_size_t_subtract(
+        request->header.length, EBPF_OFFSET_OF(ebpf_operation_get_next_pinned_paths_request_t, data), &data_length);
+    if (result != EBPF_SUCCESS)
+        goto Exit;
+
+    if (request->prefix_length > data_length) {
+        result = EBPF_INVALID_ARGUMENT;
+        goto Exit;
+    }
+
+    const ebpf_utf8_string_t prefix = {(uint8_t*)request->data, request->prefix_length};
+    const ebpf_utf8_string_t start_path = {
+        (uint8_t*)request->data + request->prefix_length, data_length - request->prefix_length};
+    size_t available_length = reply_length - EBPF_OFFSET_OF(ebpf_operation_get_next_pinned_paths_reply_t, data);
+
+    // Each path takes at least a length and one byte, which bounds the number of entries that can fit in the reply.
+    uint16_t max_entry_count = (uint16_t)max((size_t)1, available_length / (sizeof(uint16_t) + 1));
+
+    result = ebpf_pinning_table_enumerate_prefix(
+        _ebpf_core_map_pinning_table,
+        EBPF_OBJECT_UNKNOWN,
+        &prefix,
+        &start_path,
+        max_entry_count,
+        &entry_count,
+        &pinning_entries);
+    if (result != EBPF_SUCCESS)
+        goto Exit;
+
+    if (entry_count == 0) {
+        result = EBPF_NO_MORE_KEYS;
+        goto Exit;
+    }
+
+    // Return as many paths as fit, the caller resumes the enumeration after the last one.
+    for (path_count = 0; path_count < entry_count; path_count++) {
+        const ebpf_pinning_entry_t* entry = &pinning_entries[path_count];
+        uint16_t path_length = (uint16_t)entry->path.length;
+        if (available_length - offset < sizeof(path_length) + path_length) {
+            break;
+        }
+        memcpy(reply->data + offset, &path_length, sizeof(path_length));
+        offset += sizeof(path_length);
+        memcpy(reply->data + offset, entry->path.value, entry->path.length);
+        offset += entry->path.length;
+    }
+
+    if (path_count == 0) {
+        result = EBPF_INSUFFICIENT_BUFFER;
+        goto Exit;
+    }
+
+    reply->path_count = path_count;
+    reply->header.length = (uint16_t)(EBPF_OFFSET_OF(ebpf_operation_get_next_pinned_paths_reply_t, data) + offset);
+
+Exit:
+    ebpf_pinning_entries_release(entry_count, pinning_entries);
+
+    EBPF_RETURN_RESULT(result);
+}
+
+static ebpf_result_t
+_ebpf_core_protocol_unpin_path_prefix(
+    _In_ const ebpf_operation_unpin_path_prefix_request_t* request,
+    _Out_ ebpf_operation_unpin_path_prefix_reply_t* reply)
+{
+    EBPF_LOG_ENTRY();
+    size_t prefix_length;
+    ebpf_result_t result = ebpf_safe_size_t_subtract(
+        request->header.length, EBPF_OFFSET_OF(ebpf_operation_unpin_path_prefix_request_t, prefix), &prefix_length);
+    if (result != EBPF_SUCCESS)
+        EBPF_RETURN_RESULT(result);
+
+    const ebpf_utf8_string_t prefix = {(uint8_t*)request->prefix, prefix_length};
+
+    result = ebpf_pinning_table_delete_prefix(_ebpf_core_map_pinning_table, &prefix, &reply->unpinned_count);
+    EBPF_RETURN_RESULT(result);
+}
+
 static ebpf_result_t
 _ebpf_core_protocol_bind_map(_In_ const ebpf_operation_bind_map_request_t* request)
 {
@@ -1608,6 +1715,83 @@ Done:
     EBPF_RETURN_RESULT(result);
 }
 
+static ebpf_result_t
+_ebpf_core_protocol_update_link(_In_ const ebpf_operation_update_link_request_t* request)
+{
+    EBPF_LOG_ENTRY();
+    ebpf_result_t result;
+    ebpf_link_t* link = NULL;
+    ebpf_program_t* program = NULL;
+    ebpf_program_t* old_program = NULL;
+
+    result = ebpf_object_reference_by_handle(request->link_handle, EBPF_OBJECT_LINK, (ebpf_core_object_t**)&link);
+    if (result != EBPF_SUCCESS) {
+        goto Done;
+    }
+
+    result =
+        ebpf_object_reference_by_handle(request->program_handle, EBPF_OBJECT_PROGRAM, (ebpf_core_object_t**)&program);
+    if (result != EBPF_SUCCESS) {
+        goto Done;
+    }
+
+    if (request->old_program_handle != ebpf_handle_invalid) {
+        result = ebpf_object_reference_by_handle(
+            request->old_program_handle, EBPF_OBJECT_PROGRAM, (ebpf_core_object_t**)&old_program);
+        if (result != EBPF_SUCCESS) {
+            goto Done;
+        }
+    }
+
+    result = ebpf_link_update_program(link, program, old_program);
+
+Done:
+    if (link) {
+        ebpf_object_release_reference((ebpf_core_object_t*)link);
+    }
+    if (program) {
+        ebpf_object_release_reference((ebpf_core_object_t*)program);
+    }
+    if (old_program) {
+        ebpf_object_release_reference((ebpf_core_object_t*)old_program);
+    }
+    EBPF_RETURN_RESULT(result);
+}
+
+static ebpf_result_t
+_ebpf_core_protocol_get_epoch_statistics(
+    _In_ const ebpf_operation_get_epoch_statistics_request_t* request,
+    _Inout_ ebpf_operation_get_epoch_statistics_reply_t* reply,
+    uint16_t reply_length)
+{
+    EBPF_LOG_ENTRY();
+    ebpf_result_t result;
+    uint32_t cpu_count = (uint32_t)(
+        (reply_length - EBPF_OFFSET_OF(ebpf_operation_get_epoch_statistics_reply_t, cpu_statistics)) /
+        sizeof(ebpf_epoch_cpu_statistics_t));
+
+    UNREFERENCED_PARAMETER(request);
+
+    result = ebpf_epoch_query_statistics(&reply->statistics, reply->cpu_statistics, &cpu_count);
+    reply->cpu_count = cpu_count;
+    if (result == EBPF_SUCCESS) {
+        reply->header.length = (uint16_t)(
+            EBPF_OFFSET_OF(ebpf_operation_get_epoch_statistics_reply_t, cpu_statistics) +
+            (size_t)cpu_count * sizeof(ebpf_epoch_cpu_statistics_t));
+    }
+
+    EBPF_RETURN_RESULT(result);
+}
+
+static ebpf_result_t
+_ebpf_core_protocol_set_epoch_backlog_threshold(
+    _In_ const ebpf_operation_set_epoch_backlog_threshold_request_t* request)
+{
+    EBPF_LOG_ENTRY();
+    ebpf_epoch_set_backlog_threshold((size_t)request->threshold_in_bytes);
+    EBPF_RETURN_RESULT(EBPF_SUCCESS);
+}
+
 static ebpf_result_t
 _ebpf_core_protocol_get_object_info(
     _In_ const ebpf_operation_get_object_info_request_t* request,
@@ -1643,6 +1827,153 @@ _ebpf_core_protocol_get_object_info(
     EBPF_RETURN_RESULT(result);
 }
 
+static ebpf_result_t
+_get_next_object_info(
+    ebpf_object_type_t type,
+    _In_ const ebpf_operation_get_next_object_info_request_t* request,
+    _Inout_ ebpf_operation_get_next_object_info_reply_t* reply,
+    uint16_t reply_length)
+{
+    ebpf_result_t result = EBPF_SUCCESS;
+    size_t available_length = reply_length - EBPF_OFFSET_OF(ebpf_operation_get_next_object_info_reply_t, data);
+    uint16_t record_size;
+    uint32_t info_count = 0;
+    ebpf_id_t id = request->start_id;
+
+    // Programs don't return map IDs, so the input info is left empty.
+    const struct bpf_prog_info empty_program_info = {0};
+
+    switch (type) {
+    case EBPF_OBJECT_LINK:
+        record_size = sizeof(struct bpf_link_info);
+        break;
+    case EBPF_OBJECT_MAP:
+        record_size = sizeof(struct bpf_map_info);
+        break;
+    default:
+        record_size = sizeof(struct bpf_prog_info);
+        break;
+    }
+
+    while (available_length - (size_t)info_count * record_size >= record_size) {
+        ebpf_core_object_t* object;
+        uint8_t* record = reply->data + (size_t)info_count * record_size;
+        uint16_t info_size = record_size;
+
+        if (ebpf_object_get_next_id(id, type, &id) != EBPF_SUCCESS) {
+            break;
+        }
+
+        // Skip objects that were deleted after their ID was found.
+        if (ebpf_object_reference_by_id(id, type, &object) != EBPF_SUCCESS) {
+            continue;
+        }
+
+        switch (type) {
+        case EBPF_OBJECT_LINK:
+            result = ebpf_link_get_info((ebpf_link_t*)object, record, &info_size);
+            break;
+        case EBPF_OBJECT_MAP:
+            result = ebpf_map_get_info((ebpf_map_t*)object, record, &info_size);
+            break;
+        default:
+            result = ebpf_program_get_info(
+                (ebpf_program_t*)object, (const uint8_t*)&empty_program_info, record, &info_size);
+            break;
+        }
+        ebpf_object_release_reference(object);
+        if (result != EBPF_SUCCESS) {
+            goto Exit;
+        }
+        info_count++;
+    }
+
+    if (info_count == 0) {
+        // Either no object follows the start ID or the reply can't hold a single record.
+        result = (available_length < record_size) ? EBPF_INSUFFICIENT_BUFFER : EBPF_NO_MORE_KEYS;
+        goto Exit;
+    }
+
+    reply->info_count = info_count;
+    reply->info_size = record_size;
+    reply->header.length = (uint16_t)(
+        EBPF_OFFSET_OF(ebpf_operation_get_next_object_info_reply_t, data) + (size_t)info_count * record_size);
+
+Exit:
+    return result;
+}
+
+static ebpf_result_t
+_ebpf_core_protocol_get_next_link_info(
+    _In_ const ebpf_operation_get_next_object_info_request_t* request,
+    _Inout_ ebpf_operation_get_next_object_info_reply_t* reply,
+    uint16_t reply_length)
+{
+    EBPF_LOG_ENTRY();
+    EBPF_RETURN_RESULT(_get_next_object_info(EBPF_OBJECT_LINK, request, reply, reply_length));
+}
+
+static ebpf_result_t
+_ebpf_core_protocol_get_next_map_info(
+    _In_ const ebpf_operation_get_next_object_info_request_t* request,
+    _Inout_ ebpf_operation_get_next_object_info_reply_t* reply,
+    uint16_t reply_length)
+{
+    EBPF_LOG_ENTRY();
+    EBPF_RETURN_RESULT(_get_next_object_info(EBPF_OBJECT_MAP, request, reply, reply_length));
+}
+
+static ebpf_result_t
+_ebpf_core_protocol_get_next_program_info(
+    _In_ const ebpf_operation_get_next_object_info_request_t* request,
+    _Inout_ ebpf_operation_get_next_object_info_reply_t* reply,
+    uint16_t reply_length)
+{
+    EBPF_LOG_ENTRY();
+    EBPF_RETURN_RESULT(_get_next_object_info(EBPF_OBJECT_PROGRAM, request, reply, reply_length));
+}
+
+static ebpf_result_t
+_ebpf_core_protocol_create_map_queue(
+    _In_ const ebpf_operation_create_map_queue_request_t* request,
+    _Out_ ebpf_operation_create_map_queue_reply_t* reply)
+{
+    EBPF_LOG_ENTRY();
+    ebpf_core_map_queue_t* queue = NULL;
+    void* buffer;
+
+    ebpf_result_t result = ebpf_core_map_queue_create(request->entry_count, request->slot_size, &buffer, &queue);
+    if (result != EBPF_SUCCESS) {
+        goto Exit;
+    }
+
+    result = ebpf_handle_create(&reply->queue_handle, (ebpf_base_object_t*)queue);
+    reply->buffer_address = (uint64_t)(uintptr_t)buffer;
+
+Exit:
+    ebpf_core_map_queue_release_reference(queue);
+    EBPF_RETURN_RESULT(result);
+}
+
+static ebpf_result_t
+_ebpf_core_protocol_submit_map_queue(
+    _In_ const ebpf_operation_submit_map_queue_request_t* request,
+    _Out_ ebpf_operation_submit_map_queue_reply_t* reply)
+{
+    // High volume call - Skip entry/exit logging.
+    ebpf_core_map_queue_t* queue = NULL;
+
+    reply->completed_count = 0;
+    ebpf_result_t result = ebpf_core_map_queue_reference_by_handle(request->queue_handle, &queue);
+    if (result != EBPF_SUCCESS) {
+        return result;
+    }
+
+    result = ebpf_core_map_queue_process(queue, &reply->completed_count);
+    ebpf_core_map_queue_release_reference(queue);
+    return result;
+}
+
 static ebpf_result_t
 _ebpf_core_protocol_ring_buffer_map_query_buffer(
     _In_ const ebpf_operation_ring_buffer_map_query_buffer_request_t* request,
@@ -1707,6 +2038,73 @@ Exit:
     return result;
 }
 
+static ebpf_result_t
+_ebpf_core_protocol_ring_buffer_map_set_wakeup_thresholds(
+    _In_ const ebpf_operation_ring_buffer_map_set_wakeup_thresholds_request_t* request)
+{
+    EBPF_LOG_ENTRY();
+    ebpf_map_t* map = NULL;
+
+    ebpf_result_t result =
+        ebpf_object_reference_by_handle(request->map_handle, EBPF_OBJECT_MAP, (ebpf_core_object_t**)&map);
+    if (result != EBPF_SUCCESS)
+        goto Exit;
+
+    if (ebpf_map_get_definition(map)->type != BPF_MAP_TYPE_RINGBUF) {
+        result = EBPF_INVALID_ARGUMENT;
+        goto Exit;
+    }
+
+    result = ebpf_ring_buffer_map_set_wakeup_thresholds(
+        map, request->wakeup_bytes, request->wakeup_records, request->max_wakeup_latency_us);
+
+Exit:
+    if (map)
+        ebpf_object_release_reference((ebpf_core_object_t*)map);
+    EBPF_RETURN_RESULT(result);
+}
+
+static ebpf_result_t
+_ebpf_core_protocol_get_program_block_counts(
+    _In_ const ebpf_operation_get_program_block_counts_request_t* request,
+    _Inout_ ebpf_operation_get_program_block_counts_reply_t* reply,
+    uint16_t reply_length)
+{
+    EBPF_LOG_ENTRY();
+    ebpf_program_t* program = NULL;
+    const uint64_t* block_counts = NULL;
+    size_t block_count = 0;
+    size_t maximum_block_count =
+        (reply_length - EBPF_OFFSET_OF(ebpf_operation_get_program_block_counts_reply_t, block_counts)) /
+        sizeof(uint64_t);
+
+    ebpf_result_t result = ebpf_object_reference_by_handle(
+        request->program_handle, EBPF_OBJECT_PROGRAM, (ebpf_core_object_t**)&program);
+    if (result != EBPF_SUCCESS)
+        goto Exit;
+
+    result = ebpf_program_get_block_counts(program, &block_counts, &block_count);
+    if (result != EBPF_SUCCESS)
+        goto Exit;
+
+    reply->block_count = (uint32_t)block_count;
+    if (block_count > maximum_block_count) {
+        result = EBPF_INSUFFICIENT_BUFFER;
+        goto Exit;
+    }
+
+    // Running programs update the counters without synchronization, so this is a snapshot.
+    memcpy(reply->block_counts, block_counts, block_count * sizeof(uint64_t));
+    reply->header.length = (uint16_t)(
+        EBPF_OFFSET_OF(ebpf_operation_get_program_block_counts_reply_t, block_counts) +
+        block_count * sizeof(uint64_t));
+
+Exit:
+    if (program)
+        ebpf_object_release_reference((ebpf_core_object_t*)program);
+    EBPF_RETURN_RESULT(result);
+}
+
 static void*
 _ebpf_core_map_find_element(ebpf_map_t* map, const uint8_t* key)
 {
@@ -1939,8 +2337,7 @@ _ebpf_core_ring_buffer_output(
     _Inout_ ebpf_map_t* map, _In_reads_bytes_(length) uint8_t* data, size_t length, uint64_t flags)
 {
     // This function implements bpf_ringbuf_output helper function, which returns negative error in case of failure.
-    UNREFERENCED_PARAMETER(flags);
-    return -ebpf_ring_buffer_map_output(map, data, length);
+    return -ebpf_ring_buffer_map_output(map, data, length, flags);
 }
 
 static uint64_t
@@ -2079,6 +2476,9 @@ ALIAS_TYPES(get_next_id, get_next_program_id)
 ALIAS_TYPES(get_handle_by_id, get_link_handle_by_id)
 ALIAS_TYPES(get_handle_by_id, get_map_handle_by_id)
 ALIAS_TYPES(get_handle_by_id, get_program_handle_by_id)
+ALIAS_TYPES(get_next_object_info, get_next_link_info)
+ALIAS_TYPES(get_next_object_info, get_next_map_info)
+ALIAS_TYPES(get_next_object_info, get_next_program_info)
 
 static ebpf_protocol_handler_t _ebpf_protocol_handlers[] = {
 
@@ -2117,6 +2517,18 @@ static ebpf_protocol_handler_t _ebpf_protocol_handlers[] = {
     DECLARE_PROTOCOL_HANDLER_VARIABLE_REQUEST_FIXED_REPLY(load_native_module, data, PROTOCOL_NATIVE_MODE),
     DECLARE_PROTOCOL_HANDLER_FIXED_REQUEST_VARIABLE_REPLY(load_native_programs, data, PROTOCOL_NATIVE_MODE),
     DECLARE_PROTOCOL_HANDLER_VARIABLE_REQUEST_VARIABLE_REPLY_ASYNC(program_test_run, data, data, PROTOCOL_ALL_MODES),
+    DECLARE_PROTOCOL_HANDLER_FIXED_REQUEST_NO_REPLY(update_link, PROTOCOL_ALL_MODES),
+    DECLARE_PROTOCOL_HANDLER_FIXED_REQUEST_VARIABLE_REPLY(get_epoch_statistics, cpu_statistics, PROTOCOL_ALL_MODES),
+    DECLARE_PROTOCOL_HANDLER_FIXED_REQUEST_NO_REPLY(set_epoch_backlog_threshold, PROTOCOL_ALL_MODES),
+    DECLARE_PROTOCOL_HANDLER_VARIABLE_REQUEST_VARIABLE_REPLY(get_next_pinned_paths, data, data, PROTOCOL_ALL_MODES),
+    DECLARE_PROTOCOL_HANDLER_VARIABLE_REQUEST_FIXED_REPLY(unpin_path_prefix, prefix, PROTOCOL_ALL_MODES),
+    DECLARE_PROTOCOL_HANDLER_FIXED_REQUEST_VARIABLE_REPLY(get_next_link_info, data, PROTOCOL_ALL_MODES),
+    DECLARE_PROTOCOL_HANDLER_FIXED_REQUEST_VARIABLE_REPLY(get_next_map_info, data, PROTOCOL_ALL_MODES),
+    DECLARE_PROTOCOL_HANDLER_FIXED_REQUEST_VARIABLE_REPLY(get_next_program_info, data, PROTOCOL_ALL_MODES),
+    DECLARE_PROTOCOL_HANDLER_FIXED_REQUEST_FIXED_REPLY(create_map_queue, PROTOCOL_ALL_MODES),
+    DECLARE_PROTOCOL_HANDLER_FIXED_REQUEST_FIXED_REPLY(submit_map_queue, PROTOCOL_ALL_MODES),
+    DECLARE_PROTOCOL_HANDLER_FIXED_REQUEST_NO_REPLY(ring_buffer_map_set_wakeup_thresholds, PROTOCOL_ALL_MODES),
+    DECLARE_PROTOCOL_HANDLER_FIXED_REQUEST_VARIABLE_REPLY(get_program_block_counts, block_counts, PROTOCOL_ALL_MODES),
 };
 
 _Must_inspect_result_ ebpf_result_t
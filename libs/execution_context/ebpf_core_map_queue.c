@@ -0,0 +1,311 @@
+// Copyright (c) Microsoft Corporation
+// SPDX-License-Identifier: MIT
+
+#include "ebpf_handle.h"
+#include "ebpf_core_map_queue.h"
+#include "ebpf_maps.h"
+#include "ebpf_object.h"
+#include "ebpf_protocol.h"
+
+// The user produces submissions and consumes completions, the execution context does the opposite. Both sides
+// only ever advance the indices they own. The execution context keeps private copies of its own indices and
+// masks every index read from shared memory, so a misbehaving user can only corrupt its own operations.
+
+static const uint32_t _ebpf_core_map_queue_marker = 'emqu';
+
+// Map queues are backed by non-paged memory that any caller can allocate, so the total is capped.
+#define EBPF_MAP_QUEUE_MAX_TOTAL_SIZE (64 * 1024 * 1024)
+
+static volatile int32_t _ebpf_core_map_queue_total_size = 0;
+
+typedef struct _ebpf_core_map_queue
+{
+    ebpf_base_object_t base;
+    ebpf_memory_descriptor_t* memory;
+    ebpf_user_mapping_t* user_mapping;
+    int32_t buffer_size;
+    ebpf_map_queue_header_t* header;
+    ebpf_map_queue_submission_t* submissions;
+    ebpf_map_queue_completion_entry_t* completions;
+    uint8_t* slots;
+    uint32_t entry_count;
+    uint32_t slot_size;
+    uint32_t submission_head;
+    uint32_t completion_tail;
+    volatile int32_t processing; // Non-zero while a thread is processing the queue.
+    uint8_t* key;                // Private copy of the key of the submission being executed.
+} ebpf_core_map_queue_t;
+
+static bool
+_ebpf_core_map_queue_reserve_memory(int32_t size)
+{
+    for (;;) {
+        int32_t total_size = _ebpf_core_map_queue_total_size;
+        if (total_size + size > EBPF_MAP_QUEUE_MAX_TOTAL_SIZE) {
+            return false;
+        }
+        if (ebpf_interlocked_compare_exchange_int32(&_ebpf_core_map_queue_total_size, total_size + size, total_size) ==
+            total_size) {
+            return true;
+        }
+    }
+}
+
+static void
+_ebpf_core_map_queue_release_memory(int32_t size)
+{
+    for (;;) {
+        int32_t total_size = _ebpf_core_map_queue_total_size;
+        if (ebpf_interlocked_compare_exchange_int32(&_ebpf_core_map_queue_total_size, total_size - size, total_size) ==
+            total_size) {
+            return;
+        }
+    }
+}
+
+static void
+_ebpf_core_map_queue_free(_In_opt_ _Post_invalid_ ebpf_core_map_queue_t* queue)
+{
+    if (!queue) {
+        return;
+    }
+
+    // The pages must not be released while the user can still access them.
+    ebpf_unmap_memory_user(queue->user_mapping);
+    ebpf_unmap_memory(queue->memory);
+    _ebpf_core_map_queue_release_memory(queue->buffer_size);
+    ebpf_free(queue->key);
+    ebpf_free(queue);
+}
+
+static void
+_ebpf_core_map_queue_acquire_reference(_Inout_ void* base_object)
+{
+    ebpf_core_map_queue_t* queue = (ebpf_core_map_queue_t*)base_object;
+    ebpf_assert(queue->base.marker == _ebpf_core_map_queue_marker);
+    ebpf_interlocked_increment_int32(&queue->base.reference_count);
+}
+
+static void
+_ebpf_core_map_queue_release_reference(_Inout_ void* base_object)
+{
+    ebpf_core_map_queue_t* queue = (ebpf_core_map_queue_t*)base_object;
+    ebpf_assert(queue->base.marker == _ebpf_core_map_queue_marker);
+    if (ebpf_interlocked_decrement_int32(&queue->base.reference_count) == 0) {
+        queue->base.marker = ~queue->base.marker;
+        _ebpf_core_map_queue_free(queue);
+    }
+}
+
+static bool
+_ebpf_core_map_queue_compare(_In_ const ebpf_base_object_t* object, _In_opt_ const void* context)
+{
+    UNREFERENCED_PARAMETER(context);
+    return object->marker == _ebpf_core_map_queue_marker;
+}
+
+_Must_inspect_result_ ebpf_result_t
+ebpf_core_map_queue_create(
+    uint32_t entry_count, uint32_t slot_size, _Outptr_ void** buffer, _Outptr_ ebpf_core_map_queue_t** queue)
+{
+    EBPF_LOG_ENTRY();
+    ebpf_result_t result;
+    ebpf_core_map_queue_t* local_queue = NULL;
+    uint8_t* base_address;
+    size_t buffer_size;
+
+    if (entry_count == 0 || entry_count > EBPF_MAP_QUEUE_MAX_ENTRY_COUNT || (entry_count & (entry_count - 1)) != 0 ||
+        slot_size == 0 || slot_size > EBPF_MAP_QUEUE_MAX_SLOT_SIZE) {
+        result = EBPF_INVALID_ARGUMENT;
+        goto Done;
+    }
+    buffer_size = EBPF_MAP_QUEUE_BUFFER_SIZE(entry_count, slot_size);
+
+    local_queue = ebpf_allocate(sizeof(ebpf_core_map_queue_t));
+    if (!local_queue) {
+        result = EBPF_NO_MEMORY;
+        goto Done;
+    }
+
+    local_queue->key = ebpf_allocate(slot_size);
+    if (!local_queue->key) {
+        result = EBPF_NO_MEMORY;
+        goto Done;
+    }
+
+    if (!_ebpf_core_map_queue_reserve_memory((int32_t)buffer_size)) {
+        result = EBPF_NO_MEMORY;
+        goto Done;
+    }
+    local_queue->buffer_size = (int32_t)buffer_size;
+
+    // The memory is owned by the execution context and only mapped into the caller, so it is released with the
+    // map queue whatever happens to the process that created it.
+    local_queue->memory = ebpf_map_memory(buffer_size);
+    if (!local_queue->memory) {
+        result = EBPF_NO_MEMORY;
+        goto Done;
+    }
+
+    base_address = ebpf_memory_descriptor_get_base_address(local_queue->memory);
+    if (!base_address) {
+        result = EBPF_NO_MEMORY;
+        goto Done;
+    }
+    memset(base_address, 0, buffer_size);
+
+    result = ebpf_map_memory_user(local_queue->memory, &local_queue->user_mapping);
+    if (result != EBPF_SUCCESS) {
+        goto Done;
+    }
+
+    local_queue->header = (ebpf_map_queue_header_t*)base_address;
+    local_queue->submissions = (ebpf_map_queue_submission_t*)(local_queue->header + 1);
+    local_queue->completions = (ebpf_map_queue_completion_entry_t*)(local_queue->submissions + entry_count);
+    local_queue->slots = (uint8_t*)(local_queue->completions + entry_count);
+    local_queue->entry_count = entry_count;
+    local_queue->slot_size = slot_size;
+
+    local_queue->base.marker = _ebpf_core_map_queue_marker;
+    local_queue->base.reference_count = 1;
+    local_queue->base.acquire_reference = _ebpf_core_map_queue_acquire_reference;
+    local_queue->base.release_reference = _ebpf_core_map_queue_release_reference;
+
+    *buffer = ebpf_user_mapping_get_address(local_queue->user_mapping);
+    *queue = local_queue;
+    local_queue = NULL;
+    result = EBPF_SUCCESS;
+
+Done:
+    _ebpf_core_map_queue_free(local_queue);
+    EBPF_RETURN_RESULT(result);
+}
+
+_Must_inspect_result_ ebpf_result_t
+ebpf_core_map_queue_reference_by_handle(ebpf_handle_t handle, _Outptr_ ebpf_core_map_queue_t** queue)
+{
+    return ebpf_reference_base_object_by_handle(
+        handle, _ebpf_core_map_queue_compare, NULL, (ebpf_base_object_t**)queue);
+}
+
+void
+ebpf_core_map_queue_release_reference(_In_opt_ _Post_invalid_ ebpf_core_map_queue_t* queue)
+{
+    if (queue) {
+        _ebpf_core_map_queue_release_reference(queue);
+    }
+}
+
+/**
+ * @brief Execute a single submission.
+ *
+ * @param[in, out] queue Map queue the submission was posted to.
+ * @param[in] submission Private copy of the submission.
+ * @param[in, out] slot Slot holding the key and value of the submission.
+ * @param[in, out] map Map targeted by the previous submission, if any. On
+ *  return, holds a reference to the map targeted by this submission.
+ * @param[in, out] map_handle Handle that map was resolved from.
+ * @return Result of the map operation.
+ */
+static ebpf_result_t
+_ebpf_core_map_queue_execute(
+    _Inout_ ebpf_core_map_queue_t* queue,
+    _In_ const ebpf_map_queue_submission_t* submission,
+    _Inout_updates_(queue->slot_size) uint8_t* slot,
+    _Inout_ ebpf_map_t** map,
+    _Inout_ ebpf_handle_t* map_handle)
+{
+    ebpf_result_t result;
+
+    // Consecutive submissions usually target the same map, so only resolve the handle when it changes.
+    if (*map == NULL || submission->map_handle != *map_handle) {
+        ebpf_object_release_reference((ebpf_core_object_t*)*map);
+        *map = NULL;
+        result = ebpf_object_reference_by_handle(submission->map_handle, EBPF_OBJECT_MAP, (ebpf_core_object_t**)map);
+        if (result != EBPF_SUCCESS) {
+            return result;
+        }
+        *map_handle = submission->map_handle;
+    }
+
+    const ebpf_map_definition_in_memory_t* map_definition = ebpf_map_get_definition(*map);
+    size_t key_size = map_definition->key_size;
+    size_t value_size = map_definition->value_size;
+    if (key_size + value_size > queue->slot_size) {
+        return EBPF_INVALID_ARGUMENT;
+    }
+
+    // The map must not read a key that the user can change while it is being used.
+    memcpy(queue->key, slot, key_size);
+
+    switch (submission->operation) {
+    case EBPF_MAP_QUEUE_OPERATION_FIND:
+        return ebpf_map_find_entry(*map, key_size, queue->key, value_size, slot + key_size, 0);
+    case EBPF_MAP_QUEUE_OPERATION_FIND_AND_DELETE:
+        return ebpf_map_find_entry(*map, key_size, queue->key, value_size, slot + key_size, EPBF_MAP_FIND_FLAG_DELETE);
+    case EBPF_MAP_QUEUE_OPERATION_UPDATE:
+        return ebpf_map_update_entry(
+            *map, key_size, queue->key, value_size, slot + key_size, (ebpf_map_option_t)submission->option, 0);
+    case EBPF_MAP_QUEUE_OPERATION_DELETE:
+        return ebpf_map_delete_entry(*map, key_size, queue->key, 0);
+    default:
+        return EBPF_INVALID_ARGUMENT;
+    }
+}
+
+_Must_inspect_result_ ebpf_result_t
+ebpf_core_map_queue_process(_Inout_ ebpf_core_map_queue_t* queue, _Out_ uint32_t* completed_count)
+{
+    // High volume call - Skip entry/exit logging.
+    ebpf_result_t result = EBPF_SUCCESS;
+    ebpf_map_t* map = NULL;
+    ebpf_handle_t map_handle = ebpf_handle_invalid;
+    uint32_t mask = queue->entry_count - 1;
+    uint32_t count = 0;
+
+    *completed_count = 0;
+    if (ebpf_interlocked_compare_exchange_int32(&queue->processing, 1, 0) != 0) {
+        return EBPF_INVALID_ARGUMENT;
+    }
+
+    // The acquire pairs with the release of the tail by the user, making the submissions before it visible.
+    uint32_t submission_tail = (uint32_t)ReadAcquire((volatile LONG*)&queue->header->submission_tail);
+    uint32_t completion_head = (uint32_t)ReadAcquire((volatile LONG*)&queue->header->completion_head);
+    if (submission_tail - queue->submission_head > queue->entry_count) {
+        result = EBPF_INVALID_ARGUMENT;
+        goto Done;
+    }
+
+    while (queue->submission_head != submission_tail) {
+        if (queue->completion_tail - completion_head >= queue->entry_count) {
+            // The completion queue is full. The remaining submissions are executed by the next call.
+            break;
+        }
+
+        uint32_t index = queue->submission_head & mask;
+        ebpf_map_queue_submission_t submission;
+        memcpy(&submission, &queue->submissions[index], sizeof(submission));
+
+        ebpf_result_t operation_result = _ebpf_core_map_queue_execute(
+            queue, &submission, queue->slots + (size_t)index * queue->slot_size, &map, &map_handle);
+
+        ebpf_map_queue_completion_entry_t* completion = &queue->completions[queue->completion_tail & mask];
+        completion->user_data = submission.user_data;
+        completion->slot = index;
+        completion->result = operation_result;
+
+        queue->submission_head++;
+        queue->completion_tail++;
+        count++;
+    }
+
+    // The release makes the completions and the values they refer to visible before the new tail.
+    WriteRelease((volatile LONG*)&queue->header->submission_head, (LONG)queue->submission_head);
+    WriteRelease((volatile LONG*)&queue->header->completion_tail, (LONG)queue->completion_tail);
+    *completed_count = count;
+
+Done:
+    ebpf_object_release_reference((ebpf_core_object_t*)map);
+    ebpf_interlocked_compare_exchange_int32(&queue->processing, 0, 1);
+    return result;
+}
@@ -0,0 +1,80 @@
+// Copyright (c) Microsoft Corporation
+// SPDX-License-Identifier: MIT
+
+#pragma once
+
+#include "ebpf_platform.h"
+
+#ifdef __cplusplus
+extern "C"
+{
+#endif
+
+    /**
+     * @brief A pair of submission and completion queues, in memory shared with
+     * the user, through which the user posts map operations in bulk.
+     */
+    typedef struct _ebpf_core_map_queue ebpf_core_map_queue_t;
+
+    /**
+     * @brief Create a map queue and map its memory into the calling
+     * process. The memory holds EBPF_MAP_QUEUE_BUFFER_SIZE(entry_count,
+     * slot_size) bytes laid out as described in ebpf_protocol.h, and is
+     * released with the map queue.
+     *
+     * @param[in] entry_count Number of entries in each queue. Must be a power
+     *  of two.
+     * @param[in] slot_size Size of the key and value slot of each submission.
+     * @param[out] buffer Pointer to memory that will contain the address of
+     *  the memory in the calling process on success.
+     * @param[out] queue Pointer to memory that will contain the map queue on
+     *  success. The caller owns a reference to the map queue.
+     * @retval EBPF_SUCCESS The operation was successful.
+     * @retval EBPF_INVALID_ARGUMENT One or more parameters are invalid.
+     * @retval EBPF_NO_MEMORY Unable to allocate resources for this
+     *  map queue, or the memory used by all map queues would exceed its
+     *  limit.
+     */
+    _Must_inspect_result_ ebpf_result_t
+    ebpf_core_map_queue_create(
+        uint32_t entry_count, uint32_t slot_size, _Outptr_ void** buffer, _Outptr_ ebpf_core_map_queue_t** queue);
+
+    /**
+     * @brief Get a reference to the map queue that a handle refers to.
+     *
+     * @param[in] handle Handle of the map queue.
+     * @param[out] queue Pointer to memory that will contain the map queue on
+     *  success.
+     * @retval EBPF_SUCCESS The operation was successful.
+     * @retval EBPF_INVALID_OBJECT The handle doesn't refer to a map queue.
+     */
+    _Must_inspect_result_ ebpf_result_t
+    ebpf_core_map_queue_reference_by_handle(ebpf_handle_t handle, _Outptr_ ebpf_core_map_queue_t** queue);
+
+    /**
+     * @brief Release a reference on a map queue, freeing it and its memory
+     * when the last reference is released.
+     *
+     * @param[in] queue Map queue to release.
+     */
+    void
+    ebpf_core_map_queue_release_reference(_In_opt_ _Post_invalid_ ebpf_core_map_queue_t* queue);
+
+    /**
+     * @brief Execute the map operations posted to the submission queue and
+     * post their completions, stopping early if the completion queue is full.
+     * The operations are executed in order. A failed operation is reported in
+     * its completion and does not stop the others.
+     *
+     * @param[in, out] queue Map queue to process.
+     * @param[out] completed_count Number of completions posted.
+     * @retval EBPF_SUCCESS The operation was successful.
+     * @retval EBPF_INVALID_ARGUMENT The submission queue tail is corrupt, or
+     *  another thread is processing the map queue.
+     */
+    _Must_inspect_result_ ebpf_result_t
+    ebpf_core_map_queue_process(_Inout_ ebpf_core_map_queue_t* queue, _Out_ uint32_t* completed_count);
+
+#ifdef __cplusplus
+}
+#endif
@@ -9,6 +9,8 @@
 #include "ebpf_platform.h"
 #include "ebpf_program.h"
 
+typedef struct _ebpf_link_attach_point ebpf_link_attach_point_t;
+
 typedef struct _ebpf_link
 {
     ebpf_core_object_t object;
@@ -24,18 +26,81 @@ typedef struct _ebpf_link
     bool detaching;
 
     void* provider_binding_context;
+
+    // Shared attach point this link belongs to, or NULL if the link owns its own hook client.
+    ebpf_link_attach_point_t* attach_point;
+    int32_t priority;
 } ebpf_link_t;
 
+/**
+ * @brief Priority-sorted snapshot of the links attached to a shared attach point.
+ * Writers publish a new copy and release the old one with ebpf_epoch_free, so
+ * readers only need to be in an epoch. The only change made to a published
+ * snapshot is clearing the entry of a link that is removed when no memory is
+ * available for a new copy, so readers and writers skip NULL entries.
+ */
+typedef struct _ebpf_link_array
+{
+    uint32_t count;
+    ebpf_link_t* volatile links[1];
+} ebpf_link_array_t;
+
+/**
+ * @brief A single hook client that is shared by all links created with
+ * EBPF_LINK_FLAG_MULTI_ATTACH for the same attach type and attach parameters.
+ */
+typedef struct _ebpf_link_attach_point
+{
+    ebpf_list_entry_t entry;
+    ebpf_attach_type_t attach_type;
+    ebpf_attach_provider_data_t attach_provider_data;
+    uint32_t continue_verdict;
+    ebpf_extension_data_t client_data;
+    ebpf_extension_client_t* extension_client_context;
+    void* provider_binding_context;
+
+    // Number of links that reference this attach point.
+    uint32_t reference_count;
+    ebpf_link_array_t* volatile links;
+} ebpf_link_attach_point_t;
+
+static ebpf_lock_t _ebpf_link_attach_point_lock = {0};
+static _Requires_lock_held_(&_ebpf_link_attach_point_lock) ebpf_list_entry_t _ebpf_link_attach_points;
+
 static ebpf_result_t
 _ebpf_link_instance_invoke(
     _In_ const void* extension_client_binding_context, _Inout_ void* program_context, _Out_ uint32_t* result);
 
+static ebpf_result_t
+_ebpf_link_attach_point_invoke(
+    _In_ const void* extension_client_binding_context, _Inout_ void* program_context, _Out_ uint32_t* result);
+
 static struct
 {
     size_t size;
     _ebpf_extension_dispatch_function function[1];
 } _ebpf_link_dispatch_table = {1, {_ebpf_link_instance_invoke}};
 
+static struct
+{
+    size_t size;
+    _ebpf_extension_dispatch_function function[1];
+} _ebpf_link_attach_point_dispatch_table = {1, {_ebpf_link_attach_point_invoke}};
+
+void
+ebpf_link_initiate()
+{
+    ebpf_lock_create(&_ebpf_link_attach_point_lock);
+    ebpf_list_initialize(&_ebpf_link_attach_points);
+}
+
+void
+ebpf_link_terminate()
+{
+    ebpf_assert(ebpf_list_is_empty(&_ebpf_link_attach_points) || ebpf_fuzzing_enabled);
+    ebpf_lock_destroy(&_ebpf_link_attach_point_lock);
+}
+
 static void
 _ebpf_link_free(_Frees_ptr_ ebpf_core_object_t* object)
 {
@@ -64,17 +129,22 @@ ebpf_link_create(_Outptr_ ebpf_link_t** link)
     EBPF_RETURN_RESULT(EBPF_SUCCESS);
 }
 
-_Must_inspect_result_ ebpf_result_t
-ebpf_link_initialize(
-    _Inout_ ebpf_link_t* link,
+/**
+ * @brief Load the hook extension for an attach type and validate the attach
+ * provider data it returns.
+ */
+static ebpf_result_t
+_ebpf_link_load_hook_extension(
     ebpf_attach_type_t attach_type,
-    _In_reads_(context_data_length) const uint8_t* context_data,
-    size_t context_data_length)
+    _In_ const void* client_context,
+    _In_ const ebpf_extension_data_t* client_data,
+    _In_ const ebpf_extension_dispatch_table_t* client_dispatch_table,
+    _Outptr_ ebpf_extension_client_t** extension_client_context,
+    _Outptr_ void** provider_binding_context,
+    _Out_ ebpf_attach_provider_data_t* attach_provider_data)
 {
-    EBPF_LOG_ENTRY();
     ebpf_result_t return_value;
     ebpf_extension_data_t* provider_data;
-    ebpf_attach_provider_data_t* attach_provider_data;
     GUID module_id = {0};
 
     return_value = ebpf_guid_create(&module_id);
@@ -82,27 +152,15 @@ ebpf_link_initialize(
         goto Exit;
     }
 
-    link->client_data.version = 0;
-    link->client_data.size = context_data_length;
-
-    if (context_data_length > 0) {
-        link->client_data.data = ebpf_allocate(context_data_length);
-        if (!link->client_data.data) {
-            return_value = EBPF_NO_MEMORY;
-            goto Exit;
-        }
-        memcpy(link->client_data.data, context_data, context_data_length);
-    }
-
     return_value = ebpf_extension_load(
-        &(link->extension_client_context),
+        extension_client_context,
         &ebpf_hook_extension_interface_id, // Load hook extension.
         &attach_type,                      // Attach type is the expected provider module Id.
         &module_id,
-        link,
-        &link->client_data,
-        (ebpf_extension_dispatch_table_t*)&_ebpf_link_dispatch_table,
-        &(link->provider_binding_context),
+        client_context,
+        client_data,
+        client_dispatch_table,
+        provider_binding_context,
         &provider_data,
         NULL,
         NULL);
@@ -121,11 +179,335 @@ ebpf_link_initialize(
         goto Exit;
     }
 
-    attach_provider_data = (ebpf_attach_provider_data_t*)provider_data->data;
-    link->program_type = attach_provider_data->supported_program_type;
+    *attach_provider_data = *(ebpf_attach_provider_data_t*)provider_data->data;
+
+Exit:
+    return return_value;
+}
+
+static ebpf_result_t
+_ebpf_link_copy_client_data(
+    _Out_ ebpf_extension_data_t* client_data,
+    _In_reads_(context_data_length) const uint8_t* context_data,
+    size_t context_data_length)
+{
+    client_data->version = 0;
+    client_data->size = context_data_length;
+    client_data->data = NULL;
+
+    if (context_data_length > 0) {
+        client_data->data = ebpf_allocate(context_data_length);
+        if (!client_data->data) {
+            return EBPF_NO_MEMORY;
+        }
+        memcpy(client_data->data, context_data, context_data_length);
+    }
+    return EBPF_SUCCESS;
+}
+
+_Must_inspect_result_ ebpf_result_t
+ebpf_link_initialize(
+    _Inout_ ebpf_link_t* link,
+    ebpf_attach_type_t attach_type,
+    _In_reads_(context_data_length) const uint8_t* context_data,
+    size_t context_data_length)
+{
+    EBPF_LOG_ENTRY();
+    ebpf_result_t return_value;
+    ebpf_attach_provider_data_t attach_provider_data;
+
+    return_value = _ebpf_link_copy_client_data(&link->client_data, context_data, context_data_length);
+    if (return_value != EBPF_SUCCESS) {
+        goto Exit;
+    }
+
+    return_value = _ebpf_link_load_hook_extension(
+        attach_type,
+        link,
+        &link->client_data,
+        (ebpf_extension_dispatch_table_t*)&_ebpf_link_dispatch_table,
+        &link->extension_client_context,
+        &link->provider_binding_context,
+        &attach_provider_data);
+    if (return_value != EBPF_SUCCESS) {
+        goto Exit;
+    }
+
+    link->program_type = attach_provider_data.supported_program_type;
     link->attach_type = attach_type;
-    link->bpf_attach_type = attach_provider_data->bpf_attach_type;
-    link->link_type = attach_provider_data->link_type;
+    link->bpf_attach_type = attach_provider_data.bpf_attach_type;
+    link->link_type = attach_provider_data.link_type;
+
+Exit:
+    EBPF_RETURN_RESULT(return_value);
+}
+
+static _Requires_lock_held_(&_ebpf_link_attach_point_lock) ebpf_link_attach_point_t* _ebpf_link_attach_point_find(
+    _In_ const ebpf_attach_type_t* attach_type,
+    _In_reads_(context_data_length) const uint8_t* context_data,
+    size_t context_data_length)
+{
+    for (ebpf_list_entry_t* entry = _ebpf_link_attach_points.Flink; entry != &_ebpf_link_attach_points;
+         entry = entry->Flink) {
+        ebpf_link_attach_point_t* attach_point = CONTAINING_RECORD(entry, ebpf_link_attach_point_t, entry);
+        if (memcmp(&attach_point->attach_type, attach_type, sizeof(*attach_type)) != 0) {
+            continue;
+        }
+        if (attach_point->client_data.size != context_data_length) {
+            continue;
+        }
+        if (context_data_length > 0 && memcmp(attach_point->client_data.data, context_data, context_data_length) != 0) {
+            continue;
+        }
+        return attach_point;
+    }
+    return NULL;
+}
+
+static void
+_ebpf_link_attach_point_free(_Frees_ptr_ ebpf_link_attach_point_t* attach_point)
+{
+    // Unloading the extension waits for the provider to detach, after which
+    // no new invocations can start. In-flight readers are covered by the epoch.
+    ebpf_extension_unload(attach_point->extension_client_context);
+    ebpf_free(attach_point->client_data.data);
+    ebpf_epoch_free(attach_point->links);
+    ebpf_epoch_free(attach_point);
+}
+
+static ebpf_result_t
+_ebpf_link_attach_point_create(
+    ebpf_attach_type_t attach_type,
+    _In_reads_(context_data_length) const uint8_t* context_data,
+    size_t context_data_length,
+    uint32_t continue_verdict,
+    _Outptr_ ebpf_link_attach_point_t** attach_point)
+{
+    ebpf_result_t return_value;
+    ebpf_link_attach_point_t* new_attach_point = ebpf_epoch_allocate(sizeof(ebpf_link_attach_point_t));
+    if (new_attach_point == NULL) {
+        return EBPF_NO_MEMORY;
+    }
+    memset(new_attach_point, 0, sizeof(ebpf_link_attach_point_t));
+
+    new_attach_point->attach_type = attach_type;
+    new_attach_point->continue_verdict = continue_verdict;
+    new_attach_point->reference_count = 1;
+
+    return_value = _ebpf_link_copy_client_data(&new_attach_point->client_data, context_data, context_data_length);
+    if (return_value != EBPF_SUCCESS) {
+        goto Exit;
+    }
+
+    return_value = _ebpf_link_load_hook_extension(
+        attach_type,
+        new_attach_point,
+        &new_attach_point->client_data,
+        (ebpf_extension_dispatch_table_t*)&_ebpf_link_attach_point_dispatch_table,
+        &new_attach_point->extension_client_context,
+        &new_attach_point->provider_binding_context,
+        &new_attach_point->attach_provider_data);
+    if (return_value != EBPF_SUCCESS) {
+        goto Exit;
+    }
+
+    *attach_point = new_attach_point;
+    new_attach_point = NULL;
+
+Exit:
+    if (new_attach_point != NULL) {
+        _ebpf_link_attach_point_free(new_attach_point);
+    }
+    return return_value;
+}
+
+static void
+_ebpf_link_attach_point_release(_Inout_ ebpf_link_attach_point_t* attach_point)
+{
+    bool last_reference = false;
+    ebpf_lock_state_t state = ebpf_lock_lock(&_ebpf_link_attach_point_lock);
+    ebpf_assert(attach_point->reference_count > 0);
+    if (--attach_point->reference_count == 0) {
+        ebpf_list_remove_entry(&attach_point->entry);
+        last_reference = true;
+    }
+    ebpf_lock_unlock(&_ebpf_link_attach_point_lock, state);
+
+    if (last_reference) {
+        _ebpf_link_attach_point_free(attach_point);
+    }
+}
+
+static _Requires_lock_held_(&_ebpf_link_attach_point_lock) void _ebpf_link_attach_point_publish(
+    _Inout_ ebpf_link_attach_point_t* attach_point, _In_opt_ ebpf_link_array_t* links)
+{
+    ebpf_link_array_t* old_links = attach_point->links;
+    // The exchange provides the barrier that orders initialization of the new snapshot before its publication.
+    // Writers are serialized by the lock, so the exchange always succeeds.
+    ebpf_interlocked_compare_exchange_pointer((void* volatile*)&attach_point->links, links, old_links);
+    ebpf_epoch_free(old_links);
+}
+
+static ebpf_result_t
+_ebpf_link_attach_point_insert_link(_Inout_ ebpf_link_attach_point_t* attach_point, _In_ ebpf_link_t* link)
+{
+    ebpf_result_t return_value = EBPF_SUCCESS;
+    ebpf_lock_state_t state = ebpf_lock_lock(&_ebpf_link_attach_point_lock);
+    const ebpf_link_array_t* old_links = attach_point->links;
+    uint32_t old_count = old_links ? old_links->count : 0;
+    uint32_t new_index = 0;
+    bool inserted = false;
+
+    ebpf_link_array_t* new_links = (ebpf_link_array_t*)ebpf_epoch_allocate(
+        FIELD_OFFSET(ebpf_link_array_t, links) + ((size_t)old_count + 1) * sizeof(ebpf_link_t*));
+    if (new_links == NULL) {
+        return_value = EBPF_NO_MEMORY;
+        goto Exit;
+    }
+
+    // Links with equal priority run in the order they were attached.
+    for (uint32_t index = 0; index < old_count; index++) {
+        ebpf_link_t* old_link = old_links->links[index];
+        if (old_link == NULL) {
+            continue;
+        }
+        if (!inserted && link->priority < old_link->priority) {
+            new_links->links[new_index++] = link;
+            inserted = true;
+        }
+        new_links->links[new_index++] = old_link;
+    }
+    if (!inserted) {
+        new_links->links[new_index++] = link;
+    }
+    new_links->count = new_index;
+
+    _ebpf_link_attach_point_publish(attach_point, new_links);
+
+Exit:
+    ebpf_lock_unlock(&_ebpf_link_attach_point_lock, state);
+    return return_value;
+}
+
+static void
+_ebpf_link_attach_point_remove_link(_Inout_ ebpf_link_attach_point_t* attach_point, _In_ const ebpf_link_t* link)
+{
+    ebpf_lock_state_t state = ebpf_lock_lock(&_ebpf_link_attach_point_lock);
+    ebpf_link_array_t* old_links = attach_point->links;
+    ebpf_link_array_t* new_links = NULL;
+    uint32_t new_index = 0;
+    uint32_t remaining_count = 0;
+    uint32_t found_index = 0;
+    bool found = false;
+
+    if (old_links == NULL) {
+        goto Exit;
+    }
+
+    for (uint32_t index = 0; index < old_links->count; index++) {
+        if (old_links->links[index] == link) {
+            found_index = index;
+            found = true;
+        } else if (old_links->links[index] != NULL) {
+            remaining_count++;
+        }
+    }
+    if (!found) {
+        goto Exit;
+    }
+
+    if (remaining_count > 0) {
+        new_links = (ebpf_link_array_t*)ebpf_epoch_allocate(
+            FIELD_OFFSET(ebpf_link_array_t, links) + (size_t)remaining_count * sizeof(ebpf_link_t*));
+        if (new_links == NULL) {
+            // Removal must not fail. Clear the entry in place instead, so that the link is no longer dispatched to
+            // once this returns. The next snapshot that is published drops the entry.
+            ebpf_interlocked_compare_exchange_pointer((void* volatile*)&old_links->links[found_index], NULL, link);
+            goto Exit;
+        }
+        for (uint32_t index = 0; index < old_links->count; index++) {
+            if (old_links->links[index] != link && old_links->links[index] != NULL) {
+                new_links->links[new_index++] = old_links->links[index];
+            }
+        }
+        new_links->count = new_index;
+    }
+
+    _ebpf_link_attach_point_publish(attach_point, new_links);
+
+Exit:
+    ebpf_lock_unlock(&_ebpf_link_attach_point_lock, state);
+}
+
+_Must_inspect_result_ ebpf_result_t
+ebpf_link_initialize_shared(
+    _Inout_ ebpf_link_t* link,
+    ebpf_attach_type_t attach_type,
+    _In_reads_(context_data_length) const uint8_t* context_data,
+    size_t context_data_length,
+    int32_t priority,
+    uint32_t continue_verdict)
+{
+    EBPF_LOG_ENTRY();
+    ebpf_result_t return_value;
+    ebpf_lock_state_t state;
+    ebpf_link_attach_point_t* attach_point = NULL;
+    ebpf_link_attach_point_t* new_attach_point = NULL;
+
+    return_value = _ebpf_link_copy_client_data(&link->client_data, context_data, context_data_length);
+    if (return_value != EBPF_SUCCESS) {
+        goto Exit;
+    }
+
+    state = ebpf_lock_lock(&_ebpf_link_attach_point_lock);
+    attach_point = _ebpf_link_attach_point_find(&attach_type, context_data, context_data_length);
+    if (attach_point != NULL) {
+        attach_point->reference_count++;
+    }
+    ebpf_lock_unlock(&_ebpf_link_attach_point_lock, state);
+
+    if (attach_point == NULL) {
+        // Loading the extension blocks, so it cannot be done while holding the lock.
+        return_value = _ebpf_link_attach_point_create(
+            attach_type, context_data, context_data_length, continue_verdict, &new_attach_point);
+        if (return_value != EBPF_SUCCESS) {
+            goto Exit;
+        }
+
+        state = ebpf_lock_lock(&_ebpf_link_attach_point_lock);
+        attach_point = _ebpf_link_attach_point_find(&attach_type, context_data, context_data_length);
+        if (attach_point != NULL) {
+            // Another link created the attach point first.
+            attach_point->reference_count++;
+        } else {
+            ebpf_list_insert_tail(&_ebpf_link_attach_points, &new_attach_point->entry);
+            attach_point = new_attach_point;
+            new_attach_point = NULL;
+        }
+        ebpf_lock_unlock(&_ebpf_link_attach_point_lock, state);
+
+        if (new_attach_point != NULL) {
+            _ebpf_link_attach_point_free(new_attach_point);
+        }
+    }
+
+    if (attach_point->continue_verdict != continue_verdict) {
+        EBPF_LOG_MESSAGE_GUID(
+            EBPF_TRACELOG_LEVEL_ERROR,
+            EBPF_TRACELOG_KEYWORD_LINK,
+            "Continue verdict does not match the shared attach point",
+            attach_type);
+        _ebpf_link_attach_point_release(attach_point);
+        return_value = EBPF_INVALID_ARGUMENT;
+        goto Exit;
+    }
+
+    link->attach_point = attach_point;
+    link->priority = priority;
+    link->program_type = attach_point->attach_provider_data.supported_program_type;
+    link->attach_type = attach_type;
+    link->bpf_attach_type = attach_point->attach_provider_data.bpf_attach_type;
+    link->link_type = attach_point->attach_provider_data.link_type;
 
 Exit:
     EBPF_RETURN_RESULT(return_value);
@@ -154,6 +536,13 @@ ebpf_link_attach_program(_Inout_ ebpf_link_t* link, _Inout_ ebpf_program_t* prog
         goto Done;
     }
 
+    if (link->attach_point != NULL) {
+        return_value = _ebpf_link_attach_point_insert_link(link->attach_point, link);
+        if (return_value != EBPF_SUCCESS) {
+            goto Done;
+        }
+    }
+
     link->program = program;
     link->detaching = FALSE;
     ebpf_program_attach_link(program, link);
@@ -163,26 +552,94 @@ Done:
     EBPF_RETURN_RESULT(return_value);
 }
 
+_Must_inspect_result_ ebpf_result_t
+ebpf_link_update_program(
+    _Inout_ ebpf_link_t* link, _Inout_ ebpf_program_t* new_program, _In_opt_ const ebpf_program_t* old_program)
+{
+    EBPF_LOG_ENTRY();
+    ebpf_result_t return_value = EBPF_SUCCESS;
+    ebpf_lock_state_t state;
+    ebpf_program_t* current_program;
+    ebpf_program_t* referenced_program = NULL;
+    state = ebpf_lock_lock(&link->attach_lock);
+    current_program = link->program;
+    if (current_program == NULL || link->detaching) {
+        return_value = EBPF_INVALID_ARGUMENT;
+        goto Done;
+    }
+
+    if (old_program != NULL && old_program != current_program) {
+        EBPF_LOG_MESSAGE(
+            EBPF_TRACELOG_LEVEL_ERROR, EBPF_TRACELOG_KEYWORD_LINK, "Update failed as the link has a different program");
+        return_value = EBPF_INVALID_ARGUMENT;
+        goto Done;
+    }
+
+    const ebpf_program_type_t* program_type = ebpf_program_type_uuid(new_program);
+    if (memcmp(program_type, &link->program_type, sizeof(link->program_type)) != 0) {
+        EBPF_LOG_MESSAGE_GUID(
+            EBPF_TRACELOG_LEVEL_ERROR,
+            EBPF_TRACELOG_KEYWORD_LINK,
+            "Update failed due to incorrect program type",
+            *program_type);
+        return_value = EBPF_INVALID_ARGUMENT;
+        goto Done;
+    }
+
+    if (new_program == current_program) {
+        goto Done;
+    }
+
+    // The link stays bound to the hook provider throughout, so invocations see either the old or the new program.
+    // The new program is published before the link leaves the old program's attach list, so the old program can't
+    // be freed through the epoch while an invocation can still read it from the link. The new program is referenced
+    // until the link is in its attach list, so it can't be freed without detaching the link.
+    ebpf_object_acquire_reference((ebpf_core_object_t*)new_program);
+    referenced_program = new_program;
+    ebpf_interlocked_compare_exchange_pointer((void* volatile*)&link->program, new_program, current_program);
+    ebpf_program_move_link(current_program, new_program, link);
+
+Done:
+    ebpf_lock_unlock(&link->attach_lock, state);
+    if (referenced_program != NULL) {
+        // Released outside the lock, as freeing a program detaches its links.
+        ebpf_object_release_reference((ebpf_core_object_t*)referenced_program);
+    }
+    EBPF_RETURN_RESULT(return_value);
+}
+
 void
 ebpf_link_detach_program(_Inout_ ebpf_link_t* link)
 {
     EBPF_LOG_ENTRY();
     ebpf_lock_state_t state;
     ebpf_program_t* program = NULL;
+    ebpf_link_attach_point_t* attach_point = NULL;
 
     state = ebpf_lock_lock(&link->attach_lock);
     if (link->program != NULL && !link->detaching) {
         program = link->program;
         link->detaching = TRUE;
     }
+    attach_point = link->attach_point;
+    link->attach_point = NULL;
     ebpf_lock_unlock(&link->attach_lock, state);
 
+    if (attach_point != NULL) {
+        // Stop dispatching to this link before dropping the program's reference on it.
+        _ebpf_link_attach_point_remove_link(attach_point, link);
+    }
+
     if (program != NULL) {
         ebpf_program_detach_link(program, link);
     }
 
     ebpf_extension_unload(link->extension_client_context);
 
+    if (attach_point != NULL) {
+        _ebpf_link_attach_point_release(attach_point);
+    }
+
     state = ebpf_lock_lock(&link->attach_lock);
     link->program = NULL;
     ebpf_lock_unlock(&link->attach_lock, state);
@@ -220,6 +677,52 @@ Exit:
     EBPF_RETURN_RESULT(return_value);
 }
 
+static ebpf_result_t
+_ebpf_link_attach_point_invoke(
+    _In_ const void* extension_client_binding_context, _Inout_ void* program_context, _Out_ uint32_t* result)
+{
+    // No function entry exit traces as this is a high volume function.
+    ebpf_result_t return_value;
+    ebpf_link_attach_point_t* attach_point =
+        (ebpf_link_attach_point_t*)ebpf_extension_get_client_context(extension_client_binding_context);
+
+    if (attach_point == NULL) {
+        GUID npi_id = ebpf_extension_get_provider_guid(extension_client_binding_context);
+        EBPF_LOG_MESSAGE_GUID(
+            EBPF_TRACELOG_LEVEL_WARNING, EBPF_TRACELOG_KEYWORD_LINK, "Client context is null", npi_id);
+        return_value = EBPF_FAILED;
+        goto Exit;
+    }
+
+    return_value = ebpf_epoch_enter();
+    if (return_value != EBPF_SUCCESS)
+        goto Exit;
+
+    // Run programs in priority order until one returns a verdict other than the continue verdict.
+    *result = attach_point->continue_verdict;
+    const ebpf_link_array_t* links = attach_point->links;
+    if (links != NULL) {
+        for (uint32_t index = 0; index < links->count; index++) {
+            const ebpf_link_t* link = links->links[index];
+            if (link == NULL) {
+                continue;
+            }
+            const ebpf_program_t* program = link->program;
+            if (program == NULL) {
+                continue;
+            }
+            ebpf_program_invoke(program, program_context, result);
+            if (*result != attach_point->continue_verdict) {
+                break;
+            }
+        }
+    }
+    ebpf_epoch_exit();
+
+Exit:
+    EBPF_RETURN_RESULT(return_value);
+}
+
 _Must_inspect_result_ ebpf_result_t
 ebpf_link_get_info(
     _In_ const ebpf_link_t* link, _Out_writes_to_(*info_size, *info_size) uint8_t* buffer, _Inout_ uint16_t* info_size)
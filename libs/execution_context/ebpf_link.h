@@ -14,6 +14,18 @@ extern "C"
     typedef struct _ebpf_link ebpf_link_t;
     typedef struct _ebpf_program ebpf_program_t;
 
+    /**
+     * @brief Initialize global state used by link objects.
+     */
+    void
+    ebpf_link_initiate();
+
+    /**
+     * @brief Uninitialize global state used by link objects.
+     */
+    void
+    ebpf_link_terminate();
+
     /**
      * @brief Create a new link object.
      *
@@ -44,6 +56,37 @@ extern "C"
         _In_reads_(context_data_length) const uint8_t* context_data,
         size_t context_data_length);
 
+    /**
+     * @brief Initialize this link object as a member of a shared attach point.
+     *  All links initialized this way with the same attach type and context
+     *  data share a single hook provider binding, and their programs are
+     *  invoked in ascending priority order until one of them returns a value
+     *  other than continue_verdict.
+     *
+     * @param[in, out] link The link object to initialize.
+     * @param[in] attach_type Attach type to load.
+     * @param[in] context_data Data to be passed to the hook provider.
+     * @param[in] context_data_length Length of the data to be passed to the hook
+     *  provider.
+     * @param[in] priority Position of this link in the invocation order. Links
+     *  with equal priority are invoked in the order they were attached.
+     * @param[in] continue_verdict Program return value that causes the next
+     *  program to be invoked.
+     * @retval EBPF_SUCCESS The operation was successful.
+     * @retval EBPF_NO_MEMORY Unable to allocate resources for this
+     *  operation.
+     * @retval EBPF_INVALID_ARGUMENT The attach point already exists with a
+     *  different continue verdict.
+     */
+    _Must_inspect_result_ ebpf_result_t
+    ebpf_link_initialize_shared(
+        _Inout_ ebpf_link_t* link,
+        ebpf_attach_type_t attach_type,
+        _In_reads_(context_data_length) const uint8_t* context_data,
+        size_t context_data_length,
+        int32_t priority,
+        uint32_t continue_verdict);
+
     /**
      * @brief Attach a program to this link object.
      *
@@ -56,6 +99,23 @@ extern "C"
     _Must_inspect_result_ ebpf_result_t
     ebpf_link_attach_program(_Inout_ ebpf_link_t* link, _Inout_ ebpf_program_t* program);
 
+    /**
+     * @brief Atomically replace the program attached to this link object
+     *  without detaching the link from its hook provider.
+     *
+     * @param[in, out] link The link object to update.
+     * @param[in, out] new_program The program to attach to this link object.
+     * @param[in] old_program Optionally, the program that is expected to be
+     *  attached to this link object.
+     * @retval EBPF_SUCCESS The operation was successful.
+     * @retval EBPF_INVALID_ARGUMENT The link has no program attached, the
+     *  attached program is not old_program, or new_program has the wrong
+     *  program type.
+     */
+    _Must_inspect_result_ ebpf_result_t
+    ebpf_link_update_program(
+        _Inout_ ebpf_link_t* link, _Inout_ ebpf_program_t* new_program, _In_opt_ const ebpf_program_t* old_program);
+
     /**
      * @brief Detach a program from this link object.
      *
@@ -17,6 +17,8 @@ typedef struct _ebpf_core_map
     ebpf_map_definition_in_memory_t ebpf_map_definition;
     uint32_t original_value_size;
     uint8_t* data;
+    // Set once the map's entries can no longer be updated or deleted.
+    bool frozen;
 } ebpf_core_map_t;
 
 typedef struct _ebpf_core_object_map
@@ -114,6 +116,16 @@ typedef struct _ebpf_core_ring_buffer_map
     // for all subsequent updates, so should only be allowed to admin.
     bool async_contexts_trip_wire;
     ebpf_list_entry_t async_contexts;
+    // Thresholds that batch up records before a pending async query is completed. When both thresholds are 0, the
+    // query is completed as soon as there is data to consume.
+    uint32_t wakeup_bytes;
+    uint32_t wakeup_records;
+    // Maximum time a record waits for a threshold to be reached before the query is completed anyway.
+    uint32_t max_wakeup_latency_us;
+    // Number of records written since the last async query completion.
+    uint32_t pending_records;
+    ebpf_timer_work_item_t* wakeup_timer;
+    bool wakeup_timer_armed;
 } ebpf_core_ring_buffer_map_t;
 
 typedef struct _ebpf_core_ring_buffer_map_async_query_context
@@ -288,6 +300,18 @@ ebpf_map_get_effective_value_size(_In_ const ebpf_map_t* map)
     return map->original_value_size;
 }
 
+_Ret_maybenull_ uint8_t*
+ebpf_map_get_array_data(_In_ const ebpf_map_t* map)
+{
+    return (map->ebpf_map_definition.type == BPF_MAP_TYPE_ARRAY) ? map->data : NULL;
+}
+
+void
+ebpf_map_freeze(_Inout_ ebpf_map_t* map)
+{
+    map->frozen = true;
+}
+
 static ebpf_result_t
 _create_array_map_with_map_struct_size(
     size_t map_struct_size, _In_ const ebpf_map_definition_in_memory_t* map_definition, _Outptr_ ebpf_core_map_t** map)
@@ -1674,17 +1698,80 @@ static _Requires_lock_held_(ring_buffer_map->lock) void _ebpf_ring_buffer_map_si
         ebpf_async_complete(context->async_context, sizeof(*async_query_result), EBPF_SUCCESS);
         ebpf_free(context);
         context = NULL;
+        ring_buffer_map->pending_records = 0;
+    }
+}
+
+static _Requires_lock_held_(ring_buffer_map->lock) bool _ebpf_ring_buffer_map_wakeup_threshold_reached(
+    _In_ const ebpf_core_ring_buffer_map_t* ring_buffer_map, size_t unconsumed_bytes)
+{
+    if (ring_buffer_map->wakeup_bytes == 0 && ring_buffer_map->wakeup_records == 0) {
+        return true;
+    }
+    if (ring_buffer_map->wakeup_bytes != 0 && unconsumed_bytes >= ring_buffer_map->wakeup_bytes) {
+        return true;
+    }
+    return ring_buffer_map->wakeup_records != 0 && ring_buffer_map->pending_records >= ring_buffer_map->wakeup_records;
+}
+
+/**
+ * @brief Complete the pending async query if a wakeup threshold is reached,
+ * otherwise make sure the data doesn't wait longer than the maximum latency.
+ */
+static _Requires_lock_held_(ring_buffer_map->lock) void _ebpf_ring_buffer_map_wakeup_if_needed(
+    _Inout_ ebpf_core_ring_buffer_map_t* ring_buffer_map)
+{
+    size_t consumer;
+    size_t producer;
+
+    if (ebpf_list_is_empty(&ring_buffer_map->async_contexts)) {
+        return;
+    }
+    ebpf_ring_buffer_query((ebpf_ring_buffer_t*)ring_buffer_map->core_map.data, &consumer, &producer);
+    if (producer == consumer) {
+        return;
+    }
+    if (_ebpf_ring_buffer_map_wakeup_threshold_reached(ring_buffer_map, producer - consumer)) {
+        _ebpf_ring_buffer_map_signal_async_query_complete(ring_buffer_map);
+    } else if (
+        ring_buffer_map->max_wakeup_latency_us != 0 && ring_buffer_map->wakeup_timer != NULL &&
+        !ring_buffer_map->wakeup_timer_armed) {
+        ring_buffer_map->wakeup_timer_armed = true;
+        ebpf_schedule_timer_work_item(ring_buffer_map->wakeup_timer, ring_buffer_map->max_wakeup_latency_us);
+    }
+}
+
+static void
+_ebpf_ring_buffer_map_wakeup_timer_routine(_Inout_opt_ void* context)
+{
+    ebpf_core_ring_buffer_map_t* ring_buffer_map = (ebpf_core_ring_buffer_map_t*)context;
+    if (!ring_buffer_map) {
+        return;
+    }
+
+    size_t consumer;
+    size_t producer;
+    ebpf_lock_state_t state = ebpf_lock_lock(&ring_buffer_map->lock);
+    ring_buffer_map->wakeup_timer_armed = false;
+    ebpf_ring_buffer_query((ebpf_ring_buffer_t*)ring_buffer_map->core_map.data, &consumer, &producer);
+    if (producer != consumer) {
+        _ebpf_ring_buffer_map_signal_async_query_complete(ring_buffer_map);
     }
+    ebpf_lock_unlock(&ring_buffer_map->lock, state);
 }
 
 static void
 _delete_ring_buffer_map(_In_ _Post_invalid_ ebpf_core_map_t* map)
 {
     EBPF_LOG_ENTRY();
+    ebpf_core_ring_buffer_map_t* ring_buffer_map = EBPF_FROM_FIELD(ebpf_core_ring_buffer_map_t, core_map, map);
+
+    // Wait for any running wakeup timer before freeing the ring buffer it queries.
+    ebpf_free_timer_work_item(ring_buffer_map->wakeup_timer);
+
     // Free the ring buffer.
     ebpf_ring_buffer_destroy((ebpf_ring_buffer_t*)map->data);
 
-    ebpf_core_ring_buffer_map_t* ring_buffer_map = EBPF_FROM_FIELD(ebpf_core_ring_buffer_map_t, core_map, map);
     // Snap the async context list.
     ebpf_list_entry_t temp_list;
     ebpf_list_initialize(&temp_list);
@@ -1751,7 +1838,8 @@ Exit:
 }
 
 _Must_inspect_result_ ebpf_result_t
-ebpf_ring_buffer_map_output(_Inout_ ebpf_core_map_t* map, _In_reads_bytes_(length) uint8_t* data, size_t length)
+ebpf_ring_buffer_map_output(
+    _Inout_ ebpf_core_map_t* map, _In_reads_bytes_(length) uint8_t* data, size_t length, uint64_t flags)
 {
     ebpf_result_t result = EBPF_SUCCESS;
 
@@ -1764,7 +1852,12 @@ ebpf_ring_buffer_map_output(_Inout_ ebpf_core_map_t* map, _In_reads_bytes_(lengt
     ebpf_core_ring_buffer_map_t* ring_buffer_map = EBPF_FROM_FIELD(ebpf_core_ring_buffer_map_t, core_map, map);
 
     ebpf_lock_state_t state = ebpf_lock_lock(&ring_buffer_map->lock);
-    _ebpf_ring_buffer_map_signal_async_query_complete(ring_buffer_map);
+    ring_buffer_map->pending_records++;
+    if (flags & BPF_RB_FORCE_WAKEUP) {
+        _ebpf_ring_buffer_map_signal_async_query_complete(ring_buffer_map);
+    } else if (!(flags & BPF_RB_NO_WAKEUP) && ring_buffer_map->async_contexts_trip_wire) {
+        _ebpf_ring_buffer_map_wakeup_if_needed(ring_buffer_map);
+    }
     ebpf_lock_unlock(&ring_buffer_map->lock, state);
 
 Exit:
@@ -1845,12 +1938,11 @@ ebpf_ring_buffer_map_async_query(
     ebpf_list_insert_tail(&ring_buffer_map->async_contexts, &context->entry);
     ring_buffer_map->async_contexts_trip_wire = true;
 
-    // If there is already some data available in the ring buffer, indicate the results right away.
+    // If enough data is already available in the ring buffer, indicate the results right away.
     ebpf_ring_buffer_query(
         (ebpf_ring_buffer_t*)map->data, &async_query_result->consumer, &async_query_result->producer);
 
-    if (async_query_result->producer != async_query_result->consumer)
-        _ebpf_ring_buffer_map_signal_async_query_complete(ring_buffer_map);
+    _ebpf_ring_buffer_map_wakeup_if_needed(ring_buffer_map);
 
 Exit:
     ebpf_lock_unlock(&ring_buffer_map->lock, state);
@@ -1858,6 +1950,43 @@ Exit:
     EBPF_RETURN_RESULT(result);
 }
 
+_Must_inspect_result_ ebpf_result_t
+ebpf_ring_buffer_map_set_wakeup_thresholds(
+    _Inout_ ebpf_map_t* map, uint32_t wakeup_bytes, uint32_t wakeup_records, uint32_t max_wakeup_latency_us)
+{
+    ebpf_result_t result = EBPF_SUCCESS;
+    ebpf_timer_work_item_t* wakeup_timer = NULL;
+    EBPF_LOG_ENTRY();
+
+    ebpf_core_ring_buffer_map_t* ring_buffer_map = EBPF_FROM_FIELD(ebpf_core_ring_buffer_map_t, core_map, map);
+
+    // The timer is allocated on first use, outside the lock.
+    if (max_wakeup_latency_us != 0 && ring_buffer_map->wakeup_timer == NULL) {
+        result =
+            ebpf_allocate_timer_work_item(&wakeup_timer, _ebpf_ring_buffer_map_wakeup_timer_routine, ring_buffer_map);
+        if (result != EBPF_SUCCESS)
+            goto Exit;
+    }
+
+    ebpf_lock_state_t state = ebpf_lock_lock(&ring_buffer_map->lock);
+    if (wakeup_timer != NULL && ring_buffer_map->wakeup_timer == NULL) {
+        ring_buffer_map->wakeup_timer = wakeup_timer;
+        wakeup_timer = NULL;
+    }
+    ring_buffer_map->wakeup_bytes = wakeup_bytes;
+    ring_buffer_map->wakeup_records = wakeup_records;
+    ring_buffer_map->max_wakeup_latency_us = max_wakeup_latency_us;
+
+    // Lowering the thresholds may make the pending data due.
+    _ebpf_ring_buffer_map_wakeup_if_needed(ring_buffer_map);
+    ebpf_lock_unlock(&ring_buffer_map->lock, state);
+
+Exit:
+    // Another caller allocated the timer first.
+    ebpf_free_timer_work_item(wakeup_timer);
+    EBPF_RETURN_RESULT(result);
+}
+
 const ebpf_map_metadata_table_t ebpf_map_metadata_tables[] = {
     {
         BPF_MAP_TYPE_UNSPEC,
@@ -2308,6 +2437,12 @@ ebpf_map_update_entry(
     // High volume call - Skip entry/exit logging.
     ebpf_result_t result;
 
+    if (map->frozen) {
+        EBPF_LOG_MESSAGE_UINT64(
+            EBPF_TRACELOG_LEVEL_ERROR, EBPF_TRACELOG_KEYWORD_MAP, "Map is frozen", map->ebpf_map_definition.type);
+        return EBPF_ACCESS_DENIED;
+    }
+
     if (ebpf_map_metadata_tables[map->ebpf_map_definition.type].zero_length_key) {
         if (key_size != 0) {
             EBPF_LOG_MESSAGE_UINT64(
@@ -2393,6 +2528,12 @@ _Must_inspect_result_ ebpf_result_t
 ebpf_map_delete_entry(_In_ ebpf_map_t* map, size_t key_size, _In_reads_(key_size) const uint8_t* key, int flags)
 {
     // High volume call - Skip entry/exit logging.
+    if (map->frozen) {
+        EBPF_LOG_MESSAGE_UINT64(
+            EBPF_TRACELOG_LEVEL_ERROR, EBPF_TRACELOG_KEYWORD_MAP, "Map is frozen", map->ebpf_map_definition.type);
+        return EBPF_ACCESS_DENIED;
+    }
+
     if (!(flags & EBPF_MAP_FLAG_HELPER) && (key_size != map->ebpf_map_definition.key_size)) {
         EBPF_LOG_MESSAGE_UINT64_UINT64(
             EBPF_TRACELOG_LEVEL_ERROR,
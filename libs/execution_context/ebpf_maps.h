@@ -55,6 +55,26 @@ extern "C"
     uint32_t
     ebpf_map_get_effective_value_size(_In_ const ebpf_map_t* map);
 
+    /**
+     * @brief Get the values of a BPF_MAP_TYPE_ARRAY map, which are stored
+     * contiguously in key order and don't move for the lifetime of the map.
+     *
+     * @param[in] map Map to query.
+     * @return Pointer to the value of key 0, or NULL if the map is not a
+     *  BPF_MAP_TYPE_ARRAY map.
+     */
+    _Ret_maybenull_ uint8_t*
+    ebpf_map_get_array_data(_In_ const ebpf_map_t* map);
+
+    /**
+     * @brief Freeze a map, so that its entries can no longer be updated or
+     * deleted, either from user mode or by an eBPF program.
+     *
+     * @param[in, out] map Map to freeze.
+     */
+    void
+    ebpf_map_freeze(_Inout_ ebpf_map_t* map);
+
     /**
      * @brief Get a pointer to an entry in the map.
      *
@@ -82,6 +102,7 @@ extern "C"
      * @param[in] flags EBPF_MAP_FLAG_HELPER if called from helper function.
      * @retval EBPF_SUCCESS The operation was successful.
      * @retval EBPF_NO_MEMORY Unable to allocate resources for this entry.
+     * @retval EBPF_ACCESS_DENIED The map is frozen.
      */
     _Must_inspect_result_ ebpf_result_t
     ebpf_map_update_entry(
@@ -120,6 +141,7 @@ extern "C"
      * @retval EBPF_SUCCESS The operation was successful.
      * @retval EBPF_INVALID_ARGUMENT One or more parameters are
      *  invalid.
+     * @retval EBPF_ACCESS_DENIED The map is frozen.
      */
     _Must_inspect_result_ ebpf_result_t
     ebpf_map_delete_entry(_In_ ebpf_map_t* map, size_t key_size, _In_reads_(key_size) const uint8_t* key, int flags);
@@ -223,17 +245,40 @@ extern "C"
         _Inout_ ebpf_ring_buffer_map_async_query_result_t* async_query_result,
         _Inout_ void* async_context);
 
+    /**
+     * @brief Set the thresholds that must be reached before a pending async
+     * query on a ring buffer map is completed.
+     *
+     * @param[in, out] map Ring buffer map to configure.
+     * @param[in] wakeup_bytes Number of unconsumed bytes that completes the
+     *  query, or 0 for no byte threshold.
+     * @param[in] wakeup_records Number of records written since the last
+     *  completion that completes the query, or 0 for no record threshold.
+     * @param[in] max_wakeup_latency_us Maximum time in microseconds that data
+     *  waits for a threshold before the query is completed anyway, or 0 to
+     *  wait until a threshold is reached.
+     * @retval EBPF_SUCCESS The operation was successful.
+     * @retval EBPF_NO_MEMORY Unable to allocate the latency timer.
+     */
+    _Must_inspect_result_ ebpf_result_t
+    ebpf_ring_buffer_map_set_wakeup_thresholds(
+        _Inout_ ebpf_map_t* map, uint32_t wakeup_bytes, uint32_t wakeup_records, uint32_t max_wakeup_latency_us);
+
     /**
      * @brief Write out a variable sized record to the ring buffer map.
      *
      * @param[in, out] map Pointer to map of type EBPF_MAP_TYPE_RINGBUF.
      * @param[in] data Data of record to write into ring buffer map.
      * @param[in] length Length of data.
+     * @param[in] flags BPF_RB_NO_WAKEUP to not notify the consumer of this
+     *  record, BPF_RB_FORCE_WAKEUP to notify it regardless of the wakeup
+     *  thresholds, or 0.
      * @retval EPBF_SUCCESS Successfully wrote record into ring buffer.
      * @retval EBPF_OUT_OF_SPACE Unable to output to ring buffer due to inadequate space.
      */
     _Must_inspect_result_ ebpf_result_t
-    ebpf_ring_buffer_map_output(_Inout_ ebpf_map_t* map, _In_reads_bytes_(length) uint8_t* data, size_t length);
+    ebpf_ring_buffer_map_output(
+        _Inout_ ebpf_map_t* map, _In_reads_bytes_(length) uint8_t* data, size_t length, uint64_t flags);
 
     /**
      * @brief Insert an element at the end of the map (only valid for stack and queue).
@@ -14,7 +14,9 @@
 static const uint32_t _ebpf_native_marker = 'entv';
 
 // Set this value if there is a need to block older version of the native driver.
-static bpf2c_version_t _ebpf_minimum_version = {0, 0, 0};
+// 0.6.0 added array_data, initial_value and read_only to map_entry_t and block_counts and block_count to
+// program_entry_t, which changed the size of the map and program entries the loader indexes.
+static bpf2c_version_t _ebpf_minimum_version = {0, 6, 0};
 
 #ifndef GUID_NULL
 static const GUID GUID_NULL = {0, 0, 0, {0, 0, 0, 0, 0, 0, 0, 0}};
@@ -103,10 +105,10 @@ _ebpf_compare_versions(bpf2c_version_t* lhs, bpf2c_version_t* rhs)
         return 1;
     }
     ebpf_assert(lhs->major == rhs->major);
-    if (lhs->minor < rhs->major) {
+    if (lhs->minor < rhs->minor) {
         return -1;
     }
-    if (lhs->minor > rhs->major) {
+    if (lhs->minor > rhs->minor) {
         return 1;
     }
     ebpf_assert(lhs->minor == rhs->minor);
@@ -572,6 +574,7 @@ _ebpf_native_initialize_maps(
         native_maps[i].entry = &maps[i];
         native_maps[i].original_id = i + ORIGINAL_ID_OFFSET;
         maps[i].address = NULL;
+        maps[i].array_data = NULL;
 
         if (maps[i].definition.pinning == PIN_GLOBAL_NS) {
             // Construct the pin path.
@@ -716,6 +719,40 @@ Exit:
     return result;
 }
 
+static ebpf_result_t
+_ebpf_native_initialize_global_data_map(_In_ const ebpf_native_map_t* map)
+{
+    EBPF_LOG_ENTRY();
+    ebpf_result_t result = EBPF_SUCCESS;
+    ebpf_map_t* object = NULL;
+    uint32_t key = 0;
+
+    result = ebpf_object_reference_by_handle(map->handle, EBPF_OBJECT_MAP, (ebpf_core_object_t**)&object);
+    if (result != EBPF_SUCCESS) {
+        EBPF_RETURN_RESULT(result);
+    }
+
+    // Global data maps hold the whole section in the value of their only entry.
+    if (map->entry->initial_value != NULL) {
+        result = ebpf_map_update_entry(
+            object,
+            sizeof(key),
+            (const uint8_t*)&key,
+            map->entry->definition.value_size,
+            map->entry->initial_value,
+            EBPF_ANY,
+            0);
+    }
+
+    // bpf2c folds loads from read-only data into the program, so the map must keep its initial value.
+    if (result == EBPF_SUCCESS && map->entry->read_only) {
+        ebpf_map_freeze(object);
+    }
+
+    ebpf_object_release_reference((ebpf_core_object_t*)object);
+    EBPF_RETURN_RESULT(result);
+}
+
 static ebpf_result_t
 _ebpf_native_create_maps(_Inout_ ebpf_native_module_t* module)
 {
@@ -787,6 +824,13 @@ _ebpf_native_create_maps(_Inout_ ebpf_native_module_t* module)
             break;
         }
 
+        if (native_map->entry->initial_value != NULL || native_map->entry->read_only) {
+            result = _ebpf_native_initialize_global_data_map(native_map);
+            if (result != EBPF_SUCCESS) {
+                break;
+            }
+        }
+
         ebpf_free(map_name.value);
         map_name.value = NULL;
 
@@ -890,6 +934,7 @@ _ebpf_native_resolve_maps_for_program(_In_ ebpf_native_module_t* module, _In_ co
             goto Done;
         }
         native_maps[map_indices[i]].entry->address = (void*)map_addresses[i];
+        native_maps[map_indices[i]].entry->array_data = ebpf_map_get_array_data((ebpf_map_t*)map_addresses[i]);
     }
 
 Done:
@@ -1420,6 +1465,39 @@ Done:
     EBPF_RETURN_RESULT(result);
 }
 
+_Must_inspect_result_ ebpf_result_t
+ebpf_native_get_block_counts(
+    _In_ const ebpf_native_module_t* module,
+    _In_ const void* function,
+    _Outptr_result_buffer_maybenull_(*block_count) const uint64_t** block_counts,
+    _Out_ size_t* block_count)
+{
+    EBPF_LOG_ENTRY();
+    ebpf_result_t result = EBPF_OBJECT_NOT_FOUND;
+    program_entry_t* programs = NULL;
+    size_t count_of_programs;
+
+    *block_counts = NULL;
+    *block_count = 0;
+
+    module->table->programs(&programs, &count_of_programs);
+    for (size_t i = 0; i < count_of_programs; i++) {
+        if ((const void*)programs[i].function != function) {
+            continue;
+        }
+        if (programs[i].block_counts == NULL) {
+            result = EBPF_OPERATION_NOT_SUPPORTED;
+            break;
+        }
+        *block_counts = programs[i].block_counts;
+        *block_count = programs[i].block_count;
+        result = EBPF_SUCCESS;
+        break;
+    }
+
+    EBPF_RETURN_RESULT(result);
+}
+
 _Must_inspect_result_ ebpf_result_t
 ebpf_native_get_count_of_maps(_In_ const GUID* module_id, _Out_ size_t* count_of_maps)
 {
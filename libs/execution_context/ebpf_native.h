@@ -106,6 +106,25 @@ extern "C"
     _Must_inspect_result_ ebpf_result_t
     ebpf_native_get_count_of_maps(_In_ const GUID* module_id, _Out_ size_t* count_of_maps);
 
+    /**
+     * @brief Get the basic block counters of a program in a native module generated with bpf2c --instrument.
+     *
+     * @param[in] module Native module that contains the program.
+     * @param[in] function Entry point of the program.
+     * @param[out] block_counts Pointer to the counters of the program.
+     * @param[out] block_count Number of counters.
+     *
+     * @retval EBPF_SUCCESS The operation was successful.
+     * @retval EBPF_OBJECT_NOT_FOUND The program was not found in the module.
+     * @retval EBPF_OPERATION_NOT_SUPPORTED The program was generated without instrumentation.
+     */
+    _Must_inspect_result_ ebpf_result_t
+    ebpf_native_get_block_counts(
+        _In_ const ebpf_native_module_binding_context_t* module,
+        _In_ const void* function,
+        _Outptr_result_buffer_maybenull_(*block_count) const uint64_t** block_counts,
+        _Out_ size_t* block_count);
+
     /**
      * @brief Acquire reference on the native module.
      *
@@ -17,6 +17,7 @@
 #include "ebpf_state.h"
 
 #include "ubpf.h"
+#include "ubpf_threaded.h"
 
 static size_t _ebpf_program_state_index = MAXUINT64;
 #define EBPF_MAX_HASH_SIZE 128
@@ -41,6 +42,9 @@ typedef struct _ebpf_program
         // EBPF_CODE_EBPF
         struct ubpf_vm* vm;
 
+        // EBPF_CODE_EBPF_THREADED
+        ubpf_threaded_program_t* threaded;
+
         // EBPF_CODE_NATIVE
         struct
         {
@@ -311,6 +315,9 @@ _ebpf_program_epoch_free(_In_ _Post_invalid_ void* context)
             ubpf_destroy(program->code_or_vm.vm);
         }
         break;
+    case EBPF_CODE_EBPF_THREADED:
+        ubpf_threaded_destroy(program->code_or_vm.threaded);
+        break;
 #endif
     case EBPF_CODE_NATIVE:
         ebpf_native_release_reference((ebpf_native_module_binding_context_t*)program->code_or_vm.native.module);
@@ -731,7 +738,9 @@ _ebpf_program_update_interpret_helpers(_Inout_ ebpf_program_t* program, _Inout_
             continue;
 
 #if !defined(CONFIG_BPF_JIT_ALWAYS_ON)
-        if (ubpf_register(program->code_or_vm.vm, (unsigned int)index, NULL, (void*)helper) < 0) {
+        if (program->parameters.code_type == EBPF_CODE_EBPF_THREADED) {
+            ubpf_threaded_register(program->code_or_vm.threaded, (uint32_t)index, helper);
+        } else if (ubpf_register(program->code_or_vm.vm, (unsigned int)index, NULL, (void*)helper) < 0) {
             EBPF_LOG_MESSAGE_UINT64(
                 EBPF_TRACELOG_LEVEL_ERROR, EBPF_TRACELOG_KEYWORD_PROGRAM, "ubpf_register failed", index);
             result = EBPF_INVALID_ARGUMENT;
@@ -950,6 +959,40 @@ Done:
 
     EBPF_RETURN_RESULT(return_value);
 }
+
+static ebpf_result_t
+_ebpf_program_load_threaded_code(
+    _Inout_ ebpf_program_t* program, _In_ const ebpf_instruction_t* instructions, size_t instruction_count)
+{
+    EBPF_LOG_ENTRY();
+    ebpf_result_t return_value;
+
+    return_value =
+        ubpf_threaded_load((const uint64_t*)instructions, instruction_count, &program->code_or_vm.threaded);
+    if (return_value != EBPF_SUCCESS) {
+        EBPF_LOG_MESSAGE(
+            EBPF_TRACELOG_LEVEL_ERROR, EBPF_TRACELOG_KEYWORD_PROGRAM, "Failed to decode program into threaded code");
+        goto Done;
+    }
+
+    program->helper_function_addresses_changed_callback = _ebpf_program_update_interpret_helpers;
+    program->helper_function_addresses_changed_context = NULL;
+
+    return_value = _ebpf_program_update_helpers(program);
+    if (return_value != EBPF_SUCCESS) {
+        EBPF_LOG_MESSAGE(
+            EBPF_TRACELOG_LEVEL_ERROR, EBPF_TRACELOG_KEYWORD_PROGRAM, "Failed to update helpers for program");
+        goto Done;
+    }
+
+Done:
+    if (return_value != EBPF_SUCCESS) {
+        ubpf_threaded_destroy(program->code_or_vm.threaded);
+        program->code_or_vm.threaded = NULL;
+    }
+
+    EBPF_RETURN_RESULT(return_value);
+}
 #endif
 
 _Must_inspect_result_ ebpf_result_t
@@ -974,6 +1017,13 @@ ebpf_program_load_code(
             program, (const ebpf_instruction_t*)code, code_size / sizeof(ebpf_instruction_t));
 #else
         result = EBPF_BLOCKED_BY_POLICY;
+#endif
+    else if (program->parameters.code_type == EBPF_CODE_EBPF_THREADED)
+#if !defined(CONFIG_BPF_JIT_ALWAYS_ON)
+        result = _ebpf_program_load_threaded_code(
+            program, (const ebpf_instruction_t*)code, code_size / sizeof(ebpf_instruction_t));
+#else
+        result = EBPF_BLOCKED_BY_POLICY;
 #endif
     else {
         EBPF_LOG_MESSAGE_UINT64(
@@ -1047,6 +1097,17 @@ ebpf_program_invoke(_In_ const ebpf_program_t* program, _Inout_ void* context, _
             ebpf_program_entry_point_t function_pointer;
             function_pointer = (ebpf_program_entry_point_t)(current_program->code_or_vm.code.code_pointer);
             *result = (function_pointer)(context);
+        } else if (current_program->parameters.code_type == EBPF_CODE_EBPF_THREADED) {
+#if !defined(CONFIG_BPF_JIT_ALWAYS_ON)
+            uint64_t out_value;
+            if (ubpf_threaded_exec(current_program->code_or_vm.threaded, context, &out_value) != EBPF_SUCCESS) {
+                *result = (uint32_t)-1;
+            } else {
+                *result = (uint32_t)(out_value);
+            }
+#else
+            *result = 0;
+#endif
         } else {
 #if !defined(CONFIG_BPF_JIT_ALWAYS_ON)
             uint64_t out_value;
@@ -1208,6 +1269,30 @@ Exit:
     EBPF_RETURN_RESULT(result);
 }
 
+_Must_inspect_result_ ebpf_result_t
+ebpf_program_get_block_counts(
+    _In_ const ebpf_program_t* program,
+    _Outptr_result_buffer_maybenull_(*block_count) const uint64_t** block_counts,
+    _Out_ size_t* block_count)
+{
+    EBPF_LOG_ENTRY();
+    ebpf_result_t result;
+
+    *block_counts = NULL;
+    *block_count = 0;
+
+    if (program->parameters.code_type != EBPF_CODE_NATIVE || program->code_or_vm.native.module == NULL) {
+        result = EBPF_OPERATION_NOT_SUPPORTED;
+        goto Exit;
+    }
+
+    result = ebpf_native_get_block_counts(
+        program->code_or_vm.native.module, program->code_or_vm.native.code_pointer, block_counts, block_count);
+
+Exit:
+    EBPF_RETURN_RESULT(result);
+}
+
 _Must_inspect_result_ ebpf_result_t
 ebpf_program_set_helper_function_ids(
     _Inout_ ebpf_program_t* program,
@@ -1382,6 +1467,28 @@ ebpf_program_detach_link(_Inout_ ebpf_program_t* program, _Inout_ ebpf_link_t* l
     EBPF_RETURN_VOID();
 }
 
+void
+ebpf_program_move_link(
+    _Inout_ ebpf_program_t* old_program, _Inout_ ebpf_program_t* new_program, _Inout_ ebpf_link_t* link)
+{
+    EBPF_LOG_ENTRY();
+    ebpf_lock_state_t state;
+    ebpf_list_entry_t* entry = &((ebpf_core_object_t*)link)->object_list_entry;
+
+    // Remove the link from the old program's attach list before inserting it in the new one, as it has a single
+    // list entry. The "attach" reference moves with it.
+    state = ebpf_lock_lock(&old_program->lock);
+    ebpf_list_remove_entry(entry);
+    old_program->link_count--;
+    ebpf_lock_unlock(&old_program->lock, state);
+
+    state = ebpf_lock_lock(&new_program->lock);
+    ebpf_list_insert_tail(&new_program->links, entry);
+    new_program->link_count++;
+    ebpf_lock_unlock(&new_program->lock, state);
+    EBPF_RETURN_VOID();
+}
+
 _Must_inspect_result_ ebpf_result_t
 ebpf_program_get_info(
     _In_ const ebpf_program_t* program,
@@ -210,6 +210,21 @@ extern "C"
         const size_t addresses_count,
         _Out_writes_(addresses_count) uint64_t* addresses);
 
+    /**
+     * @brief Get the basic block counters of a native program generated with bpf2c --instrument.
+     *
+     * @param[in] program Program object to query this on.
+     * @param[out] block_counts Pointer to the counters of the program.
+     * @param[out] block_count Number of counters.
+     * @retval EBPF_SUCCESS The operation was successful.
+     * @retval EBPF_OPERATION_NOT_SUPPORTED The program isn't an instrumented native program.
+     */
+    _Must_inspect_result_ ebpf_result_t
+    ebpf_program_get_block_counts(
+        _In_ const ebpf_program_t* program,
+        _Outptr_result_buffer_maybenull_(*block_count) const uint64_t** block_counts,
+        _Out_ size_t* block_count);
+
     /**
      * @brief Attach a link object to an eBPF program.
      *
@@ -228,6 +243,18 @@ extern "C"
     void
     ebpf_program_detach_link(_Inout_ ebpf_program_t* program, _Inout_ ebpf_link_t* link);
 
+    /**
+     * @brief Move a link object from the eBPF program it is attached to onto
+     * another eBPF program. The link's "attach" reference is kept.
+     *
+     * @param[in, out] old_program Program the link object is attached to.
+     * @param[in, out] new_program Program to attach the link object to.
+     * @param[in, out] link The link object.
+     */
+    void
+    ebpf_program_move_link(
+        _Inout_ ebpf_program_t* old_program, _Inout_ ebpf_program_t* new_program, _Inout_ ebpf_link_t* link);
+
     /**
      * @brief Store the pointer to the program to execute on tail call.
      *
@@ -42,6 +42,18 @@ typedef enum _ebpf_operation_id
     EBPF_OPERATION_LOAD_NATIVE_MODULE,
     EBPF_OPERATION_LOAD_NATIVE_PROGRAMS,
     EBPF_OPERATION_PROGRAM_TEST_RUN,
+    EBPF_OPERATION_UPDATE_LINK,
+    EBPF_OPERATION_GET_EPOCH_STATISTICS,
+    EBPF_OPERATION_SET_EPOCH_BACKLOG_THRESHOLD,
+    EBPF_OPERATION_GET_NEXT_PINNED_PATHS,
+    EBPF_OPERATION_UNPIN_PATH_PREFIX,
+    EBPF_OPERATION_GET_NEXT_LINK_INFO,
+    EBPF_OPERATION_GET_NEXT_MAP_INFO,
+    EBPF_OPERATION_GET_NEXT_PROGRAM_INFO,
+    EBPF_OPERATION_CREATE_MAP_QUEUE,
+    EBPF_OPERATION_SUBMIT_MAP_QUEUE,
+    EBPF_OPERATION_RING_BUFFER_MAP_SET_WAKEUP_THRESHOLDS,
+    EBPF_OPERATION_GET_PROGRAM_BLOCK_COUNTS,
 } ebpf_operation_id_t;
 
 typedef enum _ebpf_code_type
@@ -50,6 +62,7 @@ typedef enum _ebpf_code_type
     EBPF_CODE_JIT,
     EBPF_CODE_EBPF,
     EBPF_CODE_NATIVE,
+    EBPF_CODE_EBPF_THREADED,
 } ebpf_code_type_t;
 
 typedef struct _ebpf_operation_header
@@ -241,6 +254,8 @@ typedef struct _ebpf_operation_link_program_request
     struct _ebpf_operation_header header;
     ebpf_handle_t program_handle;
     ebpf_attach_type_t attach_type;
+    bool multi_attach;
+    ebpf_link_multi_attach_options_t multi_attach_options;
     uint8_t data[1];
 } ebpf_operation_link_program_request_t;
 
@@ -377,6 +392,15 @@ typedef struct _ebpf_operation_ring_buffer_map_async_query_reply
     ebpf_ring_buffer_map_async_query_result_t async_query_result;
 } ebpf_operation_ring_buffer_map_async_query_reply_t;
 
+typedef struct _ebpf_operation_ring_buffer_map_set_wakeup_thresholds_request
+{
+    struct _ebpf_operation_header header;
+    ebpf_handle_t map_handle;
+    uint32_t wakeup_bytes;
+    uint32_t wakeup_records;
+    uint32_t max_wakeup_latency_us;
+} ebpf_operation_ring_buffer_map_set_wakeup_thresholds_request_t;
+
 typedef struct _ebpf_operation_load_native_module_request
 {
     struct _ebpf_operation_header header;
@@ -450,4 +474,153 @@ typedef struct _ebpf_operation_program_test_run_reply
     uint64_t return_value;
     uint64_t context_offset;
     uint8_t data[1];
-} ebpf_operation_program_test_run_reply_t;
\ No newline at end of file
+} ebpf_operation_program_test_run_reply_t;
+
+typedef struct _ebpf_operation_update_link_request
+{
+    struct _ebpf_operation_header header;
+    ebpf_handle_t link_handle;
+    ebpf_handle_t program_handle;
+    // ebpf_handle_invalid if the currently attached program need not be checked.
+    ebpf_handle_t old_program_handle;
+} ebpf_operation_update_link_request_t;
+
+typedef struct _ebpf_operation_get_epoch_statistics_request
+{
+    struct _ebpf_operation_header header;
+} ebpf_operation_get_epoch_statistics_request_t;
+
+typedef struct _ebpf_operation_get_epoch_statistics_reply
+{
+    struct _ebpf_operation_header header;
+    ebpf_epoch_statistics_t statistics;
+    uint32_t cpu_count;
+    ebpf_epoch_cpu_statistics_t cpu_statistics[1];
+} ebpf_operation_get_epoch_statistics_reply_t;
+
+typedef struct _ebpf_operation_set_epoch_backlog_threshold_request
+{
+    struct _ebpf_operation_header header;
+    uint64_t threshold_in_bytes;
+} ebpf_operation_set_epoch_backlog_threshold_request_t;
+
+typedef struct _ebpf_operation_get_next_pinned_paths_request
+{
+    struct _ebpf_operation_header header;
+    uint16_t prefix_length;
+    // Prefix followed by the path to look for entries greater than.
+    uint8_t data[1];
+} ebpf_operation_get_next_pinned_paths_request_t;
+
+typedef struct _ebpf_operation_get_next_pinned_paths_reply
+{
+    struct _ebpf_operation_header header;
+    uint16_t path_count;
+    // Sequence of unaligned uint16_t path lengths, each followed by the path.
+    uint8_t data[1];
+} ebpf_operation_get_next_pinned_paths_reply_t;
+
+typedef struct _ebpf_operation_unpin_path_prefix_request
+{
+    struct _ebpf_operation_header header;
+    uint8_t prefix[1];
+} ebpf_operation_unpin_path_prefix_request_t;
+
+typedef struct _ebpf_operation_unpin_path_prefix_reply
+{
+    struct _ebpf_operation_header header;
+    uint32_t unpinned_count;
+} ebpf_operation_unpin_path_prefix_reply_t;
+
+typedef struct _ebpf_operation_get_next_object_info_request
+{
+    struct _ebpf_operation_header header;
+    ebpf_id_t start_id;
+} ebpf_operation_get_next_object_info_request_t;
+
+typedef struct _ebpf_operation_get_next_object_info_reply
+{
+    struct _ebpf_operation_header header;
+    uint32_t info_count;
+    uint32_t info_size;
+    // Array of bpf_link_info, bpf_map_info or bpf_prog_info records, in increasing order of ID.
+    uint8_t data[1];
+} ebpf_operation_get_next_object_info_reply_t;
+
+// Layout of the memory shared by a map queue: an ebpf_map_queue_header_t, entry_count
+// ebpf_map_queue_submission_t, entry_count ebpf_map_queue_completion_entry_t and entry_count
+// slots of slot_size bytes. Each slot holds the key of the submission at the same index,
+// followed by its value.
+#define EBPF_MAP_QUEUE_MAX_ENTRY_COUNT 4096
+#define EBPF_MAP_QUEUE_MAX_SLOT_SIZE 4096
+#define EBPF_MAP_QUEUE_BUFFER_SIZE(entry_count, slot_size) \
+    (sizeof(ebpf_map_queue_header_t) +                     \
+     (size_t)(entry_count) *                               \
+         (sizeof(ebpf_map_queue_submission_t) + sizeof(ebpf_map_queue_completion_entry_t) + (slot_size)))
+
+typedef struct _ebpf_map_queue_header
+{
+    // Written by the user.
+    volatile uint32_t submission_tail;
+    volatile uint32_t completion_head;
+    uint8_t user_padding[56];
+    // Written by the execution context.
+    volatile uint32_t submission_head;
+    volatile uint32_t completion_tail;
+    uint8_t core_padding[56];
+} ebpf_map_queue_header_t;
+
+typedef struct _ebpf_map_queue_submission
+{
+    uint64_t user_data;
+    ebpf_handle_t map_handle;
+    uint32_t operation; // ebpf_map_queue_operation_t
+    uint32_t option;    // ebpf_map_option_t, for updates.
+} ebpf_map_queue_submission_t;
+
+typedef struct _ebpf_map_queue_completion_entry
+{
+    uint64_t user_data;
+    uint32_t slot;  // Index of the slot that holds the value of a find operation.
+    int32_t result; // ebpf_result_t
+} ebpf_map_queue_completion_entry_t;
+
+typedef struct _ebpf_operation_create_map_queue_request
+{
+    struct _ebpf_operation_header header;
+    uint32_t entry_count;
+    uint32_t slot_size;
+} ebpf_operation_create_map_queue_request_t;
+
+typedef struct _ebpf_operation_create_map_queue_reply
+{
+    struct _ebpf_operation_header header;
+    ebpf_handle_t queue_handle;
+    // Address of the memory shared with the execution context, in the calling process.
+    uint64_t buffer_address;
+} ebpf_operation_create_map_queue_reply_t;
+
+typedef struct _ebpf_operation_submit_map_queue_request
+{
+    struct _ebpf_operation_header header;
+    ebpf_handle_t queue_handle;
+} ebpf_operation_submit_map_queue_request_t;
+
+typedef struct _ebpf_operation_submit_map_queue_reply
+{
+    struct _ebpf_operation_header header;
+    uint32_t completed_count;
+} ebpf_operation_submit_map_queue_reply_t;
+
+typedef struct _ebpf_operation_get_program_block_counts_request
+{
+    struct _ebpf_operation_header header;
+    ebpf_handle_t program_handle;
+} ebpf_operation_get_program_block_counts_request_t;
+
+typedef struct _ebpf_operation_get_program_block_counts_reply
+{
+    struct _ebpf_operation_header header;
+    uint32_t block_count;
+    uint64_t block_counts[1];
+} ebpf_operation_get_program_block_counts_reply_t;
@@ -1,13 +1,17 @@
 // Copyright (c) Microsoft Corporation
 // SPDX-License-Identifier: MIT
 
+#include <atomic>
+#include <chrono>
 #include <set>
+#include <thread>
 
 #include <optional>
 #include "catch_wrapper.hpp"
 #include "ebpf_async.h"
 #include "ebpf_ring_buffer.h"
 #include "ebpf_core.h"
+#include "ebpf_handle.h"
 #include "ebpf_maps.h"
 #include "ebpf_object.h"
 #include "ebpf_program.h"
@@ -756,6 +760,51 @@ TEST_CASE("program", "[execution_context]")
     ebpf_free_trampoline_table(table);
 }
 
+TEST_CASE("program_threaded", "[execution_context]")
+{
+    _ebpf_core_initializer core;
+    program_ptr program;
+    {
+        ebpf_program_t* local_program = nullptr;
+        REQUIRE(ebpf_program_create(&local_program) == EBPF_SUCCESS);
+        program.reset(local_program);
+    }
+
+    const ebpf_utf8_string_t program_name{(uint8_t*)("foo"), 3};
+    const ebpf_utf8_string_t section_name{(uint8_t*)("bar"), 3};
+    program_info_provider_t program_info_provider(EBPF_PROGRAM_TYPE_XDP);
+
+    const ebpf_program_parameters_t program_parameters{
+        EBPF_PROGRAM_TYPE_XDP, EBPF_ATTACH_TYPE_XDP, program_name, section_name};
+    REQUIRE(ebpf_program_initialize(program.get(), &program_parameters) == EBPF_SUCCESS);
+
+    // Instructions with an unsupported opcode must be rejected at load time.
+    std::vector<ebpf_instruction_t> invalid_byte_code = {{0xff}, {0x95}};
+    REQUIRE(
+        ebpf_program_load_code(
+            program.get(),
+            EBPF_CODE_EBPF_THREADED,
+            nullptr,
+            reinterpret_cast<uint8_t*>(invalid_byte_code.data()),
+            invalid_byte_code.size() * sizeof(ebpf_instruction_t)) == EBPF_INVALID_ARGUMENT);
+
+    // r0 = 0; r1 = 64; do { r0 += r1; r1 -= 1; } while (r1 != 0); return r0;
+    std::vector<ebpf_instruction_t> byte_code = {
+        {0xb7, 0, 0, 0, 0}, {0xb7, 1, 0, 0, 64}, {0x0f, 0, 1, 0, 0}, {0x17, 1, 0, 0, 1}, {0x55, 1, 0, -3, 0}, {0x95}};
+    REQUIRE(
+        ebpf_program_load_code(
+            program.get(),
+            EBPF_CODE_EBPF_THREADED,
+            nullptr,
+            reinterpret_cast<uint8_t*>(byte_code.data()),
+            byte_code.size() * sizeof(ebpf_instruction_t)) == EBPF_SUCCESS);
+
+    uint32_t result = 0;
+    xdp_md_t ctx{0};
+    ebpf_program_invoke(program.get(), &ctx, &result);
+    REQUIRE(result == (64 * 65) / 2);
+}
+
 TEST_CASE("name size", "[execution_context]")
 {
     _ebpf_core_initializer core;
@@ -845,7 +894,8 @@ TEST_CASE("ring_buffer_async_query", "[execution_context]")
     REQUIRE(result == EBPF_PENDING);
 
     uint64_t value = 1;
-    REQUIRE(ebpf_ring_buffer_map_output(map.get(), reinterpret_cast<uint8_t*>(&value), sizeof(value)) == EBPF_SUCCESS);
+    REQUIRE(
+        ebpf_ring_buffer_map_output(map.get(), reinterpret_cast<uint8_t*>(&value), sizeof(value), 0) == EBPF_SUCCESS);
 
     REQUIRE(completion.value == value);
 
@@ -883,6 +933,99 @@ TEST_CASE("ring_buffer_async_query", "[execution_context]")
     }
 }
 
+TEST_CASE("ring_buffer_wakeup_thresholds", "[execution_context]")
+{
+    _ebpf_core_initializer core;
+    ebpf_map_definition_in_memory_t map_definition{BPF_MAP_TYPE_RINGBUF, 0, 0, 64 * 1024};
+    map_ptr map;
+    {
+        ebpf_map_t* local_map;
+        ebpf_utf8_string_t map_name = {0};
+        REQUIRE(
+            ebpf_map_create(&map_name, &map_definition, (uintptr_t)ebpf_handle_invalid, &local_map) == EBPF_SUCCESS);
+        map.reset(local_map);
+    }
+
+    struct _completion
+    {
+        ebpf_ring_buffer_map_async_query_result_t async_query_result = {};
+        std::atomic<uint32_t> count = 0;
+    } completion;
+
+    // Return the data reported by the last completion and queue up the next query.
+    auto arm = [&]() {
+        REQUIRE(ebpf_ring_buffer_map_return_buffer(map.get(), completion.async_query_result.producer) == EBPF_SUCCESS);
+        REQUIRE(
+            ebpf_async_set_completion_callback(
+                &completion, [](_Inout_ void* context, size_t output_buffer_length, ebpf_result_t result) {
+                    UNREFERENCED_PARAMETER(output_buffer_length);
+                    REQUIRE(result == EBPF_SUCCESS);
+                    reinterpret_cast<_completion*>(context)->count++;
+                }) == EBPF_SUCCESS);
+        ebpf_result_t result = ebpf_ring_buffer_map_async_query(map.get(), &completion.async_query_result, &completion);
+        if (result != EBPF_PENDING) {
+            REQUIRE(ebpf_async_reset_completion_callback(&completion) == EBPF_SUCCESS);
+        }
+        REQUIRE(result == EBPF_PENDING);
+    };
+    uint64_t value = 1;
+    auto output = [&](uint64_t flags) {
+        REQUIRE(
+            ebpf_ring_buffer_map_output(map.get(), reinterpret_cast<uint8_t*>(&value), sizeof(value), flags) ==
+            EBPF_SUCCESS);
+    };
+
+    // The query completes once the record threshold is reached.
+    REQUIRE(ebpf_ring_buffer_map_set_wakeup_thresholds(map.get(), 0, 3, 0) == EBPF_SUCCESS);
+    arm();
+    output(0);
+    output(0);
+    REQUIRE(completion.count == 0);
+    output(0);
+    REQUIRE(completion.count == 1);
+
+    // BPF_RB_FORCE_WAKEUP ignores the thresholds.
+    arm();
+    output(BPF_RB_FORCE_WAKEUP);
+    REQUIRE(completion.count == 2);
+
+    // BPF_RB_NO_WAKEUP records count towards the threshold, but never complete the query themselves.
+    arm();
+    output(BPF_RB_NO_WAKEUP);
+    output(BPF_RB_NO_WAKEUP);
+    output(BPF_RB_NO_WAKEUP);
+    REQUIRE(completion.count == 2);
+    output(0);
+    REQUIRE(completion.count == 3);
+
+    // The byte threshold includes the record headers; this one is reached by the second record.
+    uint32_t wakeup_bytes =
+        static_cast<uint32_t>(EBPF_OFFSET_OF(ebpf_ring_buffer_record_t, data) + sizeof(value) + 1);
+    REQUIRE(ebpf_ring_buffer_map_set_wakeup_thresholds(map.get(), wakeup_bytes, 0, 0) == EBPF_SUCCESS);
+    arm();
+    output(0);
+    REQUIRE(completion.count == 3);
+    output(0);
+    REQUIRE(completion.count == 4);
+
+    // Clearing the thresholds completes a query that has data pending.
+    REQUIRE(ebpf_ring_buffer_map_set_wakeup_thresholds(map.get(), 0, 100, 0) == EBPF_SUCCESS);
+    arm();
+    output(0);
+    REQUIRE(completion.count == 4);
+    REQUIRE(ebpf_ring_buffer_map_set_wakeup_thresholds(map.get(), 0, 0, 0) == EBPF_SUCCESS);
+    REQUIRE(completion.count == 5);
+
+    // Data below the thresholds is reported once the maximum latency expires.
+    REQUIRE(ebpf_ring_buffer_map_set_wakeup_thresholds(map.get(), 0, 100, 1000) == EBPF_SUCCESS);
+    arm();
+    output(0);
+    for (int i = 0; i < 1000 && completion.count == 5; i++) {
+        std::this_thread::sleep_for(std::chrono::milliseconds(1));
+    }
+    REQUIRE(completion.count == 6);
+}
+
 std::vector<GUID> _program_types = {
     EBPF_PROGRAM_TYPE_XDP,
     EBPF_PROGRAM_TYPE_BIND,
@@ -1553,6 +1696,22 @@ TEST_CASE("EBPF_OPERATION_LINK_PROGRAM", "[execution_context][negative]")
     REQUIRE(invoke_protocol(EBPF_OPERATION_LINK_PROGRAM, request, reply) == EBPF_EXTENSION_FAILED_TO_LOAD);
 }
 
+TEST_CASE("EBPF_OPERATION_UPDATE_LINK", "[execution_context][negative]")
+{
+    NEGATIVE_TEST_PROLOG();
+    ebpf_operation_update_link_request_t request;
+
+    // Wrong handle type.
+    request.link_handle = program_handles[0];
+    request.program_handle = program_handles[0];
+    request.old_program_handle = ebpf_handle_invalid;
+    REQUIRE(invoke_protocol(EBPF_OPERATION_UPDATE_LINK, request) == EBPF_INVALID_OBJECT);
+
+    // Invalid handle.
+    request.link_handle = ebpf_handle_invalid - 1;
+    REQUIRE(invoke_protocol(EBPF_OPERATION_UPDATE_LINK, request) == EBPF_INVALID_OBJECT);
+}
+
 TEST_CASE("EBPF_OPERATION_GET_EC_FUNCTION", "[execution_context][negative]")
 {
     NEGATIVE_TEST_PROLOG();
@@ -1594,6 +1753,212 @@ TEST_CASE("EBPF_OPERATION_GET_PINNED_MAP_INFO", "[execution_context][negative]")
     REQUIRE(invoke_protocol(EBPF_OPERATION_GET_PINNED_MAP_INFO, request, reply) == EBPF_SUCCESS);
 }
 
+TEST_CASE("EBPF_OPERATION_GET_EPOCH_STATISTICS", "[execution_context][negative]")
+{
+    _ebpf_core_initializer core;
+    ebpf_operation_get_epoch_statistics_request_t request;
+    std::vector<uint8_t> reply(EBPF_OFFSET_OF(ebpf_operation_get_epoch_statistics_reply_t, cpu_statistics));
+    auto epoch_statistics_reply = reinterpret_cast<ebpf_operation_get_epoch_statistics_reply_t*>(reply.data());
+
+    // Reply too small for the per-CPU statistics.
+    REQUIRE(invoke_protocol(EBPF_OPERATION_GET_EPOCH_STATISTICS, request, reply) == EBPF_INSUFFICIENT_BUFFER);
+    uint32_t cpu_count = epoch_statistics_reply->cpu_count;
+    REQUIRE(cpu_count == ebpf_get_cpu_count());
+
+    reply.resize(reply.size() + cpu_count * sizeof(ebpf_epoch_cpu_statistics_t));
+    epoch_statistics_reply = reinterpret_cast<ebpf_operation_get_epoch_statistics_reply_t*>(reply.data());
+    REQUIRE(invoke_protocol(EBPF_OPERATION_GET_EPOCH_STATISTICS, request, reply) == EBPF_SUCCESS);
+    REQUIRE(epoch_statistics_reply->cpu_count == cpu_count);
+
+    ebpf_operation_set_epoch_backlog_threshold_request_t threshold_request;
+    threshold_request.threshold_in_bytes = 4096;
+    REQUIRE(invoke_protocol(EBPF_OPERATION_SET_EPOCH_BACKLOG_THRESHOLD, threshold_request) == EBPF_SUCCESS);
+    REQUIRE(invoke_protocol(EBPF_OPERATION_GET_EPOCH_STATISTICS, request, reply) == EBPF_SUCCESS);
+    REQUIRE(epoch_statistics_reply->statistics.backlog_threshold_in_bytes == 4096);
+}
+
+TEST_CASE("EBPF_OPERATION_GET_NEXT_PINNED_PATHS", "[execution_context][negative]")
+{
+    NEGATIVE_TEST_PROLOG();
+    ebpf_handle_t map_handle = map_handles.begin()->second;
+    for (const char* path : {"/a/x", "/a/y", "/ab", "/b/z"}) {
+        ebpf_utf8_string_t utf8_path = {(uint8_t*)path, strlen(path)};
+        REQUIRE(ebpf_core_update_pinning(map_handle, &utf8_path) == EBPF_SUCCESS);
+    }
+
+    std::string prefix = "/a/";
+    std::vector<uint8_t> request(EBPF_OFFSET_OF(ebpf_operation_get_next_pinned_paths_request_t, data) + prefix.size());
+    auto get_next_pinned_paths_request =
+        reinterpret_cast<ebpf_operation_get_next_pinned_paths_request_t*>(request.data());
+    get_next_pinned_paths_request->prefix_length = static_cast<uint16_t>(prefix.size());
+    memcpy(get_next_pinned_paths_request->data, prefix.data(), prefix.size());
+
+    // Reply too small for any path.
+    std::vector<uint8_t> reply(EBPF_OFFSET_OF(ebpf_operation_get_next_pinned_paths_reply_t, data));
+    REQUIRE(invoke_protocol(EBPF_OPERATION_GET_NEXT_PINNED_PATHS, request, reply) == EBPF_INSUFFICIENT_BUFFER);
+
+    // Reply that fits a single path returns the first one.
+    reply.resize(reply.size() + sizeof(uint16_t) + 4);
+    auto get_next_pinned_paths_reply = reinterpret_cast<ebpf_operation_get_next_pinned_paths_reply_t*>(reply.data());
+    REQUIRE(invoke_protocol(EBPF_OPERATION_GET_NEXT_PINNED_PATHS, request, reply) == EBPF_SUCCESS);
+    REQUIRE(get_next_pinned_paths_reply->path_count == 1);
+    REQUIRE(memcmp(get_next_pinned_paths_reply->data + sizeof(uint16_t), "/a/x", 4) == 0);
+
+    // Resume after the first path.
+    request.resize(request.size() + 4);
+    get_next_pinned_paths_request = reinterpret_cast<ebpf_operation_get_next_pinned_paths_request_t*>(request.data());
+    memcpy(get_next_pinned_paths_request->data + prefix.size(), "/a/x", 4);
+    REQUIRE(invoke_protocol(EBPF_OPERATION_GET_NEXT_PINNED_PATHS, request, reply) == EBPF_SUCCESS);
+    REQUIRE(get_next_pinned_paths_reply->path_count == 1);
+    REQUIRE(memcmp(get_next_pinned_paths_reply->data + sizeof(uint16_t), "/a/y", 4) == 0);
+
+    memcpy(get_next_pinned_paths_request->data + prefix.size(), "/a/y", 4);
+    REQUIRE(invoke_protocol(EBPF_OPERATION_GET_NEXT_PINNED_PATHS, request, reply) == EBPF_NO_MORE_KEYS);
+
+    // Prefix longer than the request.
+    get_next_pinned_paths_request->prefix_length = static_cast<uint16_t>(request.size());
+    REQUIRE(invoke_protocol(EBPF_OPERATION_GET_NEXT_PINNED_PATHS, request, reply) == EBPF_INVALID_ARGUMENT);
+
+    // Unpin the directory.
+    std::vector<uint8_t> unpin_request(EBPF_OFFSET_OF(ebpf_operation_unpin_path_prefix_request_t, prefix));
+    ebpf_operation_unpin_path_prefix_reply_t unpin_reply;
+    REQUIRE(invoke_protocol(EBPF_OPERATION_UNPIN_PATH_PREFIX, unpin_request, unpin_reply) == EBPF_INVALID_ARGUMENT);
+
+    unpin_request.resize(unpin_request.size() + prefix.size());
+    memcpy(
+        reinterpret_cast<ebpf_operation_unpin_path_prefix_request_t*>(unpin_request.data())->prefix,
+        prefix.data(),
+        prefix.size());
+    REQUIRE(invoke_protocol(EBPF_OPERATION_UNPIN_PATH_PREFIX, unpin_request, unpin_reply) == EBPF_SUCCESS);
+    REQUIRE(unpin_reply.unpinned_count == 2);
+
+    request.resize(EBPF_OFFSET_OF(ebpf_operation_get_next_pinned_paths_request_t, data) + prefix.size());
+    get_next_pinned_paths_request = reinterpret_cast<ebpf_operation_get_next_pinned_paths_request_t*>(request.data());
+    get_next_pinned_paths_request->prefix_length = static_cast<uint16_t>(prefix.size());
+    REQUIRE(invoke_protocol(EBPF_OPERATION_GET_NEXT_PINNED_PATHS, request, reply) == EBPF_NO_MORE_KEYS);
+}
+
+TEST_CASE("EBPF_OPERATION_GET_NEXT_MAP_INFO", "[execution_context][negative]")
+{
+    NEGATIVE_TEST_PROLOG();
+    ebpf_operation_get_next_object_info_request_t request;
+    std::vector<uint8_t> reply(EBPF_OFFSET_OF(ebpf_operation_get_next_object_info_reply_t, data));
+
+    // Reply too small for a single record.
+    request.start_id = 0;
+    REQUIRE(invoke_protocol(EBPF_OPERATION_GET_NEXT_MAP_INFO, request, reply) == EBPF_INSUFFICIENT_BUFFER);
+
+    // Enumerate all the maps in one call.
+    reply.resize(reply.size() + (map_handles.size() + 64) * sizeof(bpf_map_info));
+    auto get_next_map_info_reply = reinterpret_cast<ebpf_operation_get_next_object_info_reply_t*>(reply.data());
+    REQUIRE(invoke_protocol(EBPF_OPERATION_GET_NEXT_MAP_INFO, request, reply) == EBPF_SUCCESS);
+    REQUIRE(get_next_map_info_reply->info_count >= map_handles.size());
+    REQUIRE(get_next_map_info_reply->info_size == sizeof(bpf_map_info));
+
+    uint32_t info_count = get_next_map_info_reply->info_count;
+    auto infos = reinterpret_cast<bpf_map_info*>(get_next_map_info_reply->data);
+    for (uint32_t index = 1; index < info_count; index++) {
+        REQUIRE(infos[index - 1].id < infos[index].id);
+    }
+
+    // Resume after the last map.
+    request.start_id = infos[info_count - 1].id;
+    REQUIRE(invoke_protocol(EBPF_OPERATION_GET_NEXT_MAP_INFO, request, reply) == EBPF_NO_MORE_KEYS);
+
+    // Programs are enumerated separately.
+    request.start_id = 0;
+    reply.resize(EBPF_OFFSET_OF(ebpf_operation_get_next_object_info_reply_t, data) + sizeof(bpf_prog_info));
+    get_next_map_info_reply = reinterpret_cast<ebpf_operation_get_next_object_info_reply_t*>(reply.data());
+    REQUIRE(invoke_protocol(EBPF_OPERATION_GET_NEXT_PROGRAM_INFO, request, reply) == EBPF_SUCCESS);
+    REQUIRE(get_next_map_info_reply->info_count == 1);
+    REQUIRE(get_next_map_info_reply->info_size == sizeof(bpf_prog_info));
+}
+
+TEST_CASE("EBPF_OPERATION_SUBMIT_MAP_QUEUE", "[execution_context][negative]")
+{
+    NEGATIVE_TEST_PROLOG();
+    const uint32_t entry_count = 4;
+    const uint32_t slot_size = 32;
+    ebpf_handle_t map_handle = map_handles["BPF_MAP_TYPE_HASH"];
+
+    ebpf_operation_create_map_queue_request_t create_request;
+    ebpf_operation_create_map_queue_reply_t create_reply;
+    create_request.slot_size = slot_size;
+
+    // Entry count must be a power of two.
+    create_request.entry_count = entry_count - 1;
+    REQUIRE(invoke_protocol(EBPF_OPERATION_CREATE_MAP_QUEUE, create_request, create_reply) == EBPF_INVALID_ARGUMENT);
+
+    // The memory used by all map queues is capped.
+    create_request.entry_count = EBPF_MAP_QUEUE_MAX_ENTRY_COUNT;
+    create_request.slot_size = EBPF_MAP_QUEUE_MAX_SLOT_SIZE;
+    std::vector<ebpf_handle_t> large_queue_handles;
+    ebpf_result_t result;
+    while ((result = invoke_protocol(EBPF_OPERATION_CREATE_MAP_QUEUE, create_request, create_reply)) == EBPF_SUCCESS) {
+        large_queue_handles.push_back(create_reply.queue_handle);
+        REQUIRE(large_queue_handles.size() < 16);
+    }
+    REQUIRE(result == EBPF_NO_MEMORY);
+    for (ebpf_handle_t handle : large_queue_handles) {
+        REQUIRE(ebpf_handle_close(handle) == EBPF_SUCCESS);
+    }
+
+    create_request.entry_count = entry_count;
+    create_request.slot_size = slot_size;
+    REQUIRE(invoke_protocol(EBPF_OPERATION_CREATE_MAP_QUEUE, create_request, create_reply) == EBPF_SUCCESS);
+    auto header = reinterpret_cast<ebpf_map_queue_header_t*>(create_reply.buffer_address);
+    auto submissions = reinterpret_cast<ebpf_map_queue_submission_t*>(header + 1);
+    auto completions = reinterpret_cast<ebpf_map_queue_completion_entry_t*>(submissions + entry_count);
+    auto slots = reinterpret_cast<uint8_t*>(completions + entry_count);
+
+    ebpf_operation_submit_map_queue_request_t submit_request;
+    ebpf_operation_submit_map_queue_reply_t submit_reply;
+    submit_request.queue_handle = map_handle;
+    REQUIRE(invoke_protocol(EBPF_OPERATION_SUBMIT_MAP_QUEUE, submit_request, submit_reply) == EBPF_INVALID_OBJECT);
+    submit_request.queue_handle = create_reply.queue_handle;
+
+    auto post = [&](ebpf_map_queue_operation_t operation, uint32_t key, uint8_t value) {
+        uint32_t index = header->submission_tail % entry_count;
+        uint8_t* slot = slots + index * slot_size;
+        memcpy(slot, &key, sizeof(key));
+        memset(slot + sizeof(key), value, 20);
+        submissions[index] = {header->submission_tail, map_handle, static_cast<uint32_t>(operation), EBPF_ANY};
+        header->submission_tail = header->submission_tail + 1;
+    };
+
+    post(EBPF_MAP_QUEUE_OPERATION_UPDATE, 1, 0x11);
+    post(EBPF_MAP_QUEUE_OPERATION_UPDATE, 2, 0x22);
+    post(EBPF_MAP_QUEUE_OPERATION_FIND, 1, 0);
+    post(EBPF_MAP_QUEUE_OPERATION_DELETE, 2, 0);
+    REQUIRE(invoke_protocol(EBPF_OPERATION_SUBMIT_MAP_QUEUE, submit_request, submit_reply) == EBPF_SUCCESS);
+    REQUIRE(submit_reply.completed_count == entry_count);
+    REQUIRE(header->submission_head == entry_count);
+    REQUIRE(header->completion_tail == entry_count);
+    for (uint32_t index = 0; index < entry_count; index++) {
+        REQUIRE(completions[index].user_data == index);
+        REQUIRE(completions[index].result == EBPF_SUCCESS);
+    }
+    std::vector<uint8_t> expected_value(20, 0x11);
+    uint8_t* find_value = slots + completions[2].slot * slot_size + sizeof(uint32_t);
+    REQUIRE(memcmp(find_value, expected_value.data(), expected_value.size()) == 0);
+
+    // Nothing is executed while the completion queue is full.
+    post(EBPF_MAP_QUEUE_OPERATION_FIND, 2, 0);
+    REQUIRE(invoke_protocol(EBPF_OPERATION_SUBMIT_MAP_QUEUE, submit_request, submit_reply) == EBPF_SUCCESS);
+    REQUIRE(submit_reply.completed_count == 0);
+
+    // A failed operation is reported in its completion.
+    header->completion_head = entry_count;
+    REQUIRE(invoke_protocol(EBPF_OPERATION_SUBMIT_MAP_QUEUE, submit_request, submit_reply) == EBPF_SUCCESS);
+    REQUIRE(submit_reply.completed_count == 1);
+    REQUIRE(completions[0].user_data == entry_count);
+    REQUIRE(completions[0].result != EBPF_SUCCESS);
+
+    // The submission tail can't be more than a queue ahead of the head.
+    header->submission_tail = header->submission_tail + entry_count + 1;
+    REQUIRE(invoke_protocol(EBPF_OPERATION_SUBMIT_MAP_QUEUE, submit_request, submit_reply) == EBPF_INVALID_ARGUMENT);
+}
+
 TEST_CASE("EBPF_OPERATION_GET_OBJECT_INFO", "[execution_context][negative]")
 {
     NEGATIVE_TEST_PROLOG();
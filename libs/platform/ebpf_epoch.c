@@ -9,17 +9,24 @@
 //
 // Each block of code that accesses epoch freed memory wraps access in calls to ebpf_epoch_enter/ebpf_epoch_exit.
 //
-// The per-CPU state is protected by a single per-CPU lock.
+// Entering and exiting an epoch does not acquire any lock. An active caller publishes the epoch it observed in an
+// epoch slot, where 0 means inactive. ebpf_flush reads the slots without a lock.
+// The per-CPU lock protects the free list, the thread table and the timer state, i.e. only the reclamation path.
 //
 // ebpf_epoch_enter:
-// If preemptible, the thread is affinitized to the current CPU (to prevent it from moving between CPUs).
-// Either the per-CPU or per-thread ebpf_epoch_state_t is located.
-// The ebpf_epoch_state_t is marked as active and the current epoch is recorded and last_used_time is set to now.
+// If not preemptible, the current epoch is stored in the per-CPU slot, followed by a memory barrier.
+// If preemptible, the thread is affinitized to the current CPU (to prevent it from moving between CPUs) and claims a
+// free per-CPU thread slot with an interlocked compare exchange, then publishes the current epoch in it.
+// If all thread slots are in use, the thread falls back to a per-thread ebpf_epoch_state_t in the per-CPU thread
+// table, which is protected by the per-CPU lock.
+//
+// The memory barrier after publishing the epoch orders the slot store before any load of epoch protected memory. If
+// ebpf_flush reads the slot before the store becomes visible, then the caller is guaranteed to observe every unlink
+// that happened before ebpf_flush captured _ebpf_current_epoch, so the memory ebpf_flush releases is unreachable.
 //
 // ebpf_epoch_exit:
 // First:
-// Either the per-CPU or per-thread ebpf_epoch_state_t is located.
-// The ebpf_epoch_state_t is marked as inactive and the current epoch is recorded and last_used_time is set to now.
+// The slot (or the per-thread ebpf_epoch_state_t) is cleared with a release store, and any thread slot is released.
 // If preemptible, the thread is affinity is restored.
 //
 // Second:
@@ -40,10 +47,27 @@
 // Stale flag:
 // The stale flag is set if the timer runs and the ebpf_epoch_cpu_entry_t has entries in its free list.
 // If the stale flag is already set, then the per-CPU stale_worker is scheduled.
+//
+// Slab cache:
+// Allocations whose size (including the header) fits in one of the power of two size classes are rounded up to that
+// size class. When such a block's epoch is released, it is pushed onto the magazine for its size class on the CPU
+// that released it, instead of being returned to the pool. ebpf_epoch_allocate pops from the current CPU's magazine
+// before falling back to the pool. Each magazine is bounded to EBPF_EPOCH_SLAB_MAGAZINE_SIZE_IN_BYTES.
+//
+// Backlog:
+// Each CPU counts the blocks, bytes and work items in its free list. If the pending bytes on a CPU exceed
+// _ebpf_epoch_backlog_threshold_in_bytes, then ebpf_epoch_free arms the _ebpf_flush_timer and the timer is armed with
+// EBPF_EPOCH_FLUSH_DELAY_UNDER_BACKLOG_IN_MICROSECONDS instead of EBPF_EPOCH_FLUSH_DELAY_IN_MICROSECONDS.
 
 // Delay after the _ebpf_flush_timer is set before it runs.
 #define EBPF_EPOCH_FLUSH_DELAY_IN_MICROSECONDS 1000
 
+// Delay after the _ebpf_flush_timer is set before it runs, if a CPU has a backlog of pending bytes.
+#define EBPF_EPOCH_FLUSH_DELAY_UNDER_BACKLOG_IN_MICROSECONDS 100
+
+// Default number of pending bytes on a CPU above which the flush delay is shortened.
+#define EBPF_EPOCH_DEFAULT_BACKLOG_THRESHOLD_IN_BYTES (1024 * 1024)
+
 // Time before logging that a thread entry is stale
 #define EBPF_EPOCH_STALE_THREAD_TIME_IN_NANO_SECONDS 10000000000 // 10 seconds
 
@@ -52,25 +76,43 @@
 
 #define EBPF_NANO_SECONDS_PER_FILETIME_TICK 100
 
+// Number of lock-free slots available to preemptible threads on each CPU.
+#define EBPF_EPOCH_THREAD_SLOT_COUNT 16
+
+// Size of the smallest slab size class, including the allocation header.
+#define EBPF_EPOCH_SLAB_MIN_BLOCK_SIZE 64
+
+// Number of slab size classes. Size classes are powers of two starting at EBPF_EPOCH_SLAB_MIN_BLOCK_SIZE.
+#define EBPF_EPOCH_SLAB_SIZE_CLASS_COUNT 6
+
+// Size of the blocks in a slab size class.
+#define EBPF_EPOCH_SLAB_BLOCK_SIZE(size_class) ((size_t)EBPF_EPOCH_SLAB_MIN_BLOCK_SIZE << (size_class))
+
+// Maximum number of bytes cached in each per-CPU magazine.
+#define EBPF_EPOCH_SLAB_MAGAZINE_SIZE_IN_BYTES (16 * 1024)
+
 typedef struct _ebpf_epoch_state
 {
-    int64_t epoch;           // The highest epoch seen by this epoch state.
-    bool active : 1;         // Currently within an entry/exit block.
-    bool timer_armed : 1;    // This state has requested the global timer.
-    bool stale : 1;          // This state has entries that haven't been freed.
-    bool timer_disabled : 1; // Prevent re-arming the timer during shutdown.
+    int64_t epoch;   // The highest epoch seen by this epoch state.
+    bool active : 1; // Currently within an entry/exit block.
 } ebpf_epoch_state_t;
 
 // Table to track per CPU state.
 // This table must fit into a multiple of EBPF_CACHE_LINE_SIZE.
 typedef struct _ebpf_epoch_cpu_entry
 {
+    volatile int64_t active_epoch; // Epoch published by the non-preemptible caller on this CPU, 0 if inactive.
+    volatile bool stale;           // The free list has entries that haven't been freed.
     ebpf_lock_t lock;
-    _Requires_lock_held_(lock) ebpf_epoch_state_t epoch_state;                 // Per-CPU epoch state.
+    _Requires_lock_held_(lock) bool timer_armed;                               // Requested the global timer.
+    _Requires_lock_held_(lock) bool timer_disabled;                            // Prevent re-arming the timer.
     _Requires_lock_held_(lock) ebpf_list_entry_t free_list;                    // Per-CPU free list.
-    _Requires_lock_held_(lock) ebpf_hash_table_t* thread_table;                // Per-CPU thread table.
+    _Requires_lock_held_(lock) ebpf_hash_table_t* thread_table;                // Per-CPU overflow thread table.
     _Requires_lock_held_(lock) ebpf_non_preemptible_work_item_t* stale_worker; // Per-CPU stale worker DPC.
-    uint32_t padding; // Pad to multiple of EBPF_CACHE_LINE_SIZE.
+    _Requires_lock_held_(lock) uint64_t pending_blocks;                        // Memory blocks in the free list.
+    _Requires_lock_held_(lock) uint64_t pending_bytes;                         // Size of the memory blocks.
+    _Requires_lock_held_(lock) uint64_t pending_work_items;                    // Work items in the free list.
+    uint8_t padding[40];
 } ebpf_epoch_cpu_entry_t;
 
 typedef struct _ebpf_epoch_thread_entry
@@ -80,11 +122,45 @@ typedef struct _ebpf_epoch_thread_entry
     uint64_t last_used_time;            // Time when this entry was last used.
 } ebpf_epoch_thread_entry_t;
 
+// Lock-free epoch slot for a preemptible thread. A slot is owned by at most one thread between
+// ebpf_epoch_enter and ebpf_epoch_exit.
+typedef struct _ebpf_epoch_thread_slot
+{
+    void* volatile thread_id;           // Owning thread, or NULL if the slot is free.
+    volatile int64_t epoch;             // Epoch published by the owning thread, 0 if inactive.
+    uintptr_t old_thread_affinity_mask; // Thread affinity mask before entering an entry/exit block.
+    uint64_t enter_time;                // Time when the owning thread entered the epoch.
+} ebpf_epoch_thread_slot_t;
+
 C_ASSERT(sizeof(ebpf_epoch_cpu_entry_t) % EBPF_CACHE_LINE_SIZE == 0); // Verify alignment.
+C_ASSERT((sizeof(ebpf_epoch_thread_slot_t) * EBPF_EPOCH_THREAD_SLOT_COUNT) % EBPF_CACHE_LINE_SIZE == 0);
+
+// Per-CPU cache of free blocks of a single size class.
+typedef struct _ebpf_epoch_slab_magazine
+{
+    ebpf_lock_t lock;
+    _Requires_lock_held_(lock) ebpf_list_entry_t blocks; // Free blocks, most recently freed last.
+    _Requires_lock_held_(lock) uint32_t block_count;     // Number of blocks in the magazine.
+    uint32_t padding;
+} ebpf_epoch_slab_magazine_t;
+
+// Per-CPU set of magazines, one per size class.
+// This table must fit into a multiple of EBPF_CACHE_LINE_SIZE.
+typedef struct _ebpf_epoch_slab_cpu_entry
+{
+    ebpf_epoch_slab_magazine_t magazines[EBPF_EPOCH_SLAB_SIZE_CLASS_COUNT];
+} ebpf_epoch_slab_cpu_entry_t;
+
+C_ASSERT(sizeof(ebpf_epoch_slab_cpu_entry_t) % EBPF_CACHE_LINE_SIZE == 0); // Verify alignment.
 
 static _Writable_elements_(_ebpf_epoch_cpu_count) ebpf_epoch_cpu_entry_t* _ebpf_epoch_cpu_table = NULL;
 static uint32_t _ebpf_epoch_cpu_count = 0;
 
+// Per-CPU arrays of EBPF_EPOCH_THREAD_SLOT_COUNT thread slots.
+static ebpf_epoch_thread_slot_t* _ebpf_epoch_thread_slot_table = NULL;
+
+static _Writable_elements_(_ebpf_epoch_cpu_count) ebpf_epoch_slab_cpu_entry_t* _ebpf_epoch_slab_table = NULL;
+
 /**
  * @brief _ebpf_current_epoch indicates the newest active epoch. All memory free
  * operations were performed prior to this value.
@@ -107,6 +183,18 @@ static volatile bool _ebpf_epoch_rundown = false;
  */
 static ebpf_timer_work_item_t* _ebpf_flush_timer = NULL;
 
+/**
+ * @brief Pending bytes on a CPU above which the _ebpf_flush_timer is armed with the shorter backlog delay.
+ * 0 disables the backlog delay.
+ */
+static volatile int64_t _ebpf_epoch_backlog_threshold_in_bytes = EBPF_EPOCH_DEFAULT_BACKLOG_THRESHOLD_IN_BYTES;
+
+// Reclamation event counters, reported by ebpf_epoch_query_statistics.
+static volatile int64_t _ebpf_epoch_flush_timer_fires = 0;
+static volatile int64_t _ebpf_epoch_stale_worker_runs = 0;
+static volatile int64_t _ebpf_epoch_stale_thread_detections = 0;
+static volatile int64_t _ebpf_epoch_accelerated_flushes = 0;
+
 // There are two possible actions that can be taken at the end of an epoch.
 // 1. Return a block of memory to the memory pool.
 // 2. Invoke a work item, which is used to free custom allocations.
@@ -121,6 +209,7 @@ typedef struct _ebpf_epoch_allocation_header
     ebpf_list_entry_t list_entry;
     int64_t freed_epoch;
     ebpf_epoch_allocation_type_t entry_type;
+    uint32_t size; // Size of the block, including the header, saturated to UINT32_MAX. 0 for work items.
 } ebpf_epoch_allocation_header_t;
 
 /**
@@ -131,6 +220,7 @@ typedef struct _ebpf_epoch_allocation_header
 typedef struct _ebpf_epoch_work_item
 {
     ebpf_epoch_allocation_header_t header;
+    uint32_t cpu_id; // CPU whose free list and pending_work_items the work item was last scheduled on.
     void* callback_context;
     const void (*callback)(_Inout_ void* context);
 } ebpf_epoch_work_item_t;
@@ -195,6 +285,124 @@ static _Requires_lock_held_(_ebpf_epoch_cpu_table[cpu_id].lock) ebpf_epoch_threa
  */
 static _Requires_lock_held_(cpu_entry->lock) void _ebpf_epoch_arm_timer_if_needed(ebpf_epoch_cpu_entry_t* cpu_entry);
 
+/**
+ * @brief Publish the current epoch in an epoch slot and order the store before any subsequent load.
+ *
+ * @param[in, out] epoch_slot Slot to publish the epoch in.
+ */
+static inline void
+_ebpf_epoch_publish(_Inout_ volatile int64_t* epoch_slot)
+{
+    *epoch_slot = _ebpf_current_epoch;
+    MemoryBarrier();
+}
+
+/**
+ * @brief Clear an epoch slot, ordering all prior loads of epoch protected memory before the store.
+ *
+ * @param[in, out] epoch_slot Slot to clear.
+ */
+static inline void
+_ebpf_epoch_retire(_Inout_ volatile int64_t* epoch_slot)
+{
+    WriteRelease64((volatile LONG64*)epoch_slot, 0);
+}
+
+/**
+ * @brief Check if the free list of a CPU is empty without acquiring the lock. The result is only a hint, callers must
+ * acquire the lock before acting on the free list.
+ *
+ * @param[in] cpu_entry The CPU entry to check.
+ * @retval true Free list appears to be empty.
+ * @retval false Free list appears to be non-empty.
+ */
+static inline bool
+_ebpf_epoch_is_free_list_empty_no_lock(_In_ const ebpf_epoch_cpu_entry_t* cpu_entry)
+{
+    return *(ebpf_list_entry_t* volatile*)&cpu_entry->free_list.Flink == &cpu_entry->free_list;
+}
+
+/**
+ * @brief Check if the pending bytes on a CPU exceed the backlog threshold.
+ *
+ * @param[in] cpu_entry The CPU entry to check.
+ * @retval true The CPU has a backlog.
+ * @retval false The CPU doesn't have a backlog or the backlog threshold is disabled.
+ */
+static inline _Requires_lock_held_(cpu_entry->lock) bool _ebpf_epoch_is_backlogged(
+    _In_ const ebpf_epoch_cpu_entry_t* cpu_entry)
+{
+    uint64_t threshold = (uint64_t)_ebpf_epoch_backlog_threshold_in_bytes;
+    return threshold != 0 && cpu_entry->pending_bytes > threshold;
+}
+
+/**
+ * @brief Find the smallest slab size class that fits an allocation.
+ *
+ * @param[in] size Size of the allocation, including the allocation header.
+ * @return The size class, or EBPF_EPOCH_SLAB_SIZE_CLASS_COUNT if the allocation is too large for any size class.
+ */
+static inline uint32_t
+_ebpf_epoch_slab_get_size_class(size_t size)
+{
+    uint32_t size_class = 0;
+    while (size_class < EBPF_EPOCH_SLAB_SIZE_CLASS_COUNT && EBPF_EPOCH_SLAB_BLOCK_SIZE(size_class) < size) {
+        size_class++;
+    }
+    return size_class;
+}
+
+/**
+ * @brief Take a block from the current CPU's magazine for a size class.
+ *
+ * @param[in] size_class The size class.
+ * @return Pointer to the block, or NULL if the magazine is empty. The contents of the block are undefined.
+ */
+static ebpf_epoch_allocation_header_t*
+_ebpf_epoch_slab_allocate(uint32_t size_class);
+
+/**
+ * @brief Return a block whose epoch has been released to a CPU's magazine for its size class, or to the pool if the
+ * block has no size class or the magazine is full.
+ *
+ * @param[in] cpu_id The CPU that released the block.
+ * @param[in] header The block to recycle.
+ */
+static void
+_ebpf_epoch_slab_free(uint32_t cpu_id, _Frees_ptr_ ebpf_epoch_allocation_header_t* header);
+
+/**
+ * @brief Get the thread slots for a CPU.
+ *
+ * @param[in] cpu_id The CPU id.
+ * @return Pointer to the first of EBPF_EPOCH_THREAD_SLOT_COUNT thread slots.
+ */
+static inline ebpf_epoch_thread_slot_t*
+_ebpf_epoch_get_thread_slots(uint32_t cpu_id)
+{
+    return &_ebpf_epoch_thread_slot_table[(size_t)cpu_id * EBPF_EPOCH_THREAD_SLOT_COUNT];
+}
+
+/**
+ * @brief Enter an epoch from a preemptible thread.
+ *
+ * @param[in] cpu_id The CPU id of the current thread.
+ * @retval EBPF_SUCCESS The operation was successful.
+ * @retval EBPF_NO_MEMORY Unable to allocate per-thread tracking state.
+ * @retval EBPF_OPERATION_NOT_SUPPORTED Unable to affinitize the thread.
+ */
+static ebpf_result_t
+_ebpf_epoch_enter_preemptible(uint32_t cpu_id);
+
+/**
+ * @brief Exit an epoch from a preemptible thread.
+ *
+ * @param[in] cpu_id The CPU id of the current thread.
+ * @param[out] old_thread_affinity The thread affinity to restore.
+ */
+static void
+_ebpf_epoch_exit_preemptible(uint32_t cpu_id, _Out_ uintptr_t* old_thread_affinity);
+
 _Must_inspect_result_ ebpf_result_t
 ebpf_epoch_initiate()
 {
@@ -209,6 +417,11 @@ ebpf_epoch_initiate()
     _ebpf_current_epoch = 1;
     _ebpf_release_epoch = 0;
     _ebpf_epoch_cpu_count = cpu_count;
+    _ebpf_epoch_backlog_threshold_in_bytes = EBPF_EPOCH_DEFAULT_BACKLOG_THRESHOLD_IN_BYTES;
+    _ebpf_epoch_flush_timer_fires = 0;
+    _ebpf_epoch_stale_worker_runs = 0;
+    _ebpf_epoch_stale_thread_detections = 0;
+    _ebpf_epoch_accelerated_flushes = 0;
 
     _ebpf_epoch_cpu_table = ebpf_allocate_cache_aligned(sizeof(ebpf_epoch_cpu_entry_t) * cpu_count);
     if (!_ebpf_epoch_cpu_table) {
@@ -218,9 +431,29 @@ ebpf_epoch_initiate()
 
     ebpf_assert(EBPF_CACHE_ALIGN_POINTER(_ebpf_epoch_cpu_table) == _ebpf_epoch_cpu_table);
 
+    _ebpf_epoch_thread_slot_table =
+        ebpf_allocate_cache_aligned(sizeof(ebpf_epoch_thread_slot_t) * EBPF_EPOCH_THREAD_SLOT_COUNT * cpu_count);
+    if (!_ebpf_epoch_thread_slot_table) {
+        return_value = EBPF_NO_MEMORY;
+        goto Error;
+    }
+
+    _ebpf_epoch_slab_table = ebpf_allocate_cache_aligned(sizeof(ebpf_epoch_slab_cpu_entry_t) * cpu_count);
+    if (!_ebpf_epoch_slab_table) {
+        return_value = EBPF_NO_MEMORY;
+        goto Error;
+    }
+
+    for (cpu_id = 0; cpu_id < _ebpf_epoch_cpu_count; cpu_id++) {
+        for (uint32_t size_class = 0; size_class < EBPF_EPOCH_SLAB_SIZE_CLASS_COUNT; size_class++) {
+            ebpf_epoch_slab_magazine_t* magazine = &_ebpf_epoch_slab_table[cpu_id].magazines[size_class];
+            ebpf_lock_create(&magazine->lock);
+            ebpf_list_initialize(&magazine->blocks);
+        }
+    }
+
     for (cpu_id = 0; cpu_id < _ebpf_epoch_cpu_count; cpu_id++) {
-        _ebpf_epoch_cpu_table[cpu_id].epoch_state.epoch = _ebpf_current_epoch;
-        _ebpf_epoch_cpu_table[cpu_id].epoch_state.active = false;
+        _ebpf_epoch_cpu_table[cpu_id].active_epoch = 0;
         ebpf_lock_create(&_ebpf_epoch_cpu_table[cpu_id].lock);
 
         ebpf_list_initialize(&_ebpf_epoch_cpu_table[cpu_id].free_list);
@@ -267,7 +500,7 @@ ebpf_epoch_terminate()
     // First disable all timers.
     for (cpu_id = 0; cpu_id < _ebpf_epoch_cpu_count; cpu_id++) {
         ebpf_lock_state_t lock_state = ebpf_lock_lock(&_ebpf_epoch_cpu_table[cpu_id].lock);
-        _ebpf_epoch_cpu_table[cpu_id].epoch_state.timer_disabled = true;
+        _ebpf_epoch_cpu_table[cpu_id].timer_disabled = true;
         ebpf_lock_unlock(&_ebpf_epoch_cpu_table[cpu_id].lock, lock_state);
     }
 
@@ -284,8 +517,28 @@ ebpf_epoch_terminate()
         _ebpf_epoch_cpu_table[cpu_id].thread_table = NULL;
         ebpf_free_non_preemptible_work_item(_ebpf_epoch_cpu_table[cpu_id].stale_worker);
     }
+
+    // Return all cached blocks to the pool.
+    for (cpu_id = 0; _ebpf_epoch_slab_table && cpu_id < _ebpf_epoch_cpu_count; cpu_id++) {
+        for (uint32_t size_class = 0; size_class < EBPF_EPOCH_SLAB_SIZE_CLASS_COUNT; size_class++) {
+            ebpf_epoch_slab_magazine_t* magazine = &_ebpf_epoch_slab_table[cpu_id].magazines[size_class];
+            while (!ebpf_list_is_empty(&magazine->blocks)) {
+                ebpf_list_entry_t* entry = magazine->blocks.Flink;
+                ebpf_list_remove_entry(entry);
+                ebpf_free(CONTAINING_RECORD(entry, ebpf_epoch_allocation_header_t, list_entry));
+            }
+            magazine->block_count = 0;
+            ebpf_lock_destroy(&magazine->lock);
+        }
+    }
     _ebpf_epoch_cpu_count = 0;
 
+    ebpf_free_cache_aligned(_ebpf_epoch_slab_table);
+    _ebpf_epoch_slab_table = NULL;
+
+    ebpf_free_cache_aligned(_ebpf_epoch_thread_slot_table);
+    _ebpf_epoch_thread_slot_table = NULL;
+
     ebpf_free_cache_aligned(_ebpf_epoch_cpu_table);
     _ebpf_epoch_cpu_table = NULL;
     EBPF_RETURN_VOID();
@@ -294,121 +547,49 @@ ebpf_epoch_terminate()
 _Must_inspect_result_ ebpf_result_t
 ebpf_epoch_enter()
 {
-    ebpf_result_t return_value;
-    uint32_t current_cpu;
-    ebpf_epoch_state_t* epoch_state = NULL;
-    // Capture preemptible state outside lock
     bool is_preemptible = ebpf_is_preemptible();
-    uintptr_t old_thread_affinity = 0;
-    current_cpu = ebpf_get_current_cpu();
+    uint32_t current_cpu = ebpf_get_current_cpu();
 
     // If the current CPU is not in the CPU table, then fail the enter.
     if (current_cpu >= _ebpf_epoch_cpu_count) {
         return EBPF_OPERATION_NOT_SUPPORTED;
     }
 
-    // Set the thread affinity to the current CPU.
     if (is_preemptible) {
-        return_value = ebpf_set_current_thread_affinity((uintptr_t)1 << current_cpu, &old_thread_affinity);
-        if (return_value != EBPF_SUCCESS) {
-            return EBPF_OPERATION_NOT_SUPPORTED;
-        }
+        return _ebpf_epoch_enter_preemptible(current_cpu);
     }
 
-    // Grab the CPU lock.
-    ebpf_lock_state_t state = ebpf_lock_lock(&_ebpf_epoch_cpu_table[current_cpu].lock);
-
-    // If this thread is preemptible, then find or create the per thread epoch state.
-    if (is_preemptible) {
-        // Find or create the thread entry.
-        ebpf_epoch_thread_entry_t* thread_entry = _ebpf_epoch_get_thread_entry(
-            current_cpu, ebpf_get_current_thread_id(), EBPF_EPOCH_GET_THREAD_ENTRY_OPTION_CREATE_IF_NOT_FOUND);
-        if (!thread_entry) {
-            return_value = EBPF_NO_MEMORY;
-            goto Done;
-        }
-
-        thread_entry->old_thread_affinity_mask = old_thread_affinity;
-
-        // Update the thread entry's last used time.
-        thread_entry->last_used_time = ebpf_query_time_since_boot(false);
-        epoch_state = &thread_entry->epoch_state;
-    } else {
-        // Otherwise grab the per-CPU epoch state.
-        epoch_state = &_ebpf_epoch_cpu_table[current_cpu].epoch_state;
-    }
-
-    // Capture the current epoch.
-    epoch_state->epoch = _ebpf_current_epoch;
-
-    // Mark the epoch state as active.
-    epoch_state->active = true;
-    return_value = EBPF_SUCCESS;
-
-Done:
-    // Release the CPU lock.
-    ebpf_lock_unlock(&_ebpf_epoch_cpu_table[current_cpu].lock, state);
-
-    // Restore thread affinity on failure
-    if (is_preemptible && return_value != 0) {
-        ebpf_restore_current_thread_affinity(old_thread_affinity);
-    }
-    return return_value;
+    // Nothing else can run on this CPU until ebpf_epoch_exit, so the per-CPU slot is owned by this caller.
+    _ebpf_epoch_publish(&_ebpf_epoch_cpu_table[current_cpu].active_epoch);
+    return EBPF_SUCCESS;
 }
 
 void
 ebpf_epoch_exit()
 {
-    ebpf_epoch_state_t* epoch_state = NULL;
-    // Capture preemptible state outside lock
     bool is_preemptible = ebpf_is_preemptible();
     uint32_t current_cpu = ebpf_get_current_cpu();
     uintptr_t old_thread_affinity = 0;
 
-    bool release_free_list = false;
     if (current_cpu >= _ebpf_epoch_cpu_count) {
         return;
     }
 
-    ebpf_lock_state_t state = ebpf_lock_lock(&_ebpf_epoch_cpu_table[current_cpu].lock);
+    ebpf_epoch_cpu_entry_t* cpu_entry = &_ebpf_epoch_cpu_table[current_cpu];
 
-    // If this thread is preemptible, then find the per thread epoch state.
     if (is_preemptible) {
-        // Get the thread entry for the current thread.
-        ebpf_epoch_thread_entry_t* thread_entry = _ebpf_epoch_get_thread_entry(
-            current_cpu, ebpf_get_current_thread_id(), EBPF_EPOCH_GET_THREAD_ENTRY_OPTION_DO_NOT_CREATE);
-
-        // If the thread entry is not found, then exit.
-        ebpf_assert(thread_entry);
-        if (!thread_entry) {
-            goto Done;
-        }
-
-        // Update the thread entry's last used time.
-        thread_entry->last_used_time = ebpf_query_time_since_boot(false);
-
-        old_thread_affinity = thread_entry->old_thread_affinity_mask;
-        epoch_state = &thread_entry->epoch_state;
+        _ebpf_epoch_exit_preemptible(current_cpu, &old_thread_affinity);
     } else {
-        // Otherwise grab the per-CPU epoch state.
-        epoch_state = &_ebpf_epoch_cpu_table[current_cpu].epoch_state;
+        _ebpf_epoch_retire(&cpu_entry->active_epoch);
     }
 
-    // Capture the current epoch.
-    epoch_state->epoch = _ebpf_current_epoch;
-    // Mark the epoch state as inactive.
-    epoch_state->active = false;
-    // Mark the epoch state as not stale.
-    epoch_state->stale = false;
+    // Mark the CPU as not stale.
+    cpu_entry->stale = false;
 
-    if (!ebpf_list_is_empty(&_ebpf_epoch_cpu_table[current_cpu].free_list)) {
-        release_free_list = true;
-    }
-
-Done:
-    ebpf_lock_unlock(&_ebpf_epoch_cpu_table[current_cpu].lock, state);
-    if (release_free_list) {
-        _ebpf_epoch_release_free_list(&_ebpf_epoch_cpu_table[current_cpu], _ebpf_release_epoch);
+    // The free list is checked without the lock. An entry that is missed here will be released on a later exit or
+    // by the stale worker.
+    if (!_ebpf_epoch_is_free_list_empty_no_lock(cpu_entry)) {
+        _ebpf_epoch_release_free_list(cpu_entry, _ebpf_release_epoch);
     }
 
     if (is_preemptible) {
@@ -438,11 +619,27 @@ _Must_inspect_result_ _Ret_writes_maybenull_(size) void* ebpf_epoch_allocate(siz
 {
     ebpf_assert(size);
     ebpf_epoch_allocation_header_t* header;
+    uint32_t size_class;
 
     size += sizeof(ebpf_epoch_allocation_header_t);
-    header = (ebpf_epoch_allocation_header_t*)ebpf_allocate(size);
-    if (header)
+    size_class = _ebpf_epoch_slab_get_size_class(size);
+    if (size_class < EBPF_EPOCH_SLAB_SIZE_CLASS_COUNT) {
+        header = _ebpf_epoch_slab_allocate(size_class);
+        if (header) {
+            // Blocks from the pool are zero initialized, so recycled blocks must be too.
+            memset(header, 0, size);
+        } else {
+            header = (ebpf_epoch_allocation_header_t*)ebpf_allocate(EBPF_EPOCH_SLAB_BLOCK_SIZE(size_class));
+        }
+        size = EBPF_EPOCH_SLAB_BLOCK_SIZE(size_class);
+    } else {
+        header = (ebpf_epoch_allocation_header_t*)ebpf_allocate(size);
+    }
+
+    if (header) {
+        header->size = (uint32_t)min(size, UINT32_MAX);
         header++;
+    }
 
     return header;
 }
@@ -472,11 +669,20 @@ ebpf_epoch_free(_Frees_ptr_opt_ void* memory)
     ebpf_assert(header->freed_epoch == 0);
     header->entry_type = EBPF_EPOCH_ALLOCATION_MEMORY;
 
+    ebpf_epoch_cpu_entry_t* cpu_entry = &_ebpf_epoch_cpu_table[current_cpu];
+
     // Items are inserted into the free list in increasing epoch order.
-    lock_state = ebpf_lock_lock(&_ebpf_epoch_cpu_table[current_cpu].lock);
+    lock_state = ebpf_lock_lock(&cpu_entry->lock);
     header->freed_epoch = ebpf_interlocked_increment_int64(&_ebpf_current_epoch) - 1;
-    ebpf_list_insert_tail(&_ebpf_epoch_cpu_table[current_cpu].free_list, &header->list_entry);
-    ebpf_lock_unlock(&_ebpf_epoch_cpu_table[current_cpu].lock, lock_state);
+    ebpf_list_insert_tail(&cpu_entry->free_list, &header->list_entry);
+    cpu_entry->pending_blocks++;
+    cpu_entry->pending_bytes += header->size;
+
+    // Don't wait for the next exit on this CPU to arm the timer if the backlog is growing.
+    if (_ebpf_epoch_is_backlogged(cpu_entry)) {
+        _ebpf_epoch_arm_timer_if_needed(cpu_entry);
+    }
+    ebpf_lock_unlock(&cpu_entry->lock, lock_state);
 }
 
 ebpf_epoch_work_item_t*
@@ -512,8 +718,10 @@ ebpf_epoch_schedule_work_item(_Inout_ ebpf_epoch_work_item_t* work_item)
 
     // Items are inserted into the free list in increasing epoch order.
     lock_state = ebpf_lock_lock(&_ebpf_epoch_cpu_table[current_cpu].lock);
+    work_item->cpu_id = current_cpu;
     work_item->header.freed_epoch = ebpf_interlocked_increment_int64(&_ebpf_current_epoch) - 1;
     ebpf_list_insert_tail(&_ebpf_epoch_cpu_table[current_cpu].free_list, &work_item->header.list_entry);
+    _ebpf_epoch_cpu_table[current_cpu].pending_work_items++;
     _ebpf_epoch_arm_timer_if_needed(&_ebpf_epoch_cpu_table[current_cpu]);
     ebpf_lock_unlock(&_ebpf_epoch_cpu_table[current_cpu].lock, lock_state);
 }
@@ -531,9 +739,15 @@ ebpf_epoch_free_work_item(_Frees_ptr_opt_ ebpf_epoch_work_item_t* work_item)
         return;
     }
 
-    lock_state = ebpf_lock_lock(&_ebpf_epoch_cpu_table[current_cpu].lock);
+    // The work item is on the free list of the CPU it was scheduled on, which may not be the current CPU.
+    ebpf_epoch_cpu_entry_t* cpu_entry = &_ebpf_epoch_cpu_table[work_item->cpu_id];
+    lock_state = ebpf_lock_lock(&cpu_entry->lock);
     ebpf_list_remove_entry(&work_item->header.list_entry);
-    ebpf_lock_unlock(&_ebpf_epoch_cpu_table[current_cpu].lock, lock_state);
+    // A work item that was scheduled and hasn't run yet is still counted as pending.
+    if (work_item->header.freed_epoch != 0) {
+        cpu_entry->pending_work_items--;
+    }
+    ebpf_lock_unlock(&cpu_entry->lock, lock_state);
     ebpf_free(work_item);
 }
 
@@ -547,6 +761,54 @@ ebpf_epoch_is_free_list_empty(uint32_t cpu_id)
     return is_free_list_empty;
 }
 
+_Must_inspect_result_ ebpf_result_t
+ebpf_epoch_query_statistics(
+    _Out_ ebpf_epoch_statistics_t* statistics,
+    _Out_writes_opt_(*cpu_count) ebpf_epoch_cpu_statistics_t* cpu_statistics,
+    _Inout_ uint32_t* cpu_count)
+{
+    int64_t current_epoch = _ebpf_current_epoch;
+
+    statistics->current_epoch = (uint64_t)current_epoch;
+    statistics->release_epoch = (uint64_t)_ebpf_release_epoch;
+    statistics->flush_timer_fires = (uint64_t)_ebpf_epoch_flush_timer_fires;
+    statistics->stale_worker_runs = (uint64_t)_ebpf_epoch_stale_worker_runs;
+    statistics->stale_thread_detections = (uint64_t)_ebpf_epoch_stale_thread_detections;
+    statistics->accelerated_flushes = (uint64_t)_ebpf_epoch_accelerated_flushes;
+    statistics->backlog_threshold_in_bytes = (uint64_t)_ebpf_epoch_backlog_threshold_in_bytes;
+
+    if (*cpu_count < _ebpf_epoch_cpu_count || (_ebpf_epoch_cpu_count > 0 && !cpu_statistics)) {
+        *cpu_count = _ebpf_epoch_cpu_count;
+        return EBPF_INSUFFICIENT_BUFFER;
+    }
+    *cpu_count = _ebpf_epoch_cpu_count;
+
+    for (uint32_t cpu_id = 0; cpu_id < _ebpf_epoch_cpu_count; cpu_id++) {
+        ebpf_epoch_cpu_entry_t* cpu_entry = &_ebpf_epoch_cpu_table[cpu_id];
+        ebpf_epoch_cpu_statistics_t* entry_statistics = &cpu_statistics[cpu_id];
+        ebpf_lock_state_t lock_state = ebpf_lock_lock(&cpu_entry->lock);
+        entry_statistics->pending_blocks = cpu_entry->pending_blocks;
+        entry_statistics->pending_bytes = cpu_entry->pending_bytes;
+        entry_statistics->pending_work_items = cpu_entry->pending_work_items;
+        entry_statistics->oldest_pending_epoch_age = 0;
+        // The free list is ordered by epoch, so the oldest entry is at the head.
+        if (!ebpf_list_is_empty(&cpu_entry->free_list)) {
+            ebpf_epoch_allocation_header_t* header =
+                CONTAINING_RECORD(cpu_entry->free_list.Flink, ebpf_epoch_allocation_header_t, list_entry);
+            entry_statistics->oldest_pending_epoch_age = (uint64_t)max(current_epoch - header->freed_epoch, 0);
+        }
+        ebpf_lock_unlock(&cpu_entry->lock, lock_state);
+    }
+
+    return EBPF_SUCCESS;
+}
+
+void
+ebpf_epoch_set_backlog_threshold(size_t threshold_in_bytes)
+{
+    _ebpf_epoch_backlog_threshold_in_bytes = (int64_t)min(threshold_in_bytes, (size_t)MAXINT64);
+}
+
 static void
 _ebpf_epoch_release_free_list(_Inout_ ebpf_epoch_cpu_entry_t* cpu_entry, int64_t released_epoch)
 {
@@ -566,6 +828,14 @@ _ebpf_epoch_release_free_list(_Inout_ ebpf_epoch_cpu_entry_t* cpu_entry, int64_t
         if (header->freed_epoch <= released_epoch) {
             ebpf_list_remove_entry(entry);
             ebpf_list_insert_tail(&free_list, entry);
+            if (header->entry_type == EBPF_EPOCH_ALLOCATION_MEMORY) {
+                cpu_entry->pending_blocks--;
+                cpu_entry->pending_bytes -= header->size;
+            } else {
+                cpu_entry->pending_work_items--;
+                // The work item is no longer pending.
+                header->freed_epoch = 0;
+            }
         } else {
             break;
         }
@@ -583,7 +853,7 @@ _ebpf_epoch_release_free_list(_Inout_ ebpf_epoch_cpu_entry_t* cpu_entry, int64_t
         ebpf_list_remove_entry(entry);
         switch (header->entry_type) {
         case EBPF_EPOCH_ALLOCATION_MEMORY:
-            ebpf_free(header);
+            _ebpf_epoch_slab_free((uint32_t)(cpu_entry - _ebpf_epoch_cpu_table), header);
             break;
         case EBPF_EPOCH_ALLOCATION_WORK_ITEM: {
             ebpf_epoch_work_item_t* work_item = CONTAINING_RECORD(header, ebpf_epoch_work_item_t, header);
@@ -606,12 +876,18 @@ _ebpf_epoch_get_release_epoch(_Out_ int64_t* release_epoch)
     ebpf_lock_state_t lock_state;
     ebpf_result_t return_value;
     uint64_t now = ebpf_query_time_since_boot(false);
+    // Time a thread can remain in an epoch before it is logged as stale.
+    const uint64_t stale_active_thread_age =
+        EBPF_EPOCH_STALE_THREAD_TIME_IN_NANO_SECONDS / EBPF_NANO_SECONDS_PER_FILETIME_TICK;
     EBPF_LOG_MESSAGE_UINT64(
         EBPF_TRACELOG_LEVEL_VERBOSE,
         EBPF_TRACELOG_KEYWORD_EPOCH,
         "Captured value of _ebpf_current_epoch",
         lowest_epoch);
 
+    // Order the capture of _ebpf_current_epoch before reading any epoch slot.
+    MemoryBarrier();
+
     for (cpu_id = 0; cpu_id < _ebpf_epoch_cpu_count; cpu_id++) {
         ebpf_epoch_thread_entry_t* thread_entry = NULL;
         uintptr_t thread_id = 0;
@@ -620,13 +896,13 @@ _ebpf_epoch_get_release_epoch(_Out_ int64_t* release_epoch)
         lock_state = ebpf_lock_lock(&_ebpf_epoch_cpu_table[cpu_id].lock);
 
         // Clear the flush timer flag and re-arm the timer if needed.
-        _ebpf_epoch_cpu_table[cpu_id].epoch_state.timer_armed = false;
+        _ebpf_epoch_cpu_table[cpu_id].timer_armed = false;
         _ebpf_epoch_arm_timer_if_needed(&_ebpf_epoch_cpu_table[cpu_id]);
 
         // Check for stale items in the free list.
         if (!ebpf_list_is_empty(&_ebpf_epoch_cpu_table[cpu_id].free_list)) {
             // If the stale flag is set, then schedule the DPC to release the stale items.
-            if (_ebpf_epoch_cpu_table[cpu_id].epoch_state.stale) {
+            if (_ebpf_epoch_cpu_table[cpu_id].stale) {
                 if (!_ebpf_epoch_cpu_table[cpu_id].stale_worker) {
                     // If ebpf_allocate_non_preemptible_work_item fails, it will retry next time the timer fires.
                     (void)ebpf_allocate_non_preemptible_work_item(
@@ -634,15 +910,37 @@ _ebpf_epoch_get_release_epoch(_Out_ int64_t* release_epoch)
                 }
                 if (_ebpf_epoch_cpu_table[cpu_id].stale_worker) {
                     ebpf_queue_non_preemptible_work_item(_ebpf_epoch_cpu_table[cpu_id].stale_worker, NULL);
+                    ebpf_interlocked_increment_int64(&_ebpf_epoch_stale_worker_runs);
                 }
             } else {
-                _ebpf_epoch_cpu_table[cpu_id].epoch_state.stale = true;
+                _ebpf_epoch_cpu_table[cpu_id].stale = true;
             }
         }
 
-        // Include this epoch state if it's active.
-        if (_ebpf_epoch_cpu_table[cpu_id].epoch_state.active) {
-            lowest_epoch = min(lowest_epoch, _ebpf_epoch_cpu_table[cpu_id].epoch_state.epoch);
+        // Include the per-CPU slot and the thread slots if they are active. These are read without the lock.
+        int64_t active_epoch = _ebpf_epoch_cpu_table[cpu_id].active_epoch;
+        if (active_epoch != 0) {
+            lowest_epoch = min(lowest_epoch, active_epoch);
+        }
+
+        ebpf_epoch_thread_slot_t* thread_slots = _ebpf_epoch_get_thread_slots(cpu_id);
+        for (uint32_t slot_index = 0; slot_index < EBPF_EPOCH_THREAD_SLOT_COUNT; slot_index++) {
+            active_epoch = thread_slots[slot_index].epoch;
+            if (active_epoch != 0) {
+                lowest_epoch = min(lowest_epoch, active_epoch);
+                if (now - thread_slots[slot_index].enter_time > stale_active_thread_age) {
+                    EBPF_LOG_MESSAGE_UINT64_UINT64(
+                        EBPF_TRACELOG_LEVEL_VERBOSE,
+                        EBPF_TRACELOG_KEYWORD_EPOCH,
+                        "Stale active thread slot",
+                        (uint64_t)thread_slots[slot_index].thread_id,
+                        now - thread_slots[slot_index].enter_time);
+                    ebpf_interlocked_increment_int64(&_ebpf_epoch_stale_thread_detections);
+                    // Reset enter_time to limit rate of logging. A racing enter on this slot overwrites it with
+                    // the same time.
+                    thread_slots[slot_index].enter_time = now;
+                }
+            }
         }
 
         // If a thread was last used before this cutoff, then it is stale and should be removed.
@@ -665,14 +963,15 @@ _ebpf_epoch_get_release_epoch(_Out_ int64_t* release_epoch)
 
             // Include this epoch state if it's active.
             if (thread_entry->epoch_state.active) {
-                int64_t age = now - thread_entry->last_used_time;
-                if (age > EBPF_EPOCH_STALE_THREAD_TIME_IN_NANO_SECONDS) {
+                uint64_t age = now - thread_entry->last_used_time;
+                if (age > stale_active_thread_age) {
                     EBPF_LOG_MESSAGE_UINT64_UINT64(
                         EBPF_TRACELOG_LEVEL_VERBOSE,
                         EBPF_TRACELOG_KEYWORD_EPOCH,
                         "Stale active thread entry",
                         (uint64_t)thread_id,
                         age);
+                    ebpf_interlocked_increment_int64(&_ebpf_epoch_stale_thread_detections);
                     // Reset last_used_time time to limit rate of logging.
                     thread_entry->last_used_time = now;
                 }
@@ -716,6 +1015,7 @@ _ebpf_flush_worker(_In_ const void* context)
 {
     UNREFERENCED_PARAMETER(context);
 
+    ebpf_interlocked_increment_int64(&_ebpf_epoch_flush_timer_fires);
     ebpf_epoch_flush();
 }
 
@@ -746,17 +1046,22 @@ static _Requires_lock_held_(_ebpf_epoch_cpu_table[cpu_id].lock) ebpf_epoch_threa
 
 static _Requires_lock_held_(cpu_entry->lock) void _ebpf_epoch_arm_timer_if_needed(ebpf_epoch_cpu_entry_t* cpu_entry)
 {
-    if (cpu_entry->epoch_state.timer_disabled) {
+    if (cpu_entry->timer_disabled) {
         return;
     }
-    if (cpu_entry->epoch_state.timer_armed) {
+    if (cpu_entry->timer_armed) {
         return;
     }
     if (ebpf_list_is_empty(&cpu_entry->free_list)) {
         return;
     }
-    cpu_entry->epoch_state.timer_armed = true;
-    ebpf_schedule_timer_work_item(_ebpf_flush_timer, EBPF_EPOCH_FLUSH_DELAY_IN_MICROSECONDS);
+    cpu_entry->timer_armed = true;
+    if (_ebpf_epoch_is_backlogged(cpu_entry)) {
+        ebpf_interlocked_increment_int64(&_ebpf_epoch_accelerated_flushes);
+        ebpf_schedule_timer_work_item(_ebpf_flush_timer, EBPF_EPOCH_FLUSH_DELAY_UNDER_BACKLOG_IN_MICROSECONDS);
+    } else {
+        ebpf_schedule_timer_work_item(_ebpf_flush_timer, EBPF_EPOCH_FLUSH_DELAY_IN_MICROSECONDS);
+    }
     return;
 }
 
@@ -769,3 +1074,150 @@ _ebpf_epoch_stale_worker(_In_ const void* work_item_context, _In_ const void* pa
         ebpf_epoch_exit();
     }
 }
+
+static ebpf_result_t
+_ebpf_epoch_enter_preemptible(uint32_t cpu_id)
+{
+    ebpf_result_t return_value;
+    uintptr_t old_thread_affinity = 0;
+    uintptr_t thread_id = ebpf_get_current_thread_id();
+    ebpf_epoch_thread_slot_t* thread_slots = _ebpf_epoch_get_thread_slots(cpu_id);
+
+    // Set the thread affinity to the current CPU.
+    return_value = ebpf_set_current_thread_affinity((uintptr_t)1 << cpu_id, &old_thread_affinity);
+    if (return_value != EBPF_SUCCESS) {
+        return EBPF_OPERATION_NOT_SUPPORTED;
+    }
+
+    // Claim a free thread slot. Only preemptible threads affinitized to this CPU compete for these slots.
+    for (uint32_t slot_index = 0; slot_index < EBPF_EPOCH_THREAD_SLOT_COUNT; slot_index++) {
+        ebpf_epoch_thread_slot_t* thread_slot = &thread_slots[slot_index];
+        if (thread_slot->thread_id != NULL) {
+            continue;
+        }
+        if (ebpf_interlocked_compare_exchange_pointer(&thread_slot->thread_id, (void*)thread_id, NULL) == NULL) {
+            thread_slot->old_thread_affinity_mask = old_thread_affinity;
+            thread_slot->enter_time = ebpf_query_time_since_boot(false);
+            _ebpf_epoch_publish(&thread_slot->epoch);
+            return EBPF_SUCCESS;
+        }
+    }
+
+    // All thread slots are in use, fall back to the per-CPU thread table.
+    ebpf_lock_state_t state = ebpf_lock_lock(&_ebpf_epoch_cpu_table[cpu_id].lock);
+
+    ebpf_epoch_thread_entry_t* thread_entry =
+        _ebpf_epoch_get_thread_entry(cpu_id, thread_id, EBPF_EPOCH_GET_THREAD_ENTRY_OPTION_CREATE_IF_NOT_FOUND);
+    if (!thread_entry) {
+        return_value = EBPF_NO_MEMORY;
+    } else {
+        thread_entry->old_thread_affinity_mask = old_thread_affinity;
+
+        // Update the thread entry's last used time.
+        thread_entry->last_used_time = ebpf_query_time_since_boot(false);
+
+        // Capture the current epoch and mark the epoch state as active.
+        thread_entry->epoch_state.epoch = _ebpf_current_epoch;
+        thread_entry->epoch_state.active = true;
+        return_value = EBPF_SUCCESS;
+    }
+
+    ebpf_lock_unlock(&_ebpf_epoch_cpu_table[cpu_id].lock, state);
+
+    // Restore thread affinity on failure.
+    if (return_value != EBPF_SUCCESS) {
+        ebpf_restore_current_thread_affinity(old_thread_affinity);
+    }
+    return return_value;
+}
+
+static void
+_ebpf_epoch_exit_preemptible(uint32_t cpu_id, _Out_ uintptr_t* old_thread_affinity)
+{
+    uintptr_t thread_id = ebpf_get_current_thread_id();
+    ebpf_epoch_thread_slot_t* thread_slots = _ebpf_epoch_get_thread_slots(cpu_id);
+
+    *old_thread_affinity = 0;
+
+    // Search from the last slot, so that a nested entry is normally found before the entry that encloses it.
+    for (uint32_t slot_index = EBPF_EPOCH_THREAD_SLOT_COUNT; slot_index-- > 0;) {
+        ebpf_epoch_thread_slot_t* thread_slot = &thread_slots[slot_index];
+        if (thread_slot->thread_id == (void*)thread_id) {
+            *old_thread_affinity = thread_slot->old_thread_affinity_mask;
+            _ebpf_epoch_retire(&thread_slot->epoch);
+            // Release the slot for other threads on this CPU.
+            (void)ebpf_interlocked_compare_exchange_pointer(&thread_slot->thread_id, NULL, (void*)thread_id);
+            return;
+        }
+    }
+
+    // The thread didn't get a thread slot, so it must be in the per-CPU thread table.
+    ebpf_lock_state_t state = ebpf_lock_lock(&_ebpf_epoch_cpu_table[cpu_id].lock);
+
+    ebpf_epoch_thread_entry_t* thread_entry =
+        _ebpf_epoch_get_thread_entry(cpu_id, thread_id, EBPF_EPOCH_GET_THREAD_ENTRY_OPTION_DO_NOT_CREATE);
+
+    // If the thread entry is not found, then exit.
+    ebpf_assert(thread_entry);
+    if (thread_entry) {
+        // Update the thread entry's last used time.
+        thread_entry->last_used_time = ebpf_query_time_since_boot(false);
+
+        *old_thread_affinity = thread_entry->old_thread_affinity_mask;
+
+        // Capture the current epoch and mark the epoch state as inactive.
+        thread_entry->epoch_state.epoch = _ebpf_current_epoch;
+        thread_entry->epoch_state.active = false;
+    }
+
+    ebpf_lock_unlock(&_ebpf_epoch_cpu_table[cpu_id].lock, state);
+}
+
+static ebpf_epoch_allocation_header_t*
+_ebpf_epoch_slab_allocate(uint32_t size_class)
+{
+    ebpf_epoch_allocation_header_t* header = NULL;
+    uint32_t current_cpu = ebpf_get_current_cpu();
+
+    if (!_ebpf_epoch_slab_table || current_cpu >= _ebpf_epoch_cpu_count) {
+        return NULL;
+    }
+
+    ebpf_epoch_slab_magazine_t* magazine = &_ebpf_epoch_slab_table[current_cpu].magazines[size_class];
+    ebpf_lock_state_t lock_state = ebpf_lock_lock(&magazine->lock);
+    if (!ebpf_list_is_empty(&magazine->blocks)) {
+        // Reuse the most recently freed block, which is the most likely to still be in the cache.
+        ebpf_list_entry_t* entry = magazine->blocks.Blink;
+        ebpf_list_remove_entry(entry);
+        magazine->block_count--;
+        header = CONTAINING_RECORD(entry, ebpf_epoch_allocation_header_t, list_entry);
+    }
+    ebpf_lock_unlock(&magazine->lock, lock_state);
+
+    return header;
+}
+
+static void
+_ebpf_epoch_slab_free(uint32_t cpu_id, _Frees_ptr_ ebpf_epoch_allocation_header_t* header)
+{
+    uint32_t size_class = _ebpf_epoch_slab_get_size_class(header->size);
+
+    if (_ebpf_epoch_rundown || !_ebpf_epoch_slab_table || size_class >= EBPF_EPOCH_SLAB_SIZE_CLASS_COUNT) {
+        ebpf_free(header);
+        return;
+    }
+
+    ebpf_epoch_slab_magazine_t* magazine = &_ebpf_epoch_slab_table[cpu_id].magazines[size_class];
+    ebpf_lock_state_t lock_state = ebpf_lock_lock(&magazine->lock);
+    if (magazine->block_count < EBPF_EPOCH_SLAB_MAGAZINE_SIZE_IN_BYTES / EBPF_EPOCH_SLAB_BLOCK_SIZE(size_class)) {
+        ebpf_list_insert_tail(&magazine->blocks, &header->list_entry);
+        magazine->block_count++;
+        header = NULL;
+    }
+    ebpf_lock_unlock(&magazine->lock, lock_state);
+
+    // The magazine is full.
+    if (header) {
+        ebpf_free(header);
+    }
+}
@@ -3,6 +3,7 @@
 
 #pragma once
 
+#include "ebpf_core_structs.h"
 #include "ebpf_platform.h"
 
 #ifdef __cplusplus
@@ -103,6 +104,29 @@ extern "C"
     bool
     ebpf_epoch_is_free_list_empty(uint32_t cpu_id);
 
+    /**
+     * @brief Query the state of epoch reclamation.
+     *
+     * @param[out] statistics Global epoch statistics.
+     * @param[out] cpu_statistics Array that receives the statistics of each CPU.
+     * @param[in, out] cpu_count On input, the number of entries in cpu_statistics. On output, the number of CPUs.
+     * @retval EBPF_SUCCESS The operation was successful.
+     * @retval EBPF_INSUFFICIENT_BUFFER cpu_statistics is too small to hold the statistics of every CPU.
+     */
+    _Must_inspect_result_ ebpf_result_t
+    ebpf_epoch_query_statistics(
+        _Out_ ebpf_epoch_statistics_t* statistics,
+        _Out_writes_opt_(*cpu_count) ebpf_epoch_cpu_statistics_t* cpu_statistics,
+        _Inout_ uint32_t* cpu_count);
+
+    /**
+     * @brief Set the number of pending bytes on a CPU above which the flush timer uses a shorter delay.
+     *
+     * @param[in] threshold_in_bytes Backlog threshold in bytes, or 0 to always use the default delay.
+     */
+    void
+    ebpf_epoch_set_backlog_threshold(size_t threshold_in_bytes);
+
 #ifdef __cplusplus
 }
 #endif
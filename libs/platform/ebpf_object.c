@@ -32,41 +32,80 @@ static ebpf_lock_t _ebpf_object_tracking_list_lock = {0};
  * object gets a unique ID upon creation.
  */
 
+// IDs are made of a table index in the high EBPF_ID_INDEX_BITS bits and a generation counter in the low
+// EBPF_ID_GENERATION_BITS bits. The counter is incremented each time an entry is reused, which allows stale IDs to
+// be detected while still keeping IDs in order by index.
+#define EBPF_ID_GENERATION_BITS 12
+#define EBPF_ID_GENERATION_MASK ((1 << EBPF_ID_GENERATION_BITS) - 1)
+#define EBPF_ID_INDEX_BITS (32 - EBPF_ID_GENERATION_BITS)
+
+// The ID table grows one page at a time. Pages are never freed until object tracking is terminated, which lets
+// ebpf_object_reference_by_id find an entry without acquiring _ebpf_object_tracking_list_lock.
+#define EBPF_ID_TABLE_PAGE_SHIFT 10
+#define EBPF_ID_TABLE_PAGE_SIZE (1 << EBPF_ID_TABLE_PAGE_SHIFT)
+#define EBPF_ID_TABLE_PAGE_COUNT ((1 << EBPF_ID_INDEX_BITS) / EBPF_ID_TABLE_PAGE_SIZE)
+
+// The last index is not used, so that no ID is equal to EBPF_ID_NONE. Index 0 is not used, so that no ID is 0.
+#define EBPF_ID_TABLE_MAX_ENTRIES ((1 << EBPF_ID_INDEX_BITS) - 1)
+
 typedef struct _ebpf_id_entry
 {
     // Counter incremented each time a new object is stored here.
     uint16_t counter;
 
+    // Index of the next free entry, or 0 if this is the last free entry. Only valid while the entry is free.
+    uint32_t next_free_index;
+
     // Pointer to object.
-    ebpf_core_object_t* object;
+    ebpf_core_object_t* volatile object;
 } ebpf_id_entry_t;
 
-// Currently we allow a maximum of 1024 objects (links, maps,
-// and programs combined).  This can be increased in the future
-// if needed by making each array element store a linked list of
-// entries in order by ID, rather than a single entry, in which
-// case this becomes a hash table.
-static _Requires_lock_held_(&_ebpf_object_tracking_list_lock) ebpf_id_entry_t _ebpf_id_table[1024];
+// Pages of EBPF_ID_TABLE_PAGE_SIZE entries, allocated on demand. Pages are published with a release store and
+// read without the lock.
+static ebpf_id_entry_t* volatile _ebpf_id_table_pages[EBPF_ID_TABLE_PAGE_COUNT];
+
+// Number of entries in the allocated pages.
+static _Requires_lock_held_(&_ebpf_object_tracking_list_lock) uint32_t _ebpf_id_table_size;
+
+// Free entries are reused in the order in which they were freed, which maximizes the time before an entry's
+// counter wraps around and an ID is reused.
+static _Requires_lock_held_(&_ebpf_object_tracking_list_lock) uint32_t _ebpf_id_table_free_head;
+static _Requires_lock_held_(&_ebpf_object_tracking_list_lock) uint32_t _ebpf_id_table_free_tail;
+
+// Get the entry at a given index, or NULL if the index is not in an allocated page.
+static inline _Ret_maybenull_ ebpf_id_entry_t*
+_get_entry_from_index(uint32_t index)
+{
+    if (index >= EBPF_ID_TABLE_MAX_ENTRIES) {
+        return NULL;
+    }
+
+    ebpf_id_entry_t* page =
+        (ebpf_id_entry_t*)ReadPointerAcquire((void* volatile*)&_ebpf_id_table_pages[index >> EBPF_ID_TABLE_PAGE_SHIFT]);
+    if (page == NULL) {
+        return NULL;
+    }
+
+    return &page[index & (EBPF_ID_TABLE_PAGE_SIZE - 1)];
+}
 
 // Get the ID last stored at a given index.
 static inline ebpf_id_t
 _get_id_from_index(uint32_t index)
 {
-    if (index >= EBPF_COUNT_OF(_ebpf_id_table)) {
+    ebpf_id_entry_t* entry = _get_entry_from_index(index);
+    if (entry == NULL) {
         return EBPF_ID_NONE;
     }
 
-    // Put the index in the high 2 bytes and the counter in the low 2 bytes.
-    // This allows us to more easily detect stale IDs while
-    // still keeping IDs in order by index.
-    return (index << 16) | _ebpf_id_table[index].counter;
+    return (index << EBPF_ID_GENERATION_BITS) | entry->counter;
 }
 
 // Get the index at which a given ID is stored.
 static inline ebpf_result_t
 _get_index_from_id(ebpf_id_t id, _Out_ uint32_t* index)
 {
-    uint32_t possible_index = id >> 16;
+    uint32_t possible_index = id >> EBPF_ID_GENERATION_BITS;
     if (id != _get_id_from_index(possible_index)) {
         return EBPF_KEY_NOT_FOUND;
     }
@@ -75,34 +114,83 @@ _get_index_from_id(ebpf_id_t id, _Out_ uint32_t* index)
     return EBPF_SUCCESS;
 }
 
+// Append an entry to the free list.
+_Requires_lock_held_(&_ebpf_object_tracking_list_lock) static void _ebpf_id_table_push_free(uint32_t index)
+{
+    ebpf_id_entry_t* entry = _get_entry_from_index(index);
+    ebpf_assert(entry != NULL);
+    _Analysis_assume_(entry != NULL);
+
+    entry->next_free_index = 0;
+    if (_ebpf_id_table_free_tail == 0) {
+        _ebpf_id_table_free_head = index;
+    } else {
+        _get_entry_from_index(_ebpf_id_table_free_tail)->next_free_index = index;
+    }
+    _ebpf_id_table_free_tail = index;
+}
+
+// Add a page of entries to the ID table and to the free list.
+_Requires_lock_held_(&_ebpf_object_tracking_list_lock) static ebpf_result_t _ebpf_id_table_grow()
+{
+    uint32_t page_index = _ebpf_id_table_size >> EBPF_ID_TABLE_PAGE_SHIFT;
+    if (page_index >= EBPF_ID_TABLE_PAGE_COUNT) {
+        return EBPF_NO_MEMORY;
+    }
+
+    ebpf_id_entry_t* page = ebpf_allocate(sizeof(ebpf_id_entry_t) * EBPF_ID_TABLE_PAGE_SIZE);
+    if (page == NULL) {
+        return EBPF_NO_MEMORY;
+    }
+    WritePointerRelease((void* volatile*)&_ebpf_id_table_pages[page_index], page);
+    _ebpf_id_table_size += EBPF_ID_TABLE_PAGE_SIZE;
+
+    for (uint32_t index = page_index << EBPF_ID_TABLE_PAGE_SHIFT; index < _ebpf_id_table_size; index++) {
+        // Index 0 and EBPF_ID_TABLE_MAX_ENTRIES are never used.
+        if (index != 0 && index < EBPF_ID_TABLE_MAX_ENTRIES) {
+            _ebpf_id_table_push_free(index);
+        }
+    }
+    return EBPF_SUCCESS;
+}
+
 static ebpf_result_t
 _ebpf_object_tracking_list_insert(_Inout_ ebpf_core_object_t* object)
 {
-    int new_index;
+    uint32_t new_index;
+    ebpf_id_entry_t* entry;
     ebpf_result_t return_value;
     ebpf_lock_state_t state;
     state = ebpf_lock_lock(&_ebpf_object_tracking_list_lock);
-    for (new_index = 1; new_index < EBPF_COUNT_OF(_ebpf_id_table); new_index++) {
-        if (_ebpf_id_table[new_index].object == NULL) {
-            break;
+    if (_ebpf_id_table_free_head == 0) {
+        return_value = _ebpf_id_table_grow();
+        if (return_value != EBPF_SUCCESS) {
+            goto Done;
         }
     }
-    if (new_index == EBPF_COUNT_OF(_ebpf_id_table)) {
-        return_value = EBPF_NO_MEMORY;
-        goto Done;
+
+    new_index = _ebpf_id_table_free_head;
+    entry = _get_entry_from_index(new_index);
+    ebpf_assert(entry != NULL);
+    _Analysis_assume_(entry != NULL);
+    _ebpf_id_table_free_head = entry->next_free_index;
+    if (_ebpf_id_table_free_head == 0) {
+        _ebpf_id_table_free_tail = 0;
     }
 
     // Generate a new ID.
-    _ebpf_id_table[new_index].counter++;
-    _ebpf_id_table[new_index].object = object;
+    entry->counter = (entry->counter + 1) & EBPF_ID_GENERATION_MASK;
     object->id = _get_id_from_index(new_index);
 
+    // Publish the object after its ID is set, for lock-free lookups.
+    WritePointerRelease((void* volatile*)&entry->object, object);
+
     return_value = EBPF_SUCCESS;
 
 Done:
     ebpf_lock_unlock(&_ebpf_object_tracking_list_lock, state);
 
-    return EBPF_SUCCESS;
+    return return_value;
 }
 
 _Requires_lock_held_(&_ebpf_object_tracking_list_lock) static void _ebpf_object_tracking_list_remove(
@@ -116,22 +204,37 @@ _Requires_lock_held_(&_ebpf_object_tracking_list_lock) static void _ebpf_object_
     // need to avoid an unreferenced variable warning.
     UNREFERENCED_PARAMETER(return_value);
 
-    _ebpf_id_table[index].object = NULL;
+    WritePointerRelease((void* volatile*)&_get_entry_from_index(index)->object, NULL);
+    _ebpf_id_table_push_free(index);
 }
 
 void
 ebpf_object_tracking_initiate()
 {
     ebpf_lock_create(&_ebpf_object_tracking_list_lock);
-    memset(_ebpf_id_table, 0, sizeof(_ebpf_id_table));
+    memset((void*)_ebpf_id_table_pages, 0, sizeof(_ebpf_id_table_pages));
+    _ebpf_id_table_size = 0;
+    _ebpf_id_table_free_head = 0;
+    _ebpf_id_table_free_tail = 0;
 }
 
 void
 ebpf_object_tracking_terminate()
 {
-    for (int index = 0; index < EBPF_COUNT_OF(_ebpf_id_table); index++) {
-        ebpf_assert(_ebpf_id_table[index].object == NULL || ebpf_fuzzing_enabled);
+    for (uint32_t page_index = 0; page_index < EBPF_ID_TABLE_PAGE_COUNT; page_index++) {
+        ebpf_id_entry_t* page = _ebpf_id_table_pages[page_index];
+        if (page == NULL) {
+            break;
+        }
+        for (uint32_t index = 0; index < EBPF_ID_TABLE_PAGE_SIZE; index++) {
+            ebpf_assert(page[index].object == NULL || ebpf_fuzzing_enabled);
+        }
+        ebpf_free(page);
+        _ebpf_id_table_pages[page_index] = NULL;
     }
+    _ebpf_id_table_size = 0;
+    _ebpf_id_table_free_head = 0;
+    _ebpf_id_table_free_tail = 0;
 }
 
 _Must_inspect_result_ ebpf_result_t
@@ -237,12 +340,12 @@ _Requires_lock_held_(&_ebpf_object_tracking_list_lock) static ebpf_core_object_t
     ebpf_id_t start_id, ebpf_object_type_t object_type)
 {
     // The start_id need not exist, so we can't call _get_index_from_id().
-    uint32_t index = (start_id >> 16);
+    uint32_t index = (start_id >> EBPF_ID_GENERATION_BITS);
     if (_get_id_from_index(index) == start_id) {
         index++;
     }
-    while (index < EBPF_COUNT_OF(_ebpf_id_table)) {
-        ebpf_core_object_t* object = _ebpf_id_table[index].object;
+    while (index < _ebpf_id_table_size) {
+        ebpf_core_object_t* object = _get_entry_from_index(index)->object;
         if ((object != NULL) && (object->type == object_type)) {
             return object;
         }
@@ -287,28 +390,47 @@ ebpf_object_reference_next_object(
     ebpf_lock_unlock(&_ebpf_object_tracking_list_lock, state);
 }
 
+/**
+ * @brief Acquire a reference on an object unless its reference count already dropped to zero.
+ *
+ * @param[in, out] object Object to acquire a reference on.
+ * @retval true A reference was acquired.
+ * @retval false The object is being freed.
+ */
+static bool
+_ebpf_object_try_acquire_reference(_Inout_ ebpf_core_object_t* object)
+{
+    int32_t reference_count = object->base.reference_count;
+    while (reference_count > 0) {
+        int32_t old_reference_count = ebpf_interlocked_compare_exchange_int32(
+            &object->base.reference_count, reference_count + 1, reference_count);
+        if (old_reference_count == reference_count) {
+            return true;
+        }
+        reference_count = old_reference_count;
+    }
+    return false;
+}
+
 _Must_inspect_result_ ebpf_result_t
 ebpf_object_reference_by_id(ebpf_id_t id, ebpf_object_type_t object_type, _Outptr_ ebpf_core_object_t** object)
 {
-    ebpf_lock_state_t state = ebpf_lock_lock(&_ebpf_object_tracking_list_lock);
+    // This doesn't acquire _ebpf_object_tracking_list_lock. ID table pages are never freed while objects are
+    // tracked and objects are freed under epoch, so the entry and the object it points to can be read until the
+    // reference is acquired. An entry that is reused for another object is detected by comparing the object's ID.
+    ebpf_id_entry_t* entry = _get_entry_from_index(id >> EBPF_ID_GENERATION_BITS);
+    if (entry == NULL) {
+        return EBPF_KEY_NOT_FOUND;
+    }
 
-    uint32_t index;
-    ebpf_result_t return_value = _get_index_from_id(id, &index);
-    if (return_value == EBPF_SUCCESS) {
-        if (index >= EBPF_COUNT_OF(_ebpf_id_table)) {
-            return_value = EBPF_KEY_NOT_FOUND;
-        } else {
-            ebpf_core_object_t* found = _ebpf_id_table[index].object;
-            if ((found != NULL) && (found->type == object_type)) {
-                ebpf_object_acquire_reference(found);
-                *object = found;
-            } else
-                return_value = EBPF_KEY_NOT_FOUND;
-        }
+    ebpf_core_object_t* found = (ebpf_core_object_t*)ReadPointerAcquire((void* volatile*)&entry->object);
+    if ((found == NULL) || (found->id != id) || (found->type != object_type) ||
+        !_ebpf_object_try_acquire_reference(found)) {
+        return EBPF_KEY_NOT_FOUND;
     }
 
-    ebpf_lock_unlock(&_ebpf_object_tracking_list_lock, state);
-    return return_value;
+    *object = found;
+    return EBPF_SUCCESS;
 }
 
 _Must_inspect_result_ ebpf_result_t
@@ -319,7 +441,7 @@ ebpf_object_dereference_by_id(ebpf_id_t id, ebpf_object_type_t object_type)
     uint32_t index;
     ebpf_result_t return_value = _get_index_from_id(id, &index);
     if (return_value == EBPF_SUCCESS) {
-        ebpf_core_object_t* found = _ebpf_id_table[index].object;
+        ebpf_core_object_t* found = _get_entry_from_index(index)->object;
         if ((found != NULL) && (found->type == object_type)) {
             _ebpf_object_release_reference_under_lock(found);
         } else
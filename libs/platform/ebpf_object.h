@@ -125,7 +125,9 @@ extern "C"
 
     /**
      * @brief Find an ID in the ID table, verify the type matches,
-     *  acquire a reference to the object and return it.
+     *  acquire a reference to the object and return it. The lookup doesn't
+     *  acquire a lock, so the caller must be in an epoch and objects must be
+     *  freed under epoch.
      *
      * @param[in] id ID to find in table.
      * @param[in] object_type Object type to match.
@@ -1,39 +1,47 @@
 // Copyright (c) Microsoft Corporation
 // SPDX-License-Identifier: MIT
 
-// The pinning table stores ebpf_pinning_entry_t objects in an ebpf_hash_table_t, which is designed to store fixed
-// size keys and values. The pinning table uses ebpf_utf8_string_t as the key for this table, which is a variable
-// sized structure with embedded pointers. As a result, ebpf_utf8_string_t structures are not directly comparable.
-// To handle this case, the ebpf_hash_table_t exposes an extract method, that accepts a key and returns
-// a pointer to data that can be compared or hashed. The ebpf_hash_table_t is initialized to use ebpf_utf8_string_t*
-// as keys and ebpf_pinning_entry_t* as values.
-// Insertion - The key is a pointer to the ebpf_utf8_string_t embedded in the ebpf_pinning_entry_t and the value is
-// a pointer to the ebpf_pinning_entry_t object.
-// Find/Delete - The key is a pointer to an ebpf_utf8_string_t that contains the string to search for.
-// Find returns a pointer to the ebpf_pinning_entry_t object. Comparison is done based on the value pointed to by the
-// key. Delete erases the entry from the ebpf_hash_table_t, but doesn't free the memory associated with the
-// ebpf_pinning_entry_t.
+// The pinning table stores ebpf_pinning_entry_t objects in a trie keyed by path component. A path is split into
+// components that each end with a '/' or '\' separator, except for the last one which ends with the path. Each node
+// of the trie holds one component, an optional ebpf_pinning_entry_t whose path ends at that node and an array of
+// child nodes sorted by component. Components keep their separator, so every path maps to exactly one node and
+// a depth first walk of the trie visits the paths in byte-wise lexical order.
+// Find - Walks the trie one component at a time, using a binary search of the children of each node.
+// Enumeration - The paths that start with a given prefix are contiguous in lexical order, so enumerating a
+// directory or resuming an enumeration after a given path only visits the entries that are returned.
+// Delete - Removes the entry from its node and frees the nodes that no longer lead to any entry. The memory
+// associated with the ebpf_pinning_entry_t is freed after the lock is released.
 
 #include "ebpf_core_structs.h"
 #include "ebpf_object.h"
 #include "ebpf_pinning_table.h"
 
-#define EBPF_PINNING_TABLE_BUCKET_COUNT 64
+// Initial number of children of a node.
+#define EBPF_PINNING_NODE_INITIAL_CAPACITY 4
+
+// Maximum number of entries removed by ebpf_pinning_table_delete_prefix each time it acquires the lock.
+#define EBPF_PINNING_TABLE_DELETE_BATCH_SIZE 16
+
+typedef struct _ebpf_pinning_node ebpf_pinning_node_t;
+
+typedef struct _ebpf_pinning_node
+{
+    ebpf_pinning_node_t* parent;     // Parent node, or NULL for the root.
+    ebpf_pinning_entry_t* entry;     // Entry whose path ends at this node, or NULL.
+    ebpf_pinning_node_t** children;  // Child nodes, sorted by component.
+    uint32_t child_count;            // Number of child nodes.
+    uint32_t child_capacity;         // Number of child nodes that fit in children.
+    size_t component_length;         // Length of the component.
+    uint8_t component[1];            // Component, including the trailing separator if any.
+} ebpf_pinning_node_t;
 
 typedef struct _ebpf_pinning_table
 {
-    _Requires_lock_held_(&lock) ebpf_hash_table_t* hash_table;
+    _Requires_lock_held_(&lock) ebpf_pinning_node_t root;
+    _Requires_lock_held_(&lock) size_t entry_count;
     ebpf_lock_t lock;
 } ebpf_pinning_table_t;
 
-static void
-_ebpf_pinning_table_extract(_In_ const uint8_t* value, _Outptr_ const uint8_t** data, _Out_ size_t* length)
-{
-    const ebpf_utf8_string_t* key = *(ebpf_utf8_string_t**)value;
-    *data = key->value;
-    *length = key->length * 8;
-}
-
 static void
 _ebpf_pinning_entry_free(_Frees_ptr_opt_ ebpf_pinning_entry_t* pinning_entry)
 {
@@ -45,6 +53,240 @@ _ebpf_pinning_entry_free(_Frees_ptr_opt_ ebpf_pinning_entry_t* pinning_entry)
     ebpf_free(pinning_entry);
 }
 
+// Get the length of the component that starts at offset in path.
+static size_t
+_ebpf_pinning_path_component_length(_In_ const ebpf_utf8_string_t* path, size_t offset)
+{
+    size_t index;
+    for (index = offset; index < path->length; index++) {
+        if (path->value[index] == '/' || path->value[index] == '\\') {
+            return index + 1 - offset;
+        }
+    }
+    return path->length - offset;
+}
+
+static int
+_ebpf_pinning_compare(
+    _In_reads_(left_length) const uint8_t* left,
+    size_t left_length,
+    _In_reads_(right_length) const uint8_t* right,
+    size_t right_length)
+{
+    size_t length = min(left_length, right_length);
+    int result = (length == 0) ? 0 : memcmp(left, right, length);
+    if (result != 0) {
+        return result;
+    }
+    return (left_length < right_length) ? -1 : (left_length > right_length) ? 1 : 0;
+}
+
+// Find the child of node that holds a component. If there is no such child, *index is where it would be inserted.
+static bool
+_ebpf_pinning_node_find_child(
+    _In_ const ebpf_pinning_node_t* node,
+    _In_reads_(component_length) const uint8_t* component,
+    size_t component_length,
+    _Out_ uint32_t* index)
+{
+    uint32_t low = 0;
+    uint32_t high = node->child_count;
+    while (low < high) {
+        uint32_t middle = low + (high - low) / 2;
+        const ebpf_pinning_node_t* child = node->children[middle];
+        int result = _ebpf_pinning_compare(child->component, child->component_length, component, component_length);
+        if (result == 0) {
+            *index = middle;
+            return true;
+        } else if (result < 0) {
+            low = middle + 1;
+        } else {
+            high = middle;
+        }
+    }
+    *index = low;
+    return false;
+}
+
+// Get the index of a node in the children of its parent.
+static uint32_t
+_ebpf_pinning_node_get_index(_In_ const ebpf_pinning_node_t* node)
+{
+    uint32_t index;
+    bool found = _ebpf_pinning_node_find_child(node->parent, node->component, node->component_length, &index);
+    ebpf_assert(found);
+    UNREFERENCED_PARAMETER(found);
+    return index;
+}
+
+static _Must_inspect_result_ ebpf_result_t
+_ebpf_pinning_node_insert_child(
+    _Inout_ ebpf_pinning_node_t* node,
+    uint32_t index,
+    _In_reads_(component_length) const uint8_t* component,
+    size_t component_length,
+    _Outptr_ ebpf_pinning_node_t** child)
+{
+    if (node->child_count == node->child_capacity) {
+        uint32_t new_capacity =
+            (node->child_capacity == 0) ? EBPF_PINNING_NODE_INITIAL_CAPACITY : node->child_capacity * 2;
+        ebpf_pinning_node_t** new_children = ebpf_allocate(sizeof(ebpf_pinning_node_t*) * new_capacity);
+        if (new_children == NULL) {
+            return EBPF_NO_MEMORY;
+        }
+        if (node->child_count > 0) {
+            memcpy(new_children, node->children, sizeof(ebpf_pinning_node_t*) * node->child_count);
+        }
+        ebpf_free(node->children);
+        node->children = new_children;
+        node->child_capacity = new_capacity;
+    }
+
+    ebpf_pinning_node_t* new_node = ebpf_allocate(EBPF_OFFSET_OF(ebpf_pinning_node_t, component) + component_length);
+    if (new_node == NULL) {
+        return EBPF_NO_MEMORY;
+    }
+    new_node->parent = node;
+    new_node->component_length = component_length;
+    memcpy(new_node->component, component, component_length);
+
+    memmove(
+        &node->children[index + 1],
+        &node->children[index],
+        sizeof(ebpf_pinning_node_t*) * (node->child_count - index));
+    node->children[index] = new_node;
+    node->child_count++;
+    *child = new_node;
+    return EBPF_SUCCESS;
+}
+
+// Free node and any of its ancestors that no longer lead to an entry.
+static void
+_ebpf_pinning_node_prune(_Inout_ ebpf_pinning_node_t* node)
+{
+    while (node->parent != NULL && node->entry == NULL && node->child_count == 0) {
+        ebpf_pinning_node_t* parent = node->parent;
+        uint32_t index = _ebpf_pinning_node_get_index(node);
+        memmove(
+            &parent->children[index],
+            &parent->children[index + 1],
+            sizeof(ebpf_pinning_node_t*) * (parent->child_count - index - 1));
+        parent->child_count--;
+        ebpf_free(node->children);
+        ebpf_free(node);
+        node = parent;
+    }
+}
+
+// Find the node that holds a path, or NULL if there is none.
+static _Ret_maybenull_ ebpf_pinning_node_t*
+_ebpf_pinning_table_find_node(_In_ ebpf_pinning_table_t* pinning_table, _In_ const ebpf_utf8_string_t* path)
+{
+    ebpf_pinning_node_t* node = &pinning_table->root;
+    size_t offset = 0;
+    while (offset < path->length) {
+        size_t component_length = _ebpf_pinning_path_component_length(path, offset);
+        uint32_t index;
+        if (!_ebpf_pinning_node_find_child(node, path->value + offset, component_length, &index)) {
+            return NULL;
+        }
+        node = node->children[index];
+        offset += component_length;
+    }
+    return node;
+}
+
+// Get the first node with an entry in the subtree of node. Every node other than the root leads to an entry.
+static _Ret_maybenull_ ebpf_pinning_node_t*
+_ebpf_pinning_node_first(_In_ ebpf_pinning_node_t* node)
+{
+    while (node->entry == NULL) {
+        if (node->child_count == 0) {
+            return NULL;
+        }
+        node = node->children[0];
+    }
+    return node;
+}
+
+// Get the first node with an entry that follows the subtree of node.
+static _Ret_maybenull_ ebpf_pinning_node_t*
+_ebpf_pinning_node_next_sibling(_In_ ebpf_pinning_node_t* node)
+{
+    while (node->parent != NULL) {
+        uint32_t index = _ebpf_pinning_node_get_index(node);
+        if (index + 1 < node->parent->child_count) {
+            return _ebpf_pinning_node_first(node->parent->children[index + 1]);
+        }
+        node = node->parent;
+    }
+    return NULL;
+}
+
+// Get the first node with an entry that follows the entry of node.
+static _Ret_maybenull_ ebpf_pinning_node_t*
+_ebpf_pinning_node_next(_In_ ebpf_pinning_node_t* node)
+{
+    if (node->child_count > 0) {
+        return _ebpf_pinning_node_first(node->children[0]);
+    }
+    return _ebpf_pinning_node_next_sibling(node);
+}
+
+// Get the first node with an entry whose path is greater than path, or greater than or equal to it if inclusive.
+static _Ret_maybenull_ ebpf_pinning_node_t*
+_ebpf_pinning_table_seek(
+    _In_ ebpf_pinning_table_t* pinning_table, _In_ const ebpf_utf8_string_t* path, bool inclusive)
+{
+    ebpf_pinning_node_t* node = &pinning_table->root;
+    size_t offset = 0;
+    while (offset < path->length) {
+        size_t component_length = _ebpf_pinning_path_component_length(path, offset);
+        uint32_t index;
+        if (!_ebpf_pinning_node_find_child(node, path->value + offset, component_length, &index)) {
+            // Every path under the children that follow index is greater than path.
+            if (index < node->child_count) {
+                return _ebpf_pinning_node_first(node->children[index]);
+            }
+            return _ebpf_pinning_node_next_sibling(node);
+        }
+        node = node->children[index];
+        offset += component_length;
+    }
+
+    if (inclusive && node->entry != NULL) {
+        return node;
+    }
+    return _ebpf_pinning_node_next(node);
+}
+
+static bool
+_ebpf_pinning_path_has_prefix(_In_ const ebpf_utf8_string_t* path, _In_ const ebpf_utf8_string_t* prefix)
+{
+    return prefix->length == 0 ||
+           (path->length >= prefix->length && memcmp(path->value, prefix->value, prefix->length) == 0);
+}
+
+static bool
+_ebpf_pinning_entry_has_type(_In_ const ebpf_pinning_entry_t* entry, ebpf_object_type_t object_type)
+{
+    return object_type == EBPF_OBJECT_UNKNOWN || object_type == ebpf_object_get_type(entry->object);
+}
+
+// Detach the entry from a node and free the nodes that no longer lead to an entry.
+static _Ret_notnull_ ebpf_pinning_entry_t*
+_ebpf_pinning_node_detach_entry(_Inout_ ebpf_pinning_table_t* pinning_table, _Inout_ ebpf_pinning_node_t* node)
+{
+    ebpf_pinning_entry_t* entry = node->entry;
+    ebpf_assert(entry != NULL);
+    _Analysis_assume_(entry != NULL);
+    node->entry = NULL;
+    pinning_table->entry_count--;
+    _ebpf_pinning_node_prune(node);
+    ebpf_interlocked_decrement_int32(&entry->object->pinned_path_count);
+    return entry;
+}
+
 _Must_inspect_result_ ebpf_result_t
 ebpf_pinning_table_allocate(ebpf_pinning_table_t** pinning_table)
 {
@@ -60,29 +302,8 @@ ebpf_pinning_table_allocate(ebpf_pinning_table_t** pinning_table)
 
     ebpf_lock_create(&(*pinning_table)->lock);
 
-    const ebpf_hash_table_creation_options_t options = {
-        .key_size = sizeof(ebpf_utf8_string_t*),
-        .value_size = sizeof(ebpf_pinning_entry_t*),
-        .extract_function = _ebpf_pinning_table_extract,
-        .allocate = ebpf_allocate,
-        .free = ebpf_free,
-    };
-
-    return_value = ebpf_hash_table_create(&(*pinning_table)->hash_table, &options);
-
-    if (return_value != EBPF_SUCCESS)
-        goto Done;
-
     return_value = EBPF_SUCCESS;
 Done:
-    if (return_value != EBPF_SUCCESS) {
-        if ((*pinning_table))
-            ebpf_hash_table_destroy((*pinning_table)->hash_table);
-
-        ebpf_free(*pinning_table);
-        *pinning_table = NULL;
-    }
-
     EBPF_RETURN_RESULT(return_value);
 }
 
@@ -90,17 +311,13 @@ void
 ebpf_pinning_table_free(ebpf_pinning_table_t* pinning_table)
 {
     EBPF_LOG_ENTRY();
-    ebpf_result_t return_value;
-    ebpf_utf8_string_t* key = NULL;
-    if (pinning_table && pinning_table->hash_table) {
-        for (;;) {
-            return_value = ebpf_hash_table_next_key(pinning_table->hash_table, NULL, (uint8_t*)&key);
-            if (return_value != EBPF_SUCCESS) {
-                break;
-            }
-            ebpf_assert_success(ebpf_pinning_table_delete(pinning_table, key));
+    ebpf_pinning_node_t* node;
+    if (pinning_table) {
+        while ((node = _ebpf_pinning_node_first(&pinning_table->root)) != NULL) {
+            _ebpf_pinning_entry_free(_ebpf_pinning_node_detach_entry(pinning_table, node));
         }
-        ebpf_hash_table_destroy(pinning_table->hash_table);
+        ebpf_free(pinning_table->root.children);
+        ebpf_lock_destroy(&pinning_table->lock);
     }
 
     ebpf_free(pinning_table);
@@ -115,8 +332,9 @@ ebpf_pinning_table_insert(
     EBPF_LOG_ENTRY();
     ebpf_lock_state_t state;
     ebpf_result_t return_value;
-    ebpf_utf8_string_t* new_key;
     ebpf_pinning_entry_t* new_pinning_entry;
+    ebpf_pinning_node_t* node;
+    size_t offset;
 
     if (path->length >= EBPF_MAX_PIN_PATH_LENGTH || path->length == 0) {
         EBPF_RETURN_RESULT(EBPF_INVALID_ARGUMENT);
@@ -141,20 +359,38 @@ ebpf_pinning_table_insert(
 
     new_pinning_entry->object = object;
     ebpf_object_acquire_reference(object);
-    new_key = &new_pinning_entry->path;
 
     state = ebpf_lock_lock(&pinning_table->lock);
 
-    return_value = ebpf_hash_table_update(
-        pinning_table->hash_table,
-        (const uint8_t*)&new_key,
-        (const uint8_t*)&new_pinning_entry,
-        EBPF_HASH_TABLE_OPERATION_INSERT);
-    if (return_value == EBPF_KEY_ALREADY_EXISTS) {
-        return_value = EBPF_OBJECT_ALREADY_EXISTS;
-    } else if (return_value == EBPF_SUCCESS) {
-        new_pinning_entry = NULL;
-        ebpf_interlocked_increment_int32(&object->pinned_path_count);
+    // Find or create the node for each component of the path.
+    node = &pinning_table->root;
+    for (offset = 0; offset < path->length;) {
+        size_t component_length = _ebpf_pinning_path_component_length(path, offset);
+        uint32_t index;
+        if (_ebpf_pinning_node_find_child(node, path->value + offset, component_length, &index)) {
+            node = node->children[index];
+        } else {
+            return_value =
+                _ebpf_pinning_node_insert_child(node, index, path->value + offset, component_length, &node);
+            if (return_value != EBPF_SUCCESS) {
+                break;
+            }
+        }
+        offset += component_length;
+    }
+
+    if (return_value == EBPF_SUCCESS) {
+        if (node->entry != NULL) {
+            return_value = EBPF_OBJECT_ALREADY_EXISTS;
+        } else {
+            node->entry = new_pinning_entry;
+            new_pinning_entry = NULL;
+            pinning_table->entry_count++;
+            ebpf_interlocked_increment_int32(&object->pinned_path_count);
+        }
+    } else {
+        // Free the nodes created for this path.
+        _ebpf_pinning_node_prune(node);
     }
 
     ebpf_lock_unlock(&pinning_table->lock, state);
@@ -175,16 +411,16 @@ ebpf_pinning_table_find(
     EBPF_LOG_ENTRY();
     ebpf_lock_state_t state;
     ebpf_result_t return_value;
-    const ebpf_utf8_string_t* existing_key = path;
-    ebpf_pinning_entry_t** existing_pinning_entry;
+    ebpf_pinning_node_t* node;
 
     state = ebpf_lock_lock(&pinning_table->lock);
-    return_value = ebpf_hash_table_find(
-        pinning_table->hash_table, (const uint8_t*)&existing_key, (uint8_t**)&existing_pinning_entry);
-
-    if (return_value == EBPF_SUCCESS) {
-        *object = (*existing_pinning_entry)->object;
+    node = _ebpf_pinning_table_find_node(pinning_table, path);
+    if (node != NULL && node->entry != NULL) {
+        *object = node->entry->object;
         ebpf_object_acquire_reference(*object);
+        return_value = EBPF_SUCCESS;
+    } else {
+        return_value = EBPF_KEY_NOT_FOUND;
     }
 
     ebpf_lock_unlock(&pinning_table->lock, state);
@@ -198,20 +434,16 @@ ebpf_pinning_table_delete(ebpf_pinning_table_t* pinning_table, const ebpf_utf8_s
     EBPF_LOG_ENTRY();
     ebpf_lock_state_t state;
     ebpf_result_t return_value;
-    const ebpf_utf8_string_t* existing_key = path;
-    ebpf_pinning_entry_t** existing_pinning_entry;
+    ebpf_pinning_node_t* node;
     ebpf_pinning_entry_t* entry = NULL;
 
     state = ebpf_lock_lock(&pinning_table->lock);
-    return_value = ebpf_hash_table_find(
-        pinning_table->hash_table, (const uint8_t*)&existing_key, (uint8_t**)&existing_pinning_entry);
-    if (return_value == EBPF_SUCCESS) {
-        entry = *existing_pinning_entry;
-        return_value = ebpf_hash_table_delete(pinning_table->hash_table, (const uint8_t*)&existing_key);
-        // If unable to remove the entry from the table, don't delete it.
-        if (return_value != EBPF_SUCCESS) {
-            entry = NULL;
-        }
+    node = _ebpf_pinning_table_find_node(pinning_table, path);
+    if (node != NULL && node->entry != NULL) {
+        entry = _ebpf_pinning_node_detach_entry(pinning_table, node);
+        return_value = EBPF_SUCCESS;
+    } else {
+        return_value = EBPF_KEY_NOT_FOUND;
     }
     ebpf_lock_unlock(&pinning_table->lock, state);
 
@@ -219,39 +451,88 @@ ebpf_pinning_table_delete(ebpf_pinning_table_t* pinning_table, const ebpf_utf8_s
     if (return_value == EBPF_SUCCESS)
         EBPF_LOG_MESSAGE_UTF8_STRING(EBPF_TRACELOG_LEVEL_VERBOSE, EBPF_TRACELOG_KEYWORD_BASE, "Unpinned object", *path);
 
-    if (entry != NULL) {
-        ebpf_interlocked_decrement_int32(&entry->object->pinned_path_count);
-        _ebpf_pinning_entry_free(entry);
-    }
+    _ebpf_pinning_entry_free(entry);
 
     EBPF_RETURN_RESULT(return_value);
 }
 
+_Must_inspect_result_ ebpf_result_t
+ebpf_pinning_table_delete_prefix(
+    _Inout_ ebpf_pinning_table_t* pinning_table, _In_ const ebpf_utf8_string_t* prefix, _Out_ uint32_t* entry_count)
+{
+    EBPF_LOG_ENTRY();
+    ebpf_pinning_entry_t* entries[EBPF_PINNING_TABLE_DELETE_BATCH_SIZE];
+    uint32_t batch_count;
+    uint32_t total_count = 0;
+
+    if (prefix->length == 0) {
+        EBPF_RETURN_RESULT(EBPF_INVALID_ARGUMENT);
+    }
+
+    // Remove the entries in batches to bound the time spent holding the lock, and release the references on the
+    // objects after the lock is released.
+    do {
+        batch_count = 0;
+        ebpf_lock_state_t state = ebpf_lock_lock(&pinning_table->lock);
+        ebpf_pinning_node_t* node = _ebpf_pinning_table_seek(pinning_table, prefix, true);
+        while (node != NULL && batch_count < EBPF_PINNING_TABLE_DELETE_BATCH_SIZE &&
+               _ebpf_pinning_path_has_prefix(&node->entry->path, prefix)) {
+            ebpf_pinning_node_t* next_node = _ebpf_pinning_node_next(node);
+            entries[batch_count++] = _ebpf_pinning_node_detach_entry(pinning_table, node);
+            node = next_node;
+        }
+        ebpf_lock_unlock(&pinning_table->lock, state);
+
+        for (uint32_t index = 0; index < batch_count; index++) {
+            EBPF_LOG_MESSAGE_UTF8_STRING(
+                EBPF_TRACELOG_LEVEL_VERBOSE, EBPF_TRACELOG_KEYWORD_BASE, "Unpinned object", entries[index]->path);
+            _ebpf_pinning_entry_free(entries[index]);
+        }
+        total_count += batch_count;
+    } while (batch_count == EBPF_PINNING_TABLE_DELETE_BATCH_SIZE);
+
+    *entry_count = total_count;
+    EBPF_RETURN_RESULT(EBPF_SUCCESS);
+}
+
 _Must_inspect_result_ ebpf_result_t
 ebpf_pinning_table_enumerate_entries(
     _Inout_ ebpf_pinning_table_t* pinning_table,
     ebpf_object_type_t object_type,
     _Out_ uint16_t* entry_count,
     _Outptr_result_buffer_maybenull_(*entry_count) ebpf_pinning_entry_t** pinning_entries)
+{
+    EBPF_LOG_ENTRY();
+    const ebpf_utf8_string_t empty_path = {NULL, 0};
+    EBPF_RETURN_RESULT(ebpf_pinning_table_enumerate_prefix(
+        pinning_table, object_type, &empty_path, &empty_path, UINT16_MAX, entry_count, pinning_entries));
+}
+
+_Must_inspect_result_ ebpf_result_t
+ebpf_pinning_table_enumerate_prefix(
+    _Inout_ ebpf_pinning_table_t* pinning_table,
+    ebpf_object_type_t object_type,
+    _In_ const ebpf_utf8_string_t* prefix,
+    _In_ const ebpf_utf8_string_t* start_path,
+    uint16_t max_entry_count,
+    _Out_ uint16_t* entry_count,
+    _Outptr_result_buffer_maybenull_(*entry_count) ebpf_pinning_entry_t** pinning_entries)
 {
     EBPF_LOG_ENTRY();
     ebpf_result_t result = EBPF_SUCCESS;
     ebpf_lock_state_t state = 0;
-    bool lock_held = FALSE;
     uint16_t local_entry_count = 0;
     uint16_t entries_array_length = 0;
     ebpf_pinning_entry_t* local_pinning_entries = NULL;
-    ebpf_utf8_string_t* next_object_path;
-    ebpf_pinning_entry_t* new_entry = NULL;
+    ebpf_pinning_node_t* node;
 
     ebpf_assert(entry_count);
     ebpf_assert(pinning_entries);
 
     state = ebpf_lock_lock(&pinning_table->lock);
-    lock_held = TRUE;
 
-    // Get output array length by finding how many entries are there in the pinning table.
-    entries_array_length = (uint16_t)ebpf_hash_table_key_count(pinning_table->hash_table);
+    // Get output array length from the number of entries in the pinning table.
+    entries_array_length = (uint16_t)min(max_entry_count, pinning_table->entry_count);
 
     // Exit if there are no entries.
     if (entries_array_length == 0)
@@ -264,54 +545,47 @@ ebpf_pinning_table_enumerate_entries(
         goto Exit;
     }
 
-    // Loop through the entries in the hashtable.
-    next_object_path = NULL;
-    for (;;) {
-        ebpf_pinning_entry_t** next_pinning_entry = NULL;
+    // Paths that start with the prefix follow the prefix and are contiguous, so resume after start_path only if it
+    // isn't before them.
+    if (start_path->length > 0 &&
+        _ebpf_pinning_compare(start_path->value, start_path->length, prefix->value, prefix->length) >= 0) {
+        node = _ebpf_pinning_table_seek(pinning_table, start_path, false);
+    } else {
+        node = _ebpf_pinning_table_seek(pinning_table, prefix, true);
+    }
 
-        // Find next pinning entry, if any.
-        result = ebpf_hash_table_next_key_and_value(
-            pinning_table->hash_table,
-            (const uint8_t*)((next_object_path == NULL) ? NULL : &next_object_path),
-            (uint8_t*)&next_object_path,
-            (uint8_t**)&next_pinning_entry);
+    for (; node != NULL && local_entry_count < entries_array_length; node = _ebpf_pinning_node_next(node)) {
+        ebpf_pinning_entry_t* next_pinning_entry = node->entry;
 
-        if (result == EBPF_NO_MORE_KEYS) {
-            // Reached end of hashtable.
-            result = EBPF_SUCCESS;
+        // Stop at the first path that doesn't start with the prefix.
+        if (!_ebpf_pinning_path_has_prefix(&next_pinning_entry->path, prefix)) {
             break;
         }
 
-        if (result != EBPF_SUCCESS)
-            goto Exit;
-
         // Skip entries that don't match the input object type.
-        if (object_type != ebpf_object_get_type((*next_pinning_entry)->object)) {
+        if (!_ebpf_pinning_entry_has_type(next_pinning_entry, object_type)) {
             continue;
         }
 
         local_entry_count++;
-        ebpf_assert(local_entry_count <= entries_array_length);
 
         // Copy the next pinning entry to a new entry in the output array.
-        new_entry = &local_pinning_entries[local_entry_count - 1];
-        new_entry->object = (*next_pinning_entry)->object;
+        ebpf_pinning_entry_t* new_entry = &local_pinning_entries[local_entry_count - 1];
+        new_entry->object = next_pinning_entry->object;
 
         // Take reference on underlying ebpf_object.
         ebpf_object_acquire_reference(new_entry->object);
 
         // Duplicate pinning object path.
-        result = ebpf_duplicate_utf8_string(&new_entry->path, &(*next_pinning_entry)->path);
+        result = ebpf_duplicate_utf8_string(&new_entry->path, &next_pinning_entry->path);
         if (result != EBPF_SUCCESS)
             goto Exit;
     }
 
 Exit:
-    // Release lock if held.
-    if (lock_held)
-        ebpf_lock_unlock(&pinning_table->lock, state);
+    ebpf_lock_unlock(&pinning_table->lock, state);
 
-    if (result != EBPF_SUCCESS) {
+    if (result != EBPF_SUCCESS || local_entry_count == 0) {
         ebpf_pinning_entries_release(local_entry_count, local_pinning_entries);
         local_entry_count = 0;
         local_pinning_entries = NULL;
@@ -336,34 +610,24 @@ ebpf_pinning_table_get_next_path(
         EBPF_RETURN_RESULT(EBPF_INVALID_ARGUMENT);
     }
 
-    const uint8_t* previous_key = (start_path->length == 0) ? NULL : (const uint8_t*)&start_path;
-
     ebpf_lock_state_t state = ebpf_lock_lock(&pinning_table->lock);
 
     ebpf_result_t result;
-    ebpf_pinning_entry_t** next_pinning_entry = NULL;
-
-    for (;;) {
-        // Get the next entry in the table.
-        ebpf_utf8_string_t* next_object_path;
-        result = ebpf_hash_table_next_key_and_value(
-            pinning_table->hash_table, previous_key, (uint8_t*)&next_object_path, (uint8_t**)&next_pinning_entry);
-        if (result != EBPF_SUCCESS) {
-            break;
-        }
+    ebpf_pinning_node_t* node = _ebpf_pinning_table_seek(pinning_table, start_path, false);
 
-        // See if the entry matches the object type the caller is interested in.
-        if (object_type == ebpf_object_get_type((*next_pinning_entry)->object)) {
-            if (next_path->length < (*next_pinning_entry)->path.length) {
-                result = EBPF_INSUFFICIENT_BUFFER;
-            } else {
-                next_path->length = (*next_pinning_entry)->path.length;
-                memcpy(next_path->value, (*next_pinning_entry)->path.value, next_path->length);
-                result = EBPF_SUCCESS;
-            }
-            break;
-        }
-        previous_key = (uint8_t*)&next_object_path;
+    // Find the next entry that matches the object type the caller is interested in.
+    while (node != NULL && !_ebpf_pinning_entry_has_type(node->entry, object_type)) {
+        node = _ebpf_pinning_node_next(node);
+    }
+
+    if (node == NULL) {
+        result = EBPF_NO_MORE_KEYS;
+    } else if (next_path->length < node->entry->path.length) {
+        result = EBPF_INSUFFICIENT_BUFFER;
+    } else {
+        next_path->length = node->entry->path.length;
+        memcpy(next_path->value, node->entry->path.value, next_path->length);
+        result = EBPF_SUCCESS;
     }
 
     ebpf_lock_unlock(&pinning_table->lock, state);
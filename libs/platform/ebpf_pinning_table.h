@@ -48,6 +48,10 @@ extern "C"
      * @param[in] path Path to associate with this entry.
      * @param[in] object Ebpf object to associate with this entry.
      * @retval EBPF_SUCCESS The operation was successful.
+     * @retval EBPF_INVALID_ARGUMENT The path is empty, too long or contains
+     *  a null character.
+     * @retval EBPF_OBJECT_ALREADY_EXISTS The path is already present in the
+     *  pinning table.
      * @retval EBPF_NO_MEMORY Unable to allocate resources for this
      *  entry.
      */
@@ -63,7 +67,7 @@ extern "C"
      * @param[in] path Path to find in the pinning table.
      * @param[out] object Pointer to memory that contains the object on success.
      * @retval EBPF_SUCCESS The operation was successful.
-     * @retval EBPF_OBJECT_NOT_FOUND The path is not present in the pinning
+     * @retval EBPF_KEY_NOT_FOUND The path is not present in the pinning
      *  table.
      */
     _Must_inspect_result_ ebpf_result_t
@@ -77,12 +81,29 @@ extern "C"
      * @param[in] pinning_table Pinning table to update.
      * @param[in] path Path to find in the pinning table.
      * @retval EBPF_SUCCESS The operation was successful.
-     * @retval EBPF_OBJECT_NOT_FOUND The path is not present in the pinning
+     * @retval EBPF_KEY_NOT_FOUND The path is not present in the pinning
      *  table.
      */
     _Must_inspect_result_ ebpf_result_t
     ebpf_pinning_table_delete(ebpf_pinning_table_t* pinning_table, const ebpf_utf8_string_t* path);
 
+    /**
+     * @brief Remove all entries whose path starts with a given prefix and
+     *  release a reference on the objects associated with them. To remove a
+     *  directory, the prefix must end with a separator.
+     *
+     * @param[in, out] pinning_table Pinning table to update.
+     * @param[in] prefix Prefix of the paths to remove.
+     * @param[out] entry_count Number of entries removed.
+     * @retval EBPF_SUCCESS The operation was successful.
+     * @retval EBPF_INVALID_ARGUMENT The prefix is empty.
+     */
+    _Must_inspect_result_ ebpf_result_t
+    ebpf_pinning_table_delete_prefix(
+        _Inout_ ebpf_pinning_table_t* pinning_table,
+        _In_ const ebpf_utf8_string_t* prefix,
+        _Out_ uint32_t* entry_count);
+
     /**
      * @brief Returns all entries in the pinning table of specified object type after acquiring a reference.
      *
@@ -102,7 +123,37 @@ extern "C"
         _Outptr_result_buffer_maybenull_(*entry_count) ebpf_pinning_entry_t** pinning_entries);
 
     /**
-     * @brief Gets the next path in the pinning table after a given path.
+     * @brief Returns the entries in the pinning table of specified object type
+     *  whose path starts with a given prefix and follows a given path, in
+     *  lexical order of path, after acquiring a reference.
+     *
+     * @param[in, out] pinning_table Pinning table to enumerate.
+     * @param[in] object_type eBPF object type that will be used to filter
+     *  pinning entries, or EBPF_OBJECT_UNKNOWN to return all entries.
+     * @param[in] prefix Prefix of the paths to return. An empty prefix
+     *  matches all paths.
+     * @param[in] start_path Path to look for entries greater than. An empty
+     *  path starts from the first entry.
+     * @param[in] max_entry_count Maximum number of entries to return.
+     * @param[out] entry_count Number of pinning entries being returned.
+     * @param[out] pinning_entries Array of pinning entries being returned.
+     *  Must be freed by caller using ebpf_pinning_entries_release().
+     * @retval EBPF_SUCCESS The operation was successful.
+     * @retval EBPF_NO_MEMORY Output array of entries could not be allocated.
+     */
+    _Must_inspect_result_ ebpf_result_t
+    ebpf_pinning_table_enumerate_prefix(
+        _Inout_ ebpf_pinning_table_t* pinning_table,
+        ebpf_object_type_t object_type,
+        _In_ const ebpf_utf8_string_t* prefix,
+        _In_ const ebpf_utf8_string_t* start_path,
+        uint16_t max_entry_count,
+        _Out_ uint16_t* entry_count,
+        _Outptr_result_buffer_maybenull_(*entry_count) ebpf_pinning_entry_t** pinning_entries);
+
+    /**
+     * @brief Gets the next path in the pinning table after a given path, in
+     *  lexical order of path.
      *
      * @param[in, out] pinning_table Pinning table to enumerate.
      * @param[in] object_type Object type.
@@ -119,7 +170,8 @@ extern "C"
         _Inout_ ebpf_utf8_string_t* next_path);
 
     /**
-     * @brief Releases entries returned by ebpf_pinning_table_enumerate_entries.
+     * @brief Releases entries returned by ebpf_pinning_table_enumerate_entries
+     *  or ebpf_pinning_table_enumerate_prefix.
      * @param[in] entry_count Length of input array of entries.
      * @param[in] pinning_entries Array of entries to be released.
      */
@@ -272,6 +272,42 @@ extern "C"
     _Ret_maybenull_ void*
     ebpf_ring_map_readonly_user(_In_ const ebpf_ring_descriptor_t* ring);
 
+    typedef struct _ebpf_user_mapping ebpf_user_mapping_t;
+
+    /**
+     * @brief Create a read-write mapping in the calling process of memory
+     * allocated via ebpf_map_memory.
+     *
+     * @param[in] memory_descriptor Pointer to an ebpf_memory_descriptor_t
+     * describing allocated pages.
+     * @param[out] user_mapping Pointer to memory that will contain the
+     *  mapping on success.
+     * @retval EBPF_SUCCESS The operation was successful.
+     * @retval EBPF_NO_MEMORY Unable to map the pages into the calling process.
+     */
+    _Must_inspect_result_ ebpf_result_t
+    ebpf_map_memory_user(_In_ ebpf_memory_descriptor_t* memory_descriptor, _Outptr_ ebpf_user_mapping_t** user_mapping);
+
+    /**
+     * @brief Get the address of a mapping created via ebpf_map_memory_user
+     * in the process it was created in.
+     *
+     * @param[in] user_mapping Mapping to query.
+     * @return User address of the mapped pages.
+     */
+    void*
+    ebpf_user_mapping_get_address(_In_ const ebpf_user_mapping_t* user_mapping);
+
+    /**
+     * @brief Remove a mapping created via ebpf_map_memory_user from the
+     * process it was created in. This can be called from any process, and
+     * must be called before the pages are released via ebpf_unmap_memory.
+     *
+     * @param[in] user_mapping Mapping to remove.
+     */
+    void
+    ebpf_unmap_memory_user(_Frees_ptr_opt_ ebpf_user_mapping_t* user_mapping);
+
     /**
      * @brief Allocate and copy a UTF-8 string.
      *
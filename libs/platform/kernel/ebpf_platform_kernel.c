@@ -297,6 +297,83 @@ ebpf_ring_map_readonly_user(_In_ const ebpf_ring_descriptor_t* ring)
         return NULL;
     }
 }
+
+struct _ebpf_user_mapping
+{
+    MDL* memory_descriptor_list;
+    PEPROCESS process;
+    void* address;
+};
+
+_Must_inspect_result_ ebpf_result_t
+ebpf_map_memory_user(_In_ ebpf_memory_descriptor_t* memory_descriptor, _Outptr_ ebpf_user_mapping_t** user_mapping)
+{
+    EBPF_LOG_ENTRY();
+    ebpf_user_mapping_t* local_user_mapping = ebpf_allocate(sizeof(ebpf_user_mapping_t));
+    if (!local_user_mapping) {
+        EBPF_RETURN_RESULT(EBPF_NO_MEMORY);
+    }
+
+    local_user_mapping->memory_descriptor_list = &memory_descriptor->memory_descriptor_list;
+    __try {
+        local_user_mapping->address = MmMapLockedPagesSpecifyCache(
+            local_user_mapping->memory_descriptor_list,
+            UserMode,
+            MmCached,
+            NULL,
+            FALSE,
+            NormalPagePriority | MdlMappingNoExecute);
+    } __except (EXCEPTION_EXECUTE_HANDLER) {
+        local_user_mapping->address = NULL;
+    }
+    if (!local_user_mapping->address) {
+        EBPF_LOG_NTSTATUS_API_FAILURE(EBPF_TRACELOG_KEYWORD_BASE, MmMapLockedPagesSpecifyCache, STATUS_NO_MEMORY);
+        ebpf_free(local_user_mapping);
+        EBPF_RETURN_RESULT(EBPF_NO_MEMORY);
+    }
+
+    // The mapping can only be removed in the context of this process.
+    local_user_mapping->process = PsGetCurrentProcess();
+    ObReferenceObject(local_user_mapping->process);
+
+    *user_mapping = local_user_mapping;
+    EBPF_RETURN_RESULT(EBPF_SUCCESS);
+}
+
+void*
+ebpf_user_mapping_get_address(_In_ const ebpf_user_mapping_t* user_mapping)
+{
+    return user_mapping->address;
+}
+
+void
+ebpf_unmap_memory_user(_Frees_ptr_opt_ ebpf_user_mapping_t* user_mapping)
+{
+    EBPF_LOG_ENTRY();
+    if (!user_mapping) {
+        EBPF_RETURN_VOID();
+    }
+
+    if (PsGetCurrentProcess() == user_mapping->process) {
+        MmUnmapLockedPages(user_mapping->address, user_mapping->memory_descriptor_list);
+    } else {
+        // The last reference can be released by another process that was given a duplicate handle. The memory
+        // manager removes the mapping itself when the process exits, so only attach to a process that hasn't
+        // terminated.
+        LARGE_INTEGER timeout = {0};
+        if (KeWaitForSingleObject(user_mapping->process, Executive, KernelMode, FALSE, &timeout) == STATUS_TIMEOUT) {
+            KAPC_STATE apc_state;
+            KeStackAttachProcess(user_mapping->process, &apc_state);
+            MmUnmapLockedPages(user_mapping->address, user_mapping->memory_descriptor_list);
+            KeUnstackDetachProcess(&apc_state);
+        }
+    }
+
+    ObDereferenceObject(user_mapping->process);
+    ebpf_free(user_mapping);
+    EBPF_RETURN_VOID();
+}
+
 // There isn't an official API to query this information from kernel.
 // Use NtQuerySystemInformation with struct + header from winternl.h.
 
@@ -6,9 +6,11 @@
 #include <winsock2.h>
 #include <Windows.h>
 
+#include <atomic>
 #include <chrono>
 #include <condition_variable>
 #include <mutex>
+#include <set>
 #include <thread>
 #include <sddl.h>
 
@@ -17,6 +19,7 @@
 #include "ebpf_async.h"
 #include "ebpf_bitmap.h"
 #include "ebpf_epoch.h"
+#include "ebpf_handle.h"
 #include "ebpf_nethooks.h"
 #include "ebpf_platform.h"
 #include "ebpf_pinning_table.h"
@@ -53,9 +56,9 @@ class _test_helper
             ebpf_epoch_flush();
             ebpf_epoch_terminate();
         }
+        ebpf_object_tracking_terminate();
         if (platform_initiated)
             ebpf_platform_terminate();
-        ebpf_object_tracking_terminate();
     }
 
   private:
@@ -301,6 +304,197 @@ TEST_CASE("pinning_test", "[platform]")
     ebpf_object_release_reference(&another_object.object);
 }
 
+TEST_CASE("pinning_test_prefix", "[platform]")
+{
+    _test_helper test_helper;
+
+    ebpf_core_object_t map_object{};
+    ebpf_core_object_t program_object{};
+    REQUIRE(ebpf_object_initialize(&map_object, EBPF_OBJECT_MAP, [](ebpf_core_object_t*) {}, NULL) == EBPF_SUCCESS);
+    REQUIRE(
+        ebpf_object_initialize(&program_object, EBPF_OBJECT_PROGRAM, [](ebpf_core_object_t*) {}, NULL) ==
+        EBPF_SUCCESS);
+
+    ebpf_pinning_table_t* pinning_table = nullptr;
+    REQUIRE(ebpf_pinning_table_allocate(&pinning_table) == EBPF_SUCCESS);
+
+    // Insert the paths out of order, the table returns them in lexical order.
+    std::vector<std::string> paths = {
+        "/tenant1/maps/b",
+        "/tenant10/maps/a",
+        "/tenant1/maps/a",
+        "/tenant1",
+        "/tenant1/programs/a",
+        "tenant2\\maps\\a"};
+    for (const auto& path : paths) {
+        ebpf_utf8_string_t utf8_path = {(uint8_t*)path.data(), path.size()};
+        ebpf_core_object_t* object = (path.find("programs") != std::string::npos) ? &program_object : &map_object;
+        REQUIRE(ebpf_pinning_table_insert(pinning_table, &utf8_path, object) == EBPF_SUCCESS);
+    }
+    ebpf_utf8_string_t duplicate_path = {(uint8_t*)paths[0].data(), paths[0].size()};
+    REQUIRE(ebpf_pinning_table_insert(pinning_table, &duplicate_path, &map_object) == EBPF_OBJECT_ALREADY_EXISTS);
+    REQUIRE(map_object.pinned_path_count == 5);
+
+    // Walk all maps with get_next_path.
+    std::vector<std::string> map_paths;
+    std::string start_path;
+    for (;;) {
+        uint8_t buffer[EBPF_MAX_PIN_PATH_LENGTH];
+        ebpf_utf8_string_t utf8_start_path = {(uint8_t*)start_path.data(), start_path.size()};
+        ebpf_utf8_string_t next_path = {buffer, sizeof(buffer)};
+        ebpf_result_t result =
+            ebpf_pinning_table_get_next_path(pinning_table, EBPF_OBJECT_MAP, &utf8_start_path, &next_path);
+        if (result == EBPF_NO_MORE_KEYS) {
+            break;
+        }
+        REQUIRE(result == EBPF_SUCCESS);
+        start_path.assign((char*)next_path.value, next_path.length);
+        map_paths.push_back(start_path);
+    }
+    REQUIRE(
+        map_paths ==
+        std::vector<std::string>{
+            "/tenant1", "/tenant1/maps/a", "/tenant1/maps/b", "/tenant10/maps/a", "tenant2\\maps\\a"});
+
+    // Page through a directory one entry at a time.
+    ebpf_utf8_string_t prefix = EBPF_UTF8_STRING_FROM_CONST_STRING("/tenant1/");
+    std::vector<std::string> directory_paths;
+    start_path.clear();
+    for (;;) {
+        uint16_t entry_count;
+        ebpf_pinning_entry_t* entries;
+        ebpf_utf8_string_t utf8_start_path = {(uint8_t*)start_path.data(), start_path.size()};
+        REQUIRE(
+            ebpf_pinning_table_enumerate_prefix(
+                pinning_table, EBPF_OBJECT_UNKNOWN, &prefix, &utf8_start_path, 1, &entry_count, &entries) ==
+            EBPF_SUCCESS);
+        if (entry_count == 0) {
+            break;
+        }
+        REQUIRE(entry_count == 1);
+        start_path.assign((char*)entries[0].path.value, entries[0].path.length);
+        directory_paths.push_back(start_path);
+        ebpf_pinning_entries_release(entry_count, entries);
+    }
+    REQUIRE(directory_paths == std::vector<std::string>{"/tenant1/maps/a", "/tenant1/maps/b", "/tenant1/programs/a"});
+
+    // Remove the directory, which leaves the other tenants and the path equal to the directory name.
+    uint32_t deleted_count;
+    REQUIRE(ebpf_pinning_table_delete_prefix(pinning_table, &prefix, &deleted_count) == EBPF_SUCCESS);
+    REQUIRE(deleted_count == 3);
+    REQUIRE(map_object.pinned_path_count == 3);
+    REQUIRE(program_object.pinned_path_count == 0);
+    REQUIRE(program_object.base.reference_count == 1);
+
+    uint16_t entry_count;
+    ebpf_pinning_entry_t* entries;
+    REQUIRE(
+        ebpf_pinning_table_enumerate_entries(pinning_table, EBPF_OBJECT_MAP, &entry_count, &entries) == EBPF_SUCCESS);
+    REQUIRE(entry_count == 3);
+    ebpf_pinning_entries_release(entry_count, entries);
+
+    ebpf_utf8_string_t empty_prefix = {nullptr, 0};
+    REQUIRE(ebpf_pinning_table_delete_prefix(pinning_table, &empty_prefix, &deleted_count) == EBPF_INVALID_ARGUMENT);
+
+    ebpf_pinning_table_free(pinning_table);
+    REQUIRE(map_object.base.reference_count == 1);
+
+    ebpf_object_release_reference(&map_object);
+    ebpf_object_release_reference(&program_object);
+}
+
+TEST_CASE("object_id_table_test", "[platform]")
+{
+    _test_helper test_helper;
+
+    // More objects than fit in one page of the ID table.
+    const size_t object_count = 5000;
+    std::vector<ebpf_core_object_t> objects(object_count);
+    std::set<ebpf_id_t> ids;
+
+    for (auto& object : objects) {
+        REQUIRE(
+            ebpf_object_initialize(
+                &object, EBPF_OBJECT_MAP, [](ebpf_core_object_t*) {}, NULL) == EBPF_SUCCESS);
+        REQUIRE(object.id != 0);
+        REQUIRE(object.id != EBPF_ID_NONE);
+        ids.insert(object.id);
+    }
+    REQUIRE(ids.size() == object_count);
+
+    // IDs are enumerated in order.
+    ebpf_id_t id = 0;
+    for (ebpf_id_t expected_id : ids) {
+        REQUIRE(ebpf_object_get_next_id(id, EBPF_OBJECT_MAP, &id) == EBPF_SUCCESS);
+        REQUIRE(id == expected_id);
+    }
+    REQUIRE(ebpf_object_get_next_id(id, EBPF_OBJECT_MAP, &id) == EBPF_NO_MORE_KEYS);
+
+    REQUIRE(ebpf_epoch_enter() == EBPF_SUCCESS);
+    ebpf_core_object_t* found = nullptr;
+    REQUIRE(ebpf_object_reference_by_id(objects[4321].id, EBPF_OBJECT_MAP, &found) == EBPF_SUCCESS);
+    REQUIRE(found == &objects[4321]);
+    ebpf_object_release_reference(found);
+    REQUIRE(ebpf_object_reference_by_id(objects[4321].id, EBPF_OBJECT_PROGRAM, &found) == EBPF_KEY_NOT_FOUND);
+
+    // A freed object's ID is not found and is not reused by the next object.
+    ebpf_id_t freed_id = objects[0].id;
+    ebpf_object_release_reference(&objects[0]);
+    REQUIRE(ebpf_object_reference_by_id(freed_id, EBPF_OBJECT_MAP, &found) == EBPF_KEY_NOT_FOUND);
+    REQUIRE(
+        ebpf_object_initialize(
+            &objects[0], EBPF_OBJECT_MAP, [](ebpf_core_object_t*) {}, NULL) == EBPF_SUCCESS);
+    REQUIRE(objects[0].id != freed_id);
+    ebpf_epoch_exit();
+
+    for (auto& object : objects) {
+        ebpf_object_release_reference(&object);
+    }
+}
+
+TEST_CASE("handle_table_test", "[platform]")
+{
+    _test_helper test_helper;
+    REQUIRE(ebpf_handle_table_initiate() == EBPF_SUCCESS);
+
+    ebpf_core_object_t object{};
+    REQUIRE(
+        ebpf_object_initialize(
+            &object, EBPF_OBJECT_MAP, [](ebpf_core_object_t*) {}, NULL) == EBPF_SUCCESS);
+
+    // More handles than fit in one page of the handle table.
+    const size_t handle_count = 5000;
+    std::vector<ebpf_handle_t> handles(handle_count);
+    for (auto& handle : handles) {
+        REQUIRE(ebpf_handle_create(&handle, &object.base) == EBPF_SUCCESS);
+    }
+    REQUIRE(std::set<ebpf_handle_t>(handles.begin(), handles.end()).size() == handle_count);
+    REQUIRE(object.base.reference_count == static_cast<int32_t>(handle_count + 1));
+
+    ebpf_core_object_t* found = nullptr;
+    REQUIRE(ebpf_object_reference_by_handle(handles[4321], EBPF_OBJECT_MAP, &found) == EBPF_SUCCESS);
+    REQUIRE(found == &object);
+    ebpf_object_release_reference(found);
+    REQUIRE(ebpf_object_reference_by_handle(handles[4321], EBPF_OBJECT_PROGRAM, &found) == EBPF_INVALID_OBJECT);
+
+    // A closed handle is invalid until it is reused.
+    REQUIRE(ebpf_handle_close(handles[0]) == EBPF_SUCCESS);
+    REQUIRE(ebpf_handle_close(handles[0]) == EBPF_INVALID_OBJECT);
+    REQUIRE(ebpf_object_reference_by_handle(handles[0], EBPF_OBJECT_MAP, &found) == EBPF_INVALID_OBJECT);
+    REQUIRE(ebpf_handle_create(&handles[0], &object.base) == EBPF_SUCCESS);
+
+    REQUIRE(ebpf_handle_close(ebpf_handle_invalid) == EBPF_INVALID_OBJECT);
+    REQUIRE(ebpf_object_reference_by_handle(ebpf_handle_invalid, EBPF_OBJECT_MAP, &found) == EBPF_INVALID_OBJECT);
+
+    for (auto& handle : handles) {
+        REQUIRE(ebpf_handle_close(handle) == EBPF_SUCCESS);
+    }
+    REQUIRE(object.base.reference_count == 1);
+
+    ebpf_handle_table_terminate();
+    ebpf_object_release_reference(&object);
+}
+
 TEST_CASE("epoch_test_single_epoch", "[platform]")
 {
     _test_helper test_helper;
@@ -417,6 +611,287 @@ TEST_CASE("epoch_test_stale_items", "[platform]")
     }
 }
 
+/**
+ * @brief Verify that memory freed while preemptible threads are in an epoch is
+ * not released until all of them exit, including threads that don't get one of
+ * the per-CPU thread slots.
+ */
+TEST_CASE("epoch_test_preemptible_threads", "[platform]")
+{
+    bool was_preemptible = _ebpf_platform_is_preemptible;
+    _ebpf_platform_is_preemptible = true;
+
+    {
+        _test_helper test_helper;
+        const size_t thread_count = 64;
+        std::atomic<size_t> entered_count = 0;
+        std::atomic<size_t> failed_count = 0;
+        _signal exit_signal;
+        std::vector<std::thread> threads;
+
+        for (size_t i = 0; i < thread_count; i++) {
+            threads.emplace_back([&]() {
+                uintptr_t old_thread_affinity;
+                ebpf_assert_success(ebpf_set_current_thread_affinity(1, &old_thread_affinity));
+                bool in_epoch = (ebpf_epoch_enter() == EBPF_SUCCESS);
+                if (!in_epoch) {
+                    failed_count++;
+                }
+                entered_count++;
+                exit_signal.wait();
+                if (in_epoch) {
+                    ebpf_epoch_exit();
+                }
+            });
+        }
+
+        while (entered_count < thread_count) {
+            std::this_thread::sleep_for(std::chrono::milliseconds(1));
+        }
+        REQUIRE(failed_count == 0);
+
+        uintptr_t old_thread_affinity;
+        REQUIRE(ebpf_set_current_thread_affinity(1, &old_thread_affinity) == EBPF_SUCCESS);
+
+        REQUIRE(ebpf_epoch_enter() == EBPF_SUCCESS);
+        void* memory = ebpf_epoch_allocate(10);
+        REQUIRE(memory != nullptr);
+        ebpf_epoch_free(memory);
+        ebpf_epoch_exit();
+
+        // The threads are still in the epoch, so the memory must not be released.
+        ebpf_epoch_flush();
+        REQUIRE(ebpf_epoch_enter() == EBPF_SUCCESS);
+        ebpf_epoch_exit();
+        REQUIRE(!ebpf_epoch_is_free_list_empty(0));
+
+        exit_signal.signal();
+        for (auto& thread : threads) {
+            thread.join();
+        }
+
+        for (size_t retry = 0; retry < 100; retry++) {
+            ebpf_epoch_flush();
+            REQUIRE(ebpf_epoch_enter() == EBPF_SUCCESS);
+            ebpf_epoch_exit();
+            if (ebpf_epoch_is_free_list_empty(0)) {
+                break;
+            }
+            std::this_thread::sleep_for(std::chrono::milliseconds(1));
+        }
+        REQUIRE(ebpf_epoch_is_free_list_empty(0));
+
+        ebpf_restore_current_thread_affinity(old_thread_affinity);
+    }
+
+    _ebpf_platform_is_preemptible = was_preemptible;
+}
+
+/**
+ * @brief Verify that a block released by epoch is recycled by the next
+ * allocation of the same size class on the same CPU, and is zero initialized.
+ */
+TEST_CASE("epoch_test_slab_recycle", "[platform]")
+{
+    bool was_preemptible = _ebpf_platform_is_preemptible;
+    _ebpf_platform_is_preemptible = true;
+
+    {
+        _test_helper test_helper;
+        uintptr_t old_thread_affinity;
+        REQUIRE(ebpf_set_current_thread_affinity(1, &old_thread_affinity) == EBPF_SUCCESS);
+
+        REQUIRE(ebpf_epoch_enter() == EBPF_SUCCESS);
+        uint8_t* first = reinterpret_cast<uint8_t*>(ebpf_epoch_allocate(24));
+        REQUIRE(first != nullptr);
+        memset(first, 0xcc, 24);
+        ebpf_epoch_free(first);
+        ebpf_epoch_exit();
+
+        for (size_t retry = 0; retry < 100; retry++) {
+            ebpf_epoch_flush();
+            REQUIRE(ebpf_epoch_enter() == EBPF_SUCCESS);
+            ebpf_epoch_exit();
+            if (ebpf_epoch_is_free_list_empty(0)) {
+                break;
+            }
+            std::this_thread::sleep_for(std::chrono::milliseconds(1));
+        }
+        REQUIRE(ebpf_epoch_is_free_list_empty(0));
+
+        // A different size in the same size class gets the recycled block.
+        REQUIRE(ebpf_epoch_enter() == EBPF_SUCCESS);
+        uint8_t* second = reinterpret_cast<uint8_t*>(ebpf_epoch_allocate(20));
+        REQUIRE(second == first);
+        for (size_t i = 0; i < 20; i++) {
+            REQUIRE(second[i] == 0);
+        }
+
+        // Allocations too large for any size class still work.
+        void* large = ebpf_epoch_allocate(64 * 1024);
+        REQUIRE(large != nullptr);
+        ebpf_epoch_free(large);
+        ebpf_epoch_free(second);
+        ebpf_epoch_exit();
+
+        ebpf_restore_current_thread_affinity(old_thread_affinity);
+    }
+
+    _ebpf_platform_is_preemptible = was_preemptible;
+}
+
+/**
+ * @brief Verify that the per-CPU backlog counters track memory that is waiting
+ * for an epoch to end, and that a backlog above the threshold arms the flush
+ * timer with the shorter delay.
+ */
+TEST_CASE("epoch_test_statistics", "[platform]")
+{
+    bool was_preemptible = _ebpf_platform_is_preemptible;
+    _ebpf_platform_is_preemptible = true;
+
+    {
+        _test_helper test_helper;
+        ebpf_epoch_statistics_t statistics;
+        uint32_t cpu_count = 0;
+        _signal entered_signal;
+        _signal exit_signal;
+
+        REQUIRE(ebpf_epoch_query_statistics(&statistics, nullptr, &cpu_count) == EBPF_INSUFFICIENT_BUFFER);
+        REQUIRE(cpu_count == ebpf_get_cpu_count());
+        std::vector<ebpf_epoch_cpu_statistics_t> cpu_statistics(cpu_count);
+
+        ebpf_epoch_set_backlog_threshold(64);
+
+        // Hold an epoch open on CPU 0 so that nothing freed after this point can be released.
+        std::thread holder([&]() {
+            uintptr_t old_thread_affinity;
+            ebpf_assert_success(ebpf_set_current_thread_affinity(1, &old_thread_affinity));
+            bool in_epoch = (ebpf_epoch_enter() == EBPF_SUCCESS);
+            entered_signal.signal();
+            exit_signal.wait();
+            if (in_epoch) {
+                ebpf_epoch_exit();
+            }
+        });
+        entered_signal.wait();
+
+        uintptr_t old_thread_affinity;
+        REQUIRE(ebpf_set_current_thread_affinity(1, &old_thread_affinity) == EBPF_SUCCESS);
+
+        REQUIRE(ebpf_epoch_enter() == EBPF_SUCCESS);
+        for (size_t i = 0; i < 3; i++) {
+            void* memory = ebpf_epoch_allocate(24);
+            REQUIRE(memory != nullptr);
+            ebpf_epoch_free(memory);
+        }
+        ebpf_epoch_exit();
+        ebpf_epoch_flush();
+
+        REQUIRE(ebpf_epoch_query_statistics(&statistics, cpu_statistics.data(), &cpu_count) == EBPF_SUCCESS);
+        REQUIRE(cpu_statistics[0].pending_blocks >= 3);
+        REQUIRE(cpu_statistics[0].pending_bytes >= 3 * 24);
+        REQUIRE(cpu_statistics[0].pending_work_items == 0);
+        REQUIRE(cpu_statistics[0].oldest_pending_epoch_age >= 3);
+        REQUIRE(statistics.backlog_threshold_in_bytes == 64);
+        REQUIRE(statistics.accelerated_flushes > 0);
+        REQUIRE(statistics.release_epoch < statistics.current_epoch);
+
+        exit_signal.signal();
+        holder.join();
+
+        for (size_t retry = 0; retry < 100; retry++) {
+            ebpf_epoch_flush();
+            REQUIRE(ebpf_epoch_enter() == EBPF_SUCCESS);
+            ebpf_epoch_exit();
+            if (ebpf_epoch_is_free_list_empty(0)) {
+                break;
+            }
+            std::this_thread::sleep_for(std::chrono::milliseconds(1));
+        }
+        REQUIRE(ebpf_epoch_is_free_list_empty(0));
+
+        REQUIRE(ebpf_epoch_query_statistics(&statistics, cpu_statistics.data(), &cpu_count) == EBPF_SUCCESS);
+        REQUIRE(cpu_statistics[0].pending_blocks == 0);
+        REQUIRE(cpu_statistics[0].pending_bytes == 0);
+        REQUIRE(cpu_statistics[0].oldest_pending_epoch_age == 0);
+
+        ebpf_restore_current_thread_affinity(old_thread_affinity);
+    }
+
+    _ebpf_platform_is_preemptible = was_preemptible;
+}
+
+static const void
+_epoch_test_set_flag(_Inout_ void* context)
+{
+    *reinterpret_cast<bool*>(context) = true;
+}
+
+/**
+ * @brief Verify that freeing a pending work item on a different CPU than the
+ * one it was scheduled on removes it from the scheduling CPU's backlog.
+ */
+TEST_CASE("epoch_test_free_work_item_cross_cpu", "[platform]")
+{
+    if (ebpf_get_cpu_count() < 2) {
+        return;
+    }
+
+    bool was_preemptible = _ebpf_platform_is_preemptible;
+    _ebpf_platform_is_preemptible = true;
+
+    {
+        _test_helper test_helper;
+        ebpf_epoch_statistics_t statistics;
+        uint32_t cpu_count = ebpf_get_cpu_count();
+        std::vector<ebpf_epoch_cpu_statistics_t> cpu_statistics(cpu_count);
+        _signal entered_signal;
+        _signal exit_signal;
+
+        // Hold an epoch open on CPU 0 so that the work item stays pending.
+        std::thread holder([&]() {
+            uintptr_t old_thread_affinity;
+            ebpf_assert_success(ebpf_set_current_thread_affinity(1, &old_thread_affinity));
+            bool in_epoch = (ebpf_epoch_enter() == EBPF_SUCCESS);
+            entered_signal.signal();
+            exit_signal.wait();
+            if (in_epoch) {
+                ebpf_epoch_exit();
+            }
+        });
+        entered_signal.wait();
+
+        bool called = false;
+        ebpf_epoch_work_item_t* work_item = ebpf_epoch_allocate_work_item(&called, _epoch_test_set_flag);
+        REQUIRE(work_item != nullptr);
+
+        uintptr_t old_thread_affinity;
+        REQUIRE(ebpf_set_current_thread_affinity(1, &old_thread_affinity) == EBPF_SUCCESS);
+        REQUIRE(ebpf_epoch_enter() == EBPF_SUCCESS);
+        ebpf_epoch_schedule_work_item(work_item);
+        ebpf_epoch_exit();
+        ebpf_restore_current_thread_affinity(old_thread_affinity);
+
+        REQUIRE(ebpf_epoch_query_statistics(&statistics, cpu_statistics.data(), &cpu_count) == EBPF_SUCCESS);
+        REQUIRE(cpu_statistics[0].pending_work_items == 1);
+
+        REQUIRE(ebpf_set_current_thread_affinity(2, &old_thread_affinity) == EBPF_SUCCESS);
+        ebpf_epoch_free_work_item(work_item);
+        ebpf_restore_current_thread_affinity(old_thread_affinity);
+
+        REQUIRE(ebpf_epoch_query_statistics(&statistics, cpu_statistics.data(), &cpu_count) == EBPF_SUCCESS);
+        REQUIRE(cpu_statistics[0].pending_work_items == 0);
+        REQUIRE(cpu_statistics[1].pending_work_items == 0);
+        REQUIRE(!called);
+
+        exit_signal.signal();
+        holder.join();
+    }
+
+    _ebpf_platform_is_preemptible = was_preemptible;
+}
+
 static auto provider_function = []() { return EBPF_SUCCESS; };
 
 static ebpf_extension_dispatch_table_t test_provider_dispatch_table = {
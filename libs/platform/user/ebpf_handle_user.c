@@ -3,22 +3,93 @@
 
 #include "ebpf_handle.h"
 
-typedef ebpf_base_object_t* ebpf_handle_entry_t;
-
 // Simplified handle table implementation.
 // TODO: Replace this with the real Windows object manager handle table code.
+//
+// The handle table grows one page at a time and a handle is the index of its entry. Creating and closing handles
+// acquires _ebpf_handle_table_lock to maintain the free list. Resolving a handle doesn't acquire the lock:
+// ebpf_reference_base_object_by_handle announces itself in the entry's reader count before reading the object and
+// ebpf_handle_close waits for the reader count to drop to zero after clearing the object and before releasing its
+// reference, so a reader never acquires a reference on an object that has been freed.
+
+// Number of entries in each page of the handle table.
+#define EBPF_HANDLE_TABLE_PAGE_SHIFT 10
+#define EBPF_HANDLE_TABLE_PAGE_SIZE (1 << EBPF_HANDLE_TABLE_PAGE_SHIFT)
+
+// Maximum number of pages in the handle table.
+#define EBPF_HANDLE_TABLE_PAGE_COUNT 1024
+
+typedef struct _ebpf_handle_entry
+{
+    ebpf_base_object_t* volatile object; // Object the handle refers to, or NULL if the handle is closed.
+    volatile int32_t reader_count;       // Number of threads resolving the handle without the lock.
+    uint32_t next_free_handle;           // Next free handle, or 0 if this is the last one. Only valid if closed.
+} ebpf_handle_entry_t;
 
 static ebpf_lock_t _ebpf_handle_table_lock = {0};
-static _Requires_lock_held_(&_ebpf_handle_table_lock) ebpf_handle_entry_t _ebpf_handle_table[1024];
+
+// Pages are published with a release store, read without the lock and only freed on termination.
+static ebpf_handle_entry_t* volatile _ebpf_handle_table_pages[EBPF_HANDLE_TABLE_PAGE_COUNT];
+
+// Number of entries in the allocated pages.
+static _Requires_lock_held_(&_ebpf_handle_table_lock) uint32_t _ebpf_handle_table_size = 0;
+
+// Most recently closed handle, which is the first to be reused.
+static _Requires_lock_held_(&_ebpf_handle_table_lock) uint32_t _ebpf_handle_table_free_head = 0;
 
 static bool _ebpf_handle_table_initiated = false;
 
+// Get the entry for a handle, or NULL if the handle is not in an allocated page.
+static inline _Ret_maybenull_ ebpf_handle_entry_t*
+_ebpf_handle_table_get_entry(ebpf_handle_t handle)
+{
+    if (handle <= 0 || (size_t)handle >= (size_t)EBPF_HANDLE_TABLE_PAGE_SIZE * EBPF_HANDLE_TABLE_PAGE_COUNT) {
+        return NULL;
+    }
+
+    ebpf_handle_entry_t* page = (ebpf_handle_entry_t*)ReadPointerAcquire(
+        (void* volatile*)&_ebpf_handle_table_pages[handle >> EBPF_HANDLE_TABLE_PAGE_SHIFT]);
+    if (page == NULL) {
+        return NULL;
+    }
+
+    return &page[handle & (EBPF_HANDLE_TABLE_PAGE_SIZE - 1)];
+}
+
+// Add a page of entries to the handle table and to the free list.
+_Requires_lock_held_(&_ebpf_handle_table_lock) static ebpf_result_t _ebpf_handle_table_grow()
+{
+    uint32_t page_index = _ebpf_handle_table_size >> EBPF_HANDLE_TABLE_PAGE_SHIFT;
+    if (page_index >= EBPF_HANDLE_TABLE_PAGE_COUNT) {
+        return EBPF_NO_MEMORY;
+    }
+
+    ebpf_handle_entry_t* page = ebpf_allocate(sizeof(ebpf_handle_entry_t) * EBPF_HANDLE_TABLE_PAGE_SIZE);
+    if (page == NULL) {
+        return EBPF_NO_MEMORY;
+    }
+
+    // Chain the new entries in increasing order, skipping handle 0.
+    uint32_t first_handle = page_index << EBPF_HANDLE_TABLE_PAGE_SHIFT;
+    for (uint32_t index = 0; index < EBPF_HANDLE_TABLE_PAGE_SIZE; index++) {
+        page[index].next_free_handle =
+            (index + 1 < EBPF_HANDLE_TABLE_PAGE_SIZE) ? first_handle + index + 1 : _ebpf_handle_table_free_head;
+    }
+    _ebpf_handle_table_free_head = (first_handle == 0) ? 1 : first_handle;
+    _ebpf_handle_table_size += EBPF_HANDLE_TABLE_PAGE_SIZE;
+
+    WritePointerRelease((void* volatile*)&_ebpf_handle_table_pages[page_index], page);
+    return EBPF_SUCCESS;
+}
+
 _Must_inspect_result_ ebpf_result_t
 ebpf_handle_table_initiate()
 {
     EBPF_LOG_ENTRY();
     ebpf_lock_create(&_ebpf_handle_table_lock);
-    memset(_ebpf_handle_table, 0, sizeof(_ebpf_handle_table));
+    memset((void*)_ebpf_handle_table_pages, 0, sizeof(_ebpf_handle_table_pages));
+    _ebpf_handle_table_size = 0;
+    _ebpf_handle_table_free_head = 0;
     _ebpf_handle_table_initiated = true;
     EBPF_RETURN_RESULT(EBPF_SUCCESS);
 }
@@ -31,34 +102,46 @@ ebpf_handle_table_terminate()
     if (!_ebpf_handle_table_initiated)
         EBPF_RETURN_VOID();
 
-    for (handle = 0; handle < EBPF_COUNT_OF(_ebpf_handle_table); handle++) {
+    for (handle = 1; handle < (ebpf_handle_t)_ebpf_handle_table_size; handle++) {
         // Ignore invalid handle close.
         (void)ebpf_handle_close(handle);
     }
+
+    for (uint32_t page_index = 0; page_index < EBPF_HANDLE_TABLE_PAGE_COUNT; page_index++) {
+        ebpf_free(_ebpf_handle_table_pages[page_index]);
+        _ebpf_handle_table_pages[page_index] = NULL;
+    }
+    _ebpf_handle_table_size = 0;
+    _ebpf_handle_table_free_head = 0;
     _ebpf_handle_table_initiated = false;
     EBPF_RETURN_VOID();
 }
 
 _Must_inspect_result_ ebpf_result_t
-ebpf_handle_create(_Out_ ebpf_handle_t* handle, _Inout_  ebpf_base_object_t* object)
+ebpf_handle_create(_Out_ ebpf_handle_t* handle, _Inout_ ebpf_base_object_t* object)
 {
     EBPF_LOG_ENTRY();
     ebpf_handle_t new_handle;
+    ebpf_handle_entry_t* entry;
     ebpf_result_t return_value;
     ebpf_lock_state_t state;
     state = ebpf_lock_lock(&_ebpf_handle_table_lock);
-    for (new_handle = 1; new_handle < EBPF_COUNT_OF(_ebpf_handle_table); new_handle++) {
-        if (_ebpf_handle_table[new_handle] == NULL)
-            break;
-    }
-    if (new_handle == EBPF_COUNT_OF(_ebpf_handle_table)) {
-        return_value = EBPF_NO_MEMORY;
-        goto Done;
+    if (_ebpf_handle_table_free_head == 0) {
+        return_value = _ebpf_handle_table_grow();
+        if (return_value != EBPF_SUCCESS) {
+            goto Done;
+        }
     }
 
+    new_handle = _ebpf_handle_table_free_head;
+    entry = _ebpf_handle_table_get_entry(new_handle);
+    ebpf_assert(entry != NULL);
+    _Analysis_assume_(entry != NULL);
+    _ebpf_handle_table_free_head = entry->next_free_handle;
+
     *handle = new_handle;
-    _ebpf_handle_table[new_handle] = object;
     object->acquire_reference(object);
+    WritePointerRelease((void* volatile*)&entry->object, object);
 
     return_value = EBPF_SUCCESS;
 
@@ -73,17 +156,29 @@ ebpf_handle_close(ebpf_handle_t handle)
 {
     // High volume call - Skip entry/exit logging.
     ebpf_lock_state_t state;
-    ebpf_result_t return_value;
+    ebpf_handle_entry_t* entry = _ebpf_handle_table_get_entry(handle);
+    if (entry == NULL) {
+        return EBPF_INVALID_OBJECT;
+    }
+
+    // Only one of any concurrent closes of the same handle observes the object.
+    ebpf_base_object_t* object = (ebpf_base_object_t*)InterlockedExchangePointer((void* volatile*)&entry->object, NULL);
+    if (object == NULL) {
+        return EBPF_INVALID_OBJECT;
+    }
+
+    // Wait for readers that might have observed the object before it was cleared.
+    while (ReadAcquire((volatile LONG*)&entry->reader_count) != 0) {
+        YieldProcessor();
+    }
+
+    object->release_reference(object);
 
     state = ebpf_lock_lock(&_ebpf_handle_table_lock);
-    if (((size_t)handle < EBPF_COUNT_OF(_ebpf_handle_table)) && _ebpf_handle_table[handle] != NULL) {
-        (_ebpf_handle_table[handle])->release_reference(_ebpf_handle_table[handle]);
-        _ebpf_handle_table[handle] = NULL;
-        return_value = EBPF_SUCCESS;
-    } else
-        return_value = EBPF_INVALID_OBJECT;
+    entry->next_free_handle = _ebpf_handle_table_free_head;
+    _ebpf_handle_table_free_head = (uint32_t)handle;
     ebpf_lock_unlock(&_ebpf_handle_table_lock, state);
-    return return_value;
+    return EBPF_SUCCESS;
 }
 
 _IRQL_requires_max_(PASSIVE_LEVEL) ebpf_result_t ebpf_reference_base_object_by_handle(
@@ -93,22 +188,24 @@ _IRQL_requires_max_(PASSIVE_LEVEL) ebpf_result_t ebpf_reference_base_object_by_h
     _Outptr_ struct _ebpf_base_object** object)
 {
     ebpf_result_t return_value;
-    ebpf_lock_state_t state;
 
-    if (handle >= EBPF_COUNT_OF(_ebpf_handle_table)) {
+    ebpf_handle_entry_t* entry = _ebpf_handle_table_get_entry(handle);
+    if (entry == NULL) {
         EBPF_LOG_MESSAGE_UINT64(EBPF_TRACELOG_LEVEL_CRITICAL, EBPF_TRACELOG_KEYWORD_BASE, "Invalid handle", handle);
         return EBPF_INVALID_OBJECT;
     }
 
-    state = ebpf_lock_lock(&_ebpf_handle_table_lock);
-    if (_ebpf_handle_table[handle] != NULL &&
-        (compare_function == NULL || compare_function(_ebpf_handle_table[handle], context))) {
-        _ebpf_handle_table[handle]->acquire_reference(_ebpf_handle_table[handle]);
-        *object = _ebpf_handle_table[handle];
+    // The interlocked increment orders the reader count update before the read of the object, pairing with the
+    // exchange in ebpf_handle_close.
+    ebpf_interlocked_increment_int32(&entry->reader_count);
+    ebpf_base_object_t* found = (ebpf_base_object_t*)ReadPointerAcquire((void* volatile*)&entry->object);
+    if (found != NULL && (compare_function == NULL || compare_function(found, context))) {
+        found->acquire_reference(found);
+        *object = found;
         return_value = EBPF_SUCCESS;
     } else
         return_value = EBPF_INVALID_OBJECT;
+    ebpf_interlocked_decrement_int32(&entry->reader_count);
 
-    ebpf_lock_unlock(&_ebpf_handle_table_lock, state);
     return return_value;
 }
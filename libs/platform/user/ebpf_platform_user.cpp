@@ -655,6 +655,38 @@ ebpf_ring_map_readonly_user(_In_ const ebpf_ring_descriptor_t* ring)
     EBPF_RETURN_POINTER(void*, ebpf_ring_descriptor_get_base_address(ring));
 }
 
+struct _ebpf_user_mapping
+{
+    void* address;
+};
+
+_Must_inspect_result_ ebpf_result_t
+ebpf_map_memory_user(_In_ ebpf_memory_descriptor_t* memory_descriptor, _Outptr_ ebpf_user_mapping_t** user_mapping)
+{
+    EBPF_LOG_ENTRY();
+    ebpf_user_mapping_t* local_user_mapping = (ebpf_user_mapping_t*)ebpf_allocate(sizeof(ebpf_user_mapping_t));
+    if (!local_user_mapping) {
+        EBPF_RETURN_RESULT(EBPF_NO_MEMORY);
+    }
+
+    // The caller shares the address space, so the memory is used in place.
+    local_user_mapping->address = memory_descriptor->base;
+    *user_mapping = local_user_mapping;
+    EBPF_RETURN_RESULT(EBPF_SUCCESS);
+}
+
+void*
+ebpf_user_mapping_get_address(_In_ const ebpf_user_mapping_t* user_mapping)
+{
+    return user_mapping->address;
+}
+
+void
+ebpf_unmap_memory_user(_Frees_ptr_opt_ ebpf_user_mapping_t* user_mapping)
+{
+    ebpf_free(user_mapping);
+}
+
 _Must_inspect_result_ ebpf_result_t
 ebpf_protect_memory(_In_ const ebpf_memory_descriptor_t* memory_descriptor, ebpf_page_protection_t protection)
 {
@@ -348,7 +348,17 @@ ebpf_verify_and_load_program(
         request->header.id = ebpf_operation_id_t::EBPF_OPERATION_LOAD_CODE;
         request->header.length = static_cast<uint16_t>(request_buffer.size());
         request->program_handle = program_handle;
-        request->code_type = execution_type == EBPF_EXECUTION_JIT ? EBPF_CODE_JIT : EBPF_CODE_EBPF;
+        switch (execution_type) {
+        case EBPF_EXECUTION_JIT:
+            request->code_type = EBPF_CODE_JIT;
+            break;
+        case EBPF_EXECUTION_INTERPRET_THREADED:
+            request->code_type = EBPF_CODE_EBPF_THREADED;
+            break;
+        default:
+            request->code_type = EBPF_CODE_EBPF;
+            break;
+        }
 
         memcpy(request->code, byte_code_data, byte_code_size);
 
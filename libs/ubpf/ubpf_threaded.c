@@ -0,0 +1,541 @@
+// Copyright (c) Microsoft Corporation
+// SPDX-License-Identifier: MIT
+
+// Threaded-code interpreter for eBPF byte code.
+//
+// ubpf_exec decodes every instruction on every execution and dispatches through
+// a switch on the opcode. This interpreter does the decoding once, at load time,
+// producing an array of pre-decoded instructions that each carry a pointer to the
+// handler that executes them. Execution is then a tight loop of indirect calls,
+// where each handler returns the next instruction to run. Jump targets and helper
+// functions are resolved to pointers up front, so handlers do no lookups.
+//
+// MSVC does not support computed goto, so handlers are separate functions and
+// the dispatch loop calls them in turn (call threading).
+
+#include "ubpf_threaded.h"
+
+#define UBPF_THREADED_REGISTER_COUNT 11
+#define UBPF_THREADED_FRAME_POINTER 10
+#define UBPF_THREADED_STACK_SIZE 512
+
+// Instruction encoding.
+#define UBPF_THREADED_CLASS(opcode) ((opcode)&0x07)
+#define UBPF_THREADED_CLASS_LD 0x00
+#define UBPF_THREADED_CLASS_LDX 0x01
+#define UBPF_THREADED_CLASS_ST 0x02
+#define UBPF_THREADED_CLASS_STX 0x03
+#define UBPF_THREADED_CLASS_ALU 0x04
+#define UBPF_THREADED_CLASS_JMP 0x05
+#define UBPF_THREADED_CLASS_JMP32 0x06
+#define UBPF_THREADED_CLASS_ALU64 0x07
+
+#define UBPF_THREADED_SOURCE_REG 0x08
+#define UBPF_THREADED_OP_INDEX(opcode) ((opcode) >> 4)
+
+#define UBPF_THREADED_ALU_OP_END 0xd0
+
+#define UBPF_THREADED_JMP_OP_JA 0x00
+#define UBPF_THREADED_JMP_OP_CALL 0x80
+#define UBPF_THREADED_JMP_OP_EXIT 0x90
+
+#define UBPF_THREADED_MODE(opcode) ((opcode)&0xe0)
+#define UBPF_THREADED_MODE_IMM 0x00
+#define UBPF_THREADED_MODE_MEM 0x60
+#define UBPF_THREADED_SIZE(opcode) ((opcode)&0x18)
+#define UBPF_THREADED_SIZE_W 0x00
+#define UBPF_THREADED_SIZE_H 0x08
+#define UBPF_THREADED_SIZE_B 0x10
+#define UBPF_THREADED_SIZE_DW 0x18
+
+#define UBPF_THREADED_OP_LDDW 0x18
+
+#define UBPF_THREADED_INVALID_INDEX UINT32_MAX
+
+typedef struct _ubpf_threaded_raw_instruction
+{
+    uint8_t opcode;
+    uint8_t dst : 4;
+    uint8_t src : 4;
+    int16_t offset;
+    int32_t imm;
+} ubpf_threaded_raw_instruction_t;
+
+typedef struct _ubpf_threaded_state
+{
+    uint64_t registers[UBPF_THREADED_REGISTER_COUNT];
+    bool failed;
+} ubpf_threaded_state_t;
+
+typedef struct _ubpf_threaded_instruction ubpf_threaded_instruction_t;
+
+typedef const ubpf_threaded_instruction_t* (*ubpf_threaded_handler_t)(
+    _Inout_ ubpf_threaded_state_t* state, _In_ const ubpf_threaded_instruction_t* instruction);
+
+typedef uint64_t (*ubpf_threaded_helper_t)(uint64_t r1, uint64_t r2, uint64_t r3, uint64_t r4, uint64_t r5);
+
+typedef struct _ubpf_threaded_instruction
+{
+    ubpf_threaded_handler_t handler;
+    uint8_t dst;
+    uint8_t src;
+    int16_t offset;
+    uint32_t helper_index;
+    uint64_t immediate; // Sign extended to 64 bits, or the full 64-bit value for LDDW.
+    union
+    {
+        const ubpf_threaded_instruction_t* target; // Jumps.
+        void* volatile helper;                     // Calls.
+    };
+} ubpf_threaded_instruction_t;
+
+typedef struct _ubpf_threaded_program
+{
+    size_t instruction_count;
+    ubpf_threaded_instruction_t instructions[1];
+} ubpf_threaded_program_t;
+
+#define UBPF_THREADED_HANDLER(NAME)                         \
+    static const ubpf_threaded_instruction_t* NAME(         \
+        _Inout_ ubpf_threaded_state_t* state, _In_ const ubpf_threaded_instruction_t* instruction)
+
+// ALU operations. DST and SRC are the operand values, already truncated for 32-bit operations.
+#define UBPF_THREADED_ALU(NAME, TYPE, EXPRESSION)                                         \
+    UBPF_THREADED_HANDLER(_ubpf_threaded_##NAME##_imm)                                    \
+    {                                                                                     \
+        TYPE DST = (TYPE)state->registers[instruction->dst];                              \
+        TYPE SRC = (TYPE)instruction->immediate;                                          \
+        UNREFERENCED_PARAMETER(DST);                                                      \
+        UNREFERENCED_PARAMETER(SRC);                                                      \
+        state->registers[instruction->dst] = (TYPE)(EXPRESSION);                          \
+        return instruction + 1;                                                           \
+    }                                                                                     \
+    UBPF_THREADED_HANDLER(_ubpf_threaded_##NAME##_reg)                                    \
+    {                                                                                     \
+        TYPE DST = (TYPE)state->registers[instruction->dst];                              \
+        TYPE SRC = (TYPE)state->registers[instruction->src];                              \
+        UNREFERENCED_PARAMETER(DST);                                                      \
+        UNREFERENCED_PARAMETER(SRC);                                                      \
+        state->registers[instruction->dst] = (TYPE)(EXPRESSION);                          \
+        return instruction + 1;                                                           \
+    }
+
+#define UBPF_THREADED_ALU_BOTH(NAME, EXPRESSION_64, EXPRESSION_32) \
+    UBPF_THREADED_ALU(NAME##64, uint64_t, EXPRESSION_64)           \
+    UBPF_THREADED_ALU(NAME##32, uint32_t, EXPRESSION_32)
+
+UBPF_THREADED_ALU_BOTH(add, DST + SRC, DST + SRC)
+UBPF_THREADED_ALU_BOTH(sub, DST - SRC, DST - SRC)
+UBPF_THREADED_ALU_BOTH(mul, DST * SRC, DST * SRC)
+UBPF_THREADED_ALU_BOTH(div, SRC ? DST / SRC : 0, SRC ? DST / SRC : 0)
+UBPF_THREADED_ALU_BOTH(or, DST | SRC, DST | SRC)
+UBPF_THREADED_ALU_BOTH(and, DST & SRC, DST & SRC)
+UBPF_THREADED_ALU_BOTH(lsh, DST << (SRC & 63), DST << (SRC & 31))
+UBPF_THREADED_ALU_BOTH(rsh, DST >> (SRC & 63), DST >> (SRC & 31))
+UBPF_THREADED_ALU_BOTH(neg, (uint64_t)(-(int64_t)DST), (uint32_t)(-(int32_t)DST))
+UBPF_THREADED_ALU_BOTH(mod, SRC ? DST % SRC : DST, SRC ? DST % SRC : DST)
+UBPF_THREADED_ALU_BOTH(xor, DST ^ SRC, DST ^ SRC)
+UBPF_THREADED_ALU_BOTH(mov, SRC, SRC)
+UBPF_THREADED_ALU_BOTH(arsh, (uint64_t)((int64_t)DST >> (SRC & 63)), (uint32_t)((int32_t)DST >> (SRC & 31)))
+
+#define UBPF_THREADED_ALU_ENTRY(NAME, WIDTH, SOURCE) _ubpf_threaded_##NAME##WIDTH##_##SOURCE
+
+#define UBPF_THREADED_ALU_TABLE(WIDTH, SOURCE)                                               \
+    {                                                                                        \
+        UBPF_THREADED_ALU_ENTRY(add, WIDTH, SOURCE), UBPF_THREADED_ALU_ENTRY(sub, WIDTH, SOURCE), \
+            UBPF_THREADED_ALU_ENTRY(mul, WIDTH, SOURCE), UBPF_THREADED_ALU_ENTRY(div, WIDTH, SOURCE), \
+            UBPF_THREADED_ALU_ENTRY(or, WIDTH, SOURCE), UBPF_THREADED_ALU_ENTRY(and, WIDTH, SOURCE), \
+            UBPF_THREADED_ALU_ENTRY(lsh, WIDTH, SOURCE), UBPF_THREADED_ALU_ENTRY(rsh, WIDTH, SOURCE), \
+            UBPF_THREADED_ALU_ENTRY(neg, WIDTH, SOURCE), UBPF_THREADED_ALU_ENTRY(mod, WIDTH, SOURCE), \
+            UBPF_THREADED_ALU_ENTRY(xor, WIDTH, SOURCE), UBPF_THREADED_ALU_ENTRY(mov, WIDTH, SOURCE), \
+            UBPF_THREADED_ALU_ENTRY(arsh, WIDTH, SOURCE), NULL, NULL, NULL                    \
+    }
+
+// Indexed by [source is register][operation].
+static const ubpf_threaded_handler_t _ubpf_threaded_alu64_handlers[2][16] = {
+    UBPF_THREADED_ALU_TABLE(64, imm), UBPF_THREADED_ALU_TABLE(64, reg)};
+static const ubpf_threaded_handler_t _ubpf_threaded_alu32_handlers[2][16] = {
+    UBPF_THREADED_ALU_TABLE(32, imm), UBPF_THREADED_ALU_TABLE(32, reg)};
+
+static inline uint16_t
+_ubpf_threaded_swap16(uint16_t value)
+{
+    return (uint16_t)((value << 8) | (value >> 8));
+}
+
+static inline uint32_t
+_ubpf_threaded_swap32(uint32_t value)
+{
+    return ((uint32_t)_ubpf_threaded_swap16((uint16_t)value) << 16) | _ubpf_threaded_swap16((uint16_t)(value >> 16));
+}
+
+static inline uint64_t
+_ubpf_threaded_swap64(uint64_t value)
+{
+    return ((uint64_t)_ubpf_threaded_swap32((uint32_t)value) << 32) | _ubpf_threaded_swap32((uint32_t)(value >> 32));
+}
+
+// Byte swap operations. Only little endian hosts are supported, so conversion to little endian truncates.
+#define UBPF_THREADED_END(NAME, EXPRESSION)                   \
+    UBPF_THREADED_HANDLER(_ubpf_threaded_##NAME)              \
+    {                                                         \
+        uint64_t DST = state->registers[instruction->dst];    \
+        state->registers[instruction->dst] = (EXPRESSION);    \
+        return instruction + 1;                               \
+    }
+
+UBPF_THREADED_END(le16, (uint16_t)DST)
+UBPF_THREADED_END(le32, (uint32_t)DST)
+UBPF_THREADED_END(le64, DST)
+UBPF_THREADED_END(be16, _ubpf_threaded_swap16((uint16_t)DST))
+UBPF_THREADED_END(be32, _ubpf_threaded_swap32((uint32_t)DST))
+UBPF_THREADED_END(be64, _ubpf_threaded_swap64(DST))
+
+// Conditional jumps. TYPE selects the signedness and width of the comparison.
+#define UBPF_THREADED_JUMP(NAME, TYPE, CONDITION)                                     \
+    UBPF_THREADED_HANDLER(_ubpf_threaded_##NAME##_imm)                                \
+    {                                                                                 \
+        TYPE DST = (TYPE)state->registers[instruction->dst];                          \
+        TYPE SRC = (TYPE)instruction->immediate;                                      \
+        return (CONDITION) ? instruction->target : instruction + 1;                   \
+    }                                                                                 \
+    UBPF_THREADED_HANDLER(_ubpf_threaded_##NAME##_reg)                                \
+    {                                                                                 \
+        TYPE DST = (TYPE)state->registers[instruction->dst];                          \
+        TYPE SRC = (TYPE)state->registers[instruction->src];                          \
+        return (CONDITION) ? instruction->target : instruction + 1;                   \
+    }
+
+#define UBPF_THREADED_JUMP_BOTH(NAME, UNSIGNED_OR_SIGNED, CONDITION) \
+    UBPF_THREADED_JUMP(NAME##64, UNSIGNED_OR_SIGNED##64_t, CONDITION) \
+    UBPF_THREADED_JUMP(NAME##32, UNSIGNED_OR_SIGNED##32_t, CONDITION)
+
+UBPF_THREADED_JUMP_BOTH(jeq, uint, DST == SRC)
+UBPF_THREADED_JUMP_BOTH(jgt, uint, DST > SRC)
+UBPF_THREADED_JUMP_BOTH(jge, uint, DST >= SRC)
+UBPF_THREADED_JUMP_BOTH(jset, uint, (DST & SRC) != 0)
+UBPF_THREADED_JUMP_BOTH(jne, uint, DST != SRC)
+UBPF_THREADED_JUMP_BOTH(jsgt, int, DST > SRC)
+UBPF_THREADED_JUMP_BOTH(jsge, int, DST >= SRC)
+UBPF_THREADED_JUMP_BOTH(jlt, uint, DST < SRC)
+UBPF_THREADED_JUMP_BOTH(jle, uint, DST <= SRC)
+UBPF_THREADED_JUMP_BOTH(jslt, int, DST < SRC)
+UBPF_THREADED_JUMP_BOTH(jsle, int, DST <= SRC)
+
+#define UBPF_THREADED_JUMP_ENTRY(NAME, WIDTH, SOURCE) _ubpf_threaded_##NAME##WIDTH##_##SOURCE
+
+// JA, CALL and EXIT are decoded separately.
+#define UBPF_THREADED_JUMP_TABLE(WIDTH, SOURCE)                                                      \
+    {                                                                                                \
+        NULL, UBPF_THREADED_JUMP_ENTRY(jeq, WIDTH, SOURCE), UBPF_THREADED_JUMP_ENTRY(jgt, WIDTH, SOURCE), \
+            UBPF_THREADED_JUMP_ENTRY(jge, WIDTH, SOURCE), UBPF_THREADED_JUMP_ENTRY(jset, WIDTH, SOURCE), \
+            UBPF_THREADED_JUMP_ENTRY(jne, WIDTH, SOURCE), UBPF_THREADED_JUMP_ENTRY(jsgt, WIDTH, SOURCE), \
+            UBPF_THREADED_JUMP_ENTRY(jsge, WIDTH, SOURCE), NULL, NULL,                                \
+            UBPF_THREADED_JUMP_ENTRY(jlt, WIDTH, SOURCE), UBPF_THREADED_JUMP_ENTRY(jle, WIDTH, SOURCE), \
+            UBPF_THREADED_JUMP_ENTRY(jslt, WIDTH, SOURCE), UBPF_THREADED_JUMP_ENTRY(jsle, WIDTH, SOURCE), \
+            NULL, NULL                                                                               \
+    }
+
+// Indexed by [source is register][operation].
+static const ubpf_threaded_handler_t _ubpf_threaded_jmp64_handlers[2][16] = {
+    UBPF_THREADED_JUMP_TABLE(64, imm), UBPF_THREADED_JUMP_TABLE(64, reg)};
+static const ubpf_threaded_handler_t _ubpf_threaded_jmp32_handlers[2][16] = {
+    UBPF_THREADED_JUMP_TABLE(32, imm), UBPF_THREADED_JUMP_TABLE(32, reg)};
+
+UBPF_THREADED_HANDLER(_ubpf_threaded_ja)
+{
+    UNREFERENCED_PARAMETER(state);
+    return instruction->target;
+}
+
+UBPF_THREADED_HANDLER(_ubpf_threaded_call)
+{
+    ubpf_threaded_helper_t helper = (ubpf_threaded_helper_t)instruction->helper;
+    if (helper == NULL) {
+        state->failed = true;
+        return NULL;
+    }
+    state->registers[0] = helper(
+        state->registers[1], state->registers[2], state->registers[3], state->registers[4], state->registers[5]);
+    return instruction + 1;
+}
+
+UBPF_THREADED_HANDLER(_ubpf_threaded_exit)
+{
+    UNREFERENCED_PARAMETER(state);
+    UNREFERENCED_PARAMETER(instruction);
+    return NULL;
+}
+
+// Appended after the last instruction. Only reachable if the program runs off its end.
+UBPF_THREADED_HANDLER(_ubpf_threaded_end_of_program)
+{
+    UNREFERENCED_PARAMETER(instruction);
+    state->failed = true;
+    return NULL;
+}
+
+UBPF_THREADED_HANDLER(_ubpf_threaded_lddw)
+{
+    state->registers[instruction->dst] = instruction->immediate;
+    return instruction + 1;
+}
+
+// Memory access. Bounds are enforced by the verifier, not at run time.
+#define UBPF_THREADED_MEMORY(TYPE, SIZE)                                                               \
+    UBPF_THREADED_HANDLER(_ubpf_threaded_ldx##SIZE)                                                    \
+    {                                                                                                  \
+        state->registers[instruction->dst] =                                                           \
+            *(const TYPE*)(uintptr_t)(state->registers[instruction->src] + instruction->offset);       \
+        return instruction + 1;                                                                        \
+    }                                                                                                  \
+    UBPF_THREADED_HANDLER(_ubpf_threaded_st##SIZE)                                                     \
+    {                                                                                                  \
+        *(TYPE*)(uintptr_t)(state->registers[instruction->dst] + instruction->offset) =                \
+            (TYPE)instruction->immediate;                                                              \
+        return instruction + 1;                                                                        \
+    }                                                                                                  \
+    UBPF_THREADED_HANDLER(_ubpf_threaded_stx##SIZE)                                                    \
+    {                                                                                                  \
+        *(TYPE*)(uintptr_t)(state->registers[instruction->dst] + instruction->offset) =                \
+            (TYPE)state->registers[instruction->src];                                                  \
+        return instruction + 1;                                                                        \
+    }
+
+UBPF_THREADED_MEMORY(uint8_t, b)
+UBPF_THREADED_MEMORY(uint16_t, h)
+UBPF_THREADED_MEMORY(uint32_t, w)
+UBPF_THREADED_MEMORY(uint64_t, dw)
+
+static ubpf_threaded_handler_t
+_ubpf_threaded_memory_handler(uint8_t instruction_class, uint8_t size)
+{
+    static const ubpf_threaded_handler_t ldx[] = {
+        _ubpf_threaded_ldxw, _ubpf_threaded_ldxh, _ubpf_threaded_ldxb, _ubpf_threaded_ldxdw};
+    static const ubpf_threaded_handler_t st[] = {
+        _ubpf_threaded_stw, _ubpf_threaded_sth, _ubpf_threaded_stb, _ubpf_threaded_stdw};
+    static const ubpf_threaded_handler_t stx[] = {
+        _ubpf_threaded_stxw, _ubpf_threaded_stxh, _ubpf_threaded_stxb, _ubpf_threaded_stxdw};
+    size_t index = size >> 3;
+
+    switch (instruction_class) {
+    case UBPF_THREADED_CLASS_LDX:
+        return ldx[index];
+    case UBPF_THREADED_CLASS_ST:
+        return st[index];
+    case UBPF_THREADED_CLASS_STX:
+        return stx[index];
+    default:
+        return NULL;
+    }
+}
+
+static ubpf_threaded_handler_t
+_ubpf_threaded_end_handler(bool big_endian, int32_t width)
+{
+    switch (width) {
+    case 16:
+        return big_endian ? _ubpf_threaded_be16 : _ubpf_threaded_le16;
+    case 32:
+        return big_endian ? _ubpf_threaded_be32 : _ubpf_threaded_le32;
+    case 64:
+        return big_endian ? _ubpf_threaded_be64 : _ubpf_threaded_le64;
+    default:
+        return NULL;
+    }
+}
+
+static ubpf_threaded_raw_instruction_t
+_ubpf_threaded_read_instruction(_In_reads_(instruction_count) const uint64_t* instructions, size_t index)
+{
+    ubpf_threaded_raw_instruction_t raw;
+    memcpy(&raw, &instructions[index], sizeof(raw));
+    return raw;
+}
+
+_Must_inspect_result_ ebpf_result_t
+ubpf_threaded_load(
+    _In_reads_(instruction_count) const uint64_t* instructions,
+    size_t instruction_count,
+    _Outptr_ ubpf_threaded_program_t** program)
+{
+    ebpf_result_t result;
+    ubpf_threaded_program_t* new_program = NULL;
+    uint32_t* decoded_index = NULL;
+    size_t decoded_count = 0;
+    size_t program_size;
+
+    // Jump offsets are 16 bits, but keep indices comfortably within 32 bits.
+    if (instruction_count == 0 || instruction_count >= UBPF_THREADED_INVALID_INDEX) {
+        result = (instruction_count == 0) ? EBPF_INVALID_ARGUMENT : EBPF_PROGRAM_TOO_LARGE;
+        goto Done;
+    }
+
+    // Map each raw instruction index to its decoded index. The second half of LDDW has no decoded
+    // instruction and is not a valid jump target. The extra entry maps the end of the program.
+    decoded_index = (uint32_t*)ebpf_allocate((instruction_count + 1) * sizeof(uint32_t));
+    if (decoded_index == NULL) {
+        result = EBPF_NO_MEMORY;
+        goto Done;
+    }
+    for (size_t index = 0; index < instruction_count; index++) {
+        ubpf_threaded_raw_instruction_t raw = _ubpf_threaded_read_instruction(instructions, index);
+        decoded_index[index] = (uint32_t)decoded_count++;
+        if (raw.opcode == UBPF_THREADED_OP_LDDW) {
+            if (index + 1 >= instruction_count) {
+                result = EBPF_INVALID_ARGUMENT;
+                goto Done;
+            }
+            decoded_index[++index] = UBPF_THREADED_INVALID_INDEX;
+        }
+    }
+    decoded_index[instruction_count] = (uint32_t)decoded_count;
+
+    // One extra instruction catches execution running off the end of the program.
+    result = ebpf_safe_size_t_multiply(decoded_count, sizeof(ubpf_threaded_instruction_t), &program_size);
+    if (result != EBPF_SUCCESS) {
+        goto Done;
+    }
+    result = ebpf_safe_size_t_add(program_size, sizeof(ubpf_threaded_program_t), &program_size);
+    if (result != EBPF_SUCCESS) {
+        goto Done;
+    }
+    new_program = (ubpf_threaded_program_t*)ebpf_allocate(program_size);
+    if (new_program == NULL) {
+        result = EBPF_NO_MEMORY;
+        goto Done;
+    }
+    new_program->instruction_count = decoded_count;
+    new_program->instructions[decoded_count].handler = _ubpf_threaded_end_of_program;
+
+    for (size_t index = 0; index < instruction_count; index++) {
+        ubpf_threaded_raw_instruction_t raw = _ubpf_threaded_read_instruction(instructions, index);
+        ubpf_threaded_instruction_t* decoded = &new_program->instructions[decoded_index[index]];
+        uint8_t operation = raw.opcode & 0xf0;
+        size_t source_is_register = (raw.opcode & UBPF_THREADED_SOURCE_REG) ? 1 : 0;
+
+        if (raw.dst >= UBPF_THREADED_REGISTER_COUNT || raw.src >= UBPF_THREADED_REGISTER_COUNT) {
+            result = EBPF_INVALID_ARGUMENT;
+            goto Done;
+        }
+
+        decoded->dst = raw.dst;
+        decoded->src = raw.src;
+        decoded->offset = raw.offset;
+        decoded->immediate = (uint64_t)(int64_t)raw.imm;
+
+        switch (UBPF_THREADED_CLASS(raw.opcode)) {
+        case UBPF_THREADED_CLASS_ALU64:
+            // 64-bit byte swap is not part of the supported instruction set, so END has no entry in this table.
+            decoded->handler = _ubpf_threaded_alu64_handlers[source_is_register][UBPF_THREADED_OP_INDEX(raw.opcode)];
+            break;
+        case UBPF_THREADED_CLASS_ALU:
+            if (operation == UBPF_THREADED_ALU_OP_END) {
+                decoded->handler = _ubpf_threaded_end_handler(source_is_register != 0, raw.imm);
+            } else {
+                decoded->handler =
+                    _ubpf_threaded_alu32_handlers[source_is_register][UBPF_THREADED_OP_INDEX(raw.opcode)];
+            }
+            break;
+        case UBPF_THREADED_CLASS_JMP:
+        case UBPF_THREADED_CLASS_JMP32: {
+            bool is_jmp32 = UBPF_THREADED_CLASS(raw.opcode) == UBPF_THREADED_CLASS_JMP32;
+            if (operation == UBPF_THREADED_JMP_OP_CALL && !is_jmp32) {
+                // Only calls to helper functions are supported.
+                decoded->handler = (raw.src == 0 && raw.imm >= 0) ? _ubpf_threaded_call : NULL;
+                decoded->helper_index = (uint32_t)raw.imm;
+                decoded->helper = NULL;
+                break;
+            }
+            if (operation == UBPF_THREADED_JMP_OP_EXIT && !is_jmp32) {
+                decoded->handler = _ubpf_threaded_exit;
+                break;
+            }
+            if (operation == UBPF_THREADED_JMP_OP_JA) {
+                decoded->handler = is_jmp32 ? NULL : _ubpf_threaded_ja;
+            } else if (is_jmp32) {
+                decoded->handler = _ubpf_threaded_jmp32_handlers[source_is_register][UBPF_THREADED_OP_INDEX(raw.opcode)];
+            } else {
+                decoded->handler = _ubpf_threaded_jmp64_handlers[source_is_register][UBPF_THREADED_OP_INDEX(raw.opcode)];
+            }
+
+            int64_t target = (int64_t)index + 1 + raw.offset;
+            if (target < 0 || target > (int64_t)instruction_count ||
+                decoded_index[(size_t)target] == UBPF_THREADED_INVALID_INDEX) {
+                result = EBPF_INVALID_ARGUMENT;
+                goto Done;
+            }
+            decoded->target = &new_program->instructions[decoded_index[(size_t)target]];
+            break;
+        }
+        case UBPF_THREADED_CLASS_LD:
+            if (raw.opcode == UBPF_THREADED_OP_LDDW) {
+                ubpf_threaded_raw_instruction_t high = _ubpf_threaded_read_instruction(instructions, ++index);
+                decoded->immediate = (uint64_t)(uint32_t)raw.imm | ((uint64_t)(uint32_t)high.imm << 32);
+                decoded->handler = _ubpf_threaded_lddw;
+            } else {
+                decoded->handler = NULL;
+            }
+            break;
+        case UBPF_THREADED_CLASS_LDX:
+        case UBPF_THREADED_CLASS_ST:
+        case UBPF_THREADED_CLASS_STX:
+            if (UBPF_THREADED_MODE(raw.opcode) != UBPF_THREADED_MODE_MEM) {
+                decoded->handler = NULL;
+            } else {
+                decoded->handler =
+                    _ubpf_threaded_memory_handler(UBPF_THREADED_CLASS(raw.opcode), UBPF_THREADED_SIZE(raw.opcode));
+            }
+            break;
+        }
+
+        if (decoded->handler == NULL) {
+            result = EBPF_INVALID_ARGUMENT;
+            goto Done;
+        }
+    }
+
+    *program = new_program;
+    new_program = NULL;
+    result = EBPF_SUCCESS;
+
+Done:
+    ebpf_free(new_program);
+    ebpf_free(decoded_index);
+    return result;
+}
+
+void
+ubpf_threaded_register(_Inout_ ubpf_threaded_program_t* program, uint32_t index, _In_opt_ void* helper)
+{
+    for (size_t instruction = 0; instruction < program->instruction_count; instruction++) {
+        ubpf_threaded_instruction_t* decoded = &program->instructions[instruction];
+        if (decoded->handler == _ubpf_threaded_call && decoded->helper_index == index) {
+            decoded->helper = helper;
+        }
+    }
+}
+
+_Must_inspect_result_ ebpf_result_t
+ubpf_threaded_exec(_In_ const ubpf_threaded_program_t* program, _In_opt_ void* context, _Out_ uint64_t* result)
+{
+    ubpf_threaded_state_t state = {0};
+    uint64_t stack[UBPF_THREADED_STACK_SIZE / sizeof(uint64_t)];
+    const ubpf_threaded_instruction_t* instruction = program->instructions;
+
+    state.registers[1] = (uintptr_t)context;
+    state.registers[UBPF_THREADED_FRAME_POINTER] = (uintptr_t)(stack + _countof(stack));
+
+    while (instruction != NULL) {
+        instruction = instruction->handler(&state, instruction);
+    }
+
+    *result = state.registers[0];
+    return state.failed ? EBPF_FAILED : EBPF_SUCCESS;
+}
+
+void
+ubpf_threaded_destroy(_In_opt_ _Post_invalid_ ubpf_threaded_program_t* program)
+{
+    ebpf_free(program);
+}
@@ -0,0 +1,74 @@
+// Copyright (c) Microsoft Corporation
+// SPDX-License-Identifier: MIT
+
+#pragma once
+
+#include "ebpf_platform.h"
+
+#ifdef __cplusplus
+extern "C"
+{
+#endif
+
+    /**
+     * @brief eBPF byte code that has been pre-decoded into threaded code. Each
+     * instruction carries a pointer to the handler that executes it, its operands
+     * pre-extracted, jump targets resolved to instruction pointers, and helper
+     * calls resolved to helper function addresses.
+     */
+    typedef struct _ubpf_threaded_program ubpf_threaded_program_t;
+
+    /**
+     * @brief Decode eBPF byte code into threaded code.
+     *
+     * @param[in] instructions eBPF instructions, 8 bytes each.
+     * @param[in] instruction_count Number of instructions.
+     * @param[out] program Pointer to memory that will contain the threaded
+     *  program on success.
+     * @retval EBPF_SUCCESS The operation was successful.
+     * @retval EBPF_NO_MEMORY Unable to allocate resources for this
+     *  operation.
+     * @retval EBPF_INVALID_ARGUMENT The byte code contains an instruction,
+     *  register or jump target that is not supported.
+     * @retval EBPF_PROGRAM_TOO_LARGE The byte code is too large.
+     */
+    _Must_inspect_result_ ebpf_result_t
+    ubpf_threaded_load(
+        _In_reads_(instruction_count) const uint64_t* instructions,
+        size_t instruction_count,
+        _Outptr_ ubpf_threaded_program_t** program);
+
+    /**
+     * @brief Resolve the helper function for all call instructions that use
+     *  a given helper index. May be called while the program is executing.
+     *
+     * @param[in, out] program Threaded program to update.
+     * @param[in] index Helper index, as encoded in the call instruction.
+     * @param[in] helper Address of the helper function.
+     */
+    void
+    ubpf_threaded_register(_Inout_ ubpf_threaded_program_t* program, uint32_t index, _In_opt_ void* helper);
+
+    /**
+     * @brief Execute a threaded program.
+     *
+     * @param[in] program Threaded program to execute.
+     * @param[in] context Context passed to the program in R1.
+     * @param[out] result Value of R0 when the program exits.
+     * @retval EBPF_SUCCESS The program ran to completion.
+     * @retval EBPF_FAILED The program called an unresolved helper function.
+     */
+    _Must_inspect_result_ ebpf_result_t
+    ubpf_threaded_exec(_In_ const ubpf_threaded_program_t* program, _In_opt_ void* context, _Out_ uint64_t* result);
+
+    /**
+     * @brief Free a threaded program.
+     *
+     * @param[in] program Threaded program to free.
+     */
+    void
+    ubpf_threaded_destroy(_In_opt_ _Post_invalid_ ubpf_threaded_program_t* program);
+
+#ifdef __cplusplus
+}
+#endif
@@ -1,4 +1,4 @@
 // Copyright (c) Microsoft Corporation
 // SPDX-License-Identifier: MIT
 
-#define EBPF_VERSION "0.5.0"
+#define EBPF_VERSION "0.6.0"
@@ -229,3 +229,35 @@ TEST_CASE("bad --hash", "[bpf2c_cli]")
     REQUIRE(result_value != 0);
     REQUIRE(!err.empty());
 }
+
+TEST_CASE("bad --jobs", "[bpf2c_cli]")
+{
+    std::vector<const char*> argv;
+    argv.push_back("bpf2c.exe");
+    argv.push_back("--jobs");
+    argv.push_back("0");
+
+    auto [out, err, result_value] = run_test_main(argv);
+    REQUIRE(result_value != 0);
+    REQUIRE(!err.empty());
+}
+
+TEST_CASE("--cache", "[bpf2c_cli]")
+{
+    auto cache_directory = std::filesystem::temp_directory_path() / "bpf2c_tests_cache";
+    std::filesystem::remove_all(cache_directory);
+    std::string cache = cache_directory.string();
+    std::vector<const char*> argv = {
+        "bpf2c.exe", "--bpf", "droppacket.o", "--hash", "none", "--jobs", "2", "--cache", cache.c_str()};
+
+    auto [out, err, result_value] = run_test_main(argv);
+    REQUIRE(result_value == 0);
+    REQUIRE(!std::filesystem::is_empty(cache_directory));
+
+    // The second run skips verification and generates the same code.
+    auto [cached_out, cached_err, cached_result_value] = run_test_main(argv);
+    REQUIRE(cached_result_value == 0);
+    REQUIRE(cached_out == out);
+
+    std::filesystem::remove_all(cache_directory);
+}
@@ -95,11 +95,7 @@ lookup(void* context)
     r0 = lookup_helpers[0].address
 #line 24 "sample/bad_map_name.c"
          (r1, r2, r3, r4, r5);
-#line 24 "sample/bad_map_name.c"
-    if ((lookup_helpers[0].tail_call) && (r0 == 0))
-#line 24 "sample/bad_map_name.c"
-        return 0;
-        // EBPF_OP_MOV64_REG pc=7 dst=r1 src=r0 offset=0 imm=0
+    // EBPF_OP_MOV64_REG pc=7 dst=r1 src=r0 offset=0 imm=0
 #line 24 "sample/bad_map_name.c"
     r1 = r0;
     // EBPF_OP_MOV64_IMM pc=8 dst=r0 src=r0 offset=0 imm=1
@@ -152,7 +148,7 @@ static void
 _get_version(_Out_ bpf2c_version_t* version)
 {
     version->major = 0;
-    version->minor = 5;
+    version->minor = 6;
     version->revision = 0;
 }
 
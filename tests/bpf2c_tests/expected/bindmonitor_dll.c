@@ -154,14 +154,20 @@ BindMonitor(void* context)
     r1 = POINTER(_maps[1].address);
     // EBPF_OP_CALL pc=7 dst=r0 src=r0 offset=0 imm=1
 #line 82 "sample/bindmonitor.c"
-    r0 = BindMonitor_helpers[0].address
+    if (_maps[1].array_data != NULL) {
 #line 82 "sample/bindmonitor.c"
-         (r1, r2, r3, r4, r5);
+        r0 = *(uint32_t*)(uintptr_t)r2;
+#line 82 "sample/bindmonitor.c"
+        r0 = (r0 < 1) ? POINTER((uint8_t*)_maps[1].array_data + r0 * 4) : 0;
+#line 82 "sample/bindmonitor.c"
+    } else {
 #line 82 "sample/bindmonitor.c"
-    if ((BindMonitor_helpers[0].tail_call) && (r0 == 0))
+        r0 = BindMonitor_helpers[0].address
 #line 82 "sample/bindmonitor.c"
-        return 0;
-        // EBPF_OP_MOV64_REG pc=8 dst=r7 src=r0 offset=0 imm=0
+             (r1, r2, r3, r4, r5);
+#line 82 "sample/bindmonitor.c"
+    }
+    // EBPF_OP_MOV64_REG pc=8 dst=r7 src=r0 offset=0 imm=0
 #line 82 "sample/bindmonitor.c"
     r7 = r0;
     // EBPF_OP_JEQ_IMM pc=9 dst=r7 src=r0 offset=82 imm=0
@@ -227,11 +233,7 @@ BindMonitor(void* context)
     r0 = BindMonitor_helpers[0].address
 #line 47 "sample/bindmonitor.c"
          (r1, r2, r3, r4, r5);
-#line 47 "sample/bindmonitor.c"
-    if ((BindMonitor_helpers[0].tail_call) && (r0 == 0))
-#line 47 "sample/bindmonitor.c"
-        return 0;
-        // EBPF_OP_JEQ_IMM pc=29 dst=r0 src=r0 offset=1 imm=0
+    // EBPF_OP_JEQ_IMM pc=29 dst=r0 src=r0 offset=1 imm=0
 #line 48 "sample/bindmonitor.c"
     if (r0 == IMMEDIATE(0))
 #line 48 "sample/bindmonitor.c"
@@ -293,11 +295,7 @@ label_1:
     r0 = BindMonitor_helpers[1].address
 #line 57 "sample/bindmonitor.c"
          (r1, r2, r3, r4, r5);
-#line 57 "sample/bindmonitor.c"
-    if ((BindMonitor_helpers[1].tail_call) && (r0 == 0))
-#line 57 "sample/bindmonitor.c"
-        return 0;
-        // EBPF_OP_LDDW pc=47 dst=r1 src=r0 offset=0 imm=0
+    // EBPF_OP_LDDW pc=47 dst=r1 src=r0 offset=0 imm=0
 #line 58 "sample/bindmonitor.c"
     r1 = POINTER(_maps[0].address);
     // EBPF_OP_MOV64_REG pc=49 dst=r2 src=r8 offset=0 imm=0
@@ -308,11 +306,7 @@ label_1:
     r0 = BindMonitor_helpers[0].address
 #line 58 "sample/bindmonitor.c"
          (r1, r2, r3, r4, r5);
-#line 58 "sample/bindmonitor.c"
-    if ((BindMonitor_helpers[0].tail_call) && (r0 == 0))
-#line 58 "sample/bindmonitor.c"
-        return 0;
-        // EBPF_OP_JEQ_IMM pc=51 dst=r0 src=r0 offset=39 imm=0
+    // EBPF_OP_JEQ_IMM pc=51 dst=r0 src=r0 offset=39 imm=0
 #line 59 "sample/bindmonitor.c"
     if (r0 == IMMEDIATE(0))
 #line 59 "sample/bindmonitor.c"
@@ -453,10 +447,6 @@ label_7:
     r0 = BindMonitor_helpers[2].address
 #line 110 "sample/bindmonitor.c"
          (r1, r2, r3, r4, r5);
-#line 110 "sample/bindmonitor.c"
-    if ((BindMonitor_helpers[2].tail_call) && (r0 == 0))
-#line 110 "sample/bindmonitor.c"
-        return 0;
 label_8:
     // EBPF_OP_MOV64_IMM pc=91 dst=r8 src=r0 offset=0 imm=0
 #line 110 "sample/bindmonitor.c"
@@ -503,7 +493,7 @@ static void
 _get_version(_Out_ bpf2c_version_t* version)
 {
     version->major = 0;
-    version->minor = 5;
+    version->minor = 6;
     version->revision = 0;
 }
 
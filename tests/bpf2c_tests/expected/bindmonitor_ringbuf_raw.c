@@ -110,10 +110,6 @@ bind_monitor(void* context)
     r0 = bind_monitor_helpers[0].address
 #line 26 "sample/bindmonitor_ringbuf.c"
          (r1, r2, r3, r4, r5);
-#line 26 "sample/bindmonitor_ringbuf.c"
-    if ((bind_monitor_helpers[0].tail_call) && (r0 == 0))
-#line 26 "sample/bindmonitor_ringbuf.c"
-        return 0;
 label_1:
     // EBPF_OP_MOV64_IMM pc=10 dst=r0 src=r0 offset=0 imm=0
 #line 32 "sample/bindmonitor_ringbuf.c"
@@ -156,7 +152,7 @@ static void
 _get_version(_Out_ bpf2c_version_t* version)
 {
     version->major = 0;
-    version->minor = 5;
+    version->minor = 6;
     version->revision = 0;
 }
 
@@ -176,11 +176,7 @@ BindMonitor(void* context)
     r0 = BindMonitor_helpers[0].address
 #line 117 "sample/bindmonitor_tailcall.c"
          (r1, r2, r3, r4, r5);
-#line 117 "sample/bindmonitor_tailcall.c"
-    if ((BindMonitor_helpers[0].tail_call) && (r0 == 0))
-#line 117 "sample/bindmonitor_tailcall.c"
-        return 0;
-        // EBPF_OP_JNE_IMM pc=8 dst=r0 src=r0 offset=5 imm=0
+    // EBPF_OP_JNE_IMM pc=8 dst=r0 src=r0 offset=5 imm=0
 #line 119 "sample/bindmonitor_tailcall.c"
     if (r0 != IMMEDIATE(0))
 #line 119 "sample/bindmonitor_tailcall.c"
@@ -283,11 +279,7 @@ BindMonitor_Callee0(void* context)
     r0 = BindMonitor_Callee0_helpers[0].address
 #line 133 "sample/bindmonitor_tailcall.c"
          (r1, r2, r3, r4, r5);
-#line 133 "sample/bindmonitor_tailcall.c"
-    if ((BindMonitor_Callee0_helpers[0].tail_call) && (r0 == 0))
-#line 133 "sample/bindmonitor_tailcall.c"
-        return 0;
-        // EBPF_OP_JNE_IMM pc=8 dst=r0 src=r0 offset=5 imm=0
+    // EBPF_OP_JNE_IMM pc=8 dst=r0 src=r0 offset=5 imm=0
 #line 135 "sample/bindmonitor_tailcall.c"
     if (r0 != IMMEDIATE(0))
 #line 135 "sample/bindmonitor_tailcall.c"
@@ -394,14 +386,20 @@ BindMonitor_Callee1(void* context)
     r1 = POINTER(_maps[1].address);
     // EBPF_OP_CALL pc=7 dst=r0 src=r0 offset=0 imm=1
 #line 150 "sample/bindmonitor_tailcall.c"
-    r0 = BindMonitor_Callee1_helpers[0].address
+    if (_maps[1].array_data != NULL) {
 #line 150 "sample/bindmonitor_tailcall.c"
-         (r1, r2, r3, r4, r5);
+        r0 = *(uint32_t*)(uintptr_t)r2;
 #line 150 "sample/bindmonitor_tailcall.c"
-    if ((BindMonitor_Callee1_helpers[0].tail_call) && (r0 == 0))
+        r0 = (r0 < 1) ? POINTER((uint8_t*)_maps[1].array_data + r0 * 4) : 0;
 #line 150 "sample/bindmonitor_tailcall.c"
-        return 0;
-        // EBPF_OP_MOV64_REG pc=8 dst=r7 src=r0 offset=0 imm=0
+    } else {
+#line 150 "sample/bindmonitor_tailcall.c"
+        r0 = BindMonitor_Callee1_helpers[0].address
+#line 150 "sample/bindmonitor_tailcall.c"
+             (r1, r2, r3, r4, r5);
+#line 150 "sample/bindmonitor_tailcall.c"
+    }
+    // EBPF_OP_MOV64_REG pc=8 dst=r7 src=r0 offset=0 imm=0
 #line 150 "sample/bindmonitor_tailcall.c"
     r7 = r0;
     // EBPF_OP_JEQ_IMM pc=9 dst=r7 src=r0 offset=82 imm=0
@@ -467,11 +465,7 @@ BindMonitor_Callee1(void* context)
     r0 = BindMonitor_Callee1_helpers[0].address
 #line 83 "sample/bindmonitor_tailcall.c"
          (r1, r2, r3, r4, r5);
-#line 83 "sample/bindmonitor_tailcall.c"
-    if ((BindMonitor_Callee1_helpers[0].tail_call) && (r0 == 0))
-#line 83 "sample/bindmonitor_tailcall.c"
-        return 0;
-        // EBPF_OP_JEQ_IMM pc=29 dst=r0 src=r0 offset=1 imm=0
+    // EBPF_OP_JEQ_IMM pc=29 dst=r0 src=r0 offset=1 imm=0
 #line 84 "sample/bindmonitor_tailcall.c"
     if (r0 == IMMEDIATE(0))
 #line 84 "sample/bindmonitor_tailcall.c"
@@ -533,11 +527,7 @@ label_1:
     r0 = BindMonitor_Callee1_helpers[1].address
 #line 93 "sample/bindmonitor_tailcall.c"
          (r1, r2, r3, r4, r5);
-#line 93 "sample/bindmonitor_tailcall.c"
-    if ((BindMonitor_Callee1_helpers[1].tail_call) && (r0 == 0))
-#line 93 "sample/bindmonitor_tailcall.c"
-        return 0;
-        // EBPF_OP_LDDW pc=47 dst=r1 src=r0 offset=0 imm=0
+    // EBPF_OP_LDDW pc=47 dst=r1 src=r0 offset=0 imm=0
 #line 94 "sample/bindmonitor_tailcall.c"
     r1 = POINTER(_maps[0].address);
     // EBPF_OP_MOV64_REG pc=49 dst=r2 src=r8 offset=0 imm=0
@@ -548,11 +538,7 @@ label_1:
     r0 = BindMonitor_Callee1_helpers[0].address
 #line 94 "sample/bindmonitor_tailcall.c"
          (r1, r2, r3, r4, r5);
-#line 94 "sample/bindmonitor_tailcall.c"
-    if ((BindMonitor_Callee1_helpers[0].tail_call) && (r0 == 0))
-#line 94 "sample/bindmonitor_tailcall.c"
-        return 0;
-        // EBPF_OP_JEQ_IMM pc=51 dst=r0 src=r0 offset=39 imm=0
+    // EBPF_OP_JEQ_IMM pc=51 dst=r0 src=r0 offset=39 imm=0
 #line 95 "sample/bindmonitor_tailcall.c"
     if (r0 == IMMEDIATE(0))
 #line 95 "sample/bindmonitor_tailcall.c"
@@ -693,10 +679,6 @@ label_7:
     r0 = BindMonitor_Callee1_helpers[2].address
 #line 178 "sample/bindmonitor_tailcall.c"
          (r1, r2, r3, r4, r5);
-#line 178 "sample/bindmonitor_tailcall.c"
-    if ((BindMonitor_Callee1_helpers[2].tail_call) && (r0 == 0))
-#line 178 "sample/bindmonitor_tailcall.c"
-        return 0;
 label_8:
     // EBPF_OP_MOV64_IMM pc=91 dst=r8 src=r0 offset=0 imm=0
 #line 178 "sample/bindmonitor_tailcall.c"
@@ -771,7 +753,7 @@ static void
 _get_version(_Out_ bpf2c_version_t* version)
 {
     version->major = 0;
-    version->minor = 5;
+    version->minor = 6;
     version->revision = 0;
 }
 
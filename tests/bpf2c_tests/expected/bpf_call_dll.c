@@ -144,11 +144,7 @@ func(void* context)
     r0 = func_helpers[0].address
 #line 22 "sample/bpf_call.c"
          (r1, r2, r3, r4, r5);
-#line 22 "sample/bpf_call.c"
-    if ((func_helpers[0].tail_call) && (r0 == 0))
-#line 22 "sample/bpf_call.c"
-        return 0;
-        // EBPF_OP_EXIT pc=12 dst=r0 src=r0 offset=0 imm=0
+    // EBPF_OP_EXIT pc=12 dst=r0 src=r0 offset=0 imm=0
 #line 23 "sample/bpf_call.c"
     return r0;
 #line 23 "sample/bpf_call.c"
@@ -186,7 +182,7 @@ static void
 _get_version(_Out_ bpf2c_version_t* version)
 {
     version->major = 0;
-    version->minor = 5;
+    version->minor = 6;
     version->revision = 0;
 }
 
@@ -320,11 +320,7 @@ label_1:
     r0 = connect_redirect4_helpers[0].address
 #line 48 "sample/cgroup_sock_addr2.c"
          (r1, r2, r3, r4, r5);
-#line 48 "sample/cgroup_sock_addr2.c"
-    if ((connect_redirect4_helpers[0].tail_call) && (r0 == 0))
-#line 48 "sample/cgroup_sock_addr2.c"
-        return 0;
-        // EBPF_OP_MOV64_REG pc=21 dst=r8 src=r0 offset=0 imm=0
+    // EBPF_OP_MOV64_REG pc=21 dst=r8 src=r0 offset=0 imm=0
 #line 48 "sample/cgroup_sock_addr2.c"
     r8 = r0;
     // EBPF_OP_JEQ_IMM pc=22 dst=r8 src=r0 offset=27 imm=0
@@ -388,11 +384,7 @@ label_1:
     r0 = connect_redirect4_helpers[1].address
 #line 50 "sample/cgroup_sock_addr2.c"
          (r1, r2, r3, r4, r5);
-#line 50 "sample/cgroup_sock_addr2.c"
-    if ((connect_redirect4_helpers[1].tail_call) && (r0 == 0))
-#line 50 "sample/cgroup_sock_addr2.c"
-        return 0;
-        // EBPF_OP_LDXW pc=45 dst=r1 src=r8 offset=0 imm=0
+    // EBPF_OP_LDXW pc=45 dst=r1 src=r8 offset=0 imm=0
 #line 51 "sample/cgroup_sock_addr2.c"
     r1 = *(uint32_t*)(uintptr_t)(r8 + OFFSET(0));
     // EBPF_OP_STXW pc=46 dst=r6 src=r1 offset=24 imm=0
@@ -557,11 +549,7 @@ label_1:
     r0 = connect_redirect6_helpers[0].address
 #line 82 "sample/cgroup_sock_addr2.c"
          (r1, r2, r3, r4, r5);
-#line 82 "sample/cgroup_sock_addr2.c"
-    if ((connect_redirect6_helpers[0].tail_call) && (r0 == 0))
-#line 82 "sample/cgroup_sock_addr2.c"
-        return 0;
-        // EBPF_OP_MOV64_REG pc=28 dst=r8 src=r0 offset=0 imm=0
+    // EBPF_OP_MOV64_REG pc=28 dst=r8 src=r0 offset=0 imm=0
 #line 82 "sample/cgroup_sock_addr2.c"
     r8 = r0;
     // EBPF_OP_JEQ_IMM pc=29 dst=r8 src=r0 offset=30 imm=0
@@ -619,11 +607,7 @@ label_1:
     r0 = connect_redirect6_helpers[1].address
 #line 84 "sample/cgroup_sock_addr2.c"
          (r1, r2, r3, r4, r5);
-#line 84 "sample/cgroup_sock_addr2.c"
-    if ((connect_redirect6_helpers[1].tail_call) && (r0 == 0))
-#line 84 "sample/cgroup_sock_addr2.c"
-        return 0;
-        // EBPF_OP_LDXW pc=49 dst=r1 src=r8 offset=12 imm=0
+    // EBPF_OP_LDXW pc=49 dst=r1 src=r8 offset=12 imm=0
 #line 85 "sample/cgroup_sock_addr2.c"
     r1 = *(uint32_t*)(uintptr_t)(r8 + OFFSET(12));
     // EBPF_OP_STXW pc=50 dst=r7 src=r1 offset=12 imm=0
@@ -712,7 +696,7 @@ static void
 _get_version(_Out_ bpf2c_version_t* version)
 {
     version->major = 0;
-    version->minor = 5;
+    version->minor = 6;
     version->revision = 0;
 }
 
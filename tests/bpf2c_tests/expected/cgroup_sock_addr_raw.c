@@ -145,11 +145,7 @@ authorize_connect4(void* context)
     r0 = authorize_connect4_helpers[0].address
 #line 41 "sample/cgroup_sock_addr.c"
          (r1, r2, r3, r4, r5);
-#line 41 "sample/cgroup_sock_addr.c"
-    if ((authorize_connect4_helpers[0].tail_call) && (r0 == 0))
-#line 41 "sample/cgroup_sock_addr.c"
-        return 0;
-        // EBPF_OP_MOV64_REG pc=19 dst=r1 src=r0 offset=0 imm=0
+    // EBPF_OP_MOV64_REG pc=19 dst=r1 src=r0 offset=0 imm=0
 #line 41 "sample/cgroup_sock_addr.c"
     r1 = r0;
     // EBPF_OP_MOV64_IMM pc=20 dst=r0 src=r0 offset=0 imm=1
@@ -287,11 +283,7 @@ authorize_connect6(void* context)
     r0 = authorize_connect6_helpers[0].address
 #line 55 "sample/cgroup_sock_addr.c"
          (r1, r2, r3, r4, r5);
-#line 55 "sample/cgroup_sock_addr.c"
-    if ((authorize_connect6_helpers[0].tail_call) && (r0 == 0))
-#line 55 "sample/cgroup_sock_addr.c"
-        return 0;
-        // EBPF_OP_MOV64_REG pc=25 dst=r1 src=r0 offset=0 imm=0
+    // EBPF_OP_MOV64_REG pc=25 dst=r1 src=r0 offset=0 imm=0
 #line 55 "sample/cgroup_sock_addr.c"
     r1 = r0;
     // EBPF_OP_MOV64_IMM pc=26 dst=r0 src=r0 offset=0 imm=1
@@ -411,11 +403,7 @@ authorize_recv_accept4(void* context)
     r0 = authorize_recv_accept4_helpers[0].address
 #line 41 "sample/cgroup_sock_addr.c"
          (r1, r2, r3, r4, r5);
-#line 41 "sample/cgroup_sock_addr.c"
-    if ((authorize_recv_accept4_helpers[0].tail_call) && (r0 == 0))
-#line 41 "sample/cgroup_sock_addr.c"
-        return 0;
-        // EBPF_OP_MOV64_REG pc=19 dst=r1 src=r0 offset=0 imm=0
+    // EBPF_OP_MOV64_REG pc=19 dst=r1 src=r0 offset=0 imm=0
 #line 41 "sample/cgroup_sock_addr.c"
     r1 = r0;
     // EBPF_OP_MOV64_IMM pc=20 dst=r0 src=r0 offset=0 imm=1
@@ -553,11 +541,7 @@ authorize_recv_accept6(void* context)
     r0 = authorize_recv_accept6_helpers[0].address
 #line 55 "sample/cgroup_sock_addr.c"
          (r1, r2, r3, r4, r5);
-#line 55 "sample/cgroup_sock_addr.c"
-    if ((authorize_recv_accept6_helpers[0].tail_call) && (r0 == 0))
-#line 55 "sample/cgroup_sock_addr.c"
-        return 0;
-        // EBPF_OP_MOV64_REG pc=25 dst=r1 src=r0 offset=0 imm=0
+    // EBPF_OP_MOV64_REG pc=25 dst=r1 src=r0 offset=0 imm=0
 #line 55 "sample/cgroup_sock_addr.c"
     r1 = r0;
     // EBPF_OP_MOV64_IMM pc=26 dst=r0 src=r0 offset=0 imm=1
@@ -652,7 +636,7 @@ static void
 _get_version(_Out_ bpf2c_version_t* version)
 {
     version->major = 0;
-    version->minor = 5;
+    version->minor = 6;
     version->revision = 0;
 }
 
@@ -412,11 +412,7 @@ decapsulate_permit_packet(void* context)
     r0 = decapsulate_permit_packet_helpers[0].address
 #line 39 "sample/decap_permit_packet.c"
          (r1, r2, r3, r4, r5);
-#line 39 "sample/decap_permit_packet.c"
-    if ((decapsulate_permit_packet_helpers[0].tail_call) && (r0 == 0))
-#line 39 "sample/decap_permit_packet.c"
-        return 0;
-        // EBPF_OP_MOV64_REG pc=57 dst=r1 src=r0 offset=0 imm=0
+    // EBPF_OP_MOV64_REG pc=57 dst=r1 src=r0 offset=0 imm=0
 #line 39 "sample/decap_permit_packet.c"
     r1 = r0;
     // EBPF_OP_LSH64_IMM pc=58 dst=r1 src=r0 offset=0 imm=32
@@ -562,11 +558,7 @@ label_1:
     r0 = decapsulate_permit_packet_helpers[0].address
 #line 66 "sample/decap_permit_packet.c"
          (r1, r2, r3, r4, r5);
-#line 66 "sample/decap_permit_packet.c"
-    if ((decapsulate_permit_packet_helpers[0].tail_call) && (r0 == 0))
-#line 66 "sample/decap_permit_packet.c"
-        return 0;
-        // EBPF_OP_MOV64_REG pc=102 dst=r1 src=r0 offset=0 imm=0
+    // EBPF_OP_MOV64_REG pc=102 dst=r1 src=r0 offset=0 imm=0
 #line 66 "sample/decap_permit_packet.c"
     r1 = r0;
     // EBPF_OP_LSH64_IMM pc=103 dst=r1 src=r0 offset=0 imm=32
@@ -629,7 +621,7 @@ static void
 _get_version(_Out_ bpf2c_version_t* version)
 {
     version->major = 0;
-    version->minor = 5;
+    version->minor = 6;
     version->revision = 0;
 }
 
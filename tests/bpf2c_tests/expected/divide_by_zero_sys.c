@@ -263,14 +263,20 @@ divide_by_zero(void* context)
     r1 = POINTER(_maps[0].address);
     // EBPF_OP_CALL pc=6 dst=r0 src=r0 offset=0 imm=1
 #line 30 "sample/divide_by_zero.c"
-    r0 = divide_by_zero_helpers[0].address
+    if (_maps[0].array_data != NULL) {
 #line 30 "sample/divide_by_zero.c"
-         (r1, r2, r3, r4, r5);
+        r0 = *(uint32_t*)(uintptr_t)r2;
 #line 30 "sample/divide_by_zero.c"
-    if ((divide_by_zero_helpers[0].tail_call) && (r0 == 0))
+        r0 = (r0 < 1) ? POINTER((uint8_t*)_maps[0].array_data + r0 * 4) : 0;
 #line 30 "sample/divide_by_zero.c"
-        return 0;
-        // EBPF_OP_JEQ_IMM pc=7 dst=r0 src=r0 offset=3 imm=0
+    } else {
+#line 30 "sample/divide_by_zero.c"
+        r0 = divide_by_zero_helpers[0].address
+#line 30 "sample/divide_by_zero.c"
+             (r1, r2, r3, r4, r5);
+#line 30 "sample/divide_by_zero.c"
+    }
+    // EBPF_OP_JEQ_IMM pc=7 dst=r0 src=r0 offset=3 imm=0
 #line 31 "sample/divide_by_zero.c"
     if (r0 == IMMEDIATE(0))
 #line 31 "sample/divide_by_zero.c"
@@ -326,7 +332,7 @@ static void
 _get_version(_Out_ bpf2c_version_t* version)
 {
     version->major = 0;
-    version->minor = 5;
+    version->minor = 6;
     version->revision = 0;
 }
 
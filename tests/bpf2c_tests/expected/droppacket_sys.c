@@ -279,14 +279,20 @@ DropPacket(void* context)
     r1 = POINTER(_maps[1].address);
     // EBPF_OP_CALL pc=7 dst=r0 src=r0 offset=0 imm=1
 #line 48 "sample/droppacket.c"
-    r0 = DropPacket_helpers[0].address
+    if (_maps[1].array_data != NULL) {
 #line 48 "sample/droppacket.c"
-         (r1, r2, r3, r4, r5);
+        r0 = *(uint32_t*)(uintptr_t)r2;
 #line 48 "sample/droppacket.c"
-    if ((DropPacket_helpers[0].tail_call) && (r0 == 0))
+        r0 = (r0 < 1) ? POINTER((uint8_t*)_maps[1].array_data + r0 * 4) : 0;
 #line 48 "sample/droppacket.c"
-        return 0;
-        // EBPF_OP_MOV64_REG pc=8 dst=r1 src=r0 offset=0 imm=0
+    } else {
+#line 48 "sample/droppacket.c"
+        r0 = DropPacket_helpers[0].address
+#line 48 "sample/droppacket.c"
+             (r1, r2, r3, r4, r5);
+#line 48 "sample/droppacket.c"
+    }
+    // EBPF_OP_MOV64_REG pc=8 dst=r1 src=r0 offset=0 imm=0
 #line 48 "sample/droppacket.c"
     r1 = r0;
     // EBPF_OP_JEQ_IMM pc=9 dst=r1 src=r0 offset=4 imm=0
@@ -377,8 +383,6 @@ label_1:
     // EBPF_OP_BE pc=33 dst=r1 src=r0 offset=0 imm=16
 #line 69 "sample/droppacket.c"
     r1 = htobe16((uint16_t)r1);
-#line 69 "sample/droppacket.c"
-    r1 &= UINT32_MAX;
     // EBPF_OP_JGT_IMM pc=34 dst=r1 src=r0 offset=11 imm=8
 #line 69 "sample/droppacket.c"
     if (r1 > IMMEDIATE(8))
@@ -395,14 +399,20 @@ label_1:
     r1 = POINTER(_maps[0].address);
     // EBPF_OP_CALL pc=39 dst=r0 src=r0 offset=0 imm=1
 #line 70 "sample/droppacket.c"
-    r0 = DropPacket_helpers[0].address
+    if (_maps[0].array_data != NULL) {
 #line 70 "sample/droppacket.c"
-         (r1, r2, r3, r4, r5);
+        r0 = *(uint32_t*)(uintptr_t)r2;
 #line 70 "sample/droppacket.c"
-    if ((DropPacket_helpers[0].tail_call) && (r0 == 0))
+        r0 = (r0 < 1) ? POINTER((uint8_t*)_maps[0].array_data + r0 * 8) : 0;
 #line 70 "sample/droppacket.c"
-        return 0;
-        // EBPF_OP_MOV64_REG pc=40 dst=r1 src=r0 offset=0 imm=0
+    } else {
+#line 70 "sample/droppacket.c"
+        r0 = DropPacket_helpers[0].address
+#line 70 "sample/droppacket.c"
+             (r1, r2, r3, r4, r5);
+#line 70 "sample/droppacket.c"
+    }
+    // EBPF_OP_MOV64_REG pc=40 dst=r1 src=r0 offset=0 imm=0
 #line 70 "sample/droppacket.c"
     r1 = r0;
     // EBPF_OP_MOV64_IMM pc=41 dst=r0 src=r0 offset=0 imm=2
@@ -461,7 +471,7 @@ static void
 _get_version(_Out_ bpf2c_version_t* version)
 {
     version->major = 0;
-    version->minor = 5;
+    version->minor = 6;
     version->revision = 0;
 }
 
@@ -86,8 +86,6 @@ DropPacket(void* context)
     // EBPF_OP_BE pc=5 dst=r1 src=r0 offset=0 imm=16
 #line 10 "bpf_endian.h"
     r1 = htobe16((uint16_t)r1);
-#line 10 "bpf_endian.h"
-    r1 &= UINT32_MAX;
     // EBPF_OP_JGT_IMM pc=6 dst=r1 src=r0 offset=12 imm=8
 #line 38 "sample/droppacket_unsafe.c"
     if (r1 > IMMEDIATE(8))
@@ -109,13 +107,20 @@ DropPacket(void* context)
     r1 = POINTER(_maps[0].address);
     // EBPF_OP_CALL pc=13 dst=r0 src=r0 offset=0 imm=1
 #line 40 "sample/droppacket_unsafe.c"
-    r0 = DropPacket_helpers[0].address
+    if (_maps[0].array_data != NULL) {
+#line 40 "sample/droppacket_unsafe.c"
+        r0 = *(uint32_t*)(uintptr_t)r2;
+#line 40 "sample/droppacket_unsafe.c"
+        r0 = (r0 < 1) ? POINTER((uint8_t*)_maps[0].array_data + r0 * 8) : 0;
+#line 40 "sample/droppacket_unsafe.c"
+    } else {
+#line 40 "sample/droppacket_unsafe.c"
+        r0 = DropPacket_helpers[0].address
 #line 40 "sample/droppacket_unsafe.c"
-         (r1, r2, r3, r4, r5);
+             (r1, r2, r3, r4, r5);
 #line 40 "sample/droppacket_unsafe.c"
-    if ((DropPacket_helpers[0].tail_call) && (r0 == 0))
-        return 0;
-        // EBPF_OP_JEQ_IMM pc=14 dst=r0 src=r0 offset=3 imm=0
+    }
+    // EBPF_OP_JEQ_IMM pc=14 dst=r0 src=r0 offset=3 imm=0
 #line 41 "sample/droppacket_unsafe.c"
     if (r0 == IMMEDIATE(0))
         goto label_1;
@@ -190,11 +190,7 @@ encap_reflect_packet(void* context)
     r0 = encap_reflect_packet_helpers[0].address
 #line 22 "sample/encap_reflect_packet.c"
          (r1, r2, r3, r4, r5);
-#line 22 "sample/encap_reflect_packet.c"
-    if ((encap_reflect_packet_helpers[0].tail_call) && (r0 == 0))
-#line 22 "sample/encap_reflect_packet.c"
-        return 0;
-        // EBPF_OP_MOV64_REG pc=28 dst=r1 src=r0 offset=0 imm=0
+    // EBPF_OP_MOV64_REG pc=28 dst=r1 src=r0 offset=0 imm=0
 #line 22 "sample/encap_reflect_packet.c"
     r1 = r0;
     // EBPF_OP_MOV64_IMM pc=29 dst=r0 src=r0 offset=0 imm=2
@@ -399,16 +395,12 @@ encap_reflect_packet(void* context)
     // EBPF_OP_BE pc=92 dst=r1 src=r0 offset=0 imm=16
 #line 64 "sample/encap_reflect_packet.c"
     r1 = htobe16((uint16_t)r1);
-#line 64 "sample/encap_reflect_packet.c"
-    r1 &= UINT32_MAX;
     // EBPF_OP_ADD64_IMM pc=93 dst=r1 src=r0 offset=0 imm=20
 #line 64 "sample/encap_reflect_packet.c"
     r1 += IMMEDIATE(20);
     // EBPF_OP_BE pc=94 dst=r1 src=r0 offset=0 imm=16
 #line 64 "sample/encap_reflect_packet.c"
     r1 = htobe16((uint16_t)r1);
-#line 64 "sample/encap_reflect_packet.c"
-    r1 &= UINT32_MAX;
     // EBPF_OP_STXH pc=95 dst=r6 src=r1 offset=16 imm=0
 #line 64 "sample/encap_reflect_packet.c"
     *(uint16_t*)(uintptr_t)(r6 + OFFSET(16)) = (uint16_t)r1;
@@ -435,11 +427,7 @@ encap_reflect_packet(void* context)
     r0 = encap_reflect_packet_helpers[1].address
 #line 68 "sample/encap_reflect_packet.c"
          (r1, r2, r3, r4, r5);
-#line 68 "sample/encap_reflect_packet.c"
-    if ((encap_reflect_packet_helpers[1].tail_call) && (r0 == 0))
-#line 68 "sample/encap_reflect_packet.c"
-        return 0;
-        // EBPF_OP_MOV64_REG pc=103 dst=r1 src=r0 offset=0 imm=0
+    // EBPF_OP_MOV64_REG pc=103 dst=r1 src=r0 offset=0 imm=0
 #line 41 "sample/./xdp_common.h"
     r1 = r0;
     // EBPF_OP_AND64_IMM pc=104 dst=r1 src=r0 offset=0 imm=65535
@@ -522,11 +510,7 @@ label_1:
     r0 = encap_reflect_packet_helpers[0].address
 #line 82 "sample/encap_reflect_packet.c"
          (r1, r2, r3, r4, r5);
-#line 82 "sample/encap_reflect_packet.c"
-    if ((encap_reflect_packet_helpers[0].tail_call) && (r0 == 0))
-#line 82 "sample/encap_reflect_packet.c"
-        return 0;
-        // EBPF_OP_MOV64_REG pc=128 dst=r1 src=r0 offset=0 imm=0
+    // EBPF_OP_MOV64_REG pc=128 dst=r1 src=r0 offset=0 imm=0
 #line 82 "sample/encap_reflect_packet.c"
     r1 = r0;
     // EBPF_OP_MOV64_IMM pc=129 dst=r0 src=r0 offset=0 imm=2
@@ -1031,16 +1015,12 @@ label_1:
     // EBPF_OP_BE pc=292 dst=r2 src=r0 offset=0 imm=16
 #line 123 "sample/encap_reflect_packet.c"
     r2 = htobe16((uint16_t)r2);
-#line 123 "sample/encap_reflect_packet.c"
-    r2 &= UINT32_MAX;
     // EBPF_OP_ADD64_IMM pc=293 dst=r2 src=r0 offset=0 imm=40
 #line 123 "sample/encap_reflect_packet.c"
     r2 += IMMEDIATE(40);
     // EBPF_OP_BE pc=294 dst=r2 src=r0 offset=0 imm=16
 #line 123 "sample/encap_reflect_packet.c"
     r2 = htobe16((uint16_t)r2);
-#line 123 "sample/encap_reflect_packet.c"
-    r2 &= UINT32_MAX;
     // EBPF_OP_STXH pc=295 dst=r1 src=r2 offset=18 imm=0
 #line 123 "sample/encap_reflect_packet.c"
     *(uint16_t*)(uintptr_t)(r1 + OFFSET(18)) = (uint16_t)r2;
@@ -1087,7 +1067,7 @@ static void
 _get_version(_Out_ bpf2c_version_t* version)
 {
     version->major = 0;
-    version->minor = 5;
+    version->minor = 6;
     version->revision = 0;
 }
 
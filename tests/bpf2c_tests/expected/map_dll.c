@@ -248,11 +248,7 @@ test_maps(void* context)
     r0 = test_maps_helpers[0].address
 #line 76 "sample/map.c"
          (r1, r2, r3, r4, r5);
-#line 76 "sample/map.c"
-    if ((test_maps_helpers[0].tail_call) && (r0 == 0))
-#line 76 "sample/map.c"
-        return 0;
-        // EBPF_OP_MOV64_REG pc=12 dst=r6 src=r0 offset=0 imm=0
+    // EBPF_OP_MOV64_REG pc=12 dst=r6 src=r0 offset=0 imm=0
 #line 76 "sample/map.c"
     r6 = r0;
     // EBPF_OP_LSH64_IMM pc=13 dst=r6 src=r0 offset=0 imm=32
@@ -280,11 +276,7 @@ test_maps(void* context)
     r0 = test_maps_helpers[1].address
 #line 82 "sample/map.c"
          (r1, r2, r3, r4, r5);
-#line 82 "sample/map.c"
-    if ((test_maps_helpers[1].tail_call) && (r0 == 0))
-#line 82 "sample/map.c"
-        return 0;
-        // EBPF_OP_LDDW pc=21 dst=r6 src=r0 offset=0 imm=-1
+    // EBPF_OP_LDDW pc=21 dst=r6 src=r0 offset=0 imm=-1
 #line 82 "sample/map.c"
     r6 = (uint64_t)4294967295;
     // EBPF_OP_JEQ_IMM pc=23 dst=r0 src=r0 offset=22 imm=0
@@ -306,11 +298,7 @@ test_maps(void* context)
     r0 = test_maps_helpers[2].address
 #line 88 "sample/map.c"
          (r1, r2, r3, r4, r5);
-#line 88 "sample/map.c"
-    if ((test_maps_helpers[2].tail_call) && (r0 == 0))
-#line 88 "sample/map.c"
-        return 0;
-        // EBPF_OP_MOV64_REG pc=29 dst=r6 src=r0 offset=0 imm=0
+    // EBPF_OP_MOV64_REG pc=29 dst=r6 src=r0 offset=0 imm=0
 #line 88 "sample/map.c"
     r6 = r0;
     // EBPF_OP_LSH64_IMM pc=30 dst=r6 src=r0 offset=0 imm=32
@@ -350,11 +338,7 @@ test_maps(void* context)
     r0 = test_maps_helpers[0].address
 #line 94 "sample/map.c"
          (r1, r2, r3, r4, r5);
-#line 94 "sample/map.c"
-    if ((test_maps_helpers[0].tail_call) && (r0 == 0))
-#line 94 "sample/map.c"
-        return 0;
-        // EBPF_OP_MOV64_REG pc=42 dst=r6 src=r0 offset=0 imm=0
+    // EBPF_OP_MOV64_REG pc=42 dst=r6 src=r0 offset=0 imm=0
 #line 94 "sample/map.c"
     r6 = r0;
     // EBPF_OP_LSH64_IMM pc=43 dst=r6 src=r0 offset=0 imm=32
@@ -390,11 +374,7 @@ label_2:
     r0 = test_maps_helpers[3].address
 #line 105 "sample/map.c"
          (r1, r2, r3, r4, r5);
-#line 105 "sample/map.c"
-    if ((test_maps_helpers[3].tail_call) && (r0 == 0))
-#line 105 "sample/map.c"
-        return 0;
-        // EBPF_OP_LDDW pc=53 dst=r6 src=r0 offset=0 imm=-1
+    // EBPF_OP_LDDW pc=53 dst=r6 src=r0 offset=0 imm=-1
 #line 105 "sample/map.c"
     r6 = (uint64_t)4294967295;
     // EBPF_OP_JEQ_IMM pc=55 dst=r0 src=r0 offset=-10 imm=0
@@ -437,11 +417,7 @@ label_2:
     r0 = test_maps_helpers[0].address
 #line 76 "sample/map.c"
          (r1, r2, r3, r4, r5);
-#line 76 "sample/map.c"
-    if ((test_maps_helpers[0].tail_call) && (r0 == 0))
-#line 76 "sample/map.c"
-        return 0;
-        // EBPF_OP_MOV64_REG pc=68 dst=r6 src=r0 offset=0 imm=0
+    // EBPF_OP_MOV64_REG pc=68 dst=r6 src=r0 offset=0 imm=0
 #line 76 "sample/map.c"
     r6 = r0;
     // EBPF_OP_LSH64_IMM pc=69 dst=r6 src=r0 offset=0 imm=32
@@ -469,11 +445,7 @@ label_2:
     r0 = test_maps_helpers[1].address
 #line 82 "sample/map.c"
          (r1, r2, r3, r4, r5);
-#line 82 "sample/map.c"
-    if ((test_maps_helpers[1].tail_call) && (r0 == 0))
-#line 82 "sample/map.c"
-        return 0;
-        // EBPF_OP_LDDW pc=77 dst=r6 src=r0 offset=0 imm=-1
+    // EBPF_OP_LDDW pc=77 dst=r6 src=r0 offset=0 imm=-1
 #line 82 "sample/map.c"
     r6 = (uint64_t)4294967295;
     // EBPF_OP_JEQ_IMM pc=79 dst=r0 src=r0 offset=22 imm=0
@@ -495,11 +467,7 @@ label_2:
     r0 = test_maps_helpers[2].address
 #line 88 "sample/map.c"
          (r1, r2, r3, r4, r5);
-#line 88 "sample/map.c"
-    if ((test_maps_helpers[2].tail_call) && (r0 == 0))
-#line 88 "sample/map.c"
-        return 0;
-        // EBPF_OP_MOV64_REG pc=85 dst=r6 src=r0 offset=0 imm=0
+    // EBPF_OP_MOV64_REG pc=85 dst=r6 src=r0 offset=0 imm=0
 #line 88 "sample/map.c"
     r6 = r0;
     // EBPF_OP_LSH64_IMM pc=86 dst=r6 src=r0 offset=0 imm=32
@@ -539,11 +507,7 @@ label_2:
     r0 = test_maps_helpers[0].address
 #line 94 "sample/map.c"
          (r1, r2, r3, r4, r5);
-#line 94 "sample/map.c"
-    if ((test_maps_helpers[0].tail_call) && (r0 == 0))
-#line 94 "sample/map.c"
-        return 0;
-        // EBPF_OP_MOV64_REG pc=98 dst=r6 src=r0 offset=0 imm=0
+    // EBPF_OP_MOV64_REG pc=98 dst=r6 src=r0 offset=0 imm=0
 #line 94 "sample/map.c"
     r6 = r0;
     // EBPF_OP_LSH64_IMM pc=99 dst=r6 src=r0 offset=0 imm=32
@@ -576,11 +540,7 @@ label_4:
     r0 = test_maps_helpers[3].address
 #line 105 "sample/map.c"
          (r1, r2, r3, r4, r5);
-#line 105 "sample/map.c"
-    if ((test_maps_helpers[3].tail_call) && (r0 == 0))
-#line 105 "sample/map.c"
-        return 0;
-        // EBPF_OP_LDDW pc=108 dst=r6 src=r0 offset=0 imm=-1
+    // EBPF_OP_LDDW pc=108 dst=r6 src=r0 offset=0 imm=-1
 #line 105 "sample/map.c"
     r6 = (uint64_t)4294967295;
     // EBPF_OP_JEQ_IMM pc=110 dst=r0 src=r0 offset=-65 imm=0
@@ -623,11 +583,7 @@ label_4:
     r0 = test_maps_helpers[0].address
 #line 76 "sample/map.c"
          (r1, r2, r3, r4, r5);
-#line 76 "sample/map.c"
-    if ((test_maps_helpers[0].tail_call) && (r0 == 0))
-#line 76 "sample/map.c"
-        return 0;
-        // EBPF_OP_MOV64_REG pc=123 dst=r6 src=r0 offset=0 imm=0
+    // EBPF_OP_MOV64_REG pc=123 dst=r6 src=r0 offset=0 imm=0
 #line 76 "sample/map.c"
     r6 = r0;
     // EBPF_OP_LSH64_IMM pc=124 dst=r6 src=r0 offset=0 imm=32
@@ -652,14 +608,20 @@ label_4:
     r1 = POINTER(_maps[2].address);
     // EBPF_OP_CALL pc=131 dst=r0 src=r0 offset=0 imm=1
 #line 82 "sample/map.c"
-    r0 = test_maps_helpers[1].address
+    if (_maps[2].array_data != NULL) {
 #line 82 "sample/map.c"
-         (r1, r2, r3, r4, r5);
+        r0 = *(uint32_t*)(uintptr_t)r2;
+#line 82 "sample/map.c"
+        r0 = (r0 < 10) ? POINTER((uint8_t*)_maps[2].array_data + r0 * 4) : 0;
 #line 82 "sample/map.c"
-    if ((test_maps_helpers[1].tail_call) && (r0 == 0))
+    } else {
 #line 82 "sample/map.c"
-        return 0;
-        // EBPF_OP_LDDW pc=132 dst=r6 src=r0 offset=0 imm=-1
+        r0 = test_maps_helpers[1].address
+#line 82 "sample/map.c"
+             (r1, r2, r3, r4, r5);
+#line 82 "sample/map.c"
+    }
+    // EBPF_OP_LDDW pc=132 dst=r6 src=r0 offset=0 imm=-1
 #line 82 "sample/map.c"
     r6 = (uint64_t)4294967295;
     // EBPF_OP_JEQ_IMM pc=134 dst=r0 src=r0 offset=23 imm=0
@@ -681,11 +643,7 @@ label_4:
     r0 = test_maps_helpers[2].address
 #line 88 "sample/map.c"
          (r1, r2, r3, r4, r5);
-#line 88 "sample/map.c"
-    if ((test_maps_helpers[2].tail_call) && (r0 == 0))
-#line 88 "sample/map.c"
-        return 0;
-        // EBPF_OP_MOV64_REG pc=140 dst=r6 src=r0 offset=0 imm=0
+    // EBPF_OP_MOV64_REG pc=140 dst=r6 src=r0 offset=0 imm=0
 #line 88 "sample/map.c"
     r6 = r0;
     // EBPF_OP_LSH64_IMM pc=141 dst=r6 src=r0 offset=0 imm=32
@@ -728,11 +686,7 @@ label_4:
     r0 = test_maps_helpers[0].address
 #line 94 "sample/map.c"
          (r1, r2, r3, r4, r5);
-#line 94 "sample/map.c"
-    if ((test_maps_helpers[0].tail_call) && (r0 == 0))
-#line 94 "sample/map.c"
-        return 0;
-        // EBPF_OP_MOV64_REG pc=154 dst=r6 src=r0 offset=0 imm=0
+    // EBPF_OP_MOV64_REG pc=154 dst=r6 src=r0 offset=0 imm=0
 #line 94 "sample/map.c"
     r6 = r0;
     // EBPF_OP_LSH64_IMM pc=155 dst=r6 src=r0 offset=0 imm=32
@@ -783,11 +737,7 @@ label_6:
     r0 = test_maps_helpers[0].address
 #line 76 "sample/map.c"
          (r1, r2, r3, r4, r5);
-#line 76 "sample/map.c"
-    if ((test_maps_helpers[0].tail_call) && (r0 == 0))
-#line 76 "sample/map.c"
-        return 0;
-        // EBPF_OP_MOV64_REG pc=170 dst=r6 src=r0 offset=0 imm=0
+    // EBPF_OP_MOV64_REG pc=170 dst=r6 src=r0 offset=0 imm=0
 #line 76 "sample/map.c"
     r6 = r0;
     // EBPF_OP_LSH64_IMM pc=171 dst=r6 src=r0 offset=0 imm=32
@@ -815,11 +765,7 @@ label_6:
     r0 = test_maps_helpers[1].address
 #line 82 "sample/map.c"
          (r1, r2, r3, r4, r5);
-#line 82 "sample/map.c"
-    if ((test_maps_helpers[1].tail_call) && (r0 == 0))
-#line 82 "sample/map.c"
-        return 0;
-        // EBPF_OP_LDDW pc=179 dst=r6 src=r0 offset=0 imm=-1
+    // EBPF_OP_LDDW pc=179 dst=r6 src=r0 offset=0 imm=-1
 #line 82 "sample/map.c"
     r6 = (uint64_t)4294967295;
     // EBPF_OP_JEQ_IMM pc=181 dst=r0 src=r0 offset=23 imm=0
@@ -841,11 +787,7 @@ label_6:
     r0 = test_maps_helpers[2].address
 #line 88 "sample/map.c"
          (r1, r2, r3, r4, r5);
-#line 88 "sample/map.c"
-    if ((test_maps_helpers[2].tail_call) && (r0 == 0))
-#line 88 "sample/map.c"
-        return 0;
-        // EBPF_OP_MOV64_REG pc=187 dst=r6 src=r0 offset=0 imm=0
+    // EBPF_OP_MOV64_REG pc=187 dst=r6 src=r0 offset=0 imm=0
 #line 88 "sample/map.c"
     r6 = r0;
     // EBPF_OP_LSH64_IMM pc=188 dst=r6 src=r0 offset=0 imm=32
@@ -888,11 +830,7 @@ label_6:
     r0 = test_maps_helpers[0].address
 #line 94 "sample/map.c"
          (r1, r2, r3, r4, r5);
-#line 94 "sample/map.c"
-    if ((test_maps_helpers[0].tail_call) && (r0 == 0))
-#line 94 "sample/map.c"
-        return 0;
-        // EBPF_OP_MOV64_REG pc=201 dst=r6 src=r0 offset=0 imm=0
+    // EBPF_OP_MOV64_REG pc=201 dst=r6 src=r0 offset=0 imm=0
 #line 94 "sample/map.c"
     r6 = r0;
     // EBPF_OP_LSH64_IMM pc=202 dst=r6 src=r0 offset=0 imm=32
@@ -943,11 +881,7 @@ label_8:
     r0 = test_maps_helpers[0].address
 #line 76 "sample/map.c"
          (r1, r2, r3, r4, r5);
-#line 76 "sample/map.c"
-    if ((test_maps_helpers[0].tail_call) && (r0 == 0))
-#line 76 "sample/map.c"
-        return 0;
-        // EBPF_OP_MOV64_REG pc=217 dst=r6 src=r0 offset=0 imm=0
+    // EBPF_OP_MOV64_REG pc=217 dst=r6 src=r0 offset=0 imm=0
 #line 76 "sample/map.c"
     r6 = r0;
     // EBPF_OP_LSH64_IMM pc=218 dst=r6 src=r0 offset=0 imm=32
@@ -975,11 +909,7 @@ label_8:
     r0 = test_maps_helpers[1].address
 #line 82 "sample/map.c"
          (r1, r2, r3, r4, r5);
-#line 82 "sample/map.c"
-    if ((test_maps_helpers[1].tail_call) && (r0 == 0))
-#line 82 "sample/map.c"
-        return 0;
-        // EBPF_OP_LDDW pc=226 dst=r6 src=r0 offset=0 imm=-1
+    // EBPF_OP_LDDW pc=226 dst=r6 src=r0 offset=0 imm=-1
 #line 82 "sample/map.c"
     r6 = (uint64_t)4294967295;
     // EBPF_OP_JEQ_IMM pc=228 dst=r0 src=r0 offset=22 imm=0
@@ -1001,11 +931,7 @@ label_8:
     r0 = test_maps_helpers[2].address
 #line 88 "sample/map.c"
          (r1, r2, r3, r4, r5);
-#line 88 "sample/map.c"
-    if ((test_maps_helpers[2].tail_call) && (r0 == 0))
-#line 88 "sample/map.c"
-        return 0;
-        // EBPF_OP_MOV64_REG pc=234 dst=r6 src=r0 offset=0 imm=0
+    // EBPF_OP_MOV64_REG pc=234 dst=r6 src=r0 offset=0 imm=0
 #line 88 "sample/map.c"
     r6 = r0;
     // EBPF_OP_LSH64_IMM pc=235 dst=r6 src=r0 offset=0 imm=32
@@ -1045,11 +971,7 @@ label_8:
     r0 = test_maps_helpers[0].address
 #line 94 "sample/map.c"
          (r1, r2, r3, r4, r5);
-#line 94 "sample/map.c"
-    if ((test_maps_helpers[0].tail_call) && (r0 == 0))
-#line 94 "sample/map.c"
-        return 0;
-        // EBPF_OP_MOV64_REG pc=247 dst=r6 src=r0 offset=0 imm=0
+    // EBPF_OP_MOV64_REG pc=247 dst=r6 src=r0 offset=0 imm=0
 #line 94 "sample/map.c"
     r6 = r0;
     // EBPF_OP_LSH64_IMM pc=248 dst=r6 src=r0 offset=0 imm=32
@@ -1082,11 +1004,7 @@ label_10:
     r0 = test_maps_helpers[3].address
 #line 105 "sample/map.c"
          (r1, r2, r3, r4, r5);
-#line 105 "sample/map.c"
-    if ((test_maps_helpers[3].tail_call) && (r0 == 0))
-#line 105 "sample/map.c"
-        return 0;
-        // EBPF_OP_LDDW pc=257 dst=r6 src=r0 offset=0 imm=-1
+    // EBPF_OP_LDDW pc=257 dst=r6 src=r0 offset=0 imm=-1
 #line 105 "sample/map.c"
     r6 = (uint64_t)4294967295;
     // EBPF_OP_JEQ_IMM pc=259 dst=r0 src=r0 offset=-214 imm=0
@@ -1129,11 +1047,7 @@ label_10:
     r0 = test_maps_helpers[0].address
 #line 76 "sample/map.c"
          (r1, r2, r3, r4, r5);
-#line 76 "sample/map.c"
-    if ((test_maps_helpers[0].tail_call) && (r0 == 0))
-#line 76 "sample/map.c"
-        return 0;
-        // EBPF_OP_MOV64_REG pc=272 dst=r6 src=r0 offset=0 imm=0
+    // EBPF_OP_MOV64_REG pc=272 dst=r6 src=r0 offset=0 imm=0
 #line 76 "sample/map.c"
     r6 = r0;
     // EBPF_OP_LSH64_IMM pc=273 dst=r6 src=r0 offset=0 imm=32
@@ -1161,11 +1075,7 @@ label_10:
     r0 = test_maps_helpers[1].address
 #line 82 "sample/map.c"
          (r1, r2, r3, r4, r5);
-#line 82 "sample/map.c"
-    if ((test_maps_helpers[1].tail_call) && (r0 == 0))
-#line 82 "sample/map.c"
-        return 0;
-        // EBPF_OP_LDDW pc=281 dst=r6 src=r0 offset=0 imm=-1
+    // EBPF_OP_LDDW pc=281 dst=r6 src=r0 offset=0 imm=-1
 #line 82 "sample/map.c"
     r6 = (uint64_t)4294967295;
     // EBPF_OP_JEQ_IMM pc=283 dst=r0 src=r0 offset=22 imm=0
@@ -1187,11 +1097,7 @@ label_10:
     r0 = test_maps_helpers[2].address
 #line 88 "sample/map.c"
          (r1, r2, r3, r4, r5);
-#line 88 "sample/map.c"
-    if ((test_maps_helpers[2].tail_call) && (r0 == 0))
-#line 88 "sample/map.c"
-        return 0;
-        // EBPF_OP_MOV64_REG pc=289 dst=r6 src=r0 offset=0 imm=0
+    // EBPF_OP_MOV64_REG pc=289 dst=r6 src=r0 offset=0 imm=0
 #line 88 "sample/map.c"
     r6 = r0;
     // EBPF_OP_LSH64_IMM pc=290 dst=r6 src=r0 offset=0 imm=32
@@ -1231,11 +1137,7 @@ label_10:
     r0 = test_maps_helpers[0].address
 #line 94 "sample/map.c"
          (r1, r2, r3, r4, r5);
-#line 94 "sample/map.c"
-    if ((test_maps_helpers[0].tail_call) && (r0 == 0))
-#line 94 "sample/map.c"
-        return 0;
-        // EBPF_OP_MOV64_REG pc=302 dst=r6 src=r0 offset=0 imm=0
+    // EBPF_OP_MOV64_REG pc=302 dst=r6 src=r0 offset=0 imm=0
 #line 94 "sample/map.c"
     r6 = r0;
     // EBPF_OP_LSH64_IMM pc=303 dst=r6 src=r0 offset=0 imm=32
@@ -1268,11 +1170,7 @@ label_12:
     r0 = test_maps_helpers[3].address
 #line 105 "sample/map.c"
          (r1, r2, r3, r4, r5);
-#line 105 "sample/map.c"
-    if ((test_maps_helpers[3].tail_call) && (r0 == 0))
-#line 105 "sample/map.c"
-        return 0;
-        // EBPF_OP_LDDW pc=312 dst=r6 src=r0 offset=0 imm=-1
+    // EBPF_OP_LDDW pc=312 dst=r6 src=r0 offset=0 imm=-1
 #line 105 "sample/map.c"
     r6 = (uint64_t)4294967295;
     // EBPF_OP_JEQ_IMM pc=314 dst=r0 src=r0 offset=-269 imm=0
@@ -1361,11 +1259,7 @@ label_14:
     r0 = test_maps_helpers[0].address
 #line 122 "sample/map.c"
          (r1, r2, r3, r4, r5);
-#line 122 "sample/map.c"
-    if ((test_maps_helpers[0].tail_call) && (r0 == 0))
-#line 122 "sample/map.c"
-        return 0;
-        // EBPF_OP_MOV64_REG pc=341 dst=r6 src=r0 offset=0 imm=0
+    // EBPF_OP_MOV64_REG pc=341 dst=r6 src=r0 offset=0 imm=0
 #line 122 "sample/map.c"
     r6 = r0;
     // EBPF_OP_MOV64_REG pc=342 dst=r1 src=r6 offset=0 imm=0
@@ -1426,11 +1320,7 @@ label_15:
     r0 = test_maps_helpers[4].address
 #line 173 "sample/map.c"
          (r1, r2, r3, r4, r5);
-#line 173 "sample/map.c"
-    if ((test_maps_helpers[4].tail_call) && (r0 == 0))
-#line 173 "sample/map.c"
-        return 0;
-        // EBPF_OP_MOV64_REG pc=360 dst=r1 src=r0 offset=0 imm=0
+    // EBPF_OP_MOV64_REG pc=360 dst=r1 src=r0 offset=0 imm=0
 #line 173 "sample/map.c"
     r1 = r0;
     // EBPF_OP_LSH64_IMM pc=361 dst=r1 src=r0 offset=0 imm=32
@@ -1480,11 +1370,7 @@ label_16:
     r0 = test_maps_helpers[0].address
 #line 122 "sample/map.c"
          (r1, r2, r3, r4, r5);
-#line 122 "sample/map.c"
-    if ((test_maps_helpers[0].tail_call) && (r0 == 0))
-#line 122 "sample/map.c"
-        return 0;
-        // EBPF_OP_MOV64_REG pc=377 dst=r6 src=r0 offset=0 imm=0
+    // EBPF_OP_MOV64_REG pc=377 dst=r6 src=r0 offset=0 imm=0
 #line 122 "sample/map.c"
     r6 = r0;
     // EBPF_OP_MOV64_REG pc=378 dst=r1 src=r6 offset=0 imm=0
@@ -1538,11 +1424,7 @@ label_17:
     r0 = test_maps_helpers[5].address
 #line 174 "sample/map.c"
          (r1, r2, r3, r4, r5);
-#line 174 "sample/map.c"
-    if ((test_maps_helpers[5].tail_call) && (r0 == 0))
-#line 174 "sample/map.c"
-        return 0;
-        // EBPF_OP_LDXW pc=393 dst=r1 src=r10 offset=-4 imm=0
+    // EBPF_OP_LDXW pc=393 dst=r1 src=r10 offset=-4 imm=0
 #line 174 "sample/map.c"
     r1 = *(uint32_t*)(uintptr_t)(r10 + OFFSET(-4));
     // EBPF_OP_MOV64_REG pc=394 dst=r7 src=r6 offset=0 imm=0
@@ -1617,11 +1499,7 @@ label_19:
     r0 = test_maps_helpers[6].address
 #line 177 "sample/map.c"
          (r1, r2, r3, r4, r5);
-#line 177 "sample/map.c"
-    if ((test_maps_helpers[6].tail_call) && (r0 == 0))
-#line 177 "sample/map.c"
-        return 0;
-        // EBPF_OP_MOV64_REG pc=416 dst=r6 src=r0 offset=0 imm=0
+    // EBPF_OP_MOV64_REG pc=416 dst=r6 src=r0 offset=0 imm=0
 #line 177 "sample/map.c"
     r6 = r0;
     // EBPF_OP_MOV64_REG pc=417 dst=r1 src=r6 offset=0 imm=0
@@ -1661,11 +1539,7 @@ label_19:
     r0 = test_maps_helpers[6].address
 #line 177 "sample/map.c"
          (r1, r2, r3, r4, r5);
-#line 177 "sample/map.c"
-    if ((test_maps_helpers[6].tail_call) && (r0 == 0))
-#line 177 "sample/map.c"
-        return 0;
-        // EBPF_OP_MOV64_REG pc=429 dst=r6 src=r0 offset=0 imm=0
+    // EBPF_OP_MOV64_REG pc=429 dst=r6 src=r0 offset=0 imm=0
 #line 177 "sample/map.c"
     r6 = r0;
     // EBPF_OP_MOV64_REG pc=430 dst=r1 src=r6 offset=0 imm=0
@@ -1709,11 +1583,7 @@ label_20:
     r0 = test_maps_helpers[6].address
 #line 177 "sample/map.c"
          (r1, r2, r3, r4, r5);
-#line 177 "sample/map.c"
-    if ((test_maps_helpers[6].tail_call) && (r0 == 0))
-#line 177 "sample/map.c"
-        return 0;
-        // EBPF_OP_MOV64_REG pc=443 dst=r6 src=r0 offset=0 imm=0
+    // EBPF_OP_MOV64_REG pc=443 dst=r6 src=r0 offset=0 imm=0
 #line 177 "sample/map.c"
     r6 = r0;
     // EBPF_OP_MOV64_REG pc=444 dst=r1 src=r6 offset=0 imm=0
@@ -1753,11 +1623,7 @@ label_20:
     r0 = test_maps_helpers[6].address
 #line 177 "sample/map.c"
          (r1, r2, r3, r4, r5);
-#line 177 "sample/map.c"
-    if ((test_maps_helpers[6].tail_call) && (r0 == 0))
-#line 177 "sample/map.c"
-        return 0;
-        // EBPF_OP_MOV64_REG pc=456 dst=r6 src=r0 offset=0 imm=0
+    // EBPF_OP_MOV64_REG pc=456 dst=r6 src=r0 offset=0 imm=0
 #line 177 "sample/map.c"
     r6 = r0;
     // EBPF_OP_MOV64_REG pc=457 dst=r1 src=r6 offset=0 imm=0
@@ -1797,11 +1663,7 @@ label_20:
     r0 = test_maps_helpers[6].address
 #line 177 "sample/map.c"
          (r1, r2, r3, r4, r5);
-#line 177 "sample/map.c"
-    if ((test_maps_helpers[6].tail_call) && (r0 == 0))
-#line 177 "sample/map.c"
-        return 0;
-        // EBPF_OP_MOV64_REG pc=469 dst=r6 src=r0 offset=0 imm=0
+    // EBPF_OP_MOV64_REG pc=469 dst=r6 src=r0 offset=0 imm=0
 #line 177 "sample/map.c"
     r6 = r0;
     // EBPF_OP_MOV64_REG pc=470 dst=r1 src=r6 offset=0 imm=0
@@ -1841,11 +1703,7 @@ label_20:
     r0 = test_maps_helpers[6].address
 #line 177 "sample/map.c"
          (r1, r2, r3, r4, r5);
-#line 177 "sample/map.c"
-    if ((test_maps_helpers[6].tail_call) && (r0 == 0))
-#line 177 "sample/map.c"
-        return 0;
-        // EBPF_OP_MOV64_REG pc=482 dst=r6 src=r0 offset=0 imm=0
+    // EBPF_OP_MOV64_REG pc=482 dst=r6 src=r0 offset=0 imm=0
 #line 177 "sample/map.c"
     r6 = r0;
     // EBPF_OP_MOV64_REG pc=483 dst=r1 src=r6 offset=0 imm=0
@@ -1885,11 +1743,7 @@ label_20:
     r0 = test_maps_helpers[6].address
 #line 177 "sample/map.c"
          (r1, r2, r3, r4, r5);
-#line 177 "sample/map.c"
-    if ((test_maps_helpers[6].tail_call) && (r0 == 0))
-#line 177 "sample/map.c"
-        return 0;
-        // EBPF_OP_MOV64_REG pc=495 dst=r6 src=r0 offset=0 imm=0
+    // EBPF_OP_MOV64_REG pc=495 dst=r6 src=r0 offset=0 imm=0
 #line 177 "sample/map.c"
     r6 = r0;
     // EBPF_OP_MOV64_REG pc=496 dst=r1 src=r6 offset=0 imm=0
@@ -1929,11 +1783,7 @@ label_20:
     r0 = test_maps_helpers[6].address
 #line 177 "sample/map.c"
          (r1, r2, r3, r4, r5);
-#line 177 "sample/map.c"
-    if ((test_maps_helpers[6].tail_call) && (r0 == 0))
-#line 177 "sample/map.c"
-        return 0;
-        // EBPF_OP_MOV64_REG pc=508 dst=r6 src=r0 offset=0 imm=0
+    // EBPF_OP_MOV64_REG pc=508 dst=r6 src=r0 offset=0 imm=0
 #line 177 "sample/map.c"
     r6 = r0;
     // EBPF_OP_MOV64_REG pc=509 dst=r1 src=r6 offset=0 imm=0
@@ -1973,11 +1823,7 @@ label_20:
     r0 = test_maps_helpers[6].address
 #line 177 "sample/map.c"
          (r1, r2, r3, r4, r5);
-#line 177 "sample/map.c"
-    if ((test_maps_helpers[6].tail_call) && (r0 == 0))
-#line 177 "sample/map.c"
-        return 0;
-        // EBPF_OP_MOV64_REG pc=521 dst=r6 src=r0 offset=0 imm=0
+    // EBPF_OP_MOV64_REG pc=521 dst=r6 src=r0 offset=0 imm=0
 #line 177 "sample/map.c"
     r6 = r0;
     // EBPF_OP_MOV64_REG pc=522 dst=r1 src=r6 offset=0 imm=0
@@ -2017,11 +1863,7 @@ label_20:
     r0 = test_maps_helpers[6].address
 #line 177 "sample/map.c"
          (r1, r2, r3, r4, r5);
-#line 177 "sample/map.c"
-    if ((test_maps_helpers[6].tail_call) && (r0 == 0))
-#line 177 "sample/map.c"
-        return 0;
-        // EBPF_OP_MOV64_REG pc=534 dst=r6 src=r0 offset=0 imm=0
+    // EBPF_OP_MOV64_REG pc=534 dst=r6 src=r0 offset=0 imm=0
 #line 177 "sample/map.c"
     r6 = r0;
     // EBPF_OP_MOV64_REG pc=535 dst=r1 src=r6 offset=0 imm=0
@@ -2061,11 +1903,7 @@ label_20:
     r0 = test_maps_helpers[6].address
 #line 180 "sample/map.c"
          (r1, r2, r3, r4, r5);
-#line 180 "sample/map.c"
-    if ((test_maps_helpers[6].tail_call) && (r0 == 0))
-#line 180 "sample/map.c"
-        return 0;
-        // EBPF_OP_MOV64_REG pc=547 dst=r6 src=r0 offset=0 imm=0
+    // EBPF_OP_MOV64_REG pc=547 dst=r6 src=r0 offset=0 imm=0
 #line 180 "sample/map.c"
     r6 = r0;
     // EBPF_OP_MOV64_REG pc=548 dst=r1 src=r6 offset=0 imm=0
@@ -2124,11 +1962,7 @@ label_22:
     r0 = test_maps_helpers[4].address
 #line 173 "sample/map.c"
          (r1, r2, r3, r4, r5);
-#line 173 "sample/map.c"
-    if ((test_maps_helpers[4].tail_call) && (r0 == 0))
-#line 173 "sample/map.c"
-        return 0;
-        // EBPF_OP_MOV64_REG pc=566 dst=r1 src=r0 offset=0 imm=0
+    // EBPF_OP_MOV64_REG pc=566 dst=r1 src=r0 offset=0 imm=0
 #line 173 "sample/map.c"
     r1 = r0;
     // EBPF_OP_LSH64_IMM pc=567 dst=r1 src=r0 offset=0 imm=32
@@ -2185,11 +2019,7 @@ label_23:
     r0 = test_maps_helpers[5].address
 #line 174 "sample/map.c"
          (r1, r2, r3, r4, r5);
-#line 174 "sample/map.c"
-    if ((test_maps_helpers[5].tail_call) && (r0 == 0))
-#line 174 "sample/map.c"
-        return 0;
-        // EBPF_OP_LDXW pc=584 dst=r1 src=r10 offset=-4 imm=0
+    // EBPF_OP_LDXW pc=584 dst=r1 src=r10 offset=-4 imm=0
 #line 174 "sample/map.c"
     r1 = *(uint32_t*)(uintptr_t)(r10 + OFFSET(-4));
     // EBPF_OP_MOV64_REG pc=585 dst=r6 src=r7 offset=0 imm=0
@@ -2264,11 +2094,7 @@ label_25:
     r0 = test_maps_helpers[6].address
 #line 177 "sample/map.c"
          (r1, r2, r3, r4, r5);
-#line 177 "sample/map.c"
-    if ((test_maps_helpers[6].tail_call) && (r0 == 0))
-#line 177 "sample/map.c"
-        return 0;
-        // EBPF_OP_MOV64_REG pc=607 dst=r7 src=r0 offset=0 imm=0
+    // EBPF_OP_MOV64_REG pc=607 dst=r7 src=r0 offset=0 imm=0
 #line 177 "sample/map.c"
     r7 = r0;
     // EBPF_OP_MOV64_REG pc=608 dst=r1 src=r7 offset=0 imm=0
@@ -2308,11 +2134,7 @@ label_25:
     r0 = test_maps_helpers[6].address
 #line 177 "sample/map.c"
          (r1, r2, r3, r4, r5);
-#line 177 "sample/map.c"
-    if ((test_maps_helpers[6].tail_call) && (r0 == 0))
-#line 177 "sample/map.c"
-        return 0;
-        // EBPF_OP_MOV64_REG pc=620 dst=r7 src=r0 offset=0 imm=0
+    // EBPF_OP_MOV64_REG pc=620 dst=r7 src=r0 offset=0 imm=0
 #line 177 "sample/map.c"
     r7 = r0;
     // EBPF_OP_MOV64_REG pc=621 dst=r1 src=r7 offset=0 imm=0
@@ -2356,11 +2178,7 @@ label_26:
     r0 = test_maps_helpers[6].address
 #line 177 "sample/map.c"
          (r1, r2, r3, r4, r5);
-#line 177 "sample/map.c"
-    if ((test_maps_helpers[6].tail_call) && (r0 == 0))
-#line 177 "sample/map.c"
-        return 0;
-        // EBPF_OP_MOV64_REG pc=634 dst=r7 src=r0 offset=0 imm=0
+    // EBPF_OP_MOV64_REG pc=634 dst=r7 src=r0 offset=0 imm=0
 #line 177 "sample/map.c"
     r7 = r0;
     // EBPF_OP_MOV64_REG pc=635 dst=r1 src=r7 offset=0 imm=0
@@ -2400,11 +2218,7 @@ label_26:
     r0 = test_maps_helpers[6].address
 #line 177 "sample/map.c"
          (r1, r2, r3, r4, r5);
-#line 177 "sample/map.c"
-    if ((test_maps_helpers[6].tail_call) && (r0 == 0))
-#line 177 "sample/map.c"
-        return 0;
-        // EBPF_OP_MOV64_REG pc=647 dst=r7 src=r0 offset=0 imm=0
+    // EBPF_OP_MOV64_REG pc=647 dst=r7 src=r0 offset=0 imm=0
 #line 177 "sample/map.c"
     r7 = r0;
     // EBPF_OP_MOV64_REG pc=648 dst=r1 src=r7 offset=0 imm=0
@@ -2444,11 +2258,7 @@ label_26:
     r0 = test_maps_helpers[6].address
 #line 177 "sample/map.c"
          (r1, r2, r3, r4, r5);
-#line 177 "sample/map.c"
-    if ((test_maps_helpers[6].tail_call) && (r0 == 0))
-#line 177 "sample/map.c"
-        return 0;
-        // EBPF_OP_MOV64_REG pc=660 dst=r7 src=r0 offset=0 imm=0
+    // EBPF_OP_MOV64_REG pc=660 dst=r7 src=r0 offset=0 imm=0
 #line 177 "sample/map.c"
     r7 = r0;
     // EBPF_OP_MOV64_REG pc=661 dst=r1 src=r7 offset=0 imm=0
@@ -2488,11 +2298,7 @@ label_26:
     r0 = test_maps_helpers[6].address
 #line 177 "sample/map.c"
          (r1, r2, r3, r4, r5);
-#line 177 "sample/map.c"
-    if ((test_maps_helpers[6].tail_call) && (r0 == 0))
-#line 177 "sample/map.c"
-        return 0;
-        // EBPF_OP_MOV64_REG pc=673 dst=r7 src=r0 offset=0 imm=0
+    // EBPF_OP_MOV64_REG pc=673 dst=r7 src=r0 offset=0 imm=0
 #line 177 "sample/map.c"
     r7 = r0;
     // EBPF_OP_MOV64_REG pc=674 dst=r1 src=r7 offset=0 imm=0
@@ -2532,11 +2338,7 @@ label_26:
     r0 = test_maps_helpers[6].address
 #line 177 "sample/map.c"
          (r1, r2, r3, r4, r5);
-#line 177 "sample/map.c"
-    if ((test_maps_helpers[6].tail_call) && (r0 == 0))
-#line 177 "sample/map.c"
-        return 0;
-        // EBPF_OP_MOV64_REG pc=686 dst=r7 src=r0 offset=0 imm=0
+    // EBPF_OP_MOV64_REG pc=686 dst=r7 src=r0 offset=0 imm=0
 #line 177 "sample/map.c"
     r7 = r0;
     // EBPF_OP_MOV64_REG pc=687 dst=r1 src=r7 offset=0 imm=0
@@ -2576,11 +2378,7 @@ label_26:
     r0 = test_maps_helpers[6].address
 #line 177 "sample/map.c"
          (r1, r2, r3, r4, r5);
-#line 177 "sample/map.c"
-    if ((test_maps_helpers[6].tail_call) && (r0 == 0))
-#line 177 "sample/map.c"
-        return 0;
-        // EBPF_OP_MOV64_REG pc=699 dst=r7 src=r0 offset=0 imm=0
+    // EBPF_OP_MOV64_REG pc=699 dst=r7 src=r0 offset=0 imm=0
 #line 177 "sample/map.c"
     r7 = r0;
     // EBPF_OP_MOV64_REG pc=700 dst=r1 src=r7 offset=0 imm=0
@@ -2620,11 +2418,7 @@ label_26:
     r0 = test_maps_helpers[6].address
 #line 177 "sample/map.c"
          (r1, r2, r3, r4, r5);
-#line 177 "sample/map.c"
-    if ((test_maps_helpers[6].tail_call) && (r0 == 0))
-#line 177 "sample/map.c"
-        return 0;
-        // EBPF_OP_MOV64_REG pc=712 dst=r7 src=r0 offset=0 imm=0
+    // EBPF_OP_MOV64_REG pc=712 dst=r7 src=r0 offset=0 imm=0
 #line 177 "sample/map.c"
     r7 = r0;
     // EBPF_OP_MOV64_REG pc=713 dst=r1 src=r7 offset=0 imm=0
@@ -2664,11 +2458,7 @@ label_26:
     r0 = test_maps_helpers[6].address
 #line 177 "sample/map.c"
          (r1, r2, r3, r4, r5);
-#line 177 "sample/map.c"
-    if ((test_maps_helpers[6].tail_call) && (r0 == 0))
-#line 177 "sample/map.c"
-        return 0;
-        // EBPF_OP_MOV64_REG pc=725 dst=r7 src=r0 offset=0 imm=0
+    // EBPF_OP_MOV64_REG pc=725 dst=r7 src=r0 offset=0 imm=0
 #line 177 "sample/map.c"
     r7 = r0;
     // EBPF_OP_MOV64_REG pc=726 dst=r1 src=r7 offset=0 imm=0
@@ -2708,11 +2498,7 @@ label_26:
     r0 = test_maps_helpers[6].address
 #line 180 "sample/map.c"
          (r1, r2, r3, r4, r5);
-#line 180 "sample/map.c"
-    if ((test_maps_helpers[6].tail_call) && (r0 == 0))
-#line 180 "sample/map.c"
-        return 0;
-        // EBPF_OP_MOV64_REG pc=738 dst=r7 src=r0 offset=0 imm=0
+    // EBPF_OP_MOV64_REG pc=738 dst=r7 src=r0 offset=0 imm=0
 #line 180 "sample/map.c"
     r7 = r0;
     // EBPF_OP_MOV64_REG pc=739 dst=r1 src=r7 offset=0 imm=0
@@ -2778,11 +2564,7 @@ label_29:
     r0 = test_maps_helpers[6].address
 #line 181 "sample/map.c"
          (r1, r2, r3, r4, r5);
-#line 181 "sample/map.c"
-    if ((test_maps_helpers[6].tail_call) && (r0 == 0))
-#line 181 "sample/map.c"
-        return 0;
-        // EBPF_OP_MOV64_REG pc=759 dst=r6 src=r0 offset=0 imm=0
+    // EBPF_OP_MOV64_REG pc=759 dst=r6 src=r0 offset=0 imm=0
 #line 181 "sample/map.c"
     r6 = r0;
     // EBPF_OP_MOV64_REG pc=760 dst=r1 src=r6 offset=0 imm=0
@@ -2828,11 +2610,7 @@ label_30:
     r0 = test_maps_helpers[4].address
 #line 183 "sample/map.c"
          (r1, r2, r3, r4, r5);
-#line 183 "sample/map.c"
-    if ((test_maps_helpers[4].tail_call) && (r0 == 0))
-#line 183 "sample/map.c"
-        return 0;
-        // EBPF_OP_MOV64_REG pc=773 dst=r6 src=r0 offset=0 imm=0
+    // EBPF_OP_MOV64_REG pc=773 dst=r6 src=r0 offset=0 imm=0
 #line 183 "sample/map.c"
     r6 = r0;
     // EBPF_OP_MOV64_REG pc=774 dst=r1 src=r6 offset=0 imm=0
@@ -2873,11 +2651,7 @@ label_31:
     r0 = test_maps_helpers[6].address
 #line 181 "sample/map.c"
          (r1, r2, r3, r4, r5);
-#line 181 "sample/map.c"
-    if ((test_maps_helpers[6].tail_call) && (r0 == 0))
-#line 181 "sample/map.c"
-        return 0;
-        // EBPF_OP_MOV64_REG pc=786 dst=r7 src=r0 offset=0 imm=0
+    // EBPF_OP_MOV64_REG pc=786 dst=r7 src=r0 offset=0 imm=0
 #line 181 "sample/map.c"
     r7 = r0;
     // EBPF_OP_MOV64_REG pc=787 dst=r1 src=r7 offset=0 imm=0
@@ -2923,11 +2697,7 @@ label_32:
     r0 = test_maps_helpers[4].address
 #line 183 "sample/map.c"
          (r1, r2, r3, r4, r5);
-#line 183 "sample/map.c"
-    if ((test_maps_helpers[4].tail_call) && (r0 == 0))
-#line 183 "sample/map.c"
-        return 0;
-        // EBPF_OP_MOV64_REG pc=800 dst=r7 src=r0 offset=0 imm=0
+    // EBPF_OP_MOV64_REG pc=800 dst=r7 src=r0 offset=0 imm=0
 #line 183 "sample/map.c"
     r7 = r0;
     // EBPF_OP_MOV64_REG pc=801 dst=r1 src=r7 offset=0 imm=0
@@ -2979,11 +2749,7 @@ label_33:
     r0 = test_maps_helpers[5].address
 #line 186 "sample/map.c"
          (r1, r2, r3, r4, r5);
-#line 186 "sample/map.c"
-    if ((test_maps_helpers[5].tail_call) && (r0 == 0))
-#line 186 "sample/map.c"
-        return 0;
-        // EBPF_OP_MOV64_REG pc=817 dst=r6 src=r0 offset=0 imm=0
+    // EBPF_OP_MOV64_REG pc=817 dst=r6 src=r0 offset=0 imm=0
 #line 186 "sample/map.c"
     r6 = r0;
     // EBPF_OP_MOV64_REG pc=818 dst=r1 src=r6 offset=0 imm=0
@@ -3039,11 +2805,7 @@ label_35:
     r0 = test_maps_helpers[5].address
 #line 186 "sample/map.c"
          (r1, r2, r3, r4, r5);
-#line 186 "sample/map.c"
-    if ((test_maps_helpers[5].tail_call) && (r0 == 0))
-#line 186 "sample/map.c"
-        return 0;
-        // EBPF_OP_MOV64_REG pc=835 dst=r6 src=r0 offset=0 imm=0
+    // EBPF_OP_MOV64_REG pc=835 dst=r6 src=r0 offset=0 imm=0
 #line 186 "sample/map.c"
     r6 = r0;
     // EBPF_OP_MOV64_REG pc=836 dst=r1 src=r6 offset=0 imm=0
@@ -3096,11 +2858,7 @@ label_37:
     r0 = test_maps_helpers[5].address
 #line 186 "sample/map.c"
          (r1, r2, r3, r4, r5);
-#line 186 "sample/map.c"
-    if ((test_maps_helpers[5].tail_call) && (r0 == 0))
-#line 186 "sample/map.c"
-        return 0;
-        // EBPF_OP_MOV64_REG pc=852 dst=r7 src=r0 offset=0 imm=0
+    // EBPF_OP_MOV64_REG pc=852 dst=r7 src=r0 offset=0 imm=0
 #line 186 "sample/map.c"
     r7 = r0;
     // EBPF_OP_MOV64_REG pc=853 dst=r1 src=r7 offset=0 imm=0
@@ -3156,11 +2914,7 @@ label_39:
     r0 = test_maps_helpers[5].address
 #line 186 "sample/map.c"
          (r1, r2, r3, r4, r5);
-#line 186 "sample/map.c"
-    if ((test_maps_helpers[5].tail_call) && (r0 == 0))
-#line 186 "sample/map.c"
-        return 0;
-        // EBPF_OP_MOV64_REG pc=870 dst=r7 src=r0 offset=0 imm=0
+    // EBPF_OP_MOV64_REG pc=870 dst=r7 src=r0 offset=0 imm=0
 #line 186 "sample/map.c"
     r7 = r0;
     // EBPF_OP_MOV64_REG pc=871 dst=r1 src=r7 offset=0 imm=0
@@ -3213,11 +2967,7 @@ label_41:
     r0 = test_maps_helpers[5].address
 #line 186 "sample/map.c"
          (r1, r2, r3, r4, r5);
-#line 186 "sample/map.c"
-    if ((test_maps_helpers[5].tail_call) && (r0 == 0))
-#line 186 "sample/map.c"
-        return 0;
-        // EBPF_OP_MOV64_REG pc=887 dst=r6 src=r0 offset=0 imm=0
+    // EBPF_OP_MOV64_REG pc=887 dst=r6 src=r0 offset=0 imm=0
 #line 186 "sample/map.c"
     r6 = r0;
     // EBPF_OP_MOV64_REG pc=888 dst=r1 src=r6 offset=0 imm=0
@@ -3265,11 +3015,7 @@ label_41:
     r0 = test_maps_helpers[5].address
 #line 186 "sample/map.c"
          (r1, r2, r3, r4, r5);
-#line 186 "sample/map.c"
-    if ((test_maps_helpers[5].tail_call) && (r0 == 0))
-#line 186 "sample/map.c"
-        return 0;
-        // EBPF_OP_MOV64_REG pc=903 dst=r6 src=r0 offset=0 imm=0
+    // EBPF_OP_MOV64_REG pc=903 dst=r6 src=r0 offset=0 imm=0
 #line 186 "sample/map.c"
     r6 = r0;
     // EBPF_OP_MOV64_REG pc=904 dst=r1 src=r6 offset=0 imm=0
@@ -3317,11 +3063,7 @@ label_41:
     r0 = test_maps_helpers[5].address
 #line 186 "sample/map.c"
          (r1, r2, r3, r4, r5);
-#line 186 "sample/map.c"
-    if ((test_maps_helpers[5].tail_call) && (r0 == 0))
-#line 186 "sample/map.c"
-        return 0;
-        // EBPF_OP_MOV64_REG pc=919 dst=r6 src=r0 offset=0 imm=0
+    // EBPF_OP_MOV64_REG pc=919 dst=r6 src=r0 offset=0 imm=0
 #line 186 "sample/map.c"
     r6 = r0;
     // EBPF_OP_MOV64_REG pc=920 dst=r1 src=r6 offset=0 imm=0
@@ -3369,11 +3111,7 @@ label_41:
     r0 = test_maps_helpers[5].address
 #line 186 "sample/map.c"
          (r1, r2, r3, r4, r5);
-#line 186 "sample/map.c"
-    if ((test_maps_helpers[5].tail_call) && (r0 == 0))
-#line 186 "sample/map.c"
-        return 0;
-        // EBPF_OP_MOV64_REG pc=935 dst=r6 src=r0 offset=0 imm=0
+    // EBPF_OP_MOV64_REG pc=935 dst=r6 src=r0 offset=0 imm=0
 #line 186 "sample/map.c"
     r6 = r0;
     // EBPF_OP_MOV64_REG pc=936 dst=r1 src=r6 offset=0 imm=0
@@ -3421,11 +3159,7 @@ label_41:
     r0 = test_maps_helpers[5].address
 #line 186 "sample/map.c"
          (r1, r2, r3, r4, r5);
-#line 186 "sample/map.c"
-    if ((test_maps_helpers[5].tail_call) && (r0 == 0))
-#line 186 "sample/map.c"
-        return 0;
-        // EBPF_OP_MOV64_REG pc=951 dst=r6 src=r0 offset=0 imm=0
+    // EBPF_OP_MOV64_REG pc=951 dst=r6 src=r0 offset=0 imm=0
 #line 186 "sample/map.c"
     r6 = r0;
     // EBPF_OP_MOV64_REG pc=952 dst=r1 src=r6 offset=0 imm=0
@@ -3473,11 +3207,7 @@ label_41:
     r0 = test_maps_helpers[5].address
 #line 186 "sample/map.c"
          (r1, r2, r3, r4, r5);
-#line 186 "sample/map.c"
-    if ((test_maps_helpers[5].tail_call) && (r0 == 0))
-#line 186 "sample/map.c"
-        return 0;
-        // EBPF_OP_MOV64_REG pc=967 dst=r6 src=r0 offset=0 imm=0
+    // EBPF_OP_MOV64_REG pc=967 dst=r6 src=r0 offset=0 imm=0
 #line 186 "sample/map.c"
     r6 = r0;
     // EBPF_OP_MOV64_REG pc=968 dst=r1 src=r6 offset=0 imm=0
@@ -3525,11 +3255,7 @@ label_41:
     r0 = test_maps_helpers[5].address
 #line 186 "sample/map.c"
          (r1, r2, r3, r4, r5);
-#line 186 "sample/map.c"
-    if ((test_maps_helpers[5].tail_call) && (r0 == 0))
-#line 186 "sample/map.c"
-        return 0;
-        // EBPF_OP_MOV64_REG pc=983 dst=r6 src=r0 offset=0 imm=0
+    // EBPF_OP_MOV64_REG pc=983 dst=r6 src=r0 offset=0 imm=0
 #line 186 "sample/map.c"
     r6 = r0;
     // EBPF_OP_MOV64_REG pc=984 dst=r1 src=r6 offset=0 imm=0
@@ -3577,11 +3303,7 @@ label_41:
     r0 = test_maps_helpers[5].address
 #line 186 "sample/map.c"
          (r1, r2, r3, r4, r5);
-#line 186 "sample/map.c"
-    if ((test_maps_helpers[5].tail_call) && (r0 == 0))
-#line 186 "sample/map.c"
-        return 0;
-        // EBPF_OP_MOV64_REG pc=999 dst=r6 src=r0 offset=0 imm=0
+    // EBPF_OP_MOV64_REG pc=999 dst=r6 src=r0 offset=0 imm=0
 #line 186 "sample/map.c"
     r6 = r0;
     // EBPF_OP_MOV64_REG pc=1000 dst=r1 src=r6 offset=0 imm=0
@@ -3629,11 +3351,7 @@ label_41:
     r0 = test_maps_helpers[4].address
 #line 189 "sample/map.c"
          (r1, r2, r3, r4, r5);
-#line 189 "sample/map.c"
-    if ((test_maps_helpers[4].tail_call) && (r0 == 0))
-#line 189 "sample/map.c"
-        return 0;
-        // EBPF_OP_LDXW pc=1015 dst=r1 src=r10 offset=-4 imm=0
+    // EBPF_OP_LDXW pc=1015 dst=r1 src=r10 offset=-4 imm=0
 #line 189 "sample/map.c"
     r1 = *(uint32_t*)(uintptr_t)(r10 + OFFSET(-4));
     // EBPF_OP_MOV64_REG pc=1016 dst=r6 src=r7 offset=0 imm=0
@@ -3703,11 +3421,7 @@ label_44:
     r0 = test_maps_helpers[5].address
 #line 190 "sample/map.c"
          (r1, r2, r3, r4, r5);
-#line 190 "sample/map.c"
-    if ((test_maps_helpers[5].tail_call) && (r0 == 0))
-#line 190 "sample/map.c"
-        return 0;
-        // EBPF_OP_LDXW pc=1036 dst=r1 src=r10 offset=-4 imm=0
+    // EBPF_OP_LDXW pc=1036 dst=r1 src=r10 offset=-4 imm=0
 #line 190 "sample/map.c"
     r1 = *(uint32_t*)(uintptr_t)(r10 + OFFSET(-4));
     // EBPF_OP_JEQ_IMM pc=1037 dst=r1 src=r0 offset=1 imm=0
@@ -3785,11 +3499,7 @@ label_47:
     r0 = test_maps_helpers[5].address
 #line 186 "sample/map.c"
          (r1, r2, r3, r4, r5);
-#line 186 "sample/map.c"
-    if ((test_maps_helpers[5].tail_call) && (r0 == 0))
-#line 186 "sample/map.c"
-        return 0;
-        // EBPF_OP_MOV64_REG pc=1060 dst=r7 src=r0 offset=0 imm=0
+    // EBPF_OP_MOV64_REG pc=1060 dst=r7 src=r0 offset=0 imm=0
 #line 186 "sample/map.c"
     r7 = r0;
     // EBPF_OP_MOV64_REG pc=1061 dst=r1 src=r7 offset=0 imm=0
@@ -3837,11 +3547,7 @@ label_47:
     r0 = test_maps_helpers[5].address
 #line 186 "sample/map.c"
          (r1, r2, r3, r4, r5);
-#line 186 "sample/map.c"
-    if ((test_maps_helpers[5].tail_call) && (r0 == 0))
-#line 186 "sample/map.c"
-        return 0;
-        // EBPF_OP_MOV64_REG pc=1076 dst=r7 src=r0 offset=0 imm=0
+    // EBPF_OP_MOV64_REG pc=1076 dst=r7 src=r0 offset=0 imm=0
 #line 186 "sample/map.c"
     r7 = r0;
     // EBPF_OP_MOV64_REG pc=1077 dst=r1 src=r7 offset=0 imm=0
@@ -3889,11 +3595,7 @@ label_47:
     r0 = test_maps_helpers[5].address
 #line 186 "sample/map.c"
          (r1, r2, r3, r4, r5);
-#line 186 "sample/map.c"
-    if ((test_maps_helpers[5].tail_call) && (r0 == 0))
-#line 186 "sample/map.c"
-        return 0;
-        // EBPF_OP_MOV64_REG pc=1092 dst=r7 src=r0 offset=0 imm=0
+    // EBPF_OP_MOV64_REG pc=1092 dst=r7 src=r0 offset=0 imm=0
 #line 186 "sample/map.c"
     r7 = r0;
     // EBPF_OP_MOV64_REG pc=1093 dst=r1 src=r7 offset=0 imm=0
@@ -3941,11 +3643,7 @@ label_47:
     r0 = test_maps_helpers[5].address
 #line 186 "sample/map.c"
          (r1, r2, r3, r4, r5);
-#line 186 "sample/map.c"
-    if ((test_maps_helpers[5].tail_call) && (r0 == 0))
-#line 186 "sample/map.c"
-        return 0;
-        // EBPF_OP_MOV64_REG pc=1108 dst=r7 src=r0 offset=0 imm=0
+    // EBPF_OP_MOV64_REG pc=1108 dst=r7 src=r0 offset=0 imm=0
 #line 186 "sample/map.c"
     r7 = r0;
     // EBPF_OP_MOV64_REG pc=1109 dst=r1 src=r7 offset=0 imm=0
@@ -3993,11 +3691,7 @@ label_47:
     r0 = test_maps_helpers[5].address
 #line 186 "sample/map.c"
          (r1, r2, r3, r4, r5);
-#line 186 "sample/map.c"
-    if ((test_maps_helpers[5].tail_call) && (r0 == 0))
-#line 186 "sample/map.c"
-        return 0;
-        // EBPF_OP_MOV64_REG pc=1124 dst=r7 src=r0 offset=0 imm=0
+    // EBPF_OP_MOV64_REG pc=1124 dst=r7 src=r0 offset=0 imm=0
 #line 186 "sample/map.c"
     r7 = r0;
     // EBPF_OP_MOV64_REG pc=1125 dst=r1 src=r7 offset=0 imm=0
@@ -4045,11 +3739,7 @@ label_47:
     r0 = test_maps_helpers[5].address
 #line 186 "sample/map.c"
          (r1, r2, r3, r4, r5);
-#line 186 "sample/map.c"
-    if ((test_maps_helpers[5].tail_call) && (r0 == 0))
-#line 186 "sample/map.c"
-        return 0;
-        // EBPF_OP_MOV64_REG pc=1140 dst=r7 src=r0 offset=0 imm=0
+    // EBPF_OP_MOV64_REG pc=1140 dst=r7 src=r0 offset=0 imm=0
 #line 186 "sample/map.c"
     r7 = r0;
     // EBPF_OP_MOV64_REG pc=1141 dst=r1 src=r7 offset=0 imm=0
@@ -4097,11 +3787,7 @@ label_47:
     r0 = test_maps_helpers[5].address
 #line 186 "sample/map.c"
          (r1, r2, r3, r4, r5);
-#line 186 "sample/map.c"
-    if ((test_maps_helpers[5].tail_call) && (r0 == 0))
-#line 186 "sample/map.c"
-        return 0;
-        // EBPF_OP_MOV64_REG pc=1156 dst=r7 src=r0 offset=0 imm=0
+    // EBPF_OP_MOV64_REG pc=1156 dst=r7 src=r0 offset=0 imm=0
 #line 186 "sample/map.c"
     r7 = r0;
     // EBPF_OP_MOV64_REG pc=1157 dst=r1 src=r7 offset=0 imm=0
@@ -4149,11 +3835,7 @@ label_47:
     r0 = test_maps_helpers[5].address
 #line 186 "sample/map.c"
          (r1, r2, r3, r4, r5);
-#line 186 "sample/map.c"
-    if ((test_maps_helpers[5].tail_call) && (r0 == 0))
-#line 186 "sample/map.c"
-        return 0;
-        // EBPF_OP_MOV64_REG pc=1172 dst=r7 src=r0 offset=0 imm=0
+    // EBPF_OP_MOV64_REG pc=1172 dst=r7 src=r0 offset=0 imm=0
 #line 186 "sample/map.c"
     r7 = r0;
     // EBPF_OP_MOV64_REG pc=1173 dst=r1 src=r7 offset=0 imm=0
@@ -4201,11 +3883,7 @@ label_47:
     r0 = test_maps_helpers[4].address
 #line 189 "sample/map.c"
          (r1, r2, r3, r4, r5);
-#line 189 "sample/map.c"
-    if ((test_maps_helpers[4].tail_call) && (r0 == 0))
-#line 189 "sample/map.c"
-        return 0;
-        // EBPF_OP_LDXW pc=1188 dst=r1 src=r10 offset=-4 imm=0
+    // EBPF_OP_LDXW pc=1188 dst=r1 src=r10 offset=-4 imm=0
 #line 189 "sample/map.c"
     r1 = *(uint32_t*)(uintptr_t)(r10 + OFFSET(-4));
     // EBPF_OP_MOV64_REG pc=1189 dst=r7 src=r6 offset=0 imm=0
@@ -4275,11 +3953,7 @@ label_50:
     r0 = test_maps_helpers[5].address
 #line 190 "sample/map.c"
          (r1, r2, r3, r4, r5);
-#line 190 "sample/map.c"
-    if ((test_maps_helpers[5].tail_call) && (r0 == 0))
-#line 190 "sample/map.c"
-        return 0;
-        // EBPF_OP_LDXW pc=1209 dst=r1 src=r10 offset=-4 imm=0
+    // EBPF_OP_LDXW pc=1209 dst=r1 src=r10 offset=-4 imm=0
 #line 190 "sample/map.c"
     r1 = *(uint32_t*)(uintptr_t)(r10 + OFFSET(-4));
     // EBPF_OP_JEQ_IMM pc=1210 dst=r1 src=r0 offset=1 imm=0
@@ -4360,7 +4034,7 @@ static void
 _get_version(_Out_ bpf2c_version_t* version)
 {
     version->major = 0;
-    version->minor = 5;
+    version->minor = 6;
     version->revision = 0;
 }
 
@@ -276,11 +276,7 @@ lookup(void* context)
     r0 = lookup_helpers[0].address
 #line 32 "sample/map_in_map.c"
          (r1, r2, r3, r4, r5);
-#line 32 "sample/map_in_map.c"
-    if ((lookup_helpers[0].tail_call) && (r0 == 0))
-#line 32 "sample/map_in_map.c"
-        return 0;
-        // EBPF_OP_JEQ_IMM pc=7 dst=r0 src=r0 offset=9 imm=0
+    // EBPF_OP_JEQ_IMM pc=7 dst=r0 src=r0 offset=9 imm=0
 #line 33 "sample/map_in_map.c"
     if (r0 == IMMEDIATE(0))
 #line 33 "sample/map_in_map.c"
@@ -305,11 +301,7 @@ lookup(void* context)
     r0 = lookup_helpers[0].address
 #line 35 "sample/map_in_map.c"
          (r1, r2, r3, r4, r5);
-#line 35 "sample/map_in_map.c"
-    if ((lookup_helpers[0].tail_call) && (r0 == 0))
-#line 35 "sample/map_in_map.c"
-        return 0;
-        // EBPF_OP_JNE_IMM pc=14 dst=r0 src=r0 offset=1 imm=0
+    // EBPF_OP_JNE_IMM pc=14 dst=r0 src=r0 offset=1 imm=0
 #line 36 "sample/map_in_map.c"
     if (r0 != IMMEDIATE(0))
 #line 36 "sample/map_in_map.c"
@@ -363,7 +355,7 @@ static void
 _get_version(_Out_ bpf2c_version_t* version)
 {
     version->major = 0;
-    version->minor = 5;
+    version->minor = 6;
     version->revision = 0;
 }
 
@@ -109,11 +109,7 @@ lookup(void* context)
     r0 = lookup_helpers[0].address
 #line 38 "sample/map_in_map_v2.c"
          (r1, r2, r3, r4, r5);
-#line 38 "sample/map_in_map_v2.c"
-    if ((lookup_helpers[0].tail_call) && (r0 == 0))
-#line 38 "sample/map_in_map_v2.c"
-        return 0;
-        // EBPF_OP_JEQ_IMM pc=7 dst=r0 src=r0 offset=9 imm=0
+    // EBPF_OP_JEQ_IMM pc=7 dst=r0 src=r0 offset=9 imm=0
 #line 39 "sample/map_in_map_v2.c"
     if (r0 == IMMEDIATE(0))
 #line 39 "sample/map_in_map_v2.c"
@@ -138,11 +134,7 @@ lookup(void* context)
     r0 = lookup_helpers[0].address
 #line 41 "sample/map_in_map_v2.c"
          (r1, r2, r3, r4, r5);
-#line 41 "sample/map_in_map_v2.c"
-    if ((lookup_helpers[0].tail_call) && (r0 == 0))
-#line 41 "sample/map_in_map_v2.c"
-        return 0;
-        // EBPF_OP_JNE_IMM pc=14 dst=r0 src=r0 offset=1 imm=0
+    // EBPF_OP_JNE_IMM pc=14 dst=r0 src=r0 offset=1 imm=0
 #line 42 "sample/map_in_map_v2.c"
     if (r0 != IMMEDIATE(0))
 #line 42 "sample/map_in_map_v2.c"
@@ -196,7 +188,7 @@ static void
 _get_version(_Out_ bpf2c_version_t* version)
 {
     version->major = 0;
-    version->minor = 5;
+    version->minor = 6;
     version->revision = 0;
 }
 
@@ -214,11 +214,7 @@ test_maps(void* context)
     r0 = test_maps_helpers[0].address
 #line 76 "sample/map.c"
          (r1, r2, r3, r4, r5);
-#line 76 "sample/map.c"
-    if ((test_maps_helpers[0].tail_call) && (r0 == 0))
-#line 76 "sample/map.c"
-        return 0;
-        // EBPF_OP_MOV64_REG pc=12 dst=r6 src=r0 offset=0 imm=0
+    // EBPF_OP_MOV64_REG pc=12 dst=r6 src=r0 offset=0 imm=0
 #line 76 "sample/map.c"
     r6 = r0;
     // EBPF_OP_LSH64_IMM pc=13 dst=r6 src=r0 offset=0 imm=32
@@ -246,11 +242,7 @@ test_maps(void* context)
     r0 = test_maps_helpers[1].address
 #line 82 "sample/map.c"
          (r1, r2, r3, r4, r5);
-#line 82 "sample/map.c"
-    if ((test_maps_helpers[1].tail_call) && (r0 == 0))
-#line 82 "sample/map.c"
-        return 0;
-        // EBPF_OP_LDDW pc=21 dst=r6 src=r0 offset=0 imm=-1
+    // EBPF_OP_LDDW pc=21 dst=r6 src=r0 offset=0 imm=-1
 #line 82 "sample/map.c"
     r6 = (uint64_t)4294967295;
     // EBPF_OP_JEQ_IMM pc=23 dst=r0 src=r0 offset=22 imm=0
@@ -272,11 +264,7 @@ test_maps(void* context)
     r0 = test_maps_helpers[2].address
 #line 88 "sample/map.c"
          (r1, r2, r3, r4, r5);
-#line 88 "sample/map.c"
-    if ((test_maps_helpers[2].tail_call) && (r0 == 0))
-#line 88 "sample/map.c"
-        return 0;
-        // EBPF_OP_MOV64_REG pc=29 dst=r6 src=r0 offset=0 imm=0
+    // EBPF_OP_MOV64_REG pc=29 dst=r6 src=r0 offset=0 imm=0
 #line 88 "sample/map.c"
     r6 = r0;
     // EBPF_OP_LSH64_IMM pc=30 dst=r6 src=r0 offset=0 imm=32
@@ -316,11 +304,7 @@ test_maps(void* context)
     r0 = test_maps_helpers[0].address
 #line 94 "sample/map.c"
          (r1, r2, r3, r4, r5);
-#line 94 "sample/map.c"
-    if ((test_maps_helpers[0].tail_call) && (r0 == 0))
-#line 94 "sample/map.c"
-        return 0;
-        // EBPF_OP_MOV64_REG pc=42 dst=r6 src=r0 offset=0 imm=0
+    // EBPF_OP_MOV64_REG pc=42 dst=r6 src=r0 offset=0 imm=0
 #line 94 "sample/map.c"
     r6 = r0;
     // EBPF_OP_LSH64_IMM pc=43 dst=r6 src=r0 offset=0 imm=32
@@ -356,11 +340,7 @@ label_2:
     r0 = test_maps_helpers[3].address
 #line 105 "sample/map.c"
          (r1, r2, r3, r4, r5);
-#line 105 "sample/map.c"
-    if ((test_maps_helpers[3].tail_call) && (r0 == 0))
-#line 105 "sample/map.c"
-        return 0;
-        // EBPF_OP_LDDW pc=53 dst=r6 src=r0 offset=0 imm=-1
+    // EBPF_OP_LDDW pc=53 dst=r6 src=r0 offset=0 imm=-1
 #line 105 "sample/map.c"
     r6 = (uint64_t)4294967295;
     // EBPF_OP_JEQ_IMM pc=55 dst=r0 src=r0 offset=-10 imm=0
@@ -403,11 +383,7 @@ label_2:
     r0 = test_maps_helpers[0].address
 #line 76 "sample/map.c"
          (r1, r2, r3, r4, r5);
-#line 76 "sample/map.c"
-    if ((test_maps_helpers[0].tail_call) && (r0 == 0))
-#line 76 "sample/map.c"
-        return 0;
-        // EBPF_OP_MOV64_REG pc=68 dst=r6 src=r0 offset=0 imm=0
+    // EBPF_OP_MOV64_REG pc=68 dst=r6 src=r0 offset=0 imm=0
 #line 76 "sample/map.c"
     r6 = r0;
     // EBPF_OP_LSH64_IMM pc=69 dst=r6 src=r0 offset=0 imm=32
@@ -435,11 +411,7 @@ label_2:
     r0 = test_maps_helpers[1].address
 #line 82 "sample/map.c"
          (r1, r2, r3, r4, r5);
-#line 82 "sample/map.c"
-    if ((test_maps_helpers[1].tail_call) && (r0 == 0))
-#line 82 "sample/map.c"
-        return 0;
-        // EBPF_OP_LDDW pc=77 dst=r6 src=r0 offset=0 imm=-1
+    // EBPF_OP_LDDW pc=77 dst=r6 src=r0 offset=0 imm=-1
 #line 82 "sample/map.c"
     r6 = (uint64_t)4294967295;
     // EBPF_OP_JEQ_IMM pc=79 dst=r0 src=r0 offset=22 imm=0
@@ -461,11 +433,7 @@ label_2:
     r0 = test_maps_helpers[2].address
 #line 88 "sample/map.c"
          (r1, r2, r3, r4, r5);
-#line 88 "sample/map.c"
-    if ((test_maps_helpers[2].tail_call) && (r0 == 0))
-#line 88 "sample/map.c"
-        return 0;
-        // EBPF_OP_MOV64_REG pc=85 dst=r6 src=r0 offset=0 imm=0
+    // EBPF_OP_MOV64_REG pc=85 dst=r6 src=r0 offset=0 imm=0
 #line 88 "sample/map.c"
     r6 = r0;
     // EBPF_OP_LSH64_IMM pc=86 dst=r6 src=r0 offset=0 imm=32
@@ -505,11 +473,7 @@ label_2:
     r0 = test_maps_helpers[0].address
 #line 94 "sample/map.c"
          (r1, r2, r3, r4, r5);
-#line 94 "sample/map.c"
-    if ((test_maps_helpers[0].tail_call) && (r0 == 0))
-#line 94 "sample/map.c"
-        return 0;
-        // EBPF_OP_MOV64_REG pc=98 dst=r6 src=r0 offset=0 imm=0
+    // EBPF_OP_MOV64_REG pc=98 dst=r6 src=r0 offset=0 imm=0
 #line 94 "sample/map.c"
     r6 = r0;
     // EBPF_OP_LSH64_IMM pc=99 dst=r6 src=r0 offset=0 imm=32
@@ -542,11 +506,7 @@ label_4:
     r0 = test_maps_helpers[3].address
 #line 105 "sample/map.c"
          (r1, r2, r3, r4, r5);
-#line 105 "sample/map.c"
-    if ((test_maps_helpers[3].tail_call) && (r0 == 0))
-#line 105 "sample/map.c"
-        return 0;
-        // EBPF_OP_LDDW pc=108 dst=r6 src=r0 offset=0 imm=-1
+    // EBPF_OP_LDDW pc=108 dst=r6 src=r0 offset=0 imm=-1
 #line 105 "sample/map.c"
     r6 = (uint64_t)4294967295;
     // EBPF_OP_JEQ_IMM pc=110 dst=r0 src=r0 offset=-65 imm=0
@@ -589,11 +549,7 @@ label_4:
     r0 = test_maps_helpers[0].address
 #line 76 "sample/map.c"
          (r1, r2, r3, r4, r5);
-#line 76 "sample/map.c"
-    if ((test_maps_helpers[0].tail_call) && (r0 == 0))
-#line 76 "sample/map.c"
-        return 0;
-        // EBPF_OP_MOV64_REG pc=123 dst=r6 src=r0 offset=0 imm=0
+    // EBPF_OP_MOV64_REG pc=123 dst=r6 src=r0 offset=0 imm=0
 #line 76 "sample/map.c"
     r6 = r0;
     // EBPF_OP_LSH64_IMM pc=124 dst=r6 src=r0 offset=0 imm=32
@@ -618,14 +574,20 @@ label_4:
     r1 = POINTER(_maps[2].address);
     // EBPF_OP_CALL pc=131 dst=r0 src=r0 offset=0 imm=1
 #line 82 "sample/map.c"
-    r0 = test_maps_helpers[1].address
+    if (_maps[2].array_data != NULL) {
 #line 82 "sample/map.c"
-         (r1, r2, r3, r4, r5);
+        r0 = *(uint32_t*)(uintptr_t)r2;
+#line 82 "sample/map.c"
+        r0 = (r0 < 10) ? POINTER((uint8_t*)_maps[2].array_data + r0 * 4) : 0;
 #line 82 "sample/map.c"
-    if ((test_maps_helpers[1].tail_call) && (r0 == 0))
+    } else {
 #line 82 "sample/map.c"
-        return 0;
-        // EBPF_OP_LDDW pc=132 dst=r6 src=r0 offset=0 imm=-1
+        r0 = test_maps_helpers[1].address
+#line 82 "sample/map.c"
+             (r1, r2, r3, r4, r5);
+#line 82 "sample/map.c"
+    }
+    // EBPF_OP_LDDW pc=132 dst=r6 src=r0 offset=0 imm=-1
 #line 82 "sample/map.c"
     r6 = (uint64_t)4294967295;
     // EBPF_OP_JEQ_IMM pc=134 dst=r0 src=r0 offset=23 imm=0
@@ -647,11 +609,7 @@ label_4:
     r0 = test_maps_helpers[2].address
 #line 88 "sample/map.c"
          (r1, r2, r3, r4, r5);
-#line 88 "sample/map.c"
-    if ((test_maps_helpers[2].tail_call) && (r0 == 0))
-#line 88 "sample/map.c"
-        return 0;
-        // EBPF_OP_MOV64_REG pc=140 dst=r6 src=r0 offset=0 imm=0
+    // EBPF_OP_MOV64_REG pc=140 dst=r6 src=r0 offset=0 imm=0
 #line 88 "sample/map.c"
     r6 = r0;
     // EBPF_OP_LSH64_IMM pc=141 dst=r6 src=r0 offset=0 imm=32
@@ -694,11 +652,7 @@ label_4:
     r0 = test_maps_helpers[0].address
 #line 94 "sample/map.c"
          (r1, r2, r3, r4, r5);
-#line 94 "sample/map.c"
-    if ((test_maps_helpers[0].tail_call) && (r0 == 0))
-#line 94 "sample/map.c"
-        return 0;
-        // EBPF_OP_MOV64_REG pc=154 dst=r6 src=r0 offset=0 imm=0
+    // EBPF_OP_MOV64_REG pc=154 dst=r6 src=r0 offset=0 imm=0
 #line 94 "sample/map.c"
     r6 = r0;
     // EBPF_OP_LSH64_IMM pc=155 dst=r6 src=r0 offset=0 imm=32
@@ -749,11 +703,7 @@ label_6:
     r0 = test_maps_helpers[0].address
 #line 76 "sample/map.c"
          (r1, r2, r3, r4, r5);
-#line 76 "sample/map.c"
-    if ((test_maps_helpers[0].tail_call) && (r0 == 0))
-#line 76 "sample/map.c"
-        return 0;
-        // EBPF_OP_MOV64_REG pc=170 dst=r6 src=r0 offset=0 imm=0
+    // EBPF_OP_MOV64_REG pc=170 dst=r6 src=r0 offset=0 imm=0
 #line 76 "sample/map.c"
     r6 = r0;
     // EBPF_OP_LSH64_IMM pc=171 dst=r6 src=r0 offset=0 imm=32
@@ -781,11 +731,7 @@ label_6:
     r0 = test_maps_helpers[1].address
 #line 82 "sample/map.c"
          (r1, r2, r3, r4, r5);
-#line 82 "sample/map.c"
-    if ((test_maps_helpers[1].tail_call) && (r0 == 0))
-#line 82 "sample/map.c"
-        return 0;
-        // EBPF_OP_LDDW pc=179 dst=r6 src=r0 offset=0 imm=-1
+    // EBPF_OP_LDDW pc=179 dst=r6 src=r0 offset=0 imm=-1
 #line 82 "sample/map.c"
     r6 = (uint64_t)4294967295;
     // EBPF_OP_JEQ_IMM pc=181 dst=r0 src=r0 offset=23 imm=0
@@ -807,11 +753,7 @@ label_6:
     r0 = test_maps_helpers[2].address
 #line 88 "sample/map.c"
          (r1, r2, r3, r4, r5);
-#line 88 "sample/map.c"
-    if ((test_maps_helpers[2].tail_call) && (r0 == 0))
-#line 88 "sample/map.c"
-        return 0;
-        // EBPF_OP_MOV64_REG pc=187 dst=r6 src=r0 offset=0 imm=0
+    // EBPF_OP_MOV64_REG pc=187 dst=r6 src=r0 offset=0 imm=0
 #line 88 "sample/map.c"
     r6 = r0;
     // EBPF_OP_LSH64_IMM pc=188 dst=r6 src=r0 offset=0 imm=32
@@ -854,11 +796,7 @@ label_6:
     r0 = test_maps_helpers[0].address
 #line 94 "sample/map.c"
          (r1, r2, r3, r4, r5);
-#line 94 "sample/map.c"
-    if ((test_maps_helpers[0].tail_call) && (r0 == 0))
-#line 94 "sample/map.c"
-        return 0;
-        // EBPF_OP_MOV64_REG pc=201 dst=r6 src=r0 offset=0 imm=0
+    // EBPF_OP_MOV64_REG pc=201 dst=r6 src=r0 offset=0 imm=0
 #line 94 "sample/map.c"
     r6 = r0;
     // EBPF_OP_LSH64_IMM pc=202 dst=r6 src=r0 offset=0 imm=32
@@ -909,11 +847,7 @@ label_8:
     r0 = test_maps_helpers[0].address
 #line 76 "sample/map.c"
          (r1, r2, r3, r4, r5);
-#line 76 "sample/map.c"
-    if ((test_maps_helpers[0].tail_call) && (r0 == 0))
-#line 76 "sample/map.c"
-        return 0;
-        // EBPF_OP_MOV64_REG pc=217 dst=r6 src=r0 offset=0 imm=0
+    // EBPF_OP_MOV64_REG pc=217 dst=r6 src=r0 offset=0 imm=0
 #line 76 "sample/map.c"
     r6 = r0;
     // EBPF_OP_LSH64_IMM pc=218 dst=r6 src=r0 offset=0 imm=32
@@ -941,11 +875,7 @@ label_8:
     r0 = test_maps_helpers[1].address
 #line 82 "sample/map.c"
          (r1, r2, r3, r4, r5);
-#line 82 "sample/map.c"
-    if ((test_maps_helpers[1].tail_call) && (r0 == 0))
-#line 82 "sample/map.c"
-        return 0;
-        // EBPF_OP_LDDW pc=226 dst=r6 src=r0 offset=0 imm=-1
+    // EBPF_OP_LDDW pc=226 dst=r6 src=r0 offset=0 imm=-1
 #line 82 "sample/map.c"
     r6 = (uint64_t)4294967295;
     // EBPF_OP_JEQ_IMM pc=228 dst=r0 src=r0 offset=22 imm=0
@@ -967,11 +897,7 @@ label_8:
     r0 = test_maps_helpers[2].address
 #line 88 "sample/map.c"
          (r1, r2, r3, r4, r5);
-#line 88 "sample/map.c"
-    if ((test_maps_helpers[2].tail_call) && (r0 == 0))
-#line 88 "sample/map.c"
-        return 0;
-        // EBPF_OP_MOV64_REG pc=234 dst=r6 src=r0 offset=0 imm=0
+    // EBPF_OP_MOV64_REG pc=234 dst=r6 src=r0 offset=0 imm=0
 #line 88 "sample/map.c"
     r6 = r0;
     // EBPF_OP_LSH64_IMM pc=235 dst=r6 src=r0 offset=0 imm=32
@@ -1011,11 +937,7 @@ label_8:
     r0 = test_maps_helpers[0].address
 #line 94 "sample/map.c"
          (r1, r2, r3, r4, r5);
-#line 94 "sample/map.c"
-    if ((test_maps_helpers[0].tail_call) && (r0 == 0))
-#line 94 "sample/map.c"
-        return 0;
-        // EBPF_OP_MOV64_REG pc=247 dst=r6 src=r0 offset=0 imm=0
+    // EBPF_OP_MOV64_REG pc=247 dst=r6 src=r0 offset=0 imm=0
 #line 94 "sample/map.c"
     r6 = r0;
     // EBPF_OP_LSH64_IMM pc=248 dst=r6 src=r0 offset=0 imm=32
@@ -1048,11 +970,7 @@ label_10:
     r0 = test_maps_helpers[3].address
 #line 105 "sample/map.c"
          (r1, r2, r3, r4, r5);
-#line 105 "sample/map.c"
-    if ((test_maps_helpers[3].tail_call) && (r0 == 0))
-#line 105 "sample/map.c"
-        return 0;
-        // EBPF_OP_LDDW pc=257 dst=r6 src=r0 offset=0 imm=-1
+    // EBPF_OP_LDDW pc=257 dst=r6 src=r0 offset=0 imm=-1
 #line 105 "sample/map.c"
     r6 = (uint64_t)4294967295;
     // EBPF_OP_JEQ_IMM pc=259 dst=r0 src=r0 offset=-214 imm=0
@@ -1095,11 +1013,7 @@ label_10:
     r0 = test_maps_helpers[0].address
 #line 76 "sample/map.c"
          (r1, r2, r3, r4, r5);
-#line 76 "sample/map.c"
-    if ((test_maps_helpers[0].tail_call) && (r0 == 0))
-#line 76 "sample/map.c"
-        return 0;
-        // EBPF_OP_MOV64_REG pc=272 dst=r6 src=r0 offset=0 imm=0
+    // EBPF_OP_MOV64_REG pc=272 dst=r6 src=r0 offset=0 imm=0
 #line 76 "sample/map.c"
     r6 = r0;
     // EBPF_OP_LSH64_IMM pc=273 dst=r6 src=r0 offset=0 imm=32
@@ -1127,11 +1041,7 @@ label_10:
     r0 = test_maps_helpers[1].address
 #line 82 "sample/map.c"
          (r1, r2, r3, r4, r5);
-#line 82 "sample/map.c"
-    if ((test_maps_helpers[1].tail_call) && (r0 == 0))
-#line 82 "sample/map.c"
-        return 0;
-        // EBPF_OP_LDDW pc=281 dst=r6 src=r0 offset=0 imm=-1
+    // EBPF_OP_LDDW pc=281 dst=r6 src=r0 offset=0 imm=-1
 #line 82 "sample/map.c"
     r6 = (uint64_t)4294967295;
     // EBPF_OP_JEQ_IMM pc=283 dst=r0 src=r0 offset=22 imm=0
@@ -1153,11 +1063,7 @@ label_10:
     r0 = test_maps_helpers[2].address
 #line 88 "sample/map.c"
          (r1, r2, r3, r4, r5);
-#line 88 "sample/map.c"
-    if ((test_maps_helpers[2].tail_call) && (r0 == 0))
-#line 88 "sample/map.c"
-        return 0;
-        // EBPF_OP_MOV64_REG pc=289 dst=r6 src=r0 offset=0 imm=0
+    // EBPF_OP_MOV64_REG pc=289 dst=r6 src=r0 offset=0 imm=0
 #line 88 "sample/map.c"
     r6 = r0;
     // EBPF_OP_LSH64_IMM pc=290 dst=r6 src=r0 offset=0 imm=32
@@ -1197,11 +1103,7 @@ label_10:
     r0 = test_maps_helpers[0].address
 #line 94 "sample/map.c"
          (r1, r2, r3, r4, r5);
-#line 94 "sample/map.c"
-    if ((test_maps_helpers[0].tail_call) && (r0 == 0))
-#line 94 "sample/map.c"
-        return 0;
-        // EBPF_OP_MOV64_REG pc=302 dst=r6 src=r0 offset=0 imm=0
+    // EBPF_OP_MOV64_REG pc=302 dst=r6 src=r0 offset=0 imm=0
 #line 94 "sample/map.c"
     r6 = r0;
     // EBPF_OP_LSH64_IMM pc=303 dst=r6 src=r0 offset=0 imm=32
@@ -1234,11 +1136,7 @@ label_12:
     r0 = test_maps_helpers[3].address
 #line 105 "sample/map.c"
          (r1, r2, r3, r4, r5);
-#line 105 "sample/map.c"
-    if ((test_maps_helpers[3].tail_call) && (r0 == 0))
-#line 105 "sample/map.c"
-        return 0;
-        // EBPF_OP_LDDW pc=312 dst=r6 src=r0 offset=0 imm=-1
+    // EBPF_OP_LDDW pc=312 dst=r6 src=r0 offset=0 imm=-1
 #line 105 "sample/map.c"
     r6 = (uint64_t)4294967295;
     // EBPF_OP_JEQ_IMM pc=314 dst=r0 src=r0 offset=-269 imm=0
@@ -1327,11 +1225,7 @@ label_14:
     r0 = test_maps_helpers[0].address
 #line 122 "sample/map.c"
          (r1, r2, r3, r4, r5);
-#line 122 "sample/map.c"
-    if ((test_maps_helpers[0].tail_call) && (r0 == 0))
-#line 122 "sample/map.c"
-        return 0;
-        // EBPF_OP_MOV64_REG pc=341 dst=r6 src=r0 offset=0 imm=0
+    // EBPF_OP_MOV64_REG pc=341 dst=r6 src=r0 offset=0 imm=0
 #line 122 "sample/map.c"
     r6 = r0;
     // EBPF_OP_MOV64_REG pc=342 dst=r1 src=r6 offset=0 imm=0
@@ -1392,11 +1286,7 @@ label_15:
     r0 = test_maps_helpers[4].address
 #line 173 "sample/map.c"
          (r1, r2, r3, r4, r5);
-#line 173 "sample/map.c"
-    if ((test_maps_helpers[4].tail_call) && (r0 == 0))
-#line 173 "sample/map.c"
-        return 0;
-        // EBPF_OP_MOV64_REG pc=360 dst=r1 src=r0 offset=0 imm=0
+    // EBPF_OP_MOV64_REG pc=360 dst=r1 src=r0 offset=0 imm=0
 #line 173 "sample/map.c"
     r1 = r0;
     // EBPF_OP_LSH64_IMM pc=361 dst=r1 src=r0 offset=0 imm=32
@@ -1446,11 +1336,7 @@ label_16:
     r0 = test_maps_helpers[0].address
 #line 122 "sample/map.c"
          (r1, r2, r3, r4, r5);
-#line 122 "sample/map.c"
-    if ((test_maps_helpers[0].tail_call) && (r0 == 0))
-#line 122 "sample/map.c"
-        return 0;
-        // EBPF_OP_MOV64_REG pc=377 dst=r6 src=r0 offset=0 imm=0
+    // EBPF_OP_MOV64_REG pc=377 dst=r6 src=r0 offset=0 imm=0
 #line 122 "sample/map.c"
     r6 = r0;
     // EBPF_OP_MOV64_REG pc=378 dst=r1 src=r6 offset=0 imm=0
@@ -1504,11 +1390,7 @@ label_17:
     r0 = test_maps_helpers[5].address
 #line 174 "sample/map.c"
          (r1, r2, r3, r4, r5);
-#line 174 "sample/map.c"
-    if ((test_maps_helpers[5].tail_call) && (r0 == 0))
-#line 174 "sample/map.c"
-        return 0;
-        // EBPF_OP_LDXW pc=393 dst=r1 src=r10 offset=-4 imm=0
+    // EBPF_OP_LDXW pc=393 dst=r1 src=r10 offset=-4 imm=0
 #line 174 "sample/map.c"
     r1 = *(uint32_t*)(uintptr_t)(r10 + OFFSET(-4));
     // EBPF_OP_MOV64_REG pc=394 dst=r7 src=r6 offset=0 imm=0
@@ -1583,11 +1465,7 @@ label_19:
     r0 = test_maps_helpers[6].address
 #line 177 "sample/map.c"
          (r1, r2, r3, r4, r5);
-#line 177 "sample/map.c"
-    if ((test_maps_helpers[6].tail_call) && (r0 == 0))
-#line 177 "sample/map.c"
-        return 0;
-        // EBPF_OP_MOV64_REG pc=416 dst=r6 src=r0 offset=0 imm=0
+    // EBPF_OP_MOV64_REG pc=416 dst=r6 src=r0 offset=0 imm=0
 #line 177 "sample/map.c"
     r6 = r0;
     // EBPF_OP_MOV64_REG pc=417 dst=r1 src=r6 offset=0 imm=0
@@ -1627,11 +1505,7 @@ label_19:
     r0 = test_maps_helpers[6].address
 #line 177 "sample/map.c"
          (r1, r2, r3, r4, r5);
-#line 177 "sample/map.c"
-    if ((test_maps_helpers[6].tail_call) && (r0 == 0))
-#line 177 "sample/map.c"
-        return 0;
-        // EBPF_OP_MOV64_REG pc=429 dst=r6 src=r0 offset=0 imm=0
+    // EBPF_OP_MOV64_REG pc=429 dst=r6 src=r0 offset=0 imm=0
 #line 177 "sample/map.c"
     r6 = r0;
     // EBPF_OP_MOV64_REG pc=430 dst=r1 src=r6 offset=0 imm=0
@@ -1675,11 +1549,7 @@ label_20:
     r0 = test_maps_helpers[6].address
 #line 177 "sample/map.c"
          (r1, r2, r3, r4, r5);
-#line 177 "sample/map.c"
-    if ((test_maps_helpers[6].tail_call) && (r0 == 0))
-#line 177 "sample/map.c"
-        return 0;
-        // EBPF_OP_MOV64_REG pc=443 dst=r6 src=r0 offset=0 imm=0
+    // EBPF_OP_MOV64_REG pc=443 dst=r6 src=r0 offset=0 imm=0
 #line 177 "sample/map.c"
     r6 = r0;
     // EBPF_OP_MOV64_REG pc=444 dst=r1 src=r6 offset=0 imm=0
@@ -1719,11 +1589,7 @@ label_20:
     r0 = test_maps_helpers[6].address
 #line 177 "sample/map.c"
          (r1, r2, r3, r4, r5);
-#line 177 "sample/map.c"
-    if ((test_maps_helpers[6].tail_call) && (r0 == 0))
-#line 177 "sample/map.c"
-        return 0;
-        // EBPF_OP_MOV64_REG pc=456 dst=r6 src=r0 offset=0 imm=0
+    // EBPF_OP_MOV64_REG pc=456 dst=r6 src=r0 offset=0 imm=0
 #line 177 "sample/map.c"
     r6 = r0;
     // EBPF_OP_MOV64_REG pc=457 dst=r1 src=r6 offset=0 imm=0
@@ -1763,11 +1629,7 @@ label_20:
     r0 = test_maps_helpers[6].address
 #line 177 "sample/map.c"
          (r1, r2, r3, r4, r5);
-#line 177 "sample/map.c"
-    if ((test_maps_helpers[6].tail_call) && (r0 == 0))
-#line 177 "sample/map.c"
-        return 0;
-        // EBPF_OP_MOV64_REG pc=469 dst=r6 src=r0 offset=0 imm=0
+    // EBPF_OP_MOV64_REG pc=469 dst=r6 src=r0 offset=0 imm=0
 #line 177 "sample/map.c"
     r6 = r0;
     // EBPF_OP_MOV64_REG pc=470 dst=r1 src=r6 offset=0 imm=0
@@ -1807,11 +1669,7 @@ label_20:
     r0 = test_maps_helpers[6].address
 #line 177 "sample/map.c"
          (r1, r2, r3, r4, r5);
-#line 177 "sample/map.c"
-    if ((test_maps_helpers[6].tail_call) && (r0 == 0))
-#line 177 "sample/map.c"
-        return 0;
-        // EBPF_OP_MOV64_REG pc=482 dst=r6 src=r0 offset=0 imm=0
+    // EBPF_OP_MOV64_REG pc=482 dst=r6 src=r0 offset=0 imm=0
 #line 177 "sample/map.c"
     r6 = r0;
     // EBPF_OP_MOV64_REG pc=483 dst=r1 src=r6 offset=0 imm=0
@@ -1851,11 +1709,7 @@ label_20:
     r0 = test_maps_helpers[6].address
 #line 177 "sample/map.c"
          (r1, r2, r3, r4, r5);
-#line 177 "sample/map.c"
-    if ((test_maps_helpers[6].tail_call) && (r0 == 0))
-#line 177 "sample/map.c"
-        return 0;
-        // EBPF_OP_MOV64_REG pc=495 dst=r6 src=r0 offset=0 imm=0
+    // EBPF_OP_MOV64_REG pc=495 dst=r6 src=r0 offset=0 imm=0
 #line 177 "sample/map.c"
     r6 = r0;
     // EBPF_OP_MOV64_REG pc=496 dst=r1 src=r6 offset=0 imm=0
@@ -1895,11 +1749,7 @@ label_20:
     r0 = test_maps_helpers[6].address
 #line 177 "sample/map.c"
          (r1, r2, r3, r4, r5);
-#line 177 "sample/map.c"
-    if ((test_maps_helpers[6].tail_call) && (r0 == 0))
-#line 177 "sample/map.c"
-        return 0;
-        // EBPF_OP_MOV64_REG pc=508 dst=r6 src=r0 offset=0 imm=0
+    // EBPF_OP_MOV64_REG pc=508 dst=r6 src=r0 offset=0 imm=0
 #line 177 "sample/map.c"
     r6 = r0;
     // EBPF_OP_MOV64_REG pc=509 dst=r1 src=r6 offset=0 imm=0
@@ -1939,11 +1789,7 @@ label_20:
     r0 = test_maps_helpers[6].address
 #line 177 "sample/map.c"
          (r1, r2, r3, r4, r5);
-#line 177 "sample/map.c"
-    if ((test_maps_helpers[6].tail_call) && (r0 == 0))
-#line 177 "sample/map.c"
-        return 0;
-        // EBPF_OP_MOV64_REG pc=521 dst=r6 src=r0 offset=0 imm=0
+    // EBPF_OP_MOV64_REG pc=521 dst=r6 src=r0 offset=0 imm=0
 #line 177 "sample/map.c"
     r6 = r0;
     // EBPF_OP_MOV64_REG pc=522 dst=r1 src=r6 offset=0 imm=0
@@ -1983,11 +1829,7 @@ label_20:
     r0 = test_maps_helpers[6].address
 #line 177 "sample/map.c"
          (r1, r2, r3, r4, r5);
-#line 177 "sample/map.c"
-    if ((test_maps_helpers[6].tail_call) && (r0 == 0))
-#line 177 "sample/map.c"
-        return 0;
-        // EBPF_OP_MOV64_REG pc=534 dst=r6 src=r0 offset=0 imm=0
+    // EBPF_OP_MOV64_REG pc=534 dst=r6 src=r0 offset=0 imm=0
 #line 177 "sample/map.c"
     r6 = r0;
     // EBPF_OP_MOV64_REG pc=535 dst=r1 src=r6 offset=0 imm=0
@@ -2027,11 +1869,7 @@ label_20:
     r0 = test_maps_helpers[6].address
 #line 180 "sample/map.c"
          (r1, r2, r3, r4, r5);
-#line 180 "sample/map.c"
-    if ((test_maps_helpers[6].tail_call) && (r0 == 0))
-#line 180 "sample/map.c"
-        return 0;
-        // EBPF_OP_MOV64_REG pc=547 dst=r6 src=r0 offset=0 imm=0
+    // EBPF_OP_MOV64_REG pc=547 dst=r6 src=r0 offset=0 imm=0
 #line 180 "sample/map.c"
     r6 = r0;
     // EBPF_OP_MOV64_REG pc=548 dst=r1 src=r6 offset=0 imm=0
@@ -2090,11 +1928,7 @@ label_22:
     r0 = test_maps_helpers[4].address
 #line 173 "sample/map.c"
          (r1, r2, r3, r4, r5);
-#line 173 "sample/map.c"
-    if ((test_maps_helpers[4].tail_call) && (r0 == 0))
-#line 173 "sample/map.c"
-        return 0;
-        // EBPF_OP_MOV64_REG pc=566 dst=r1 src=r0 offset=0 imm=0
+    // EBPF_OP_MOV64_REG pc=566 dst=r1 src=r0 offset=0 imm=0
 #line 173 "sample/map.c"
     r1 = r0;
     // EBPF_OP_LSH64_IMM pc=567 dst=r1 src=r0 offset=0 imm=32
@@ -2151,11 +1985,7 @@ label_23:
     r0 = test_maps_helpers[5].address
 #line 174 "sample/map.c"
          (r1, r2, r3, r4, r5);
-#line 174 "sample/map.c"
-    if ((test_maps_helpers[5].tail_call) && (r0 == 0))
-#line 174 "sample/map.c"
-        return 0;
-        // EBPF_OP_LDXW pc=584 dst=r1 src=r10 offset=-4 imm=0
+    // EBPF_OP_LDXW pc=584 dst=r1 src=r10 offset=-4 imm=0
 #line 174 "sample/map.c"
     r1 = *(uint32_t*)(uintptr_t)(r10 + OFFSET(-4));
     // EBPF_OP_MOV64_REG pc=585 dst=r6 src=r7 offset=0 imm=0
@@ -2230,11 +2060,7 @@ label_25:
     r0 = test_maps_helpers[6].address
 #line 177 "sample/map.c"
          (r1, r2, r3, r4, r5);
-#line 177 "sample/map.c"
-    if ((test_maps_helpers[6].tail_call) && (r0 == 0))
-#line 177 "sample/map.c"
-        return 0;
-        // EBPF_OP_MOV64_REG pc=607 dst=r7 src=r0 offset=0 imm=0
+    // EBPF_OP_MOV64_REG pc=607 dst=r7 src=r0 offset=0 imm=0
 #line 177 "sample/map.c"
     r7 = r0;
     // EBPF_OP_MOV64_REG pc=608 dst=r1 src=r7 offset=0 imm=0
@@ -2274,11 +2100,7 @@ label_25:
     r0 = test_maps_helpers[6].address
 #line 177 "sample/map.c"
          (r1, r2, r3, r4, r5);
-#line 177 "sample/map.c"
-    if ((test_maps_helpers[6].tail_call) && (r0 == 0))
-#line 177 "sample/map.c"
-        return 0;
-        // EBPF_OP_MOV64_REG pc=620 dst=r7 src=r0 offset=0 imm=0
+    // EBPF_OP_MOV64_REG pc=620 dst=r7 src=r0 offset=0 imm=0
 #line 177 "sample/map.c"
     r7 = r0;
     // EBPF_OP_MOV64_REG pc=621 dst=r1 src=r7 offset=0 imm=0
@@ -2322,11 +2144,7 @@ label_26:
     r0 = test_maps_helpers[6].address
 #line 177 "sample/map.c"
          (r1, r2, r3, r4, r5);
-#line 177 "sample/map.c"
-    if ((test_maps_helpers[6].tail_call) && (r0 == 0))
-#line 177 "sample/map.c"
-        return 0;
-        // EBPF_OP_MOV64_REG pc=634 dst=r7 src=r0 offset=0 imm=0
+    // EBPF_OP_MOV64_REG pc=634 dst=r7 src=r0 offset=0 imm=0
 #line 177 "sample/map.c"
     r7 = r0;
     // EBPF_OP_MOV64_REG pc=635 dst=r1 src=r7 offset=0 imm=0
@@ -2366,11 +2184,7 @@ label_26:
     r0 = test_maps_helpers[6].address
 #line 177 "sample/map.c"
          (r1, r2, r3, r4, r5);
-#line 177 "sample/map.c"
-    if ((test_maps_helpers[6].tail_call) && (r0 == 0))
-#line 177 "sample/map.c"
-        return 0;
-        // EBPF_OP_MOV64_REG pc=647 dst=r7 src=r0 offset=0 imm=0
+    // EBPF_OP_MOV64_REG pc=647 dst=r7 src=r0 offset=0 imm=0
 #line 177 "sample/map.c"
     r7 = r0;
     // EBPF_OP_MOV64_REG pc=648 dst=r1 src=r7 offset=0 imm=0
@@ -2410,11 +2224,7 @@ label_26:
     r0 = test_maps_helpers[6].address
 #line 177 "sample/map.c"
          (r1, r2, r3, r4, r5);
-#line 177 "sample/map.c"
-    if ((test_maps_helpers[6].tail_call) && (r0 == 0))
-#line 177 "sample/map.c"
-        return 0;
-        // EBPF_OP_MOV64_REG pc=660 dst=r7 src=r0 offset=0 imm=0
+    // EBPF_OP_MOV64_REG pc=660 dst=r7 src=r0 offset=0 imm=0
 #line 177 "sample/map.c"
     r7 = r0;
     // EBPF_OP_MOV64_REG pc=661 dst=r1 src=r7 offset=0 imm=0
@@ -2454,11 +2264,7 @@ label_26:
     r0 = test_maps_helpers[6].address
 #line 177 "sample/map.c"
          (r1, r2, r3, r4, r5);
-#line 177 "sample/map.c"
-    if ((test_maps_helpers[6].tail_call) && (r0 == 0))
-#line 177 "sample/map.c"
-        return 0;
-        // EBPF_OP_MOV64_REG pc=673 dst=r7 src=r0 offset=0 imm=0
+    // EBPF_OP_MOV64_REG pc=673 dst=r7 src=r0 offset=0 imm=0
 #line 177 "sample/map.c"
     r7 = r0;
     // EBPF_OP_MOV64_REG pc=674 dst=r1 src=r7 offset=0 imm=0
@@ -2498,11 +2304,7 @@ label_26:
     r0 = test_maps_helpers[6].address
 #line 177 "sample/map.c"
          (r1, r2, r3, r4, r5);
-#line 177 "sample/map.c"
-    if ((test_maps_helpers[6].tail_call) && (r0 == 0))
-#line 177 "sample/map.c"
-        return 0;
-        // EBPF_OP_MOV64_REG pc=686 dst=r7 src=r0 offset=0 imm=0
+    // EBPF_OP_MOV64_REG pc=686 dst=r7 src=r0 offset=0 imm=0
 #line 177 "sample/map.c"
     r7 = r0;
     // EBPF_OP_MOV64_REG pc=687 dst=r1 src=r7 offset=0 imm=0
@@ -2542,11 +2344,7 @@ label_26:
     r0 = test_maps_helpers[6].address
 #line 177 "sample/map.c"
          (r1, r2, r3, r4, r5);
-#line 177 "sample/map.c"
-    if ((test_maps_helpers[6].tail_call) && (r0 == 0))
-#line 177 "sample/map.c"
-        return 0;
-        // EBPF_OP_MOV64_REG pc=699 dst=r7 src=r0 offset=0 imm=0
+    // EBPF_OP_MOV64_REG pc=699 dst=r7 src=r0 offset=0 imm=0
 #line 177 "sample/map.c"
     r7 = r0;
     // EBPF_OP_MOV64_REG pc=700 dst=r1 src=r7 offset=0 imm=0
@@ -2586,11 +2384,7 @@ label_26:
     r0 = test_maps_helpers[6].address
 #line 177 "sample/map.c"
          (r1, r2, r3, r4, r5);
-#line 177 "sample/map.c"
-    if ((test_maps_helpers[6].tail_call) && (r0 == 0))
-#line 177 "sample/map.c"
-        return 0;
-        // EBPF_OP_MOV64_REG pc=712 dst=r7 src=r0 offset=0 imm=0
+    // EBPF_OP_MOV64_REG pc=712 dst=r7 src=r0 offset=0 imm=0
 #line 177 "sample/map.c"
     r7 = r0;
     // EBPF_OP_MOV64_REG pc=713 dst=r1 src=r7 offset=0 imm=0
@@ -2630,11 +2424,7 @@ label_26:
     r0 = test_maps_helpers[6].address
 #line 177 "sample/map.c"
          (r1, r2, r3, r4, r5);
-#line 177 "sample/map.c"
-    if ((test_maps_helpers[6].tail_call) && (r0 == 0))
-#line 177 "sample/map.c"
-        return 0;
-        // EBPF_OP_MOV64_REG pc=725 dst=r7 src=r0 offset=0 imm=0
+    // EBPF_OP_MOV64_REG pc=725 dst=r7 src=r0 offset=0 imm=0
 #line 177 "sample/map.c"
     r7 = r0;
     // EBPF_OP_MOV64_REG pc=726 dst=r1 src=r7 offset=0 imm=0
@@ -2674,11 +2464,7 @@ label_26:
     r0 = test_maps_helpers[6].address
 #line 180 "sample/map.c"
          (r1, r2, r3, r4, r5);
-#line 180 "sample/map.c"
-    if ((test_maps_helpers[6].tail_call) && (r0 == 0))
-#line 180 "sample/map.c"
-        return 0;
-        // EBPF_OP_MOV64_REG pc=738 dst=r7 src=r0 offset=0 imm=0
+    // EBPF_OP_MOV64_REG pc=738 dst=r7 src=r0 offset=0 imm=0
 #line 180 "sample/map.c"
     r7 = r0;
     // EBPF_OP_MOV64_REG pc=739 dst=r1 src=r7 offset=0 imm=0
@@ -2744,11 +2530,7 @@ label_29:
     r0 = test_maps_helpers[6].address
 #line 181 "sample/map.c"
          (r1, r2, r3, r4, r5);
-#line 181 "sample/map.c"
-    if ((test_maps_helpers[6].tail_call) && (r0 == 0))
-#line 181 "sample/map.c"
-        return 0;
-        // EBPF_OP_MOV64_REG pc=759 dst=r6 src=r0 offset=0 imm=0
+    // EBPF_OP_MOV64_REG pc=759 dst=r6 src=r0 offset=0 imm=0
 #line 181 "sample/map.c"
     r6 = r0;
     // EBPF_OP_MOV64_REG pc=760 dst=r1 src=r6 offset=0 imm=0
@@ -2794,11 +2576,7 @@ label_30:
     r0 = test_maps_helpers[4].address
 #line 183 "sample/map.c"
          (r1, r2, r3, r4, r5);
-#line 183 "sample/map.c"
-    if ((test_maps_helpers[4].tail_call) && (r0 == 0))
-#line 183 "sample/map.c"
-        return 0;
-        // EBPF_OP_MOV64_REG pc=773 dst=r6 src=r0 offset=0 imm=0
+    // EBPF_OP_MOV64_REG pc=773 dst=r6 src=r0 offset=0 imm=0
 #line 183 "sample/map.c"
     r6 = r0;
     // EBPF_OP_MOV64_REG pc=774 dst=r1 src=r6 offset=0 imm=0
@@ -2839,11 +2617,7 @@ label_31:
     r0 = test_maps_helpers[6].address
 #line 181 "sample/map.c"
          (r1, r2, r3, r4, r5);
-#line 181 "sample/map.c"
-    if ((test_maps_helpers[6].tail_call) && (r0 == 0))
-#line 181 "sample/map.c"
-        return 0;
-        // EBPF_OP_MOV64_REG pc=786 dst=r7 src=r0 offset=0 imm=0
+    // EBPF_OP_MOV64_REG pc=786 dst=r7 src=r0 offset=0 imm=0
 #line 181 "sample/map.c"
     r7 = r0;
     // EBPF_OP_MOV64_REG pc=787 dst=r1 src=r7 offset=0 imm=0
@@ -2889,11 +2663,7 @@ label_32:
     r0 = test_maps_helpers[4].address
 #line 183 "sample/map.c"
          (r1, r2, r3, r4, r5);
-#line 183 "sample/map.c"
-    if ((test_maps_helpers[4].tail_call) && (r0 == 0))
-#line 183 "sample/map.c"
-        return 0;
-        // EBPF_OP_MOV64_REG pc=800 dst=r7 src=r0 offset=0 imm=0
+    // EBPF_OP_MOV64_REG pc=800 dst=r7 src=r0 offset=0 imm=0
 #line 183 "sample/map.c"
     r7 = r0;
     // EBPF_OP_MOV64_REG pc=801 dst=r1 src=r7 offset=0 imm=0
@@ -2945,11 +2715,7 @@ label_33:
     r0 = test_maps_helpers[5].address
 #line 186 "sample/map.c"
          (r1, r2, r3, r4, r5);
-#line 186 "sample/map.c"
-    if ((test_maps_helpers[5].tail_call) && (r0 == 0))
-#line 186 "sample/map.c"
-        return 0;
-        // EBPF_OP_MOV64_REG pc=817 dst=r6 src=r0 offset=0 imm=0
+    // EBPF_OP_MOV64_REG pc=817 dst=r6 src=r0 offset=0 imm=0
 #line 186 "sample/map.c"
     r6 = r0;
     // EBPF_OP_MOV64_REG pc=818 dst=r1 src=r6 offset=0 imm=0
@@ -3005,11 +2771,7 @@ label_35:
     r0 = test_maps_helpers[5].address
 #line 186 "sample/map.c"
          (r1, r2, r3, r4, r5);
-#line 186 "sample/map.c"
-    if ((test_maps_helpers[5].tail_call) && (r0 == 0))
-#line 186 "sample/map.c"
-        return 0;
-        // EBPF_OP_MOV64_REG pc=835 dst=r6 src=r0 offset=0 imm=0
+    // EBPF_OP_MOV64_REG pc=835 dst=r6 src=r0 offset=0 imm=0
 #line 186 "sample/map.c"
     r6 = r0;
     // EBPF_OP_MOV64_REG pc=836 dst=r1 src=r6 offset=0 imm=0
@@ -3062,11 +2824,7 @@ label_37:
     r0 = test_maps_helpers[5].address
 #line 186 "sample/map.c"
          (r1, r2, r3, r4, r5);
-#line 186 "sample/map.c"
-    if ((test_maps_helpers[5].tail_call) && (r0 == 0))
-#line 186 "sample/map.c"
-        return 0;
-        // EBPF_OP_MOV64_REG pc=852 dst=r7 src=r0 offset=0 imm=0
+    // EBPF_OP_MOV64_REG pc=852 dst=r7 src=r0 offset=0 imm=0
 #line 186 "sample/map.c"
     r7 = r0;
     // EBPF_OP_MOV64_REG pc=853 dst=r1 src=r7 offset=0 imm=0
@@ -3122,11 +2880,7 @@ label_39:
     r0 = test_maps_helpers[5].address
 #line 186 "sample/map.c"
          (r1, r2, r3, r4, r5);
-#line 186 "sample/map.c"
-    if ((test_maps_helpers[5].tail_call) && (r0 == 0))
-#line 186 "sample/map.c"
-        return 0;
-        // EBPF_OP_MOV64_REG pc=870 dst=r7 src=r0 offset=0 imm=0
+    // EBPF_OP_MOV64_REG pc=870 dst=r7 src=r0 offset=0 imm=0
 #line 186 "sample/map.c"
     r7 = r0;
     // EBPF_OP_MOV64_REG pc=871 dst=r1 src=r7 offset=0 imm=0
@@ -3179,11 +2933,7 @@ label_41:
     r0 = test_maps_helpers[5].address
 #line 186 "sample/map.c"
          (r1, r2, r3, r4, r5);
-#line 186 "sample/map.c"
-    if ((test_maps_helpers[5].tail_call) && (r0 == 0))
-#line 186 "sample/map.c"
-        return 0;
-        // EBPF_OP_MOV64_REG pc=887 dst=r6 src=r0 offset=0 imm=0
+    // EBPF_OP_MOV64_REG pc=887 dst=r6 src=r0 offset=0 imm=0
 #line 186 "sample/map.c"
     r6 = r0;
     // EBPF_OP_MOV64_REG pc=888 dst=r1 src=r6 offset=0 imm=0
@@ -3231,11 +2981,7 @@ label_41:
     r0 = test_maps_helpers[5].address
 #line 186 "sample/map.c"
          (r1, r2, r3, r4, r5);
-#line 186 "sample/map.c"
-    if ((test_maps_helpers[5].tail_call) && (r0 == 0))
-#line 186 "sample/map.c"
-        return 0;
-        // EBPF_OP_MOV64_REG pc=903 dst=r6 src=r0 offset=0 imm=0
+    // EBPF_OP_MOV64_REG pc=903 dst=r6 src=r0 offset=0 imm=0
 #line 186 "sample/map.c"
     r6 = r0;
     // EBPF_OP_MOV64_REG pc=904 dst=r1 src=r6 offset=0 imm=0
@@ -3283,11 +3029,7 @@ label_41:
     r0 = test_maps_helpers[5].address
 #line 186 "sample/map.c"
          (r1, r2, r3, r4, r5);
-#line 186 "sample/map.c"
-    if ((test_maps_helpers[5].tail_call) && (r0 == 0))
-#line 186 "sample/map.c"
-        return 0;
-        // EBPF_OP_MOV64_REG pc=919 dst=r6 src=r0 offset=0 imm=0
+    // EBPF_OP_MOV64_REG pc=919 dst=r6 src=r0 offset=0 imm=0
 #line 186 "sample/map.c"
     r6 = r0;
     // EBPF_OP_MOV64_REG pc=920 dst=r1 src=r6 offset=0 imm=0
@@ -3335,11 +3077,7 @@ label_41:
     r0 = test_maps_helpers[5].address
 #line 186 "sample/map.c"
          (r1, r2, r3, r4, r5);
-#line 186 "sample/map.c"
-    if ((test_maps_helpers[5].tail_call) && (r0 == 0))
-#line 186 "sample/map.c"
-        return 0;
-        // EBPF_OP_MOV64_REG pc=935 dst=r6 src=r0 offset=0 imm=0
+    // EBPF_OP_MOV64_REG pc=935 dst=r6 src=r0 offset=0 imm=0
 #line 186 "sample/map.c"
     r6 = r0;
     // EBPF_OP_MOV64_REG pc=936 dst=r1 src=r6 offset=0 imm=0
@@ -3387,11 +3125,7 @@ label_41:
     r0 = test_maps_helpers[5].address
 #line 186 "sample/map.c"
          (r1, r2, r3, r4, r5);
-#line 186 "sample/map.c"
-    if ((test_maps_helpers[5].tail_call) && (r0 == 0))
-#line 186 "sample/map.c"
-        return 0;
-        // EBPF_OP_MOV64_REG pc=951 dst=r6 src=r0 offset=0 imm=0
+    // EBPF_OP_MOV64_REG pc=951 dst=r6 src=r0 offset=0 imm=0
 #line 186 "sample/map.c"
     r6 = r0;
     // EBPF_OP_MOV64_REG pc=952 dst=r1 src=r6 offset=0 imm=0
@@ -3439,11 +3173,7 @@ label_41:
     r0 = test_maps_helpers[5].address
 #line 186 "sample/map.c"
          (r1, r2, r3, r4, r5);
-#line 186 "sample/map.c"
-    if ((test_maps_helpers[5].tail_call) && (r0 == 0))
-#line 186 "sample/map.c"
-        return 0;
-        // EBPF_OP_MOV64_REG pc=967 dst=r6 src=r0 offset=0 imm=0
+    // EBPF_OP_MOV64_REG pc=967 dst=r6 src=r0 offset=0 imm=0
 #line 186 "sample/map.c"
     r6 = r0;
     // EBPF_OP_MOV64_REG pc=968 dst=r1 src=r6 offset=0 imm=0
@@ -3491,11 +3221,7 @@ label_41:
     r0 = test_maps_helpers[5].address
 #line 186 "sample/map.c"
          (r1, r2, r3, r4, r5);
-#line 186 "sample/map.c"
-    if ((test_maps_helpers[5].tail_call) && (r0 == 0))
-#line 186 "sample/map.c"
-        return 0;
-        // EBPF_OP_MOV64_REG pc=983 dst=r6 src=r0 offset=0 imm=0
+    // EBPF_OP_MOV64_REG pc=983 dst=r6 src=r0 offset=0 imm=0
 #line 186 "sample/map.c"
     r6 = r0;
     // EBPF_OP_MOV64_REG pc=984 dst=r1 src=r6 offset=0 imm=0
@@ -3543,11 +3269,7 @@ label_41:
     r0 = test_maps_helpers[5].address
 #line 186 "sample/map.c"
          (r1, r2, r3, r4, r5);
-#line 186 "sample/map.c"
-    if ((test_maps_helpers[5].tail_call) && (r0 == 0))
-#line 186 "sample/map.c"
-        return 0;
-        // EBPF_OP_MOV64_REG pc=999 dst=r6 src=r0 offset=0 imm=0
+    // EBPF_OP_MOV64_REG pc=999 dst=r6 src=r0 offset=0 imm=0
 #line 186 "sample/map.c"
     r6 = r0;
     // EBPF_OP_MOV64_REG pc=1000 dst=r1 src=r6 offset=0 imm=0
@@ -3595,11 +3317,7 @@ label_41:
     r0 = test_maps_helpers[4].address
 #line 189 "sample/map.c"
          (r1, r2, r3, r4, r5);
-#line 189 "sample/map.c"
-    if ((test_maps_helpers[4].tail_call) && (r0 == 0))
-#line 189 "sample/map.c"
-        return 0;
-        // EBPF_OP_LDXW pc=1015 dst=r1 src=r10 offset=-4 imm=0
+    // EBPF_OP_LDXW pc=1015 dst=r1 src=r10 offset=-4 imm=0
 #line 189 "sample/map.c"
     r1 = *(uint32_t*)(uintptr_t)(r10 + OFFSET(-4));
     // EBPF_OP_MOV64_REG pc=1016 dst=r6 src=r7 offset=0 imm=0
@@ -3669,11 +3387,7 @@ label_44:
     r0 = test_maps_helpers[5].address
 #line 190 "sample/map.c"
          (r1, r2, r3, r4, r5);
-#line 190 "sample/map.c"
-    if ((test_maps_helpers[5].tail_call) && (r0 == 0))
-#line 190 "sample/map.c"
-        return 0;
-        // EBPF_OP_LDXW pc=1036 dst=r1 src=r10 offset=-4 imm=0
+    // EBPF_OP_LDXW pc=1036 dst=r1 src=r10 offset=-4 imm=0
 #line 190 "sample/map.c"
     r1 = *(uint32_t*)(uintptr_t)(r10 + OFFSET(-4));
     // EBPF_OP_JEQ_IMM pc=1037 dst=r1 src=r0 offset=1 imm=0
@@ -3751,11 +3465,7 @@ label_47:
     r0 = test_maps_helpers[5].address
 #line 186 "sample/map.c"
          (r1, r2, r3, r4, r5);
-#line 186 "sample/map.c"
-    if ((test_maps_helpers[5].tail_call) && (r0 == 0))
-#line 186 "sample/map.c"
-        return 0;
-        // EBPF_OP_MOV64_REG pc=1060 dst=r7 src=r0 offset=0 imm=0
+    // EBPF_OP_MOV64_REG pc=1060 dst=r7 src=r0 offset=0 imm=0
 #line 186 "sample/map.c"
     r7 = r0;
     // EBPF_OP_MOV64_REG pc=1061 dst=r1 src=r7 offset=0 imm=0
@@ -3803,11 +3513,7 @@ label_47:
     r0 = test_maps_helpers[5].address
 #line 186 "sample/map.c"
          (r1, r2, r3, r4, r5);
-#line 186 "sample/map.c"
-    if ((test_maps_helpers[5].tail_call) && (r0 == 0))
-#line 186 "sample/map.c"
-        return 0;
-        // EBPF_OP_MOV64_REG pc=1076 dst=r7 src=r0 offset=0 imm=0
+    // EBPF_OP_MOV64_REG pc=1076 dst=r7 src=r0 offset=0 imm=0
 #line 186 "sample/map.c"
     r7 = r0;
     // EBPF_OP_MOV64_REG pc=1077 dst=r1 src=r7 offset=0 imm=0
@@ -3855,11 +3561,7 @@ label_47:
     r0 = test_maps_helpers[5].address
 #line 186 "sample/map.c"
          (r1, r2, r3, r4, r5);
-#line 186 "sample/map.c"
-    if ((test_maps_helpers[5].tail_call) && (r0 == 0))
-#line 186 "sample/map.c"
-        return 0;
-        // EBPF_OP_MOV64_REG pc=1092 dst=r7 src=r0 offset=0 imm=0
+    // EBPF_OP_MOV64_REG pc=1092 dst=r7 src=r0 offset=0 imm=0
 #line 186 "sample/map.c"
     r7 = r0;
     // EBPF_OP_MOV64_REG pc=1093 dst=r1 src=r7 offset=0 imm=0
@@ -3907,11 +3609,7 @@ label_47:
     r0 = test_maps_helpers[5].address
 #line 186 "sample/map.c"
          (r1, r2, r3, r4, r5);
-#line 186 "sample/map.c"
-    if ((test_maps_helpers[5].tail_call) && (r0 == 0))
-#line 186 "sample/map.c"
-        return 0;
-        // EBPF_OP_MOV64_REG pc=1108 dst=r7 src=r0 offset=0 imm=0
+    // EBPF_OP_MOV64_REG pc=1108 dst=r7 src=r0 offset=0 imm=0
 #line 186 "sample/map.c"
     r7 = r0;
     // EBPF_OP_MOV64_REG pc=1109 dst=r1 src=r7 offset=0 imm=0
@@ -3959,11 +3657,7 @@ label_47:
     r0 = test_maps_helpers[5].address
 #line 186 "sample/map.c"
          (r1, r2, r3, r4, r5);
-#line 186 "sample/map.c"
-    if ((test_maps_helpers[5].tail_call) && (r0 == 0))
-#line 186 "sample/map.c"
-        return 0;
-        // EBPF_OP_MOV64_REG pc=1124 dst=r7 src=r0 offset=0 imm=0
+    // EBPF_OP_MOV64_REG pc=1124 dst=r7 src=r0 offset=0 imm=0
 #line 186 "sample/map.c"
     r7 = r0;
     // EBPF_OP_MOV64_REG pc=1125 dst=r1 src=r7 offset=0 imm=0
@@ -4011,11 +3705,7 @@ label_47:
     r0 = test_maps_helpers[5].address
 #line 186 "sample/map.c"
          (r1, r2, r3, r4, r5);
-#line 186 "sample/map.c"
-    if ((test_maps_helpers[5].tail_call) && (r0 == 0))
-#line 186 "sample/map.c"
-        return 0;
-        // EBPF_OP_MOV64_REG pc=1140 dst=r7 src=r0 offset=0 imm=0
+    // EBPF_OP_MOV64_REG pc=1140 dst=r7 src=r0 offset=0 imm=0
 #line 186 "sample/map.c"
     r7 = r0;
     // EBPF_OP_MOV64_REG pc=1141 dst=r1 src=r7 offset=0 imm=0
@@ -4063,11 +3753,7 @@ label_47:
     r0 = test_maps_helpers[5].address
 #line 186 "sample/map.c"
          (r1, r2, r3, r4, r5);
-#line 186 "sample/map.c"
-    if ((test_maps_helpers[5].tail_call) && (r0 == 0))
-#line 186 "sample/map.c"
-        return 0;
-        // EBPF_OP_MOV64_REG pc=1156 dst=r7 src=r0 offset=0 imm=0
+    // EBPF_OP_MOV64_REG pc=1156 dst=r7 src=r0 offset=0 imm=0
 #line 186 "sample/map.c"
     r7 = r0;
     // EBPF_OP_MOV64_REG pc=1157 dst=r1 src=r7 offset=0 imm=0
@@ -4115,11 +3801,7 @@ label_47:
     r0 = test_maps_helpers[5].address
 #line 186 "sample/map.c"
          (r1, r2, r3, r4, r5);
-#line 186 "sample/map.c"
-    if ((test_maps_helpers[5].tail_call) && (r0 == 0))
-#line 186 "sample/map.c"
-        return 0;
-        // EBPF_OP_MOV64_REG pc=1172 dst=r7 src=r0 offset=0 imm=0
+    // EBPF_OP_MOV64_REG pc=1172 dst=r7 src=r0 offset=0 imm=0
 #line 186 "sample/map.c"
     r7 = r0;
     // EBPF_OP_MOV64_REG pc=1173 dst=r1 src=r7 offset=0 imm=0
@@ -4167,11 +3849,7 @@ label_47:
     r0 = test_maps_helpers[4].address
 #line 189 "sample/map.c"
          (r1, r2, r3, r4, r5);
-#line 189 "sample/map.c"
-    if ((test_maps_helpers[4].tail_call) && (r0 == 0))
-#line 189 "sample/map.c"
-        return 0;
-        // EBPF_OP_LDXW pc=1188 dst=r1 src=r10 offset=-4 imm=0
+    // EBPF_OP_LDXW pc=1188 dst=r1 src=r10 offset=-4 imm=0
 #line 189 "sample/map.c"
     r1 = *(uint32_t*)(uintptr_t)(r10 + OFFSET(-4));
     // EBPF_OP_MOV64_REG pc=1189 dst=r7 src=r6 offset=0 imm=0
@@ -4241,11 +3919,7 @@ label_50:
     r0 = test_maps_helpers[5].address
 #line 190 "sample/map.c"
          (r1, r2, r3, r4, r5);
-#line 190 "sample/map.c"
-    if ((test_maps_helpers[5].tail_call) && (r0 == 0))
-#line 190 "sample/map.c"
-        return 0;
-        // EBPF_OP_LDXW pc=1209 dst=r1 src=r10 offset=-4 imm=0
+    // EBPF_OP_LDXW pc=1209 dst=r1 src=r10 offset=-4 imm=0
 #line 190 "sample/map.c"
     r1 = *(uint32_t*)(uintptr_t)(r10 + OFFSET(-4));
     // EBPF_OP_JEQ_IMM pc=1210 dst=r1 src=r0 offset=1 imm=0
@@ -4326,7 +4000,7 @@ static void
 _get_version(_Out_ bpf2c_version_t* version)
 {
     version->major = 0;
-    version->minor = 5;
+    version->minor = 6;
     version->revision = 0;
 }
 
@@ -127,11 +127,7 @@ lookup_update(void* context)
     r0 = lookup_update_helpers[0].address
 #line 52 "sample/map_reuse_2.c"
          (r1, r2, r3, r4, r5);
-#line 52 "sample/map_reuse_2.c"
-    if ((lookup_update_helpers[0].tail_call) && (r0 == 0))
-#line 52 "sample/map_reuse_2.c"
-        return 0;
-        // EBPF_OP_JEQ_IMM pc=7 dst=r0 src=r0 offset=21 imm=0
+    // EBPF_OP_JEQ_IMM pc=7 dst=r0 src=r0 offset=21 imm=0
 #line 53 "sample/map_reuse_2.c"
     if (r0 == IMMEDIATE(0))
 #line 53 "sample/map_reuse_2.c"
@@ -156,11 +152,7 @@ lookup_update(void* context)
     r0 = lookup_update_helpers[0].address
 #line 55 "sample/map_reuse_2.c"
          (r1, r2, r3, r4, r5);
-#line 55 "sample/map_reuse_2.c"
-    if ((lookup_update_helpers[0].tail_call) && (r0 == 0))
-#line 55 "sample/map_reuse_2.c"
-        return 0;
-        // EBPF_OP_MOV64_REG pc=14 dst=r7 src=r0 offset=0 imm=0
+    // EBPF_OP_MOV64_REG pc=14 dst=r7 src=r0 offset=0 imm=0
 #line 55 "sample/map_reuse_2.c"
     r7 = r0;
     // EBPF_OP_JNE_IMM pc=15 dst=r7 src=r0 offset=1 imm=0
@@ -204,11 +196,7 @@ label_1:
     r0 = lookup_update_helpers[1].address
 #line 60 "sample/map_reuse_2.c"
          (r1, r2, r3, r4, r5);
-#line 60 "sample/map_reuse_2.c"
-    if ((lookup_update_helpers[1].tail_call) && (r0 == 0))
-#line 60 "sample/map_reuse_2.c"
-        return 0;
-        // EBPF_OP_LDXW pc=28 dst=r6 src=r7 offset=0 imm=0
+    // EBPF_OP_LDXW pc=28 dst=r6 src=r7 offset=0 imm=0
 #line 62 "sample/map_reuse_2.c"
     r6 = *(uint32_t*)(uintptr_t)(r7 + OFFSET(0));
 label_2:
@@ -253,7 +241,7 @@ static void
 _get_version(_Out_ bpf2c_version_t* version)
 {
     version->major = 0;
-    version->minor = 5;
+    version->minor = 6;
     version->revision = 0;
 }
 
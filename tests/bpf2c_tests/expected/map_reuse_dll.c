@@ -161,11 +161,7 @@ lookup_update(void* context)
     r0 = lookup_update_helpers[0].address
 #line 50 "sample/map_reuse.c"
          (r1, r2, r3, r4, r5);
-#line 50 "sample/map_reuse.c"
-    if ((lookup_update_helpers[0].tail_call) && (r0 == 0))
-#line 50 "sample/map_reuse.c"
-        return 0;
-        // EBPF_OP_JEQ_IMM pc=7 dst=r0 src=r0 offset=21 imm=0
+    // EBPF_OP_JEQ_IMM pc=7 dst=r0 src=r0 offset=21 imm=0
 #line 51 "sample/map_reuse.c"
     if (r0 == IMMEDIATE(0))
 #line 51 "sample/map_reuse.c"
@@ -190,11 +186,7 @@ lookup_update(void* context)
     r0 = lookup_update_helpers[0].address
 #line 53 "sample/map_reuse.c"
          (r1, r2, r3, r4, r5);
-#line 53 "sample/map_reuse.c"
-    if ((lookup_update_helpers[0].tail_call) && (r0 == 0))
-#line 53 "sample/map_reuse.c"
-        return 0;
-        // EBPF_OP_MOV64_REG pc=14 dst=r7 src=r0 offset=0 imm=0
+    // EBPF_OP_MOV64_REG pc=14 dst=r7 src=r0 offset=0 imm=0
 #line 53 "sample/map_reuse.c"
     r7 = r0;
     // EBPF_OP_JNE_IMM pc=15 dst=r7 src=r0 offset=1 imm=0
@@ -238,11 +230,7 @@ label_1:
     r0 = lookup_update_helpers[1].address
 #line 58 "sample/map_reuse.c"
          (r1, r2, r3, r4, r5);
-#line 58 "sample/map_reuse.c"
-    if ((lookup_update_helpers[1].tail_call) && (r0 == 0))
-#line 58 "sample/map_reuse.c"
-        return 0;
-        // EBPF_OP_LDXW pc=28 dst=r6 src=r7 offset=0 imm=0
+    // EBPF_OP_LDXW pc=28 dst=r6 src=r7 offset=0 imm=0
 #line 60 "sample/map_reuse.c"
     r6 = *(uint32_t*)(uintptr_t)(r7 + OFFSET(0));
 label_2:
@@ -287,7 +275,7 @@ static void
 _get_version(_Out_ bpf2c_version_t* version)
 {
     version->major = 0;
-    version->minor = 5;
+    version->minor = 6;
     version->revision = 0;
 }
 
@@ -381,11 +381,7 @@ test_maps(void* context)
     r0 = test_maps_helpers[0].address
 #line 76 "sample/map.c"
          (r1, r2, r3, r4, r5);
-#line 76 "sample/map.c"
-    if ((test_maps_helpers[0].tail_call) && (r0 == 0))
-#line 76 "sample/map.c"
-        return 0;
-        // EBPF_OP_MOV64_REG pc=12 dst=r6 src=r0 offset=0 imm=0
+    // EBPF_OP_MOV64_REG pc=12 dst=r6 src=r0 offset=0 imm=0
 #line 76 "sample/map.c"
     r6 = r0;
     // EBPF_OP_LSH64_IMM pc=13 dst=r6 src=r0 offset=0 imm=32
@@ -413,11 +409,7 @@ test_maps(void* context)
     r0 = test_maps_helpers[1].address
 #line 82 "sample/map.c"
          (r1, r2, r3, r4, r5);
-#line 82 "sample/map.c"
-    if ((test_maps_helpers[1].tail_call) && (r0 == 0))
-#line 82 "sample/map.c"
-        return 0;
-        // EBPF_OP_LDDW pc=21 dst=r6 src=r0 offset=0 imm=-1
+    // EBPF_OP_LDDW pc=21 dst=r6 src=r0 offset=0 imm=-1
 #line 82 "sample/map.c"
     r6 = (uint64_t)4294967295;
     // EBPF_OP_JEQ_IMM pc=23 dst=r0 src=r0 offset=22 imm=0
@@ -439,11 +431,7 @@ test_maps(void* context)
     r0 = test_maps_helpers[2].address
 #line 88 "sample/map.c"
          (r1, r2, r3, r4, r5);
-#line 88 "sample/map.c"
-    if ((test_maps_helpers[2].tail_call) && (r0 == 0))
-#line 88 "sample/map.c"
-        return 0;
-        // EBPF_OP_MOV64_REG pc=29 dst=r6 src=r0 offset=0 imm=0
+    // EBPF_OP_MOV64_REG pc=29 dst=r6 src=r0 offset=0 imm=0
 #line 88 "sample/map.c"
     r6 = r0;
     // EBPF_OP_LSH64_IMM pc=30 dst=r6 src=r0 offset=0 imm=32
@@ -483,11 +471,7 @@ test_maps(void* context)
     r0 = test_maps_helpers[0].address
 #line 94 "sample/map.c"
          (r1, r2, r3, r4, r5);
-#line 94 "sample/map.c"
-    if ((test_maps_helpers[0].tail_call) && (r0 == 0))
-#line 94 "sample/map.c"
-        return 0;
-        // EBPF_OP_MOV64_REG pc=42 dst=r6 src=r0 offset=0 imm=0
+    // EBPF_OP_MOV64_REG pc=42 dst=r6 src=r0 offset=0 imm=0
 #line 94 "sample/map.c"
     r6 = r0;
     // EBPF_OP_LSH64_IMM pc=43 dst=r6 src=r0 offset=0 imm=32
@@ -523,11 +507,7 @@ label_2:
     r0 = test_maps_helpers[3].address
 #line 105 "sample/map.c"
          (r1, r2, r3, r4, r5);
-#line 105 "sample/map.c"
-    if ((test_maps_helpers[3].tail_call) && (r0 == 0))
-#line 105 "sample/map.c"
-        return 0;
-        // EBPF_OP_LDDW pc=53 dst=r6 src=r0 offset=0 imm=-1
+    // EBPF_OP_LDDW pc=53 dst=r6 src=r0 offset=0 imm=-1
 #line 105 "sample/map.c"
     r6 = (uint64_t)4294967295;
     // EBPF_OP_JEQ_IMM pc=55 dst=r0 src=r0 offset=-10 imm=0
@@ -570,11 +550,7 @@ label_2:
     r0 = test_maps_helpers[0].address
 #line 76 "sample/map.c"
          (r1, r2, r3, r4, r5);
-#line 76 "sample/map.c"
-    if ((test_maps_helpers[0].tail_call) && (r0 == 0))
-#line 76 "sample/map.c"
-        return 0;
-        // EBPF_OP_MOV64_REG pc=68 dst=r6 src=r0 offset=0 imm=0
+    // EBPF_OP_MOV64_REG pc=68 dst=r6 src=r0 offset=0 imm=0
 #line 76 "sample/map.c"
     r6 = r0;
     // EBPF_OP_LSH64_IMM pc=69 dst=r6 src=r0 offset=0 imm=32
@@ -602,11 +578,7 @@ label_2:
     r0 = test_maps_helpers[1].address
 #line 82 "sample/map.c"
          (r1, r2, r3, r4, r5);
-#line 82 "sample/map.c"
-    if ((test_maps_helpers[1].tail_call) && (r0 == 0))
-#line 82 "sample/map.c"
-        return 0;
-        // EBPF_OP_LDDW pc=77 dst=r6 src=r0 offset=0 imm=-1
+    // EBPF_OP_LDDW pc=77 dst=r6 src=r0 offset=0 imm=-1
 #line 82 "sample/map.c"
     r6 = (uint64_t)4294967295;
     // EBPF_OP_JEQ_IMM pc=79 dst=r0 src=r0 offset=22 imm=0
@@ -628,11 +600,7 @@ label_2:
     r0 = test_maps_helpers[2].address
 #line 88 "sample/map.c"
          (r1, r2, r3, r4, r5);
-#line 88 "sample/map.c"
-    if ((test_maps_helpers[2].tail_call) && (r0 == 0))
-#line 88 "sample/map.c"
-        return 0;
-        // EBPF_OP_MOV64_REG pc=85 dst=r6 src=r0 offset=0 imm=0
+    // EBPF_OP_MOV64_REG pc=85 dst=r6 src=r0 offset=0 imm=0
 #line 88 "sample/map.c"
     r6 = r0;
     // EBPF_OP_LSH64_IMM pc=86 dst=r6 src=r0 offset=0 imm=32
@@ -672,11 +640,7 @@ label_2:
     r0 = test_maps_helpers[0].address
 #line 94 "sample/map.c"
          (r1, r2, r3, r4, r5);
-#line 94 "sample/map.c"
-    if ((test_maps_helpers[0].tail_call) && (r0 == 0))
-#line 94 "sample/map.c"
-        return 0;
-        // EBPF_OP_MOV64_REG pc=98 dst=r6 src=r0 offset=0 imm=0
+    // EBPF_OP_MOV64_REG pc=98 dst=r6 src=r0 offset=0 imm=0
 #line 94 "sample/map.c"
     r6 = r0;
     // EBPF_OP_LSH64_IMM pc=99 dst=r6 src=r0 offset=0 imm=32
@@ -709,11 +673,7 @@ label_4:
     r0 = test_maps_helpers[3].address
 #line 105 "sample/map.c"
          (r1, r2, r3, r4, r5);
-#line 105 "sample/map.c"
-    if ((test_maps_helpers[3].tail_call) && (r0 == 0))
-#line 105 "sample/map.c"
-        return 0;
-        // EBPF_OP_LDDW pc=108 dst=r6 src=r0 offset=0 imm=-1
+    // EBPF_OP_LDDW pc=108 dst=r6 src=r0 offset=0 imm=-1
 #line 105 "sample/map.c"
     r6 = (uint64_t)4294967295;
     // EBPF_OP_JEQ_IMM pc=110 dst=r0 src=r0 offset=-65 imm=0
@@ -756,11 +716,7 @@ label_4:
     r0 = test_maps_helpers[0].address
 #line 76 "sample/map.c"
          (r1, r2, r3, r4, r5);
-#line 76 "sample/map.c"
-    if ((test_maps_helpers[0].tail_call) && (r0 == 0))
-#line 76 "sample/map.c"
-        return 0;
-        // EBPF_OP_MOV64_REG pc=123 dst=r6 src=r0 offset=0 imm=0
+    // EBPF_OP_MOV64_REG pc=123 dst=r6 src=r0 offset=0 imm=0
 #line 76 "sample/map.c"
     r6 = r0;
     // EBPF_OP_LSH64_IMM pc=124 dst=r6 src=r0 offset=0 imm=32
@@ -785,14 +741,20 @@ label_4:
     r1 = POINTER(_maps[2].address);
     // EBPF_OP_CALL pc=131 dst=r0 src=r0 offset=0 imm=1
 #line 82 "sample/map.c"
-    r0 = test_maps_helpers[1].address
+    if (_maps[2].array_data != NULL) {
 #line 82 "sample/map.c"
-         (r1, r2, r3, r4, r5);
+        r0 = *(uint32_t*)(uintptr_t)r2;
+#line 82 "sample/map.c"
+        r0 = (r0 < 10) ? POINTER((uint8_t*)_maps[2].array_data + r0 * 4) : 0;
 #line 82 "sample/map.c"
-    if ((test_maps_helpers[1].tail_call) && (r0 == 0))
+    } else {
 #line 82 "sample/map.c"
-        return 0;
-        // EBPF_OP_LDDW pc=132 dst=r6 src=r0 offset=0 imm=-1
+        r0 = test_maps_helpers[1].address
+#line 82 "sample/map.c"
+             (r1, r2, r3, r4, r5);
+#line 82 "sample/map.c"
+    }
+    // EBPF_OP_LDDW pc=132 dst=r6 src=r0 offset=0 imm=-1
 #line 82 "sample/map.c"
     r6 = (uint64_t)4294967295;
     // EBPF_OP_JEQ_IMM pc=134 dst=r0 src=r0 offset=23 imm=0
@@ -814,11 +776,7 @@ label_4:
     r0 = test_maps_helpers[2].address
 #line 88 "sample/map.c"
          (r1, r2, r3, r4, r5);
-#line 88 "sample/map.c"
-    if ((test_maps_helpers[2].tail_call) && (r0 == 0))
-#line 88 "sample/map.c"
-        return 0;
-        // EBPF_OP_MOV64_REG pc=140 dst=r6 src=r0 offset=0 imm=0
+    // EBPF_OP_MOV64_REG pc=140 dst=r6 src=r0 offset=0 imm=0
 #line 88 "sample/map.c"
     r6 = r0;
     // EBPF_OP_LSH64_IMM pc=141 dst=r6 src=r0 offset=0 imm=32
@@ -861,11 +819,7 @@ label_4:
     r0 = test_maps_helpers[0].address
 #line 94 "sample/map.c"
          (r1, r2, r3, r4, r5);
-#line 94 "sample/map.c"
-    if ((test_maps_helpers[0].tail_call) && (r0 == 0))
-#line 94 "sample/map.c"
-        return 0;
-        // EBPF_OP_MOV64_REG pc=154 dst=r6 src=r0 offset=0 imm=0
+    // EBPF_OP_MOV64_REG pc=154 dst=r6 src=r0 offset=0 imm=0
 #line 94 "sample/map.c"
     r6 = r0;
     // EBPF_OP_LSH64_IMM pc=155 dst=r6 src=r0 offset=0 imm=32
@@ -916,11 +870,7 @@ label_6:
     r0 = test_maps_helpers[0].address
 #line 76 "sample/map.c"
          (r1, r2, r3, r4, r5);
-#line 76 "sample/map.c"
-    if ((test_maps_helpers[0].tail_call) && (r0 == 0))
-#line 76 "sample/map.c"
-        return 0;
-        // EBPF_OP_MOV64_REG pc=170 dst=r6 src=r0 offset=0 imm=0
+    // EBPF_OP_MOV64_REG pc=170 dst=r6 src=r0 offset=0 imm=0
 #line 76 "sample/map.c"
     r6 = r0;
     // EBPF_OP_LSH64_IMM pc=171 dst=r6 src=r0 offset=0 imm=32
@@ -948,11 +898,7 @@ label_6:
     r0 = test_maps_helpers[1].address
 #line 82 "sample/map.c"
          (r1, r2, r3, r4, r5);
-#line 82 "sample/map.c"
-    if ((test_maps_helpers[1].tail_call) && (r0 == 0))
-#line 82 "sample/map.c"
-        return 0;
-        // EBPF_OP_LDDW pc=179 dst=r6 src=r0 offset=0 imm=-1
+    // EBPF_OP_LDDW pc=179 dst=r6 src=r0 offset=0 imm=-1
 #line 82 "sample/map.c"
     r6 = (uint64_t)4294967295;
     // EBPF_OP_JEQ_IMM pc=181 dst=r0 src=r0 offset=23 imm=0
@@ -974,11 +920,7 @@ label_6:
     r0 = test_maps_helpers[2].address
 #line 88 "sample/map.c"
          (r1, r2, r3, r4, r5);
-#line 88 "sample/map.c"
-    if ((test_maps_helpers[2].tail_call) && (r0 == 0))
-#line 88 "sample/map.c"
-        return 0;
-        // EBPF_OP_MOV64_REG pc=187 dst=r6 src=r0 offset=0 imm=0
+    // EBPF_OP_MOV64_REG pc=187 dst=r6 src=r0 offset=0 imm=0
 #line 88 "sample/map.c"
     r6 = r0;
     // EBPF_OP_LSH64_IMM pc=188 dst=r6 src=r0 offset=0 imm=32
@@ -1021,11 +963,7 @@ label_6:
     r0 = test_maps_helpers[0].address
 #line 94 "sample/map.c"
          (r1, r2, r3, r4, r5);
-#line 94 "sample/map.c"
-    if ((test_maps_helpers[0].tail_call) && (r0 == 0))
-#line 94 "sample/map.c"
-        return 0;
-        // EBPF_OP_MOV64_REG pc=201 dst=r6 src=r0 offset=0 imm=0
+    // EBPF_OP_MOV64_REG pc=201 dst=r6 src=r0 offset=0 imm=0
 #line 94 "sample/map.c"
     r6 = r0;
     // EBPF_OP_LSH64_IMM pc=202 dst=r6 src=r0 offset=0 imm=32
@@ -1076,11 +1014,7 @@ label_8:
     r0 = test_maps_helpers[0].address
 #line 76 "sample/map.c"
          (r1, r2, r3, r4, r5);
-#line 76 "sample/map.c"
-    if ((test_maps_helpers[0].tail_call) && (r0 == 0))
-#line 76 "sample/map.c"
-        return 0;
-        // EBPF_OP_MOV64_REG pc=217 dst=r6 src=r0 offset=0 imm=0
+    // EBPF_OP_MOV64_REG pc=217 dst=r6 src=r0 offset=0 imm=0
 #line 76 "sample/map.c"
     r6 = r0;
     // EBPF_OP_LSH64_IMM pc=218 dst=r6 src=r0 offset=0 imm=32
@@ -1108,11 +1042,7 @@ label_8:
     r0 = test_maps_helpers[1].address
 #line 82 "sample/map.c"
          (r1, r2, r3, r4, r5);
-#line 82 "sample/map.c"
-    if ((test_maps_helpers[1].tail_call) && (r0 == 0))
-#line 82 "sample/map.c"
-        return 0;
-        // EBPF_OP_LDDW pc=226 dst=r6 src=r0 offset=0 imm=-1
+    // EBPF_OP_LDDW pc=226 dst=r6 src=r0 offset=0 imm=-1
 #line 82 "sample/map.c"
     r6 = (uint64_t)4294967295;
     // EBPF_OP_JEQ_IMM pc=228 dst=r0 src=r0 offset=22 imm=0
@@ -1134,11 +1064,7 @@ label_8:
     r0 = test_maps_helpers[2].address
 #line 88 "sample/map.c"
          (r1, r2, r3, r4, r5);
-#line 88 "sample/map.c"
-    if ((test_maps_helpers[2].tail_call) && (r0 == 0))
-#line 88 "sample/map.c"
-        return 0;
-        // EBPF_OP_MOV64_REG pc=234 dst=r6 src=r0 offset=0 imm=0
+    // EBPF_OP_MOV64_REG pc=234 dst=r6 src=r0 offset=0 imm=0
 #line 88 "sample/map.c"
     r6 = r0;
     // EBPF_OP_LSH64_IMM pc=235 dst=r6 src=r0 offset=0 imm=32
@@ -1178,11 +1104,7 @@ label_8:
     r0 = test_maps_helpers[0].address
 #line 94 "sample/map.c"
          (r1, r2, r3, r4, r5);
-#line 94 "sample/map.c"
-    if ((test_maps_helpers[0].tail_call) && (r0 == 0))
-#line 94 "sample/map.c"
-        return 0;
-        // EBPF_OP_MOV64_REG pc=247 dst=r6 src=r0 offset=0 imm=0
+    // EBPF_OP_MOV64_REG pc=247 dst=r6 src=r0 offset=0 imm=0
 #line 94 "sample/map.c"
     r6 = r0;
     // EBPF_OP_LSH64_IMM pc=248 dst=r6 src=r0 offset=0 imm=32
@@ -1215,11 +1137,7 @@ label_10:
     r0 = test_maps_helpers[3].address
 #line 105 "sample/map.c"
          (r1, r2, r3, r4, r5);
-#line 105 "sample/map.c"
-    if ((test_maps_helpers[3].tail_call) && (r0 == 0))
-#line 105 "sample/map.c"
-        return 0;
-        // EBPF_OP_LDDW pc=257 dst=r6 src=r0 offset=0 imm=-1
+    // EBPF_OP_LDDW pc=257 dst=r6 src=r0 offset=0 imm=-1
 #line 105 "sample/map.c"
     r6 = (uint64_t)4294967295;
     // EBPF_OP_JEQ_IMM pc=259 dst=r0 src=r0 offset=-214 imm=0
@@ -1262,11 +1180,7 @@ label_10:
     r0 = test_maps_helpers[0].address
 #line 76 "sample/map.c"
          (r1, r2, r3, r4, r5);
-#line 76 "sample/map.c"
-    if ((test_maps_helpers[0].tail_call) && (r0 == 0))
-#line 76 "sample/map.c"
-        return 0;
-        // EBPF_OP_MOV64_REG pc=272 dst=r6 src=r0 offset=0 imm=0
+    // EBPF_OP_MOV64_REG pc=272 dst=r6 src=r0 offset=0 imm=0
 #line 76 "sample/map.c"
     r6 = r0;
     // EBPF_OP_LSH64_IMM pc=273 dst=r6 src=r0 offset=0 imm=32
@@ -1294,11 +1208,7 @@ label_10:
     r0 = test_maps_helpers[1].address
 #line 82 "sample/map.c"
          (r1, r2, r3, r4, r5);
-#line 82 "sample/map.c"
-    if ((test_maps_helpers[1].tail_call) && (r0 == 0))
-#line 82 "sample/map.c"
-        return 0;
-        // EBPF_OP_LDDW pc=281 dst=r6 src=r0 offset=0 imm=-1
+    // EBPF_OP_LDDW pc=281 dst=r6 src=r0 offset=0 imm=-1
 #line 82 "sample/map.c"
     r6 = (uint64_t)4294967295;
     // EBPF_OP_JEQ_IMM pc=283 dst=r0 src=r0 offset=22 imm=0
@@ -1320,11 +1230,7 @@ label_10:
     r0 = test_maps_helpers[2].address
 #line 88 "sample/map.c"
          (r1, r2, r3, r4, r5);
-#line 88 "sample/map.c"
-    if ((test_maps_helpers[2].tail_call) && (r0 == 0))
-#line 88 "sample/map.c"
-        return 0;
-        // EBPF_OP_MOV64_REG pc=289 dst=r6 src=r0 offset=0 imm=0
+    // EBPF_OP_MOV64_REG pc=289 dst=r6 src=r0 offset=0 imm=0
 #line 88 "sample/map.c"
     r6 = r0;
     // EBPF_OP_LSH64_IMM pc=290 dst=r6 src=r0 offset=0 imm=32
@@ -1364,11 +1270,7 @@ label_10:
     r0 = test_maps_helpers[0].address
 #line 94 "sample/map.c"
          (r1, r2, r3, r4, r5);
-#line 94 "sample/map.c"
-    if ((test_maps_helpers[0].tail_call) && (r0 == 0))
-#line 94 "sample/map.c"
-        return 0;
-        // EBPF_OP_MOV64_REG pc=302 dst=r6 src=r0 offset=0 imm=0
+    // EBPF_OP_MOV64_REG pc=302 dst=r6 src=r0 offset=0 imm=0
 #line 94 "sample/map.c"
     r6 = r0;
     // EBPF_OP_LSH64_IMM pc=303 dst=r6 src=r0 offset=0 imm=32
@@ -1401,11 +1303,7 @@ label_12:
     r0 = test_maps_helpers[3].address
 #line 105 "sample/map.c"
          (r1, r2, r3, r4, r5);
-#line 105 "sample/map.c"
-    if ((test_maps_helpers[3].tail_call) && (r0 == 0))
-#line 105 "sample/map.c"
-        return 0;
-        // EBPF_OP_LDDW pc=312 dst=r6 src=r0 offset=0 imm=-1
+    // EBPF_OP_LDDW pc=312 dst=r6 src=r0 offset=0 imm=-1
 #line 105 "sample/map.c"
     r6 = (uint64_t)4294967295;
     // EBPF_OP_JEQ_IMM pc=314 dst=r0 src=r0 offset=-269 imm=0
@@ -1494,11 +1392,7 @@ label_14:
     r0 = test_maps_helpers[0].address
 #line 122 "sample/map.c"
          (r1, r2, r3, r4, r5);
-#line 122 "sample/map.c"
-    if ((test_maps_helpers[0].tail_call) && (r0 == 0))
-#line 122 "sample/map.c"
-        return 0;
-        // EBPF_OP_MOV64_REG pc=341 dst=r6 src=r0 offset=0 imm=0
+    // EBPF_OP_MOV64_REG pc=341 dst=r6 src=r0 offset=0 imm=0
 #line 122 "sample/map.c"
     r6 = r0;
     // EBPF_OP_MOV64_REG pc=342 dst=r1 src=r6 offset=0 imm=0
@@ -1559,11 +1453,7 @@ label_15:
     r0 = test_maps_helpers[4].address
 #line 173 "sample/map.c"
          (r1, r2, r3, r4, r5);
-#line 173 "sample/map.c"
-    if ((test_maps_helpers[4].tail_call) && (r0 == 0))
-#line 173 "sample/map.c"
-        return 0;
-        // EBPF_OP_MOV64_REG pc=360 dst=r1 src=r0 offset=0 imm=0
+    // EBPF_OP_MOV64_REG pc=360 dst=r1 src=r0 offset=0 imm=0
 #line 173 "sample/map.c"
     r1 = r0;
     // EBPF_OP_LSH64_IMM pc=361 dst=r1 src=r0 offset=0 imm=32
@@ -1613,11 +1503,7 @@ label_16:
     r0 = test_maps_helpers[0].address
 #line 122 "sample/map.c"
          (r1, r2, r3, r4, r5);
-#line 122 "sample/map.c"
-    if ((test_maps_helpers[0].tail_call) && (r0 == 0))
-#line 122 "sample/map.c"
-        return 0;
-        // EBPF_OP_MOV64_REG pc=377 dst=r6 src=r0 offset=0 imm=0
+    // EBPF_OP_MOV64_REG pc=377 dst=r6 src=r0 offset=0 imm=0
 #line 122 "sample/map.c"
     r6 = r0;
     // EBPF_OP_MOV64_REG pc=378 dst=r1 src=r6 offset=0 imm=0
@@ -1671,11 +1557,7 @@ label_17:
     r0 = test_maps_helpers[5].address
 #line 174 "sample/map.c"
          (r1, r2, r3, r4, r5);
-#line 174 "sample/map.c"
-    if ((test_maps_helpers[5].tail_call) && (r0 == 0))
-#line 174 "sample/map.c"
-        return 0;
-        // EBPF_OP_LDXW pc=393 dst=r1 src=r10 offset=-4 imm=0
+    // EBPF_OP_LDXW pc=393 dst=r1 src=r10 offset=-4 imm=0
 #line 174 "sample/map.c"
     r1 = *(uint32_t*)(uintptr_t)(r10 + OFFSET(-4));
     // EBPF_OP_MOV64_REG pc=394 dst=r7 src=r6 offset=0 imm=0
@@ -1750,11 +1632,7 @@ label_19:
     r0 = test_maps_helpers[6].address
 #line 177 "sample/map.c"
          (r1, r2, r3, r4, r5);
-#line 177 "sample/map.c"
-    if ((test_maps_helpers[6].tail_call) && (r0 == 0))
-#line 177 "sample/map.c"
-        return 0;
-        // EBPF_OP_MOV64_REG pc=416 dst=r6 src=r0 offset=0 imm=0
+    // EBPF_OP_MOV64_REG pc=416 dst=r6 src=r0 offset=0 imm=0
 #line 177 "sample/map.c"
     r6 = r0;
     // EBPF_OP_MOV64_REG pc=417 dst=r1 src=r6 offset=0 imm=0
@@ -1794,11 +1672,7 @@ label_19:
     r0 = test_maps_helpers[6].address
 #line 177 "sample/map.c"
          (r1, r2, r3, r4, r5);
-#line 177 "sample/map.c"
-    if ((test_maps_helpers[6].tail_call) && (r0 == 0))
-#line 177 "sample/map.c"
-        return 0;
-        // EBPF_OP_MOV64_REG pc=429 dst=r6 src=r0 offset=0 imm=0
+    // EBPF_OP_MOV64_REG pc=429 dst=r6 src=r0 offset=0 imm=0
 #line 177 "sample/map.c"
     r6 = r0;
     // EBPF_OP_MOV64_REG pc=430 dst=r1 src=r6 offset=0 imm=0
@@ -1842,11 +1716,7 @@ label_20:
     r0 = test_maps_helpers[6].address
 #line 177 "sample/map.c"
          (r1, r2, r3, r4, r5);
-#line 177 "sample/map.c"
-    if ((test_maps_helpers[6].tail_call) && (r0 == 0))
-#line 177 "sample/map.c"
-        return 0;
-        // EBPF_OP_MOV64_REG pc=443 dst=r6 src=r0 offset=0 imm=0
+    // EBPF_OP_MOV64_REG pc=443 dst=r6 src=r0 offset=0 imm=0
 #line 177 "sample/map.c"
     r6 = r0;
     // EBPF_OP_MOV64_REG pc=444 dst=r1 src=r6 offset=0 imm=0
@@ -1886,11 +1756,7 @@ label_20:
     r0 = test_maps_helpers[6].address
 #line 177 "sample/map.c"
          (r1, r2, r3, r4, r5);
-#line 177 "sample/map.c"
-    if ((test_maps_helpers[6].tail_call) && (r0 == 0))
-#line 177 "sample/map.c"
-        return 0;
-        // EBPF_OP_MOV64_REG pc=456 dst=r6 src=r0 offset=0 imm=0
+    // EBPF_OP_MOV64_REG pc=456 dst=r6 src=r0 offset=0 imm=0
 #line 177 "sample/map.c"
     r6 = r0;
     // EBPF_OP_MOV64_REG pc=457 dst=r1 src=r6 offset=0 imm=0
@@ -1930,11 +1796,7 @@ label_20:
     r0 = test_maps_helpers[6].address
 #line 177 "sample/map.c"
          (r1, r2, r3, r4, r5);
-#line 177 "sample/map.c"
-    if ((test_maps_helpers[6].tail_call) && (r0 == 0))
-#line 177 "sample/map.c"
-        return 0;
-        // EBPF_OP_MOV64_REG pc=469 dst=r6 src=r0 offset=0 imm=0
+    // EBPF_OP_MOV64_REG pc=469 dst=r6 src=r0 offset=0 imm=0
 #line 177 "sample/map.c"
     r6 = r0;
     // EBPF_OP_MOV64_REG pc=470 dst=r1 src=r6 offset=0 imm=0
@@ -1974,11 +1836,7 @@ label_20:
     r0 = test_maps_helpers[6].address
 #line 177 "sample/map.c"
          (r1, r2, r3, r4, r5);
-#line 177 "sample/map.c"
-    if ((test_maps_helpers[6].tail_call) && (r0 == 0))
-#line 177 "sample/map.c"
-        return 0;
-        // EBPF_OP_MOV64_REG pc=482 dst=r6 src=r0 offset=0 imm=0
+    // EBPF_OP_MOV64_REG pc=482 dst=r6 src=r0 offset=0 imm=0
 #line 177 "sample/map.c"
     r6 = r0;
     // EBPF_OP_MOV64_REG pc=483 dst=r1 src=r6 offset=0 imm=0
@@ -2018,11 +1876,7 @@ label_20:
     r0 = test_maps_helpers[6].address
 #line 177 "sample/map.c"
          (r1, r2, r3, r4, r5);
-#line 177 "sample/map.c"
-    if ((test_maps_helpers[6].tail_call) && (r0 == 0))
-#line 177 "sample/map.c"
-        return 0;
-        // EBPF_OP_MOV64_REG pc=495 dst=r6 src=r0 offset=0 imm=0
+    // EBPF_OP_MOV64_REG pc=495 dst=r6 src=r0 offset=0 imm=0
 #line 177 "sample/map.c"
     r6 = r0;
     // EBPF_OP_MOV64_REG pc=496 dst=r1 src=r6 offset=0 imm=0
@@ -2062,11 +1916,7 @@ label_20:
     r0 = test_maps_helpers[6].address
 #line 177 "sample/map.c"
          (r1, r2, r3, r4, r5);
-#line 177 "sample/map.c"
-    if ((test_maps_helpers[6].tail_call) && (r0 == 0))
-#line 177 "sample/map.c"
-        return 0;
-        // EBPF_OP_MOV64_REG pc=508 dst=r6 src=r0 offset=0 imm=0
+    // EBPF_OP_MOV64_REG pc=508 dst=r6 src=r0 offset=0 imm=0
 #line 177 "sample/map.c"
     r6 = r0;
     // EBPF_OP_MOV64_REG pc=509 dst=r1 src=r6 offset=0 imm=0
@@ -2106,11 +1956,7 @@ label_20:
     r0 = test_maps_helpers[6].address
 #line 177 "sample/map.c"
          (r1, r2, r3, r4, r5);
-#line 177 "sample/map.c"
-    if ((test_maps_helpers[6].tail_call) && (r0 == 0))
-#line 177 "sample/map.c"
-        return 0;
-        // EBPF_OP_MOV64_REG pc=521 dst=r6 src=r0 offset=0 imm=0
+    // EBPF_OP_MOV64_REG pc=521 dst=r6 src=r0 offset=0 imm=0
 #line 177 "sample/map.c"
     r6 = r0;
     // EBPF_OP_MOV64_REG pc=522 dst=r1 src=r6 offset=0 imm=0
@@ -2150,11 +1996,7 @@ label_20:
     r0 = test_maps_helpers[6].address
 #line 177 "sample/map.c"
          (r1, r2, r3, r4, r5);
-#line 177 "sample/map.c"
-    if ((test_maps_helpers[6].tail_call) && (r0 == 0))
-#line 177 "sample/map.c"
-        return 0;
-        // EBPF_OP_MOV64_REG pc=534 dst=r6 src=r0 offset=0 imm=0
+    // EBPF_OP_MOV64_REG pc=534 dst=r6 src=r0 offset=0 imm=0
 #line 177 "sample/map.c"
     r6 = r0;
     // EBPF_OP_MOV64_REG pc=535 dst=r1 src=r6 offset=0 imm=0
@@ -2194,11 +2036,7 @@ label_20:
     r0 = test_maps_helpers[6].address
 #line 180 "sample/map.c"
          (r1, r2, r3, r4, r5);
-#line 180 "sample/map.c"
-    if ((test_maps_helpers[6].tail_call) && (r0 == 0))
-#line 180 "sample/map.c"
-        return 0;
-        // EBPF_OP_MOV64_REG pc=547 dst=r6 src=r0 offset=0 imm=0
+    // EBPF_OP_MOV64_REG pc=547 dst=r6 src=r0 offset=0 imm=0
 #line 180 "sample/map.c"
     r6 = r0;
     // EBPF_OP_MOV64_REG pc=548 dst=r1 src=r6 offset=0 imm=0
@@ -2257,11 +2095,7 @@ label_22:
     r0 = test_maps_helpers[4].address
 #line 173 "sample/map.c"
          (r1, r2, r3, r4, r5);
-#line 173 "sample/map.c"
-    if ((test_maps_helpers[4].tail_call) && (r0 == 0))
-#line 173 "sample/map.c"
-        return 0;
-        // EBPF_OP_MOV64_REG pc=566 dst=r1 src=r0 offset=0 imm=0
+    // EBPF_OP_MOV64_REG pc=566 dst=r1 src=r0 offset=0 imm=0
 #line 173 "sample/map.c"
     r1 = r0;
     // EBPF_OP_LSH64_IMM pc=567 dst=r1 src=r0 offset=0 imm=32
@@ -2318,11 +2152,7 @@ label_23:
     r0 = test_maps_helpers[5].address
 #line 174 "sample/map.c"
          (r1, r2, r3, r4, r5);
-#line 174 "sample/map.c"
-    if ((test_maps_helpers[5].tail_call) && (r0 == 0))
-#line 174 "sample/map.c"
-        return 0;
-        // EBPF_OP_LDXW pc=584 dst=r1 src=r10 offset=-4 imm=0
+    // EBPF_OP_LDXW pc=584 dst=r1 src=r10 offset=-4 imm=0
 #line 174 "sample/map.c"
     r1 = *(uint32_t*)(uintptr_t)(r10 + OFFSET(-4));
     // EBPF_OP_MOV64_REG pc=585 dst=r6 src=r7 offset=0 imm=0
@@ -2397,11 +2227,7 @@ label_25:
     r0 = test_maps_helpers[6].address
 #line 177 "sample/map.c"
          (r1, r2, r3, r4, r5);
-#line 177 "sample/map.c"
-    if ((test_maps_helpers[6].tail_call) && (r0 == 0))
-#line 177 "sample/map.c"
-        return 0;
-        // EBPF_OP_MOV64_REG pc=607 dst=r7 src=r0 offset=0 imm=0
+    // EBPF_OP_MOV64_REG pc=607 dst=r7 src=r0 offset=0 imm=0
 #line 177 "sample/map.c"
     r7 = r0;
     // EBPF_OP_MOV64_REG pc=608 dst=r1 src=r7 offset=0 imm=0
@@ -2441,11 +2267,7 @@ label_25:
     r0 = test_maps_helpers[6].address
 #line 177 "sample/map.c"
          (r1, r2, r3, r4, r5);
-#line 177 "sample/map.c"
-    if ((test_maps_helpers[6].tail_call) && (r0 == 0))
-#line 177 "sample/map.c"
-        return 0;
-        // EBPF_OP_MOV64_REG pc=620 dst=r7 src=r0 offset=0 imm=0
+    // EBPF_OP_MOV64_REG pc=620 dst=r7 src=r0 offset=0 imm=0
 #line 177 "sample/map.c"
     r7 = r0;
     // EBPF_OP_MOV64_REG pc=621 dst=r1 src=r7 offset=0 imm=0
@@ -2489,11 +2311,7 @@ label_26:
     r0 = test_maps_helpers[6].address
 #line 177 "sample/map.c"
          (r1, r2, r3, r4, r5);
-#line 177 "sample/map.c"
-    if ((test_maps_helpers[6].tail_call) && (r0 == 0))
-#line 177 "sample/map.c"
-        return 0;
-        // EBPF_OP_MOV64_REG pc=634 dst=r7 src=r0 offset=0 imm=0
+    // EBPF_OP_MOV64_REG pc=634 dst=r7 src=r0 offset=0 imm=0
 #line 177 "sample/map.c"
     r7 = r0;
     // EBPF_OP_MOV64_REG pc=635 dst=r1 src=r7 offset=0 imm=0
@@ -2533,11 +2351,7 @@ label_26:
     r0 = test_maps_helpers[6].address
 #line 177 "sample/map.c"
          (r1, r2, r3, r4, r5);
-#line 177 "sample/map.c"
-    if ((test_maps_helpers[6].tail_call) && (r0 == 0))
-#line 177 "sample/map.c"
-        return 0;
-        // EBPF_OP_MOV64_REG pc=647 dst=r7 src=r0 offset=0 imm=0
+    // EBPF_OP_MOV64_REG pc=647 dst=r7 src=r0 offset=0 imm=0
 #line 177 "sample/map.c"
     r7 = r0;
     // EBPF_OP_MOV64_REG pc=648 dst=r1 src=r7 offset=0 imm=0
@@ -2577,11 +2391,7 @@ label_26:
     r0 = test_maps_helpers[6].address
 #line 177 "sample/map.c"
          (r1, r2, r3, r4, r5);
-#line 177 "sample/map.c"
-    if ((test_maps_helpers[6].tail_call) && (r0 == 0))
-#line 177 "sample/map.c"
-        return 0;
-        // EBPF_OP_MOV64_REG pc=660 dst=r7 src=r0 offset=0 imm=0
+    // EBPF_OP_MOV64_REG pc=660 dst=r7 src=r0 offset=0 imm=0
 #line 177 "sample/map.c"
     r7 = r0;
     // EBPF_OP_MOV64_REG pc=661 dst=r1 src=r7 offset=0 imm=0
@@ -2621,11 +2431,7 @@ label_26:
     r0 = test_maps_helpers[6].address
 #line 177 "sample/map.c"
          (r1, r2, r3, r4, r5);
-#line 177 "sample/map.c"
-    if ((test_maps_helpers[6].tail_call) && (r0 == 0))
-#line 177 "sample/map.c"
-        return 0;
-        // EBPF_OP_MOV64_REG pc=673 dst=r7 src=r0 offset=0 imm=0
+    // EBPF_OP_MOV64_REG pc=673 dst=r7 src=r0 offset=0 imm=0
 #line 177 "sample/map.c"
     r7 = r0;
     // EBPF_OP_MOV64_REG pc=674 dst=r1 src=r7 offset=0 imm=0
@@ -2665,11 +2471,7 @@ label_26:
     r0 = test_maps_helpers[6].address
 #line 177 "sample/map.c"
          (r1, r2, r3, r4, r5);
-#line 177 "sample/map.c"
-    if ((test_maps_helpers[6].tail_call) && (r0 == 0))
-#line 177 "sample/map.c"
-        return 0;
-        // EBPF_OP_MOV64_REG pc=686 dst=r7 src=r0 offset=0 imm=0
+    // EBPF_OP_MOV64_REG pc=686 dst=r7 src=r0 offset=0 imm=0
 #line 177 "sample/map.c"
     r7 = r0;
     // EBPF_OP_MOV64_REG pc=687 dst=r1 src=r7 offset=0 imm=0
@@ -2709,11 +2511,7 @@ label_26:
     r0 = test_maps_helpers[6].address
 #line 177 "sample/map.c"
          (r1, r2, r3, r4, r5);
-#line 177 "sample/map.c"
-    if ((test_maps_helpers[6].tail_call) && (r0 == 0))
-#line 177 "sample/map.c"
-        return 0;
-        // EBPF_OP_MOV64_REG pc=699 dst=r7 src=r0 offset=0 imm=0
+    // EBPF_OP_MOV64_REG pc=699 dst=r7 src=r0 offset=0 imm=0
 #line 177 "sample/map.c"
     r7 = r0;
     // EBPF_OP_MOV64_REG pc=700 dst=r1 src=r7 offset=0 imm=0
@@ -2753,11 +2551,7 @@ label_26:
     r0 = test_maps_helpers[6].address
 #line 177 "sample/map.c"
          (r1, r2, r3, r4, r5);
-#line 177 "sample/map.c"
-    if ((test_maps_helpers[6].tail_call) && (r0 == 0))
-#line 177 "sample/map.c"
-        return 0;
-        // EBPF_OP_MOV64_REG pc=712 dst=r7 src=r0 offset=0 imm=0
+    // EBPF_OP_MOV64_REG pc=712 dst=r7 src=r0 offset=0 imm=0
 #line 177 "sample/map.c"
     r7 = r0;
     // EBPF_OP_MOV64_REG pc=713 dst=r1 src=r7 offset=0 imm=0
@@ -2797,11 +2591,7 @@ label_26:
     r0 = test_maps_helpers[6].address
 #line 177 "sample/map.c"
          (r1, r2, r3, r4, r5);
-#line 177 "sample/map.c"
-    if ((test_maps_helpers[6].tail_call) && (r0 == 0))
-#line 177 "sample/map.c"
-        return 0;
-        // EBPF_OP_MOV64_REG pc=725 dst=r7 src=r0 offset=0 imm=0
+    // EBPF_OP_MOV64_REG pc=725 dst=r7 src=r0 offset=0 imm=0
 #line 177 "sample/map.c"
     r7 = r0;
     // EBPF_OP_MOV64_REG pc=726 dst=r1 src=r7 offset=0 imm=0
@@ -2841,11 +2631,7 @@ label_26:
     r0 = test_maps_helpers[6].address
 #line 180 "sample/map.c"
          (r1, r2, r3, r4, r5);
-#line 180 "sample/map.c"
-    if ((test_maps_helpers[6].tail_call) && (r0 == 0))
-#line 180 "sample/map.c"
-        return 0;
-        // EBPF_OP_MOV64_REG pc=738 dst=r7 src=r0 offset=0 imm=0
+    // EBPF_OP_MOV64_REG pc=738 dst=r7 src=r0 offset=0 imm=0
 #line 180 "sample/map.c"
     r7 = r0;
     // EBPF_OP_MOV64_REG pc=739 dst=r1 src=r7 offset=0 imm=0
@@ -2911,11 +2697,7 @@ label_29:
     r0 = test_maps_helpers[6].address
 #line 181 "sample/map.c"
          (r1, r2, r3, r4, r5);
-#line 181 "sample/map.c"
-    if ((test_maps_helpers[6].tail_call) && (r0 == 0))
-#line 181 "sample/map.c"
-        return 0;
-        // EBPF_OP_MOV64_REG pc=759 dst=r6 src=r0 offset=0 imm=0
+    // EBPF_OP_MOV64_REG pc=759 dst=r6 src=r0 offset=0 imm=0
 #line 181 "sample/map.c"
     r6 = r0;
     // EBPF_OP_MOV64_REG pc=760 dst=r1 src=r6 offset=0 imm=0
@@ -2961,11 +2743,7 @@ label_30:
     r0 = test_maps_helpers[4].address
 #line 183 "sample/map.c"
          (r1, r2, r3, r4, r5);
-#line 183 "sample/map.c"
-    if ((test_maps_helpers[4].tail_call) && (r0 == 0))
-#line 183 "sample/map.c"
-        return 0;
-        // EBPF_OP_MOV64_REG pc=773 dst=r6 src=r0 offset=0 imm=0
+    // EBPF_OP_MOV64_REG pc=773 dst=r6 src=r0 offset=0 imm=0
 #line 183 "sample/map.c"
     r6 = r0;
     // EBPF_OP_MOV64_REG pc=774 dst=r1 src=r6 offset=0 imm=0
@@ -3006,11 +2784,7 @@ label_31:
     r0 = test_maps_helpers[6].address
 #line 181 "sample/map.c"
          (r1, r2, r3, r4, r5);
-#line 181 "sample/map.c"
-    if ((test_maps_helpers[6].tail_call) && (r0 == 0))
-#line 181 "sample/map.c"
-        return 0;
-        // EBPF_OP_MOV64_REG pc=786 dst=r7 src=r0 offset=0 imm=0
+    // EBPF_OP_MOV64_REG pc=786 dst=r7 src=r0 offset=0 imm=0
 #line 181 "sample/map.c"
     r7 = r0;
     // EBPF_OP_MOV64_REG pc=787 dst=r1 src=r7 offset=0 imm=0
@@ -3056,11 +2830,7 @@ label_32:
     r0 = test_maps_helpers[4].address
 #line 183 "sample/map.c"
          (r1, r2, r3, r4, r5);
-#line 183 "sample/map.c"
-    if ((test_maps_helpers[4].tail_call) && (r0 == 0))
-#line 183 "sample/map.c"
-        return 0;
-        // EBPF_OP_MOV64_REG pc=800 dst=r7 src=r0 offset=0 imm=0
+    // EBPF_OP_MOV64_REG pc=800 dst=r7 src=r0 offset=0 imm=0
 #line 183 "sample/map.c"
     r7 = r0;
     // EBPF_OP_MOV64_REG pc=801 dst=r1 src=r7 offset=0 imm=0
@@ -3112,11 +2882,7 @@ label_33:
     r0 = test_maps_helpers[5].address
 #line 186 "sample/map.c"
          (r1, r2, r3, r4, r5);
-#line 186 "sample/map.c"
-    if ((test_maps_helpers[5].tail_call) && (r0 == 0))
-#line 186 "sample/map.c"
-        return 0;
-        // EBPF_OP_MOV64_REG pc=817 dst=r6 src=r0 offset=0 imm=0
+    // EBPF_OP_MOV64_REG pc=817 dst=r6 src=r0 offset=0 imm=0
 #line 186 "sample/map.c"
     r6 = r0;
     // EBPF_OP_MOV64_REG pc=818 dst=r1 src=r6 offset=0 imm=0
@@ -3172,11 +2938,7 @@ label_35:
     r0 = test_maps_helpers[5].address
 #line 186 "sample/map.c"
          (r1, r2, r3, r4, r5);
-#line 186 "sample/map.c"
-    if ((test_maps_helpers[5].tail_call) && (r0 == 0))
-#line 186 "sample/map.c"
-        return 0;
-        // EBPF_OP_MOV64_REG pc=835 dst=r6 src=r0 offset=0 imm=0
+    // EBPF_OP_MOV64_REG pc=835 dst=r6 src=r0 offset=0 imm=0
 #line 186 "sample/map.c"
     r6 = r0;
     // EBPF_OP_MOV64_REG pc=836 dst=r1 src=r6 offset=0 imm=0
@@ -3229,11 +2991,7 @@ label_37:
     r0 = test_maps_helpers[5].address
 #line 186 "sample/map.c"
          (r1, r2, r3, r4, r5);
-#line 186 "sample/map.c"
-    if ((test_maps_helpers[5].tail_call) && (r0 == 0))
-#line 186 "sample/map.c"
-        return 0;
-        // EBPF_OP_MOV64_REG pc=852 dst=r7 src=r0 offset=0 imm=0
+    // EBPF_OP_MOV64_REG pc=852 dst=r7 src=r0 offset=0 imm=0
 #line 186 "sample/map.c"
     r7 = r0;
     // EBPF_OP_MOV64_REG pc=853 dst=r1 src=r7 offset=0 imm=0
@@ -3289,11 +3047,7 @@ label_39:
     r0 = test_maps_helpers[5].address
 #line 186 "sample/map.c"
          (r1, r2, r3, r4, r5);
-#line 186 "sample/map.c"
-    if ((test_maps_helpers[5].tail_call) && (r0 == 0))
-#line 186 "sample/map.c"
-        return 0;
-        // EBPF_OP_MOV64_REG pc=870 dst=r7 src=r0 offset=0 imm=0
+    // EBPF_OP_MOV64_REG pc=870 dst=r7 src=r0 offset=0 imm=0
 #line 186 "sample/map.c"
     r7 = r0;
     // EBPF_OP_MOV64_REG pc=871 dst=r1 src=r7 offset=0 imm=0
@@ -3346,11 +3100,7 @@ label_41:
     r0 = test_maps_helpers[5].address
 #line 186 "sample/map.c"
          (r1, r2, r3, r4, r5);
-#line 186 "sample/map.c"
-    if ((test_maps_helpers[5].tail_call) && (r0 == 0))
-#line 186 "sample/map.c"
-        return 0;
-        // EBPF_OP_MOV64_REG pc=887 dst=r6 src=r0 offset=0 imm=0
+    // EBPF_OP_MOV64_REG pc=887 dst=r6 src=r0 offset=0 imm=0
 #line 186 "sample/map.c"
     r6 = r0;
     // EBPF_OP_MOV64_REG pc=888 dst=r1 src=r6 offset=0 imm=0
@@ -3398,11 +3148,7 @@ label_41:
     r0 = test_maps_helpers[5].address
 #line 186 "sample/map.c"
          (r1, r2, r3, r4, r5);
-#line 186 "sample/map.c"
-    if ((test_maps_helpers[5].tail_call) && (r0 == 0))
-#line 186 "sample/map.c"
-        return 0;
-        // EBPF_OP_MOV64_REG pc=903 dst=r6 src=r0 offset=0 imm=0
+    // EBPF_OP_MOV64_REG pc=903 dst=r6 src=r0 offset=0 imm=0
 #line 186 "sample/map.c"
     r6 = r0;
     // EBPF_OP_MOV64_REG pc=904 dst=r1 src=r6 offset=0 imm=0
@@ -3450,11 +3196,7 @@ label_41:
     r0 = test_maps_helpers[5].address
 #line 186 "sample/map.c"
          (r1, r2, r3, r4, r5);
-#line 186 "sample/map.c"
-    if ((test_maps_helpers[5].tail_call) && (r0 == 0))
-#line 186 "sample/map.c"
-        return 0;
-        // EBPF_OP_MOV64_REG pc=919 dst=r6 src=r0 offset=0 imm=0
+    // EBPF_OP_MOV64_REG pc=919 dst=r6 src=r0 offset=0 imm=0
 #line 186 "sample/map.c"
     r6 = r0;
     // EBPF_OP_MOV64_REG pc=920 dst=r1 src=r6 offset=0 imm=0
@@ -3502,11 +3244,7 @@ label_41:
     r0 = test_maps_helpers[5].address
 #line 186 "sample/map.c"
          (r1, r2, r3, r4, r5);
-#line 186 "sample/map.c"
-    if ((test_maps_helpers[5].tail_call) && (r0 == 0))
-#line 186 "sample/map.c"
-        return 0;
-        // EBPF_OP_MOV64_REG pc=935 dst=r6 src=r0 offset=0 imm=0
+    // EBPF_OP_MOV64_REG pc=935 dst=r6 src=r0 offset=0 imm=0
 #line 186 "sample/map.c"
     r6 = r0;
     // EBPF_OP_MOV64_REG pc=936 dst=r1 src=r6 offset=0 imm=0
@@ -3554,11 +3292,7 @@ label_41:
     r0 = test_maps_helpers[5].address
 #line 186 "sample/map.c"
          (r1, r2, r3, r4, r5);
-#line 186 "sample/map.c"
-    if ((test_maps_helpers[5].tail_call) && (r0 == 0))
-#line 186 "sample/map.c"
-        return 0;
-        // EBPF_OP_MOV64_REG pc=951 dst=r6 src=r0 offset=0 imm=0
+    // EBPF_OP_MOV64_REG pc=951 dst=r6 src=r0 offset=0 imm=0
 #line 186 "sample/map.c"
     r6 = r0;
     // EBPF_OP_MOV64_REG pc=952 dst=r1 src=r6 offset=0 imm=0
@@ -3606,11 +3340,7 @@ label_41:
     r0 = test_maps_helpers[5].address
 #line 186 "sample/map.c"
          (r1, r2, r3, r4, r5);
-#line 186 "sample/map.c"
-    if ((test_maps_helpers[5].tail_call) && (r0 == 0))
-#line 186 "sample/map.c"
-        return 0;
-        // EBPF_OP_MOV64_REG pc=967 dst=r6 src=r0 offset=0 imm=0
+    // EBPF_OP_MOV64_REG pc=967 dst=r6 src=r0 offset=0 imm=0
 #line 186 "sample/map.c"
     r6 = r0;
     // EBPF_OP_MOV64_REG pc=968 dst=r1 src=r6 offset=0 imm=0
@@ -3658,11 +3388,7 @@ label_41:
     r0 = test_maps_helpers[5].address
 #line 186 "sample/map.c"
          (r1, r2, r3, r4, r5);
-#line 186 "sample/map.c"
-    if ((test_maps_helpers[5].tail_call) && (r0 == 0))
-#line 186 "sample/map.c"
-        return 0;
-        // EBPF_OP_MOV64_REG pc=983 dst=r6 src=r0 offset=0 imm=0
+    // EBPF_OP_MOV64_REG pc=983 dst=r6 src=r0 offset=0 imm=0
 #line 186 "sample/map.c"
     r6 = r0;
     // EBPF_OP_MOV64_REG pc=984 dst=r1 src=r6 offset=0 imm=0
@@ -3710,11 +3436,7 @@ label_41:
     r0 = test_maps_helpers[5].address
 #line 186 "sample/map.c"
          (r1, r2, r3, r4, r5);
-#line 186 "sample/map.c"
-    if ((test_maps_helpers[5].tail_call) && (r0 == 0))
-#line 186 "sample/map.c"
-        return 0;
-        // EBPF_OP_MOV64_REG pc=999 dst=r6 src=r0 offset=0 imm=0
+    // EBPF_OP_MOV64_REG pc=999 dst=r6 src=r0 offset=0 imm=0
 #line 186 "sample/map.c"
     r6 = r0;
     // EBPF_OP_MOV64_REG pc=1000 dst=r1 src=r6 offset=0 imm=0
@@ -3762,11 +3484,7 @@ label_41:
     r0 = test_maps_helpers[4].address
 #line 189 "sample/map.c"
          (r1, r2, r3, r4, r5);
-#line 189 "sample/map.c"
-    if ((test_maps_helpers[4].tail_call) && (r0 == 0))
-#line 189 "sample/map.c"
-        return 0;
-        // EBPF_OP_LDXW pc=1015 dst=r1 src=r10 offset=-4 imm=0
+    // EBPF_OP_LDXW pc=1015 dst=r1 src=r10 offset=-4 imm=0
 #line 189 "sample/map.c"
     r1 = *(uint32_t*)(uintptr_t)(r10 + OFFSET(-4));
     // EBPF_OP_MOV64_REG pc=1016 dst=r6 src=r7 offset=0 imm=0
@@ -3836,11 +3554,7 @@ label_44:
     r0 = test_maps_helpers[5].address
 #line 190 "sample/map.c"
          (r1, r2, r3, r4, r5);
-#line 190 "sample/map.c"
-    if ((test_maps_helpers[5].tail_call) && (r0 == 0))
-#line 190 "sample/map.c"
-        return 0;
-        // EBPF_OP_LDXW pc=1036 dst=r1 src=r10 offset=-4 imm=0
+    // EBPF_OP_LDXW pc=1036 dst=r1 src=r10 offset=-4 imm=0
 #line 190 "sample/map.c"
     r1 = *(uint32_t*)(uintptr_t)(r10 + OFFSET(-4));
     // EBPF_OP_JEQ_IMM pc=1037 dst=r1 src=r0 offset=1 imm=0
@@ -3918,11 +3632,7 @@ label_47:
     r0 = test_maps_helpers[5].address
 #line 186 "sample/map.c"
          (r1, r2, r3, r4, r5);
-#line 186 "sample/map.c"
-    if ((test_maps_helpers[5].tail_call) && (r0 == 0))
-#line 186 "sample/map.c"
-        return 0;
-        // EBPF_OP_MOV64_REG pc=1060 dst=r7 src=r0 offset=0 imm=0
+    // EBPF_OP_MOV64_REG pc=1060 dst=r7 src=r0 offset=0 imm=0
 #line 186 "sample/map.c"
     r7 = r0;
     // EBPF_OP_MOV64_REG pc=1061 dst=r1 src=r7 offset=0 imm=0
@@ -3970,11 +3680,7 @@ label_47:
     r0 = test_maps_helpers[5].address
 #line 186 "sample/map.c"
          (r1, r2, r3, r4, r5);
-#line 186 "sample/map.c"
-    if ((test_maps_helpers[5].tail_call) && (r0 == 0))
-#line 186 "sample/map.c"
-        return 0;
-        // EBPF_OP_MOV64_REG pc=1076 dst=r7 src=r0 offset=0 imm=0
+    // EBPF_OP_MOV64_REG pc=1076 dst=r7 src=r0 offset=0 imm=0
 #line 186 "sample/map.c"
     r7 = r0;
     // EBPF_OP_MOV64_REG pc=1077 dst=r1 src=r7 offset=0 imm=0
@@ -4022,11 +3728,7 @@ label_47:
     r0 = test_maps_helpers[5].address
 #line 186 "sample/map.c"
          (r1, r2, r3, r4, r5);
-#line 186 "sample/map.c"
-    if ((test_maps_helpers[5].tail_call) && (r0 == 0))
-#line 186 "sample/map.c"
-        return 0;
-        // EBPF_OP_MOV64_REG pc=1092 dst=r7 src=r0 offset=0 imm=0
+    // EBPF_OP_MOV64_REG pc=1092 dst=r7 src=r0 offset=0 imm=0
 #line 186 "sample/map.c"
     r7 = r0;
     // EBPF_OP_MOV64_REG pc=1093 dst=r1 src=r7 offset=0 imm=0
@@ -4074,11 +3776,7 @@ label_47:
     r0 = test_maps_helpers[5].address
 #line 186 "sample/map.c"
          (r1, r2, r3, r4, r5);
-#line 186 "sample/map.c"
-    if ((test_maps_helpers[5].tail_call) && (r0 == 0))
-#line 186 "sample/map.c"
-        return 0;
-        // EBPF_OP_MOV64_REG pc=1108 dst=r7 src=r0 offset=0 imm=0
+    // EBPF_OP_MOV64_REG pc=1108 dst=r7 src=r0 offset=0 imm=0
 #line 186 "sample/map.c"
     r7 = r0;
     // EBPF_OP_MOV64_REG pc=1109 dst=r1 src=r7 offset=0 imm=0
@@ -4126,11 +3824,7 @@ label_47:
     r0 = test_maps_helpers[5].address
 #line 186 "sample/map.c"
          (r1, r2, r3, r4, r5);
-#line 186 "sample/map.c"
-    if ((test_maps_helpers[5].tail_call) && (r0 == 0))
-#line 186 "sample/map.c"
-        return 0;
-        // EBPF_OP_MOV64_REG pc=1124 dst=r7 src=r0 offset=0 imm=0
+    // EBPF_OP_MOV64_REG pc=1124 dst=r7 src=r0 offset=0 imm=0
 #line 186 "sample/map.c"
     r7 = r0;
     // EBPF_OP_MOV64_REG pc=1125 dst=r1 src=r7 offset=0 imm=0
@@ -4178,11 +3872,7 @@ label_47:
     r0 = test_maps_helpers[5].address
 #line 186 "sample/map.c"
          (r1, r2, r3, r4, r5);
-#line 186 "sample/map.c"
-    if ((test_maps_helpers[5].tail_call) && (r0 == 0))
-#line 186 "sample/map.c"
-        return 0;
-        // EBPF_OP_MOV64_REG pc=1140 dst=r7 src=r0 offset=0 imm=0
+    // EBPF_OP_MOV64_REG pc=1140 dst=r7 src=r0 offset=0 imm=0
 #line 186 "sample/map.c"
     r7 = r0;
     // EBPF_OP_MOV64_REG pc=1141 dst=r1 src=r7 offset=0 imm=0
@@ -4230,11 +3920,7 @@ label_47:
     r0 = test_maps_helpers[5].address
 #line 186 "sample/map.c"
          (r1, r2, r3, r4, r5);
-#line 186 "sample/map.c"
-    if ((test_maps_helpers[5].tail_call) && (r0 == 0))
-#line 186 "sample/map.c"
-        return 0;
-        // EBPF_OP_MOV64_REG pc=1156 dst=r7 src=r0 offset=0 imm=0
+    // EBPF_OP_MOV64_REG pc=1156 dst=r7 src=r0 offset=0 imm=0
 #line 186 "sample/map.c"
     r7 = r0;
     // EBPF_OP_MOV64_REG pc=1157 dst=r1 src=r7 offset=0 imm=0
@@ -4282,11 +3968,7 @@ label_47:
     r0 = test_maps_helpers[5].address
 #line 186 "sample/map.c"
          (r1, r2, r3, r4, r5);
-#line 186 "sample/map.c"
-    if ((test_maps_helpers[5].tail_call) && (r0 == 0))
-#line 186 "sample/map.c"
-        return 0;
-        // EBPF_OP_MOV64_REG pc=1172 dst=r7 src=r0 offset=0 imm=0
+    // EBPF_OP_MOV64_REG pc=1172 dst=r7 src=r0 offset=0 imm=0
 #line 186 "sample/map.c"
     r7 = r0;
     // EBPF_OP_MOV64_REG pc=1173 dst=r1 src=r7 offset=0 imm=0
@@ -4334,11 +4016,7 @@ label_47:
     r0 = test_maps_helpers[4].address
 #line 189 "sample/map.c"
          (r1, r2, r3, r4, r5);
-#line 189 "sample/map.c"
-    if ((test_maps_helpers[4].tail_call) && (r0 == 0))
-#line 189 "sample/map.c"
-        return 0;
-        // EBPF_OP_LDXW pc=1188 dst=r1 src=r10 offset=-4 imm=0
+    // EBPF_OP_LDXW pc=1188 dst=r1 src=r10 offset=-4 imm=0
 #line 189 "sample/map.c"
     r1 = *(uint32_t*)(uintptr_t)(r10 + OFFSET(-4));
     // EBPF_OP_MOV64_REG pc=1189 dst=r7 src=r6 offset=0 imm=0
@@ -4408,11 +4086,7 @@ label_50:
     r0 = test_maps_helpers[5].address
 #line 190 "sample/map.c"
          (r1, r2, r3, r4, r5);
-#line 190 "sample/map.c"
-    if ((test_maps_helpers[5].tail_call) && (r0 == 0))
-#line 190 "sample/map.c"
-        return 0;
-        // EBPF_OP_LDXW pc=1209 dst=r1 src=r10 offset=-4 imm=0
+    // EBPF_OP_LDXW pc=1209 dst=r1 src=r10 offset=-4 imm=0
 #line 190 "sample/map.c"
     r1 = *(uint32_t*)(uintptr_t)(r10 + OFFSET(-4));
     // EBPF_OP_JEQ_IMM pc=1210 dst=r1 src=r0 offset=1 imm=0
@@ -4493,7 +4167,7 @@ static void
 _get_version(_Out_ bpf2c_version_t* version)
 {
     version->major = 0;
-    version->minor = 5;
+    version->minor = 6;
     version->revision = 0;
 }
 
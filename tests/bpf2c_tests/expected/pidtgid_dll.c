@@ -139,11 +139,7 @@ func(void* context)
     r0 = func_helpers[0].address
 #line 43 "sample/pidtgid.c"
          (r1, r2, r3, r4, r5);
-#line 43 "sample/pidtgid.c"
-    if ((func_helpers[0].tail_call) && (r0 == 0))
-#line 43 "sample/pidtgid.c"
-        return 0;
-        // EBPF_OP_LDXDW pc=7 dst=r1 src=r6 offset=16 imm=0
+    // EBPF_OP_LDXDW pc=7 dst=r1 src=r6 offset=16 imm=0
 #line 45 "sample/pidtgid.c"
     r1 = *(uint64_t*)(uintptr_t)(r6 + OFFSET(16));
     // EBPF_OP_STXW pc=8 dst=r10 src=r0 offset=-8 imm=0
@@ -187,10 +183,6 @@ func(void* context)
     r0 = func_helpers[1].address
 #line 47 "sample/pidtgid.c"
          (r1, r2, r3, r4, r5);
-#line 47 "sample/pidtgid.c"
-    if ((func_helpers[1].tail_call) && (r0 == 0))
-#line 47 "sample/pidtgid.c"
-        return 0;
 label_1:
     // EBPF_OP_MOV64_IMM pc=22 dst=r0 src=r0 offset=0 imm=0
 #line 50 "sample/pidtgid.c"
@@ -233,7 +225,7 @@ static void
 _get_version(_Out_ bpf2c_version_t* version)
 {
     version->major = 0;
-    version->minor = 5;
+    version->minor = 6;
     version->revision = 0;
 }
 
@@ -100,11 +100,7 @@ func(void* context)
     r0 = func_helpers[0].address
 #line 31 "sample/printk_legacy.c"
          (r1, r2, r3, r4, r5);
-#line 31 "sample/printk_legacy.c"
-    if ((func_helpers[0].tail_call) && (r0 == 0))
-#line 31 "sample/printk_legacy.c"
-        return 0;
-        // EBPF_OP_MOV64_REG pc=12 dst=r8 src=r0 offset=0 imm=0
+    // EBPF_OP_MOV64_REG pc=12 dst=r8 src=r0 offset=0 imm=0
 #line 31 "sample/printk_legacy.c"
     r8 = r0;
     // EBPF_OP_MOV64_IMM pc=13 dst=r1 src=r0 offset=0 imm=10
@@ -133,11 +129,7 @@ func(void* context)
     r0 = func_helpers[0].address
 #line 32 "sample/printk_legacy.c"
          (r1, r2, r3, r4, r5);
-#line 32 "sample/printk_legacy.c"
-    if ((func_helpers[0].tail_call) && (r0 == 0))
-#line 32 "sample/printk_legacy.c"
-        return 0;
-        // EBPF_OP_MOV64_REG pc=21 dst=r6 src=r0 offset=0 imm=0
+    // EBPF_OP_MOV64_REG pc=21 dst=r6 src=r0 offset=0 imm=0
 #line 32 "sample/printk_legacy.c"
     r6 = r0;
     // EBPF_OP_LDDW pc=22 dst=r1 src=r0 offset=0 imm=977553744
@@ -166,11 +158,7 @@ func(void* context)
     r0 = func_helpers[1].address
 #line 35 "sample/printk_legacy.c"
          (r1, r2, r3, r4, r5);
-#line 35 "sample/printk_legacy.c"
-    if ((func_helpers[1].tail_call) && (r0 == 0))
-#line 35 "sample/printk_legacy.c"
-        return 0;
-        // EBPF_OP_ADD64_REG pc=31 dst=r6 src=r0 offset=0 imm=0
+    // EBPF_OP_ADD64_REG pc=31 dst=r6 src=r0 offset=0 imm=0
 #line 35 "sample/printk_legacy.c"
     r6 += r0;
     // EBPF_OP_MOV64_IMM pc=32 dst=r8 src=r0 offset=0 imm=117
@@ -211,11 +199,7 @@ func(void* context)
     r0 = func_helpers[2].address
 #line 36 "sample/printk_legacy.c"
          (r1, r2, r3, r4, r5);
-#line 36 "sample/printk_legacy.c"
-    if ((func_helpers[2].tail_call) && (r0 == 0))
-#line 36 "sample/printk_legacy.c"
-        return 0;
-        // EBPF_OP_STXH pc=46 dst=r10 src=r8 offset=-4 imm=0
+    // EBPF_OP_STXH pc=46 dst=r10 src=r8 offset=-4 imm=0
 #line 38 "sample/printk_legacy.c"
     *(uint16_t*)(uintptr_t)(r10 + OFFSET(-4)) = (uint16_t)r8;
     // EBPF_OP_MOV64_IMM pc=47 dst=r1 src=r0 offset=0 imm=622869070
@@ -265,11 +249,7 @@ func(void* context)
     r0 = func_helpers[3].address
 #line 38 "sample/printk_legacy.c"
          (r1, r2, r3, r4, r5);
-#line 38 "sample/printk_legacy.c"
-    if ((func_helpers[3].tail_call) && (r0 == 0))
-#line 38 "sample/printk_legacy.c"
-        return 0;
-        // EBPF_OP_MOV64_IMM pc=64 dst=r1 src=r0 offset=0 imm=9504
+    // EBPF_OP_MOV64_IMM pc=64 dst=r1 src=r0 offset=0 imm=9504
 #line 38 "sample/printk_legacy.c"
     r1 = IMMEDIATE(9504);
     // EBPF_OP_STXH pc=65 dst=r10 src=r1 offset=-28 imm=0
@@ -304,11 +284,7 @@ func(void* context)
     r0 = func_helpers[0].address
 #line 42 "sample/printk_legacy.c"
          (r1, r2, r3, r4, r5);
-#line 42 "sample/printk_legacy.c"
-    if ((func_helpers[0].tail_call) && (r0 == 0))
-#line 42 "sample/printk_legacy.c"
-        return 0;
-        // EBPF_OP_LDDW pc=75 dst=r1 src=r0 offset=0 imm=843333954
+    // EBPF_OP_LDDW pc=75 dst=r1 src=r0 offset=0 imm=843333954
 #line 42 "sample/printk_legacy.c"
     r1 = (uint64_t)7812660273793483074;
     // EBPF_OP_STXDW pc=77 dst=r10 src=r1 offset=-32 imm=0
@@ -337,11 +313,7 @@ func(void* context)
     r0 = func_helpers[0].address
 #line 43 "sample/printk_legacy.c"
          (r1, r2, r3, r4, r5);
-#line 43 "sample/printk_legacy.c"
-    if ((func_helpers[0].tail_call) && (r0 == 0))
-#line 43 "sample/printk_legacy.c"
-        return 0;
-        // EBPF_OP_LDDW pc=85 dst=r1 src=r0 offset=0 imm=860111170
+    // EBPF_OP_LDDW pc=85 dst=r1 src=r0 offset=0 imm=860111170
 #line 43 "sample/printk_legacy.c"
     r1 = (uint64_t)7220718397787750722;
     // EBPF_OP_STXDW pc=87 dst=r10 src=r1 offset=-32 imm=0
@@ -370,11 +342,7 @@ func(void* context)
     r0 = func_helpers[1].address
 #line 44 "sample/printk_legacy.c"
          (r1, r2, r3, r4, r5);
-#line 44 "sample/printk_legacy.c"
-    if ((func_helpers[1].tail_call) && (r0 == 0))
-#line 44 "sample/printk_legacy.c"
-        return 0;
-        // EBPF_OP_LDDW pc=95 dst=r1 src=r0 offset=0 imm=876888386
+    // EBPF_OP_LDDW pc=95 dst=r1 src=r0 offset=0 imm=876888386
 #line 44 "sample/printk_legacy.c"
     r1 = (uint64_t)31566017637663042;
     // EBPF_OP_STXDW pc=97 dst=r10 src=r1 offset=-32 imm=0
@@ -400,11 +368,7 @@ func(void* context)
     r0 = func_helpers[1].address
 #line 45 "sample/printk_legacy.c"
          (r1, r2, r3, r4, r5);
-#line 45 "sample/printk_legacy.c"
-    if ((func_helpers[1].tail_call) && (r0 == 0))
-#line 45 "sample/printk_legacy.c"
-        return 0;
-        // EBPF_OP_MOV64_IMM pc=104 dst=r1 src=r0 offset=0 imm=893665602
+    // EBPF_OP_MOV64_IMM pc=104 dst=r1 src=r0 offset=0 imm=893665602
 #line 45 "sample/printk_legacy.c"
     r1 = IMMEDIATE(893665602);
     // EBPF_OP_STXW pc=105 dst=r10 src=r1 offset=-32 imm=0
@@ -433,11 +397,7 @@ func(void* context)
     r0 = func_helpers[1].address
 #line 49 "sample/printk_legacy.c"
          (r1, r2, r3, r4, r5);
-#line 49 "sample/printk_legacy.c"
-    if ((func_helpers[1].tail_call) && (r0 == 0))
-#line 49 "sample/printk_legacy.c"
-        return 0;
-        // EBPF_OP_LDDW pc=113 dst=r1 src=r0 offset=0 imm=910442818
+    // EBPF_OP_LDDW pc=113 dst=r1 src=r0 offset=0 imm=910442818
 #line 49 "sample/printk_legacy.c"
     r1 = (uint64_t)32973392554770754;
     // EBPF_OP_STXDW pc=115 dst=r10 src=r1 offset=-32 imm=0
@@ -460,11 +420,7 @@ func(void* context)
     r0 = func_helpers[0].address
 #line 50 "sample/printk_legacy.c"
          (r1, r2, r3, r4, r5);
-#line 50 "sample/printk_legacy.c"
-    if ((func_helpers[0].tail_call) && (r0 == 0))
-#line 50 "sample/printk_legacy.c"
-        return 0;
-        // EBPF_OP_STXB pc=121 dst=r10 src=r8 offset=-22 imm=0
+    // EBPF_OP_STXB pc=121 dst=r10 src=r8 offset=-22 imm=0
 #line 53 "sample/printk_legacy.c"
     *(uint8_t*)(uintptr_t)(r10 + OFFSET(-22)) = (uint8_t)r8;
     // EBPF_OP_MOV64_IMM pc=122 dst=r1 src=r0 offset=0 imm=25966
@@ -496,11 +452,7 @@ func(void* context)
     r0 = func_helpers[0].address
 #line 53 "sample/printk_legacy.c"
          (r1, r2, r3, r4, r5);
-#line 53 "sample/printk_legacy.c"
-    if ((func_helpers[0].tail_call) && (r0 == 0))
-#line 53 "sample/printk_legacy.c"
-        return 0;
-        // EBPF_OP_ADD64_REG pc=132 dst=r6 src=r0 offset=0 imm=0
+    // EBPF_OP_ADD64_REG pc=132 dst=r6 src=r0 offset=0 imm=0
 #line 53 "sample/printk_legacy.c"
     r6 += r0;
     // EBPF_OP_MOV64_REG pc=133 dst=r0 src=r6 offset=0 imm=0
@@ -544,7 +496,7 @@ static void
 _get_version(_Out_ bpf2c_version_t* version)
 {
     version->major = 0;
-    version->minor = 5;
+    version->minor = 6;
     version->revision = 0;
 }
 
@@ -236,10 +236,7 @@ func(void* context)
     r0 = func_helpers[0].address
 #line 22 "sample/printk_unsafe.c"
          (r1, r2, r3, r4, r5);
-#line 22 "sample/printk_unsafe.c"
-    if ((func_helpers[0].tail_call) && (r0 == 0))
-        return 0;
-        // EBPF_OP_MOV64_IMM pc=8 dst=r0 src=r0 offset=0 imm=0
+    // EBPF_OP_MOV64_IMM pc=8 dst=r0 src=r0 offset=0 imm=0
 #line 23 "sample/printk_unsafe.c"
     r0 = IMMEDIATE(0);
     // EBPF_OP_EXIT pc=9 dst=r0 src=r0 offset=0 imm=0
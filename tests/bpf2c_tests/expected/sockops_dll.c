@@ -337,11 +337,7 @@ label_6:
     r0 = connection_monitor_helpers[0].address
 #line 33 "sample/sockops.c"
          (r1, r2, r3, r4, r5);
-#line 33 "sample/sockops.c"
-    if ((connection_monitor_helpers[0].tail_call) && (r0 == 0))
-#line 33 "sample/sockops.c"
-        return 0;
-        // EBPF_OP_JEQ_IMM pc=62 dst=r0 src=r0 offset=162 imm=0
+    // EBPF_OP_JEQ_IMM pc=62 dst=r0 src=r0 offset=162 imm=0
 #line 33 "sample/sockops.c"
     if (r0 == IMMEDIATE(0))
 #line 33 "sample/sockops.c"
@@ -814,11 +810,7 @@ label_11:
     r0 = connection_monitor_helpers[0].address
 #line 58 "sample/sockops.c"
          (r1, r2, r3, r4, r5);
-#line 58 "sample/sockops.c"
-    if ((connection_monitor_helpers[0].tail_call) && (r0 == 0))
-#line 58 "sample/sockops.c"
-        return 0;
-        // EBPF_OP_MOV64_IMM pc=215 dst=r6 src=r0 offset=0 imm=0
+    // EBPF_OP_MOV64_IMM pc=215 dst=r6 src=r0 offset=0 imm=0
 #line 58 "sample/sockops.c"
     r6 = IMMEDIATE(0);
     // EBPF_OP_JEQ_IMM pc=216 dst=r0 src=r0 offset=8 imm=0
@@ -847,11 +839,7 @@ label_12:
     r0 = connection_monitor_helpers[1].address
 #line 58 "sample/sockops.c"
          (r1, r2, r3, r4, r5);
-#line 58 "sample/sockops.c"
-    if ((connection_monitor_helpers[1].tail_call) && (r0 == 0))
-#line 58 "sample/sockops.c"
-        return 0;
-        // EBPF_OP_MOV64_REG pc=224 dst=r6 src=r0 offset=0 imm=0
+    // EBPF_OP_MOV64_REG pc=224 dst=r6 src=r0 offset=0 imm=0
 #line 58 "sample/sockops.c"
     r6 = r0;
 label_13:
@@ -896,7 +884,7 @@ static void
 _get_version(_Out_ bpf2c_version_t* version)
 {
     version->major = 0;
-    version->minor = 5;
+    version->minor = 6;
     version->revision = 0;
 }
 
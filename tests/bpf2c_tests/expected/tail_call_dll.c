@@ -155,14 +155,20 @@ caller(void* context)
     r1 = POINTER(_maps[1].address);
     // EBPF_OP_CALL pc=10 dst=r0 src=r0 offset=0 imm=1
 #line 29 "sample/tail_call.c"
-    r0 = caller_helpers[1].address
+    if (_maps[1].array_data != NULL) {
 #line 29 "sample/tail_call.c"
-         (r1, r2, r3, r4, r5);
+        r0 = *(uint32_t*)(uintptr_t)r2;
 #line 29 "sample/tail_call.c"
-    if ((caller_helpers[1].tail_call) && (r0 == 0))
+        r0 = (r0 < 1) ? POINTER((uint8_t*)_maps[1].array_data + r0 * 4) : 0;
 #line 29 "sample/tail_call.c"
-        return 0;
-        // EBPF_OP_JEQ_IMM pc=11 dst=r0 src=r0 offset=2 imm=0
+    } else {
+#line 29 "sample/tail_call.c"
+        r0 = caller_helpers[1].address
+#line 29 "sample/tail_call.c"
+             (r1, r2, r3, r4, r5);
+#line 29 "sample/tail_call.c"
+    }
+    // EBPF_OP_JEQ_IMM pc=11 dst=r0 src=r0 offset=2 imm=0
 #line 30 "sample/tail_call.c"
     if (r0 == IMMEDIATE(0))
 #line 30 "sample/tail_call.c"
@@ -263,7 +269,7 @@ static void
 _get_version(_Out_ bpf2c_version_t* version)
 {
     version->major = 0;
-    version->minor = 5;
+    version->minor = 6;
     version->revision = 0;
 }
 
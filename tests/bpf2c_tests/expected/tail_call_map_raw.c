@@ -113,11 +113,7 @@ caller(void* context)
     r0 = caller_helpers[0].address
 #line 32 "sample/tail_call_map.c"
          (r1, r2, r3, r4, r5);
-#line 32 "sample/tail_call_map.c"
-    if ((caller_helpers[0].tail_call) && (r0 == 0))
-#line 32 "sample/tail_call_map.c"
-        return 0;
-        // EBPF_OP_MOV64_REG pc=8 dst=r1 src=r6 offset=0 imm=0
+    // EBPF_OP_MOV64_REG pc=8 dst=r1 src=r6 offset=0 imm=0
 #line 34 "sample/tail_call_map.c"
     r1 = r6;
     // EBPF_OP_MOV64_REG pc=9 dst=r2 src=r0 offset=0 imm=0
@@ -224,7 +220,7 @@ static void
 _get_version(_Out_ bpf2c_version_t* version)
 {
     version->major = 0;
-    version->minor = 5;
+    version->minor = 6;
     version->revision = 0;
 }
 
@@ -152,14 +152,20 @@ test_program_entry(void* context)
     r1 = POINTER(_maps[0].address);
     // EBPF_OP_CALL pc=8 dst=r0 src=r0 offset=0 imm=1
 #line 35 "sample/test_sample_ebpf.c"
-    r0 = test_program_entry_helpers[0].address
+    if (_maps[0].array_data != NULL) {
 #line 35 "sample/test_sample_ebpf.c"
-         (r1, r2, r3, r4, r5);
+        r0 = *(uint32_t*)(uintptr_t)r2;
+#line 35 "sample/test_sample_ebpf.c"
+        r0 = (r0 < 2) ? POINTER((uint8_t*)_maps[0].array_data + r0 * 32) : 0;
+#line 35 "sample/test_sample_ebpf.c"
+    } else {
 #line 35 "sample/test_sample_ebpf.c"
-    if ((test_program_entry_helpers[0].tail_call) && (r0 == 0))
+        r0 = test_program_entry_helpers[0].address
 #line 35 "sample/test_sample_ebpf.c"
-        return 0;
-        // EBPF_OP_MOV64_REG pc=9 dst=r8 src=r0 offset=0 imm=0
+             (r1, r2, r3, r4, r5);
+#line 35 "sample/test_sample_ebpf.c"
+    }
+    // EBPF_OP_MOV64_REG pc=9 dst=r8 src=r0 offset=0 imm=0
 #line 35 "sample/test_sample_ebpf.c"
     r8 = r0;
     // EBPF_OP_MOV64_REG pc=10 dst=r2 src=r10 offset=0 imm=0
@@ -173,14 +179,20 @@ test_program_entry(void* context)
     r1 = POINTER(_maps[0].address);
     // EBPF_OP_CALL pc=14 dst=r0 src=r0 offset=0 imm=1
 #line 36 "sample/test_sample_ebpf.c"
-    r0 = test_program_entry_helpers[0].address
+    if (_maps[0].array_data != NULL) {
 #line 36 "sample/test_sample_ebpf.c"
-         (r1, r2, r3, r4, r5);
+        r0 = *(uint32_t*)(uintptr_t)r2;
+#line 36 "sample/test_sample_ebpf.c"
+        r0 = (r0 < 2) ? POINTER((uint8_t*)_maps[0].array_data + r0 * 32) : 0;
+#line 36 "sample/test_sample_ebpf.c"
+    } else {
 #line 36 "sample/test_sample_ebpf.c"
-    if ((test_program_entry_helpers[0].tail_call) && (r0 == 0))
+        r0 = test_program_entry_helpers[0].address
 #line 36 "sample/test_sample_ebpf.c"
-        return 0;
-        // EBPF_OP_MOV64_REG pc=15 dst=r7 src=r0 offset=0 imm=0
+             (r1, r2, r3, r4, r5);
+#line 36 "sample/test_sample_ebpf.c"
+    }
+    // EBPF_OP_MOV64_REG pc=15 dst=r7 src=r0 offset=0 imm=0
 #line 36 "sample/test_sample_ebpf.c"
     r7 = r0;
     // EBPF_OP_JEQ_IMM pc=16 dst=r8 src=r0 offset=17 imm=0
@@ -213,11 +225,7 @@ test_program_entry(void* context)
     r0 = test_program_entry_helpers[1].address
 #line 42 "sample/test_sample_ebpf.c"
          (r1, r2, r3, r4, r5);
-#line 42 "sample/test_sample_ebpf.c"
-    if ((test_program_entry_helpers[1].tail_call) && (r0 == 0))
-#line 42 "sample/test_sample_ebpf.c"
-        return 0;
-        // EBPF_OP_JEQ_IMM pc=24 dst=r7 src=r0 offset=9 imm=0
+    // EBPF_OP_JEQ_IMM pc=24 dst=r7 src=r0 offset=9 imm=0
 #line 44 "sample/test_sample_ebpf.c"
     if (r7 == IMMEDIATE(0))
 #line 44 "sample/test_sample_ebpf.c"
@@ -245,11 +253,7 @@ test_program_entry(void* context)
     r0 = test_program_entry_helpers[2].address
 #line 45 "sample/test_sample_ebpf.c"
          (r1, r2, r3, r4, r5);
-#line 45 "sample/test_sample_ebpf.c"
-    if ((test_program_entry_helpers[2].tail_call) && (r0 == 0))
-#line 45 "sample/test_sample_ebpf.c"
-        return 0;
-        // EBPF_OP_MOV64_IMM pc=32 dst=r1 src=r0 offset=0 imm=0
+    // EBPF_OP_MOV64_IMM pc=32 dst=r1 src=r0 offset=0 imm=0
 #line 45 "sample/test_sample_ebpf.c"
     r1 = IMMEDIATE(0);
     // EBPF_OP_JSGT_REG pc=33 dst=r1 src=r0 offset=5 imm=0
@@ -266,11 +270,7 @@ label_1:
     r0 = test_program_entry_helpers[3].address
 #line 53 "sample/test_sample_ebpf.c"
          (r1, r2, r3, r4, r5);
-#line 53 "sample/test_sample_ebpf.c"
-    if ((test_program_entry_helpers[3].tail_call) && (r0 == 0))
-#line 53 "sample/test_sample_ebpf.c"
-        return 0;
-        // EBPF_OP_MOV64_IMM pc=36 dst=r1 src=r0 offset=0 imm=0
+    // EBPF_OP_MOV64_IMM pc=36 dst=r1 src=r0 offset=0 imm=0
 #line 53 "sample/test_sample_ebpf.c"
     r1 = IMMEDIATE(0);
     // EBPF_OP_JSGT_REG pc=37 dst=r1 src=r0 offset=1 imm=0
@@ -364,11 +364,7 @@ test_utility_helpers(void* context)
     r0 = test_utility_helpers_helpers[0].address
 #line 16 "sample/./sample_common_routines.h"
          (r1, r2, r3, r4, r5);
-#line 16 "sample/./sample_common_routines.h"
-    if ((test_utility_helpers_helpers[0].tail_call) && (r0 == 0))
-#line 16 "sample/./sample_common_routines.h"
-        return 0;
-        // EBPF_OP_STXW pc=9 dst=r10 src=r0 offset=-48 imm=0
+    // EBPF_OP_STXW pc=9 dst=r10 src=r0 offset=-48 imm=0
 #line 16 "sample/./sample_common_routines.h"
     *(uint32_t*)(uintptr_t)(r10 + OFFSET(-48)) = (uint32_t)r0;
     // EBPF_OP_CALL pc=10 dst=r0 src=r0 offset=0 imm=7
@@ -376,11 +372,7 @@ test_utility_helpers(void* context)
     r0 = test_utility_helpers_helpers[1].address
 #line 24 "sample/./sample_common_routines.h"
          (r1, r2, r3, r4, r5);
-#line 24 "sample/./sample_common_routines.h"
-    if ((test_utility_helpers_helpers[1].tail_call) && (r0 == 0))
-#line 24 "sample/./sample_common_routines.h"
-        return 0;
-        // EBPF_OP_STXDW pc=11 dst=r10 src=r0 offset=-32 imm=0
+    // EBPF_OP_STXDW pc=11 dst=r10 src=r0 offset=-32 imm=0
 #line 24 "sample/./sample_common_routines.h"
     *(uint64_t*)(uintptr_t)(r10 + OFFSET(-32)) = (uint64_t)r0;
     // EBPF_OP_CALL pc=12 dst=r0 src=r0 offset=0 imm=9
@@ -388,11 +380,7 @@ test_utility_helpers(void* context)
     r0 = test_utility_helpers_helpers[2].address
 #line 27 "sample/./sample_common_routines.h"
          (r1, r2, r3, r4, r5);
-#line 27 "sample/./sample_common_routines.h"
-    if ((test_utility_helpers_helpers[2].tail_call) && (r0 == 0))
-#line 27 "sample/./sample_common_routines.h"
-        return 0;
-        // EBPF_OP_STXDW pc=13 dst=r10 src=r0 offset=-40 imm=0
+    // EBPF_OP_STXDW pc=13 dst=r10 src=r0 offset=-40 imm=0
 #line 27 "sample/./sample_common_routines.h"
     *(uint64_t*)(uintptr_t)(r10 + OFFSET(-40)) = (uint64_t)r0;
     // EBPF_OP_CALL pc=14 dst=r0 src=r0 offset=0 imm=8
@@ -400,11 +388,7 @@ test_utility_helpers(void* context)
     r0 = test_utility_helpers_helpers[3].address
 #line 30 "sample/./sample_common_routines.h"
          (r1, r2, r3, r4, r5);
-#line 30 "sample/./sample_common_routines.h"
-    if ((test_utility_helpers_helpers[3].tail_call) && (r0 == 0))
-#line 30 "sample/./sample_common_routines.h"
-        return 0;
-        // EBPF_OP_STXW pc=15 dst=r10 src=r0 offset=-24 imm=0
+    // EBPF_OP_STXW pc=15 dst=r10 src=r0 offset=-24 imm=0
 #line 30 "sample/./sample_common_routines.h"
     *(uint32_t*)(uintptr_t)(r10 + OFFSET(-24)) = (uint32_t)r0;
     // EBPF_OP_CALL pc=16 dst=r0 src=r0 offset=0 imm=19
@@ -412,11 +396,7 @@ test_utility_helpers(void* context)
     r0 = test_utility_helpers_helpers[4].address
 #line 33 "sample/./sample_common_routines.h"
          (r1, r2, r3, r4, r5);
-#line 33 "sample/./sample_common_routines.h"
-    if ((test_utility_helpers_helpers[4].tail_call) && (r0 == 0))
-#line 33 "sample/./sample_common_routines.h"
-        return 0;
-        // EBPF_OP_STXDW pc=17 dst=r10 src=r0 offset=-16 imm=0
+    // EBPF_OP_STXDW pc=17 dst=r10 src=r0 offset=-16 imm=0
 #line 33 "sample/./sample_common_routines.h"
     *(uint64_t*)(uintptr_t)(r10 + OFFSET(-16)) = (uint64_t)r0;
     // EBPF_OP_MOV64_REG pc=18 dst=r2 src=r10 offset=0 imm=0
@@ -445,20 +425,12 @@ test_utility_helpers(void* context)
     r0 = test_utility_helpers_helpers[5].address
 #line 36 "sample/./sample_common_routines.h"
          (r1, r2, r3, r4, r5);
-#line 36 "sample/./sample_common_routines.h"
-    if ((test_utility_helpers_helpers[5].tail_call) && (r0 == 0))
-#line 36 "sample/./sample_common_routines.h"
-        return 0;
-        // EBPF_OP_CALL pc=27 dst=r0 src=r0 offset=0 imm=6
+    // EBPF_OP_CALL pc=27 dst=r0 src=r0 offset=0 imm=6
 #line 39 "sample/./sample_common_routines.h"
     r0 = test_utility_helpers_helpers[0].address
 #line 39 "sample/./sample_common_routines.h"
          (r1, r2, r3, r4, r5);
-#line 39 "sample/./sample_common_routines.h"
-    if ((test_utility_helpers_helpers[0].tail_call) && (r0 == 0))
-#line 39 "sample/./sample_common_routines.h"
-        return 0;
-        // EBPF_OP_STXW pc=28 dst=r10 src=r0 offset=-48 imm=0
+    // EBPF_OP_STXW pc=28 dst=r10 src=r0 offset=-48 imm=0
 #line 39 "sample/./sample_common_routines.h"
     *(uint32_t*)(uintptr_t)(r10 + OFFSET(-48)) = (uint32_t)r0;
     // EBPF_OP_CALL pc=29 dst=r0 src=r0 offset=0 imm=9
@@ -466,11 +438,7 @@ test_utility_helpers(void* context)
     r0 = test_utility_helpers_helpers[2].address
 #line 42 "sample/./sample_common_routines.h"
          (r1, r2, r3, r4, r5);
-#line 42 "sample/./sample_common_routines.h"
-    if ((test_utility_helpers_helpers[2].tail_call) && (r0 == 0))
-#line 42 "sample/./sample_common_routines.h"
-        return 0;
-        // EBPF_OP_STXDW pc=30 dst=r10 src=r0 offset=-40 imm=0
+    // EBPF_OP_STXDW pc=30 dst=r10 src=r0 offset=-40 imm=0
 #line 42 "sample/./sample_common_routines.h"
     *(uint64_t*)(uintptr_t)(r10 + OFFSET(-40)) = (uint64_t)r0;
     // EBPF_OP_CALL pc=31 dst=r0 src=r0 offset=0 imm=7
@@ -478,11 +446,7 @@ test_utility_helpers(void* context)
     r0 = test_utility_helpers_helpers[1].address
 #line 45 "sample/./sample_common_routines.h"
          (r1, r2, r3, r4, r5);
-#line 45 "sample/./sample_common_routines.h"
-    if ((test_utility_helpers_helpers[1].tail_call) && (r0 == 0))
-#line 45 "sample/./sample_common_routines.h"
-        return 0;
-        // EBPF_OP_STXDW pc=32 dst=r10 src=r0 offset=-32 imm=0
+    // EBPF_OP_STXDW pc=32 dst=r10 src=r0 offset=-32 imm=0
 #line 45 "sample/./sample_common_routines.h"
     *(uint64_t*)(uintptr_t)(r10 + OFFSET(-32)) = (uint64_t)r0;
     // EBPF_OP_CALL pc=33 dst=r0 src=r0 offset=0 imm=19
@@ -490,11 +454,7 @@ test_utility_helpers(void* context)
     r0 = test_utility_helpers_helpers[4].address
 #line 48 "sample/./sample_common_routines.h"
          (r1, r2, r3, r4, r5);
-#line 48 "sample/./sample_common_routines.h"
-    if ((test_utility_helpers_helpers[4].tail_call) && (r0 == 0))
-#line 48 "sample/./sample_common_routines.h"
-        return 0;
-        // EBPF_OP_STXDW pc=34 dst=r10 src=r0 offset=-16 imm=0
+    // EBPF_OP_STXDW pc=34 dst=r10 src=r0 offset=-16 imm=0
 #line 48 "sample/./sample_common_routines.h"
     *(uint64_t*)(uintptr_t)(r10 + OFFSET(-16)) = (uint64_t)r0;
     // EBPF_OP_MOV64_REG pc=35 dst=r2 src=r10 offset=0 imm=0
@@ -517,11 +477,7 @@ test_utility_helpers(void* context)
     r0 = test_utility_helpers_helpers[5].address
 #line 51 "sample/./sample_common_routines.h"
          (r1, r2, r3, r4, r5);
-#line 51 "sample/./sample_common_routines.h"
-    if ((test_utility_helpers_helpers[5].tail_call) && (r0 == 0))
-#line 51 "sample/./sample_common_routines.h"
-        return 0;
-        // EBPF_OP_MOV64_IMM pc=42 dst=r0 src=r0 offset=0 imm=0
+    // EBPF_OP_MOV64_IMM pc=42 dst=r0 src=r0 offset=0 imm=0
 #line 75 "sample/test_sample_ebpf.c"
     r0 = IMMEDIATE(0);
     // EBPF_OP_EXIT pc=43 dst=r0 src=r0 offset=0 imm=0
@@ -576,7 +532,7 @@ static void
 _get_version(_Out_ bpf2c_version_t* version)
 {
     version->major = 0;
-    version->minor = 5;
+    version->minor = 6;
     version->revision = 0;
 }
 
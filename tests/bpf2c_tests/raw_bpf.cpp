@@ -384,9 +384,11 @@ DECLARE_TEST("subnet")
 // DECLARE_TEST("unload_reload")
 
 void
-verify_invalid_opcode_sequence(const std::vector<ebpf_inst>& instructions, const std::string& error)
+verify_invalid_opcode_sequence(
+    const std::vector<ebpf_inst>& instructions, const std::string& error, bool allow_subprograms = false)
 {
     bpf_code_generator code("test", instructions);
+    code.set_allow_subprograms(allow_subprograms);
     try {
         code.generate("test");
         FAIL("bpf_code_generator permitted invalid sequence");
@@ -444,6 +446,267 @@ TEST_CASE("EBPF_CLS_JMP invalid operation", "[raw_bpf_code_gen][negative]")
         {{(EBPF_CLS_JMP | 0xf0), 0, 0, 0, 0}, {EBPF_OP_EXIT, 0, 0, 0, 0}}, "invalid operand at offset 0");
 }
 
+TEST_CASE("division by non-zero divisor", "[raw_bpf_code_gen]")
+{
+    // r1 is known to be non-zero, r2 is not.
+    std::vector<ebpf_inst> instructions = {
+        {EBPF_OP_MOV64_IMM, 0, 0, 0, 100},
+        {EBPF_OP_MOV64_IMM, 1, 0, 0, 3},
+        {EBPF_OP_DIV64_REG, 0, 1, 0, 0},
+        {EBPF_OP_MOD64_REG, 0, 2, 0, 0},
+        {EBPF_OP_DIV_IMM, 0, 0, 0, 7},
+        {EBPF_OP_EXIT, 0, 0, 0, 0},
+    };
+    std::stringstream output;
+    bpf_code_generator code("test", instructions);
+    code.generate("test");
+    code.emit_c_code(output);
+    std::string c_code = output.str();
+    REQUIRE(c_code.find("r0 /= r1;") != std::string::npos);
+    REQUIRE(c_code.find("r0 = r2 ? (r0 % r2): r0 ;") != std::string::npos);
+    REQUIRE(c_code.find("r0 = (uint32_t)r0 / (uint32_t)IMMEDIATE(7);") != std::string::npos);
+}
+
+TEST_CASE("instrumentation and profile", "[raw_bpf_code_gen]")
+{
+    // Three basic blocks: the entry, the fall through of the branch and the branch target.
+    std::vector<ebpf_inst> instructions = {
+        {EBPF_OP_MOV64_IMM, 0, 0, 0, 0},
+        {EBPF_OP_JEQ_IMM, 1, 0, 1, 0},
+        {EBPF_OP_MOV64_IMM, 0, 0, 0, 1},
+        {EBPF_OP_EXIT, 0, 0, 0, 0},
+    };
+
+    SECTION("instrument")
+    {
+        std::stringstream output;
+        bpf_code_generator code("test", instructions);
+        code.set_instrumentation(true);
+        code.generate("test");
+        code.emit_c_code(output);
+        std::string c_code = output.str();
+        REQUIRE(c_code.find("static uint64_t test_block_counts[3];") != std::string::npos);
+        REQUIRE(c_code.find("test_block_counts[0]++;") != std::string::npos);
+        REQUIRE(c_code.find("test_block_counts[2]++;") != std::string::npos);
+        REQUIRE(c_code.find("#define BPF2C_BRANCH_HINTS") == std::string::npos);
+    }
+
+    SECTION("branch mostly taken")
+    {
+        std::stringstream output;
+        bpf_code_generator code("test", instructions);
+        code.set_profile("test", {100, 5, 100});
+        code.generate("test");
+        code.emit_c_code(output);
+        REQUIRE(output.str().find("if (LIKELY(r1 == IMMEDIATE(0)))") != std::string::npos);
+        REQUIRE(output.str().find("#define BPF2C_BRANCH_HINTS\n#include \"bpf2c.h\"") != std::string::npos);
+    }
+
+    SECTION("branch mostly not taken")
+    {
+        std::stringstream output;
+        bpf_code_generator code("test", instructions);
+        code.set_profile("test", {100, 95, 100});
+        code.generate("test");
+        code.emit_c_code(output);
+        REQUIRE(output.str().find("if (UNLIKELY(r1 == IMMEDIATE(0)))") != std::string::npos);
+        REQUIRE(output.str().find("#define BPF2C_BRANCH_HINTS") != std::string::npos);
+    }
+
+    SECTION("profile mismatch")
+    {
+        bpf_code_generator code("test", instructions);
+        code.set_profile("test", {100, 95});
+        REQUIRE_THROWS(code.generate("test"));
+    }
+}
+
+TEST_CASE("atomic operations", "[raw_bpf_code_gen]")
+{
+    // EBPF_CLS_STX | EBPF_MODE_ATOMIC, with the operation in the immediate.
+    std::vector<ebpf_inst> instructions = {
+        {(EBPF_CLS_STX | 0xc0 | EBPF_SIZE_DW), 10, 1, -8, 0x00}, // lock *(u64*)(r10 - 8) += r1
+        {(EBPF_CLS_STX | 0xc0 | EBPF_SIZE_W), 10, 1, -4, 0x41},  // r1 = atomic_fetch_or((u32*)(r10 - 4), r1)
+        {(EBPF_CLS_STX | 0xc0 | EBPF_SIZE_DW), 10, 2, -8, 0xf1}, // r0 = cmpxchg((u64*)(r10 - 8), r0, r2)
+        {EBPF_OP_EXIT, 0, 0, 0, 0},
+    };
+    std::stringstream output;
+    bpf_code_generator code("test", instructions);
+    code.generate("test");
+    code.emit_c_code(output);
+    std::string c_code = output.str();
+    REQUIRE(
+        c_code.find("_InterlockedExchangeAdd64((volatile int64_t*)(uintptr_t)(r10 + OFFSET(-8)), (int64_t)r1);") !=
+        std::string::npos);
+    REQUIRE(
+        c_code.find("r1 = (uint32_t)_InterlockedOr((volatile long*)(uintptr_t)(r10 + OFFSET(-4)), (long)r1);") !=
+        std::string::npos);
+    REQUIRE(
+        c_code.find("r0 = (uint64_t)_InterlockedCompareExchange64((volatile int64_t*)(uintptr_t)(r10 + OFFSET(-8)), "
+                    "(int64_t)r2, (int64_t)r0);") != std::string::npos);
+
+    // Exchanges require the fetch flag.
+    verify_invalid_opcode_sequence(
+        {{(EBPF_CLS_STX | 0xc0 | EBPF_SIZE_W), 10, 1, -4, 0xe0}}, "invalid operand at offset 0");
+}
+
+TEST_CASE("bpf_loop", "[raw_bpf_code_gen]")
+{
+    // The wide load with source register 4 (BPF_PSEUDO_FUNC) loads the address of the callback at pc=7.
+    std::vector<ebpf_inst> instructions = {
+        {EBPF_OP_MOV64_IMM, 1, 0, 0, 4},
+        {EBPF_OP_LDDW, 2, 4, 0, 5},
+        {0, 0, 0, 0, 0},
+        {EBPF_OP_MOV64_IMM, 3, 0, 0, 0},
+        {EBPF_OP_MOV64_IMM, 4, 0, 0, 0},
+        {EBPF_OP_CALL, 0, 0, 0, BPF_FUNC_loop},
+        {EBPF_OP_EXIT, 0, 0, 0, 0},
+        {EBPF_OP_MOV64_IMM, 0, 0, 0, 0},
+        {EBPF_OP_EXIT, 0, 0, 0, 0},
+    };
+    std::stringstream output;
+    bpf_code_generator code("test", instructions);
+    code.set_allow_subprograms(true);
+    code.generate("test");
+    code.emit_c_code(output);
+    std::string c_code = output.str();
+
+    // The callback is a separate function called from a native loop.
+    REQUIRE(c_code.find("static uint64_t\ntest_subprogram_7(uint64_t index, uint64_t context)") != std::string::npos);
+    REQUIRE(c_code.find("r2 = POINTER(&test_subprogram_7);") != std::string::npos);
+    REQUIRE(c_code.find("for (r0 = 0; r0 < (uint32_t)r1;) {") != std::string::npos);
+    REQUIRE(c_code.find("if (test_subprogram_7(r0++, r3) != 0)") != std::string::npos);
+    REQUIRE(c_code.find("test_helpers[0].address") == std::string::npos);
+
+    // The native loop replaces the helper, so the program doesn't import it.
+    REQUIRE(c_code.find("static helper_function_entry_t test_helpers[]") == std::string::npos);
+
+    // The callback must be known where bpf_loop is called.
+    verify_invalid_opcode_sequence(
+        {{EBPF_OP_CALL, 0, 0, 0, BPF_FUNC_loop}, {EBPF_OP_EXIT, 0, 0, 0, 0}},
+        "bpf_loop callback must be loaded in the same basic block at offset 0",
+        true);
+    verify_invalid_opcode_sequence(
+        {{EBPF_OP_LDDW, 2, 4, 0, 5}, {0, 0, 0, 0, 0}}, "invalid function target at offset 0", true);
+
+    // Callbacks are rejected unless the program is not verified, as the verifier can't check them.
+    verify_invalid_opcode_sequence(instructions, "subprograms can't be verified at offset 1");
+    verify_invalid_opcode_sequence(
+        {{EBPF_OP_CALL, 0, 0, 0, BPF_FUNC_loop}, {EBPF_OP_EXIT, 0, 0, 0, 0}},
+        "bpf_loop callbacks can't be verified at offset 0");
+}
+
+TEST_CASE("switch lowering", "[raw_bpf_code_gen]")
+{
+    // A chain of equality tests of r1 against constants, as emitted for a switch statement.
+    std::vector<ebpf_inst> instructions = {
+        {EBPF_OP_JEQ_IMM, 1, 0, 4, 1},
+        {EBPF_OP_JEQ_IMM, 1, 0, 3, 2},
+        {EBPF_OP_JEQ_IMM, 1, 0, 3, 1},
+        {EBPF_OP_JEQ_IMM, 1, 0, 2, -1},
+        {EBPF_OP_MOV64_IMM, 0, 0, 0, 0},
+        {EBPF_OP_EXIT, 0, 0, 0, 0},
+        {EBPF_OP_MOV64_IMM, 0, 0, 0, 1},
+        {EBPF_OP_EXIT, 0, 0, 0, 0},
+    };
+    std::stringstream output;
+    bpf_code_generator code("test", instructions);
+    code.generate("test");
+    code.emit_c_code(output);
+    std::string c_code = output.str();
+
+    REQUIRE(c_code.find("switch (r1) {") != std::string::npos);
+    REQUIRE(c_code.find("case IMMEDIATE(2):\n        goto label_1;") != std::string::npos);
+    REQUIRE(c_code.find("case IMMEDIATE(-1):\n        goto label_2;") != std::string::npos);
+    REQUIRE(c_code.find("if (r1 ==") == std::string::npos);
+
+    // The repeated constant keeps the target of its first test.
+    size_t first_case = c_code.find("case IMMEDIATE(1):\n        goto label_1;");
+    REQUIRE(first_case != std::string::npos);
+    REQUIRE(c_code.find("case IMMEDIATE(1):", first_case + 1) == std::string::npos);
+}
+
+TEST_CASE("global data", "[raw_bpf_code_gen]")
+{
+    // Load a .rodata constant and store it in a .bss variable, both addressed through relocations.
+    std::vector<ebpf_inst> instructions = {
+        {EBPF_OP_LDDW, 1, 0, 0, 0},
+        {0, 0, 0, 0, 0},
+        {EBPF_OP_LDXW, 0, 1, 0, 0},
+        {EBPF_OP_LDDW, 2, 0, 0, 0},
+        {0, 0, 0, 0, 0},
+        {EBPF_OP_STXDW, 2, 0, 0, 0},
+        {EBPF_OP_EXIT, 0, 0, 0, 0},
+    };
+    const char rodata_contents[] = {0, 0, 0, 0, 42, 0, 0, 0};
+
+    ELFIO::elfio writer;
+    writer.create(ELFIO::ELFCLASS64, ELFIO::ELFDATA2LSB);
+    writer.set_type(ELFIO::ET_REL);
+    writer.set_machine(ELFIO::EM_BPF);
+
+    ELFIO::section* text = writer.sections.add("xdp");
+    text->set_type(ELFIO::SHT_PROGBITS);
+    text->set_flags(ELFIO::SHF_ALLOC | ELFIO::SHF_EXECINSTR);
+    text->set_addr_align(8);
+    text->set_data(
+        reinterpret_cast<const char*>(instructions.data()),
+        static_cast<ELFIO::Elf_Word>(instructions.size() * sizeof(ebpf_inst)));
+
+    ELFIO::section* rodata = writer.sections.add(".rodata");
+    rodata->set_type(ELFIO::SHT_PROGBITS);
+    rodata->set_flags(ELFIO::SHF_ALLOC);
+    rodata->set_data(rodata_contents, sizeof(rodata_contents));
+
+    ELFIO::section* bss = writer.sections.add(".bss");
+    bss->set_type(ELFIO::SHT_NOBITS);
+    bss->set_flags(ELFIO::SHF_ALLOC | ELFIO::SHF_WRITE);
+    bss->set_size(16);
+
+    ELFIO::section* strtab = writer.sections.add(".strtab");
+    strtab->set_type(ELFIO::SHT_STRTAB);
+    ELFIO::section* symtab = writer.sections.add(".symtab");
+    symtab->set_type(ELFIO::SHT_SYMTAB);
+    symtab->set_link(strtab->get_index());
+    symtab->set_entry_size(writer.get_default_entry_size(ELFIO::SHT_SYMTAB));
+    ELFIO::string_section_accessor strings(strtab);
+    ELFIO::symbol_section_accessor symbols(writer, symtab);
+    symbols.add_symbol(
+        strings, "func", 0, text->get_size(), ELFIO::STB_GLOBAL, ELFIO::STT_FUNC, 0, text->get_index());
+    ELFIO::Elf_Word constant =
+        symbols.add_symbol(strings, "constant", 4, 4, ELFIO::STB_LOCAL, ELFIO::STT_OBJECT, 0, rodata->get_index());
+    ELFIO::Elf_Word counter =
+        symbols.add_symbol(strings, "counter", 8, 8, ELFIO::STB_GLOBAL, ELFIO::STT_OBJECT, 0, bss->get_index());
+
+    ELFIO::section* relocations = writer.sections.add(".relxdp");
+    relocations->set_type(ELFIO::SHT_REL);
+    relocations->set_info(text->get_index());
+    relocations->set_link(symtab->get_index());
+    relocations->set_entry_size(writer.get_default_entry_size(ELFIO::SHT_REL));
+    ELFIO::relocation_section_accessor relocation_writer(writer, relocations);
+    relocation_writer.add_entry(0 * sizeof(ebpf_inst), constant, (unsigned char)1);
+    relocation_writer.add_entry(3 * sizeof(ebpf_inst), counter, (unsigned char)1);
+
+    std::stringstream elf;
+    REQUIRE(writer.save(elf));
+
+    std::stringstream output;
+    bpf_code_generator code(elf, "test");
+    code.parse();
+    code.parse("xdp", GUID{}, GUID{}, std::nullopt);
+    code.generate("xdp");
+    code.emit_c_code(output);
+    std::string c_code = output.str();
+
+    // The load from .rodata is folded into the constant, and .bss is addressed in the value of its map.
+    REQUIRE(c_code.find("r0 = (uint64_t)42;") != std::string::npos);
+    REQUIRE(c_code.find("r2 = POINTER((uint8_t*)_maps[0].array_data + 8);") != std::string::npos);
+
+    // .bss starts zeroed. .rodata has an initial value and is frozen once it is set, as loads from it are folded.
+    REQUIRE(c_code.find("\".bss\",\n     NULL,\n     NULL,\n     false},") != std::string::npos);
+    REQUIRE(c_code.find("\".rodata\",\n     NULL,\n     _map_initial_value_1,\n     true},") != std::string::npos);
+}
+
 TEST_CASE("invalid register", "[raw_bpf_code_gen][negative]")
 {
     // 14 and 15 aren't valid registers.
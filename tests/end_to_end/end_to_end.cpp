@@ -19,6 +19,7 @@
 #include "catch_wrapper.hpp"
 #include "common_tests.h"
 #include "ebpf_core.h"
+#include "ebpf_vm_isa.hpp"
 #include "helpers.h"
 #include "ioctl_helper.h"
 #include "mock.h"
@@ -503,6 +504,44 @@ divide_by_zero_test_um(ebpf_execution_type_t execution_type)
     bpf_object__close(object);
 }
 
+// bpf_loop is lowered to a native loop by bpf2c, which only accepts the callback when verification is skipped.
+TEST_CASE("bpf_loop-native", "[end_to_end]")
+{
+    _test_helper_end_to_end test_helper;
+
+    const char* error_message = nullptr;
+    bpf_object* object = nullptr;
+    fd_t program_fd;
+    bpf_link* link;
+
+    single_instance_hook_t hook(EBPF_PROGRAM_TYPE_XDP, EBPF_ATTACH_TYPE_XDP);
+    program_info_provider_t xdp_program_info(EBPF_PROGRAM_TYPE_XDP);
+
+    int result = ebpf_program_load(
+        "bpf_loop_um.dll", BPF_PROG_TYPE_UNSPEC, EBPF_EXECUTION_NATIVE, &object, &program_fd, &error_message);
+    if (error_message) {
+        printf("ebpf_program_load failed with %s\n", error_message);
+        ebpf_free((void*)error_message);
+    }
+    REQUIRE(result == 0);
+
+    uint32_t ifindex = 0;
+    REQUIRE(hook.attach_link(program_fd, &ifindex, sizeof(ifindex), &link) == EBPF_SUCCESS);
+
+    auto packet = prepare_udp_packet(0, ETHERNET_TYPE_IPV4);
+    xdp_md_t ctx{packet.data(), packet.data() + packet.size(), 0, TEST_IFINDEX};
+
+    // The callback ends the loop on its fourth call.
+    int hook_result;
+    REQUIRE(hook.fire(&ctx, &hook_result) == EBPF_SUCCESS);
+    REQUIRE(hook_result == 4);
+
+    hook.detach_link(link);
+    hook.close_link(link);
+
+    bpf_object__close(object);
+}
+
 void
 bad_map_name_um(ebpf_execution_type_t execution_type)
 {
@@ -836,6 +875,120 @@ bindmonitor_ring_buffer_test(ebpf_execution_type_t execution_type)
     bpf_object__close(object);
 }
 
+typedef struct _ring_buffer_poll_test_context
+{
+    std::thread::id thread_id = std::this_thread::get_id();
+    uint32_t record_count = 0;
+    uint32_t wrong_thread_count = 0;
+    bool fail_next_record = false;
+} ring_buffer_poll_test_context_t;
+
+static int
+_ring_buffer_poll_test_handler(_Inout_ void* ctx, _In_opt_ void* data, size_t size)
+{
+    auto context = reinterpret_cast<ring_buffer_poll_test_context_t*>(ctx);
+    UNREFERENCED_PARAMETER(data);
+    UNREFERENCED_PARAMETER(size);
+    if (std::this_thread::get_id() != context->thread_id) {
+        context->wrong_thread_count++;
+    }
+    context->record_count++;
+    if (context->fail_next_record) {
+        context->fail_next_record = false;
+        return -1;
+    }
+    return 0;
+}
+
+static int
+_ring_buffer_ignore_handler(_Inout_opt_ void* ctx, _In_opt_ void* data, size_t size)
+{
+    UNREFERENCED_PARAMETER(ctx);
+    UNREFERENCED_PARAMETER(data);
+    UNREFERENCED_PARAMETER(size);
+    return 0;
+}
+
+void
+bindmonitor_ring_buffer_poll_test(ebpf_execution_type_t execution_type)
+{
+    _test_helper_end_to_end test_helper;
+
+    const char* error_message = nullptr;
+    bpf_object* object = nullptr;
+    bpf_link* link = nullptr;
+    fd_t program_fd;
+
+    program_info_provider_t bind_program_info(EBPF_PROGRAM_TYPE_BIND);
+
+    const char* file_name =
+        (execution_type == EBPF_EXECUTION_NATIVE ? "bindmonitor_ringbuf_um.dll" : "bindmonitor_ringbuf.o");
+    int result =
+        ebpf_program_load(file_name, BPF_PROG_TYPE_UNSPEC, execution_type, &object, &program_fd, &error_message);
+    if (error_message) {
+        printf("ebpf_program_load failed with %s\n", error_message);
+        ebpf_free((void*)error_message);
+    }
+    REQUIRE(result == 0);
+
+    fd_t process_map_fd = bpf_object__find_map_fd_by_name(object, "process_map");
+    REQUIRE(process_map_fd > 0);
+
+    single_instance_hook_t hook(EBPF_PROGRAM_TYPE_BIND, EBPF_ATTACH_TYPE_BIND);
+    REQUIRE(hook.attach_link(program_fd, nullptr, 0, &link) == EBPF_SUCCESS);
+
+    uint64_t fake_pid = 12345;
+    std::function<ebpf_result_t(void*, int*)> invoke =
+        [&hook](_Inout_ void* context, _Out_ int* result) -> ebpf_result_t { return hook.fire(context, result); };
+
+    // Records are only delivered by ring_buffer__poll and ring_buffer__consume, on this thread.
+    ring_buffer_poll_test_context_t context;
+    ring_buffer* ring_buffer = ring_buffer__new(process_map_fd, _ring_buffer_poll_test_handler, &context, nullptr);
+    REQUIRE(ring_buffer != nullptr);
+    REQUIRE(ring_buffer__add(ring_buffer, program_fd, _ring_buffer_poll_test_handler, &context) < 0);
+    REQUIRE(ring_buffer__consume(ring_buffer) == 0);
+    REQUIRE(ring_buffer__poll(ring_buffer, 0) == 0);
+
+    for (int i = 0; i < 4; i++) {
+        REQUIRE(emulate_bind(invoke, fake_pid + i, "fake_app") == BIND_PERMIT);
+    }
+    REQUIRE(context.record_count == 0);
+
+    // The usual libbpf consumer loop, with only the map passed to ring_buffer__new.
+    int iterations = 0;
+    while (context.record_count < 4 && ring_buffer__poll(ring_buffer, 100) >= 0) {
+        REQUIRE(++iterations < 100);
+    }
+    REQUIRE(context.record_count == 4);
+    REQUIRE(context.wrong_thread_count == 0);
+    REQUIRE(ring_buffer__consume(ring_buffer) == 0);
+
+    // A negative callback result stops consumption and is returned; the remaining records are consumed later.
+    REQUIRE(emulate_bind(invoke, fake_pid, "fake_app") == BIND_PERMIT);
+    REQUIRE(emulate_bind(invoke, fake_pid, "fake_app") == BIND_PERMIT);
+    context.fail_next_record = true;
+    REQUIRE(ring_buffer__poll(ring_buffer, 1000) == -1);
+    REQUIRE(ring_buffer__poll(ring_buffer, 1000) == 1);
+    REQUIRE(context.record_count == 6);
+
+    // Maps added with ring_buffer__add are polled along with the map passed to ring_buffer__new.
+    fd_t idle_map_fd = bpf_map_create(BPF_MAP_TYPE_RINGBUF, "idle_map", 0, 0, 64 * 1024, nullptr);
+    REQUIRE(idle_map_fd > 0);
+    REQUIRE(ring_buffer__add(ring_buffer, idle_map_fd, _ring_buffer_ignore_handler, nullptr) == 0);
+    REQUIRE(emulate_bind(invoke, fake_pid, "fake_app") == BIND_PERMIT);
+    REQUIRE(ring_buffer__poll(ring_buffer, 1000) == 1);
+    REQUIRE(context.record_count == 7);
+    REQUIRE(context.wrong_thread_count == 0);
+
+    ring_buffer__free(ring_buffer);
+    Platform::_close(idle_map_fd);
+
+    hook.detach_link(link);
+    hook.close_link(link);
+
+    bpf_object__close(object);
+}
+
 static void
 _utility_helper_functions_test(ebpf_execution_type_t execution_type)
 {
@@ -905,6 +1058,7 @@ DECLARE_ALL_TEST_CASES("divide_by_zero", "[end_to_end]", divide_by_zero_test_um)
 DECLARE_ALL_TEST_CASES("bindmonitor", "[end_to_end]", bindmonitor_test);
 DECLARE_ALL_TEST_CASES("bindmonitor-tailcall", "[end_to_end]", bindmonitor_tailcall_test);
 DECLARE_ALL_TEST_CASES("bindmonitor-ringbuf", "[end_to_end]", bindmonitor_ring_buffer_test);
+DECLARE_ALL_TEST_CASES("bindmonitor-ringbuf-poll", "[end_to_end]", bindmonitor_ring_buffer_poll_test);
 DECLARE_ALL_TEST_CASES("utility-helpers", "[end_to_end]", _utility_helper_functions_test);
 DECLARE_ALL_TEST_CASES("map", "[end_to_end]", map_test);
 DECLARE_ALL_TEST_CASES("bad_map_name", "[end_to_end]", bad_map_name_um);
@@ -1761,6 +1915,216 @@ TEST_CASE("link_tests", "[end_to_end]")
     hook.detach();
 }
 
+static uint32_t
+_get_link_program_id(fd_t link_fd)
+{
+    bpf_link_info link_info;
+    uint32_t info_size = sizeof(link_info);
+    REQUIRE(bpf_obj_get_info_by_fd(link_fd, &link_info, &info_size) == 0);
+    return link_info.prog_id;
+}
+
+static uint32_t
+_get_program_id(fd_t program_fd)
+{
+    bpf_prog_info program_info;
+    uint32_t info_size = sizeof(program_info);
+    REQUIRE(bpf_obj_get_info_by_fd(program_fd, &program_info, &info_size) == 0);
+    return program_info.id;
+}
+
+// Load an XDP program that returns a constant, so that tests can tell which program a hook ran.
+static fd_t
+_load_return_value_program(int32_t return_value)
+{
+    struct ebpf_inst instructions[] = {
+        {0xb7, R0_RETURN_VALUE, 0, 0, return_value}, // r0 = return_value
+        {INST_OP_EXIT},                              // return r0
+    };
+
+    fd_t program_fd = bpf_prog_load(
+        BPF_PROG_TYPE_XDP, "return_value", nullptr, (struct bpf_insn*)instructions, _countof(instructions), nullptr);
+    REQUIRE(program_fd > 0);
+    return program_fd;
+}
+
+TEST_CASE("link_update_tests", "[end_to_end]")
+{
+    _test_helper_end_to_end test_helper;
+    single_instance_hook_t hook(EBPF_PROGRAM_TYPE_XDP, EBPF_ATTACH_TYPE_XDP);
+    program_info_provider_t xdp_program_info(EBPF_PROGRAM_TYPE_XDP);
+    uint32_t ifindex = 0;
+    fd_t first_program_fd = _load_return_value_program(1);
+    fd_t second_program_fd = _load_return_value_program(2);
+    bpf_link* link;
+
+    // Dummy UDP datagram with fake IP and MAC addresses.
+    udp_packet_t packet(AF_INET);
+    packet.set_destination_port(ntohs(REFLECTION_TEST_PORT));
+
+    // Dummy context (not used by the eBPF program).
+    xdp_md_helper_t ctx(packet.packet());
+    int result;
+
+    REQUIRE(hook.attach_link(first_program_fd, &ifindex, sizeof(ifindex), &link) == EBPF_SUCCESS);
+    fd_t link_fd = bpf_link__fd(link);
+    REQUIRE(_get_link_program_id(link_fd) == _get_program_id(first_program_fd));
+    REQUIRE(hook.fire(&ctx, &result) == EBPF_SUCCESS);
+    REQUIRE(result == 1);
+
+    // Replace the program without detaching the link from the hook.
+    REQUIRE(bpf_link_update(link_fd, second_program_fd, nullptr) == 0);
+    REQUIRE(_get_link_program_id(link_fd) == _get_program_id(second_program_fd));
+    REQUIRE(hook.fire(&ctx, &result) == EBPF_SUCCESS);
+    REQUIRE(result == 2);
+
+    // BPF_F_REPLACE fails if the expected program is not the one attached.
+    bpf_link_update_opts opts = {
+        .sz = sizeof(opts), .flags = BPF_F_REPLACE, .old_prog_fd = (uint32_t)first_program_fd};
+    REQUIRE(bpf_link_update(link_fd, first_program_fd, &opts) < 0);
+    REQUIRE(errno == EINVAL);
+    REQUIRE(_get_link_program_id(link_fd) == _get_program_id(second_program_fd));
+    REQUIRE(hook.fire(&ctx, &result) == EBPF_SUCCESS);
+    REQUIRE(result == 2);
+
+    opts.old_prog_fd = second_program_fd;
+    REQUIRE(bpf_link_update(link_fd, first_program_fd, &opts) == 0);
+    REQUIRE(_get_link_program_id(link_fd) == _get_program_id(first_program_fd));
+    REQUIRE(hook.fire(&ctx, &result) == EBPF_SUCCESS);
+    REQUIRE(result == 1);
+
+    // Unsupported flags.
+    opts.flags = BPF_F_REPLACE << 1;
+    REQUIRE(bpf_link_update(link_fd, second_program_fd, &opts) < 0);
+    REQUIRE(errno == EINVAL);
+
+    // A detached link cannot be updated.
+    hook.detach_link(link);
+    REQUIRE(bpf_link_update(link_fd, second_program_fd, nullptr) < 0);
+    REQUIRE(errno == EINVAL);
+    hook.close_link(link);
+
+    Platform::_close(first_program_fd);
+    Platform::_close(second_program_fd);
+}
+
+TEST_CASE("link_update_free_programs", "[end_to_end]")
+{
+    _test_helper_end_to_end test_helper;
+    single_instance_hook_t hook(EBPF_PROGRAM_TYPE_XDP, EBPF_ATTACH_TYPE_XDP);
+    program_info_provider_t xdp_program_info(EBPF_PROGRAM_TYPE_XDP);
+    uint32_t ifindex = 0;
+    fd_t first_program_fd = _load_return_value_program(1);
+    fd_t second_program_fd = _load_return_value_program(2);
+    bpf_link* link;
+
+    // Dummy UDP datagram with fake IP and MAC addresses.
+    udp_packet_t packet(AF_INET);
+    packet.set_destination_port(ntohs(REFLECTION_TEST_PORT));
+
+    // Dummy context (not used by the eBPF program).
+    xdp_md_helper_t ctx(packet.packet());
+    int result;
+
+    REQUIRE(hook.attach_link(first_program_fd, &ifindex, sizeof(ifindex), &link) == EBPF_SUCCESS);
+    fd_t link_fd = bpf_link__fd(link);
+    REQUIRE(bpf_link_update(link_fd, second_program_fd, nullptr) == 0);
+
+    // The old program no longer lists the link, so freeing it leaves the link running the new program.
+    Platform::_close(first_program_fd);
+    REQUIRE(_get_link_program_id(link_fd) == _get_program_id(second_program_fd));
+    REQUIRE(hook.fire(&ctx, &result) == EBPF_SUCCESS);
+    REQUIRE(result == 2);
+
+    hook.detach_link(link);
+    hook.close_link(link);
+
+    // The new program no longer lists the detached link either.
+    Platform::_close(second_program_fd);
+}
+
+TEST_CASE("multi_attach_link_tests", "[end_to_end]")
+{
+    _test_helper_end_to_end test_helper;
+    single_instance_hook_t hook(EBPF_PROGRAM_TYPE_XDP, EBPF_ATTACH_TYPE_XDP);
+    program_info_provider_t xdp_program_info(EBPF_PROGRAM_TYPE_XDP);
+    uint32_t ifindex = 0;
+    fd_t continue_program_fd = _load_return_value_program(0);
+    fd_t low_priority_program_fd = _load_return_value_program(1);
+    fd_t first_program_fd = _load_return_value_program(2);
+    fd_t second_program_fd = _load_return_value_program(3);
+    bpf_link* continue_link;
+    bpf_link* low_priority_link;
+    bpf_link* first_link;
+    bpf_link* second_link;
+    bpf_link* invalid_link;
+
+    // Dummy UDP datagram with fake IP and MAC addresses.
+    udp_packet_t packet(AF_INET);
+    packet.set_destination_port(ntohs(REFLECTION_TEST_PORT));
+
+    // Dummy context (not used by the eBPF program).
+    xdp_md_helper_t ctx(packet.packet());
+    int result;
+
+    // Attach in the reverse of priority order, so that the invocation order can only come from the priority.
+    ebpf_link_multi_attach_options_t options = {10, 0};
+    REQUIRE(
+        hook.attach_link_multi(low_priority_program_fd, &ifindex, sizeof(ifindex), &options, &low_priority_link) ==
+        EBPF_SUCCESS);
+    options.priority = 0;
+    REQUIRE(hook.attach_link_multi(first_program_fd, &ifindex, sizeof(ifindex), &options, &first_link) == EBPF_SUCCESS);
+    options.priority = -10;
+    REQUIRE(
+        hook.attach_link_multi(continue_program_fd, &ifindex, sizeof(ifindex), &options, &continue_link) ==
+        EBPF_SUCCESS);
+
+    // All links on an attach point must agree on the continue verdict.
+    options.continue_verdict = 42;
+    REQUIRE(
+        hook.attach_link_multi(continue_program_fd, &ifindex, sizeof(ifindex), &options, &invalid_link) ==
+        EBPF_INVALID_ARGUMENT);
+    options.continue_verdict = 0;
+
+    // The continue program runs first and lets the next one run, which returns a verdict and stops the chain
+    // before the low priority program.
+    REQUIRE(hook.fire(&ctx, &result) == EBPF_SUCCESS);
+    REQUIRE(result == 2);
+
+    // Links with equal priority run in the order they were attached.
+    options.priority = 0;
+    REQUIRE(
+        hook.attach_link_multi(second_program_fd, &ifindex, sizeof(ifindex), &options, &second_link) == EBPF_SUCCESS);
+    REQUIRE(hook.fire(&ctx, &result) == EBPF_SUCCESS);
+    REQUIRE(result == 2);
+
+    hook.detach_link(first_link);
+    hook.close_link(first_link);
+    REQUIRE(hook.fire(&ctx, &result) == EBPF_SUCCESS);
+    REQUIRE(result == 3);
+
+    hook.detach_link(second_link);
+    hook.close_link(second_link);
+    REQUIRE(hook.fire(&ctx, &result) == EBPF_SUCCESS);
+    REQUIRE(result == 1);
+
+    // When every program returns the continue verdict, the hook returns it too.
+    hook.detach_link(low_priority_link);
+    hook.close_link(low_priority_link);
+    REQUIRE(hook.fire(&ctx, &result) == EBPF_SUCCESS);
+    REQUIRE(result == 0);
+
+    // The attach point stays bound to the provider until the last link is detached.
+    hook.detach_link(continue_link);
+    hook.close_link(continue_link);
+    REQUIRE(hook.fire(&ctx, &result) == EBPF_EXTENSION_FAILED_TO_LOAD);
+
+    Platform::_close(continue_program_fd);
+    Platform::_close(low_priority_program_fd);
+    Platform::_close(first_program_fd);
+    Platform::_close(second_program_fd);
+}
+
 static void
 _map_reuse_test(ebpf_execution_type_t execution_type)
 {
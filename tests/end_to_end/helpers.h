@@ -81,6 +81,18 @@ typedef class _hook_helper
         return ebpf_program_attach_by_fd(program_fd, &_attach_type, attach_parameters, attach_parameters_size, link);
     }
 
+    _Must_inspect_result_ ebpf_result_t
+    attach_link_multi(
+        fd_t program_fd,
+        _In_reads_bytes_opt_(attach_parameters_size) void* attach_parameters,
+        size_t attach_parameters_size,
+        _In_ const ebpf_link_multi_attach_options_t* options,
+        _Outptr_ bpf_link** link)
+    {
+        return ebpf_program_attach_multi_by_fd(
+            program_fd, &_attach_type, attach_parameters, attach_parameters_size, options, link);
+    }
+
   private:
     ebpf_attach_type_t _attach_type;
 } hook_helper_t;
@@ -459,6 +459,11 @@ GlueDeviceIoControl(
     if (user_reply) {
         *bytes_returned = user_reply->length;
     }
+
+    // As with a device opened for overlapped I/O, a request that completes synchronously still signals the event.
+    if (overlapped) {
+        _complete_overlapped(overlapped, *bytes_returned, EBPF_SUCCESS);
+    }
     return TRUE;
 
 Fail:
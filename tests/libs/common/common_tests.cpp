@@ -4,7 +4,6 @@
 // Common test functions used by end to end and component tests.
 
 #include <chrono>
-#include <future>
 #include <map>
 using namespace std::chrono_literals;
 
@@ -102,38 +101,21 @@ verify_utility_helper_results(_In_ const bpf_object* object, bool helper_overrid
 }
 
 ring_buffer_test_event_context_t::_ring_buffer_test_event_context()
-    : ring_buffer(nullptr), records(nullptr), canceled(false), matched_entry_count(0), test_event_count(0)
+    : ring_buffer(nullptr), records(nullptr), matched_entry_count(0), test_event_count(0)
 {}
 ring_buffer_test_event_context_t::~_ring_buffer_test_event_context()
 {
     if (ring_buffer != nullptr)
         ring_buffer__free(ring_buffer);
 }
-void
-ring_buffer_test_event_context_t::unsubscribe()
-{
-    struct ring_buffer* temp = ring_buffer;
-    ring_buffer = nullptr;
-    // Unsubscribe.
-    ring_buffer__free(temp);
-}
 
 int
 ring_buffer_test_event_handler(_Inout_ void* ctx, _In_opt_ const void* data, size_t size)
 {
     ring_buffer_test_event_context_t* event_context = reinterpret_cast<ring_buffer_test_event_context_t*>(ctx);
 
-    if ((data == nullptr) || (size == 0)) {
-        // eBPF ring buffer invokes callback with NULL data indicating that the subscription is canceled.
-        // This is the last callback. Free the callback context.
-        delete event_context;
+    if ((data == nullptr) || (size == 0))
         return 0;
-    }
-
-    if (event_context->canceled)
-        // Ignore the callback as the subscription is canceled.
-        // Return error so that no further callback is made.
-        return -1;
 
     if (event_context->matched_entry_count == event_context->test_event_count)
         // Required number of event notifications already received.
@@ -145,13 +127,22 @@ ring_buffer_test_event_handler(_Inout_ void* ctx, _In_opt_ const void* data, siz
     auto it = std::find(records->begin(), records->end(), event_record);
     if (it != records->end())
         event_context->matched_entry_count++;
-    if (event_context->matched_entry_count == event_context->test_event_count) {
-        // If all the entries in the app ID list was found, fulfill the promise.
-        event_context->ring_buffer_event_promise.set_value();
-    }
     return 0;
 }
 
+bool
+ring_buffer_test_poll_for_events(_Inout_ ring_buffer_test_event_context_t* context, std::chrono::milliseconds timeout)
+{
+    auto deadline = std::chrono::steady_clock::now() + timeout;
+    while (context->matched_entry_count < context->test_event_count && std::chrono::steady_clock::now() < deadline) {
+        // Records are delivered on this thread, by ring_buffer__poll.
+        if (ring_buffer__poll(context->ring_buffer, 100) < 0) {
+            return false;
+        }
+    }
+    return context->matched_entry_count == context->test_event_count;
+}
+
 void
 ring_buffer_api_test_helper(
     fd_t ring_buffer_map, std::vector<std::vector<char>>& expected_records, std::function<void(int)> generate_event)
@@ -162,35 +153,22 @@ ring_buffer_api_test_helper(
 
     context->records = &expected_records;
 
-    // Generate events prior to subscribing for ring buffer events.
+    // Generate events prior to creating the ring buffer manager.
     for (int i = 0; i < RING_BUFFER_TEST_EVENT_COUNT / 2; i++) {
         generate_event(i);
     }
 
-    // Get the std::future from the promise field in ring buffer event context, which should be in ready state
-    // once notifications for all events are received.
-    auto ring_buffer_event_callback = context->ring_buffer_event_promise.get_future();
-
-    // Create a new ring buffer manager and subscribe to ring buffer events.
-    // The notifications for the events that were generated before should occur after the subscribe call.
+    // Create a new ring buffer manager for the ring buffer map.
+    // The events that were generated before are delivered by the first poll, along with the later ones.
     context->ring_buffer = ring_buffer__new(
         ring_buffer_map, (ring_buffer_sample_fn)ring_buffer_test_event_handler, context.get(), nullptr);
     REQUIRE(context->ring_buffer != nullptr);
 
-    // Generate more events, post-subscription.
+    // Generate more events, after the ring buffer manager is created.
     for (int i = RING_BUFFER_TEST_EVENT_COUNT / 2; i < RING_BUFFER_TEST_EVENT_COUNT; i++) {
         generate_event(i);
     }
 
-    // Wait for event handler getting notifications for all RING_BUFFER_TEST_EVENT_COUNT events.
-    REQUIRE(ring_buffer_event_callback.wait_for(1s) == std::future_status::ready);
-
-    // Mark the event context as canceled, such that the event callback stops processing events.
-    context->canceled = true;
-
-    // Release the raw pointer such that the final callback frees the callback context.
-    ring_buffer_test_event_context_t* raw_context = context.release();
-
-    // Unsubscribe.
-    raw_context->unsubscribe();
+    // Poll until the event handler has seen all RING_BUFFER_TEST_EVENT_COUNT events.
+    REQUIRE(ring_buffer_test_poll_for_events(context.get(), 1s));
 }
\ No newline at end of file
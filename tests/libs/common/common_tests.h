@@ -4,7 +4,8 @@
 // Common test functions used by end to end and component tests.
 
 #pragma once
-#include <future>
+#include <chrono>
+#include <functional>
 #include <windows.h>
 
 #include "bpf/bpf.h"
@@ -24,12 +25,8 @@ typedef struct _ring_buffer_test_event_context
 {
     _ring_buffer_test_event_context();
     ~_ring_buffer_test_event_context();
-    void
-    unsubscribe();
-    std::promise<void> ring_buffer_event_promise;
     struct ring_buffer* ring_buffer;
     std::vector<std::vector<char>>* records;
-    bool canceled;
     int matched_entry_count;
     int test_event_count;
 } ring_buffer_test_event_context_t;
@@ -37,6 +34,11 @@ typedef struct _ring_buffer_test_event_context
 int
 ring_buffer_test_event_handler(_Inout_ void* ctx, _In_opt_ const void* data, size_t size);
 
+// Run the usual libbpf consumer loop on the context's ring buffer until every expected record has been seen, the
+// timeout expires, or ring_buffer__poll fails. Returns true if every expected record was seen.
+bool
+ring_buffer_test_poll_for_events(_Inout_ ring_buffer_test_event_context_t* context, std::chrono::milliseconds timeout);
+
 void
 ring_buffer_api_test_helper(
     fd_t ring_buffer_map, std::vector<std::vector<char>>& expected_records, std::function<void(int)> generate_event);
\ No newline at end of file
@@ -6,6 +6,7 @@
 #include <numeric>
 #include <optional>
 
+#include "ebpf_handle.h"
 #include "performance.h"
 
 extern "C"
@@ -71,6 +72,18 @@ typedef class _ebpf_program_test_state
                 byte_code.size() * sizeof(ebpf_instruction_t)) == EBPF_SUCCESS);
     }
 
+    void
+    prepare_threaded_program()
+    {
+        REQUIRE(
+            ebpf_program_load_code(
+                program,
+                EBPF_CODE_EBPF_THREADED,
+                nullptr,
+                reinterpret_cast<uint8_t*>(byte_code.data()),
+                byte_code.size() * sizeof(ebpf_instruction_t)) == EBPF_SUCCESS);
+    }
+
     void
     test(void* context)
     {
@@ -264,9 +277,120 @@ typedef class _ebpf_map_lpm_trie_test_state
     std::vector<std::pair<uint32_t, uint32_t>> ipv4_routes;
 } ebpf_map_lpm_trie_test_state_t;
 
+#define MAP_QUEUE_BATCH_SIZE 64
+#define MAP_QUEUE_SLOT_SIZE (sizeof(uint32_t) + sizeof(uint64_t))
+
+// Updates MAP_QUEUE_BATCH_SIZE hash map entries per iteration, either with one protocol call per update or with a
+// single call that processes a map queue.
+typedef class _ebpf_map_queue_test_state
+{
+  public:
+    _ebpf_map_queue_test_state() : queues(ebpf_get_cpu_count())
+    {
+        ebpf_utf8_string_t name{(uint8_t*)"test", 4};
+        REQUIRE(ebpf_core_initiate() == EBPF_SUCCESS);
+        ebpf_map_definition_in_memory_t definition{
+            BPF_MAP_TYPE_HASH,
+            sizeof(uint32_t),
+            sizeof(uint64_t),
+            static_cast<uint32_t>(queues.size()) * MAP_QUEUE_BATCH_SIZE};
+        REQUIRE(ebpf_core_create_map(&name, &definition, ebpf_handle_invalid, &map_handle) == EBPF_SUCCESS);
+
+        // Each CPU has its own queue, as a map queue must not be used by more than one thread at a time.
+        for (auto& queue : queues) {
+            ebpf_operation_create_map_queue_request_t request{
+                sizeof(request), EBPF_OPERATION_CREATE_MAP_QUEUE, MAP_QUEUE_BATCH_SIZE, MAP_QUEUE_SLOT_SIZE};
+            ebpf_operation_create_map_queue_reply_t reply;
+            REQUIRE(
+                ebpf_core_invoke_protocol_handler(
+                    EBPF_OPERATION_CREATE_MAP_QUEUE,
+                    &request,
+                    sizeof(request),
+                    &reply,
+                    sizeof(reply),
+                    nullptr,
+                    nullptr) == EBPF_SUCCESS);
+            queue.handle = reply.queue_handle;
+            queue.header = reinterpret_cast<ebpf_map_queue_header_t*>(reply.buffer_address);
+            queue.submissions = reinterpret_cast<ebpf_map_queue_submission_t*>(queue.header + 1);
+            queue.slots = reinterpret_cast<uint8_t*>(
+                reinterpret_cast<ebpf_map_queue_completion_entry_t*>(queue.submissions + MAP_QUEUE_BATCH_SIZE) +
+                MAP_QUEUE_BATCH_SIZE);
+        }
+    }
+    ~_ebpf_map_queue_test_state()
+    {
+        for (auto& queue : queues) {
+            (void)ebpf_handle_close(queue.handle);
+        }
+        (void)ebpf_handle_close(map_handle);
+        ebpf_core_terminate();
+    }
+
+    void
+    test_update_ioctl(uint32_t cpu_id)
+    {
+        union
+        {
+            ebpf_operation_map_update_element_request_t request;
+            uint8_t buffer[offsetof(ebpf_operation_map_update_element_request_t, data) + MAP_QUEUE_SLOT_SIZE];
+        } update;
+        update.request.header = {sizeof(update.buffer), EBPF_OPERATION_MAP_UPDATE_ELEMENT};
+        update.request.handle = map_handle;
+        update.request.option = EBPF_ANY;
+
+        for (uint32_t index = 0; index < MAP_QUEUE_BATCH_SIZE; index++) {
+            uint32_t key = cpu_id * MAP_QUEUE_BATCH_SIZE + index;
+            uint64_t value = index;
+            memcpy(update.request.data, &key, sizeof(key));
+            memcpy(update.request.data + sizeof(key), &value, sizeof(value));
+            (void)ebpf_core_invoke_protocol_handler(
+                EBPF_OPERATION_MAP_UPDATE_ELEMENT, &update, sizeof(update.buffer), nullptr, 0, nullptr, nullptr);
+        }
+    }
+
+    void
+    test_update_queue(uint32_t cpu_id)
+    {
+        per_cpu_queue_t& queue = queues[cpu_id];
+        uint32_t tail = queue.header->submission_tail;
+        for (uint32_t index = 0; index < MAP_QUEUE_BATCH_SIZE; index++) {
+            uint32_t key = cpu_id * MAP_QUEUE_BATCH_SIZE + index;
+            uint64_t value = index;
+            uint8_t* slot = queue.slots + (size_t)index * MAP_QUEUE_SLOT_SIZE;
+            memcpy(slot, &key, sizeof(key));
+            memcpy(slot + sizeof(key), &value, sizeof(value));
+            queue.submissions[index] = {index, map_handle, EBPF_MAP_QUEUE_OPERATION_UPDATE, EBPF_ANY};
+        }
+        queue.header->submission_tail = tail + MAP_QUEUE_BATCH_SIZE;
+
+        ebpf_operation_submit_map_queue_request_t request{
+            sizeof(request), EBPF_OPERATION_SUBMIT_MAP_QUEUE, queue.handle};
+        ebpf_operation_submit_map_queue_reply_t reply;
+        (void)ebpf_core_invoke_protocol_handler(
+            EBPF_OPERATION_SUBMIT_MAP_QUEUE, &request, sizeof(request), &reply, sizeof(reply), nullptr, nullptr);
+
+        // Reap all the completions.
+        queue.header->completion_head = queue.header->completion_tail;
+    }
+
+  private:
+    typedef struct _per_cpu_queue
+    {
+        ebpf_handle_t handle;
+        ebpf_map_queue_header_t* header;
+        ebpf_map_queue_submission_t* submissions;
+        uint8_t* slots;
+    } per_cpu_queue_t;
+
+    ebpf_handle_t map_handle;
+    std::vector<per_cpu_queue_t> queues;
+} ebpf_map_queue_test_state_t;
+
 static ebpf_program_test_state_t* _ebpf_program_test_state_instance = nullptr;
 static ebpf_map_test_state_t* _ebpf_map_test_state_instance = nullptr;
 static ebpf_map_lpm_trie_test_state_t* _ebpf_map_lpm_trie_test_state_instance = nullptr;
+static ebpf_map_queue_test_state_t* _ebpf_map_queue_test_state_instance = nullptr;
 
 static void
 _ebpf_program_invoke()
@@ -304,6 +428,18 @@ _map_lookup_lru_test(uint32_t cpu_id)
     _ebpf_map_test_state_instance->test_rolling_update_lru(cpu_id);
 }
 
+static void
+_map_update_ioctl_test(uint32_t cpu_id)
+{
+    _ebpf_map_queue_test_state_instance->test_update_ioctl(cpu_id);
+}
+
+static void
+_map_update_queue_test(uint32_t cpu_id)
+{
+    _ebpf_map_queue_test_state_instance->test_update_queue(cpu_id);
+}
+
 static void
 _lpm_trie_ipv4_find()
 {
@@ -443,6 +579,87 @@ test_program_invoke_interpret(bool preemptible)
     measure.run_test();
 }
 
+void
+test_program_invoke_interpret_threaded(bool preemptible)
+{
+    size_t iterations = PERFORMANCE_MEASURE_ITERATION_COUNT * 10;
+    std::vector<ebpf_instruction_t> byte_code = {{EBPF_OP_MOV_IMM, 0, 0, 0, 42}, {EBPF_OP_EXIT}};
+    _ebpf_program_test_state program_state(byte_code);
+    _ebpf_program_test_state_instance = &program_state;
+    program_state.prepare_threaded_program();
+
+    _performance_measure measure(__FUNCTION__, preemptible, _ebpf_program_invoke, iterations);
+    measure.run_test();
+}
+
+// Sum 64..1 in a loop, so that dispatch overhead per instruction dominates the
+// fixed cost of invoking the program.
+static const std::vector<ebpf_instruction_t> _loop_byte_code = {
+    {EBPF_OP_MOV64_IMM, 0, 0, 0, 0},
+    {EBPF_OP_MOV64_IMM, 1, 0, 0, 64},
+    {EBPF_OP_ADD64_REG, 0, 1, 0, 0},
+    {EBPF_OP_SUB64_IMM, 1, 0, 0, 1},
+    {EBPF_OP_JNE_IMM, 1, 0, -3, 0},
+    {EBPF_OP_EXIT}};
+
+void
+test_program_invoke_loop_jit(bool preemptible)
+{
+    size_t iterations = PERFORMANCE_MEASURE_ITERATION_COUNT;
+    _ebpf_program_test_state program_state(_loop_byte_code);
+    _ebpf_program_test_state_instance = &program_state;
+    program_state.prepare_jit_program();
+
+    _performance_measure measure(__FUNCTION__, preemptible, _ebpf_program_invoke, iterations);
+    measure.run_test();
+}
+
+void
+test_program_invoke_loop_interpret(bool preemptible)
+{
+    size_t iterations = PERFORMANCE_MEASURE_ITERATION_COUNT;
+    _ebpf_program_test_state program_state(_loop_byte_code);
+    _ebpf_program_test_state_instance = &program_state;
+    program_state.prepare_interpret_program();
+
+    _performance_measure measure(__FUNCTION__, preemptible, _ebpf_program_invoke, iterations);
+    measure.run_test();
+}
+
+void
+test_program_invoke_loop_interpret_threaded(bool preemptible)
+{
+    size_t iterations = PERFORMANCE_MEASURE_ITERATION_COUNT;
+    _ebpf_program_test_state program_state(_loop_byte_code);
+    _ebpf_program_test_state_instance = &program_state;
+    program_state.prepare_threaded_program();
+
+    _performance_measure measure(__FUNCTION__, preemptible, _ebpf_program_invoke, iterations);
+    measure.run_test();
+}
+
+void
+test_map_update_ioctl(bool preemptible)
+{
+    size_t iterations = PERFORMANCE_MEASURE_ITERATION_COUNT / MAP_QUEUE_BATCH_SIZE;
+    ebpf_map_queue_test_state_t map_queue_state;
+    _ebpf_map_queue_test_state_instance = &map_queue_state;
+
+    _performance_measure measure(__FUNCTION__, preemptible, _map_update_ioctl_test, iterations);
+    measure.run_test();
+}
+
+void
+test_map_update_queue(bool preemptible)
+{
+    size_t iterations = PERFORMANCE_MEASURE_ITERATION_COUNT / MAP_QUEUE_BATCH_SIZE;
+    ebpf_map_queue_test_state_t map_queue_state;
+    _ebpf_map_queue_test_state_instance = &map_queue_state;
+
+    _performance_measure measure(__FUNCTION__, preemptible, _map_update_queue_test, iterations);
+    measure.run_test();
+}
+
 template <size_t route_count>
 void
 test_lpm_trie_ipv4(bool preemptible)
@@ -462,6 +679,10 @@ test_lpm_trie_ipv4(bool preemptible)
 
 PERF_TEST(test_program_invoke_jit);
 PERF_TEST(test_program_invoke_interpret);
+PERF_TEST(test_program_invoke_interpret_threaded);
+PERF_TEST(test_program_invoke_loop_jit);
+PERF_TEST(test_program_invoke_loop_interpret);
+PERF_TEST(test_program_invoke_loop_interpret_threaded);
 
 PERF_TEST(test_bpf_map_lookup_elem_read<BPF_MAP_TYPE_HASH>);
 PERF_TEST(test_bpf_map_lookup_elem_read<BPF_MAP_TYPE_ARRAY>);
@@ -484,6 +705,9 @@ PERF_TEST(test_bpf_map_update_elem<BPF_MAP_TYPE_LRU_HASH>);
 PERF_TEST(test_bpf_map_update_lru_elem<BPF_MAP_TYPE_LRU_HASH>);
 PERF_TEST(test_bpf_map_lookup_lru_elem<BPF_MAP_TYPE_LRU_HASH>);
 
+PERF_TEST(test_map_update_ioctl);
+PERF_TEST(test_map_update_queue);
+
 PERF_TEST(test_lpm_trie_ipv4<1024>);
 PERF_TEST(test_lpm_trie_ipv4<1024 * 16>);
 PERF_TEST(test_lpm_trie_ipv4<1024 * 256>);
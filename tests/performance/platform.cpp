@@ -62,6 +62,89 @@ _perf_bpf_get_smp_processor_id()
     ebpf_epoch_exit();
 }
 
+static void
+_perf_object_free(_In_ _Post_invalid_ ebpf_core_object_t* object)
+{
+    ebpf_epoch_free(object);
+}
+
+static void
+_perf_object_create_destroy()
+{
+    REQUIRE(ebpf_epoch_enter() == EBPF_SUCCESS);
+    ebpf_core_object_t* object = reinterpret_cast<ebpf_core_object_t*>(ebpf_epoch_allocate(sizeof(ebpf_core_object_t)));
+    if (object != NULL) {
+        if (ebpf_object_initialize(object, EBPF_OBJECT_MAP, _perf_object_free, NULL) == EBPF_SUCCESS) {
+            ebpf_object_release_reference(object);
+        } else {
+            ebpf_epoch_free(object);
+        }
+    }
+    ebpf_epoch_exit();
+}
+
+/**
+ * @brief Helper function to populate the ID table with live objects.
+ * All tests perform the operation under test multiplier() times.
+ */
+typedef class _ebpf_object_id_test_state
+{
+  public:
+    _ebpf_object_id_test_state(size_t object_count)
+    {
+        REQUIRE(ebpf_core_initiate() == EBPF_SUCCESS);
+        objects.resize(object_count);
+        REQUIRE(ebpf_epoch_enter() == EBPF_SUCCESS);
+        for (auto& object : objects) {
+            object = reinterpret_cast<ebpf_core_object_t*>(ebpf_epoch_allocate(sizeof(ebpf_core_object_t)));
+            REQUIRE(object != nullptr);
+            REQUIRE(ebpf_object_initialize(object, EBPF_OBJECT_MAP, _perf_object_free, NULL) == EBPF_SUCCESS);
+        }
+        ebpf_epoch_exit();
+    }
+    ~_ebpf_object_id_test_state()
+    {
+        REQUIRE(ebpf_epoch_enter() == EBPF_SUCCESS);
+        for (auto& object : objects) {
+            ebpf_object_release_reference(object);
+        }
+        ebpf_epoch_exit();
+        ebpf_core_terminate();
+    }
+
+    void
+    test_reference_by_id(uint32_t current_cpu)
+    {
+        // Look up a disjoint stride of the objects on each CPU.
+        uint32_t cpu_count = ebpf_get_cpu_count();
+        REQUIRE(ebpf_epoch_enter() == EBPF_SUCCESS);
+        for (size_t index = current_cpu; index < objects.size(); index += cpu_count) {
+            ebpf_core_object_t* object;
+            if (ebpf_object_reference_by_id(objects[index]->id, EBPF_OBJECT_MAP, &object) == EBPF_SUCCESS) {
+                ebpf_object_release_reference(object);
+            }
+        }
+        ebpf_epoch_exit();
+    }
+
+    size_t
+    multiplier()
+    {
+        return objects.size() / ebpf_get_cpu_count();
+    }
+
+  private:
+    std::vector<ebpf_core_object_t*> objects;
+} ebpf_object_id_test_state_t;
+
+static ebpf_object_id_test_state_t* _ebpf_object_id_test_state_instance = nullptr;
+
+static void
+_ebpf_object_id_test_reference_by_id(uint32_t current_cpu)
+{
+    _ebpf_object_id_test_state_instance->test_reference_by_id(current_cpu);
+}
+
 /**
  * @brief Helper function to set up the hash-table for testing.
  * All tests perform the operation under test multiplier() times.
@@ -313,12 +396,36 @@ test_ebpf_hash_table_update_overlapping(bool preemptible)
     measure.run_test(instance.multiplier());
 }
 
+void
+test_ebpf_object_create_destroy(bool preemptible)
+{
+    REQUIRE(ebpf_core_initiate() == EBPF_SUCCESS);
+    // Each CPU creates and destroys 100K objects.
+    size_t iterations = 100000;
+    _performance_measure measure(__FUNCTION__, preemptible, _perf_object_create_destroy, iterations);
+    measure.run_test();
+    ebpf_core_terminate();
+}
+
+void
+test_ebpf_object_reference_by_id(bool preemptible)
+{
+    // Look up IDs while 100K objects are alive.
+    _ebpf_object_id_test_state instance(100000);
+    _ebpf_object_id_test_state_instance = &instance;
+    _performance_measure measure(
+        __FUNCTION__, preemptible, _ebpf_object_id_test_reference_by_id, PERFORMANCE_MEASURE_ITERATION_COUNT / 1000);
+    measure.run_test(instance.multiplier());
+}
+
 PERF_TEST(test_epoch_enter_exit);
 PERF_TEST(test_epoch_enter_exit_alloc_free);
 PERF_TEST(test_ebpf_hash_table_find);
 PERF_TEST(test_ebpf_hash_table_next_key);
 PERF_TEST(test_ebpf_hash_table_update);
 PERF_TEST(test_ebpf_hash_table_update_overlapping);
+PERF_TEST(test_ebpf_object_create_destroy);
+PERF_TEST(test_ebpf_object_reference_by_id);
 
 PERF_TEST(test_bpf_get_prandom_u32);
 PERF_TEST(test_bpf_ktime_get_boot_ns);
@@ -0,0 +1,28 @@
+// Copyright (c) Microsoft Corporation
+// SPDX-License-Identifier: MIT
+
+// The verifier can't check bpf_loop callbacks yet, so this program is only
+// converted to a native program with verification skipped.
+
+#include "bpf_helpers.h"
+
+static long
+count_iteration(uint32_t index, void* context)
+{
+    uint32_t* count = (uint32_t*)context;
+    *count += 1;
+
+    // End the loop on the fourth call.
+    return (index == 3) ? 1 : 0;
+}
+
+SEC("xdp")
+int
+bpf_loop_test(xdp_md_t* ctx)
+{
+    uint32_t count = 0;
+    long calls = bpf_loop(10, (void*)count_iteration, &count, 0);
+
+    // The loop makes four calls, and counts the call that ended it.
+    return (calls == count) ? (int)count : -1;
+}
@@ -6,7 +6,6 @@
 #define CATCH_CONFIG_RUNNER
 
 #include <chrono>
-#include <future>
 using namespace std::chrono_literals;
 
 #include "bpf/bpf.h"
@@ -305,11 +304,7 @@ connection_monitor_test(
 
     context->records = &audit_entry_list;
 
-    // Get the std::future from the promise field in ring buffer event context, which should be in ready state
-    // once notifications for all events are received.
-    auto ring_buffer_event_callback = context->ring_buffer_event_promise.get_future();
-
-    // Create a new ring buffer manager and subscribe to ring buffer events.
+    // Create a new ring buffer manager for the audit map.
     bpf_map* ring_buffer_map = bpf_object__find_map_by_name(object, "audit_map");
     REQUIRE(ring_buffer_map != nullptr);
     context->ring_buffer = ring_buffer__new(
@@ -346,17 +341,9 @@ connection_monitor_test(
         receiver_socket.close();
     }
 
-    // Wait for event handler getting notifications for all connection audit events.
-    REQUIRE(ring_buffer_event_callback.wait_for(1s) == std::future_status::ready);
-
-    // Mark the event context as canceled, such that the event callback stops processing events.
-    context->canceled = true;
-
-    // Release the raw pointer such that the final callback frees the callback context.
-    ring_buffer_test_event_context_t* raw_context = context.release();
-
-    // Unsubscribe.
-    raw_context->unsubscribe();
+    // Poll until the event handler has seen all connection audit events.
+    REQUIRE(ring_buffer_test_poll_for_events(context.get(), 1s));
+    context.reset();
 
     bpf_object__close(object);
 }
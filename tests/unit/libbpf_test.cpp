@@ -1,5 +1,6 @@
 // Copyright (c) Microsoft Corporation
 // SPDX-License-Identifier: MIT
+#include <chrono>
 #include <io.h>
 #include <WinSock2.h>
 
@@ -1493,6 +1494,23 @@ _enumerate_program_ids_test(ebpf_execution_type_t execution_type)
     REQUIRE(bpf_prog_get_next_id(id2, &id3) < 0);
     REQUIRE(errno == ENOENT);
 
+    // Enumerate the program information in one call.
+    struct bpf_prog_info infos[3];
+    uint32_t info_count = _countof(infos);
+    REQUIRE(ebpf_get_next_program_info(0, infos, &info_count) == EBPF_SUCCESS);
+    REQUIRE(info_count == 2);
+    REQUIRE(infos[0].id == id1);
+    REQUIRE(infos[1].id == id2);
+
+    // Enumerate one program at a time.
+    info_count = 1;
+    REQUIRE(ebpf_get_next_program_info(id1, infos, &info_count) == EBPF_SUCCESS);
+    REQUIRE(info_count == 1);
+    REQUIRE(infos[0].id == id2);
+
+    info_count = _countof(infos);
+    REQUIRE(ebpf_get_next_program_info(id2, infos, &info_count) == EBPF_NO_MORE_KEYS);
+
     bpf_object__close(xdp_object);
 }
 
@@ -1765,6 +1783,242 @@ TEST_CASE("create map with name", "[libbpf]")
     Platform::_close(map_fd);
 }
 
+TEST_CASE("map queue", "[libbpf]")
+{
+    _test_helper_end_to_end test_helper;
+
+    int map_fd = bpf_map_create(BPF_MAP_TYPE_HASH, nullptr, sizeof(uint32_t), sizeof(uint64_t), 64, nullptr);
+    REQUIRE(map_fd > 0);
+
+    ebpf_map_queue_t* queue;
+    REQUIRE(ebpf_map_queue_create(3, 16, &queue) == EBPF_INVALID_ARGUMENT);
+    REQUIRE(ebpf_map_queue_create(8, 16, &queue) == EBPF_SUCCESS);
+
+    // Fill the queue with updates.
+    uint32_t key;
+    uint64_t value;
+    for (key = 0; key < 8; key++) {
+        value = key * 10;
+        REQUIRE(
+            ebpf_map_queue_post(queue, EBPF_MAP_QUEUE_OPERATION_UPDATE, map_fd, &key, &value, EBPF_ANY, key) ==
+            EBPF_SUCCESS);
+    }
+    REQUIRE(
+        ebpf_map_queue_post(queue, EBPF_MAP_QUEUE_OPERATION_UPDATE, map_fd, &key, &value, EBPF_ANY, key) ==
+        EBPF_OUT_OF_SPACE);
+
+    uint32_t completed_count;
+    REQUIRE(ebpf_map_queue_submit(queue, &completed_count) == EBPF_SUCCESS);
+    REQUIRE(completed_count == 8);
+
+    ebpf_map_queue_completion_t completions[8];
+    uint32_t reaped_count;
+    ebpf_map_queue_reap(queue, completions, _countof(completions), &reaped_count);
+    REQUIRE(reaped_count == 8);
+    for (uint32_t index = 0; index < reaped_count; index++) {
+        REQUIRE(completions[index].user_data == index);
+        REQUIRE(completions[index].result == EBPF_SUCCESS);
+    }
+
+    key = 3;
+    REQUIRE(bpf_map_lookup_elem(map_fd, &key, &value) == 0);
+    REQUIRE(value == 30);
+
+    // Values found are copied when the completions are reaped.
+    uint64_t found_values[2] = {};
+    key = 5;
+    REQUIRE(
+        ebpf_map_queue_post(queue, EBPF_MAP_QUEUE_OPERATION_FIND, map_fd, &key, &found_values[0], 0, 0) ==
+        EBPF_SUCCESS);
+    REQUIRE(ebpf_map_queue_post(queue, EBPF_MAP_QUEUE_OPERATION_DELETE, map_fd, &key, nullptr, 0, 1) == EBPF_SUCCESS);
+    REQUIRE(
+        ebpf_map_queue_post(queue, EBPF_MAP_QUEUE_OPERATION_FIND, map_fd, &key, &found_values[1], 0, 2) ==
+        EBPF_SUCCESS);
+    REQUIRE(ebpf_map_queue_submit(queue, &completed_count) == EBPF_SUCCESS);
+    REQUIRE(completed_count == 3);
+
+    ebpf_map_queue_reap(queue, completions, _countof(completions), &reaped_count);
+    REQUIRE(reaped_count == 3);
+    REQUIRE(completions[0].result == EBPF_SUCCESS);
+    REQUIRE(found_values[0] == 50);
+    REQUIRE(completions[1].result == EBPF_SUCCESS);
+    REQUIRE(completions[2].user_data == 2);
+    REQUIRE(completions[2].result != EBPF_SUCCESS);
+    REQUIRE(found_values[1] == 0);
+    REQUIRE(bpf_map_lookup_elem(map_fd, &key, &value) < 0);
+
+    ebpf_map_queue_destroy(queue);
+    Platform::_close(map_fd);
+}
+
+typedef struct _map_async_test_context
+{
+    volatile long remaining;
+    volatile long failures;
+    ebpf_result_t expected_result;
+    HANDLE done;
+} map_async_test_context_t;
+
+static void
+_map_async_test_completion(_Inout_opt_ void* context, ebpf_result_t result)
+{
+    auto test_context = reinterpret_cast<map_async_test_context_t*>(context);
+    if (result != test_context->expected_result) {
+        InterlockedIncrement(&test_context->failures);
+    }
+    if (InterlockedDecrement(&test_context->remaining) == 0) {
+        SetEvent(test_context->done);
+    }
+}
+
+TEST_CASE("map async operations", "[libbpf]")
+{
+    _test_helper_end_to_end test_helper;
+    const uint32_t count = 16;
+    uint32_t keys[count];
+    uint64_t values[count];
+    map_async_test_context_t context = {count, 0, EBPF_SUCCESS, CreateEvent(nullptr, FALSE, FALSE, nullptr)};
+    REQUIRE(context.done != nullptr);
+
+    int map_fd = bpf_map_create(BPF_MAP_TYPE_HASH, nullptr, sizeof(uint32_t), sizeof(uint64_t), count, nullptr);
+    REQUIRE(map_fd > 0);
+
+    REQUIRE(
+        ebpf_map_update_element_async(map_fd, &keys[0], &values[0], EBPF_ANY, nullptr, &context) ==
+        EBPF_INVALID_ARGUMENT);
+    REQUIRE(
+        ebpf_map_lookup_element_async(map_fd, nullptr, &values[0], _map_async_test_completion, &context) ==
+        EBPF_INVALID_ARGUMENT);
+
+    // Pipeline all the updates before waiting for any of them.
+    for (uint32_t i = 0; i < count; i++) {
+        keys[i] = i;
+        values[i] = i * 100ull;
+        REQUIRE(
+            ebpf_map_update_element_async(
+                map_fd, &keys[i], &values[i], EBPF_ANY, _map_async_test_completion, &context) == EBPF_SUCCESS);
+    }
+    REQUIRE(WaitForSingleObject(context.done, INFINITE) == WAIT_OBJECT_0);
+    REQUIRE(context.failures == 0);
+
+    context.remaining = count;
+    for (uint32_t i = 0; i < count; i++) {
+        values[i] = 0;
+        REQUIRE(
+            ebpf_map_lookup_element_async(map_fd, &keys[i], &values[i], _map_async_test_completion, &context) ==
+            EBPF_SUCCESS);
+    }
+    REQUIRE(WaitForSingleObject(context.done, INFINITE) == WAIT_OBJECT_0);
+    REQUIRE(context.failures == 0);
+    for (uint32_t i = 0; i < count; i++) {
+        REQUIRE(values[i] == i * 100ull);
+    }
+
+    context.remaining = count;
+    for (uint32_t i = 0; i < count; i++) {
+        REQUIRE(ebpf_map_delete_element_async(map_fd, &keys[i], _map_async_test_completion, &context) == EBPF_SUCCESS);
+    }
+    REQUIRE(WaitForSingleObject(context.done, INFINITE) == WAIT_OBJECT_0);
+    REQUIRE(context.failures == 0);
+
+    // Failures are reported through the completion callback.
+    context.remaining = 1;
+    context.expected_result = EBPF_KEY_NOT_FOUND;
+    REQUIRE(
+        ebpf_map_lookup_element_async(map_fd, &keys[0], &values[0], _map_async_test_completion, &context) ==
+        EBPF_SUCCESS);
+    REQUIRE(WaitForSingleObject(context.done, INFINITE) == WAIT_OBJECT_0);
+    REQUIRE(context.failures == 0);
+
+    Platform::_close(map_fd);
+    CloseHandle(context.done);
+}
+
+TEST_CASE("map element operations after fd reuse", "[libbpf]")
+{
+    _test_helper_end_to_end test_helper;
+
+    // Warm the per-thread map property cache for the first map's fd.
+    int map_fd = bpf_map_create(BPF_MAP_TYPE_HASH, nullptr, sizeof(uint32_t), sizeof(uint32_t), 4, nullptr);
+    REQUIRE(map_fd > 0);
+    uint32_t small_key = 1;
+    uint32_t small_value = 2;
+    REQUIRE(bpf_map_update_elem(map_fd, &small_key, &small_value, 0) == 0);
+    REQUIRE(bpf_map_lookup_elem(map_fd, &small_key, &small_value) == 0);
+    REQUIRE(small_value == 2);
+    Platform::_close(map_fd);
+
+    // The fd (and possibly the handle) is reused for a map with different key and value sizes.
+    int new_map_fd = bpf_map_create(BPF_MAP_TYPE_HASH, nullptr, sizeof(uint64_t), sizeof(uint64_t) * 2, 4, nullptr);
+    REQUIRE(new_map_fd > 0);
+    uint64_t key = 3;
+    uint64_t value[2] = {4, 5};
+    REQUIRE(bpf_map_update_elem(new_map_fd, &key, value, 0) == 0);
+    value[0] = value[1] = 0;
+    REQUIRE(bpf_map_lookup_elem(new_map_fd, &key, value) == 0);
+    REQUIRE(value[0] == 4);
+    REQUIRE(value[1] == 5);
+    uint64_t next_key;
+    REQUIRE(bpf_map_get_next_key(new_map_fd, nullptr, &next_key) == 0);
+    REQUIRE(next_key == key);
+    REQUIRE(bpf_map_delete_elem(new_map_fd, &key) == 0);
+    REQUIRE(bpf_map_lookup_elem(new_map_fd, &key, value) < 0);
+    REQUIRE(errno == ENOENT);
+
+    Platform::_close(new_map_fd);
+}
+
+TEST_CASE("map element operations after fd reuse with swapped sizes", "[libbpf]")
+{
+    _test_helper_end_to_end test_helper;
+
+    // Warm the per-thread map property cache with a 4-byte key and an 8-byte value.
+    int map_fd = bpf_map_create(BPF_MAP_TYPE_HASH, nullptr, sizeof(uint32_t), sizeof(uint64_t), 4, nullptr);
+    REQUIRE(map_fd > 0);
+    uint32_t small_key = 1;
+    uint64_t large_value = 2;
+    REQUIRE(bpf_map_update_elem(map_fd, &small_key, &large_value, 0) == 0);
+    Platform::_close(map_fd);
+
+    // A map with the sizes swapped has the same request length, so stale sizes would not be rejected.
+    int new_map_fd = bpf_map_create(BPF_MAP_TYPE_HASH, nullptr, sizeof(uint64_t), sizeof(uint32_t), 4, nullptr);
+    REQUIRE(new_map_fd > 0);
+    uint64_t key = 0x0102030405060708;
+    uint32_t value = 9;
+    REQUIRE(bpf_map_update_elem(new_map_fd, &key, &value, 0) == 0);
+    uint64_t next_key = 0;
+    REQUIRE(bpf_map_get_next_key(new_map_fd, nullptr, &next_key) == 0);
+    REQUIRE(next_key == key);
+    value = 0;
+    REQUIRE(bpf_map_lookup_elem(new_map_fd, &key, &value) == 0);
+    REQUIRE(value == 9);
+
+    Platform::_close(new_map_fd);
+}
+
+// Measures the rate of steady-state map lookups from user mode. Run explicitly with the [performance] tag.
+TEST_CASE("map lookup rate", "[libbpf][.][performance]")
+{
+    _test_helper_end_to_end test_helper;
+    const uint32_t lookup_count = 1000000;
+
+    int map_fd = bpf_map_create(BPF_MAP_TYPE_ARRAY, nullptr, sizeof(uint32_t), sizeof(uint64_t), 1, nullptr);
+    REQUIRE(map_fd > 0);
+
+    uint32_t key = 0;
+    uint64_t value = 0;
+    REQUIRE(bpf_map_lookup_elem(map_fd, &key, &value) == 0);
+
+    auto start = std::chrono::steady_clock::now();
+    for (uint32_t i = 0; i < lookup_count; i++) {
+        (void)bpf_map_lookup_elem(map_fd, &key, &value);
+    }
+    std::chrono::duration<double> elapsed = std::chrono::steady_clock::now() - start;
+    printf("map lookup rate,%.0f lookups/second\n", lookup_count / elapsed.count());
+
+    Platform::_close(map_fd);
+}
+
 TEST_CASE("enumerate map IDs", "[libbpf]")
 {
     _test_helper_end_to_end test_helper;
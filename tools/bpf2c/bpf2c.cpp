@@ -1,13 +1,18 @@
 // Copyright (c) Microsoft Corporation
 // SPDX-License-Identifier: MIT
 #include <Windows.h>
+#include <algorithm>
+#include <atomic>
+#include <filesystem>
 #include <functional>
 #include <fstream>
+#include <iomanip>
 #include <iostream>
 #include <map>
 #include <regex>
 #include <sstream>
 #include <string>
+#include <thread>
 #include <tuple>
 #include <vector>
 
@@ -59,6 +64,142 @@ load_file_to_memory(const std::string& path)
     throw std::runtime_error(std::string("Failed to read file: ") + path);
 }
 
+// Each line of a profile holds a section name followed by the execution count of each basic block of the
+// program in that section, as returned by ebpf_program_get_block_counts.
+std::map<std::string, std::vector<uint64_t>>
+load_profile(const std::string& path)
+{
+    std::map<std::string, std::vector<uint64_t>> profile;
+    std::ifstream stream{path};
+    if (!stream) {
+        throw std::runtime_error(std::string("Failed to read file: ") + path);
+    }
+    std::string line;
+    while (std::getline(stream, line)) {
+        std::istringstream line_stream(line);
+        std::string section;
+        if (!(line_stream >> section)) {
+            continue;
+        }
+        std::vector<uint64_t> block_counts;
+        uint64_t count;
+        while (line_stream >> count) {
+            block_counts.push_back(count);
+        }
+        if (!line_stream.eof()) {
+            throw std::runtime_error(std::string("Invalid profile for section ") + section + " in " + path);
+        }
+        profile[section] = block_counts;
+    }
+    return profile;
+}
+
+std::string
+to_hex(const std::vector<uint8_t>& bytes)
+{
+    std::stringstream stream;
+    for (uint8_t byte : bytes) {
+        stream << std::hex << std::setw(2) << std::setfill('0') << static_cast<uint32_t>(byte);
+    }
+    return stream.str();
+}
+
+std::optional<std::vector<uint8_t>>
+from_hex(const std::string& text)
+{
+    if (text.size() % 2 != 0 || text.find_first_not_of("0123456789abcdef") != std::string::npos) {
+        return std::nullopt;
+    }
+    std::vector<uint8_t> bytes;
+    for (size_t index = 0; index < text.size(); index += 2) {
+        bytes.push_back(static_cast<uint8_t>(std::stoul(text.substr(index, 2), nullptr, 16)));
+    }
+    return bytes;
+}
+
+// The verification cache holds a file per successfully verified section, named after a hash of everything the
+// verification of the section depends on: bpf2c and the ebpfapi image that contains the verifier, the program type and
+// the program information used for it, the hash algorithm, and the parts of the ELF file the section depends on. The
+// file holds the program info hash of the section.
+std::string
+get_verification_cache_key(
+    const std::vector<std::string>& images,
+    const std::vector<std::string>& dependencies,
+    const ebpf_program_type_t& program_type,
+    const std::vector<uint8_t>& program_info_key,
+    const std::string& hash_algorithm)
+{
+    // Prefix each part with its size so that different splits of the same bytes have different keys.
+    std::string key_data;
+    auto append = [&](std::string_view part) {
+        uint64_t size = part.size();
+        key_data.append(reinterpret_cast<const char*>(&size), sizeof(size));
+        key_data.append(part);
+    };
+    for (const auto& image : images) {
+        append(image);
+    }
+    append(std::string_view(reinterpret_cast<const char*>(&program_type), sizeof(program_type)));
+    append(std::string_view(reinterpret_cast<const char*>(program_info_key.data()), program_info_key.size()));
+    append(hash_algorithm);
+    for (const auto& dependency : dependencies) {
+        append(dependency);
+    }
+    hash_t hash("SHA256");
+    return to_hex(hash.hash_string(key_data));
+}
+
+// Load the image of a module of this process, or of the executable if module is nullptr.
+std::string
+load_module_image(HMODULE module)
+{
+    char path[MAX_PATH];
+    if (GetModuleFileNameA(module, path, sizeof(path)) == 0) {
+        throw std::runtime_error(std::string("Failed to get the path of a module"));
+    }
+    return load_file_to_memory(path);
+}
+
+bool
+read_verification_cache(const std::filesystem::path& path, std::optional<std::vector<uint8_t>>& program_info_hash)
+{
+    std::ifstream stream{path};
+    std::string marker;
+    std::string hash;
+    if (!stream || !std::getline(stream, marker) || marker != "verified" || !std::getline(stream, hash)) {
+        return false;
+    }
+    if (hash.empty()) {
+        program_info_hash = std::nullopt;
+        return true;
+    }
+    program_info_hash = from_hex(hash);
+    return program_info_hash.has_value();
+}
+
+void
+write_verification_cache(
+    const std::filesystem::path& path, const std::optional<std::vector<uint8_t>>& program_info_hash)
+{
+    // Write a temporary file and rename it, so that concurrent builds never read a partial entry. A cache that can't
+    // be written only costs a verification the next time.
+    auto temporary_path = path;
+    temporary_path += "." + std::to_string(GetCurrentProcessId()) + "." + std::to_string(GetCurrentThreadId());
+    {
+        std::ofstream stream{temporary_path};
+        stream << "verified" << std::endl;
+        stream << (program_info_hash.has_value() ? to_hex(program_info_hash.value()) : "") << std::endl;
+        if (!stream) {
+            return;
+        }
+    }
+    std::error_code error;
+    std::filesystem::rename(temporary_path, path, error);
+    if (error) {
+        std::filesystem::remove(temporary_path, error);
+    }
+}
+
 extern "C" void
 elf_everparse_error(_In_ const char* struct_name, _In_ const char* field_name, _In_ const char* reason);
 
@@ -70,14 +211,9 @@ elf_everparse_error(_In_ const char* struct_name, _In_ const char* field_name, _
 }
 
 std::vector<uint8_t>
-get_program_info_type_hash(const std::string& algorithm)
+get_program_info_type_hash(const ebpf_program_info_t* program_info, const std::string& algorithm)
 {
     std::map<uint32_t, size_t> helper_id_ordering;
-    const ebpf_program_info_t* program_info;
-    ebpf_result_t result = ebpf_get_program_info_from_verifier(&program_info);
-    if (result != EBPF_SUCCESS) {
-        throw std::runtime_error(std::string("Failed to get program information"));
-    }
 
     // Note:
     // Order and fields being hashed is important. The order and fields being hashed must match the order and fields
@@ -109,6 +245,25 @@ get_program_info_type_hash(const std::string& algorithm)
     return hash.hash_byte_ranges(byte_range);
 }
 
+// Hash of the program information that the verification of a section depends on. Besides what the program info hash
+// covers, the verifier uses the global helper prototypes.
+std::vector<uint8_t>
+get_program_info_cache_key(const ebpf_program_info_t* program_info)
+{
+    std::vector<uint8_t> type_hash = get_program_info_type_hash(program_info, "SHA256");
+    hash_t::byte_range_t byte_range;
+    byte_range.push_back({type_hash.data(), type_hash.size()});
+    for (uint32_t index = 0; index < program_info->count_of_global_helpers; index++) {
+        const ebpf_helper_function_prototype_t& prototype = program_info->global_helper_prototype[index];
+        hash_t::append_byte_range(byte_range, prototype.helper_id);
+        hash_t::append_byte_range(byte_range, prototype.name);
+        hash_t::append_byte_range(byte_range, prototype.return_type);
+        hash_t::append_byte_range(byte_range, prototype.arguments);
+    }
+    hash_t hash("SHA256");
+    return hash.hash_byte_ranges(byte_range);
+}
+
 int
 main(int argc, char** argv)
 {
@@ -123,7 +278,11 @@ main(int argc, char** argv)
         std::string file;
         std::string type_string = "";
         std::string hash_algorithm = "SHA256";
+        std::string profile_file;
+        std::string cache_directory;
+        size_t job_count = std::max(1u, std::thread::hardware_concurrency());
         bool verify_programs = true;
+        bool instrument = false;
         std::vector<std::string> parameters(argv + 1, argv + argc);
         auto iter = parameters.begin();
         auto iter_end = parameters.end();
@@ -184,6 +343,49 @@ main(int argc, char** argv)
                       return true;
                   }
               }}},
+            {"--instrument",
+             {"Count executions of each basic block",
+              [&]() {
+                  instrument = true;
+                  return true;
+              }}},
+            {"--profile",
+             {"File with basic block counts of an instrumented build, used for branch hints (clang builds only)",
+              [&]() {
+                  ++iter;
+                  if (iter == iter_end) {
+                      std::cerr << "Invalid --profile option" << std::endl;
+                      return false;
+                  } else {
+                      profile_file = *iter;
+                      return true;
+                  }
+              }}},
+            {"--cache",
+             {"Directory caching the verification results of unchanged sections",
+              [&]() {
+                  ++iter;
+                  if (iter == iter_end) {
+                      std::cerr << "Invalid --cache option" << std::endl;
+                      return false;
+                  } else {
+                      cache_directory = *iter;
+                      return true;
+                  }
+              }}},
+            {"--jobs",
+             {"Number of sections to verify concurrently",
+              [&]() {
+                  ++iter;
+                  if (iter == iter_end || iter->empty() || iter->size() > 4 ||
+                      iter->find_first_not_of("0123456789") != std::string::npos || std::stoul(*iter) == 0) {
+                      std::cerr << "Invalid --jobs option" << std::endl;
+                      return false;
+                  } else {
+                      job_count = std::stoul(*iter);
+                      return true;
+                  }
+              }}},
             {"--help",
              {"This help menu",
               [&]() {
@@ -228,6 +430,13 @@ main(int argc, char** argv)
         }
 
         bpf_code_generator generator(stream, c_name, {hash_value});
+        generator.set_instrumentation(instrument);
+        generator.set_allow_subprograms(!verify_programs);
+        if (!profile_file.empty()) {
+            for (const auto& [section, block_counts] : load_profile(profile_file)) {
+                generator.set_profile(section, block_counts);
+            }
+        }
 
         // Capture list of sections.
         std::vector<bpf_code_generator::unsafe_string> sections = generator.program_sections();
@@ -252,7 +461,9 @@ main(int argc, char** argv)
             global_program_type_set = true;
         }
 
-        // Parse per-section data.
+        // Resolve the program type of each section.
+        std::vector<ebpf_program_type_t> program_types;
+        std::vector<ebpf_attach_type_t> attach_types;
         for (const auto& section : sections) {
             if (!global_program_type_set) {
                 if (ebpf_get_program_type_by_name(section.raw().c_str(), &program_type, &attach_type) != EBPF_SUCCESS) {
@@ -260,29 +471,101 @@ main(int argc, char** argv)
                     return 1;
                 }
             }
+            program_types.push_back(program_type);
+            attach_types.push_back(attach_type);
+        }
+
+        std::vector<std::optional<std::vector<uint8_t>>> program_info_hashes(sections.size());
+        if (verify_programs) {
+            std::vector<std::filesystem::path> cache_paths(sections.size());
+            if (!cache_directory.empty()) {
+                // The verifier lives in ebpfapi.dll, unless it is linked into the executable.
+                std::vector<std::string> images = {load_module_image(nullptr)};
+                HMODULE ebpfapi_module = GetModuleHandleA("ebpfapi.dll");
+                if (ebpfapi_module != nullptr) {
+                    images.push_back(load_module_image(ebpfapi_module));
+                }
+                std::filesystem::create_directories(cache_directory);
+                for (size_t index = 0; index < sections.size(); index++) {
+                    const ebpf_program_info_t* program_info;
+                    if (ebpf_get_program_info_by_type(&program_types[index], &program_info) != EBPF_SUCCESS) {
+                        // Leave the section uncached, and let its verification report the error.
+                        continue;
+                    }
+                    cache_paths[index] = std::filesystem::path(cache_directory) /
+                                         get_verification_cache_key(
+                                             images,
+                                             generator.section_dependencies(sections[index]),
+                                             program_types[index],
+                                             get_program_info_cache_key(program_info),
+                                             hash_algorithm);
+                }
+            }
 
-            const char* report = nullptr;
-            const char* error_message = nullptr;
-            ebpf_api_verifier_stats_t stats;
-            std::optional<std::vector<uint8_t>> program_info_hash;
-            if (verify_programs && ebpf_api_elf_verify_section_from_memory(
-                                       data.c_str(),
-                                       data.size(),
-                                       section.raw().c_str(),
-                                       &program_type,
-                                       false,
-                                       &report,
-                                       &error_message,
-                                       &stats) != 0) {
-                report = ((report == nullptr) ? "" : report);
-                throw std::runtime_error(
-                    std::string("Verification failed for ") + section.raw() + std::string(" with error ") +
-                    std::string(error_message) + std::string("\n Report:\n") + std::string(report));
+            // Verify sections concurrently. The verifier keeps its state in thread local storage, and the program
+            // info hash is computed from the program information of the section just verified on the same thread.
+            std::vector<std::string> errors(sections.size());
+            std::atomic<size_t> next_section = 0;
+            auto verify_sections = [&]() {
+                for (size_t index = next_section++; index < sections.size(); index = next_section++) {
+                    try {
+                        const auto& section = sections[index];
+                        if (!cache_paths[index].empty() &&
+                            read_verification_cache(cache_paths[index], program_info_hashes[index])) {
+                            continue;
+                        }
+                        const char* report = nullptr;
+                        const char* error_message = nullptr;
+                        ebpf_api_verifier_stats_t stats;
+                        if (ebpf_api_elf_verify_section_from_memory(
+                                data.c_str(),
+                                data.size(),
+                                section.raw().c_str(),
+                                &program_types[index],
+                                false,
+                                &report,
+                                &error_message,
+                                &stats) != 0) {
+                            report = ((report == nullptr) ? "" : report);
+                            throw std::runtime_error(
+                                std::string("Verification failed for ") + section.raw() +
+                                std::string(" with error ") + std::string(error_message) +
+                                std::string("\n Report:\n") + std::string(report));
+                        }
+                        if (hash_algorithm != "none") {
+                            const ebpf_program_info_t* program_info;
+                            if (ebpf_get_program_info_from_verifier(&program_info) != EBPF_SUCCESS) {
+                                throw std::runtime_error(std::string("Failed to get program information"));
+                            }
+                            program_info_hashes[index] = get_program_info_type_hash(program_info, hash_algorithm);
+                        }
+                        if (!cache_paths[index].empty()) {
+                            write_verification_cache(cache_paths[index], program_info_hashes[index]);
+                        }
+                    } catch (const std::exception& e) {
+                        errors[index] = e.what();
+                    }
+                }
+            };
+            std::vector<std::thread> threads;
+            for (size_t index = 0; index < std::min(job_count, sections.size()); index++) {
+                threads.emplace_back(verify_sections);
             }
-            if (verify_programs && (hash_algorithm != "none")) {
-                program_info_hash = get_program_info_type_hash(hash_algorithm);
+            for (auto& thread : threads) {
+                thread.join();
             }
-            generator.parse(section, program_type, attach_type, program_info_hash);
+
+            // Report the first failure in section order, as the serial verification did.
+            for (const auto& error : errors) {
+                if (!error.empty()) {
+                    throw std::runtime_error(error);
+                }
+            }
+        }
+
+        // Parse per-section data.
+        for (size_t index = 0; index < sections.size(); index++) {
+            generator.parse(sections[index], program_types[index], attach_types[index], program_info_hashes[index]);
         }
 
         for (const auto& section : sections) {
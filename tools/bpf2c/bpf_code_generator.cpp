@@ -11,6 +11,7 @@
 // Example:
 // .\scripts\generate_expected_bpf2c_output.ps1 .\x64\Debug\
 
+#include <algorithm>
 #include <cassert>
 #include <format>
 #include <iomanip>
@@ -22,15 +23,44 @@
 
 #include "btf_parser.h"
 #include "bpf_code_generator.h"
+#include "ebpf_result.h"
 #include "ebpf_version.h"
 
 #if !defined(_countof)
 #define _countof(array) (sizeof(array) / sizeof(array[0]))
 #endif
 
+#if !defined(EBPF_MODE_ATOMIC)
+#define EBPF_MODE_MASK 0xe0
+#define EBPF_MODE_ATOMIC 0xc0
+#endif
+
+// Source register of a wide load of the address of a function, with the offset of the function in the immediate.
+#if !defined(BPF_PSEUDO_FUNC)
+#define BPF_PSEUDO_FUNC 4
+#endif
+
+// Operations of EBPF_MODE_ATOMIC stores, encoded in the immediate.
+#define EBPF_ATOMIC_FETCH 0x01
+#define EBPF_ATOMIC_ADD 0x00
+#define EBPF_ATOMIC_OR 0x40
+#define EBPF_ATOMIC_AND 0x50
+#define EBPF_ATOMIC_XOR 0xa0
+#define EBPF_ATOMIC_XCHG (0xe0 | EBPF_ATOMIC_FETCH)
+#define EBPF_ATOMIC_CMPXCHG (0xf0 | EBPF_ATOMIC_FETCH)
+
+#define EBPF_OP_ATOMIC_W (EBPF_CLS_STX | EBPF_MODE_ATOMIC | EBPF_SIZE_W)
+#define EBPF_OP_ATOMIC_DW (EBPF_CLS_STX | EBPF_MODE_ATOMIC | EBPF_SIZE_DW)
+
 #define INDENT "    "
 #define LINE_BREAK_WIDTH 120
 
+// A branch is annotated as likely or unlikely when one direction is taken this many times more often than the other.
+#define BRANCH_HINT_RATIO 9
+
+// Minimum number of consecutive comparisons of a register with constants that are emitted as a switch statement.
+#define MIN_SWITCH_CASES 3
+
 static const std::string _register_names[11] = {
     "r0",
     "r1",
@@ -45,6 +75,26 @@ static const std::string _register_names[11] = {
     "r10",
 };
 
+// Sections holding global variables, each backed by a single entry array map.
+static const std::string _global_data_section_names[] = {
+    ".data",
+    ".bss",
+    ".rodata",
+};
+
+static std::string
+_subprogram_name(const std::string& program_identifier, size_t first_instruction)
+{
+    return program_identifier + "_subprogram_" + std::to_string(first_instruction);
+}
+
+static bool
+_has_initial_value(const std::optional<std::vector<uint8_t>>& global_data)
+{
+    return global_data.has_value() &&
+           std::any_of(global_data.value().begin(), global_data.value().end(), [](uint8_t byte) { return byte != 0; });
+}
+
 enum class AluOperations
 {
     Add,
@@ -115,6 +165,7 @@ static std::map<uint8_t, std::string> _opcode_name_strings = {
     ADD_OPCODE(EBPF_OP_EXIT),       ADD_OPCODE(EBPF_OP_JLT_IMM),   ADD_OPCODE(EBPF_OP_JLT_REG),
     ADD_OPCODE(EBPF_OP_JLE_IMM),    ADD_OPCODE(EBPF_OP_JLE_REG),   ADD_OPCODE(EBPF_OP_JSLT_IMM),
     ADD_OPCODE(EBPF_OP_JSLT_REG),   ADD_OPCODE(EBPF_OP_JSLE_IMM),  ADD_OPCODE(EBPF_OP_JSLE_REG),
+    ADD_OPCODE(EBPF_OP_ATOMIC_W),   ADD_OPCODE(EBPF_OP_ATOMIC_DW),
 };
 
 #define IS_JMP_CLASS_OPCODE(_opcode) \
@@ -236,6 +287,50 @@ bpf_code_generator::program_sections()
     return section_names;
 }
 
+std::vector<std::string>
+bpf_code_generator::section_dependencies(const bpf_code_generator::unsafe_string& section_name)
+{
+    // A call or a function address can pull a function from any code section into the program, along with the
+    // relocations of that section, and relocations resolve maps and global data through the symbol table. So every
+    // code section is a dependency of every program section, and only sections the verifier never reads, such as
+    // debug information, are left out.
+    auto is_dependency = [](const ELFIO::section* section) {
+        std::string name = section->get_name();
+        return (section->get_flags() & (ELFIO::SHF_EXECINSTR | ELFIO::SHF_ALLOC)) ||
+               section->get_type() == ELFIO::SHT_SYMTAB || section->get_type() == ELFIO::SHT_STRTAB ||
+               name == "maps" || name == ".BTF" || name == ".BTF.ext";
+    };
+
+    std::vector<std::string> contents = {section_name.raw()};
+    for (const auto& section : reader.sections) {
+        if (section->get_type() == ELFIO::SHT_REL || section->get_type() == ELFIO::SHT_RELA) {
+            if (section->get_info() >= reader.sections.size() ||
+                !is_dependency(reader.sections[section->get_info()])) {
+                continue;
+            }
+        } else if (!is_dependency(section.get())) {
+            continue;
+        }
+
+        // The header fields matter too: the size of .bss, which has no contents, is the size of its map.
+        std::string content = section->get_name();
+        content.push_back('\0');
+        for (uint64_t field : {
+                 static_cast<uint64_t>(section->get_index()),
+                 static_cast<uint64_t>(section->get_type()),
+                 static_cast<uint64_t>(section->get_flags()),
+                 static_cast<uint64_t>(section->get_info()),
+                 static_cast<uint64_t>(section->get_size())}) {
+            content.append(reinterpret_cast<const char*>(&field), sizeof(field));
+        }
+        if (section->get_type() != ELFIO::SHT_NOBITS && section->get_data() != nullptr) {
+            content.append(section->get_data(), section->get_size());
+        }
+        contents.push_back(std::move(content));
+    }
+    return contents;
+}
+
 void
 bpf_code_generator::parse(
     const bpf_code_generator::unsafe_string& section_name,
@@ -268,11 +363,36 @@ bpf_code_generator::generate(const bpf_code_generator::unsafe_string& section_na
 {
     current_section = &sections[section_name];
 
+    identify_subprograms();
     generate_labels();
+    identify_basic_blocks();
+    auto profile = section_profiles.find(section_name);
+    if (profile != section_profiles.end() && profile->second.size() != current_section->block_count) {
+        throw bpf_code_generator_exception("profile doesn't match the basic blocks of section " + section_name);
+    }
     build_function_table();
     encode_instructions(section_name);
 }
 
+void
+bpf_code_generator::set_instrumentation(bool instrument)
+{
+    this->instrument = instrument;
+}
+
+void
+bpf_code_generator::set_allow_subprograms(bool allow)
+{
+    allow_subprograms = allow;
+}
+
+void
+bpf_code_generator::set_profile(
+    const bpf_code_generator::unsafe_string& section_name, const std::vector<uint64_t>& block_counts)
+{
+    section_profiles[section_name] = block_counts;
+}
+
 void
 bpf_code_generator::extract_program(const bpf_code_generator::unsafe_string& section_name)
 {
@@ -364,17 +484,49 @@ bpf_code_generator::parse()
             throw bpf_code_generator_exception("bad maps section, map must have associated symbol");
         }
     }
+
+    for (const auto& name : _global_data_section_names) {
+        // .bss has no file contents, which get_optional_section rejects.
+        const ELFIO::section* data_section = reader.sections[name];
+        if (!data_section || data_section->get_size() == 0) {
+            continue;
+        }
+        if (data_section->get_size() > UINT32_MAX) {
+            throw bpf_code_generator_exception("global data section " + name + " is too large");
+        }
+        auto& map_definition = map_definitions[name];
+        map_definition.definition.type = BPF_MAP_TYPE_ARRAY;
+        map_definition.definition.key_size = sizeof(uint32_t);
+        map_definition.definition.value_size = static_cast<uint32_t>(data_section->get_size());
+        map_definition.definition.max_entries = 1;
+        map_definition.index = map_definitions.size() - 1;
+        // Sections without file contents start zeroed.
+        std::vector<uint8_t> data(data_section->get_size());
+        if (data_section->get_type() != ELFIO::SHT_NOBITS && data_section->get_data() != nullptr) {
+            memcpy(data.data(), data_section->get_data(), data.size());
+        }
+        map_definition.global_data = data;
+        map_definition.read_only = (name == ".rodata");
+    }
 }
 
 void
 bpf_code_generator::extract_relocations_and_maps(const bpf_code_generator::unsafe_string& section_name)
+{
+    auto program_section = get_required_section(section_name);
+    apply_relocations(program_section, 0, program_section->get_size(), 0);
+}
+
+void
+bpf_code_generator::apply_relocations(
+    const ELFIO::section* code_section, uint64_t begin, uint64_t end, size_t first_instruction)
 {
     auto map_section = get_optional_section("maps");
     ELFIO::const_symbol_section_accessor symbols{reader, get_required_section(".symtab")};
 
-    auto relocations = get_optional_section(".rel" + section_name);
+    auto relocations = get_optional_section(".rel" + code_section->get_name());
     if (!relocations)
-        relocations = get_optional_section(".rela" + section_name);
+        relocations = get_optional_section(".rela" + code_section->get_name());
 
     if (relocations) {
         ELFIO::const_relocation_section_accessor relocation_reader{reader, relocations};
@@ -385,6 +537,13 @@ bpf_code_generator::extract_relocations_and_maps(const bpf_code_generator::unsaf
             unsigned int type{};
             ELFIO::Elf_Sxword addend{};
             relocation_reader.get_entry(index, offset, symbol, type, addend);
+            if (offset < begin || offset >= end) {
+                continue;
+            }
+            size_t instruction_index = first_instruction + (offset - begin) / sizeof(ebpf_inst);
+            if (instruction_index >= current_section->output.size()) {
+                throw bpf_code_generator_exception("Can't perform relocation at offset ", offset);
+            }
             {
                 std::string unsafe_name{};
                 ELFIO::Elf64_Addr value{};
@@ -396,7 +555,33 @@ bpf_code_generator::extract_relocations_and_maps(const bpf_code_generator::unsaf
                 if (!symbols.get_symbol(symbol, unsafe_name, value, size, bind, symbol_type, section_index, other)) {
                     throw bpf_code_generator_exception("Can't perform relocation at offset ", offset);
                 }
-                current_section->output[offset / sizeof(ebpf_inst)].relocation = unsafe_name;
+                if (section_index < reader.sections.size() &&
+                    (reader.sections[section_index]->get_flags() & ELFIO::SHF_EXECINSTR) &&
+                    current_section->output[instruction_index].instruction.opcode == EBPF_OP_LDDW) {
+                    // Loading the address of a function (e.g. a bpf_loop callback). Append the function to the
+                    // program and refer to it by its offset from the next instruction, as a pseudo function load.
+                    uint64_t function_offset =
+                        (symbol_type == ELFIO::STT_SECTION)
+                            ? static_cast<uint32_t>(current_section->output[instruction_index].instruction.imm)
+                            : value;
+                    size_t target = link_function(section_index, function_offset);
+                    auto& instruction = current_section->output[instruction_index].instruction;
+                    instruction.src = BPF_PSEUDO_FUNC;
+                    instruction.imm = static_cast<int32_t>(
+                        static_cast<int64_t>(target) - static_cast<int64_t>(instruction_index) - 1);
+                    continue;
+                }
+                auto& relocated_output = current_section->output[instruction_index];
+                relocated_output.relocation = unsafe_name;
+                if (section_index < reader.sections.size()) {
+                    // References to global variables resolve to their offset in the section's global data map.
+                    auto data_section_name = reader.sections[section_index]->get_name();
+                    auto global_data_map = map_definitions.find(data_section_name);
+                    if (global_data_map != map_definitions.end() && global_data_map->second.global_data.has_value()) {
+                        relocated_output.relocation = data_section_name;
+                        relocated_output.relocation_offset = value;
+                    }
+                }
                 if (map_section && section_index == map_section->get_index()) {
                     // Check that the map exists in the list of map definitions.
                     if (map_definitions.find(unsafe_name) == map_definitions.end()) {
@@ -408,6 +593,50 @@ bpf_code_generator::extract_relocations_and_maps(const bpf_code_generator::unsaf
     }
 }
 
+size_t
+bpf_code_generator::link_function(ELFIO::Elf_Half section_index, uint64_t offset)
+{
+    auto linked_function = current_section->linked_functions.find({section_index, offset});
+    if (linked_function != current_section->linked_functions.end()) {
+        return linked_function->second;
+    }
+
+    // Find the size of the function from its symbol.
+    ELFIO::const_symbol_section_accessor symbols{reader, get_required_section(".symtab")};
+    std::optional<ELFIO::Elf_Xword> function_size;
+    for (ELFIO::Elf_Xword index = 0; index < symbols.get_symbols_num(); index++) {
+        std::string unsafe_name{};
+        ELFIO::Elf64_Addr value{};
+        ELFIO::Elf_Xword size{};
+        unsigned char bind{};
+        unsigned char symbol_type{};
+        ELFIO::Elf_Half symbol_section_index{};
+        unsigned char other{};
+        symbols.get_symbol(index, unsafe_name, value, size, bind, symbol_type, symbol_section_index, other);
+        if (symbol_type == ELFIO::STT_FUNC && symbol_section_index == section_index && value == offset) {
+            function_size = size;
+            break;
+        }
+    }
+
+    const ELFIO::section* code_section = reader.sections[section_index];
+    if (!function_size.has_value() || function_size.value() == 0 ||
+        function_size.value() % sizeof(ebpf_inst) != 0 || offset > code_section->get_size() ||
+        function_size.value() > code_section->get_size() - offset || code_section->get_data() == nullptr) {
+        throw bpf_code_generator_exception("invalid function at offset " + std::to_string(offset) + " of section " +
+                                           code_section->get_name());
+    }
+
+    size_t first_instruction = current_section->output.size();
+    current_section->linked_functions[{section_index, offset}] = first_instruction;
+    auto instructions = reinterpret_cast<const ebpf_inst*>(code_section->get_data() + offset);
+    for (size_t i = 0; i < function_size.value() / sizeof(ebpf_inst); i++) {
+        current_section->output.push_back({instructions[i], static_cast<uint32_t>(current_section->output.size())});
+    }
+    apply_relocations(code_section, offset, offset + function_size.value(), first_instruction);
+    return first_instruction;
+}
+
 void
 bpf_code_generator::extract_btf_information()
 {
@@ -473,6 +702,59 @@ bpf_code_generator::generate_labels()
     }
 }
 
+void
+bpf_code_generator::identify_subprograms()
+{
+    std::vector<output_instruction_t>& program_output = current_section->output;
+
+    for (size_t i = 0; i < program_output.size(); i++) {
+        auto& instruction = program_output[i].instruction;
+        if (instruction.opcode != EBPF_OP_LDDW) {
+            continue;
+        }
+        if (instruction.src == BPF_PSEUDO_FUNC) {
+            if (!allow_subprograms) {
+                throw bpf_code_generator_exception("subprograms can't be verified", i);
+            }
+            int64_t target = static_cast<int64_t>(i) + instruction.imm + 1;
+            // The main program must come first, so a subprogram can't start at the first instruction.
+            if (target <= 0 || static_cast<size_t>(target) >= program_output.size()) {
+                throw bpf_code_generator_exception("invalid function target", i);
+            }
+            current_section->subprogram_starts.insert(static_cast<size_t>(target));
+        }
+        // Skip the second half of the wide instruction.
+        i++;
+    }
+
+    if (!current_section->subprogram_starts.empty()) {
+        // Subprograms receive their arguments in r1 and r2.
+        get_register_name(2);
+    }
+}
+
+void
+bpf_code_generator::identify_basic_blocks()
+{
+    std::vector<output_instruction_t>& program_output = current_section->output;
+
+    // A basic block starts at the first instruction, at each jump target and after each jump or exit.
+    size_t block_index = 0;
+    bool block_start = true;
+    for (size_t i = 0; i < program_output.size(); i++) {
+        auto& output = program_output[i];
+        if (block_start || output.jump_target || current_section->subprogram_starts.contains(i)) {
+            output.block_index = block_index++;
+        }
+        block_start = IS_JMP_CLASS_OPCODE(output.instruction.opcode) && output.instruction.opcode != EBPF_OP_CALL;
+        if (output.instruction.opcode == EBPF_OP_LDDW) {
+            // Skip the second half of the wide instruction.
+            i++;
+        }
+    }
+    current_section->block_count = block_index;
+}
+
 void
 bpf_code_generator::build_function_table()
 {
@@ -487,6 +769,9 @@ bpf_code_generator::build_function_table()
         bpf_code_generator::unsafe_string name;
         if (!output.relocation.empty()) {
             name = output.relocation;
+        } else if (output.instruction.imm == BPF_FUNC_loop) {
+            // bpf_loop is lowered to a native loop, so the program doesn't need the helper.
+            continue;
         } else {
             name = "helper_id_";
             name += std::to_string(output.instruction.imm);
@@ -505,10 +790,50 @@ bpf_code_generator::encode_instructions(const bpf_code_generator::unsafe_string&
     auto program_name = !current_section->program_name.empty() ? current_section->program_name : section_name;
     auto helper_array_prefix = program_name.c_identifier() + "_helpers[{}]";
 
+    // Map whose address was loaded into r1 in the current basic block, used to inline lookups into array maps.
+    const map_entry_t* r1_map = nullptr;
+
+    // Basic block counters of an instrumented build, and the counts to derive branch hints from.
+    auto block_counts_name = program_name.c_identifier() + "_block_counts";
+    auto profile = section_profiles.find(section_name);
+    size_t current_block = 0;
+
+    // Registers whose lower 32 bits are known to be non-zero in the current basic block. Division and modulo by
+    // such a register don't need the check for a zero divisor.
+    std::set<uint8_t> nonzero_registers;
+
+    // Registers holding an address in .rodata in the current basic block, and the offset of that address.
+    std::map<uint8_t, uint64_t> rodata_registers;
+    auto rodata_map = map_definitions.find(".rodata");
+    const map_entry_t* rodata = (rodata_map != map_definitions.end() && rodata_map->second.global_data.has_value())
+                                    ? &rodata_map->second
+                                    : nullptr;
+
+    // Registers holding the address of a subprogram in the current basic block, and its first instruction.
+    std::map<uint8_t, size_t> callback_registers;
+
     // Encode instructions
     for (size_t i = 0; i < program_output.size(); i++) {
         auto& output = program_output[i];
         auto& inst = output.instruction;
+        const map_entry_t* loaded_map = nullptr;
+        std::optional<uint64_t> loaded_rodata_offset;
+        std::optional<size_t> loaded_callback;
+
+        // Other paths can reach a jump target with a different value in r1. A subprogram starts with no known values.
+        if (!output.label.empty() || current_section->subprogram_starts.contains(i)) {
+            r1_map = nullptr;
+            nonzero_registers.clear();
+            rodata_registers.clear();
+            callback_registers.clear();
+        }
+
+        if (output.block_index.has_value()) {
+            current_block = output.block_index.value();
+            if (instrument) {
+                output.lines.push_back(std::format("{}[{}]++;", block_counts_name, std::to_string(current_block)));
+            }
+        }
 
         switch (inst.opcode & EBPF_CLS_MASK) {
         case EBPF_CLS_ALU:
@@ -520,6 +845,11 @@ bpf_code_generator::encode_instructions(const bpf_code_generator::unsafe_string&
             else
                 source = "IMMEDIATE(" + std::to_string(inst.imm) + ")";
             bool is64bit = (inst.opcode & EBPF_CLS_MASK) == EBPF_CLS_ALU64;
+            bool divisor_nonzero =
+                (inst.opcode & EBPF_SRC_REG) ? nonzero_registers.contains(inst.src) : (inst.imm != 0);
+            // 32-bit operations must clear the upper half of the destination, unless the emitted expression
+            // already produces a zero-extended 32-bit (or narrower) unsigned value.
+            bool zero_extended = false;
             AluOperations operation = static_cast<AluOperations>(inst.opcode >> 4);
             std::string swap_function;
             switch (operation) {
@@ -533,7 +863,13 @@ bpf_code_generator::encode_instructions(const bpf_code_generator::unsafe_string&
                 output.lines.push_back(std::format("{} *= {};", destination, source));
                 break;
             case AluOperations::Div:
-                if (is64bit)
+                if (divisor_nonzero) {
+                    if (is64bit)
+                        output.lines.push_back(std::format("{} /= {};", destination, source));
+                    else
+                        output.lines.push_back(
+                            std::format("{} = (uint32_t){} / (uint32_t){};", destination, destination, source));
+                } else if (is64bit)
                     output.lines.push_back(
                         std::format("{} = {} ? ({} / {}) : 0;", destination, source, destination, source));
                 else
@@ -543,6 +879,7 @@ bpf_code_generator::encode_instructions(const bpf_code_generator::unsafe_string&
                         source,
                         destination,
                         source));
+                zero_extended = true;
                 break;
             case AluOperations::Or:
                 output.lines.push_back(std::format("{} |= {};", destination, source));
@@ -558,12 +895,19 @@ bpf_code_generator::encode_instructions(const bpf_code_generator::unsafe_string&
                     output.lines.push_back(std::format("{} >>= {};", destination, source));
                 else
                     output.lines.push_back(std::format("{} = (uint32_t){} >> {};", destination, destination, source));
+                zero_extended = true;
                 break;
             case AluOperations::Neg:
                 output.lines.push_back(std::format("{} = -(int64_t){};", destination, destination));
                 break;
             case AluOperations::Mod:
-                if (is64bit)
+                if (divisor_nonzero) {
+                    if (is64bit)
+                        output.lines.push_back(std::format("{} %= {};", destination, source));
+                    else
+                        output.lines.push_back(
+                            std::format("{} = (uint32_t){} % (uint32_t){};", destination, destination, source));
+                } else if (is64bit)
                     output.lines.push_back(std::format(
                         "{} = {} ? ({} % {}): {} ;", destination, source, destination, source, destination));
                 else
@@ -574,12 +918,15 @@ bpf_code_generator::encode_instructions(const bpf_code_generator::unsafe_string&
                         destination,
                         source,
                         destination));
+                zero_extended = true;
                 break;
             case AluOperations::Xor:
                 output.lines.push_back(std::format("{} ^= {};", destination, source));
                 break;
             case AluOperations::Mov:
                 output.lines.push_back(std::format("{} = {};", destination, source));
+                // A non-negative immediate is not sign-extended.
+                zero_extended = !(inst.opcode & EBPF_SRC_REG) && inst.imm >= 0;
                 break;
             case AluOperations::Ashr:
                 if (is64bit)
@@ -629,11 +976,12 @@ bpf_code_generator::encode_instructions(const bpf_code_generator::unsafe_string&
                 }
                 output.lines.push_back(
                     std::format("{} = {}(({}){});", destination, swap_function, size_type, destination));
+                zero_extended = true;
             } break;
             default:
                 throw bpf_code_generator_exception("invalid operand", output.instruction_offset);
             }
-            if (!is64bit)
+            if (!is64bit && !zero_extended)
                 output.lines.push_back(std::format("{} &= UINT32_MAX;", destination));
 
         } break;
@@ -646,7 +994,13 @@ bpf_code_generator::encode_instructions(const bpf_code_generator::unsafe_string&
                 throw bpf_code_generator_exception("invalid operand", output.instruction_offset);
             }
             std::string destination = get_register_name(inst.dst);
-            if (output.relocation.empty()) {
+            if (inst.src == BPF_PSEUDO_FUNC) {
+                // i is the second half of the wide instruction, so the target is i + imm.
+                size_t target = static_cast<size_t>(static_cast<int64_t>(i) + inst.imm);
+                output.lines.push_back(std::format(
+                    "{} = POINTER(&{});", destination, _subprogram_name(program_name.c_identifier(), target)));
+                loaded_callback = target;
+            } else if (output.relocation.empty()) {
                 uint64_t imm = static_cast<uint32_t>(program_output[i].instruction.imm);
                 imm <<= 32;
                 imm |= static_cast<uint32_t>(output.instruction.imm);
@@ -660,7 +1014,24 @@ bpf_code_generator::encode_instructions(const bpf_code_generator::unsafe_string&
                     throw bpf_code_generator_exception(
                         "Map " + output.relocation + " doesn't exist", output.instruction_offset);
                 }
-                source = std::format("_maps[{}].address", std::to_string(map_definition->second.index));
+                if (map_definition->second.global_data.has_value()) {
+                    // A global variable is addressed directly in the value of its section's array map.
+                    uint64_t data_offset = output.relocation_offset + static_cast<uint32_t>(output.instruction.imm);
+                    if (data_offset >= map_definition->second.global_data.value().size()) {
+                        throw bpf_code_generator_exception(
+                            "invalid offset in global data section " + output.relocation, output.instruction_offset);
+                    }
+                    source = std::format(
+                        "(uint8_t*)_maps[{}].array_data + {}",
+                        std::to_string(map_definition->second.index),
+                        std::to_string(data_offset));
+                    if (map_definition->second.read_only) {
+                        loaded_rodata_offset = data_offset;
+                    }
+                } else {
+                    source = std::format("_maps[{}].address", std::to_string(map_definition->second.index));
+                    loaded_map = &map_definition->second;
+                }
                 output.lines.push_back(std::format("{} = POINTER({});", destination, source));
                 current_section->referenced_map_indices.insert(map_definitions[output.relocation].index);
             }
@@ -670,20 +1041,37 @@ bpf_code_generator::encode_instructions(const bpf_code_generator::unsafe_string&
             std::string destination = get_register_name(inst.dst);
             std::string source = get_register_name(inst.src);
             std::string offset = "OFFSET(" + std::to_string(inst.offset) + ")";
+            size_t size = 0;
             switch (inst.opcode & EBPF_SIZE_DW) {
             case EBPF_SIZE_B:
                 size_type = "uint8_t";
+                size = sizeof(uint8_t);
                 break;
             case EBPF_SIZE_H:
                 size_type = "uint16_t";
+                size = sizeof(uint16_t);
                 break;
             case EBPF_SIZE_W:
                 size_type = "uint32_t";
+                size = sizeof(uint32_t);
                 break;
             case EBPF_SIZE_DW:
                 size_type = "uint64_t";
+                size = sizeof(uint64_t);
                 break;
             }
+            // Loads from .rodata are folded into the constant stored in the ELF file.
+            auto rodata_pointer = rodata_registers.find(inst.src);
+            if (rodata_pointer != rodata_registers.end() && rodata != nullptr) {
+                int64_t data_offset = static_cast<int64_t>(rodata_pointer->second) + inst.offset;
+                const auto& data = rodata->global_data.value();
+                if (data_offset >= 0 && static_cast<size_t>(data_offset) + size <= data.size()) {
+                    uint64_t value = 0;
+                    memcpy(&value, data.data() + data_offset, size);
+                    output.lines.push_back(std::format("{} = (uint64_t){};", destination, std::to_string(value)));
+                    break;
+                }
+            }
             output.lines.push_back(
                 std::format("{} = *({}*)(uintptr_t)({} + {});", destination, size_type, source, offset));
         } break;
@@ -698,6 +1086,64 @@ bpf_code_generator::encode_instructions(const bpf_code_generator::unsafe_string&
                 source = get_register_name(inst.src);
             }
             std::string offset = "OFFSET(" + std::to_string(inst.offset) + ")";
+            if (inst.opcode == EBPF_OP_ATOMIC_W || inst.opcode == EBPF_OP_ATOMIC_DW) {
+                // Atomic read-modify-write of the memory at dst + offset, using the interlocked intrinsics.
+                bool is64bit = inst.opcode == EBPF_OP_ATOMIC_DW;
+                std::string suffix = is64bit ? "64" : "";
+                std::string address = std::format(
+                    "(volatile {}*)(uintptr_t)({} + {})", is64bit ? "int64_t" : "long", destination, offset);
+                std::string value_cast = is64bit ? "(int64_t)" : "(long)";
+                std::string result_cast = is64bit ? "(uint64_t)" : "(uint32_t)";
+                std::string function;
+                switch (inst.imm & ~EBPF_ATOMIC_FETCH) {
+                case EBPF_ATOMIC_ADD:
+                    function = "_InterlockedExchangeAdd";
+                    break;
+                case EBPF_ATOMIC_OR:
+                    function = "_InterlockedOr";
+                    break;
+                case EBPF_ATOMIC_AND:
+                    function = "_InterlockedAnd";
+                    break;
+                case EBPF_ATOMIC_XOR:
+                    function = "_InterlockedXor";
+                    break;
+                case EBPF_ATOMIC_XCHG & ~EBPF_ATOMIC_FETCH:
+                    function = "_InterlockedExchange";
+                    break;
+                case EBPF_ATOMIC_CMPXCHG & ~EBPF_ATOMIC_FETCH:
+                    function = "_InterlockedCompareExchange";
+                    break;
+                default:
+                    throw bpf_code_generator_exception("invalid operand", output.instruction_offset);
+                }
+                // Exchanges are only defined with the fetch flag.
+                if ((inst.imm & 0xe0) == 0xe0 && !(inst.imm & EBPF_ATOMIC_FETCH)) {
+                    throw bpf_code_generator_exception("invalid operand", output.instruction_offset);
+                }
+                if (inst.imm == EBPF_ATOMIC_CMPXCHG) {
+                    // Compare with r0 and store src if equal. r0 receives the original value.
+                    output.lines.push_back(std::format(
+                        "{} = {}{}{}({}, {}{}, {}{});",
+                        get_register_name(0),
+                        result_cast,
+                        function,
+                        suffix,
+                        address,
+                        value_cast,
+                        source,
+                        value_cast,
+                        get_register_name(0)));
+                } else if (inst.imm & EBPF_ATOMIC_FETCH) {
+                    // src receives the original value.
+                    output.lines.push_back(std::format(
+                        "{} = {}{}{}({}, {}{});", source, result_cast, function, suffix, address, value_cast, source));
+                } else {
+                    output.lines.push_back(
+                        std::format("{}{}({}, {}{});", function, suffix, address, value_cast, source));
+                }
+                break;
+            }
             switch (inst.opcode & EBPF_SIZE_DW) {
             case EBPF_SIZE_B:
                 size_type = "uint8_t";
@@ -743,12 +1189,53 @@ bpf_code_generator::encode_instructions(const bpf_code_generator::unsafe_string&
             }
 
             auto& format = _predicate_format_string[inst.opcode >> 4];
-            if (inst.opcode == EBPF_OP_JA) {
+
+            // Find a chain of equality tests of the same register against constants, as clang emits for a switch.
+            // Only the first test of the chain may be a jump target. Instrumented builds keep the chain, as they
+            // count each of its basic blocks.
+            size_t chain_end = i + 1;
+            bool is_jeq_imm =
+                (inst.opcode == EBPF_OP_JEQ_IMM || inst.opcode == (EBPF_CLS_JMP32 | EBPF_SRC_IMM | EBPF_MODE_JEQ));
+            if (is_jeq_imm && !instrument) {
+                while (chain_end < program_output.size() &&
+                       program_output[chain_end].instruction.opcode == inst.opcode &&
+                       program_output[chain_end].instruction.dst == inst.dst &&
+                       !program_output[chain_end].jump_target &&
+                       !current_section->subprogram_starts.contains(chain_end)) {
+                    chain_end++;
+                }
+            }
+
+            if (chain_end - i >= MIN_SWITCH_CASES) {
+                // Emit the chain as a switch, which the C compiler can turn into a jump table or a binary search.
+                // The switch converts each case to the type of the register, like the comparison it replaces.
+                std::set<int32_t> cases;
+                output.lines.push_back(std::format("switch ({}{}) {{", destination_cast, destination));
+                for (size_t j = i; j < chain_end; j++) {
+                    const auto& test = program_output[j].instruction;
+                    std::string target = program_output[j + test.offset + 1].label;
+                    if (target.empty()) {
+                        throw bpf_code_generator_exception("invalid jump target", program_output[j].instruction_offset);
+                    }
+                    // A repeated constant can't be reached past its first test.
+                    if (!cases.insert(test.imm).second) {
+                        continue;
+                    }
+                    output.lines.push_back(std::format("case IMMEDIATE({}):", std::to_string(test.imm)));
+                    output.lines.push_back(std::format(INDENT "goto {};", target));
+                }
+                output.lines.push_back("}");
+                i = chain_end - 1;
+            } else if (inst.opcode == EBPF_OP_JA) {
                 std::string target = program_output[i + inst.offset + 1].label;
                 output.lines.push_back("goto " + target + ";");
             } else if (inst.opcode == EBPF_OP_CALL) {
                 std::string function_name;
-                if (output.relocation.empty()) {
+                int32_t helper_id;
+                if (output.relocation.empty() && output.instruction.imm == BPF_FUNC_loop) {
+                    helper_id = BPF_FUNC_loop;
+                } else if (output.relocation.empty()) {
+                    helper_id = output.instruction.imm;
                     function_name = std::vformat(
                         helper_array_prefix,
                         make_format_args(std::to_string(
@@ -757,17 +1244,77 @@ bpf_code_generator::encode_instructions(const bpf_code_generator::unsafe_string&
                 } else {
                     auto helper_function = current_section->helper_functions.find(output.relocation);
                     assert(helper_function != current_section->helper_functions.end());
+                    helper_id = helper_function->second.id;
                     function_name = std::vformat(
                         helper_array_prefix,
                         make_format_args(std::to_string(current_section->helper_functions[output.relocation].index)));
                 }
-                output.lines.push_back(get_register_name(0) + " = " + function_name + ".address");
-                output.lines.push_back(
-                    INDENT " (" + get_register_name(1) + ", " + get_register_name(2) + ", " + get_register_name(3) +
-                    ", " + get_register_name(4) + ", " + get_register_name(5) + ");");
-                output.lines.push_back(
-                    std::format("if (({}.tail_call) && ({} == 0))", function_name, get_register_name(0)));
-                output.lines.push_back(INDENT "return 0;");
+                std::string call_arguments = INDENT " (" + get_register_name(1) + ", " + get_register_name(2) + ", " +
+                                             get_register_name(3) + ", " + get_register_name(4) + ", " +
+                                             get_register_name(5) + ");";
+                if (helper_id == BPF_FUNC_map_lookup_elem && r1_map != nullptr &&
+                    r1_map->definition.type == BPF_MAP_TYPE_ARRAY) {
+                    // The values of an array map are contiguous, so a lookup is a bounds check of the key followed by
+                    // pointer arithmetic. The loader sets array_data when it resolves the map; the helper remains
+                    // the fallback otherwise. The key and value sizes of a map are checked when it is resolved.
+                    std::string map = std::format("_maps[{}]", std::to_string(r1_map->index));
+                    std::string result = get_register_name(0);
+                    output.lines.push_back(std::format("if ({}.array_data != NULL) {{", map));
+                    output.lines.push_back(
+                        std::format(INDENT "{} = *(uint32_t*)(uintptr_t){};", result, get_register_name(2)));
+                    output.lines.push_back(std::format(
+                        INDENT "{} = ({} < {}) ? POINTER((uint8_t*){}.array_data + {} * {}) : 0;",
+                        result,
+                        result,
+                        std::to_string(r1_map->definition.max_entries),
+                        map,
+                        result,
+                        std::to_string(r1_map->definition.value_size)));
+                    output.lines.push_back("} else {");
+                    output.lines.push_back(INDENT + get_register_name(0) + " = " + function_name + ".address");
+                    output.lines.push_back(INDENT + call_arguments);
+                    output.lines.push_back("}");
+                } else if (helper_id == BPF_FUNC_loop) {
+                    // Call the callback from a native loop instead of the helper, which can't call into the program.
+                    // The loop returns the number of calls made, including a call that ended the loop by returning
+                    // a non-zero value.
+                    if (!allow_subprograms) {
+                        throw bpf_code_generator_exception(
+                            "bpf_loop callbacks can't be verified", output.instruction_offset);
+                    }
+                    auto callback = callback_registers.find(2);
+                    if (callback == callback_registers.end()) {
+                        throw bpf_code_generator_exception(
+                            "bpf_loop callback must be loaded in the same basic block", output.instruction_offset);
+                    }
+                    std::string result = get_register_name(0);
+                    std::string count = get_register_name(1);
+                    output.lines.push_back(std::format(
+                        "if (({} != 0) || ((uint32_t){} > BPF_MAX_LOOPS)) {{", get_register_name(4), count));
+                    output.lines.push_back(std::format(
+                        INDENT "{} = (uint64_t)-(int64_t){};", result, std::to_string(EBPF_INVALID_ARGUMENT)));
+                    output.lines.push_back("} else {");
+                    output.lines.push_back(
+                        std::format(INDENT "for ({} = 0; {} < (uint32_t){};) {{", result, result, count));
+                    output.lines.push_back(std::format(
+                        INDENT INDENT "if ({}({}++, {}) != 0)",
+                        _subprogram_name(program_name.c_identifier(), callback->second),
+                        result,
+                        get_register_name(3)));
+                    output.lines.push_back(INDENT INDENT INDENT "break;");
+                    output.lines.push_back(INDENT "}");
+                    output.lines.push_back("}");
+                } else {
+                    output.lines.push_back(get_register_name(0) + " = " + function_name + ".address");
+                    output.lines.push_back(call_arguments);
+                    // Helper ids are known at compile time, so only bpf_tail_call needs the check for a pending
+                    // tail call. This saves a load and a branch after every other helper call.
+                    if (helper_id == BPF_FUNC_tail_call) {
+                        output.lines.push_back(
+                            std::format("if (({}.tail_call) && ({} == 0))", function_name, get_register_name(0)));
+                        output.lines.push_back(INDENT "return 0;");
+                    }
+                }
             } else if (inst.opcode == EBPF_OP_EXIT) {
                 output.lines.push_back("return " + get_register_name(0) + ";");
             } else {
@@ -778,6 +1325,22 @@ bpf_code_generator::encode_instructions(const bpf_code_generator::unsafe_string&
 
                 std::string predicate =
                     vformat(format, make_format_args(destination_cast, destination, source_cast, source));
+
+                // The fall through block is only reached from this branch when it isn't a jump target, so its
+                // count is the number of times the branch wasn't taken.
+                if (profile != section_profiles.end() && (i + 1) < program_output.size() &&
+                    !program_output[i + 1].jump_target && program_output[i + 1].block_index.has_value()) {
+                    uint64_t count = profile->second[current_block];
+                    uint64_t not_taken = profile->second[program_output[i + 1].block_index.value()];
+                    uint64_t taken = (count > not_taken) ? (count - not_taken) : 0;
+                    if (taken > BRANCH_HINT_RATIO * not_taken) {
+                        predicate = "LIKELY(" + predicate + ")";
+                        branch_hints_emitted = true;
+                    } else if (not_taken > BRANCH_HINT_RATIO * taken) {
+                        predicate = "UNLIKELY(" + predicate + ")";
+                        branch_hints_emitted = true;
+                    }
+                }
                 output.lines.push_back(vformat("if ({})", make_format_args(predicate)));
                 output.lines.push_back(vformat(INDENT "goto {};", make_format_args(target)));
             }
@@ -786,6 +1349,71 @@ bpf_code_generator::encode_instructions(const bpf_code_generator::unsafe_string&
         default:
             throw bpf_code_generator_exception("invalid operand", output.instruction_offset);
         }
+
+        uint8_t instruction_class = inst.opcode & EBPF_CLS_MASK;
+        bool writes_r1 =
+            (inst.dst == 1 && (instruction_class == EBPF_CLS_ALU || instruction_class == EBPF_CLS_ALU64 ||
+                               instruction_class == EBPF_CLS_LD || instruction_class == EBPF_CLS_LDX));
+        if (inst.opcode == EBPF_OP_CALL) {
+            // Calls clobber r1 to r5.
+            writes_r1 = true;
+        }
+
+        // Atomic operations with the fetch flag write the original value to src, or to r0 for cmpxchg.
+        std::optional<uint8_t> atomic_fetch_register;
+        if ((inst.opcode == EBPF_OP_ATOMIC_W || inst.opcode == EBPF_OP_ATOMIC_DW) && (inst.imm & EBPF_ATOMIC_FETCH)) {
+            atomic_fetch_register = static_cast<uint8_t>((inst.imm == EBPF_ATOMIC_CMPXCHG) ? 0 : inst.src);
+            if (atomic_fetch_register == 1) {
+                writes_r1 = true;
+            }
+        }
+        if (loaded_map != nullptr && inst.dst == 1) {
+            r1_map = loaded_map;
+        } else if (writes_r1) {
+            r1_map = nullptr;
+        }
+
+        bool is_alu = (instruction_class == EBPF_CLS_ALU || instruction_class == EBPF_CLS_ALU64);
+        bool has_immediate = !(inst.opcode & EBPF_SRC_REG);
+        AluOperations alu_operation = static_cast<AluOperations>(inst.opcode >> 4);
+        if (loaded_rodata_offset.has_value()) {
+            rodata_registers[inst.dst] = loaded_rodata_offset.value();
+        } else if (is_alu || instruction_class == EBPF_CLS_LD || instruction_class == EBPF_CLS_LDX) {
+            rodata_registers.erase(inst.dst);
+        } else if (atomic_fetch_register.has_value()) {
+            rodata_registers.erase(atomic_fetch_register.value());
+        }
+
+        if (loaded_callback.has_value()) {
+            callback_registers[inst.dst] = loaded_callback.value();
+        } else if (is_alu || instruction_class == EBPF_CLS_LD || instruction_class == EBPF_CLS_LDX) {
+            callback_registers.erase(inst.dst);
+        } else if (atomic_fetch_register.has_value()) {
+            callback_registers.erase(atomic_fetch_register.value());
+        }
+
+        if (inst.opcode == EBPF_OP_CALL) {
+            // Calls clobber r0 to r5.
+            for (uint8_t id = 0; id <= 5; id++) {
+                nonzero_registers.erase(id);
+                rodata_registers.erase(id);
+                callback_registers.erase(id);
+            }
+        } else if (
+            is_alu && has_immediate && inst.imm != 0 &&
+            (alu_operation == AluOperations::Mov || alu_operation == AluOperations::Or)) {
+            // Moving or or-ing a non-zero immediate leaves bits set in the lower 32 bits.
+            nonzero_registers.insert(inst.dst);
+        } else if (is_alu || instruction_class == EBPF_CLS_LD || instruction_class == EBPF_CLS_LDX) {
+            nonzero_registers.erase(inst.dst);
+        } else if (atomic_fetch_register.has_value()) {
+            nonzero_registers.erase(atomic_fetch_register.value());
+        } else if (
+            instruction_class == EBPF_CLS_JMP32 && (inst.opcode >> 4) == (EBPF_MODE_JEQ >> 4) && has_immediate &&
+            inst.imm == 0) {
+            // The fall through path of a 32-bit comparison with zero continues the basic block with a non-zero value.
+            nonzero_registers.insert(inst.dst);
+        }
     }
 }
 
@@ -793,6 +1421,10 @@ void
 bpf_code_generator::emit_c_code(std::ostream& output_stream)
 {
     // Emit C file
+    if (branch_hints_emitted) {
+        // Makes bpf2c.h reject compilers that ignore the branch hints.
+        output_stream << "#define BPF2C_BRANCH_HINTS" << std::endl;
+    }
     output_stream << "#include \"bpf2c.h\"" << std::endl << std::endl;
 
     output_stream << "static void" << std::endl
@@ -821,6 +1453,25 @@ bpf_code_generator::emit_c_code(std::ostream& output_stream)
 
     // Emit import tables
     if (map_definitions.size() > 0) {
+        // Emit the initial contents of global data maps. Zero filled sections (e.g. .bss) need none.
+        for (const auto& [name, entry] : map_definitions) {
+            if (!_has_initial_value(entry.global_data)) {
+                continue;
+            }
+            output_stream << "static const uint8_t _map_initial_value_" << std::to_string(entry.index) << "[] = {";
+            size_t column = 0;
+            for (uint8_t byte : entry.global_data.value()) {
+                if (column % 16 == 0) {
+                    output_stream << std::endl << INDENT;
+                } else {
+                    output_stream << " ";
+                }
+                output_stream << std::to_string(byte) << ",";
+                column++;
+            }
+            output_stream << std::endl << "};" << std::endl << std::endl;
+        }
+
         output_stream << "#pragma data_seg(push, \"maps\")" << std::endl;
         output_stream << "static map_entry_t _maps[] = {" << std::endl;
         size_t map_size = map_definitions.size();
@@ -884,7 +1535,17 @@ bpf_code_generator::emit_c_code(std::ostream& output_stream)
                           << std::to_string(entry.definition.inner_id) + ","
                           << "// The id of the inner map template." << std::endl;
             output_stream << INDENT " }," << std::endl;
-            output_stream << INDENT " " << name.quoted() << "}," << std::endl;
+            if (entry.global_data.has_value()) {
+                std::string initial_value = _has_initial_value(entry.global_data)
+                                                ? "_map_initial_value_" + std::to_string(entry.index)
+                                                : "NULL";
+                output_stream << INDENT " " << name.quoted() << "," << std::endl;
+                output_stream << INDENT " NULL," << std::endl;
+                output_stream << INDENT " " << initial_value << "," << std::endl;
+                output_stream << INDENT " " << (entry.read_only ? "true" : "false") << "}," << std::endl;
+            } else {
+                output_stream << INDENT " " << name.quoted() << "}," << std::endl;
+            }
         }
         output_stream << "};" << std::endl;
         output_stream << "#pragma data_seg(pop)" << std::endl;
@@ -986,6 +1647,12 @@ bpf_code_generator::emit_c_code(std::ostream& output_stream)
             output_stream << std::endl;
         }
 
+        if (instrument) {
+            // Emit the basic block counters.
+            output_stream << std::format(
+                "static uint64_t {}_block_counts[{}];\n\n", program_name.c_identifier(), section.block_count);
+        }
+
         auto& line_info = section_line_info[name];
         auto first_line_info = line_info.find(section.output.front().instruction_offset);
         std::string prolog_line_info;
@@ -996,53 +1663,92 @@ bpf_code_generator::emit_c_code(std::ostream& output_stream)
                 first_line_info->second.file_name.quoted_filename());
         }
 
-        // Emit entry point
+        // Structured bindings can't be captured by the lambdas below.
+        const auto& referenced_registers = section.referenced_registers;
+        const auto& program_output = section.output;
+
+        // Emit the prologue shared by the entry point and the subprograms.
+        auto emit_prologue = [&]() {
+            output_stream << prolog_line_info << INDENT "// Prologue" << std::endl;
+            output_stream << prolog_line_info << INDENT "uint64_t stack[(UBPF_STACK_SIZE + 7) / 8];" << std::endl;
+            for (const auto& r : _register_names) {
+                // Skip unused registers
+                if (referenced_registers.find(r) == referenced_registers.end()) {
+                    continue;
+                }
+                output_stream << prolog_line_info << INDENT "register uint64_t " << r.c_str() << " = 0;" << std::endl;
+            }
+            output_stream << std::endl;
+        };
+
+        // Emit the encoded instructions in [begin, end).
+        auto emit_instructions = [&](size_t begin, size_t end) {
+            for (size_t index = begin; index < end; index++) {
+                const auto& output = program_output[index];
+                if (output.lines.empty()) {
+                    continue;
+                }
+                if (!output.label.empty())
+                    output_stream << output.label << ":" << std::endl;
+                auto current_line = line_info.find(output.instruction_offset);
+                if (current_line != line_info.end() && !current_line->second.file_name.empty() &&
+                    current_line->second.line_number != 0) {
+                    prolog_line_info = std::format(
+                        "#line {} {}\n",
+                        std::to_string(current_line->second.line_number),
+                        current_line->second.file_name.quoted_filename());
+                }
+#if defined(_DEBUG) || defined(BPF2C_VERBOSE)
+                output_stream << INDENT "// " << _opcode_name_strings[output.instruction.opcode]
+                              << " pc=" << output.instruction_offset << " dst=r"
+                              << std::to_string(output.instruction.dst) << " src=r"
+                              << std::to_string(output.instruction.src)
+                              << " offset=" << std::to_string(output.instruction.offset)
+                              << " imm=" << std::to_string(output.instruction.imm) << std::endl;
+#endif
+                for (const auto& line : output.lines) {
+                    output_stream << prolog_line_info << INDENT "" << line << std::endl;
+                }
+            }
+        };
+
         output_stream << "#pragma code_seg(push, " << section.pe_section_name.quoted() << ")" << std::endl;
+
+        // Emit subprograms ahead of the entry point that references them. Each one runs until the next one starts.
+        std::vector<size_t> subprogram_starts(section.subprogram_starts.begin(), section.subprogram_starts.end());
+        size_t entry_point_end = subprogram_starts.empty() ? section.output.size() : subprogram_starts.front();
+        for (size_t k = 0; k < subprogram_starts.size(); k++) {
+            size_t subprogram_end =
+                (k + 1 < subprogram_starts.size()) ? subprogram_starts[k + 1] : section.output.size();
+            output_stream << std::format(
+                                 "static uint64_t\n{}(uint64_t index, uint64_t context)",
+                                 _subprogram_name(program_name.c_identifier(), subprogram_starts[k]))
+                          << std::endl;
+            output_stream << prolog_line_info << "{" << std::endl;
+            emit_prologue();
+            output_stream << prolog_line_info << INDENT "" << get_register_name(1) << " = index;" << std::endl;
+            output_stream << prolog_line_info << INDENT "" << get_register_name(2) << " = context;" << std::endl;
+            output_stream << prolog_line_info << INDENT "" << get_register_name(10)
+                          << " = (uintptr_t)((uint8_t*)stack + sizeof(stack));" << std::endl;
+            output_stream << std::endl;
+            emit_instructions(subprogram_starts[k], subprogram_end);
+            output_stream << prolog_line_info << "}" << std::endl << std::endl;
+        }
+
+        // Emit entry point
         output_stream << std::format("static uint64_t\n{}(void* context)", program_name.c_identifier()) << std::endl;
         output_stream << prolog_line_info << "{" << std::endl;
 
         // Emit prologue
-        output_stream << prolog_line_info << INDENT "// Prologue" << std::endl;
-        output_stream << prolog_line_info << INDENT "uint64_t stack[(UBPF_STACK_SIZE + 7) / 8];" << std::endl;
-        for (const auto& r : _register_names) {
-            // Skip unused registers
-            if (section.referenced_registers.find(r) == section.referenced_registers.end()) {
-                continue;
-            }
-            output_stream << prolog_line_info << INDENT "register uint64_t " << r.c_str() << " = 0;" << std::endl;
-        }
-        output_stream << std::endl;
+        emit_prologue();
         output_stream << prolog_line_info << INDENT "" << get_register_name(1) << " = (uintptr_t)context;" << std::endl;
         output_stream << prolog_line_info << INDENT "" << get_register_name(10)
                       << " = (uintptr_t)((uint8_t*)stack + sizeof(stack));" << std::endl;
         output_stream << std::endl;
 
         // Emit encoded instructions.
-        for (const auto& output : section.output) {
-            if (output.lines.empty()) {
-                continue;
-            }
-            if (!output.label.empty())
-                output_stream << output.label << ":" << std::endl;
-            auto current_line = line_info.find(output.instruction_offset);
-            if (current_line != line_info.end() && !current_line->second.file_name.empty() &&
-                current_line->second.line_number != 0) {
-                prolog_line_info = std::format(
-                    "#line {} {}\n",
-                    std::to_string(current_line->second.line_number),
-                    current_line->second.file_name.quoted_filename());
-            }
-#if defined(_DEBUG) || defined(BPF2C_VERBOSE)
-            output_stream << INDENT "// " << _opcode_name_strings[output.instruction.opcode]
-                          << " pc=" << output.instruction_offset << " dst=r" << std::to_string(output.instruction.dst)
-                          << " src=r" << std::to_string(output.instruction.src)
-                          << " offset=" << std::to_string(output.instruction.offset)
-                          << " imm=" << std::to_string(output.instruction.imm) << std::endl;
-#endif
-            for (const auto& line : output.lines) {
-                output_stream << prolog_line_info << INDENT "" << line << std::endl;
-            }
-        }
+        emit_instructions(0, entry_point_end);
+
         // Emit epilogue
         output_stream << prolog_line_info << "}" << std::endl;
         output_stream << "#pragma code_seg(pop)" << std::endl;
@@ -1078,6 +1784,13 @@ bpf_code_generator::emit_c_code(std::ostream& output_stream)
             if (program.program_info_hash.has_value()) {
                 output_stream << INDENT INDENT << program_info_hash_name << "," << std::endl;
                 output_stream << INDENT INDENT << program.program_info_hash.value().size() << "," << std::endl;
+            } else if (instrument) {
+                output_stream << INDENT INDENT "NULL," << std::endl;
+                output_stream << INDENT INDENT "0," << std::endl;
+            }
+            if (instrument) {
+                output_stream << INDENT INDENT << program_name.c_identifier() << "_block_counts," << std::endl;
+                output_stream << INDENT INDENT << program.block_count << "," << std::endl;
             }
             output_stream << INDENT "}," << std::endl;
         }
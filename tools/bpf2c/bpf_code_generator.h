@@ -7,6 +7,7 @@
 #include <optional>
 #include <set>
 #include <string>
+#include <string_view>
 #include <vector>
 
 #include "ebpf.h"
@@ -212,6 +213,17 @@ class bpf_code_generator
     std::vector<unsafe_string>
     program_sections();
 
+    /**
+     * @brief Retrieve the parts of the ELF file that the verification of a section depends on: the name of the
+     * section, and the headers and contents of every code section, the relocations that apply to them, the symbol and
+     * string tables, and the map, BTF and global data sections.
+     *
+     * @param[in] section_name Section to retrieve the dependencies of.
+     * @return One entry for the section name followed by one entry per dependency, in section order.
+     */
+    std::vector<std::string>
+    section_dependencies(const unsafe_string& section_name);
+
     /**
      * @brief Parse the eBPF file.
      *
@@ -228,12 +240,42 @@ class bpf_code_generator
         const std::optional<std::vector<uint8_t>>& program_info_hash);
 
     /**
-     * @brief Parse global data (currently map information) in the eBPF file.
+     * @brief Parse global data (map information and the .data, .bss and .rodata sections) in the eBPF file. Each
+     * global data section is backed by a single entry array map appended after the maps declared in the file.
      *
      */
     void
     parse();
 
+    /**
+     * @brief Emit a counter at the start of each basic block of the generated programs. The counts can be read from
+     * a loaded program with ebpf_program_get_block_counts and fed back to set_profile.
+     *
+     * @param[in] instrument True to emit the counters.
+     */
+    void
+    set_instrumentation(bool instrument);
+
+    /**
+     * @brief Provide the basic block counts of an instrumented build of a program. Conditional branches that the
+     * counts show to be almost always or almost never taken are annotated with LIKELY or UNLIKELY. Only clang
+     * honors these hints, so generated code that contains any of them fails to compile with other compilers.
+     *
+     * @param[in] section_name Section in the ELF file the counts were collected for.
+     * @param[in] block_counts Execution count of each basic block.
+     */
+    void
+    set_profile(const unsafe_string& section_name, const std::vector<uint64_t>& block_counts);
+
+    /**
+     * @brief Accept programs that load the address of a subprogram, such as a bpf_loop callback. The verifier can't
+     * check subprograms yet, so they must only be accepted in programs that are not verified.
+     *
+     * @param[in] allow True to accept subprograms.
+     */
+    void
+    set_allow_subprograms(bool allow);
+
     /**
      * @brief Generate C code from the parsed eBPF file.
      *
@@ -261,6 +303,9 @@ class bpf_code_generator
     {
         ebpf_map_definition_in_file_t definition;
         size_t index;
+        // Contents of the .data, .bss or .rodata section backing a global data map.
+        std::optional<std::vector<uint8_t>> global_data;
+        bool read_only = false;
     } map_entry_t;
 
     typedef struct _output_instruction
@@ -269,8 +314,11 @@ class bpf_code_generator
         uint32_t instruction_offset;
         bool jump_target = false;
         std::string label;
+        std::optional<size_t> block_index;
         std::vector<std::string> lines;
         unsafe_string relocation;
+        // Offset of the relocated symbol in its global data section.
+        uint64_t relocation_offset = 0;
     } output_instruction_t;
 
     typedef struct _section
@@ -285,6 +333,11 @@ class bpf_code_generator
         // Indices of the maps used in this section.
         std::set<size_t> referenced_map_indices;
         std::map<unsafe_string, helper_function_t> helper_functions;
+        size_t block_count = 0;
+        // First instruction of each subprogram (e.g. a bpf_loop callback). Subprograms follow the main program.
+        std::set<size_t> subprogram_starts;
+        // First instruction of each function linked from another code section, by section index and offset.
+        std::map<std::pair<ELFIO::Elf_Half, uint64_t>, size_t> linked_functions;
     } section_t;
 
     typedef struct _line_info
@@ -323,6 +376,28 @@ class bpf_code_generator
     void
     extract_relocations_and_maps(const unsafe_string& section_name);
 
+    /**
+     * @brief Apply the relocations of a range of a code section to the instructions copied from that range.
+     *
+     * @param[in] code_section Code section containing the instructions.
+     * @param[in] begin Offset in bytes of the start of the range.
+     * @param[in] end Offset in bytes of the end of the range.
+     * @param[in] first_instruction Index in the output of the instruction copied from the start of the range.
+     */
+    void
+    apply_relocations(const ELFIO::section* code_section, uint64_t begin, uint64_t end, size_t first_instruction);
+
+    /**
+     * @brief Append a function from another code section (e.g. a bpf_loop callback in .text) to the program, unless
+     * it was already appended.
+     *
+     * @param[in] section_index Index of the section containing the function.
+     * @param[in] offset Offset in bytes of the function in its section.
+     * @return Index of the first instruction of the function in the output.
+     */
+    size_t
+    link_function(ELFIO::Elf_Half section_index, uint64_t offset);
+
     /**
      * @brief Extract the mapping from instruction offset to line number.
      *
@@ -337,6 +412,20 @@ class bpf_code_generator
     void
     generate_labels();
 
+    /**
+     * @brief Find the subprograms referenced by the program, i.e. the targets of function pointer loads.
+     *
+     */
+    void
+    identify_subprograms();
+
+    /**
+     * @brief Number the basic blocks of the program.
+     *
+     */
+    void
+    identify_basic_blocks();
+
     /**
      * @brief Extract list of helper functions called by this program.
      *
@@ -398,4 +487,8 @@ class bpf_code_generator
     unsafe_string path;
     btf_section_to_instruction_to_line_info_t section_line_info;
     std::optional<std::vector<uint8_t>> elf_file_hash;
+    bool instrument = false;
+    bool allow_subprograms = false;
+    std::map<unsafe_string, std::vector<uint64_t>> section_profiles;
+    bool branch_hints_emitted = false;
 };